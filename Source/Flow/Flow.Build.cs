@@ -10,23 +10,22 @@ public class Flow : ModuleRules
 
 		PublicDependencyModuleNames.AddRange(new[]
 		{
-			"LevelSequence"
+			"NetCore"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new[]
 		{
+			"AssetRegistry",
 			"Core",
 			"CoreUObject",
 			"DeveloperSettings",
 			"Engine",
-			"GameplayTags",
-			"MovieScene",
-			"MovieSceneTracks",
-			"NetCore",
-			"Slate",
-			"SlateCore"
+			"GameplayTags"
 		});
 
+		// replicated Flow Component state is made of push-model fast arrays, which Iris replicates only when marked dirty
+		SetupIrisSupport(target);
+
 		if (target.Type == TargetType.Editor)
 		{
 			PublicDependencyModuleNames.AddRange(new[]
@@ -34,6 +33,11 @@ public class Flow : ModuleRules
 				"MessageLog",
 				"UnrealEd"
 			});
+
+			PrivateDependencyModuleNames.AddRange(new[]
+			{
+				"DerivedDataCache"
+			});
 		}
 	}
 }
\ No newline at end of file
@@ -2,35 +2,72 @@
 
 #include "FlowAsset.h"
 
+#include "FlowAssetRegistryTags.h"
+#include "FlowComponent.h"
+#include "FlowLightweightProgram.h"
 #include "FlowLogChannels.h"
+#include "FlowRemoteDebug.h"
 #include "FlowSettings.h"
+#include "FlowStats.h"
 #include "FlowSubsystem.h"
+#include "FlowTelemetry.h"
 
 #include "AddOns/FlowNodeAddOn.h"
 #include "Interfaces/FlowDataPinGeneratorNodeInterface.h"
 #include "Nodes/FlowNodeBase.h"
+#include "Nodes/FlowNodeBlueprint.h"
 #include "Nodes/Graph/FlowNode_CustomInput.h"
 #include "Nodes/Graph/FlowNode_CustomOutput.h"
 #include "Nodes/Graph/FlowNode_Start.h"
 #include "Nodes/Graph/FlowNode_SubGraph.h"
 
+#include "Algo/BinarySearch.h"
+#include "Containers/Ticker.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/Crc.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectIterator.h"
 
 #if WITH_EDITOR
+#include "AssetRegistry/IAssetRegistry.h"
+#include "DerivedDataCacheInterface.h"
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
+#include "EdGraph/EdGraph.h"
+#include "Misc/SecureHash.h"
+#include "ScopedTransaction.h"
+#include "UObject/AssetRegistryTagsContext.h"
 
 FString UFlowAsset::ValidationError_NodeClassNotAllowed = TEXT("Node class {0} is not allowed in this asset.");
 FString UFlowAsset::ValidationError_NullNodeInstance = TEXT("Node with GUID {0} is NULL");
+
+static bool GFlowLivePatchInstances = true;
+static FAutoConsoleVariableRef CVarFlowLivePatchInstances(
+	TEXT("Flow.LivePatchInstances"),
+	GFlowLivePatchInstances,
+	TEXT("Applies edits of Flow Assets to their instances running in PIE, instead of keeping the node copies made on instance creation"));
+
+// Bump after changing FFlowCompiledGraph compilation, UFlowAsset::ApplyCookFixups or FFlowAssetOptimizer
+static const TCHAR* CompiledGraphCacheVersion = TEXT("7C5D2E9A41B84F3A9E0D6B1C8F2A4E65");
 #endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowAsset)
 
 UFlowAsset::UFlowAsset(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, ExecutionPriority(0)
+	, MaxPooledInstances(0)
+	, bIsolatedExecution(false)
+	, bLazyNodeInstantiation(false)
+	, bClusterInstances(false)
 	, bWorldBound(true)
+	, bReplicateInstanceState(false)
+	, bCosmetic(false)
+	, bInlineWhenCooked(false)
 #if WITH_EDITORONLY_DATA
 	, FlowGraph(nullptr)
 #endif
@@ -48,6 +85,99 @@ UFlowAsset::UFlowAsset(const FObjectInitializer& ObjectInitializer)
 	ExpectedOwnerClass = UFlowSettings::Get()->GetDefaultExpectedOwnerClass();
 }
 
+void UFlowAsset::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	SIZE_T Size = Nodes.GetAllocatedSize() + ReverseConnections.GetAllocatedSize() + ContentDependencies.GetAllocatedSize()
+		+ ActiveInstances.GetAllocatedSize() + ActiveSubGraphs.GetAllocatedSize() + CustomInputNodes.GetAllocatedSize()
+		+ PreloadedNodes.GetAllocatedSize() + ActiveNodes.GetAllocatedSize() + RecordedNodes.GetAllocatedSize()
+		+ CompiledNodes.GetAllocatedSize() + TriggerQueue.GetAllocatedSize() + DirtyReplicatedNodes.GetAllocatedSize()
+		+ DataPinMemo.GetAllocatedSize() + CachedSaveData.GetAllocatedSize();
+
+	// the compiled graph is shared by all instances, it's accounted to the template only
+	if (TemplateAsset == nullptr && CompiledGraph.IsValid())
+	{
+		Size += sizeof(FFlowCompiledGraph) + CompiledGraph->GetAllocatedSize();
+	}
+
+	if (CustomEventNodes.IsValid())
+	{
+		Size += sizeof(FFlowCustomEventNodes) + CustomEventNodes->GetAllocatedSize();
+	}
+
+	if (LightweightProgram.IsValid())
+	{
+		Size += sizeof(FFlowLightweightProgram) + LightweightProgram->GetAllocatedSize();
+	}
+
+	// nodes owned by this asset are its subobjects, UObject::GetResourceSizeEx already visits them in the EstimatedTotal mode
+	// template nodes referenced by lazily instantiated instances aren't subobjects, so they're counted only by the template
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Size);
+}
+
+void UFlowAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// cooking saves and cooked loads filter editor-only data, so both sides agree on the layout
+	if (!Ar.IsPersistent() || !Ar.IsFilterEditorOnly() || Ar.IsSaveGame() || HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	int32 Version = FFlowCompiledGraph::SerializationVersion;
+	TArray<uint8> CompiledGraphData;
+
+	if (Ar.IsSaving())
+	{
+#if WITH_EDITOR
+		CompiledGraphData = CachedCompiledGraphData;
+#endif
+
+		if (CompiledGraphData.IsEmpty())
+		{
+			FFlowCompiledGraph CookedGraph = GetOrCompileGraph();
+			FMemoryWriter Writer(CompiledGraphData);
+			CookedGraph.Serialize(Writer);
+
+#if WITH_EDITOR
+			if (!CompiledGraphCacheKey.IsEmpty())
+			{
+				GetDerivedDataCacheRef().Put(*CompiledGraphCacheKey, CompiledGraphData, GetPathName());
+			}
+#endif
+		}
+	}
+
+	// versioned blob, so outdated cooked data is skipped instead of breaking the package
+	Ar << Version;
+	Ar << CompiledGraphData;
+
+	if (Ar.IsLoading() && Version == FFlowCompiledGraph::SerializationVersion && !CompiledGraphData.IsEmpty())
+	{
+		const TSharedRef<FFlowCompiledGraph> LoadedGraph = MakeShared<FFlowCompiledGraph>();
+		FMemoryReader Reader(CompiledGraphData);
+		LoadedGraph->Serialize(Reader);
+
+		// graph might be compiled from different nodes, if only the asset was cooked again
+		bool bMatchingNodes = !Reader.IsError() && LoadedGraph->NodeGuids.Num() == Nodes.Num()
+			&& LoadedGraph->OutputOffsets.Num() == Nodes.Num() + 1 && LoadedGraph->ExecutionOrder.Num() == Nodes.Num();
+		for (int32 NodeIndex = 0; bMatchingNodes && NodeIndex < LoadedGraph->NodeGuids.Num(); ++NodeIndex)
+		{
+			bMatchingNodes = Nodes.Contains(LoadedGraph->NodeGuids[NodeIndex]);
+		}
+
+		// pins of the nodes aren't loaded yet, these are compared in PostLoad
+		bMatchingNodes = bMatchingNodes && LoadedGraph->HasValidTables();
+
+		if (bMatchingNodes)
+		{
+			CompiledGraph = LoadedGraph;
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UFlowAsset::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
 {
@@ -79,10 +209,194 @@ void UFlowAsset::PostDuplicate(bool bDuplicateForPIE)
 	}
 }
 
+void UFlowAsset::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// undo restores nodes and event names without going through RegisterNode or SetEventName
+	InvalidateCompiledGraph();
+	bFullHarvestPending = true;
+}
+
 void UFlowAsset::PostLoad()
 {
 	Super::PostLoad();
 
+	// cooked packages are saved after ApplyCookFixups, these only fix source assets loaded by the editor
+	RemoveInvalidNodes();
+
+	// assets saved before introducing the reverse index
+	if (ReverseConnections.IsEmpty())
+	{
+		RebuildReverseConnections();
+	}
+
+	// cooked graph doesn't match the nodes, i.e. a node class changed its pins without cooking this asset again
+	if (CompiledGraph.IsValid() && !CompiledGraph->MatchesOutputPins(Nodes))
+	{
+		UE_LOG(LogFlow, Verbose, TEXT("Compiled graph of %s is outdated, it will be compiled again"), *GetPathName());
+		CompiledGraph.Reset();
+	}
+}
+
+void UFlowAsset::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	FFlowAssetRegistryTags Tags;
+	Tags.CustomInputs = CustomInputs;
+	Tags.CustomOutputs = CustomOutputs;
+
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		if (!IsValid(Node.Value))
+		{
+			continue;
+		}
+
+		Tags.NodeClasses.AddUnique(Node.Value->GetClass()->GetClassPathName());
+		(void) Node.Value->ForEachAddOnConst([&Tags](const UFlowNodeAddOn& AddOn)
+		{
+			Tags.NodeClasses.AddUnique(AddOn.GetClass()->GetClassPathName());
+			return EFlowForEachAddOnFunctionReturnValue::Continue;
+		});
+
+		Node.Value->GatherGameplayTags(Tags.GameplayTags);
+
+		if (const UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node.Value))
+		{
+			if (!SubGraphNode->Asset.IsNull())
+			{
+				Tags.SubGraphs.AddUnique(SubGraphNode->Asset.ToSoftObjectPath());
+			}
+		}
+	}
+
+	Tags.AddAssetRegistryTags(Context);
+}
+
+FString UFlowAsset::BuildCompiledGraphCacheKey() const
+{
+	// source package changes with every saved edit, pins of nodes also reflect changes of node classes
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(GetPackage()->GetFName());
+	if (!PackageData.IsSet())
+	{
+		return FString();
+	}
+
+	FSHA1 Hash;
+	const FIoHash PackageHash = PackageData->GetPackageSavedHash();
+	Hash.Update(PackageHash.GetBytes(), sizeof(FIoHash::ByteArray));
+
+	const int32 SerializationVersion = FFlowCompiledGraph::SerializationVersion;
+	Hash.Update(reinterpret_cast<const uint8*>(&SerializationVersion), sizeof(SerializationVersion));
+
+	const uint8 bOptimizeGraphs = UFlowSettings::Get()->bOptimizeGraphsOnCook ? 1 : 0;
+	Hash.Update(&bOptimizeGraphs, sizeof(bOptimizeGraphs));
+
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&Node.Key), sizeof(FGuid));
+		if (!IsValid(Node.Value))
+		{
+			continue;
+		}
+
+		// optimizer might inline the Sub Graph asset, so its saved package is part of the compiled graph
+		const UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node.Value);
+		if (bOptimizeGraphs && SubGraphNode && !SubGraphNode->Asset.IsNull())
+		{
+			const FName SubGraphPackageName = SubGraphNode->Asset.ToSoftObjectPath().GetLongPackageFName();
+			const TOptional<FAssetPackageData> SubGraphPackageData = AssetRegistry.GetAssetPackageDataCopy(SubGraphPackageName);
+			if (!SubGraphPackageData.IsSet())
+			{
+				return FString();
+			}
+
+			const FIoHash SubGraphPackageHash = SubGraphPackageData->GetPackageSavedHash();
+			Hash.Update(SubGraphPackageHash.GetBytes(), sizeof(FIoHash::ByteArray));
+		}
+
+		const FString ClassPath = Node.Value->GetClass()->GetPathName();
+		Hash.UpdateWithString(*ClassPath, ClassPath.Len());
+
+		for (const TArray<FFlowPin>* Pins : {&Node.Value->GetInputPins(), &Node.Value->GetOutputPins()})
+		{
+			for (const FFlowPin& Pin : *Pins)
+			{
+				const FString PinName = Pin.PinName.ToString();
+				Hash.UpdateWithString(*PinName, PinName.Len());
+			}
+		}
+	}
+
+	// Finalize() finishes the digest itself, finishing it twice would pad the data again
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("FLOWGRAPH"), CompiledGraphCacheVersion, *Hash.Finalize().ToString());
+}
+
+void UFlowAsset::BeginCacheForCookedPlatformData(const ITargetPlatform* TargetPlatform)
+{
+	Super::BeginCacheForCookedPlatformData(TargetPlatform);
+
+	// assets edited in the running editor might differ from the saved package
+	if (!IsRunningCookCommandlet() || HasAnyFlags(RF_ClassDefaultObject) || GetPackage()->IsDirty() || !CompiledGraphCacheKey.IsEmpty())
+	{
+		return;
+	}
+
+	// compiled graph doesn't depend on the platform, so one request covers all cooked platforms
+	CompiledGraphCacheKey = BuildCompiledGraphCacheKey();
+	if (!CompiledGraphCacheKey.IsEmpty())
+	{
+		CompiledGraphCacheHandle = GetDerivedDataCacheRef().GetAsynchronous(*CompiledGraphCacheKey, GetPathName());
+	}
+}
+
+bool UFlowAsset::IsCachedCookedPlatformDataLoaded(const ITargetPlatform* TargetPlatform)
+{
+	if (CompiledGraphCacheHandle != 0)
+	{
+		FDerivedDataCacheInterface& DerivedDataCache = GetDerivedDataCacheRef();
+		if (!DerivedDataCache.PollAsynchronousCompletion(CompiledGraphCacheHandle))
+		{
+			return false;
+		}
+
+		// a miss leaves the data empty, the graph is compiled and cached while saving
+		if (!DerivedDataCache.GetAsynchronousResults(CompiledGraphCacheHandle, CachedCompiledGraphData))
+		{
+			CachedCompiledGraphData.Reset();
+		}
+		CompiledGraphCacheHandle = 0;
+	}
+
+	return Super::IsCachedCookedPlatformDataLoaded(TargetPlatform);
+}
+
+void UFlowAsset::ClearAllCachedCookedPlatformData()
+{
+	Super::ClearAllCachedCookedPlatformData();
+
+	if (CompiledGraphCacheHandle != 0)
+	{
+		GetDerivedDataCacheRef().WaitAsynchronousCompletion(CompiledGraphCacheHandle);
+		TArray<uint8> DiscardedData;
+		GetDerivedDataCacheRef().GetAsynchronousResults(CompiledGraphCacheHandle, DiscardedData);
+		CompiledGraphCacheHandle = 0;
+	}
+
+	CompiledGraphCacheKey.Reset();
+	CachedCompiledGraphData.Empty();
+}
+
+void UFlowAsset::RemoveInvalidNodes()
+{
 	// If we removed or moved a flow node blueprint (and there is no redirector) we might loose the reference to it resulting
 	// in null pointers in the Nodes FGUID->UFlowNode* Map. So here we iterate over all the Nodes and remove all pairs that
 	// are nulled out.
@@ -103,6 +417,27 @@ void UFlowAsset::PostLoad()
 	}
 }
 
+void UFlowAsset::ApplyCookFixups()
+{
+	RemoveInvalidNodes();
+
+	// connections of nodes changed after the asset was last saved, otherwise harvested only by editor instances
+	bool bGraphNodesReady = bFullHarvestPending && !Nodes.IsEmpty();
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		bGraphNodesReady &= Node.Value->GetGraphNode() != nullptr;
+	}
+
+	if (bGraphNodesReady)
+	{
+		HarvestNodeConnections();
+	}
+	else if (ReverseConnections.IsEmpty())
+	{
+		RebuildReverseConnections();
+	}
+}
+
 EDataValidationResult UFlowAsset::ValidateAsset(FFlowMessageLog& MessageLog)
 {
 	// validate nodes
@@ -163,6 +498,39 @@ bool UFlowAsset::IsNodeOrAddOnClassAllowed(const UClass* FlowNodeOrAddOnClass, F
 	return true;
 }
 
+bool UFlowAsset::IsNodeOrAddOnBlueprintAllowed(const FAssetData& BlueprintAssetData, const FFlowNodeBlueprintMetadata& Metadata, FText* OutOptionalFailureReason) const
+{
+	// asset classes that aren't loaded can't be parents of this asset class
+	for (const FTopLevelAssetPath& DeniedAssetClassPath : Metadata.DeniedAssetClasses)
+	{
+		const UClass* DeniedAssetClass = FindObject<UClass>(DeniedAssetClassPath);
+		if (DeniedAssetClass && GetClass()->IsChildOf(DeniedAssetClass))
+		{
+			return false;
+		}
+	}
+
+	if (Metadata.AllowedAssetClasses.Num() > 0)
+	{
+		const bool bAllowedInAsset = Metadata.AllowedAssetClasses.ContainsByPredicate([this](const FTopLevelAssetPath& AllowedAssetClassPath)
+		{
+			const UClass* AllowedAssetClass = FindObject<UClass>(AllowedAssetClassPath);
+			return AllowedAssetClass && GetClass()->IsChildOf(AllowedAssetClass);
+		});
+		if (!bAllowedInAsset)
+		{
+			return false;
+		}
+	}
+
+	if (IsFlowNodeClassInDeniedClasses_Impl(Metadata) || !IsFlowNodeClassInAllowedClasses_Impl(Metadata, nullptr))
+	{
+		return false;
+	}
+
+	return CanFlowAssetReferenceFlowNode(BlueprintAssetData, OutOptionalFailureReason);
+}
+
 bool UFlowAsset::CanFlowNodeClassBeUsedByFlowAsset(const UClass& FlowNodeClass) const
 {
 	UFlowNode* NodeDefaults = Cast<UFlowNode>(FlowNodeClass.GetDefaultObject());
@@ -223,13 +591,19 @@ bool UFlowAsset::CanFlowAssetUseFlowNodeClass(const UClass& FlowNodeClass) const
 }
 
 bool UFlowAsset::IsFlowNodeClassInDeniedClasses(const UClass& FlowNodeClass) const
+{
+	return IsFlowNodeClassInDeniedClasses_Impl(FlowNodeClass);
+}
+
+template <typename TNodeClass>
+bool UFlowAsset::IsFlowNodeClassInDeniedClasses_Impl(const TNodeClass& FlowNodeClass) const
 {
 	for (const TSubclassOf<UFlowNodeBase>& DeniedNodeClass : DeniedNodeClasses)
 	{
 		if (DeniedNodeClass && FlowNodeClass.IsChildOf(DeniedNodeClass))
 		{
 			// Subclasses of a DeniedNodeClass can opt back in to being allowed
-			if (!IsFlowNodeClassInAllowedClasses(FlowNodeClass, DeniedNodeClass))
+			if (!IsFlowNodeClassInAllowedClasses_Impl(FlowNodeClass, DeniedNodeClass))
 			{
 				return true;
 			}
@@ -241,6 +615,12 @@ bool UFlowAsset::IsFlowNodeClassInDeniedClasses(const UClass& FlowNodeClass) con
 
 bool UFlowAsset::IsFlowNodeClassInAllowedClasses(const UClass& FlowNodeClass,
                                                  const TSubclassOf<UFlowNodeBase>& RequiredAncestor) const
+{
+	return IsFlowNodeClassInAllowedClasses_Impl(FlowNodeClass, RequiredAncestor);
+}
+
+template <typename TNodeClass>
+bool UFlowAsset::IsFlowNodeClassInAllowedClasses_Impl(const TNodeClass& FlowNodeClass, const TSubclassOf<UFlowNodeBase>& RequiredAncestor) const
 {
 	if (AllowedNodeClasses.Num() > 0)
 	{
@@ -272,13 +652,22 @@ bool UFlowAsset::CanFlowAssetReferenceFlowNode(const UClass& FlowNodeClass, FTex
 		return false;
 	}
 
+	return CanFlowAssetReferenceFlowNode(FAssetData(&FlowNodeClass), OutOptionalFailureReason);
+}
+
+bool UFlowAsset::CanFlowAssetReferenceFlowNode(const FAssetData& FlowNodeAssetData, FText* OutOptionalFailureReason) const
+{
+	if (!GEditor)
+	{
+		return false;
+	}
+
 	// Confirm plugin reference restrictions are being respected
 	FAssetReferenceFilterContext AssetReferenceFilterContext;
 	AssetReferenceFilterContext.AddReferencingAsset(FAssetData(this));
 	const TSharedPtr<IAssetReferenceFilter> FlowAssetReferenceFilter = GEditor->MakeAssetReferenceFilter(AssetReferenceFilterContext);
 	if (FlowAssetReferenceFilter.IsValid())
 	{
-		const FAssetData FlowNodeAssetData(&FlowNodeClass);
 		if (!FlowAssetReferenceFilter->PassesFilter(FlowNodeAssetData, OutOptionalFailureReason))
 		{
 			return false;
@@ -322,12 +711,25 @@ void UFlowAsset::UnregisterNode(const FGuid& NodeGuid)
 
 void UFlowAsset::HarvestNodeConnections(UFlowNode* TargetNode)
 {
+	// pins or connections might have changed, next instance will compile the graph again
+	InvalidateCompiledGraph();
+
+	// bulk edits would harvest all nodes after every added or removed node, a single harvest at the end of the batch covers them all
+	if (IsEditBatchActive())
+	{
+		bEditBatchHarvestPending = true;
+		bFullHarvestPending = true;
+		return;
+	}
+
 	TArray<UFlowNode*> TargetNodes;
 
-	if (IsValid(TargetNode))
+	const bool bHarvestAllNodes = !IsValid(TargetNode);
+	if (!bHarvestAllNodes)
 	{
 		TargetNodes.Reserve(1);
 		TargetNodes.Add(TargetNode);
+		bFullHarvestPending = true;
 	}
 	else
 	{
@@ -417,75 +819,215 @@ void UFlowAsset::HarvestNodeConnections(UFlowNode* TargetNode)
 			FlowNode->Modify();
 
 			FlowNode->SetConnections(FoundConnections);
-			FlowNode->PostEditChange();
+			NotifyNodeEdited(*FlowNode);
 		}
 	}
-}
 
-bool UFlowAsset::TryUpdateManagedFlowPinsForNode(UFlowNode& FlowNode)
-{
-	const UClass* FlowNodeClass = FlowNode.GetClass();
-	if (!IsValid(FlowNodeClass))
+	RebuildReverseConnections();
+
+	if (bHarvestAllNodes)
 	{
-		return false;
+		bFullHarvestPending = false;
 	}
 
-	// Setup the working data struct
-	FFlowHarvestDataPinsWorkingData WorkingData =
-		FFlowHarvestDataPinsWorkingData(
-			FlowNode,
-			FlowNode.GetPinNameToBoundPropertyNameMap(),
-			FlowNode.GetAutoInputDataPins(),
-			FlowNode.GetAutoOutputDataPins());
+	SchedulePatchRunningInstances();
+}
 
-	// Some nodes can auto-generate some pins directly, 
-	// so let them append their pins into our arrays first.
-	if (IFlowDataPinGeneratorNodeInterface* AutoGeneratorNode = Cast<IFlowDataPinGeneratorNodeInterface>(&FlowNode))
+FFlowAssetEditBatch::FFlowAssetEditBatch(UFlowAsset* InFlowAsset, const FText& TransactionDescription)
+	: FlowAsset(InFlowAsset)
+	, Transaction(MakeUnique<FScopedTransaction>(TransactionDescription))
+{
+	if (InFlowAsset)
 	{
-		AutoGeneratorNode->AutoGenerateDataPins(
-			WorkingData.PinNameToBoundPropertyNameMapNext,
-			WorkingData.AutoInputDataPinsNext,
-			WorkingData.AutoOutputDataPinsNext);
+		InFlowAsset->Modify();
+		InFlowAsset->BeginEditBatch();
 	}
+}
 
-	// Try to harvest pins to auto-generate and/or bind to for each property in the flow node
-	for (TFieldIterator<FProperty> PropertyIt(FlowNodeClass); PropertyIt; ++PropertyIt)
+FFlowAssetEditBatch::~FFlowAssetEditBatch()
+{
+	// deferred notifications are recorded by the transaction, which ends with the destruction of members
+	if (UFlowAsset* Asset = FlowAsset.Get())
 	{
-		HarvestFlowPinMetadataForProperty(*PropertyIt, WorkingData);
+		Asset->EndEditBatch();
 	}
+}
 
-	// Check if the pin name to bound property map changed
-	WorkingData.bPinNameMapChanged |= WorkingData.DidPinNameToBoundPropertyNameMapChange();
-
-	// If the auto-generated data pins array changed, it counts as dirty as well
-	const bool bAutoInputDataPinsChanged = WorkingData.DidAutoInputDataPinsChange();
-	const bool bAutoOutputDataPinsChanged = WorkingData.DidAutoOutputDataPinsChange();
+void UFlowAsset::BeginEditBatch()
+{
+	if (EditBatchDepth++ == 0)
+	{
+		bEditBatchHarvestPending = false;
+		bEditBatchGraphChanged = false;
+	}
+}
 
-	if (WorkingData.bPinNameMapChanged || bAutoInputDataPinsChanged || bAutoOutputDataPinsChanged)
+void UFlowAsset::EndEditBatch()
+{
+	check(EditBatchDepth > 0);
+	if (--EditBatchDepth > 0)
 	{
-		FlowNode.SetFlags(RF_Transactional);
-		FlowNode.Modify();
+		return;
+	}
 
-		// Lock-in the data that changed.
-		if (WorkingData.bPinNameMapChanged)
+	// every changed node is notified once, no matter how many times it changed during the batch
+	TSet<TWeakObjectPtr<UFlowNode>> ChangedNodes = MoveTemp(EditBatchChangedNodes);
+	for (const TWeakObjectPtr<UFlowNode>& ChangedNode : ChangedNodes)
+	{
+		if (UFlowNode* FlowNode = ChangedNode.Get())
 		{
-			FlowNode.SetPinNameToBoundPropertyNameMap(WorkingData.PinNameToBoundPropertyNameMapNext);
+			FlowNode->PostEditChange();
 		}
+	}
 
-		if (bAutoInputDataPinsChanged || bAutoOutputDataPinsChanged)
-		{
-			if (bAutoInputDataPinsChanged)
-			{
-				FlowNode.SetAutoInputDataPins(WorkingData.AutoInputDataPinsNext);
-			}
+	if (bEditBatchGraphChanged && FlowGraph)
+	{
+		// the graph harvests connections while refreshing
+		FlowGraph->NotifyGraphChanged();
+	}
+	else if (bEditBatchHarvestPending)
+	{
+		HarvestNodeConnections();
+	}
 
-			if (bAutoOutputDataPinsChanged)
-			{
-				FlowNode.SetAutoOutputDataPins(WorkingData.AutoOutputDataPinsNext);
-			}
-		}
+	bEditBatchHarvestPending = false;
+	bEditBatchGraphChanged = false;
+}
 
+void UFlowAsset::NotifyNodeEdited(UFlowNode& FlowNode)
+{
+	if (IsEditBatchActive())
+	{
+		EditBatchChangedNodes.Add(&FlowNode);
+	}
+	else
+	{
 		FlowNode.PostEditChange();
+	}
+}
+
+void UFlowAsset::SchedulePatchRunningInstances()
+{
+	if (!GFlowLivePatchInstances || IsInstanceInitialized() || ActiveInstances.IsEmpty() || GEditor == nullptr || GEditor->PlayWorld == nullptr)
+	{
+		return;
+	}
+
+	// edits of many nodes are applied in one pass
+	if (!PatchInstancesTickerHandle.IsValid())
+	{
+		PatchInstancesTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowAsset::PatchRunningInstances));
+	}
+}
+
+bool UFlowAsset::PatchRunningInstances(float DeltaTime)
+{
+	PatchInstancesTickerHandle.Reset();
+
+	if (GEditor && GEditor->PlayWorld)
+	{
+		// patching doesn't add or remove instances, the copy only guards against node callbacks finishing the flow
+		const TArray<UFlowAsset*> Instances = ObjectPtrDecay(ActiveInstances);
+		for (UFlowAsset* Instance : Instances)
+		{
+			if (IsValid(Instance) && Instance->IsInstanceInitialized())
+			{
+				Instance->PatchInstance();
+			}
+		}
+	}
+
+	// one-shot ticker
+	return false;
+}
+
+void UFlowAsset::HarvestNodeConnectionsIfNeeded()
+{
+	if (bFullHarvestPending)
+	{
+		HarvestNodeConnections();
+	}
+}
+
+bool UFlowAsset::TryUpdateManagedFlowPinsForNode(UFlowNode& FlowNode)
+{
+	const UClass* FlowNodeClass = FlowNode.GetClass();
+	if (!IsValid(FlowNodeClass))
+	{
+		return false;
+	}
+
+	// Setup the working data struct
+	FFlowHarvestDataPinsWorkingData WorkingData =
+		FFlowHarvestDataPinsWorkingData(
+			FlowNode,
+			FlowNode.GetPinNameToBoundPropertyNameMap(),
+			FlowNode.GetAutoInputDataPins(),
+			FlowNode.GetAutoOutputDataPins());
+
+	// Some nodes can auto-generate some pins directly, 
+	// so let them append their pins into our arrays first.
+	if (IFlowDataPinGeneratorNodeInterface* AutoGeneratorNode = Cast<IFlowDataPinGeneratorNodeInterface>(&FlowNode))
+	{
+		AutoGeneratorNode->AutoGenerateDataPins(
+			WorkingData.PinNameToBoundPropertyNameMapNext,
+			WorkingData.AutoInputDataPinsNext,
+			WorkingData.AutoOutputDataPinsNext);
+	}
+
+	// Try to harvest pins to auto-generate and/or bind to for each property in the flow node
+	// Blueprint classes are recompiled in place, so only their native ancestors use cached properties
+	const UClass* NativeClass = FlowNodeClass;
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		for (TFieldIterator<FProperty> PropertyIt(NativeClass, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+		{
+			HarvestFlowPinMetadataForProperty(*PropertyIt, WorkingData);
+		}
+
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	if (NativeClass)
+	{
+		for (const FProperty* Property : GetFlowPinMetadataProperties(*NativeClass))
+		{
+			HarvestFlowPinMetadataForProperty(Property, WorkingData);
+		}
+	}
+
+	// Check if the pin name to bound property map changed
+	WorkingData.bPinNameMapChanged |= WorkingData.DidPinNameToBoundPropertyNameMapChange();
+
+	// If the auto-generated data pins array changed, it counts as dirty as well
+	const bool bAutoInputDataPinsChanged = WorkingData.DidAutoInputDataPinsChange();
+	const bool bAutoOutputDataPinsChanged = WorkingData.DidAutoOutputDataPinsChange();
+
+	if (WorkingData.bPinNameMapChanged || bAutoInputDataPinsChanged || bAutoOutputDataPinsChanged)
+	{
+		FlowNode.SetFlags(RF_Transactional);
+		FlowNode.Modify();
+
+		// Lock-in the data that changed.
+		if (WorkingData.bPinNameMapChanged)
+		{
+			FlowNode.SetPinNameToBoundPropertyNameMap(WorkingData.PinNameToBoundPropertyNameMapNext);
+		}
+
+		if (bAutoInputDataPinsChanged || bAutoOutputDataPinsChanged)
+		{
+			if (bAutoInputDataPinsChanged)
+			{
+				FlowNode.SetAutoInputDataPins(WorkingData.AutoInputDataPinsNext);
+			}
+
+			if (bAutoOutputDataPinsChanged)
+			{
+				FlowNode.SetAutoOutputDataPins(WorkingData.AutoOutputDataPinsNext);
+			}
+		}
+
+		NotifyNodeEdited(FlowNode);
 
 		return true;
 	}
@@ -493,6 +1035,42 @@ bool UFlowAsset::TryUpdateManagedFlowPinsForNode(UFlowNode& FlowNode)
 	return false;
 }
 
+const TArray<const FProperty*>& UFlowAsset::GetFlowPinMetadataProperties(const UClass& NativeClass)
+{
+	// native classes don't change during the editor session, hot reload creates new classes
+	static TMap<const UClass*, TArray<const FProperty*>> PropertiesByClass;
+
+	if (const TArray<const FProperty*>* CachedProperties = PropertiesByClass.Find(&NativeClass))
+	{
+		return *CachedProperties;
+	}
+
+	TArray<const FProperty*> Properties;
+	for (TFieldIterator<FProperty> PropertyIt(&NativeClass); PropertyIt; ++PropertyIt)
+	{
+		if (HasFlowPinMetadata(**PropertyIt))
+		{
+			Properties.Add(*PropertyIt);
+		}
+	}
+
+	return PropertiesByClass.Add(&NativeClass, MoveTemp(Properties));
+}
+
+bool UFlowAsset::HasFlowPinMetadata(const FProperty& Property)
+{
+	if (Property.HasMetaData(FFlowPin::MetadataKey_SourceForOutputFlowPin)
+		|| Property.HasMetaData(FFlowPin::MetadataKey_DefaultForInputFlowPin)
+		|| Property.HasMetaData(FFlowPin::MetadataKey_FlowPinType))
+	{
+		return true;
+	}
+
+	const FStructProperty* StructProperty = CastField<FStructProperty>(&Property);
+	return StructProperty && StructProperty->Struct
+		&& (StructProperty->Struct->HasMetaData(FFlowPin::MetadataKey_DefaultForInputFlowPin) || StructProperty->Struct->HasMetaData(FFlowPin::MetadataKey_FlowPinType));
+}
+
 void UFlowAsset::HarvestFlowPinMetadataForProperty(const FProperty* Property, FFlowHarvestDataPinsWorkingData& InOutData)
 {
 	FText PinDisplayName = Property->GetDisplayNameText();
@@ -652,6 +1230,16 @@ void AddPinForPinType(EFlowPinType PinType, UFlowNode& FlowNode, const FProperty
 	FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
 
 	FFlowPin& NewFlowPin = InOutDataPinsNext->Add_GetRef(FFlowPin(PinAuthoredName, PinDisplayName));
+
+	// array wrappers and plain TArray properties generate array pins of their element type
+	const FStructProperty* ArrayWrapperProperty = CastField<FStructProperty>(&Property);
+	if (ArrayWrapperProperty && !ArrayWrapperProperty->Struct->IsChildOf(FFlowDataPinArrayProperty::StaticStruct()))
+	{
+		ArrayWrapperProperty = nullptr;
+	}
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(&Property);
+	NewFlowPin.SetIsArray(ArrayWrapperProperty != nullptr || ArrayProperty != nullptr);
+
 	switch (PinType)
 	{
 	case EFlowPinType::Enum:
@@ -725,7 +1313,21 @@ void AddPinForPinType(EFlowPinType PinType, UFlowNode& FlowNode, const FProperty
 	case EFlowPinType::Object:
 		{
 			UClass* Class = nullptr;
-			if (const FStructProperty* StructProperty = CastField<FStructProperty>(&Property))
+			if (ArrayWrapperProperty)
+			{
+				if (ArrayWrapperProperty->Struct->IsChildOf(FFlowDataPinOutputProperty_ObjectArray::StaticStruct()))
+				{
+					Class = ArrayWrapperProperty->ContainerPtrToValuePtr<FFlowDataPinOutputProperty_ObjectArray>(&FlowNode)->ClassFilter;
+				}
+			}
+			else if (ArrayProperty)
+			{
+				if (const FObjectProperty* ElementProperty = CastField<FObjectProperty>(ArrayProperty->Inner))
+				{
+					Class = ElementProperty->PropertyClass;
+				}
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(&Property))
 			{
 				const UStruct* ScriptStruct = TObjectProperty::StaticStruct();
 				static const UStruct* SoftObjectPathStruct = TBaseStructure<FSoftObjectPath>::Get();
@@ -836,6 +1438,15 @@ bool UFlowAsset::TryCreateFlowDataPinFromMetadataValue(
 
 		if (MetadataValueAsName == EnumValueAsName)
 		{
+			// plain TArray properties are viewed in place, so their elements must be stored as the pin type's array storage
+			const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(&Property);
+			if (ArrayProperty && FFlowDataPinProperty::GetArrayElementPinType(*ArrayProperty->Inner) != PinType)
+			{
+				LogError(FString::Printf(TEXT("Array property %s can't supply %s array pins, see TFlowDataPinArrayElementTraits for the element types"), *Property.GetName(), *MetadataValue), &FlowNode);
+
+				return false;
+			}
+
 			if (bIsInputPin)
 			{
 				AddPinForPinType<
@@ -883,6 +1494,28 @@ bool UFlowAsset::TryCreateFlowDataPinFromMetadataValue(
 
 #endif
 
+void UFlowAsset::RebuildReverseConnections()
+{
+	ReverseConnections.Reset();
+
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		if (!IsValid(Node.Value))
+		{
+			continue;
+		}
+
+		for (const TPair<FName, FConnectedPin>& Connection : Node.Value->Connections)
+		{
+			// data output might be connected to multiple inputs, keep the first one (matches the previous linear search)
+			if (!ReverseConnections.Contains(Connection.Value))
+			{
+				ReverseConnections.Add(Connection.Value, FConnectedPin(Node.Key, Connection.Key));
+			}
+		}
+	}
+}
+
 UFlowNode* UFlowAsset::GetDefaultEntryNode() const
 {
 	UFlowNode* FirstStartNode = nullptr;
@@ -940,75 +1573,86 @@ void UFlowAsset::RemoveCustomOutput(const FName& EventName)
 }
 #endif // WITH_EDITOR
 
-UFlowNode_CustomInput* UFlowAsset::TryFindCustomInputNodeByEventName(const FName& EventName) const
+const FFlowCustomEventNodes& UFlowAsset::GetCustomEventNodes() const
 {
-	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	// instances share the nodes of the template, their Nodes map is keyed by the same guids
+	if (TemplateAsset)
 	{
-		if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value))
-		{
-			if (CustomInput->GetEventName() == EventName)
-			{
-				return CustomInput;
-			}
-		}
+		return TemplateAsset->GetCustomEventNodes();
 	}
 
-	return nullptr;
+	if (!CustomEventNodes.IsValid())
+	{
+		const TSharedRef<FFlowCustomEventNodes> NewCustomEventNodes = MakeShared<FFlowCustomEventNodes>();
+		NewCustomEventNodes->Gather(Nodes);
+		CustomEventNodes = NewCustomEventNodes;
+	}
+
+	return *CustomEventNodes;
 }
 
-UFlowNode_CustomOutput* UFlowAsset::TryFindCustomOutputNodeByEventName(const FName& EventName) const
+UFlowNode_CustomInput* UFlowAsset::TryFindCustomInputNodeByEventName(const FName& EventName) const
 {
-	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
-	{
-		if (UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value))
-		{
-			if (CustomOutput->GetEventName() == EventName)
-			{
-				return CustomOutput;
-			}
-		}
-	}
+	const FGuid* NodeGuid = GetCustomEventNodes().InputNodes.Find(EventName);
+	return NodeGuid ? Cast<UFlowNode_CustomInput>(Nodes.FindRef(*NodeGuid)) : nullptr;
+}
 
-	return nullptr;
+UFlowNode_CustomOutput* UFlowAsset::TryFindCustomOutputNodeByEventName(const FName& EventName) const
+{
+	const FGuid* NodeGuid = GetCustomEventNodes().OutputNodes.Find(EventName);
+	return NodeGuid ? Cast<UFlowNode_CustomOutput>(Nodes.FindRef(*NodeGuid)) : nullptr;
 }
 
 TArray<FName> UFlowAsset::GatherCustomInputNodeEventNames() const
 {
 	// Runtime-safe gathering of the CustomInputs (which is editor-only data)
 	//  from the actual flow nodes
-	TArray<FName> Results;
-
-	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
-	{
-		if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value))
-		{
-			Results.Add(CustomInput->GetEventName());
-		}
-	}
-
-	return Results;
+	return GetCustomEventNodes().InputNames;
 }
 
 TArray<FName> UFlowAsset::GatherCustomOutputNodeEventNames() const
 {
 	// Runtime-safe gathering of the CustomOutputs (which is editor-only data)
 	//  from the actual flow nodes
-	TArray<FName> Results;
+	return GetCustomEventNodes().OutputNames;
+}
 
-	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
-	{
-		if (UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value))
-		{
-			Results.Add(CustomOutput->GetEventName());
-		}
-	}
+int32 UFlowAsset::FindCustomInputIndex(const FName& EventName) const
+{
+	const TArray<FName>& SortedInputNames = GetCustomEventNodes().SortedInputNames;
+	const int32 InputIndex = Algo::LowerBound(SortedInputNames, EventName, FNameLexicalLess());
+	return SortedInputNames.IsValidIndex(InputIndex) && SortedInputNames[InputIndex] == EventName ? InputIndex : INDEX_NONE;
+}
 
-	return Results;
+FName UFlowAsset::GetCustomInputName(const int32 InputIndex) const
+{
+	const TArray<FName>& SortedInputNames = GetCustomEventNodes().SortedInputNames;
+	return SortedInputNames.IsValidIndex(InputIndex) ? SortedInputNames[InputIndex] : NAME_None;
+}
+
+void UFlowAsset::InvalidateCustomEventNodes()
+{
+	CustomEventNodes.Reset();
 }
 
 TArray<UFlowNode*> UFlowAsset::GetNodesInExecutionOrder(UFlowNode* FirstIteratedNode, const TSubclassOf<UFlowNode> FlowNodeClass)
 {
 	TArray<UFlowNode*> FoundNodes;
+
+	if (const FFlowCompiledNodeList* EntryNodes = FindCompiledEntryNodes(FirstIteratedNode, FlowNodeClass))
+	{
+		FoundNodes.Reserve(EntryNodes->EntryNodesNum);
+		for (int32 Position = 0; Position < EntryNodes->EntryNodesNum; ++Position)
+		{
+			if (UFlowNode* Node = Nodes.FindRef(CompiledGraph->NodeGuids[EntryNodes->NodeIndices[Position]]))
+			{
+				FoundNodes.Emplace(Node);
+			}
+		}
+
+		return FoundNodes;
+	}
+
 	GetNodesInExecutionOrder<UFlowNode>(FirstIteratedNode, FoundNodes);
 
 	// filter out nodes by class
@@ -1025,13 +1669,38 @@ TArray<UFlowNode*> UFlowAsset::GetNodesInExecutionOrder(UFlowNode* FirstIterated
 }
 
 TArray<UFlowNode*> UFlowAsset::GatherNodesConnectedToAllInputs() const
+{
+	if (CompiledGraph.IsValid())
+	{
+		TArray<UFlowNode*> ConnectedNodes;
+		ConnectedNodes.Reserve(CompiledGraph->ConnectedNodes.NodeIndices.Num());
+
+		for (const int32 NodeIndex : CompiledGraph->ConnectedNodes.NodeIndices)
+		{
+			if (UFlowNode* Node = Nodes.FindRef(CompiledGraph->NodeGuids[NodeIndex]))
+			{
+				ConnectedNodes.Emplace(Node);
+			}
+		}
+
+		return ConnectedNodes;
+	}
+
+	int32 EntryNodesNum = 0;
+	return GatherNodesConnectedToAllInputs(EntryNodesNum);
+}
+
+TArray<UFlowNode*> UFlowAsset::GatherNodesConnectedToAllInputs(int32& OutEntryNodesNum) const
 {
 	TSet<TObjectKey<UFlowNode>> IteratedNodes;
 	TArray<UFlowNode*> ConnectedNodes;
 
 	// Nodes connected to the Start node
-	UFlowNode* DefaultEntryNode = GetDefaultEntryNode();
-	GetNodesInExecutionOrder_Recursive(DefaultEntryNode, IteratedNodes, ConnectedNodes);
+	if (UFlowNode* DefaultEntryNode = GetDefaultEntryNode())
+	{
+		GetNodesInExecutionOrder_Recursive(DefaultEntryNode, IteratedNodes, ConnectedNodes);
+	}
+	OutEntryNodesNum = ConnectedNodes.Num();
 
 	// Nodes connected to Custom Input node(s)
 	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
@@ -1045,9 +1714,43 @@ TArray<UFlowNode*> UFlowAsset::GatherNodesConnectedToAllInputs() const
 	return ConnectedNodes;
 }
 
+TConstArrayView<int32> UFlowAsset::GetCompiledNodesInExecutionOrder(const UClass* NodeClass) const
+{
+	if (CompiledGraph.IsValid())
+	{
+		return CompiledGraph->GetConnectedNodesOfClass(NodeClass, Nodes).NodeIndices;
+	}
+
+	return TConstArrayView<int32>();
+}
+
+const FFlowCompiledNodeList* UFlowAsset::FindCompiledEntryNodes(const UFlowNode* FirstIteratedNode, const UClass* NodeClass) const
+{
+	if (FirstIteratedNode && CompiledGraph.IsValid())
+	{
+		const FFlowCompiledNodeList& ConnectedNodes = CompiledGraph->ConnectedNodes;
+		if (ConnectedNodes.EntryNodesNum > 0 && CompiledGraph->NodeGuids[ConnectedNodes.NodeIndices[0]] == FirstIteratedNode->GetGuid())
+		{
+			return &CompiledGraph->GetConnectedNodesOfClass(NodeClass, Nodes);
+		}
+	}
+
+	return nullptr;
+}
+
 void UFlowAsset::AddInstance(UFlowAsset* Instance)
 {
 	ActiveInstances.Add(Instance);
+
+#if WITH_EDITOR
+	InstancesByDisplayName.Add(Instance->GetDisplayName(), Instance);
+	if (Instance->RootFlowActorOwner.IsValid())
+	{
+		InstancesByActorOwner.Add(Instance->RootFlowActorOwner, Instance);
+	}
+
+	InstanceListChangedEvent.Broadcast(Instance, true);
+#endif
 }
 
 int32 UFlowAsset::RemoveInstance(UFlowAsset* Instance)
@@ -1057,30 +1760,97 @@ int32 UFlowAsset::RemoveInstance(UFlowAsset* Instance)
 	{
 		SetInspectedInstance(NAME_None);
 	}
+
+	if (ActiveInstances.Contains(Instance))
+	{
+		RemoveInstanceLookups(Instance);
+		InstanceListChangedEvent.Broadcast(Instance, false);
+	}
 #endif
 
 	ActiveInstances.Remove(Instance);
 	return ActiveInstances.Num();
 }
 
-void UFlowAsset::ClearInstances()
+int32 UFlowAsset::RemoveInstances(const TSet<const UFlowAsset*>& Instances)
 {
 #if WITH_EDITOR
-	if (InspectedInstance.IsValid())
+	if (InspectedInstance.IsValid() && Instances.Contains(InspectedInstance.Get()))
 	{
 		SetInspectedInstance(NAME_None);
 	}
 #endif
 
-	for (int32 i = ActiveInstances.Num() - 1; i >= 0; i--)
+	ActiveInstances.RemoveAll([this, &Instances](const TObjectPtr<UFlowAsset>& Instance)
 	{
-		if (ActiveInstances.IsValidIndex(i) && ActiveInstances[i])
+		if (Instances.Contains(Instance))
 		{
-			ActiveInstances[i]->FinishFlow(EFlowFinishPolicy::Keep);
+#if WITH_EDITOR
+			RemoveInstanceLookups(Instance);
+#endif
+			return true;
 		}
-	}
+		return false;
+	});
+
+#if WITH_EDITOR
+	InstanceListChangedEvent.Broadcast(nullptr, false);
+#endif
+	return ActiveInstances.Num();
+}
+
+#if WITH_EDITOR
+void UFlowAsset::RemoveInstanceLookups(const UFlowAsset* Instance)
+{
+	if (Instance == nullptr)
+	{
+		return;
+	}
+
+	InstancesByDisplayName.Remove(Instance->GetDisplayName());
+
+	// weak key still matches, if the owner is already gone
+	InstancesByActorOwner.RemoveSingle(Instance->RootFlowActorOwner, const_cast<UFlowAsset*>(Instance));
+}
+#endif
+
+void UFlowAsset::ClearInstances()
+{
+#if WITH_EDITOR
+	if (InspectedInstance.IsValid())
+	{
+		SetInspectedInstance(NAME_None);
+	}
+#endif
+
+	for (int32 i = ActiveInstances.Num() - 1; i >= 0; i--)
+	{
+		if (ActiveInstances.IsValidIndex(i) && ActiveInstances[i])
+		{
+			ActiveInstances[i]->FinishFlow(EFlowFinishPolicy::Keep);
+		}
+	}
 
 	ActiveInstances.Empty();
+
+#if WITH_EDITOR
+	InstancesByDisplayName.Empty();
+	InstancesByActorOwner.Empty();
+	InstanceListChangedEvent.Broadcast(nullptr, false);
+#endif
+}
+
+SIZE_T UFlowAsset::GetInstancesResourceSize() const
+{
+	SIZE_T Size = 0;
+	for (UFlowAsset* Instance : ActiveInstances)
+	{
+		if (IsValid(Instance))
+		{
+			Size += Instance->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+	return Size;
 }
 
 #if WITH_EDITOR
@@ -1098,22 +1868,42 @@ void UFlowAsset::SetInspectedInstance(const FName& NewInspectedInstanceName)
 	{
 		InspectedInstance = nullptr;
 	}
-	else
+	else if (UFlowAsset* ActiveInstance = FindInstanceByDisplayName(NewInspectedInstanceName))
+	{
+		InspectedInstance = ActiveInstance;
+	}
+
+	BroadcastDebuggerRefresh();
+}
+
+void UFlowAsset::SetInspectedInstance(UFlowAsset* NewInspectedInstance)
+{
+	InspectedInstance = NewInspectedInstance && NewInspectedInstance->GetTemplateAsset() == this ? NewInspectedInstance : nullptr;
+	BroadcastDebuggerRefresh();
+}
+
+UFlowAsset* UFlowAsset::FindInstanceByDisplayName(const FName& DisplayName) const
+{
+	return InstancesByDisplayName.FindRef(DisplayName).Get();
+}
+
+UFlowAsset* UFlowAsset::FindInstanceByActorOwner(const AActor* ActorOwner) const
+{
+	UFlowAsset* FoundInstance = nullptr;
+	for (auto It = InstancesByActorOwner.CreateConstKeyIterator(const_cast<AActor*>(ActorOwner)); It; ++It)
 	{
-		for (UFlowAsset* ActiveInstance : ActiveInstances)
+		if (UFlowAsset* Instance = It.Value().Get())
 		{
-			if (ActiveInstance && ActiveInstance->GetDisplayName() == NewInspectedInstanceName)
+			if (Instance == InspectedInstance)
 			{
-				if (!InspectedInstance.IsValid() || InspectedInstance != ActiveInstance)
-				{
-					InspectedInstance = ActiveInstance;
-				}
-				break;
+				return Instance;
 			}
+
+			FoundInstance = FoundInstance ? FoundInstance : Instance;
 		}
 	}
 
-	BroadcastDebuggerRefresh();
+	return FoundInstance;
 }
 
 void UFlowAsset::BroadcastDebuggerRefresh() const
@@ -1133,22 +1923,326 @@ void UFlowAsset::InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlow
 
 	Owner = InOwner;
 	TemplateAsset = &InTemplateAsset;
+	CustomInputNodes.Empty();
+	ResolveFlowOwner();
+
+	// only the server replicates, clients might run their own instances of the same asset
+	UFlowComponent* OwnerComponent = Cast<UFlowComponent>(InOwner.Get());
+	if (InTemplateAsset.bReplicateInstanceState && OwnerComponent && OwnerComponent->GetOwnerRole() == ROLE_Authority && OwnerComponent->GetNetMode() != NM_Standalone)
+	{
+		ReplicatingComponent = OwnerComponent;
+	}
+
+	bLeanServerInstance = UFlowSettings::Get()->IsLeanServer(InOwner.IsValid() ? InOwner->GetWorld() : nullptr);
+
+	InTemplateAsset.GetOrCompileGraph();
+	CompiledGraph = InTemplateAsset.CompiledGraph;
+
+	CompiledNodes.SetNum(CompiledGraph->GetNodesNum());
+	for (int32 NodeIndex = 0; NodeIndex < CompiledNodes.Num(); ++NodeIndex)
+	{
+		CompiledNodes[NodeIndex] = Nodes.FindRef(CompiledGraph->NodeGuids[NodeIndex]);
+	}
+	NodeStates.Init(EFlowNodeState::NeverActivated, CompiledNodes.Num());
 
 	for (TPair<FGuid, TObjectPtr<UFlowNode>>& Node : Nodes)
 	{
-		UFlowNode* NewNodeInstance = NewObject<UFlowNode>(this, Node.Value->GetClass(), NAME_None, RF_Transient, Node.Value, false, nullptr);
-		Node.Value = NewNodeInstance;
+		// entry nodes are needed immediately, nodes already instantiated by the pooled instance are cheap to reinitialize
+		if (!InTemplateAsset.bLazyNodeInstantiation || InTemplateAsset.bClusterInstances || IsNodeInstantiated(Node.Value) || Node.Value->IsA<UFlowNode_Start>() || Node.Value->IsA<UFlowNode_CustomInput>())
+		{
+			InstantiateNode(Node.Value);
+		}
+	}
+
+	UpdateCanExecuteIsolated();
+	CreateInstanceCluster();
+}
+
+#if WITH_EDITOR
+void UFlowAsset::PatchInstance()
+{
+	check(IsInstanceInitialized());
+
+	UFlowAsset& Template = *TemplateAsset;
+	const TSharedPtr<const FFlowCompiledGraph> OldGraph = CompiledGraph;
+	Template.GetOrCompileGraph();
+
+	int32 PatchedNodesNum = 0;
+
+	// nodes removed from the template are deactivated, like on finishing the flow
+	TSet<const UFlowNode*> RemovedNodes;
+	for (auto NodeIt = Nodes.CreateIterator(); NodeIt; ++NodeIt)
+	{
+		if (Template.Nodes.Contains(NodeIt.Key()))
+		{
+			continue;
+		}
+
+		UFlowNode* Node = NodeIt.Value();
+		if (IsValid(Node) && IsNodeInstantiated(Node))
+		{
+			if (IsNodeActive(*Node))
+			{
+				Node->Deactivate();
+				RemoveActiveNode(*Node);
+			}
+
+			if (PreloadedNodes.Remove(Node) > 0)
+			{
+				Node->TriggerFlush();
+			}
+
+			RecordedNodes.Remove(Node);
+			Node->DeinitializeInstance();
+		}
+
+		RemovedNodes.Add(Node);
+		NodeIt.RemoveCurrent();
+	}
 
-		if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(NewNodeInstance))
+	if (!RemovedNodes.IsEmpty())
+	{
+		TArray<FFlowQueuedTrigger> PendingTriggers;
+		for (int32 Index = TriggerQueueHead; Index < TriggerQueue.Num(); ++Index)
 		{
-			if (!CustomInput->EventName.IsNone())
+			if (!RemovedNodes.Contains(TriggerQueue[Index].Node))
 			{
-				CustomInputNodes.Emplace(CustomInput);
+				PendingTriggers.Add(TriggerQueue[Index]);
 			}
 		}
+		TriggerQueue = MoveTemp(PendingTriggers);
+		TriggerQueueHead = 0;
+	}
+
+	TArray<FGuid> AddedNodes;
+	for (const TPair<FGuid, UFlowNode*>& TemplateNode : ObjectPtrDecay(Template.Nodes))
+	{
+		if (!IsValid(TemplateNode.Value))
+		{
+			continue;
+		}
+
+		TObjectPtr<UFlowNode>* Node = Nodes.Find(TemplateNode.Key);
+		if (Node == nullptr)
+		{
+			Nodes.Add(TemplateNode.Key, TemplateNode.Value);
+			AddedNodes.Add(TemplateNode.Key);
+		}
+		else if (!IsNodeInstantiated(*Node))
+		{
+			// not instantiated yet, the node might have been recreated with a different class
+			*Node = TemplateNode.Value;
+		}
+		else if ((*Node)->GetClass() == TemplateNode.Value->GetClass())
+		{
+			PatchNodeInstance(**Node, *TemplateNode.Value);
+			PatchedNodesNum++;
+		}
+		else
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Node %s of %s changed its class, it's patched only after restarting the instance"), *TemplateNode.Key.ToString(), *GetName());
+		}
+	}
+
+	// dense indices of the new graph, node states follow their guids
+	CompiledGraph = Template.CompiledGraph;
+
+	TArray<EFlowNodeState> OldNodeStates = MoveTemp(NodeStates);
+	NodeStates.Init(EFlowNodeState::NeverActivated, CompiledGraph->GetNodesNum());
+	CompiledNodes.Reset();
+	CompiledNodes.SetNum(CompiledGraph->GetNodesNum());
+
+	for (int32 NodeIndex = 0; NodeIndex < CompiledNodes.Num(); ++NodeIndex)
+	{
+		const FGuid& NodeGuid = CompiledGraph->NodeGuids[NodeIndex];
+		const int32 OldNodeIndex = OldGraph.IsValid() ? OldGraph->FindNodeIndex(NodeGuid) : INDEX_NONE;
+		if (OldNodeStates.IsValidIndex(OldNodeIndex))
+		{
+			NodeStates[NodeIndex] = OldNodeStates[OldNodeIndex];
+		}
+
+		UFlowNode* Node = Nodes.FindRef(NodeGuid);
+		CompiledNodes[NodeIndex] = Node;
+		if (IsNodeInstantiated(Node))
+		{
+			Node->CompiledNodeIndex = NodeIndex;
+		}
+	}
+
+	// event names of Custom Inputs might have been edited
+	CustomInputNodes.Empty();
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		const UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value);
+		if (CustomInput && IsNodeInstantiated(CustomInput) && !CustomInput->EventName.IsNone())
+		{
+			CustomInputNodes.AddUnique(CustomInput->EventName, const_cast<UFlowNode_CustomInput*>(CustomInput));
+		}
+	}
+
+	// same rules as InitializeInstance
+	for (const FGuid& NodeGuid : AddedNodes)
+	{
+		TObjectPtr<UFlowNode>& Node = Nodes[NodeGuid];
+		if (!Template.bLazyNodeInstantiation || Template.bClusterInstances || Node->IsA<UFlowNode_Start>() || Node->IsA<UFlowNode_CustomInput>())
+		{
+			InstantiateNode(Node);
+		}
+	}
+
+	DataPinMemo.Empty();
+	DirtyReplicatedNodes.Empty();
+	MarkReplicatedNodeDirty(INDEX_NONE);
+	UpdateCanExecuteIsolated();
+
+	UE_LOG(LogFlow, Log, TEXT("Patched %s: %d nodes updated, %d added, %d removed"), *GetName(), PatchedNodesNum, AddedNodes.Num(), RemovedNodes.Num());
+}
+
+void UFlowAsset::PatchNodeInstance(UFlowNode& NodeInstance, const UFlowNode& TemplateNode)
+{
+	for (TFieldIterator<FProperty> PropertyIt(TemplateNode.GetClass()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		if (!Property->HasAnyPropertyFlags(CPF_Edit)
+			|| Property->HasAnyPropertyFlags(CPF_Transient | CPF_EditConst | CPF_SaveGame | CPF_InstancedReference | CPF_ContainsInstancedReference))
+		{
+			continue;
+		}
+
+		if (!Property->Identical_InContainer(&NodeInstance, &TemplateNode))
+		{
+			Property->CopyCompleteValue_InContainer(&NodeInstance, &TemplateNode);
+		}
+	}
+
+	// pins and connections are generated by the editor, not edited directly
+	NodeInstance.InputPins = TemplateNode.InputPins;
+	NodeInstance.OutputPins = TemplateNode.OutputPins;
+	NodeInstance.Connections = TemplateNode.Connections;
+	NodeInstance.SetAutoInputDataPins(TemplateNode.GetAutoInputDataPins());
+	NodeInstance.SetAutoOutputDataPins(TemplateNode.GetAutoOutputDataPins());
+	NodeInstance.SetPinNameToBoundPropertyNameMap(TemplateNode.GetPinNameToBoundPropertyNameMap());
+
+	// event names are set by the details customization, not as an editable property
+	if (UFlowNode_CustomEventBase* CustomEvent = Cast<UFlowNode_CustomEventBase>(&NodeInstance))
+	{
+		CustomEvent->SetEventName(CastChecked<UFlowNode_CustomEventBase>(&TemplateNode)->GetEventName());
+	}
+
+	NodeInstance.UpdateNodeConfigText();
+}
+#endif
+
+UFlowNode* UFlowAsset::InstantiateNode(TObjectPtr<UFlowNode>& Node)
+{
+	// instance taken from the Flow Subsystem pool already contains node instances
+	UFlowNode* NewNodeInstance = CreateNodeInstance(Node);
+
+	if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(NewNodeInstance))
+	{
+		if (!CustomInput->EventName.IsNone())
+		{
+			CustomInputNodes.AddUnique(CustomInput->EventName, CustomInput);
+		}
+	}
+
+	const int32 NodeIndex = CompiledGraph.IsValid() ? CompiledGraph->FindNodeIndex(NewNodeInstance->GetGuid()) : INDEX_NONE;
+	if (NodeIndex != INDEX_NONE)
+	{
+		CompiledNodes[NodeIndex] = NewNodeInstance;
+		NewNodeInstance->CompiledNodeIndex = NodeIndex;
+
+		// node finished before its instance was released
+		if (NodeStates.IsValidIndex(NodeIndex) && EFlowNodeState_Classifiers::IsFinishedState(NodeStates[NodeIndex]))
+		{
+			NewNodeInstance->ActivationState = NodeStates[NodeIndex];
+		}
+	}
+
+	NewNodeInstance->InitializeInstance();
+	return NewNodeInstance;
+}
+
+UFlowNode* UFlowAsset::CreateNodeInstance(TObjectPtr<UFlowNode>& Node)
+{
+	if (!IsNodeInstantiated(Node))
+	{
+		UFlowNode* NewNodeInstance = NewObject<UFlowNode>(this, Node->GetClass(), NAME_None, RF_Transient, Node, false, nullptr);
+
+		if (UFlowSettings::Get()->bShareTemplateNodeData)
+		{
+			NewNodeInstance->ShareTemplateNodeData(*Node);
+		}
+
+		Node = NewNodeInstance;
+	}
+
+	return Node;
+}
+
+void UFlowAsset::CreateNodeInstances()
+{
+	check(!IsInstanceInitialized());
+
+	for (TPair<FGuid, TObjectPtr<UFlowNode>>& Node : Nodes)
+	{
+		if (Node.Value)
+		{
+			CreateNodeInstance(Node.Value);
+		}
+	}
+}
+
+UFlowNode* UFlowAsset::GetOrCreateNodeInstance(const FGuid& NodeGuid)
+{
+	TObjectPtr<UFlowNode>* Node = Nodes.Find(NodeGuid);
+	if (Node == nullptr || *Node == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (IsInstanceInitialized() && !IsNodeInstantiated(*Node))
+	{
+		return InstantiateNode(*Node);
+	}
+
+	return *Node;
+}
+
+int32 UFlowAsset::GetCompiledNodeIndex(const FGuid& NodeGuid)
+{
+	return GetOrCompileGraph().FindNodeIndex(NodeGuid);
+}
+
+void UFlowAsset::MarkReplicatedNodeDirty(const int32 NodeIndex)
+{
+	if (UFlowComponent* Component = ReplicatingComponent.Get())
+	{
+		if (NodeIndex != INDEX_NONE)
+		{
+			DirtyReplicatedNodes.Add(NodeIndex);
+		}
+
+		// replicating instances don't execute isolated, this only guards against the instance reaching a worker anyway
+		DeferIsolatedSideEffect([this, WeakComponent = TWeakObjectPtr<UFlowComponent>(Component)]()
+		{
+			if (UFlowComponent* ReplicatedComponent = WeakComponent.Get())
+			{
+				ReplicatedComponent->MarkReplicatedFlowStateDirty(this);
+			}
+		});
+	}
+}
 
-		NewNodeInstance->InitializeInstance();
+UFlowNode* UFlowAsset::GetOrCreateCompiledNodeInstance(const int32 NodeIndex)
+{
+	UFlowNode* Node = CompiledNodes[NodeIndex];
+	if (Node && !IsNodeInstantiated(Node))
+	{
+		return InstantiateNode(Nodes.FindChecked(CompiledGraph->NodeGuids[NodeIndex]));
 	}
+
+	return Node;
 }
 
 void UFlowAsset::DeinitializeInstance()
@@ -1157,16 +2251,62 @@ void UFlowAsset::DeinitializeInstance()
 	{
 		for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
 		{
-			if (IsValid(Node.Value))
+			if (IsValid(Node.Value) && IsNodeInstantiated(Node.Value))
 			{
 				Node.Value->DeinitializeInstance();
 			}
 		}
 
-		const int32 ActiveInstancesLeft = TemplateAsset->RemoveInstance(this);
-		if (ActiveInstancesLeft == 0 && GetFlowSubsystem())
+		CompiledNodes.Empty();
+		NodeStates.Empty();
+		CompiledGraph.Reset();
+		DataPinMemo.Empty();
+		bAbortRequested = false;
+
+#if WITH_EDITOR
+		// lookups are keyed by the owner, so they're removed before resetting it
+		TemplateAsset->RemoveInstanceLookups(this);
+#endif
+#if FLOW_WITH_REMOTE_DEBUG
+		FFlowRemoteDebug::OnInstanceDeinitialized(*this);
+#endif
+		ResetFlowOwner();
+
+		bCanExecuteIsolated = false;
+		bIsolatedFinishRequested = false;
+		IsolatedSideEffects.Empty();
+		DissolveInstanceCluster();
+
+		// pooled instance is handed out again with full significance, until the subsystem evaluates its new owner
+		SignificanceLevel = EFlowSignificance::Full;
+		Significance = 1.0f;
+
+		// component removes the replicated state of the deinitialized instance
+		MarkReplicatedNodeDirty(INDEX_NONE);
+		ReplicatingComponent.Reset();
+		DirtyReplicatedNodes.Empty();
+
+		if (GetFlowSubsystem())
+		{
+			GetFlowSubsystem()->UnregisterInstanceId(*this);
+		}
+
+		INC_DWORD_STAT(STAT_FlowFinishedInstances);
+		CSV_CUSTOM_STAT(Flow, InstancesFinished, 1, ECsvCustomStatOp::Accumulate);
+
+		// timers of finished nodes are cleared already, this drops the paused state before the instance is pooled
+		if (GetFlowSubsystem())
+		{
+			GetFlowSubsystem()->ClearFlowTimers(this);
+		}
+
+		if (!bTeardownBatched)
 		{
-			GetFlowSubsystem()->RemoveInstancedTemplate(TemplateAsset);
+			const int32 ActiveInstancesLeft = TemplateAsset->RemoveInstance(this);
+			if (ActiveInstancesLeft == 0 && GetFlowSubsystem())
+			{
+				GetFlowSubsystem()->RemoveInstancedTemplate(TemplateAsset);
+			}
 		}
 
 		TemplateAsset = nullptr;
@@ -1176,27 +2316,37 @@ void UFlowAsset::DeinitializeInstance()
 void UFlowAsset::PreStartFlow()
 {
 	ResetNodes();
+	MarkSaveDataDirty();
 
 #if WITH_EDITOR
 	check(IsInstanceInitialized());
 
-	if (TemplateAsset->ActiveInstances.Num() == 1)
+	// debugger doesn't inspect lean server instances
+	if (!IsLeanServerInstance())
 	{
-		// this instance is the only active one, set it directly as Inspected Instance
-		TemplateAsset->SetInspectedInstance(GetDisplayName());
-	}
-	else
-	{
-		// request to refresh list to show newly created instance
-		TemplateAsset->BroadcastDebuggerRefresh();
+		if (TemplateAsset->ActiveInstances.Num() == 1)
+		{
+			// this instance is the only active one, set it directly as Inspected Instance
+			TemplateAsset->SetInspectedInstance(GetDisplayName());
+		}
+		else
+		{
+			// request to refresh list to show newly created instance
+			TemplateAsset->BroadcastDebuggerRefresh();
+		}
 	}
 #endif
 }
 
 void UFlowAsset::StartFlow(IFlowDataPinValueSupplierInterface* DataPinValueSupplier)
 {
+	FLOW_TRACE_SCOPE_TEXT(TEXT("StartFlow %s"), *GetNameSafe(TemplateAsset));
+
 	PreStartFlow();
 
+	TelemetryStartTime = FLOW_TELEMETRY_TIME();
+	bTelemetryFirstOutputRecorded = false;
+
 	if (UFlowNode* ConnectedEntryNode = GetDefaultEntryNode())
 	{
 		RecordedNodes.Add(ConnectedEntryNode);
@@ -1212,14 +2362,21 @@ void UFlowAsset::StartFlow(IFlowDataPinValueSupplierInterface* DataPinValueSuppl
 
 void UFlowAsset::FinishFlow(const EFlowFinishPolicy InFinishPolicy, const bool bRemoveInstance /*= true*/)
 {
+	FLOW_TRACE_SCOPE_TEXT(TEXT("FinishFlow %s"), *GetNameSafe(TemplateAsset));
+
 	FinishPolicy = InFinishPolicy;
 
+	FLOW_TELEMETRY_RECORD(this, InstanceLifetime, TelemetryStartTime);
+	TelemetryStartTime = 0.0;
+
 	// end execution of this asset and all of its nodes
 	for (UFlowNode* Node : ActiveNodes)
 	{
 		Node->Deactivate();
 	}
-	ActiveNodes.Empty();
+	ClearActiveNodes();
+	ClearTriggerQueue();
+	MarkReplicatedNodeDirty(INDEX_NONE);
 
 	// flush preloaded content
 	for (UFlowNode* PreloadedNode : PreloadedNodes)
@@ -1231,7 +2388,13 @@ void UFlowAsset::FinishFlow(const EFlowFinishPolicy InFinishPolicy, const bool b
 	// provides option to finish game-specific logic prior to removing asset instance 
 	if (bRemoveInstance)
 	{
+		UFlowAsset* FinishedTemplate = TemplateAsset;
 		DeinitializeInstance();
+
+		if (FinishedTemplate && GetFlowSubsystem())
+		{
+			GetFlowSubsystem()->ReleaseFlowInstance(this, FinishedTemplate);
+		}
 	}
 }
 
@@ -1251,16 +2414,55 @@ AActor* UFlowAsset::TryFindActorOwner() const
 	return nullptr;
 }
 
-TWeakObjectPtr<UFlowAsset> UFlowAsset::GetFlowInstance(UFlowNode_SubGraph* SubGraphNode) const
+void UFlowAsset::ResolveFlowOwner()
 {
-	return ActiveSubGraphs.FindRef(SubGraphNode);
-}
+	ResetFlowOwner();
 
-void UFlowAsset::TriggerCustomInput_FromSubGraph(UFlowNode_SubGraph* SubGraphNode, const FName& EventName) const
-{
-	// NOTE (gtaylor) Custom Input nodes cannot currently add data pins (like Start or DefineProperties nodes can)
-	// but we may want to allow them to source parameters, so I am providing the subgraph node as the 
-	// IFlowDataPinValueSupplierInterface when triggering the node (even though it's not used at this time).
+	UObject* RootFlowOwner = Owner.Get();
+	if (!IsValid(RootFlowOwner))
+	{
+		return;
+	}
+
+	RootFlowActorOwner = Cast<AActor>(RootFlowOwner);
+	if (!RootFlowActorOwner.IsValid())
+	{
+		if (const UActorComponent* OwnerComponent = Cast<UActorComponent>(RootFlowOwner))
+		{
+			RootFlowActorOwner = OwnerComponent->GetOwner();
+		}
+	}
+
+	const UClass* OwnerClass = GetExpectedOwnerClass();
+	if (IsValid(OwnerClass))
+	{
+		FlowOwnerInterface = UFlowNodeBase::TryGetFlowOwnerInterfaceFromRootFlowOwner(*RootFlowOwner, *OwnerClass);
+		if (FlowOwnerInterface == nullptr)
+		{
+			FlowOwnerInterface = UFlowNodeBase::TryGetFlowOwnerInterfaceActor(*RootFlowOwner, *OwnerClass);
+		}
+
+		FlowOwnerInterfaceObject = FlowOwnerInterface ? Cast<UObject>(FlowOwnerInterface) : nullptr;
+	}
+}
+
+void UFlowAsset::ResetFlowOwner()
+{
+	FlowOwnerInterface = nullptr;
+	FlowOwnerInterfaceObject.Reset();
+	RootFlowActorOwner.Reset();
+}
+
+TWeakObjectPtr<UFlowAsset> UFlowAsset::GetFlowInstance(UFlowNode_SubGraph* SubGraphNode) const
+{
+	return ActiveSubGraphs.FindRef(SubGraphNode);
+}
+
+void UFlowAsset::TriggerCustomInput_FromSubGraph(UFlowNode_SubGraph* SubGraphNode, const FName& EventName) const
+{
+	// NOTE (gtaylor) Custom Input nodes cannot currently add data pins (like Start or DefineProperties nodes can)
+	// but we may want to allow them to source parameters, so I am providing the subgraph node as the 
+	// IFlowDataPinValueSupplierInterface when triggering the node (even though it's not used at this time).
 
 	const TWeakObjectPtr<UFlowAsset> FlowInstance = ActiveSubGraphs.FindRef(SubGraphNode);
 	if (FlowInstance.IsValid())
@@ -1271,28 +2473,35 @@ void UFlowAsset::TriggerCustomInput_FromSubGraph(UFlowNode_SubGraph* SubGraphNod
 
 void UFlowAsset::TriggerCustomInput(const FName& EventName, IFlowDataPinValueSupplierInterface* DataPinValueSupplier)
 {
-	for (UFlowNode_CustomInput* CustomInputNode : CustomInputNodes)
-	{
-		if (CustomInputNode->EventName == EventName)
-		{
-			RecordedNodes.Add(CustomInputNode);
+	// copied, as executing the input might instantiate other nodes of this instance
+	TArray<UFlowNode_CustomInput*, TInlineAllocator<4>> MatchingNodes;
+	CustomInputNodes.MultiFind(EventName, MatchingNodes, true);
 
-			// NOTE (gtaylor) Custom Input nodes cannot currently add data pins (like Start or DefineProperties nodes can)
-			// but we may want to allow them to source parameters, so I am providing the subgraph node as the 
-			// IFlowDataPinValueSupplierInterface when triggering the node (even though it's not used at this time).
+	for (UFlowNode_CustomInput* CustomInputNode : MatchingNodes)
+	{
+		RecordedNodes.Add(CustomInputNode);
 
-			if (IFlowNodeWithExternalDataPinSupplierInterface* ExternalPinSuppliedNode = Cast<IFlowNodeWithExternalDataPinSupplierInterface>(CustomInputNode))
-			{
-				ExternalPinSuppliedNode->SetDataPinValueSupplier(DataPinValueSupplier);
-			}
+		// NOTE (gtaylor) Custom Input nodes cannot currently add data pins (like Start or DefineProperties nodes can)
+		// but we may want to allow them to source parameters, so I am providing the subgraph node as the 
+		// IFlowDataPinValueSupplierInterface when triggering the node (even though it's not used at this time).
 
-			CustomInputNode->ExecuteInput(EventName);
+		if (IFlowNodeWithExternalDataPinSupplierInterface* ExternalPinSuppliedNode = Cast<IFlowNodeWithExternalDataPinSupplierInterface>(CustomInputNode))
+		{
+			ExternalPinSuppliedNode->SetDataPinValueSupplier(DataPinValueSupplier);
 		}
+
+		CustomInputNode->ExecuteInput(EventName);
 	}
 }
 
 void UFlowAsset::TriggerCustomOutput(const FName& EventName)
 {
+	if (!bTelemetryFirstOutputRecorded)
+	{
+		FLOW_TELEMETRY_RECORD(this, FirstOutputLatency, TelemetryStartTime);
+		bTelemetryFirstOutputRecorded = true;
+	}
+
 	if (NodeOwningThisAssetInstance.IsValid())
 	{
 		// it's a SubGraph
@@ -1310,49 +2519,838 @@ void UFlowAsset::TriggerCustomOutput(const FName& EventName)
 
 void UFlowAsset::TriggerInput(const FGuid& NodeGuid, const FName& PinName)
 {
-	if (UFlowNode* Node = Nodes.FindRef(NodeGuid))
+	if (UFlowNode* Node = GetOrCreateNodeInstance(NodeGuid))
+	{
+		TriggerNodeInput(*Node, PinName, Node->InputPins.Contains(PinName));
+	}
+}
+
+void UFlowAsset::TriggerConnectedInput(const UFlowNode& FromNode, const int32 OutputPinIndex)
+{
+	if (CompiledGraph.IsValid())
 	{
-		if (!ActiveNodes.Contains(Node))
+		if (const FFlowCompiledConnection* Connection = CompiledGraph->FindOutputConnection(FromNode.CompiledNodeIndex, OutputPinIndex))
 		{
-			ActiveNodes.Add(Node);
-			RecordedNodes.Add(Node);
+			if (!Connection->IsConnected())
+			{
+				return;
+			}
+
+			if (Connection->IsResolved())
+			{
+				UFlowNode* Node = GetOrCreateCompiledNodeInstance(Connection->NodeIndex);
+				if (Node && Node->InputPins.IsValidIndex(Connection->PinIndex))
+				{
+					TriggerNodeInput(*Node, Node->InputPins[Connection->PinIndex].PinName, true);
+					return;
+				}
+			}
 		}
+	}
 
-		Node->TriggerInput(PinName);
+	// fallback for nodes that aren't part of the compiled graph, or connections to unknown pins
+	const FName& PinName = FromNode.OutputPins[OutputPinIndex].PinName;
+	if (const FConnectedPin* ConnectedPin = FromNode.GetConnections().Find(PinName))
+	{
+		TriggerInput(ConnectedPin->NodeGuid, ConnectedPin->PinName);
 	}
 }
 
-void UFlowAsset::FinishNode(UFlowNode* Node)
+bool UFlowAsset::CheckTriggerStorm(const UFlowNode& Node, const FName& PinName)
 {
-	if (ActiveNodes.Contains(Node))
+	const UFlowSettings* Settings = UFlowSettings::Get();
+	if (Settings->MaxTriggersPerInstancePerFrame <= 0)
 	{
-		ActiveNodes.Remove(Node);
+		return true;
+	}
 
-		// if graph reached Finish and this asset instance was created by SubGraph node
-		if (Node->CanFinishGraph())
+	if (WatchdogFrame != GFrameCounter)
+	{
+		WatchdogFrame = GFrameCounter;
+		WatchdogTriggers = 0;
+		bTriggerStormDetected = false;
+	}
+
+	if (++WatchdogTriggers <= Settings->MaxTriggersPerInstancePerFrame)
+	{
+		return !bAbortRequested;
+	}
+
+	if (!bTriggerStormDetected)
+	{
+		// report once per frame, the offending node is usually a part of the loop
+		bTriggerStormDetected = true;
+		INC_DWORD_STAT(STAT_FlowTriggerStorms);
+		CSV_CUSTOM_STAT(Flow, TriggerStorms, 1, ECsvCustomStatOp::Accumulate);
+
+		UE_LOG(LogFlow, Error, TEXT("Flow '%s' executed more than %d node inputs in one frame, last was %s.%s (%s)"),
+			*GetPathName(), Settings->MaxTriggersPerInstancePerFrame, *Node.GetName(), *PinName.ToString(), *UEnum::GetDisplayValueAsText(Settings->TriggerStormResponse).ToString());
+
+		if (Settings->TriggerStormResponse == EFlowTriggerStormResponse::AbortInstance && !bAbortRequested)
 		{
-			if (NodeOwningThisAssetInstance.IsValid())
+			// nodes of this instance are still on the call stack, so it's aborted on the next tick
+			bAbortRequested = true;
+			TWeakObjectPtr<UFlowAsset> WeakThis = this;
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
 			{
-				NodeOwningThisAssetInstance.Get()->TriggerFirstOutput(true);
+				if (UFlowAsset* FlowInstance = WeakThis.Get())
+				{
+					FlowInstance->AbortFromWatchdog();
+				}
+				return false;
+			}));
+		}
+	}
+
+	return Settings->TriggerStormResponse == EFlowTriggerStormResponse::Log && !bAbortRequested;
+}
+
+void UFlowAsset::AbortFromWatchdog()
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr || !IsInstanceInitialized())
+	{
+		return;
+	}
+
+	if (UFlowNode_SubGraph* SubGraphNode = GetNodeOwningThisAssetInstance())
+	{
+		FlowSubsystem->RemoveSubFlow(SubGraphNode, EFlowFinishPolicy::Abort);
+	}
+	else
+	{
+		// owner might run several instances of the same template, only the one caught in the trigger storm is aborted
+		FlowSubsystem->FinishRootInstance(this, EFlowFinishPolicy::Abort);
+	}
+}
+
+void UFlowAsset::TriggerNodeInput(UFlowNode& Node, const FName& PinName, const bool bIsKnownPin)
+{
+	if (bIsExecutingIsolated)
+	{
+		// executed by the isolated drain loop
+		TriggerQueue.Emplace(&Node, PinName, bIsKnownPin, FLOW_TELEMETRY_TIME());
+		return;
+	}
+
+	if (CanExecuteIsolated())
+	{
+		// executed by the Flow Subsystem tick, in parallel with other isolated instances
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			TriggerQueue.Emplace(&Node, PinName, bIsKnownPin, FLOW_TELEMETRY_TIME());
+			FlowSubsystem->DeferTriggerQueue(this);
+			return;
+		}
+	}
+
+	if (DeferredInputsDepth > 0)
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			INC_DWORD_STAT(STAT_FlowDeferredTriggers);
+			TriggerQueue.Emplace(&Node, PinName, bIsKnownPin, FLOW_TELEMETRY_TIME());
+			FlowSubsystem->DeferTriggerQueue(this);
+			return;
+		}
+	}
+
+	if (!UFlowSettings::Get()->bUseTriggerQueue)
+	{
+		ExecuteNodeInput(Node, PinName, bIsKnownPin);
+		return;
+	}
+
+	// drained within the same call stack, so it's not sampled as the queue delay
+	TriggerQueue.Emplace(&Node, PinName, bIsKnownPin);
+
+	// nodes triggered while draining will be executed by the loop below, instead of growing the call stack
+	if (!bIsDrainingTriggerQueue)
+	{
+		DrainTriggerQueue();
+	}
+}
+
+void UFlowAsset::ExecuteNodeInput(UFlowNode& Node, const FName& PinName, const bool bIsKnownPin)
+{
+	if (!CheckTriggerStorm(Node, PinName))
+	{
+		return;
+	}
+
+	LastTriggerTime = FApp::GetCurrentTime();
+	bNodesHibernated = false;
+
+	if (AddActiveNode(Node))
+	{
+		RecordedNodes.Add(&Node);
+
+		if (Node.bPreloaded)
+		{
+			Node.LastPreloadUseTime = FPlatformTime::Seconds();
+		}
+
+		if (UFlowSettings::Get()->LookaheadPreloadDepth > 0)
+		{
+			UpdateLookaheadPreload();
+		}
+	}
+
+	const bool bMemoizeDataPins = UFlowSettings::Get()->bMemoizeDataPinValues;
+	if (bMemoizeDataPins)
+	{
+		BeginDataPinMemoScope();
+		InvalidateDataPinMemo(Node);
+	}
+
+	Node.TriggerInput_Internal(PinName, bIsKnownPin);
+
+	if (bMemoizeDataPins)
+	{
+		EndDataPinMemoScope();
+	}
+}
+
+void UFlowAsset::BeginDataPinMemoScope()
+{
+	DataPinMemoScopeDepth++;
+}
+
+void UFlowAsset::EndDataPinMemoScope()
+{
+	check(DataPinMemoScopeDepth > 0);
+
+	// trigger chain ended
+	if (--DataPinMemoScopeDepth == 0)
+	{
+		DataPinMemo.Reset();
+	}
+}
+
+void UFlowAsset::InvalidateDataPinMemo(const UFlowNode& SupplierNode)
+{
+	for (auto It = DataPinMemo.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == &SupplierNode)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UFlowAsset::DrainTriggerQueue()
+{
+	// resumed by the Flow Subsystem once significance rises
+	if (bIsDrainingTriggerQueue || SignificanceLevel == EFlowSignificance::Paused)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowDrainTriggerQueue);
+	CSV_SCOPED_TIMING_STAT(Flow, DrainTriggerQueue);
+	TGuardValue<bool> DrainingGuard(bIsDrainingTriggerQueue, true);
+
+	if (TriggerQueueFrame != GFrameCounter)
+	{
+		TriggerQueueFrame = GFrameCounter;
+		TriggersExecutedThisFrame = 0;
+	}
+
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	const int32 MaxTriggersPerFrame = SignificanceLevel == EFlowSignificance::Throttled
+		? UFlowSettings::Get()->ThrottledQueuedTriggersPerFrame : UFlowSettings::Get()->MaxQueuedTriggersPerFrame;
+
+	if (FlowSubsystem)
+	{
+		FlowSubsystem->BeginTriggerQueueDrain();
+	}
+
+	while (TriggerQueueHead < TriggerQueue.Num())
+	{
+		if (FlowSubsystem && ((MaxTriggersPerFrame > 0 && TriggersExecutedThisFrame >= MaxTriggersPerFrame) || FlowSubsystem->IsTriggerQueueFrameBudgetExceeded()))
+		{
+			// carry remaining activations over to the next frame
+			INC_DWORD_STAT_BY(STAT_FlowDeferredTriggers, TriggerQueue.Num() - TriggerQueueHead);
+			CSV_CUSTOM_STAT(Flow, DeferredTriggers, TriggerQueue.Num() - TriggerQueueHead, ECsvCustomStatOp::Accumulate);
+			FlowSubsystem->DeferTriggerQueue(this);
+			break;
+		}
+
+		const FFlowQueuedTrigger Trigger = TriggerQueue[TriggerQueueHead++];
+		++TriggersExecutedThisFrame;
+		FLOW_TELEMETRY_RECORD(this, TriggerQueueDelay, Trigger.QueuedTime);
+
+		if (IsValid(Trigger.Node))
+		{
+			ExecuteNodeInput(*Trigger.Node, Trigger.PinName, Trigger.bIsKnownPin);
+		}
+	}
+
+	if (FlowSubsystem)
+	{
+		FlowSubsystem->EndTriggerQueueDrain();
+	}
+
+	if (TriggerQueueHead >= TriggerQueue.Num())
+	{
+		TriggerQueue.Reset();
+		TriggerQueueHead = 0;
+	}
+}
+
+void UFlowAsset::UpdateCanExecuteIsolated()
+{
+	bCanExecuteIsolated = false;
+
+	// replicated state is dirtied through the push model of the component, which isn't safe on worker threads
+	if (!TemplateAsset->bIsolatedExecution || UFlowSettings::Get()->LookaheadPreloadDepth > 0 || IsReplicatingState())
+	{
+		return;
+	}
+
+	// lazy instantiation would create objects on the worker thread, AddOns aren't vetted for isolated execution
+	bCanExecuteIsolated = AreNodesSelfContained();
+}
+
+bool UFlowAsset::AreNodesSelfContained() const
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		if (!IsNodeInstantiated(Node.Value) || !Node.Value->SupportsIsolatedExecution() || !Node.Value->GetFlowNodeAddOnChildren().IsEmpty())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UFlowAsset::CanCreateInstanceCluster() const
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		if (!IsNodeInstantiated(Node.Value) || !Node.Value->CanBeInInstanceCluster() || !Node.Value->GetFlowNodeAddOnChildren().IsEmpty())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UFlowAsset::CreateInstanceCluster()
+{
+	// editor tools like the debugger reference nodes from outside
+	if (!TemplateAsset->bClusterInstances || bInstanceClusterRoot || !FPlatformProperties::RequiresCookedData())
+	{
+		return;
+	}
+
+	static const IConsoleVariable* CreateGCClustersCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.CreateGCClusters"));
+	if (CreateGCClustersCVar && !CreateGCClustersCVar->GetBool())
+	{
+		return;
+	}
+
+	// clusters assume the references of their objects don't change
+	if (CanCreateInstanceCluster())
+	{
+		bInstanceClusterRoot = true;
+		CreateCluster();
+	}
+}
+
+void UFlowAsset::DissolveInstanceCluster()
+{
+	if (!bInstanceClusterRoot)
+	{
+		return;
+	}
+	bInstanceClusterRoot = false;
+
+	// pooled instance might be reinitialized for the owner with other references, so its cluster is created again
+	FUObjectItem* RootItem = GUObjectArray.ObjectToObjectItem(this);
+	if (RootItem && RootItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+	{
+		GUObjectClusters.DissolveCluster(RootItem);
+	}
+}
+
+bool UFlowAsset::CanExecuteIsolated() const
+{
+	// SubGraph instances finish through the owning node, replication is gathered by the component
+	if (!bCanExecuteIsolated || NodeOwningThisAssetInstance.IsValid() || IsReplicatingState())
+	{
+		return false;
+	}
+
+#if !UE_BUILD_SHIPPING
+	// breakpoints pause the game while handling the pin notify
+	if (TemplateAsset->OnPinTriggered.IsBound())
+	{
+		return false;
+	}
+#endif
+
+#if FLOW_WITH_REMOTE_DEBUG
+	// events are traced from the game thread only, so streamed instances execute there while the editor is connected
+	if (FFlowRemoteDebug::IsStreaming())
+	{
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+void UFlowAsset::DrainIsolatedTriggerQueue()
+{
+	if (bIsDrainingTriggerQueue)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowDrainTriggerQueue);
+	TGuardValue<bool> DrainingGuard(bIsDrainingTriggerQueue, true);
+	TGuardValue<bool> IsolatedGuard(bIsExecutingIsolated, true);
+
+	if (TriggerQueueFrame != GFrameCounter)
+	{
+		TriggerQueueFrame = GFrameCounter;
+		TriggersExecutedThisFrame = 0;
+	}
+
+	// frame budget of the subsystem is accounted for the whole batch of isolated instances
+	const int32 MaxTriggersPerFrame = UFlowSettings::Get()->MaxQueuedTriggersPerFrame;
+	while (TriggerQueueHead < TriggerQueue.Num() && !bIsolatedFinishRequested)
+	{
+		if (MaxTriggersPerFrame > 0 && TriggersExecutedThisFrame >= MaxTriggersPerFrame)
+		{
+			// FlushIsolatedSideEffects carries remaining activations over to the next frame
+			INC_DWORD_STAT_BY(STAT_FlowDeferredTriggers, TriggerQueue.Num() - TriggerQueueHead);
+			break;
+		}
+
+		const FFlowQueuedTrigger Trigger = TriggerQueue[TriggerQueueHead++];
+		++TriggersExecutedThisFrame;
+		FLOW_TELEMETRY_RECORD(this, TriggerQueueDelay, Trigger.QueuedTime);
+
+		if (IsValid(Trigger.Node))
+		{
+			ExecuteNodeInput(*Trigger.Node, Trigger.PinName, Trigger.bIsKnownPin);
+		}
+	}
+
+	if (TriggerQueueHead >= TriggerQueue.Num())
+	{
+		TriggerQueue.Reset();
+		TriggerQueueHead = 0;
+	}
+}
+
+void UFlowAsset::FlushIsolatedSideEffects()
+{
+	check(IsInGameThread());
+
+	TArray<TUniqueFunction<void()>> SideEffects = MoveTemp(IsolatedSideEffects);
+	IsolatedSideEffects.Reset();
+	bIsolatedFinishRequested = false;
 
+	for (TUniqueFunction<void()>& SideEffect : SideEffects)
+	{
+		// remaining work belonged to the finished graph
+		if (!IsInstanceInitialized())
+		{
+			return;
+		}
+
+		SideEffect();
+	}
+
+	if (IsInstanceInitialized() && HasQueuedTriggers())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->DeferTriggerQueue(this);
+		}
+	}
+}
+
+void UFlowAsset::DeferIsolatedSideEffect(TUniqueFunction<void()>&& SideEffect)
+{
+	if (bIsExecutingIsolated)
+	{
+		IsolatedSideEffects.Add(MoveTemp(SideEffect));
+	}
+	else
+	{
+		SideEffect();
+	}
+}
+
+int32 UFlowAsset::GetExecutionPriority() const
+{
+	if (const IFlowOwnerInterface* FlowOwnerInterface = Cast<IFlowOwnerInterface>(GetOwner()))
+	{
+		return ExecutionPriority + FlowOwnerInterface->GetFlowExecutionPriorityOffset();
+	}
+
+	return ExecutionPriority;
+}
+
+void UFlowAsset::ClearTriggerQueue()
+{
+	TriggerQueue.Empty();
+	TriggerQueueHead = 0;
+}
+
+const FFlowCompiledGraph& UFlowAsset::GetOrCompileGraph()
+{
+	if (!CompiledGraph.IsValid())
+	{
+		const TSharedRef<FFlowCompiledGraph> NewCompiledGraph = MakeShared<FFlowCompiledGraph>();
+		NewCompiledGraph->Compile(Nodes);
+
+		int32 EntryNodesNum = 0;
+		const TArray<UFlowNode*> ConnectedNodes = GatherNodesConnectedToAllInputs(EntryNodesNum);
+		NewCompiledGraph->CompileExecutionOrder(ConnectedNodes, EntryNodesNum);
+
+		CompiledGraph = NewCompiledGraph;
+	}
+
+	return *CompiledGraph;
+}
+
+void UFlowAsset::InvalidateCompiledGraph()
+{
+	CompiledGraph.Reset();
+	InvalidateCustomEventNodes();
+	InvalidateLightweightProgram();
+}
+
+TSharedPtr<const FFlowLightweightProgram> UFlowAsset::GetLightweightProgram()
+{
+	check(!IsInstanceInitialized());
+
+	if (!bLightweightProgramCompiled)
+	{
+		LightweightProgram = FFlowLightweightProgram::Compile(*this);
+		bLightweightProgramCompiled = true;
+	}
+
+	return LightweightProgram;
+}
+
+void UFlowAsset::InvalidateLightweightProgram()
+{
+	LightweightProgram.Reset();
+	bLightweightProgramCompiled = false;
+	SpeculativeProgram.Reset();
+}
+
+TSharedPtr<const FFlowLightweightProgram> UFlowAsset::GetSpeculativeProgram()
+{
+	check(!IsInstanceInitialized());
+
+	if (!SpeculativeProgram.IsValid())
+	{
+		constexpr bool bStubUnsupportedNodes = true;
+		SpeculativeProgram = FFlowLightweightProgram::Compile(*this, bStubUnsupportedNodes);
+	}
+
+	return SpeculativeProgram;
+}
+
+TSharedPtr<const FFlowLightweightProgram> UFlowAsset::CaptureSpeculativeState(FFlowLightweightState& OutState) const
+{
+	if (!IsInstanceInitialized() || TemplateAsset == nullptr)
+	{
+		return nullptr;
+	}
+
+	const TSharedPtr<const FFlowLightweightProgram> Program = TemplateAsset->GetSpeculativeProgram();
+	return Program.IsValid() && Program->CaptureState(*this, OutState) ? Program : nullptr;
+}
+
+void UFlowAsset::FinishNode(UFlowNode* Node)
+{
+	if (Node && RemoveActiveNode(*Node))
+	{
+		if (Node->CanFinishGraph())
+		{
+			if (bIsExecutingIsolated)
+			{
+				// finishing deregisters the instance from the subsystem, so it waits for the game thread
+				bIsolatedFinishRequested = true;
+				DeferIsolatedSideEffect([this]() { FinishGraph(); });
 				return;
 			}
 
-			// if this instance is a Root Flow, we need to deregister it from the subsystem first
-			if (Owner.IsValid())
+			FinishGraph();
+		}
+	}
+}
+
+void UFlowAsset::FinishGraph()
+{
+	// if graph reached Finish and this asset instance was created by SubGraph node
+	if (NodeOwningThisAssetInstance.IsValid())
+	{
+		NodeOwningThisAssetInstance.Get()->TriggerFirstOutput(true);
+
+		return;
+	}
+
+	// if this instance is a Root Flow, we need to deregister it from the subsystem first
+	if (Owner.IsValid())
+	{
+		if (GetFlowSubsystem()->IsRootInstance(this))
+		{
+			GetFlowSubsystem()->FinishRootFlow(Owner.Get(), TemplateAsset, EFlowFinishPolicy::Keep);
+
+			return;
+		}
+	}
+
+	FinishFlow(EFlowFinishPolicy::Keep);
+}
+
+bool UFlowAsset::AddActiveNode(UFlowNode& Node)
+{
+	if (IsNodeActive(Node))
+	{
+		return false;
+	}
+
+	Node.ActiveNodeIndex = ActiveNodes.Add(&Node);
+	Node.TelemetryActivationTime = FLOW_TELEMETRY_TIME();
+	return true;
+}
+
+bool UFlowAsset::RemoveActiveNode(UFlowNode& Node)
+{
+	if (!IsNodeActive(Node))
+	{
+		return false;
+	}
+
+	FLOW_TELEMETRY_RECORD_NODE(Node, Node.TelemetryActivationTime);
+
+	const int32 RemovedIndex = Node.ActiveNodeIndex;
+	ActiveNodes.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	Node.ActiveNodeIndex = INDEX_NONE;
+
+	// the last node has been moved into the freed slot
+	if (ActiveNodes.IsValidIndex(RemovedIndex))
+	{
+		ActiveNodes[RemovedIndex]->ActiveNodeIndex = RemovedIndex;
+	}
+
+	return true;
+}
+
+void UFlowAsset::UpdateLookaheadPreload()
+{
+	if (!CompiledGraph.IsValid())
+	{
+		return;
+	}
+
+	const FFlowCompiledGraph& Graph = *CompiledGraph;
+	const int32 MaxDepth = UFlowSettings::Get()->LookaheadPreloadDepth;
+	const int32 MaxPreloadedNodes = UFlowSettings::Get()->MaxLookaheadPreloadedNodes;
+
+	// breadth-first walk, so the nearest nodes fit the budget first
+	TBitArray<> VisitedNodes(false, Graph.GetNodesNum());
+	TArray<int32> Frontier;
+	for (const UFlowNode* ActiveNode : ActiveNodes)
+	{
+		if (ActiveNode && VisitedNodes.IsValidIndex(ActiveNode->CompiledNodeIndex))
+		{
+			VisitedNodes[ActiveNode->CompiledNodeIndex] = true;
+			Frontier.Add(ActiveNode->CompiledNodeIndex);
+		}
+	}
+
+	TArray<int32> NodesToPreload;
+	TArray<int32> NextFrontier;
+	for (int32 Depth = 0; Depth < MaxDepth && Frontier.Num() > 0; Depth++)
+	{
+		NextFrontier.Reset();
+		for (const int32 NodeIndex : Frontier)
+		{
+			for (int32 ConnectionIndex = Graph.OutputOffsets[NodeIndex]; ConnectionIndex < Graph.OutputOffsets[NodeIndex + 1]; ConnectionIndex++)
 			{
-				const TSet<UFlowAsset*>& RootFlowInstances = GetFlowSubsystem()->GetRootInstancesByOwner(Owner.Get());
-				if (RootFlowInstances.Contains(this))
+				const int32 ConnectedIndex = Graph.OutputConnections[ConnectionIndex].NodeIndex;
+				if (ConnectedIndex != INDEX_NONE && !VisitedNodes[ConnectedIndex])
 				{
-					GetFlowSubsystem()->FinishRootFlow(Owner.Get(), TemplateAsset, EFlowFinishPolicy::Keep);
+					VisitedNodes[ConnectedIndex] = true;
+					NextFrontier.Add(ConnectedIndex);
 
-					return;
+					const UFlowNode* ConnectedNode = CompiledNodes[ConnectedIndex];
+					if (ConnectedNode && ConnectedNode->HasPreloadContent() && (MaxPreloadedNodes == 0 || NodesToPreload.Num() < MaxPreloadedNodes))
+					{
+						NodesToPreload.Add(ConnectedIndex);
+					}
 				}
 			}
+		}
+		Swap(Frontier, NextFrontier);
+	}
+
+	TSet<UFlowNode*> ReachableNodes;
+	ReachableNodes.Reserve(NodesToPreload.Num());
+	for (const int32 NodeIndex : NodesToPreload)
+	{
+		if (UFlowNode* Node = GetOrCreateCompiledNodeInstance(NodeIndex))
+		{
+			ReachableNodes.Add(Node);
+			if (!Node->bPreloaded)
+			{
+				Node->TriggerPreload();
+				PreloadedNodes.Add(Node);
+			}
+		}
+	}
+
+	// active nodes are using the preloaded content, these are flushed once left behind
+	for (TSet<TObjectPtr<UFlowNode>>::TIterator It = PreloadedNodes.CreateIterator(); It; ++It)
+	{
+		UFlowNode* PreloadedNode = *It;
+		if (PreloadedNode && !ReachableNodes.Contains(PreloadedNode) && !IsNodeActive(*PreloadedNode))
+		{
+			PreloadedNode->TriggerFlush();
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool UFlowAsset::FlushPreloadedNode(UFlowNode* Node)
+{
+	if (Node == nullptr || IsNodeActive(*Node) || !PreloadedNodes.Contains(Node))
+	{
+		return false;
+	}
+
+	Node->TriggerFlush();
+	PreloadedNodes.Remove(Node);
+	return true;
+}
+
+bool UFlowAsset::CanHibernateNode(const UFlowNode& Node) const
+{
+	// SaveGame and other properties of the released node would be lost, so nodes opt in explicitly
+	if (!Node.CanHibernate() || !IsNodeInstantiated(&Node) || IsNodeActive(Node) || Node.bPreloaded || PreloadedNodes.Contains(&Node))
+	{
+		return false;
+	}
+
+	// entry points are registered on initialization, Sub Graph nodes are tied to ActiveSubGraphs
+	if (Node.IsA<UFlowNode_CustomInput>() || Node.IsA<UFlowNode_Start>() || Node.IsA<UFlowNode_SubGraph>())
+	{
+		return false;
+	}
+
+	// supplied values might depend on the node state
+	for (const FFlowPin& OutputPin : Node.OutputPins)
+	{
+		if (OutputPin.IsDataPin())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 UFlowAsset::FastForward(const float DeltaTime)
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (!IsInstanceInitialized() || FlowSubsystem == nullptr || DeltaTime <= 0.0f)
+	{
+		return 0;
+	}
+
+	FLOW_TRACE_SCOPE_TEXT(TEXT("FastForward %s"), *GetNameSafe(TemplateAsset));
+
+	// captured up front, as Sub Graphs started by the fired outputs are already at the current time
+	TArray<TWeakObjectPtr<UFlowAsset>, TInlineAllocator<4>> SubFlows;
+	for (const TPair<TWeakObjectPtr<UFlowNode_SubGraph>, TWeakObjectPtr<UFlowAsset>>& SubGraph : ActiveSubGraphs)
+	{
+		SubFlows.Add(SubGraph.Value);
+	}
+
+	int32 FiredTimers = FlowSubsystem->FastForwardFlowTimers(this, DeltaTime);
+
+	for (const TWeakObjectPtr<UFlowAsset>& SubFlow : SubFlows)
+	{
+		if (SubFlow.IsValid())
+		{
+			FiredTimers += SubFlow->FastForward(DeltaTime);
+		}
+	}
+
+	return FiredTimers;
+}
+
+int32 UFlowAsset::HibernateInactiveNodes()
+{
+	// replicated state and queued triggers reference node instances
+	if (!IsInstanceInitialized() || !TemplateAsset || !TemplateAsset->bLazyNodeInstantiation || bInstanceClusterRoot
+		|| ReplicatingComponent.IsValid() || TriggerQueueHead < TriggerQueue.Num() || bIsDrainingTriggerQueue)
+	{
+		return 0;
+	}
+
+	TSet<UFlowNode*> ReleasedNodes;
+	for (TPair<FGuid, TObjectPtr<UFlowNode>>& Node : Nodes)
+	{
+		if (Node.Value && CanHibernateNode(*Node.Value))
+		{
+			UFlowNode* TemplateNode = TemplateAsset->Nodes.FindRef(Node.Key);
+			if (TemplateNode == nullptr)
+			{
+				continue;
+			}
+
+			UFlowNode* NodeInstance = Node.Value;
+			NodeInstance->DeinitializeInstance();
+			ReleasedNodes.Add(NodeInstance);
+
+			if (CompiledNodes.IsValidIndex(NodeInstance->CompiledNodeIndex))
+			{
+				CompiledNodes[NodeInstance->CompiledNodeIndex] = TemplateNode;
+			}
+			Node.Value = TemplateNode;
+		}
+	}
+
+	if (ReleasedNodes.Num() > 0)
+	{
+		RecordedNodes.RemoveAll([&ReleasedNodes](const TObjectPtr<UFlowNode>& Node)
+		{
+			return ReleasedNodes.Contains(Node);
+		});
+
+		UE_LOG(LogFlow, Verbose, TEXT("%s: hibernated %d inactive nodes"), *GetName(), ReleasedNodes.Num());
+	}
 
-			FinishFlow(EFlowFinishPolicy::Keep);
+	bNodesHibernated = true;
+	return ReleasedNodes.Num();
+}
+
+void UFlowAsset::ClearActiveNodes()
+{
+	for (UFlowNode* Node : ActiveNodes)
+	{
+		if (Node)
+		{
+			FLOW_TELEMETRY_RECORD_NODE(*Node, Node->TelemetryActivationTime);
+			Node->ActiveNodeIndex = INDEX_NONE;
 		}
 	}
+
+	ActiveNodes.Empty();
 }
 
 void UFlowAsset::ResetNodes()
@@ -1363,7 +3361,29 @@ void UFlowAsset::ResetNodes()
 	}
 
 	RecordedNodes.Empty();
+	NodeStates.Init(EFlowNodeState::NeverActivated, NodeStates.Num());
+
+#if WITH_EDITOR
+	if (WireRecords.Num() > 0)
+	{
+		WireRecords.Empty();
+		WireRecordsVersion++;
+	}
+#endif
+}
+
+#if WITH_EDITOR
+void UFlowAsset::RecordWire(const UFlowNode& Node, const int32 OutputPinIndex)
+{
+	if (UFlowSettings::Get()->GetPinRecordingMode() == EFlowPinRecordingMode::Off || !Node.GetOutputPins().IsValidIndex(OutputPinIndex))
+	{
+		return;
+	}
+
+	WireRecords.FindOrAdd(Node.GetGuid()).Emplace(static_cast<uint8>(OutputPinIndex), FApp::GetCurrentTime());
+	WireRecordsVersion++;
 }
+#endif
 
 UFlowSubsystem* UFlowAsset::GetFlowSubsystem() const
 {
@@ -1375,6 +3395,16 @@ FName UFlowAsset::GetDisplayName() const
 	return GetFName();
 }
 
+uint32 UFlowAsset::GetInstanceTemplateId() const
+{
+	if (InstanceTemplateId == 0)
+	{
+		// zero is reserved for not computed yet
+		InstanceTemplateId = FMath::Max(FCrc::StrCrc32(*GetPathName()), 1u);
+	}
+	return InstanceTemplateId;
+}
+
 UFlowNode_SubGraph* UFlowAsset::GetNodeOwningThisAssetInstance() const
 {
 	return NodeOwningThisAssetInstance.Get();
@@ -1387,72 +3417,249 @@ UFlowAsset* UFlowAsset::GetParentInstance() const
 
 FFlowAssetSaveData UFlowAsset::SaveInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances)
 {
-	FFlowAssetSaveData AssetRecord;
-	AssetRecord.WorldName = IsBoundToWorld() ? GetWorld()->GetName() : FString();
-	AssetRecord.InstanceName = GetName();
+	TArray<FFlowAssetPendingSave> PendingSaves;
+	PrepareSaveInstance(SavedFlowInstances, PendingSaves);
+
+	// this instance is prepared last, after its SubGraphs
+	const int32 RecordIndex = PendingSaves.Last().RecordIndex;
+
+	// subsystem serializes all root instances at once, if parallel save is enabled
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr || !FlowSubsystem->TryDeferSaveSerialization(PendingSaves))
+	{
+		for (const FFlowAssetPendingSave& PendingSave : PendingSaves)
+		{
+			PendingSave.Instance->SerializeSaveInstance(PendingSave);
+		}
+	}
+
+	return SavedFlowInstances[RecordIndex];
+}
+
+FFlowAssetSaveData UFlowAsset::SnapshotInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances)
+{
+	TArray<FFlowAssetPendingSave> PendingSaves;
+	PrepareSaveInstance(SavedFlowInstances, PendingSaves, true);
+
+	for (const FFlowAssetPendingSave& PendingSave : PendingSaves)
+	{
+		PendingSave.Instance->SerializeSaveInstance(PendingSave);
+	}
+
+	return SavedFlowInstances[PendingSaves.Last().RecordIndex];
+}
 
-	// opportunity to collect data before serializing asset
-	OnSave();
+void UFlowAsset::PrepareSaveInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances, TArray<FFlowAssetPendingSave>& OutPendingSaves, const bool bSnapshot)
+{
+	FFlowAssetPendingSave PendingSave;
+	PendingSave.Instance = this;
+	PendingSave.SavedFlowInstances = &SavedFlowInstances;
+	PendingSave.bSnapshot = bSnapshot;
+
+	// asset data doesn't include node records, so it can be reused even if nodes are serialized again
+	PendingSave.bReuseAssetData = !bSnapshot && UFlowSettings::Get()->bIncrementalSaveGame && !bSaveDataDirty && CanReuseSaveData();
+	if (!PendingSave.bReuseAssetData && !bSnapshot)
+	{
+		// opportunity to collect data before serializing asset
+		OnSave();
+	}
 
-	// iterate nodes
+	// iterate active nodes in execution order, so loading them backward doesn't trigger not-yet-loaded nodes
 	TArray<UFlowNode*> NodesInExecutionOrder;
-	GetNodesInExecutionOrder<UFlowNode>(GetDefaultEntryNode(), NodesInExecutionOrder);
-	for (UFlowNode* Node : NodesInExecutionOrder)
+	NodesInExecutionOrder.Reserve(ActiveNodes.Num());
+	for (UFlowNode* Node : ActiveNodes)
 	{
 		if (Node && Node->ActivationState == EFlowNodeState::Active)
 		{
-			// iterate SubGraphs
-			if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node))
+			NodesInExecutionOrder.Emplace(Node);
+		}
+	}
+
+	if (CompiledGraph.IsValid())
+	{
+		const FFlowCompiledGraph& Graph = *CompiledGraph;
+		NodesInExecutionOrder.Sort([&Graph](const UFlowNode& A, const UFlowNode& B)
+		{
+			return Graph.GetExecutionOrder(A.CompiledNodeIndex) < Graph.GetExecutionOrder(B.CompiledNodeIndex);
+		});
+	}
+
+	for (UFlowNode* Node : NodesInExecutionOrder)
+	{
+		// iterate SubGraphs
+		if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node))
+		{
+			const TWeakObjectPtr<UFlowAsset> SubFlowInstance = GetFlowInstance(SubGraphNode);
+			if (SubFlowInstance.IsValid())
 			{
-				const TWeakObjectPtr<UFlowAsset> SubFlowInstance = GetFlowInstance(SubGraphNode);
-				if (SubFlowInstance.IsValid())
+				SubFlowInstance->PrepareSaveInstance(SavedFlowInstances, OutPendingSaves, bSnapshot);
+
+				const uint64 SubInstanceId = SavedFlowInstances[OutPendingSaves.Last().RecordIndex].InstanceId;
+				if (SubGraphNode->SavedAssetInstanceId != SubInstanceId || !SubGraphNode->SavedAssetInstanceName.IsEmpty())
 				{
-					const FFlowAssetSaveData SubAssetRecord = SubFlowInstance->SaveInstance(SavedFlowInstances);
-					SubGraphNode->SavedAssetInstanceName = SubAssetRecord.InstanceName;
+					SubGraphNode->SavedAssetInstanceId = SubInstanceId;
+					SubGraphNode->SavedAssetInstanceName = FString();
+					SubGraphNode->MarkSaveDataDirty();
 				}
 			}
+		}
 
-			FFlowNodeSaveData NodeRecord;
-			Node->SaveInstance(NodeRecord);
-
-			AssetRecord.NodeRecords.Emplace(NodeRecord);
+		if (!bSnapshot)
+		{
+			Node->PrepareSaveInstance();
 		}
+		PendingSave.Nodes.Emplace(Node);
+	}
+
+	// placeholder keeps records in the same order, no matter when they are serialized
+	FFlowAssetSaveData& AssetRecord = SavedFlowInstances.AddDefaulted_GetRef();
+	AssetRecord.WorldName = IsBoundToWorld() ? GetWorld()->GetName() : FString();
+	AssetRecord.InstanceId = InstanceId;
+	AssetRecord.NodeRecords.SetNum(PendingSave.Nodes.Num());
+
+	PendingSave.RecordIndex = SavedFlowInstances.Num() - 1;
+	OutPendingSaves.Emplace(MoveTemp(PendingSave));
+}
+
+void UFlowAsset::SerializeSaveInstance(const FFlowAssetPendingSave& PendingSave)
+{
+	FFlowAssetSaveData& AssetRecord = (*PendingSave.SavedFlowInstances)[PendingSave.RecordIndex];
+
+	for (int32 NodeIndex = 0; NodeIndex < PendingSave.Nodes.Num(); NodeIndex++)
+	{
+		PendingSave.Nodes[NodeIndex]->SerializeSaveInstance(AssetRecord.NodeRecords[NodeIndex], PendingSave.bSnapshot);
+	}
+
+	if (PendingSave.bReuseAssetData)
+	{
+		AssetRecord.AssetData = CachedSaveData;
+		INC_DWORD_STAT(STAT_FlowReusedSaveRecords);
 	}
+	else
+	{
+		INC_DWORD_STAT(STAT_FlowSerializedSaveRecords);
 
-	// serialize asset
-	FMemoryWriter MemoryWriter(AssetRecord.AssetData, true);
-	FFlowArchive Ar(MemoryWriter);
-	Serialize(Ar);
+		// serialize asset
+		FMemoryWriter MemoryWriter(AssetRecord.AssetData, true);
+		FlowSave::SerializeSaveData(*this, MemoryWriter, GetSaveDataTablesForSave(), GetSaveDataDeltaArchetype(this));
+
+		// snapshot skipped OnSave(), so its data can't stand in for the next save
+		if (UFlowSettings::Get()->bIncrementalSaveGame && !PendingSave.bSnapshot)
+		{
+			CachedSaveData = AssetRecord.AssetData;
+			bSaveDataDirty = false;
+		}
+	}
 
-	// write archive to SaveGame
-	SavedFlowInstances.Emplace(AssetRecord);
+	// tables are complete once the asset and all nodes have been serialized
+	if (const FFlowSaveDataTables* Tables = GetSaveDataTablesForSave())
+	{
+		AssetRecord.Format = EFlowSaveDataFormat::CompactTables;
+		AssetRecord.Tables = *Tables;
+	}
 
-	return AssetRecord;
+	AssetRecord.bDeltaFromTemplate = UFlowSettings::Get()->bSaveGameDeltaFromTemplate;
 }
 
 void UFlowAsset::LoadInstance(const FFlowAssetSaveData& AssetRecord)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FlowLoadInstance);
+	CSV_SCOPED_TIMING_STAT(Flow, LoadInstance);
+
+	// loaded tables are extended by the next save, as loaded data is serialized again
+	LoadedSaveDataFormat = AssetRecord.Format;
+	if (LoadedSaveDataFormat == EFlowSaveDataFormat::CompactTables)
+	{
+		SaveDataTables = AssetRecord.Tables;
+		SaveDataTables.RebuildIndices();
+	}
+	else
+	{
+		SaveDataTables.Reset();
+	}
+
+	// pooled instance might contain values from its previous run, which aren't included in the delta
+	bLoadedDeltaSaveData = AssetRecord.bDeltaFromTemplate && TemplateAsset;
+	if (bLoadedDeltaSaveData)
+	{
+		FlowSave::ResetSaveGameProperties(*this, *TemplateAsset);
+	}
+
 	FMemoryReader MemoryReader(AssetRecord.AssetData, true);
-	FFlowArchive Ar(MemoryReader);
-	Serialize(Ar);
+	FlowSave::SerializeSaveData(*this, MemoryReader, GetSaveDataTablesForLoad());
 
 	PreStartFlow();
 
-	// iterate graph "from the end", backward to execution order
-	// prevents issue when the preceding node would instantly fire output to a not-yet-loaded node
+	// observers loaded in this graph and its SubGraphs query the registry once, after all OnLoad() hooks ran
+	FFlowLiveQueryBatchScope LiveQueryBatch(GetFlowSubsystem());
+
+	// restore state of all nodes first, so no OnLoad() hook sees a partially loaded graph
+	TArray<UFlowNode*> LoadedNodes;
+	LoadedNodes.Reserve(AssetRecord.NodeRecords.Num());
 	for (int32 i = AssetRecord.NodeRecords.Num() - 1; i >= 0; i--)
 	{
-		if (UFlowNode* Node = Nodes.FindRef(AssetRecord.NodeRecords[i].NodeGuid))
+		if (UFlowNode* Node = GetOrCreateNodeInstance(AssetRecord.NodeRecords[i].NodeGuid))
 		{
-			Node->LoadInstance(AssetRecord.NodeRecords[i]);
+			Node->DeserializeSaveInstance(AssetRecord.NodeRecords[i]);
+			LoadedNodes.Add(Node);
 		}
+		else if (TemplateAsset && TemplateAsset->StrippedNodeRedirects.Contains(AssetRecord.NodeRecords[i].NodeGuid))
+		{
+			// SaveGame of the unoptimized graph, stripped nodes only pass the signal through and have no state worth restoring
+			UE_LOG(LogFlow, Verbose, TEXT("Skipped loading node %s stripped from %s while cooking"), *AssetRecord.NodeRecords[i].NodeGuid.ToString(), *GetNameSafe(TemplateAsset));
+		}
+	}
+
+	// iterate graph "from the end", backward to execution order
+	// prevents issue when the preceding node would instantly fire output to a node which didn't run its OnLoad() yet
+	for (UFlowNode* LoadedNode : LoadedNodes)
+	{
+		LoadedNode->PostLoadInstance();
 	}
 
 	OnLoad();
 }
 
+void UFlowAsset::MarkSaveDataDirty()
+{
+	bSaveDataDirty = true;
+}
+
+bool UFlowAsset::CanReuseSaveData() const
+{
+	return !GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+}
+
+FFlowSaveDataTables* UFlowAsset::GetSaveDataTablesForSave()
+{
+	return UFlowSettings::Get()->bCompactSaveGameFormat ? &SaveDataTables : nullptr;
+}
+
+FFlowSaveDataTables* UFlowAsset::GetSaveDataTablesForLoad()
+{
+	return LoadedSaveDataFormat == EFlowSaveDataFormat::CompactTables ? &SaveDataTables : nullptr;
+}
+
+UObject* UFlowAsset::GetSaveDataDeltaArchetype(const UObject* InstancedObject) const
+{
+	if (!UFlowSettings::Get()->bSaveGameDeltaFromTemplate || TemplateAsset == nullptr || InstancedObject == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (InstancedObject == this)
+	{
+		return TemplateAsset;
+	}
+
+	const UFlowNode* Node = Cast<UFlowNode>(InstancedObject);
+	return Node ? TemplateAsset->GetNode(Node->GetGuid()) : nullptr;
+}
+
 void UFlowAsset::OnActivationStateLoaded(UFlowNode* Node)
 {
+	SetNodeState(Node->CompiledNodeIndex, Node->ActivationState);
+
 	if (Node->ActivationState != EFlowNodeState::NeverActivated)
 	{
 		RecordedNodes.Emplace(Node);
@@ -1460,7 +3667,7 @@ void UFlowAsset::OnActivationStateLoaded(UFlowNode* Node)
 
 	if (Node->ActivationState == EFlowNodeState::Active)
 	{
-		ActiveNodes.Emplace(Node);
+		AddActiveNode(*Node);
 	}
 }
 
@@ -1488,7 +3695,7 @@ void UFlowAsset::LogError(const FString& MessageToLog, const UFlowNodeBase* Node
 
 	if (RuntimeLog.Get())
 	{
-		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog.Get()->Error(*MessageToLog, Node);
+		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog->AddMessage(EMessageSeverity::Error, MessageToLog, Node);
 		BroadcastRuntimeMessageAdded(TokenizedMessage);
 	}
 }
@@ -1503,7 +3710,7 @@ void UFlowAsset::LogWarning(const FString& MessageToLog, const UFlowNodeBase* No
 
 	if (RuntimeLog.Get())
 	{
-		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog.Get()->Warning(*MessageToLog, Node);
+		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog->AddMessage(EMessageSeverity::Warning, MessageToLog, Node);
 		BroadcastRuntimeMessageAdded(TokenizedMessage);
 	}
 }
@@ -1518,12 +3725,236 @@ void UFlowAsset::LogNote(const FString& MessageToLog, const UFlowNodeBase* Node)
 
 	if (RuntimeLog.Get())
 	{
-		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog.Get()->Note(*MessageToLog, Node);
+		const TSharedRef<FTokenizedMessage> TokenizedMessage = RuntimeLog->AddMessage(EMessageSeverity::Info, MessageToLog, Node);
 		BroadcastRuntimeMessageAdded(TokenizedMessage);
 	}
 }
 #endif
 
+void FFlowCompiledGraph::Compile(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes)
+{
+	NodeGuids.Reset(Nodes.Num());
+	OutputOffsets.Reset(Nodes.Num() + 1);
+	OutputConnections.Reset();
+
+	NodeIndices.Reset();
+	NodeIndices.Reserve(Nodes.Num());
+
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		NodeIndices.Add(Node.Key, NodeGuids.Add(Node.Key));
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		OutputOffsets.Add(OutputConnections.Num());
+
+		if (!IsValid(Node.Value))
+		{
+			continue;
+		}
+
+		for (const FFlowPin& OutputPin : Node.Value->GetOutputPins())
+		{
+			FFlowCompiledConnection& CompiledConnection = OutputConnections.AddDefaulted_GetRef();
+
+			// only exec outputs are cached in Connections, data pins are keyed by the input pin name
+			const FConnectedPin* ConnectedPin = OutputPin.IsExecPin() ? Node.Value->Connections.Find(OutputPin.PinName) : nullptr;
+			if (ConnectedPin == nullptr)
+			{
+				continue;
+			}
+
+			if (const int32* ConnectedNodeIndex = NodeIndices.Find(ConnectedPin->NodeGuid))
+			{
+				CompiledConnection.NodeIndex = *ConnectedNodeIndex;
+
+				if (const UFlowNode* ConnectedNode = Nodes.FindRef(ConnectedPin->NodeGuid))
+				{
+					CompiledConnection.PinIndex = ConnectedNode->GetInputPins().IndexOfByKey(ConnectedPin->PinName);
+				}
+			}
+		}
+	}
+
+	OutputOffsets.Add(OutputConnections.Num());
+}
+
+void FFlowCustomEventNodes::Gather(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes)
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : ObjectPtrDecay(Nodes))
+	{
+		if (const UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value))
+		{
+			InputNames.Add(CustomInput->GetEventName());
+			InputNodes.FindOrAdd(CustomInput->GetEventName(), Node.Key);
+		}
+		else if (const UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value))
+		{
+			OutputNames.Add(CustomOutput->GetEventName());
+			OutputNodes.FindOrAdd(CustomOutput->GetEventName(), Node.Key);
+		}
+	}
+
+	// order of the Nodes map depends on the editing history, it's not a stable reference
+	InputNodes.GenerateKeyArray(SortedInputNames);
+	SortedInputNames.Sort(FNameLexicalLess());
+}
+
+void FFlowCompiledGraph::Serialize(FArchive& Ar)
+{
+	// plain tables of guids and indices, the reverse lookup is rebuilt
+	NodeGuids.BulkSerialize(Ar);
+	OutputOffsets.BulkSerialize(Ar);
+	OutputConnections.BulkSerialize(Ar);
+	ExecutionOrder.BulkSerialize(Ar);
+	ConnectedNodes.NodeIndices.BulkSerialize(Ar);
+	Ar << ConnectedNodes.EntryNodesNum;
+
+	if (Ar.IsLoading())
+	{
+		NodeIndices.Reset();
+		NodeIndices.Reserve(NodeGuids.Num());
+		for (int32 NodeIndex = 0; NodeIndex < NodeGuids.Num(); ++NodeIndex)
+		{
+			NodeIndices.Add(NodeGuids[NodeIndex], NodeIndex);
+		}
+
+		ConnectedNodesByClass.Reset();
+	}
+}
+
+bool FFlowCompiledGraph::HasValidTables() const
+{
+	const int32 NodesNum = NodeGuids.Num();
+	if (OutputOffsets.Num() != NodesNum + 1 || ExecutionOrder.Num() != NodesNum || OutputOffsets[0] != 0 || OutputOffsets.Last() != OutputConnections.Num())
+	{
+		return false;
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; ++NodeIndex)
+	{
+		if (OutputOffsets[NodeIndex] > OutputOffsets[NodeIndex + 1])
+		{
+			return false;
+		}
+	}
+
+	for (const FFlowCompiledConnection& Connection : OutputConnections)
+	{
+		if (Connection.NodeIndex < INDEX_NONE || Connection.NodeIndex >= NodesNum || Connection.PinIndex < INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	for (const int32 NodeIndex : ConnectedNodes.NodeIndices)
+	{
+		if (NodeIndex < 0 || NodeIndex >= NodesNum)
+		{
+			return false;
+		}
+	}
+
+	return ConnectedNodes.EntryNodesNum >= 0 && ConnectedNodes.EntryNodesNum <= ConnectedNodes.NodeIndices.Num();
+}
+
+bool FFlowCompiledGraph::MatchesOutputPins(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes) const
+{
+	for (int32 NodeIndex = 0; NodeIndex < NodeGuids.Num(); ++NodeIndex)
+	{
+		// Compile() adds no connections for invalid nodes
+		const UFlowNode* Node = Nodes.FindRef(NodeGuids[NodeIndex]);
+		const int32 OutputPinsNum = IsValid(Node) ? Node->GetOutputPins().Num() : 0;
+		if (OutputOffsets[NodeIndex + 1] - OutputOffsets[NodeIndex] != OutputPinsNum)
+		{
+			return false;
+		}
+	}
+
+	for (const FFlowCompiledConnection& Connection : OutputConnections)
+	{
+		if (Connection.PinIndex != INDEX_NONE)
+		{
+			const UFlowNode* ConnectedNode = Connection.NodeIndex != INDEX_NONE ? Nodes.FindRef(NodeGuids[Connection.NodeIndex]) : nullptr;
+			if (!IsValid(ConnectedNode) || Connection.PinIndex >= ConnectedNode->GetInputPins().Num())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void FFlowCompiledGraph::CompileExecutionOrder(const TArray<UFlowNode*>& NodesInExecutionOrder, const int32 EntryNodesNum)
+{
+	ExecutionOrder.Init(INDEX_NONE, NodeGuids.Num());
+
+	ConnectedNodes.NodeIndices.Reset(NodesInExecutionOrder.Num());
+	ConnectedNodes.EntryNodesNum = 0;
+	ConnectedNodesByClass.Reset();
+
+	int32 NextPosition = 0;
+	for (int32 Position = 0; Position < NodesInExecutionOrder.Num(); ++Position)
+	{
+		const UFlowNode* Node = NodesInExecutionOrder[Position];
+		const int32 NodeIndex = Node ? FindNodeIndex(Node->GetGuid()) : INDEX_NONE;
+		if (ExecutionOrder.IsValidIndex(NodeIndex) && ExecutionOrder[NodeIndex] == INDEX_NONE)
+		{
+			ExecutionOrder[NodeIndex] = NextPosition++;
+			ConnectedNodes.NodeIndices.Add(NodeIndex);
+
+			if (Position < EntryNodesNum)
+			{
+				ConnectedNodes.EntryNodesNum++;
+			}
+		}
+	}
+
+	for (int32& Position : ExecutionOrder)
+	{
+		if (Position == INDEX_NONE)
+		{
+			Position = NextPosition++;
+		}
+	}
+}
+
+const FFlowCompiledNodeList& FFlowCompiledGraph::GetConnectedNodesOfClass(const UClass* NodeClass, const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes) const
+{
+	if (NodeClass == UFlowNode::StaticClass())
+	{
+		return ConnectedNodes;
+	}
+
+	if (const FFlowCompiledNodeList* FoundNodes = ConnectedNodesByClass.Find(NodeClass))
+	{
+		return *FoundNodes;
+	}
+
+	FFlowCompiledNodeList& NodesOfClass = ConnectedNodesByClass.Add(NodeClass);
+	if (NodeClass)
+	{
+		for (int32 Position = 0; Position < ConnectedNodes.NodeIndices.Num(); ++Position)
+		{
+			const int32 NodeIndex = ConnectedNodes.NodeIndices[Position];
+			const UFlowNode* Node = Nodes.FindRef(NodeGuids[NodeIndex]);
+			if (Node && Node->GetClass()->IsChildOf(NodeClass))
+			{
+				NodesOfClass.NodeIndices.Add(NodeIndex);
+
+				if (Position < ConnectedNodes.EntryNodesNum)
+				{
+					NodesOfClass.EntryNodesNum++;
+				}
+			}
+		}
+	}
+
+	return NodesOfClass;
+}
+
 #if WITH_EDITOR
 bool FFlowHarvestDataPinsWorkingData::DidPinNameToBoundPropertyNameMapChange() const
 {
@@ -1563,3 +3994,48 @@ bool FFlowHarvestDataPinsWorkingData::DidAutoOutputDataPinsChange() const
 }
 
 #endif
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand FlowMemoryTemplatesCommand(
+	TEXT("Flow.Memory.Templates"),
+	TEXT("Logs Flow Asset templates with active instances, sorted by memory used by all their instances. Arguments: [MaxEntries=20]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 MaxEntries = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 20;
+
+		struct FTemplateMemory
+		{
+			const UFlowAsset* Template;
+			int32 Instances;
+			SIZE_T InstancesSize;
+			SIZE_T TemplateSize;
+		};
+
+		TArray<FTemplateMemory> Entries;
+		SIZE_T TotalSize = 0;
+		for (TObjectIterator<UFlowAsset> It; It; ++It)
+		{
+			UFlowAsset* Template = *It;
+			if (Template->GetTemplateAsset() == nullptr && Template->GetInstancesNum() > 0)
+			{
+				const SIZE_T InstancesSize = Template->GetInstancesResourceSize();
+				Entries.Add({Template, Template->GetInstancesNum(), InstancesSize, Template->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal)});
+				TotalSize += InstancesSize;
+			}
+		}
+
+		Entries.Sort([](const FTemplateMemory& A, const FTemplateMemory& B)
+		{
+			return A.InstancesSize > B.InstancesSize;
+		});
+
+		UE_LOG(LogFlow, Display, TEXT("Flow Memory: %d templates, %.1f KB in instances (shared preloads are reported by stat Flow)"), Entries.Num(), TotalSize / 1024.0);
+		UE_LOG(LogFlow, Display, TEXT("  %10s %12s %12s %12s  %s"), TEXT("Instances"), TEXT("Per Inst. B"), TEXT("Total KB"), TEXT("Template KB"), TEXT("Name"));
+		for (int32 Index = 0; Index < Entries.Num() && (MaxEntries <= 0 || Index < MaxEntries); Index++)
+		{
+			const FTemplateMemory& Entry = Entries[Index];
+			UE_LOG(LogFlow, Display, TEXT("  %10d %12llu %12.1f %12.1f  %s"), Entry.Instances, static_cast<uint64>(Entry.InstancesSize / Entry.Instances),
+				Entry.InstancesSize / 1024.0, Entry.TemplateSize / 1024.0, *Entry.Template->GetPathName());
+		}
+	}));
+#endif
@@ -0,0 +1,162 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAssetRegistryTags.h"
+#include "FlowAsset.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+#if WITH_EDITOR
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
+
+namespace FlowAssetRegistryTags
+{
+	static const FName SubGraphs(TEXT("FlowSubGraphs"));
+	static const FName NodeClasses(TEXT("FlowNodeClasses"));
+	static const FName GameplayTags(TEXT("FlowGameplayTags"));
+	static const FName CustomInputs(TEXT("FlowCustomInputs"));
+	static const FName CustomOutputs(TEXT("FlowCustomOutputs"));
+
+	static const TCHAR* Separator = TEXT(";");
+
+	template <typename ElementType>
+	static FString Join(const TArray<ElementType>& Elements)
+	{
+		TArray<FString> Strings;
+		Strings.Reserve(Elements.Num());
+		for (const ElementType& Element : Elements)
+		{
+			Strings.Add(Element.ToString());
+		}
+		return FString::Join(Strings, Separator);
+	}
+
+	static void Split(const FAssetData& AssetData, const FName& Tag, TArray<FString>& OutStrings)
+	{
+		FString Value;
+		if (AssetData.GetTagValue(Tag, Value))
+		{
+			Value.ParseIntoArray(OutStrings, Separator);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void FFlowAssetRegistryTags::AddAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	using namespace FlowAssetRegistryTags;
+
+	TArray<FGameplayTag> Tags;
+	GameplayTags.GetGameplayTagArray(Tags);
+
+	Context.AddTag(UObject::FAssetRegistryTag(FlowAssetRegistryTags::SubGraphs, Join(SubGraphs), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(FlowAssetRegistryTags::NodeClasses, Join(NodeClasses), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(FlowAssetRegistryTags::GameplayTags, Join(Tags), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(FlowAssetRegistryTags::CustomInputs, Join(CustomInputs), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(FlowAssetRegistryTags::CustomOutputs, Join(CustomOutputs), UObject::FAssetRegistryTag::TT_Hidden));
+}
+#endif
+
+bool FFlowAssetRegistryTags::FromAssetData(const FAssetData& AssetData, FFlowAssetRegistryTags& OutTags)
+{
+	using namespace FlowAssetRegistryTags;
+
+	// all tags are written together, empty values included
+	if (!AssetData.FindTag(FlowAssetRegistryTags::NodeClasses))
+	{
+		return false;
+	}
+
+	OutTags = FFlowAssetRegistryTags();
+	TArray<FString> Strings;
+
+	Split(AssetData, FlowAssetRegistryTags::SubGraphs, Strings);
+	for (const FString& String : Strings)
+	{
+		OutTags.SubGraphs.Emplace(String);
+	}
+
+	Split(AssetData, FlowAssetRegistryTags::NodeClasses, Strings);
+	for (const FString& String : Strings)
+	{
+		OutTags.NodeClasses.Emplace(String);
+	}
+
+	// tags removed from the project since saving the asset are dropped
+	Split(AssetData, FlowAssetRegistryTags::GameplayTags, Strings);
+	for (const FString& String : Strings)
+	{
+		const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*String), false);
+		if (Tag.IsValid())
+		{
+			OutTags.GameplayTags.AddTagFast(Tag);
+		}
+	}
+
+	Split(AssetData, FlowAssetRegistryTags::CustomInputs, Strings);
+	for (const FString& String : Strings)
+	{
+		OutTags.CustomInputs.Emplace(*String);
+	}
+
+	Split(AssetData, FlowAssetRegistryTags::CustomOutputs, Strings);
+	for (const FString& String : Strings)
+	{
+		OutTags.CustomOutputs.Emplace(*String);
+	}
+
+	return true;
+}
+
+void FFlowAssetRegistryTags::FindAssets(TFunctionRef<bool(const FAssetData& AssetData, const FFlowAssetRegistryTags& Tags)> Predicate, TArray<FAssetData>& OutAssets)
+{
+	TArray<FAssetData> FlowAssets;
+	FAssetRegistryModule::GetRegistry().GetAssetsByClass(UFlowAsset::StaticClass()->GetClassPathName(), FlowAssets, true);
+
+	FFlowAssetRegistryTags Tags;
+	for (const FAssetData& AssetData : FlowAssets)
+	{
+		if (FromAssetData(AssetData, Tags) && Predicate(AssetData, Tags))
+		{
+			OutAssets.Add(AssetData);
+		}
+	}
+}
+
+void FFlowAssetRegistryTags::FindAssetsReferencingSubGraph(const FSoftObjectPath& SubGraph, TArray<FAssetData>& OutAssets)
+{
+	FindAssets([&SubGraph](const FAssetData&, const FFlowAssetRegistryTags& Tags)
+	{
+		return Tags.SubGraphs.Contains(SubGraph);
+	}, OutAssets);
+}
+
+void FFlowAssetRegistryTags::FindAssetsUsingNodeClass(const UClass* NodeClass, TArray<FAssetData>& OutAssets)
+{
+	if (NodeClass == nullptr)
+	{
+		return;
+	}
+
+	const FTopLevelAssetPath ClassPath = NodeClass->GetClassPathName();
+	FindAssets([&ClassPath](const FAssetData&, const FFlowAssetRegistryTags& Tags)
+	{
+		return Tags.NodeClasses.Contains(ClassPath);
+	}, OutAssets);
+}
+
+void FFlowAssetRegistryTags::FindAssetsUsingGameplayTag(const FGameplayTag& Tag, TArray<FAssetData>& OutAssets)
+{
+	FindAssets([&Tag](const FAssetData&, const FFlowAssetRegistryTags& Tags)
+	{
+		for (const FGameplayTag& UsedTag : Tags.GameplayTags)
+		{
+			if (UsedTag.MatchesTag(Tag))
+			{
+				return true;
+			}
+		}
+		return false;
+	}, OutAssets);
+}
@@ -0,0 +1,150 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowAsset.h"
+#include "Nodes/Graph/FlowNode_Finish.h"
+#include "Nodes/Graph/FlowNode_Start.h"
+#include "Nodes/Graph/FlowNode_SubGraph.h"
+#include "Nodes/Route/FlowNode_ExecutionSequence.h"
+#include "Nodes/Route/FlowNode_Reroute.h"
+
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Builds synthetic Flow Assets in the transient package, without the editor graph
+ * Friend of UFlowAsset, so nodes can be added directly to the Nodes map
+ */
+struct FFlowBenchmarkGraphs
+{
+	struct FGraph
+	{
+		UFlowAsset* Asset = nullptr;
+
+		// Inputs triggered by starting a single instance of the graph
+		int32 TriggersPerInstance = 0;
+
+		// Root instance and sub graph instances created by starting a single instance of the graph
+		int32 InstancesPerRoot = 1;
+
+		// Sub graphs reference the nested assets only by soft pointers
+		TArray<TStrongObjectPtr<UFlowAsset>> KeepAlive;
+	};
+
+	static UFlowAsset* CreateAsset(FGraph& Graph, const TCHAR* Name)
+	{
+		UPackage* Package = GetTransientPackage();
+		UFlowAsset* Asset = NewObject<UFlowAsset>(Package, MakeUniqueObjectName(Package, UFlowAsset::StaticClass(), FName(Name)), RF_Transient);
+		Graph.KeepAlive.Emplace(Asset);
+		return Asset;
+	}
+
+	template <typename NodeType>
+	static NodeType* AddNode(UFlowAsset& Asset)
+	{
+		NodeType* Node = NewObject<NodeType>(&Asset, NAME_None, RF_Transient);
+		Node->SetGuid(FGuid::NewGuid());
+		Asset.Nodes.Emplace(Node->GetGuid(), Node);
+		return Node;
+	}
+
+	static void Connect(UFlowNode& From, const FName& OutputPin, const UFlowNode& To, const FName& InputPin)
+	{
+		TMap<FName, FConnectedPin> Connections = From.GetConnections();
+		Connections.Add(OutputPin, FConnectedPin(To.GetGuid(), InputPin));
+		From.SetConnections(Connections);
+	}
+
+	// Start -> Reroute x Length -> Finish
+	static FGraph MakeChain(const int32 Length)
+	{
+		FGraph Graph;
+		Graph.Asset = CreateAsset(Graph, TEXT("FlowBenchmark_Chain"));
+
+		UFlowNode* PreviousNode = AddNode<UFlowNode_Start>(*Graph.Asset);
+		for (int32 Index = 0; Index < Length; Index++)
+		{
+			UFlowNode* Reroute = AddNode<UFlowNode_Reroute>(*Graph.Asset);
+			Connect(*PreviousNode, UFlowNode::DefaultOutputPin.PinName, *Reroute, UFlowNode::DefaultInputPin.PinName);
+			PreviousNode = Reroute;
+		}
+
+		const UFlowNode* Finish = AddNode<UFlowNode_Finish>(*Graph.Asset);
+		Connect(*PreviousNode, UFlowNode::DefaultOutputPin.PinName, *Finish, UFlowNode::DefaultInputPin.PinName);
+
+		Graph.TriggersPerInstance = Length + 1;
+		return Graph;
+	}
+
+	// Start -> binary tree of Sequences, Depth levels deep -> 2^Depth leaves created by MakeLeaf
+	static FGraph MakeFanOut(const TCHAR* Name, const int32 Depth, TFunctionRef<UFlowNode*(UFlowAsset&)> MakeLeaf, const FName& LeafInputPin)
+	{
+		FGraph Graph;
+		Graph.Asset = CreateAsset(Graph, Name);
+
+		TArray<TPair<UFlowNode*, FName>> OpenOutputs;
+		OpenOutputs.Emplace(AddNode<UFlowNode_Start>(*Graph.Asset), UFlowNode::DefaultOutputPin.PinName);
+
+		for (int32 Level = 0; Level < Depth; Level++)
+		{
+			TArray<TPair<UFlowNode*, FName>> NextOutputs;
+			for (const TPair<UFlowNode*, FName>& OpenOutput : OpenOutputs)
+			{
+				UFlowNode* Sequence = AddNode<UFlowNode_ExecutionSequence>(*Graph.Asset);
+				Connect(*OpenOutput.Key, OpenOutput.Value, *Sequence, UFlowNode::DefaultInputPin.PinName);
+				Graph.TriggersPerInstance++;
+
+				for (const FFlowPin& OutputPin : Sequence->GetOutputPins())
+				{
+					NextOutputs.Emplace(Sequence, OutputPin.PinName);
+				}
+			}
+			OpenOutputs = MoveTemp(NextOutputs);
+		}
+
+		for (const TPair<UFlowNode*, FName>& OpenOutput : OpenOutputs)
+		{
+			const UFlowNode* Leaf = MakeLeaf(*Graph.Asset);
+			Connect(*OpenOutput.Key, OpenOutput.Value, *Leaf, LeafInputPin);
+			Graph.TriggersPerInstance++;
+		}
+
+		return Graph;
+	}
+
+	// Start -> Sub Graph -> Finish, each Sub Graph instancing the graph one level lower
+	static FGraph MakeNestedSubGraphs(const int32 Depth)
+	{
+		FGraph Graph;
+		for (int32 Level = 0; Level <= Depth; Level++)
+		{
+			UFlowAsset* Asset = CreateAsset(Graph, TEXT("FlowBenchmark_SubGraph"));
+			UFlowNode* Start = AddNode<UFlowNode_Start>(*Asset);
+			const UFlowNode* Finish = AddNode<UFlowNode_Finish>(*Asset);
+
+			if (Graph.Asset)
+			{
+				UFlowNode_SubGraph* SubGraph = AddNode<UFlowNode_SubGraph>(*Asset);
+				SubGraph->Asset = Graph.Asset;
+				Connect(*Start, UFlowNode::DefaultOutputPin.PinName, *SubGraph, UFlowNode_SubGraph::StartPin.PinName);
+				Connect(*SubGraph, UFlowNode_SubGraph::FinishPin.PinName, *Finish, UFlowNode::DefaultInputPin.PinName);
+
+				// Sub Graph input and Finish node of this level
+				Graph.TriggersPerInstance += 2;
+				Graph.InstancesPerRoot++;
+			}
+			else
+			{
+				Connect(*Start, UFlowNode::DefaultOutputPin.PinName, *Finish, UFlowNode::DefaultInputPin.PinName);
+				Graph.TriggersPerInstance = 1;
+			}
+
+			Graph.Asset = Asset;
+		}
+
+		return Graph;
+	}
+};
+#endif
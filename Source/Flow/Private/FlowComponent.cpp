@@ -5,7 +5,10 @@
 #include "FlowAsset.h"
 #include "FlowLogChannels.h"
 #include "FlowSettings.h"
+#include "FlowStats.h"
 #include "FlowSubsystem.h"
+#include "Nodes/FlowNode.h"
+#include "Nodes/Graph/FlowNode_CustomInput.h"
 
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
@@ -18,12 +21,71 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowComponent)
 
+namespace FlowNetStats
+{
+	int64 GetSerializedBits(const FNetDeltaSerializeInfo& DeltaParams)
+	{
+		if (DeltaParams.Writer)
+		{
+			return DeltaParams.Writer->GetNumBits();
+		}
+
+		return DeltaParams.Reader ? DeltaParams.Reader->GetPosBits() : 0;
+	}
+
+	// Network Insights attributes these bits to the replicated property, CSV captures aggregate them per property and component class
+	template <typename ItemType, typename SerializerType>
+	bool DeltaSerialize(TArray<ItemType>& Items, FNetDeltaSerializeInfo& DeltaParams, SerializerType& Serializer, const FName& PropertyName)
+	{
+		const int64 StartBits = GetSerializedBits(DeltaParams);
+		const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<ItemType, SerializerType>(Items, DeltaParams, Serializer);
+
+		const int64 SerializedBytes = (GetSerializedBits(DeltaParams) - StartBits + 7) / 8;
+		if (SerializedBytes > 0)
+		{
+			INC_DWORD_STAT_BY(STAT_FlowReplicatedBytes, SerializedBytes);
+
+#if CSV_PROFILER
+			if (FCsvProfiler::Get()->IsCapturing())
+			{
+				const int32 CategoryIndex = CSV_CATEGORY_INDEX(FlowNetworking);
+				FCsvProfiler::RecordCustomStat(PropertyName, CategoryIndex, static_cast<int32>(SerializedBytes), ECsvCustomStatOp::Accumulate);
+				if (Serializer.OwnerComponent)
+				{
+					FCsvProfiler::RecordCustomStat(Serializer.OwnerComponent->GetClass()->GetFName(), CategoryIndex, static_cast<int32>(SerializedBytes), ECsvCustomStatOp::Accumulate);
+				}
+			}
+#endif
+		}
+
+		return bResult;
+	}
+
+	// Sent by the server and delivered on clients, per notify tag
+	void RecordNotifies(const FGameplayTagContainer& NotifyTags)
+	{
+		INC_DWORD_STAT_BY(STAT_FlowReplicatedNotifies, NotifyTags.Num());
+
+#if CSV_PROFILER
+		if (FCsvProfiler::Get()->IsCapturing())
+		{
+			for (const FGameplayTag& NotifyTag : NotifyTags)
+			{
+				FCsvProfiler::RecordCustomStat(NotifyTag.GetTagName(), CSV_CATEGORY_INDEX(FlowNetworking), 1, ECsvCustomStatOp::Accumulate);
+			}
+		}
+#endif
+	}
+}
+
 UFlowComponent::UFlowComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, bCosmetic(false)
 	, RootFlow(nullptr)
 	, bAutoStartRootFlow(true)
 	, RootFlowMode(EFlowNetMode::Authority)
 	, bAllowMultipleInstances(true)
+	, EndPlayFinishPolicy(EFlowFinishPolicy::Keep)
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
@@ -31,6 +93,28 @@ UFlowComponent::UFlowComponent(const FObjectInitializer& ObjectInitializer)
 	SetIsReplicatedByDefault(true);
 }
 
+void UFlowComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+	BindReplicatedArrays();
+}
+
+void UFlowComponent::OnRegister()
+{
+	// covers components duplicated or reinstanced after initializing properties
+	BindReplicatedArrays();
+	Super::OnRegister();
+}
+
+void UFlowComponent::BindReplicatedArrays()
+{
+	ReplicatedIdentityTags.OwnerComponent = this;
+	ReplicatedNotifies.OwnerComponent = this;
+	ReplicatedFlowInstances.OwnerComponent = this;
+	ReplicatedFlowNodes.OwnerComponent = this;
+	ReplayFlowState.OwnerComponent = this;
+}
+
 void UFlowComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -39,17 +123,23 @@ void UFlowComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 	FDoRepLifetimeParams Params;
 	Params.bIsPushBased = true;
 
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, IdentityTags, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedIdentityTags, Params);
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedNotifies, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedFlowInstances, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedFlowNodes, Params);
 
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, RecentlySentNotifyTags, Params);
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, NotifyTagsFromGraph, Params);
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, NotifyTagsFromAnotherComponent, Params);
+	FDoRepLifetimeParams ReplayParams = Params;
+	ReplayParams.Condition = COND_ReplayOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplayFlowState, ReplayParams);
 #else
-	DOREPLIFETIME(ThisClass, IdentityTags);
+	DOREPLIFETIME(ThisClass, ReplicatedIdentityTags);
 
-	DOREPLIFETIME(ThisClass, RecentlySentNotifyTags);
-	DOREPLIFETIME(ThisClass, NotifyTagsFromGraph);
-	DOREPLIFETIME(ThisClass, NotifyTagsFromAnotherComponent);
+	DOREPLIFETIME(ThisClass, ReplicatedNotifies);
+	DOREPLIFETIME(ThisClass, ReplicatedFlowInstances);
+	DOREPLIFETIME(ThisClass, ReplicatedFlowNodes);
+
+	DOREPLIFETIME_CONDITION(ThisClass, ReplayFlowState, COND_ReplayOnly);
 #endif
 }
 
@@ -57,7 +147,16 @@ void UFlowComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// tags might have been set on the instance, or changed before BeginPlay
+	ReplicateIdentityTags();
+
 	RegisterWithFlowSubsystem();
+
+	const UFlowSettings* Settings = UFlowSettings::Get();
+	if (Settings->bRecordFlowStateInReplays && RootFlow && GetOwner()->HasAuthority())
+	{
+		ReplayFlowStateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowComponent::RecordReplayFlowState), Settings->ReplayFlowStateInterval);
+	}
 }
 
 void UFlowComponent::RegisterWithFlowSubsystem()
@@ -93,8 +192,37 @@ void UFlowComponent::BeginRootFlow(bool bComponentLoadedFromSaveGame)
 
 void UFlowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// registry has to know the final tags to fully unregister the component
+	CommitIdentityTagChanges();
 	UnregisterWithFlowSubsystem();
 
+	if (ReplicatedStateTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReplicatedStateTickerHandle);
+		ReplicatedStateTickerHandle.Reset();
+	}
+	PendingReplicatedStates.Empty();
+
+	if (ReplayFlowStateTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReplayFlowStateTickerHandle);
+		ReplayFlowStateTickerHandle.Reset();
+	}
+
+	if (ThrottledNotifiesTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ThrottledNotifiesTickerHandle);
+		ThrottledNotifiesTickerHandle.Reset();
+	}
+	ThrottledNotifies.Empty();
+
+	if (ClientCustomInputsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ClientCustomInputsTickerHandle);
+		ClientCustomInputsTickerHandle.Reset();
+	}
+	PendingClientCustomInputs.Empty();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -102,7 +230,7 @@ void UFlowComponent::UnregisterWithFlowSubsystem()
 {
 	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		FlowSubsystem->FinishAllRootFlows(this, EFlowFinishPolicy::Keep);
+		FlowSubsystem->FinishAllRootFlows(this, EndPlayFinishPolicy);
 		FlowSubsystem->UnregisterComponent(this);
 	}
 }
@@ -112,12 +240,16 @@ void UFlowComponent::AddIdentityTag(const FGameplayTag Tag, const EFlowNetMode N
 	if (IsFlowNetMode(NetMode) && Tag.IsValid() && !IdentityTags.HasTagExact(Tag))
 	{
 		IdentityTags.AddTag(Tag);
-#if WITH_PUSH_MODEL
-		if (GetNetMode() < NM_Client)
+		IdentityTagsVersion++;
+
+		if (IsCoalescingIdentityTagChanges())
 		{
-			MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, IdentityTags, this);
+			QueueIdentityTagChanges(FGameplayTagContainer(Tag), true);
+			return;
 		}
-#endif
+
+		ReplicateIdentityTags();
+
 		if (HasBegunPlay())
 		{
 			OnIdentityTagsAdded.Broadcast(this, FGameplayTagContainer(Tag));
@@ -147,12 +279,16 @@ void UFlowComponent::AddIdentityTags(FGameplayTagContainer Tags, const EFlowNetM
 
 		if (ValidatedTags.Num() > 0)
 		{
-#if WITH_PUSH_MODEL
-			if (GetNetMode() < NM_Client)
+			IdentityTagsVersion++;
+
+			if (IsCoalescingIdentityTagChanges())
 			{
-				MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, IdentityTags, this);
+				QueueIdentityTagChanges(ValidatedTags, true);
+				return;
 			}
-#endif
+
+			ReplicateIdentityTags();
+
 			if (HasBegunPlay())
 			{
 				OnIdentityTagsAdded.Broadcast(this, ValidatedTags);
@@ -171,12 +307,16 @@ void UFlowComponent::RemoveIdentityTag(const FGameplayTag Tag, const EFlowNetMod
 	if (IsFlowNetMode(NetMode) && Tag.IsValid() && IdentityTags.HasTagExact(Tag))
 	{
 		IdentityTags.RemoveTag(Tag);
-#if WITH_PUSH_MODEL
-		if (GetNetMode() < NM_Client)
+		IdentityTagsVersion++;
+
+		if (IsCoalescingIdentityTagChanges())
 		{
-			MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, IdentityTags, this);
+			QueueIdentityTagChanges(FGameplayTagContainer(Tag), false);
+			return;
 		}
-#endif
+
+		ReplicateIdentityTags();
+
 		if (HasBegunPlay())
 		{
 			OnIdentityTagsRemoved.Broadcast(this, FGameplayTagContainer(Tag));
@@ -206,12 +346,16 @@ void UFlowComponent::RemoveIdentityTags(FGameplayTagContainer Tags, const EFlowN
 
 		if (ValidatedTags.Num() > 0)
 		{
-#if WITH_PUSH_MODEL
-			if (GetNetMode() < NM_Client)
+			IdentityTagsVersion++;
+
+			if (IsCoalescingIdentityTagChanges())
 			{
-				MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, IdentityTags, this);
+				QueueIdentityTagChanges(ValidatedTags, false);
+				return;
 			}
-#endif
+
+			ReplicateIdentityTags();
+
 			if (HasBegunPlay())
 			{
 				OnIdentityTagsRemoved.Broadcast(this, ValidatedTags);
@@ -225,21 +369,198 @@ void UFlowComponent::RemoveIdentityTags(FGameplayTagContainer Tags, const EFlowN
 	}
 }
 
-void UFlowComponent::OnRep_IdentityTags(const FGameplayTagContainer& PreviousTags)
+bool UFlowComponent::IsCosmetic() const
+{
+	return bCosmetic || (RootFlow && RootFlow->bCosmetic);
+}
+
+bool UFlowComponent::IsCoalescingIdentityTagChanges() const
+{
+	return HasBegunPlay() && UFlowSettings::Get()->bCoalesceIdentityTagChanges;
+}
+
+void UFlowComponent::QueueIdentityTagChanges(const FGameplayTagContainer& Tags, const bool bAdded)
+{
+	FGameplayTagContainer& PendingTags = bAdded ? PendingAddedIdentityTags : PendingRemovedIdentityTags;
+	FGameplayTagContainer& OppositeTags = bAdded ? PendingRemovedIdentityTags : PendingAddedIdentityTags;
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		// tag removed and added again in the same frame didn't change at all
+		if (!OppositeTags.RemoveTag(Tag))
+		{
+			PendingTags.AddTag(Tag);
+		}
+	}
+
+	if (!IdentityTagsCommitHandle.IsValid())
+	{
+		IdentityTagsCommitHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+		{
+			IdentityTagsCommitHandle.Reset();
+			CommitIdentityTagChanges();
+			return false;
+		}));
+	}
+}
+
+void UFlowComponent::CommitIdentityTagChanges()
+{
+	if (IdentityTagsCommitHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(IdentityTagsCommitHandle);
+		IdentityTagsCommitHandle.Reset();
+	}
+
+	if (PendingAddedIdentityTags.IsEmpty() && PendingRemovedIdentityTags.IsEmpty())
+	{
+		return;
+	}
+
+	const FGameplayTagContainer AddedTags = MoveTemp(PendingAddedIdentityTags);
+	const FGameplayTagContainer RemovedTags = MoveTemp(PendingRemovedIdentityTags);
+	PendingAddedIdentityTags.Reset();
+	PendingRemovedIdentityTags.Reset();
+
+	ReplicateIdentityTags();
+
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+
+	// registry expects Identity Tags to be in the state right after the reported change, so it's rebuilt in two steps
+	if (RemovedTags.Num() > 0)
+	{
+		const FGameplayTagContainer FinalTags = IdentityTags;
+		IdentityTags.RemoveTags(AddedTags);
+
+		OnIdentityTagsRemoved.Broadcast(this, RemovedTags);
+		if (FlowSubsystem)
+		{
+			FlowSubsystem->OnIdentityTagsRemoved(this, RemovedTags);
+		}
+
+		IdentityTags = FinalTags;
+	}
+
+	if (AddedTags.Num() > 0)
+	{
+		OnIdentityTagsAdded.Broadcast(this, AddedTags);
+		if (FlowSubsystem)
+		{
+			FlowSubsystem->OnIdentityTagsAdded(this, AddedTags);
+		}
+	}
+}
+
+void FFlowIdentityTagArray::SyncTags(const FGameplayTagContainer& Tags)
+{
+	bool bRemovedItems = false;
+	for (int32 Index = Items.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Tags.HasTagExact(Items[Index].Tag))
+		{
+			Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			bRemovedItems = true;
+		}
+	}
+
+	if (bRemovedItems)
+	{
+		MarkArrayDirty();
+	}
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (!Items.ContainsByPredicate([&Tag](const FFlowIdentityTagItem& Item) { return Item.Tag == Tag; }))
+		{
+			FFlowIdentityTagItem& Item = Items.AddDefaulted_GetRef();
+			Item.Tag = Tag;
+			MarkItemDirty(Item);
+		}
+	}
+}
+
+bool FFlowIdentityTagArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	static const FName PropertyName(TEXT("ReplicatedIdentityTags"));
+	return FlowNetStats::DeltaSerialize<FFlowIdentityTagItem, FFlowIdentityTagArray>(Items, DeltaParams, *this, PropertyName);
+}
+
+void FFlowIdentityTagArray::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, const int32 FinalSize)
+{
+	for (const int32 Index : RemovedIndices)
+	{
+		ReceivedRemovedTags.AddTag(Items[Index].Tag);
+	}
+}
+
+void FFlowIdentityTagArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize)
+{
+	for (const int32 Index : AddedIndices)
+	{
+		ReceivedAddedTags.AddTag(Items[Index].Tag);
+		ReceivedRemovedTags.RemoveTag(Items[Index].Tag);
+	}
+}
+
+void FFlowIdentityTagArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowReceiveReplicatedState);
+
+	if (OwnerComponent == nullptr)
+	{
+		return;
+	}
+	check(&OwnerComponent->ReplicatedIdentityTags == this);
+
+	if (!bReceivedInitialState)
+	{
+		bReceivedInitialState = true;
+
+		ReceivedAddedTags.Reset();
+		ReceivedRemovedTags = OwnerComponent->IdentityTags;
+
+		for (const FFlowIdentityTagItem& Item : Items)
+		{
+			ReceivedAddedTags.AddTag(Item.Tag);
+			ReceivedRemovedTags.RemoveTag(Item.Tag);
+		}
+	}
+
+	const FGameplayTagContainer AddedTags = MoveTemp(ReceivedAddedTags);
+	const FGameplayTagContainer RemovedTags = MoveTemp(ReceivedRemovedTags);
+	ReceivedAddedTags.Reset();
+	ReceivedRemovedTags.Reset();
+
+	OwnerComponent->OnIdentityTagsReplicated(AddedTags, RemovedTags);
+}
+
+void UFlowComponent::ReplicateIdentityTags()
 {
+	if (GetNetMode() < NM_Client)
+	{
+		ReplicatedIdentityTags.SyncTags(IdentityTags);
+#if WITH_PUSH_MODEL
+		MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedIdentityTags, this);
+#endif
+	}
+}
 
-	// Any tags that are now in the IdentityTags container but haven't been previously must have been added.
+void UFlowComponent::OnIdentityTagsReplicated(const FGameplayTagContainer& ReplicatedAddedTags, const FGameplayTagContainer& ReplicatedRemovedTags)
+{
+	// replicated changes might include tags already applied, i.e. set on this instance in the editor
 	FGameplayTagContainer AddedTags;
-	for (const FGameplayTag& Tag : IdentityTags)
+	for (const FGameplayTag& Tag : ReplicatedAddedTags)
 	{
-		if (!PreviousTags.HasTagExact(Tag))
+		if (!IdentityTags.HasTagExact(Tag))
 		{
+			IdentityTags.AddTag(Tag);
 			AddedTags.AddTag(Tag);
 		}
 	}
 
 	if (AddedTags.Num() > 0)
 	{
+		IdentityTagsVersion++;
 		OnIdentityTagsAdded.Broadcast(this, AddedTags);
 
 		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
@@ -248,17 +569,19 @@ void UFlowComponent::OnRep_IdentityTags(const FGameplayTagContainer& PreviousTag
 		}
 	}
 
-	// Any tags that have been in the IdentityTags container previously but aren't in it anymore after the replication update must have been removed.
 	FGameplayTagContainer RemovedTags;
-	for (const FGameplayTag& Tag : PreviousTags)
+	for (const FGameplayTag& Tag : ReplicatedRemovedTags)
 	{
-		if (!IdentityTags.HasTagExact(Tag))
+		if (IdentityTags.HasTagExact(Tag))
 		{
+			IdentityTags.RemoveTag(Tag);
 			RemovedTags.AddTag(Tag);
 		}
 	}
+
 	if (RemovedTags.Num() > 0)
 	{
+		IdentityTagsVersion++;
 		OnIdentityTagsRemoved.Broadcast(this, RemovedTags);
 
 		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
@@ -282,164 +605,619 @@ void UFlowComponent::LogError(FString Message, const EFlowOnScreenMessageType On
 {
 	Message += TEXT(" --- Flow Component in actor ") + GetOwner()->GetName();
 
-	if (OnScreenMessageType == EFlowOnScreenMessageType::Permanent)
+	// nobody would see on-screen message on the lean server
+	if (!UFlowSettings::Get()->IsLeanServer(GetWorld()))
 	{
-		if (UWorld* World = GetWorld())
+		if (OnScreenMessageType == EFlowOnScreenMessageType::Permanent)
 		{
-			if (UViewportStatsSubsystem* StatsSubsystem = World->GetSubsystem<UViewportStatsSubsystem>())
+			if (UWorld* World = GetWorld())
 			{
-				StatsSubsystem->AddDisplayDelegate([WeakThis = TWeakObjectPtr<const UFlowComponent>(this), Message](FText& OutText, FLinearColor& OutColor)
+				if (UViewportStatsSubsystem* StatsSubsystem = World->GetSubsystem<UViewportStatsSubsystem>())
 				{
-					if (WeakThis.Get())
+					StatsSubsystem->AddDisplayDelegate([WeakThis = TWeakObjectPtr<const UFlowComponent>(this), Message](FText& OutText, FLinearColor& OutColor)
 					{
-						OutText = FText::FromString(Message);
-						OutColor = FLinearColor::Red;
-						return true;
-					}
-
-					return false;
-				});
+						if (WeakThis.Get())
+						{
+							OutText = FText::FromString(Message);
+							OutColor = FLinearColor::Red;
+							return true;
+						}
+
+						return false;
+					});
+				}
 			}
 		}
-	}
-	else
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, Message);
+		else
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, Message);
+		}
 	}
 
 	UE_LOG(LogFlow, Error, TEXT("%s"), *Message);
 }
 
-void UFlowComponent::NotifyGraph(const FGameplayTag NotifyTag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+void FFlowNotifyRing::AddNotify(const EFlowNotifyType Type, const FGameplayTagContainer& NotifyTags, const FGameplayTag& ActorTag, UFlowComponent* Sender, const int32 Count)
 {
-	if (IsFlowNetMode(NetMode) && NotifyTag.IsValid() && HasBegunPlay())
+	// items aren't sent before the end of the frame, so the last one can still be extended
+	if (LastNotifyFrame == GFrameCounter && Items.Num() > 0)
 	{
-		// save recently notify, this allows for the retroactive check in nodes
-		// if retroactive check wouldn't be performed, this is only used by the network replication
-		RecentlySentNotifyTags = FGameplayTagContainer(NotifyTag);
-#if WITH_PUSH_MODEL
-		if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
+		FFlowNotifyItem& LastNotify = Items.Last();
+		if (LastNotify.Type == Type && LastNotify.ActorTag == ActorTag && LastNotify.Sender == Sender && LastNotify.Count == Count && !LastNotify.NotifyTags.HasAnyExact(NotifyTags))
 		{
-			MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, RecentlySentNotifyTags, this);
+			LastNotify.NotifyTags.AppendTags(NotifyTags);
+			MarkItemDirty(LastNotify);
+			return;
 		}
-#endif
+	}
+	LastNotifyFrame = GFrameCounter;
 
-		OnRep_SentNotifyTags();
+	// clients missing more notifies than the capacity lose the oldest ones, which is still better than collapsing them into the last one
+	if (Items.Num() >= Capacity)
+	{
+		Items.RemoveAt(0, 1, EAllowShrinking::No);
+		MarkArrayDirty();
 	}
+
+	FFlowNotifyItem& Notify = Items.AddDefaulted_GetRef();
+	Notify.Type = Type;
+	Notify.ActorTag = ActorTag;
+	Notify.NotifyTags = NotifyTags;
+	Notify.Sender = Sender;
+	Notify.Sequence = ++LastSequence;
+	Notify.Count = Count;
+
+	MarkItemDirty(Notify);
 }
 
-void UFlowComponent::BulkNotifyGraph(const FGameplayTagContainer NotifyTags, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+bool FFlowNotifyRing::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
 {
-	if (IsFlowNetMode(NetMode) && NotifyTags.IsValid() && HasBegunPlay())
+	static const FName PropertyName(TEXT("ReplicatedNotifies"));
+	return FlowNetStats::DeltaSerialize<FFlowNotifyItem, FFlowNotifyRing>(Items, DeltaParams, *this, PropertyName);
+}
+
+void FFlowNotifyRing::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize)
+{
+	if (OwnerComponent == nullptr)
 	{
-		FGameplayTagContainer ValidatedTags;
-		for (const FGameplayTag& Tag : NotifyTags)
+		return;
+	}
+	check(&OwnerComponent->ReplicatedNotifies == this);
+
+	if (!bReceivedInitialState)
+	{
+		bReceivedInitialState = true;
+		for (const FFlowNotifyItem& Item : Items)
 		{
-			if (Tag.IsValid())
-			{
-				ValidatedTags.AddTag(Tag);
-			}
+			LastSequence = FMath::Max(LastSequence, Item.Sequence);
 		}
+		return;
+	}
 
-		if (ValidatedTags.Num() > 0)
+	// items are replicated in arbitrary order and might be resent after the connection dropped packets
+	TArray<const FFlowNotifyItem*, TInlineAllocator<Capacity>> NewNotifies;
+	for (const int32 Index : AddedIndices)
+	{
+		if (Items.IsValidIndex(Index) && Items[Index].Sequence > LastSequence)
 		{
-			// save recently notify, this allows for the retroactive check in nodes
-			// if retroactive check wouldn't be performed, this is only used by the network replication
-			RecentlySentNotifyTags = ValidatedTags;
-#if WITH_PUSH_MODEL
-			if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
-			{
-				MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, RecentlySentNotifyTags, this);
-			}
-#endif
-
-			OnRep_SentNotifyTags();
+			NewNotifies.Add(&Items[Index]);
 		}
 	}
+
+	NewNotifies.Sort([](const FFlowNotifyItem& A, const FFlowNotifyItem& B)
+	{
+		return A.Sequence < B.Sequence;
+	});
+
+	for (const FFlowNotifyItem* Notify : NewNotifies)
+	{
+		LastSequence = Notify->Sequence;
+		OwnerComponent->OnNotifyReplicated(*Notify);
+	}
 }
 
-void UFlowComponent::OnRep_SentNotifyTags()
+void UFlowComponent::ReplicateNotify(const EFlowNotifyType Type, const FGameplayTagContainer& NotifyTags, const FGameplayTag& ActorTag, UFlowComponent* Sender, const int32 Count)
 {
-	for (const FGameplayTag& NotifyTag : RecentlySentNotifyTags)
+	if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
 	{
-		OnNotifyFromComponent.Broadcast(this, NotifyTag);
+		ReplicatedNotifies.AddNotify(Type, NotifyTags, ActorTag, Sender, Count);
+		FlowNetStats::RecordNotifies(NotifyTags);
+#if WITH_PUSH_MODEL
+		MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedNotifies, this);
+#endif
 	}
 }
 
-void UFlowComponent::NotifyFromGraph(const FGameplayTagContainer& NotifyTags, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+void UFlowComponent::OnNotifyReplicated(const FFlowNotifyItem& Notify)
 {
-	if (IsFlowNetMode(NetMode) && NotifyTags.IsValid() && HasBegunPlay())
+	SCOPE_CYCLE_COUNTER(STAT_FlowReceiveReplicatedNotifies);
+	FlowNetStats::RecordNotifies(Notify.NotifyTags);
+
+	RecentNotifyCount = Notify.Count;
+
+	switch (Notify.Type)
 	{
-		FGameplayTagContainer ValidatedTags;
-		for (const FGameplayTag& Tag : NotifyTags)
-		{
-			if (Tag.IsValid())
+		case EFlowNotifyType::ToGraph:
+			RecentlySentNotifyTags = Notify.NotifyTags;
+			BroadcastSentNotifyTags();
+			break;
+		case EFlowNotifyType::FromGraph:
+			for (const FGameplayTag& NotifyTag : Notify.NotifyTags)
 			{
-				ValidatedTags.AddTag(Tag);
+				BroadcastReceivedNotify(nullptr, NotifyTag);
 			}
-		}
-
-		if (ValidatedTags.Num() > 0)
-		{
-			for (const FGameplayTag& ValidatedTag : ValidatedTags)
+			break;
+		case EFlowNotifyType::ToActor:
+			for (const FGameplayTag& NotifyTag : Notify.NotifyTags)
 			{
-				ReceiveNotify.Broadcast(nullptr, ValidatedTag);
+				INC_DWORD_STAT(STAT_FlowReplicatedRegistryQueries);
+				CSV_CUSTOM_STAT(FlowNetworking, RegistryQueriesFromReplication, 1, ECsvCustomStatOp::Accumulate);
+				BroadcastNotifyToActors(Notify.ActorTag, NotifyTag, Notify.Count);
 			}
-
-			if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
+			break;
+		case EFlowNotifyType::Received:
+			for (const FGameplayTag& NotifyTag : Notify.NotifyTags)
 			{
-				NotifyTagsFromGraph = ValidatedTags;
-#if WITH_PUSH_MODEL
-				MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, NotifyTagsFromGraph, this);
-#endif
+				BroadcastReceivedNotify(Notify.Sender, NotifyTag);
 			}
-		}
+			break;
+		default: ;
 	}
 }
 
-void UFlowComponent::OnRep_NotifyTagsFromGraph()
+void UFlowComponent::NotifyGraph(const FGameplayTag NotifyTag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
 {
-	for (const FGameplayTag& NotifyTag : NotifyTagsFromGraph)
+	if (IsFlowNetMode(NetMode) && NotifyTag.IsValid() && HasBegunPlay() && !ThrottleNotify(FGameplayTag(), NotifyTag))
 	{
-		ReceiveNotify.Broadcast(nullptr, NotifyTag);
+		SendNotifyGraph(FGameplayTagContainer(NotifyTag));
 	}
 }
 
-void UFlowComponent::NotifyActor(const FGameplayTag ActorTag, const FGameplayTag NotifyTag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+void UFlowComponent::BulkNotifyGraph(const FGameplayTagContainer NotifyTags, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
 {
-	if (IsFlowNetMode(NetMode) && NotifyTag.IsValid() && HasBegunPlay())
+	if (IsFlowNetMode(NetMode) && NotifyTags.IsValid() && HasBegunPlay())
 	{
-		if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		FGameplayTagContainer ValidatedTags;
+		for (const FGameplayTag& Tag : NotifyTags)
 		{
-			for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(ActorTag))
+			if (Tag.IsValid() && !ThrottleNotify(FGameplayTag(), Tag))
 			{
-				Component->ReceiveNotify.Broadcast(this, NotifyTag);
+				ValidatedTags.AddTag(Tag);
 			}
 		}
 
-		if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
+		if (ValidatedTags.Num() > 0)
 		{
-			NotifyTagsFromAnotherComponent.Empty();
-			NotifyTagsFromAnotherComponent.Add(FNotifyTagReplication(ActorTag, NotifyTag));
-#if WITH_PUSH_MODEL
-			MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, NotifyTagsFromAnotherComponent, this);
-#endif
+			SendNotifyGraph(ValidatedTags);
 		}
 	}
 }
 
-void UFlowComponent::OnRep_NotifyTagsFromAnotherComponent()
+void UFlowComponent::SendNotifyGraph(const FGameplayTagContainer& NotifyTags, const int32 Count)
 {
-	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	// save recently notify, this allows for the retroactive check in nodes
+	RecentlySentNotifyTags = NotifyTags;
+	RecentNotifyCount = Count;
+	ReplicateNotify(EFlowNotifyType::ToGraph, RecentlySentNotifyTags, FGameplayTag(), nullptr, Count);
+
+	BroadcastSentNotifyTags();
+}
+
+void UFlowComponent::BroadcastSentNotifyTags()
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	for (const FGameplayTag& NotifyTag : RecentlySentNotifyTags)
+	{
+		OnNotifyFromComponent.Broadcast(this, NotifyTag);
+
+		if (FlowSubsystem)
+		{
+			FlowSubsystem->BroadcastComponentEvent(EFlowEventType::NotifyFromComponent, this, NotifyTag);
+		}
+	}
+}
+
+void UFlowComponent::BroadcastReceivedNotify(UFlowComponent* Sender, const FGameplayTag& NotifyTag)
+{
+	ReceiveNotify.Broadcast(Sender, NotifyTag);
+
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->BroadcastComponentEvent(EFlowEventType::ReceivedNotify, this, NotifyTag, Sender);
+	}
+}
+
+void UFlowComponent::NotifyFromGraph(const FGameplayTagContainer& NotifyTags, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+{
+	if (IsFlowNetMode(NetMode) && NotifyTags.IsValid() && HasBegunPlay())
+	{
+		FGameplayTagContainer ValidatedTags;
+		for (const FGameplayTag& Tag : NotifyTags)
+		{
+			if (Tag.IsValid())
+			{
+				ValidatedTags.AddTag(Tag);
+			}
+		}
+
+		if (ValidatedTags.Num() > 0)
+		{
+			RecentNotifyCount = 1;
+			for (const FGameplayTag& ValidatedTag : ValidatedTags)
+			{
+				BroadcastReceivedNotify(nullptr, ValidatedTag);
+			}
+
+			ReplicateNotify(EFlowNotifyType::FromGraph, ValidatedTags);
+		}
+	}
+}
+
+void UFlowComponent::NotifyActor(const FGameplayTag ActorTag, const FGameplayTag NotifyTag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+{
+	if (IsFlowNetMode(NetMode) && NotifyTag.IsValid() && HasBegunPlay() && !(ActorTag.IsValid() && ThrottleNotify(ActorTag, NotifyTag)))
 	{
-		for (const FNotifyTagReplication& Notify : NotifyTagsFromAnotherComponent)
+		SendNotifyActor(ActorTag, NotifyTag);
+	}
+}
+
+void UFlowComponent::SendNotifyActor(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const int32 Count)
+{
+	if (UFlowSettings::Get()->bReplicateActorNotifiesByReceiver)
+	{
+		// replicated only to clients which can see the receiver
+		if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 		{
-			for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(Notify.ActorTag))
+			const FGameplayTagContainer NotifyTags(NotifyTag);
+			for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(ActorTag))
 			{
-				Component->ReceiveNotify.Broadcast(this, Notify.NotifyTag);
+				Component->RecentNotifyCount = Count;
+				Component->BroadcastReceivedNotify(this, NotifyTag);
+				Component->ReplicateNotify(EFlowNotifyType::Received, NotifyTags, ActorTag, this, Count);
 			}
 		}
 	}
+	else
+	{
+		BroadcastNotifyToActors(ActorTag, NotifyTag, Count);
+		ReplicateNotify(EFlowNotifyType::ToActor, FGameplayTagContainer(NotifyTag), ActorTag, nullptr, Count);
+	}
+}
+
+void UFlowComponent::BroadcastNotifyToActors(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const int32 Count)
+{
+	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(ActorTag))
+		{
+			Component->RecentNotifyCount = Count;
+			Component->BroadcastReceivedNotify(this, NotifyTag);
+		}
+	}
+}
+
+bool UFlowComponent::ThrottleNotify(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag)
+{
+	if (NotifyThrottles.Num() == 0 || GetWorld() == nullptr)
+	{
+		return false;
+	}
+
+	const FFlowNotifyThrottle* Throttle = NotifyThrottles.FindByPredicate([&NotifyTag](const FFlowNotifyThrottle& Entry)
+	{
+		return NotifyTag.MatchesTag(Entry.NotifyTag);
+	});
+
+	if (Throttle == nullptr || Throttle->MaxNotifiesPerSecond <= 0.0f)
+	{
+		return false;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	FThrottledNotify& ThrottledNotify = ThrottledNotifies.FindOrAdd(TPair<FGameplayTag, FGameplayTag>(ActorTag, NotifyTag));
+	ThrottledNotify.Interval = 1.0 / Throttle->MaxNotifiesPerSecond;
+
+	// first notify in the interval goes through immediately
+	if (ThrottledNotify.PendingCount == 0 && CurrentTime >= ThrottledNotify.NextSendTime)
+	{
+		ThrottledNotify.NextSendTime = CurrentTime + ThrottledNotify.Interval;
+		return false;
+	}
+
+	if (Throttle->Mode == EFlowNotifyThrottleMode::Accumulate)
+	{
+		if (ThrottledNotify.PendingCount > 0)
+		{
+			INC_DWORD_STAT(STAT_FlowMergedNotifies);
+		}
+		ThrottledNotify.PendingCount++;
+	}
+	else
+	{
+		if (ThrottledNotify.PendingCount > 0)
+		{
+			INC_DWORD_STAT(STAT_FlowDroppedNotifies);
+		}
+		ThrottledNotify.PendingCount = 1;
+	}
+
+	if (!ThrottledNotifiesTickerHandle.IsValid())
+	{
+		ThrottledNotifiesTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::FlushThrottledNotifies));
+	}
+
+	return true;
+}
+
+bool UFlowComponent::FlushThrottledNotifies(float DeltaTime)
+{
+	const double CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+
+	// sent after iterating, as listeners might send another notify
+	TArray<TTuple<FGameplayTag, FGameplayTag, int32>, TInlineAllocator<4>> ReadyNotifies;
+	for (TMap<TPair<FGameplayTag, FGameplayTag>, FThrottledNotify>::TIterator It = ThrottledNotifies.CreateIterator(); It; ++It)
+	{
+		FThrottledNotify& ThrottledNotify = It.Value();
+		if (CurrentTime < ThrottledNotify.NextSendTime)
+		{
+			continue;
+		}
+
+		if (ThrottledNotify.PendingCount > 0)
+		{
+			ReadyNotifies.Emplace(It.Key().Key, It.Key().Value, ThrottledNotify.PendingCount);
+			ThrottledNotify.PendingCount = 0;
+			ThrottledNotify.NextSendTime = CurrentTime + ThrottledNotify.Interval;
+		}
+		else
+		{
+			// interval passed without another notify, the next one is sent immediately
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const TTuple<FGameplayTag, FGameplayTag, int32>& ReadyNotify : ReadyNotifies)
+	{
+		if (ReadyNotify.Get<0>().IsValid())
+		{
+			SendNotifyActor(ReadyNotify.Get<0>(), ReadyNotify.Get<1>(), ReadyNotify.Get<2>());
+		}
+		else
+		{
+			SendNotifyGraph(FGameplayTagContainer(ReadyNotify.Get<1>()), ReadyNotify.Get<2>());
+		}
+	}
+
+	if (ThrottledNotifies.Num() == 0)
+	{
+		ThrottledNotifiesTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FFlowReplicatedInstanceArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	static const FName PropertyName(TEXT("ReplicatedFlowInstances"));
+	return FlowNetStats::DeltaSerialize<FFlowReplicatedInstanceState, FFlowReplicatedInstanceArray>(Items, DeltaParams, *this, PropertyName);
+}
+
+void FFlowReplicatedInstanceArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize)
+{
+	PostReplicatedChange(AddedIndices, FinalSize);
+}
+
+void FFlowReplicatedInstanceArray::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, const int32 FinalSize)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowReceiveReplicatedState);
+
+	if (OwnerComponent)
+	{
+		check(&OwnerComponent->ReplicatedFlowInstances == this);
+		for (const int32 Index : ChangedIndices)
+		{
+			OwnerComponent->OnFlowStateReplicated.Broadcast(OwnerComponent, Items[Index].TemplateAsset);
+		}
+	}
+}
+
+bool FFlowReplicatedNodeArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	static const FName PropertyName(TEXT("ReplicatedFlowNodes"));
+	return FlowNetStats::DeltaSerialize<FFlowReplicatedNodeState, FFlowReplicatedNodeArray>(Items, DeltaParams, *this, PropertyName);
+}
+
+void FFlowReplicatedNodeArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize)
+{
+	PostReplicatedChange(AddedIndices, FinalSize);
+}
+
+void FFlowReplicatedNodeArray::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, const int32 FinalSize)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowReceiveReplicatedState);
+
+	if (OwnerComponent == nullptr)
+	{
+		return;
+	}
+	check(&OwnerComponent->ReplicatedFlowNodes == this);
+
+	// single broadcast per asset, even if many of its nodes changed
+	TArray<const UFlowAsset*, TInlineAllocator<4>> ChangedAssets;
+	for (const int32 Index : ChangedIndices)
+	{
+		ChangedAssets.AddUnique(Items[Index].TemplateAsset);
+	}
+
+	for (const UFlowAsset* ChangedAsset : ChangedAssets)
+	{
+		OwnerComponent->OnFlowStateReplicated.Broadcast(OwnerComponent, ChangedAsset);
+	}
+}
+
+void UFlowComponent::MarkReplicatedFlowStateDirty(UFlowAsset* Instance)
+{
+	if (!PendingReplicatedStates.ContainsByPredicate([Instance](const FPendingReplicatedState& PendingState) { return PendingState.Instance == Instance; }))
+	{
+		PendingReplicatedStates.Add({Instance, Instance->GetTemplateAsset()});
+	}
+
+	if (!ReplicatedStateTickerHandle.IsValid())
+	{
+		ReplicatedStateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowComponent::FlushReplicatedFlowStates));
+	}
+}
+
+bool UFlowComponent::FlushReplicatedFlowStates(float DeltaTime)
+{
+	ReplicatedStateTickerHandle.Reset();
+
+	const TArray<FPendingReplicatedState> PendingStates = MoveTemp(PendingReplicatedStates);
+	PendingReplicatedStates.Reset();
+
+	for (const FPendingReplicatedState& PendingState : PendingStates)
+	{
+		UFlowAsset* Instance = PendingState.Instance.Get();
+		UFlowAsset* TemplateAsset = PendingState.TemplateAsset.Get();
+
+		// pooled instance might have been already reused by another owner
+		if (Instance && TemplateAsset && Instance->GetTemplateAsset() == TemplateAsset && Instance->GetOwner() == this && Instance->IsReplicatingState())
+		{
+			WriteReplicatedFlowState(Instance, TemplateAsset);
+		}
+		else if (TemplateAsset)
+		{
+			RemoveReplicatedFlowState(TemplateAsset);
+		}
+	}
+
+	// one-shot ticker
+	return false;
+}
+
+void UFlowComponent::WriteReplicatedFlowState(UFlowAsset* Instance, UFlowAsset* TemplateAsset)
+{
+	FFlowReplicatedInstanceState* InstanceState = ReplicatedFlowInstances.Items.FindByPredicate([TemplateAsset](const FFlowReplicatedInstanceState& State) { return State.TemplateAsset == TemplateAsset; });
+	if (InstanceState == nullptr)
+	{
+		InstanceState = &ReplicatedFlowInstances.Items.AddDefaulted_GetRef();
+		InstanceState->TemplateAsset = TemplateAsset;
+	}
+
+	TArray<uint8> ActiveNodes;
+	ActiveNodes.SetNumZeroed(FMath::DivideAndRoundUp(Instance->GetCompiledNodesNum(), 8));
+	for (const UFlowNode* ActiveNode : Instance->GetActiveNodes())
+	{
+		const int32 NodeIndex = Instance->GetCompiledNodeIndex(ActiveNode->GetGuid());
+		if (ActiveNodes.IsValidIndex(NodeIndex / 8))
+		{
+			ActiveNodes[NodeIndex / 8] |= 1 << (NodeIndex % 8);
+		}
+	}
+
+	if (InstanceState->ActiveNodes != ActiveNodes)
+	{
+		InstanceState->ActiveNodes = MoveTemp(ActiveNodes);
+		ReplicatedFlowInstances.MarkItemDirty(*InstanceState);
+	}
+
+	for (const int32 NodeIndex : Instance->TakeDirtyReplicatedNodes())
+	{
+		UFlowNode* Node = Instance->GetCompiledNode(NodeIndex);
+		if (Node == nullptr || !Instance->IsNodeInstantiated(Node))
+		{
+			continue;
+		}
+
+		TArray<uint8> NodeData;
+		FMemoryWriter MemoryWriter(NodeData, true);
+		FlowSave::SerializeSaveData(*Node, MemoryWriter, nullptr);
+
+		FFlowReplicatedNodeState* NodeState = ReplicatedFlowNodes.Items.FindByPredicate([TemplateAsset, NodeIndex](const FFlowReplicatedNodeState& State)
+		{
+			return State.TemplateAsset == TemplateAsset && State.NodeIndex == NodeIndex;
+		});
+
+		if (NodeState == nullptr)
+		{
+			NodeState = &ReplicatedFlowNodes.Items.AddDefaulted_GetRef();
+			NodeState->TemplateAsset = TemplateAsset;
+			NodeState->NodeIndex = NodeIndex;
+		}
+		else if (NodeState->NodeData == NodeData)
+		{
+			continue;
+		}
+
+		NodeState->NodeData = MoveTemp(NodeData);
+		ReplicatedFlowNodes.MarkItemDirty(*NodeState);
+	}
+
+#if WITH_PUSH_MODEL
+	MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedFlowInstances, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedFlowNodes, this);
+#endif
+}
+
+void UFlowComponent::RemoveReplicatedFlowState(const UFlowAsset* TemplateAsset)
+{
+	const int32 RemovedInstances = ReplicatedFlowInstances.Items.RemoveAll([TemplateAsset](const FFlowReplicatedInstanceState& State) { return State.TemplateAsset == TemplateAsset; });
+	const int32 RemovedNodes = ReplicatedFlowNodes.Items.RemoveAll([TemplateAsset](const FFlowReplicatedNodeState& State) { return State.TemplateAsset == TemplateAsset; });
+
+	if (RemovedInstances > 0)
+	{
+		ReplicatedFlowInstances.MarkArrayDirty();
+	}
+
+	if (RemovedNodes > 0)
+	{
+		ReplicatedFlowNodes.MarkArrayDirty();
+	}
+
+#if WITH_PUSH_MODEL
+	if (RemovedInstances > 0 || RemovedNodes > 0)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedFlowInstances, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplicatedFlowNodes, this);
+	}
+#endif
+}
+
+bool UFlowComponent::IsNodeActiveOnServer(UFlowAsset* TemplateAsset, const FGuid& NodeGuid) const
+{
+	if (TemplateAsset == nullptr)
+	{
+		return false;
+	}
+
+	const FFlowReplicatedInstanceState* InstanceState = ReplicatedFlowInstances.Items.FindByPredicate([TemplateAsset](const FFlowReplicatedInstanceState& State) { return State.TemplateAsset == TemplateAsset; });
+	return InstanceState && InstanceState->IsNodeActive(TemplateAsset->GetCompiledNodeIndex(NodeGuid));
+}
+
+bool UFlowComponent::ApplyReplicatedNodeState(UFlowNode* Node) const
+{
+	UFlowAsset* FlowInstance = Node ? Node->GetFlowAsset() : nullptr;
+	UFlowAsset* TemplateAsset = FlowInstance ? FlowInstance->GetTemplateAsset() : nullptr;
+	if (TemplateAsset == nullptr)
+	{
+		return false;
+	}
+
+	const int32 NodeIndex = TemplateAsset->GetCompiledNodeIndex(Node->GetGuid());
+	const FFlowReplicatedNodeState* NodeState = ReplicatedFlowNodes.Items.FindByPredicate([TemplateAsset, NodeIndex](const FFlowReplicatedNodeState& State)
+	{
+		return State.TemplateAsset == TemplateAsset && State.NodeIndex == NodeIndex;
+	});
+
+	if (NodeState == nullptr)
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(NodeState->NodeData, true);
+	FlowSave::SerializeSaveData(*Node, MemoryReader, nullptr);
+	return true;
 }
 
 void UFlowComponent::StartRootFlow()
@@ -477,13 +1255,15 @@ TSet<UFlowAsset*> UFlowComponent::GetRootInstances(const UObject* Owner) const
 
 UFlowAsset* UFlowComponent::GetRootFlowInstance() const
 {
-	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		const TSet<UFlowAsset*> Result = FlowSubsystem->GetRootInstancesByOwner(this);
-		if (Result.Num() > 0)
+		// Root Flow started inside a start batch isn't created until the batch ends, caller expects the instance now
+		if (FlowSubsystem->HasPendingRootFlowStart(this))
 		{
-			return Result.Array()[0];
+			FlowSubsystem->FlushPendingRootFlowStarts(this);
 		}
+
+		return FlowSubsystem->GetRootFlow(this);
 	}
 
 	return nullptr;
@@ -510,6 +1290,140 @@ void UFlowComponent::DispatchRootFlowCustomEvent(UFlowAsset* RootFlowInstance, c
 	OnRootFlowCustomEvent(RootFlowInstance, EventName);
 }
 
+void UFlowComponent::TriggerRootFlowCustomInputOnServer(UFlowAsset* TemplateAsset, const FName EventName)
+{
+	if (!IsValid(TemplateAsset))
+	{
+		return;
+	}
+
+	if (GetOwner()->HasAuthority())
+	{
+		TriggerRootInstanceCustomInput(TemplateAsset, EventName);
+		return;
+	}
+
+	// engine drops Server RPCs of actors not owned by this client, i.e. level actors
+	if (GetOwner()->GetNetConnection() == nullptr)
+	{
+		LogError(FString::Printf(TEXT("Can't send Custom Input %s to the server, %s isn't owned by this client"), *EventName.ToString(), *GetOwner()->GetName()), EFlowOnScreenMessageType::Temporary);
+		return;
+	}
+
+	const int32 InputIndex = TemplateAsset->FindCustomInputIndex(EventName);
+	if (InputIndex == INDEX_NONE || InputIndex > MAX_uint16)
+	{
+		LogError(FString::Printf(TEXT("%s has no Custom Input %s"), *TemplateAsset->GetName(), *EventName.ToString()), EFlowOnScreenMessageType::Temporary);
+		return;
+	}
+
+	const UFlowNode_CustomInput* InputNode = TemplateAsset->TryFindCustomInputNodeByEventName(EventName);
+	if (InputNode == nullptr || !InputNode->CanBeTriggeredByClient())
+	{
+		LogError(FString::Printf(TEXT("Custom Input %s of %s can't be triggered by clients, see Can Be Triggered By Client"), *EventName.ToString(), *TemplateAsset->GetName()), EFlowOnScreenMessageType::Temporary);
+		return;
+	}
+
+	FFlowClientCustomInput& Input = PendingClientCustomInputs.AddDefaulted_GetRef();
+	Input.TemplateAsset = TemplateAsset;
+	Input.InputIndex = static_cast<uint16>(InputIndex);
+
+	if (!ClientCustomInputsTickerHandle.IsValid())
+	{
+		ClientCustomInputsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowComponent::FlushClientCustomInputs));
+	}
+}
+
+bool UFlowComponent::FlushClientCustomInputs(float DeltaTime)
+{
+	ClientCustomInputsTickerHandle.Reset();
+
+	// larger batches would be rejected by the server
+	const int32 MaxBatchNum = FMath::Max(UFlowSettings::Get()->MaxClientCustomInputsPerBatch, 1);
+	for (int32 FirstIndex = 0; FirstIndex < PendingClientCustomInputs.Num(); FirstIndex += MaxBatchNum)
+	{
+		const int32 BatchNum = FMath::Min(MaxBatchNum, PendingClientCustomInputs.Num() - FirstIndex);
+		ServerTriggerCustomInputs(TArray<FFlowClientCustomInput>(PendingClientCustomInputs.GetData() + FirstIndex, BatchNum));
+	}
+
+	PendingClientCustomInputs.Reset();
+	return false;
+}
+
+bool UFlowComponent::ServerTriggerCustomInputs_Validate(const TArray<FFlowClientCustomInput>& Inputs)
+{
+	// unmodified clients never send more, the connection is closed
+	return Inputs.Num() <= FMath::Max(UFlowSettings::Get()->MaxClientCustomInputsPerBatch, 1);
+}
+
+void UFlowComponent::ServerTriggerCustomInputs_Implementation(const TArray<FFlowClientCustomInput>& Inputs)
+{
+	const float MaxInputsPerSecond = UFlowSettings::Get()->MaxClientCustomInputsPerSecond;
+	if (MaxInputsPerSecond > 0.0f && GetWorld())
+	{
+		// burst is limited to one second worth of inputs
+		const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+		ClientCustomInputTokens = FMath::Min(ClientCustomInputTokens + (CurrentTime - ClientCustomInputRefillTime) * MaxInputsPerSecond, static_cast<double>(MaxInputsPerSecond));
+		ClientCustomInputRefillTime = CurrentTime;
+	}
+
+	int32 DroppedInputs = 0;
+	for (const FFlowClientCustomInput& Input : Inputs)
+	{
+		if (MaxInputsPerSecond > 0.0f)
+		{
+			if (ClientCustomInputTokens < 1.0)
+			{
+				DroppedInputs++;
+				continue;
+			}
+			ClientCustomInputTokens -= 1.0;
+		}
+
+		const FName EventName = IsValid(Input.TemplateAsset) ? Input.TemplateAsset->GetCustomInputName(Input.InputIndex) : NAME_None;
+
+		// the client check is only a convenience, this is what protects server-only inputs
+		const UFlowNode_CustomInput* InputNode = EventName.IsNone() ? nullptr : Input.TemplateAsset->TryFindCustomInputNodeByEventName(EventName);
+		if (InputNode && !InputNode->CanBeTriggeredByClient())
+		{
+			UE_LOG(LogFlow, Warning, TEXT("%s: rejected client Custom Input %s of %s, it can't be triggered by clients"), *GetOwner()->GetName(), *EventName.ToString(), *GetNameSafe(Input.TemplateAsset));
+			DroppedInputs++;
+			continue;
+		}
+
+		if (InputNode == nullptr || !TriggerRootInstanceCustomInput(Input.TemplateAsset, EventName))
+		{
+			UE_LOG(LogFlow, Verbose, TEXT("%s: client Custom Input %d of %s doesn't match any Root Flow"), *GetOwner()->GetName(), Input.InputIndex, *GetNameSafe(Input.TemplateAsset));
+			DroppedInputs++;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_FlowClientCustomInputs, Inputs.Num() - DroppedInputs);
+	INC_DWORD_STAT_BY(STAT_FlowDroppedClientCustomInputs, DroppedInputs);
+
+	if (DroppedInputs > 0)
+	{
+		UE_LOG(LogFlow, Verbose, TEXT("%s: dropped %d of %d client Custom Inputs"), *GetOwner()->GetName(), DroppedInputs, Inputs.Num());
+	}
+}
+
+bool UFlowComponent::TriggerRootInstanceCustomInput(const UFlowAsset* TemplateAsset, const FName& EventName) const
+{
+	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		for (UFlowAsset* RootInstance : FlowSubsystem->GetRootInstancesViewByOwner(this))
+		{
+			if (IsValid(RootInstance) && RootInstance->GetTemplateAsset() == TemplateAsset)
+			{
+				RootInstance->TriggerCustomInput(EventName);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 void UFlowComponent::BP_OnTriggerRootFlowOutputEvent(UFlowAsset* RootFlowInstance, const FName& EventName)
 {
 	BP_OnRootFlowCustomEvent(RootFlowInstance, EventName);
@@ -520,6 +1434,168 @@ void UFlowComponent::OnTriggerRootFlowOutputEvent(UFlowAsset* RootFlowInstance,
 	OnRootFlowCustomEvent(RootFlowInstance, EventName);
 }
 
+bool UFlowComponent::RecordReplayFlowState(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	if (World == nullptr || !World->IsRecordingReplay())
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowRecordReplayState);
+
+	// same records as the SaveGame, so the replay restores instances with the regular loading path
+	// snapshot doesn't call OnSave() hooks, as the game doesn't expect its save logic to run every few seconds
+	uint64 RootInstanceId = 0;
+	TArray<FFlowAssetSaveData> SavedFlowInstances;
+	if (UFlowAsset* FlowAssetInstance = GetRootFlowInstance())
+	{
+		RootInstanceId = FlowAssetInstance->SnapshotInstance(SavedFlowInstances).InstanceId;
+	}
+
+	TArray<uint8> NewState;
+	if (RootInstanceId != 0)
+	{
+		FMemoryWriter MemoryWriter(NewState, true);
+		MemoryWriter << RootInstanceId;
+		MemoryWriter << SavedFlowInstances;
+	}
+
+	// checkpoints contain the latest value, so unchanged graphs cost nothing after the first snapshot
+	if (NewState == RecordedReplayFlowState)
+	{
+		return true;
+	}
+
+	const int32 MaxStateSize = FMath::Max(UFlowSettings::Get()->MaxReplayFlowStateKB, 1) * 1024;
+	if (NewState.Num() > MaxStateSize)
+	{
+		// replay keeps the last snapshot which fit, instead of failing to replicate the whole component
+		if (!bReplayFlowStateOverLimit)
+		{
+			bReplayFlowStateOverLimit = true;
+			UE_LOG(LogFlow, Warning, TEXT("Replay Flow state of %s takes %d KB, over UFlowSettings::MaxReplayFlowStateKB. Snapshots aren't recorded until it fits"), *GetOwner()->GetName(), NewState.Num() / 1024);
+		}
+		return true;
+	}
+
+	bReplayFlowStateOverLimit = false;
+	if (!bWarnedReplayFlowStateSize && NewState.Num() > MaxStateSize * 3 / 4)
+	{
+		bWarnedReplayFlowStateSize = true;
+		UE_LOG(LogFlow, Warning, TEXT("Replay Flow state of %s takes %d KB, close to UFlowSettings::MaxReplayFlowStateKB"), *GetOwner()->GetName(), NewState.Num() / 1024);
+	}
+
+	ReplayFlowState.SetState(NewState);
+	RecordedReplayFlowState = MoveTemp(NewState);
+#if WITH_PUSH_MODEL
+	MARK_PROPERTY_DIRTY_FROM_NAME(UFlowComponent, ReplayFlowState, this);
+#endif
+
+	return true;
+}
+
+bool FFlowReplayStateArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	static const FName PropertyName(TEXT("ReplayFlowState"));
+	return FlowNetStats::DeltaSerialize<FFlowReplayStateChunk, FFlowReplayStateArray>(Items, DeltaParams, *this, PropertyName);
+}
+
+void FFlowReplayStateArray::SetState(const TArray<uint8>& State)
+{
+	const int32 ChunksNum = FMath::DivideAndRoundUp(State.Num(), ChunkSize);
+	if (Items.Num() > ChunksNum)
+	{
+		Items.SetNum(ChunksNum);
+		MarkArrayDirty();
+	}
+
+	for (int32 ChunkIndex = 0; ChunkIndex < ChunksNum; ChunkIndex++)
+	{
+		const int32 Offset = ChunkIndex * ChunkSize;
+		const uint8* ChunkData = State.GetData() + Offset;
+		const int32 ChunkDataNum = FMath::Min(ChunkSize, State.Num() - Offset);
+
+		if (!Items.IsValidIndex(ChunkIndex))
+		{
+			FFlowReplayStateChunk& NewChunk = Items.AddDefaulted_GetRef();
+			NewChunk.ChunkIndex = ChunkIndex;
+			NewChunk.Data.Append(ChunkData, ChunkDataNum);
+			MarkItemDirty(NewChunk);
+		}
+		else if (Items[ChunkIndex].Data.Num() != ChunkDataNum || FMemory::Memcmp(Items[ChunkIndex].Data.GetData(), ChunkData, ChunkDataNum) != 0)
+		{
+			Items[ChunkIndex].Data.Reset();
+			Items[ChunkIndex].Data.Append(ChunkData, ChunkDataNum);
+			MarkItemDirty(Items[ChunkIndex]);
+		}
+	}
+}
+
+void FFlowReplayStateArray::GetState(TArray<uint8>& OutState) const
+{
+	// replicated items don't keep the server order
+	TArray<const FFlowReplayStateChunk*> SortedChunks;
+	SortedChunks.Reserve(Items.Num());
+	for (const FFlowReplayStateChunk& Chunk : Items)
+	{
+		SortedChunks.Add(&Chunk);
+	}
+	SortedChunks.Sort([](const FFlowReplayStateChunk& A, const FFlowReplayStateChunk& B)
+	{
+		return A.ChunkIndex < B.ChunkIndex;
+	});
+
+	OutState.Reset(Items.Num() * ChunkSize);
+	for (const FFlowReplayStateChunk* Chunk : SortedChunks)
+	{
+		OutState.Append(Chunk->Data);
+	}
+}
+
+void FFlowReplayStateArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwnerComponent)
+	{
+		check(&OwnerComponent->ReplayFlowState == this);
+
+		// the whole update is received at once, so chunks always belong to the same snapshot
+		OwnerComponent->RestoreReplayFlowState();
+	}
+}
+
+void UFlowComponent::RestoreReplayFlowState()
+{
+	const UWorld* World = GetWorld();
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (World == nullptr || !World->IsPlayingReplay() || FlowSubsystem == nullptr || RootFlow == nullptr)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowRestoreReplayState);
+
+	TArray<uint8> State;
+	ReplayFlowState.GetState(State);
+
+	uint64 RootInstanceId = 0;
+	TArray<FFlowAssetSaveData> SavedFlowInstances;
+	if (!State.IsEmpty())
+	{
+		FMemoryReader MemoryReader(State, true);
+		MemoryReader << RootInstanceId;
+		MemoryReader << SavedFlowInstances;
+
+		if (MemoryReader.IsError())
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Replay Flow state of %s couldn't be read"), *GetOwner()->GetName());
+			return;
+		}
+	}
+
+	FlowSubsystem->LoadReplayFlowState(this, RootFlow, RootInstanceId, MoveTemp(SavedFlowInstances));
+}
+
 void UFlowComponent::OnTriggerRootFlowOutputEventDispatcher(UFlowAsset* RootFlowInstance, const FName& EventName)
 {
 	DispatchRootFlowCustomEvent(RootFlowInstance, EventName);
@@ -530,21 +1606,42 @@ void UFlowComponent::SaveRootFlow(TArray<FFlowAssetSaveData>& SavedFlowInstances
 	if (UFlowAsset* FlowAssetInstance = GetRootFlowInstance())
 	{
 		const FFlowAssetSaveData AssetRecord = FlowAssetInstance->SaveInstance(SavedFlowInstances);
-		SavedAssetInstanceName = AssetRecord.InstanceName;
+		if (SavedAssetInstanceId != AssetRecord.InstanceId || !SavedAssetInstanceName.IsEmpty())
+		{
+			SavedAssetInstanceId = AssetRecord.InstanceId;
+			SavedAssetInstanceName = FString();
+			MarkSaveDataDirty();
+		}
 		return;
 	}
 
-	SavedAssetInstanceName = FString();
+	if (SavedAssetInstanceId != 0 || !SavedAssetInstanceName.IsEmpty())
+	{
+		SavedAssetInstanceId = 0;
+		SavedAssetInstanceName = FString();
+		MarkSaveDataDirty();
+	}
 }
 
 void UFlowComponent::LoadRootFlow()
 {
-	if (RootFlow && !SavedAssetInstanceName.IsEmpty() && GetFlowSubsystem())
+	if (RootFlow && (SavedAssetInstanceId != 0 || !SavedAssetInstanceName.IsEmpty()) && GetFlowSubsystem())
 	{
 		VerifyIdentityTags();
 
-		GetFlowSubsystem()->LoadRootFlow(this, RootFlow, SavedAssetInstanceName, bAllowMultipleInstances);
+		GetFlowSubsystem()->LoadLevelSaveData(GetOwner()->GetLevel());
+		if (SavedAssetInstanceId != 0)
+		{
+			GetFlowSubsystem()->LoadRootFlowById(this, RootFlow, SavedAssetInstanceId, bAllowMultipleInstances);
+		}
+		else
+		{
+			GetFlowSubsystem()->LoadRootFlow(this, RootFlow, SavedAssetInstanceName, bAllowMultipleInstances);
+		}
+
+		SavedAssetInstanceId = 0;
 		SavedAssetInstanceName = FString();
+		MarkSaveDataDirty();
 	}
 }
 
@@ -554,39 +1651,96 @@ FFlowComponentSaveData UFlowComponent::SaveInstance()
 	ComponentRecord.WorldName = GetWorld()->GetName();
 	ComponentRecord.ActorInstanceName = GetOwner()->GetName();
 
-	// opportunity to collect data before serializing component
-	OnSave();
+	const bool bIncrementalSave = UFlowSettings::Get()->bIncrementalSaveGame;
+	FFlowSaveDataTables* Tables = UFlowSettings::Get()->bCompactSaveGameFormat ? &SaveDataTables : nullptr;
 
-	// serialize component
-	FMemoryWriter MemoryWriter(ComponentRecord.ComponentData, true);
-	FFlowArchive Ar(MemoryWriter);
-	Serialize(Ar);
+	if (bIncrementalSave && !bSaveDataDirty && CanReuseSaveData())
+	{
+		ComponentRecord.ComponentData = CachedSaveData;
+		INC_DWORD_STAT(STAT_FlowReusedSaveRecords);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_FlowSerializedSaveRecords);
+
+		// opportunity to collect data before serializing component
+		OnSave();
+
+		// serialize component
+		FMemoryWriter MemoryWriter(ComponentRecord.ComponentData, true);
+		FlowSave::SerializeSaveData(*this, MemoryWriter, Tables);
+
+		if (bIncrementalSave)
+		{
+			CachedSaveData = ComponentRecord.ComponentData;
+			bSaveDataDirty = false;
+		}
+	}
+
+	if (Tables)
+	{
+		ComponentRecord.Format = EFlowSaveDataFormat::CompactTables;
+		ComponentRecord.Tables = *Tables;
+	}
 
 	return ComponentRecord;
 }
 
 bool UFlowComponent::LoadInstance()
 {
-	const UFlowSaveGame* SaveGame = GetFlowSubsystem()->GetLoadedSaveGame();
-	if (SaveGame->FlowComponents.Num() > 0)
+	SCOPE_CYCLE_COUNTER(STAT_FlowLoadComponent);
+	CSV_SCOPED_TIMING_STAT(Flow, LoadComponent);
+
+	// records of streaming levels are decoded on demand
+	GetFlowSubsystem()->LoadLevelSaveData(GetOwner()->GetLevel());
+
+	if (const FFlowComponentSaveData* ComponentRecord = GetFlowSubsystem()->FindLoadedFlowComponent(GetWorld()->GetName(), GetOwner()->GetName()))
 	{
-		for (const FFlowComponentSaveData& ComponentRecord : SaveGame->FlowComponents)
+		// loaded tables are extended by the next save, as loaded data is serialized again
+		const bool bCompactRecord = ComponentRecord->Format == EFlowSaveDataFormat::CompactTables;
+		if (bCompactRecord)
 		{
-			if (ComponentRecord.WorldName == GetWorld()->GetName() && ComponentRecord.ActorInstanceName == GetOwner()->GetName())
-			{
-				FMemoryReader MemoryReader(ComponentRecord.ComponentData, true);
-				FFlowArchive Ar(MemoryReader);
-				Serialize(Ar);
-
-				OnLoad();
-				return true;
-			}
+			SaveDataTables = ComponentRecord->Tables;
+			SaveDataTables.RebuildIndices();
+		}
+		else
+		{
+			SaveDataTables.Reset();
 		}
+
+		FMemoryReader MemoryReader(ComponentRecord->ComponentData, true);
+		FlowSave::SerializeSaveData(*this, MemoryReader, bCompactRecord ? &SaveDataTables : nullptr);
+		MarkSaveDataDirty();
+
+		OnLoad();
+		return true;
 	}
 
 	return false;
 }
 
+void UFlowComponent::MarkSaveDataDirty()
+{
+	bSaveDataDirty = true;
+}
+
+bool UFlowComponent::HasSaveGameState() const
+{
+	// instance id of the Root Flow is saved even after it finished, so loading doesn't start it again
+	if (RootFlow)
+	{
+		return true;
+	}
+
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	return FlowSubsystem == nullptr || FlowSubsystem->HasComponentClassSaveGameState(GetClass());
+}
+
+bool UFlowComponent::CanReuseSaveData() const
+{
+	return !GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+}
+
 void UFlowComponent::OnSave_Implementation()
 {
 }
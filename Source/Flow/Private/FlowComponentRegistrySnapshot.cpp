@@ -0,0 +1,92 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowComponentRegistrySnapshot.h"
+
+void FFlowComponentRegistrySnapshot::Reset()
+{
+	// keeps allocations, as the buffer is rebuilt every few frames
+	// tag buckets are emptied instead of removed, so their arrays keep the allocation too
+	Entries.Reset();
+	for (TMap<FGameplayTag, TArray<int32>>* EntriesMap : {&EntriesPerTag, &EntriesUnderTag})
+	{
+		for (TPair<FGameplayTag, TArray<int32>>& TagEntries : *EntriesMap)
+		{
+			TagEntries.Value.Reset();
+		}
+	}
+	FrameNumber = 0;
+}
+
+int32 FFlowComponentRegistrySnapshot::Num(const FGameplayTag& Tag, const bool bExactMatch) const
+{
+	const TArray<int32>* EntryIndices = FindEntries(Tag, bExactMatch);
+	return EntryIndices ? EntryIndices->Num() : 0;
+}
+
+bool FFlowComponentRegistrySnapshot::ForEachEntry(const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(const FFlowComponentSnapshotEntry&)> Function) const
+{
+	if (const TArray<int32>* EntryIndices = FindEntries(Tag, bExactMatch))
+	{
+		for (const int32 EntryIndex : *EntryIndices)
+		{
+			if (!Function(Entries[EntryIndex]))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FFlowComponentRegistrySnapshot::ForEachEntryInRadius(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const float Radius, TFunctionRef<bool(const FFlowComponentSnapshotEntry&)> Function) const
+{
+	const double RadiusSquared = FMath::Square(Radius);
+	return ForEachEntry(Tag, bExactMatch, [&](const FFlowComponentSnapshotEntry& Entry)
+	{
+		return FVector::DistSquared(Entry.Location, Origin) > RadiusSquared || Function(Entry);
+	});
+}
+
+FFlowComponentRegistrySnapshot* FFlowComponentRegistrySnapshotBuffer::BeginWrite()
+{
+	check(IsInGameThread());
+
+	// reader which pinned the back buffer just before the previous swap is still reading it
+	const int32 BackIndex = 1 - PublishedIndex.load();
+	if (ReaderCounts[BackIndex].load() > 0)
+	{
+		return nullptr;
+	}
+
+	return &Buffers[BackIndex];
+}
+
+void FFlowComponentRegistrySnapshotBuffer::EndWrite()
+{
+	check(IsInGameThread());
+	PublishedIndex.store(1 - PublishedIndex.load());
+}
+
+int32 FFlowComponentRegistrySnapshotBuffer::AcquireRead() const
+{
+	// the buffer is safe only if it's still published after pinning it,
+	// otherwise the writer might have checked the reader count before we incremented it
+	while (true)
+	{
+		const int32 BufferIndex = PublishedIndex.load();
+		ReaderCounts[BufferIndex].fetch_add(1);
+
+		if (PublishedIndex.load() == BufferIndex)
+		{
+			return BufferIndex;
+		}
+
+		ReaderCounts[BufferIndex].fetch_sub(1);
+	}
+}
+
+void FFlowComponentRegistrySnapshotBuffer::ReleaseRead(const int32 BufferIndex) const
+{
+	ReaderCounts[BufferIndex].fetch_sub(1);
+}
@@ -0,0 +1,62 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowCoroutineFramePool.h"
+
+FFlowCoroutineFramePool::~FFlowCoroutineFramePool()
+{
+	// frames still in use would return to the destroyed pool
+	ensureMsgf(FramesInUseNum == 0, TEXT("%d coroutine frames outlived the Flow Subsystem"), FramesInUseNum);
+	Trim();
+}
+
+void* FFlowCoroutineFramePool::Allocate(const SIZE_T Size)
+{
+	++FramesInUseNum;
+
+	const SIZE_T SizeClass = (Size + SizeClassGranularity - 1) / SizeClassGranularity - 1;
+	if (SizeClass >= SizeClassesNum)
+	{
+		return FMemory::Malloc(Size);
+	}
+
+	if (FFreeFrame* FreeFrame = FreeLists[SizeClass])
+	{
+		FreeLists[SizeClass] = FreeFrame->Next;
+		PooledSize -= (SizeClass + 1) * SizeClassGranularity;
+		return FreeFrame;
+	}
+
+	return FMemory::Malloc((SizeClass + 1) * SizeClassGranularity);
+}
+
+void FFlowCoroutineFramePool::Free(void* Frame, const SIZE_T Size)
+{
+	check(FramesInUseNum > 0);
+	--FramesInUseNum;
+
+	const SIZE_T SizeClass = (Size + SizeClassGranularity - 1) / SizeClassGranularity - 1;
+	if (SizeClass >= SizeClassesNum)
+	{
+		FMemory::Free(Frame);
+		return;
+	}
+
+	FFreeFrame* FreeFrame = static_cast<FFreeFrame*>(Frame);
+	FreeFrame->Next = FreeLists[SizeClass];
+	FreeLists[SizeClass] = FreeFrame;
+	PooledSize += (SizeClass + 1) * SizeClassGranularity;
+}
+
+void FFlowCoroutineFramePool::Trim()
+{
+	for (FFreeFrame*& FreeList : FreeLists)
+	{
+		while (FreeList)
+		{
+			FFreeFrame* Next = FreeList->Next;
+			FMemory::Free(FreeList);
+			FreeList = Next;
+		}
+	}
+	PooledSize = 0;
+}
@@ -0,0 +1,129 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowEventBus.h"
+
+FFlowEventWaiter::~FFlowEventWaiter()
+{
+	if (Bus)
+	{
+		Bus->Unpark(*this);
+	}
+}
+
+FFlowEventBus::~FFlowEventBus()
+{
+	Reset();
+}
+
+void FFlowEventBus::Park(FFlowEventWaiter& Waiter, const FFlowEventKey& Key)
+{
+	if (Waiter.Bus)
+	{
+		Waiter.Bus->Unpark(Waiter);
+	}
+
+	FFlowEventWaiter*& Head = Heads.FindOrAdd(Key, nullptr);
+
+	Waiter.Bus = this;
+	Waiter.Key = Key;
+	Waiter.Prev = nullptr;
+	Waiter.Next = Head;
+	if (Head)
+	{
+		Head->Prev = &Waiter;
+	}
+	Head = &Waiter;
+
+	WaitersNum++;
+}
+
+void FFlowEventBus::Unpark(FFlowEventWaiter& Waiter)
+{
+	if (Waiter.Bus != this)
+	{
+		return;
+	}
+
+	for (FFlowEventWaiter** Cursor : BroadcastCursors)
+	{
+		if (*Cursor == &Waiter)
+		{
+			*Cursor = Waiter.Next;
+		}
+	}
+
+	if (Waiter.Next)
+	{
+		Waiter.Next->Prev = Waiter.Prev;
+	}
+
+	if (Waiter.Prev)
+	{
+		Waiter.Prev->Next = Waiter.Next;
+	}
+	else if (Waiter.Next)
+	{
+		Heads.FindChecked(Waiter.Key) = Waiter.Next;
+	}
+	else
+	{
+		Heads.Remove(Waiter.Key);
+	}
+
+	Waiter.Bus = nullptr;
+	Waiter.Prev = nullptr;
+	Waiter.Next = nullptr;
+
+	WaitersNum--;
+}
+
+int32 FFlowEventBus::Broadcast(const FFlowEventKey& Key, const FFlowEvent& Event)
+{
+	FFlowEventWaiter* const* Head = Heads.Find(Key);
+	if (Head == nullptr)
+	{
+		return 0;
+	}
+
+	int32 WokenNum = 0;
+
+	FFlowEventWaiter* Cursor = *Head;
+	BroadcastCursors.Add(&Cursor);
+
+	while (Cursor)
+	{
+		FFlowEventWaiter* Waiter = Cursor;
+		Cursor = Waiter->Next;
+
+		WokenNum++;
+		Waiter->OnEvent.ExecuteIfBound(Event);
+	}
+
+	BroadcastCursors.Pop(EAllowShrinking::No);
+
+	return WokenNum;
+}
+
+void FFlowEventBus::Reset()
+{
+	for (const TPair<FFlowEventKey, FFlowEventWaiter*>& Head : Heads)
+	{
+		FFlowEventWaiter* Waiter = Head.Value;
+		while (Waiter)
+		{
+			FFlowEventWaiter* Next = Waiter->Next;
+			Waiter->Bus = nullptr;
+			Waiter->Prev = nullptr;
+			Waiter->Next = nullptr;
+			Waiter = Next;
+		}
+	}
+
+	Heads.Empty();
+	WaitersNum = 0;
+
+	for (FFlowEventWaiter** Cursor : BroadcastCursors)
+	{
+		*Cursor = nullptr;
+	}
+}
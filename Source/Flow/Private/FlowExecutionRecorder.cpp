@@ -0,0 +1,242 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowExecutionRecorder.h"
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "Nodes/FlowNode.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace FlowExecutionRecorder
+{
+	static constexpr uint32 Magic = 0x43524C46; // "FLRC"
+	static constexpr uint32 Version = 1;
+
+	// Buffer is written to the file once it grows above this size
+	static constexpr int32 FlushThreshold = 256 * 1024;
+
+	// Chunk type followed by the event
+	static constexpr int32 EventChunkSize = 13;
+
+	enum class EChunkType : uint8
+	{
+		Instance,
+		Event
+	};
+}
+
+FArchive& operator<<(FArchive& Ar, FFlowRecordedEvent& Event)
+{
+	Ar << Event.Time;
+	Ar << Event.InstanceId;
+	Ar << Event.NodeIndex;
+	Ar << Event.PinIndex;
+	Ar << Event.EventType;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFlowRecordedInstance& Instance)
+{
+	Ar << Instance.TemplatePath;
+	Ar << Instance.InstanceName;
+	Ar << Instance.NodeGuids;
+	return Ar;
+}
+
+bool FFlowExecutionRecording::Load(const FString& InFilePath)
+{
+	using namespace FlowExecutionRecorder;
+
+	Instances.Empty();
+	Events.Empty();
+	FilePath = InFilePath;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFilePath))
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Flow Recording: can't read %s"), *InFilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic;
+	Reader << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Flow Recording: %s isn't a recording of the supported version"), *InFilePath);
+		return false;
+	}
+
+	// events are fixed-size, so the size of the file is a good estimate
+	Events.Reserve(Data.Num() / EventChunkSize);
+
+	EChunkType ChunkType = EChunkType::Instance;
+	while (!Reader.AtEnd() && !Reader.IsError())
+	{
+		Reader << ChunkType;
+
+		if (ChunkType == EChunkType::Event)
+		{
+			Reader << Events.AddDefaulted_GetRef();
+		}
+		else if (ChunkType == EChunkType::Instance)
+		{
+			uint32 InstanceId = 0;
+			Reader << InstanceId;
+			Reader << Instances.FindOrAdd(InstanceId);
+		}
+		else
+		{
+			Reader.SetError();
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		// the recording might have been interrupted, keep whatever was read completely
+		UE_LOG(LogFlow, Warning, TEXT("Flow Recording: %s is truncated or corrupted"), *InFilePath);
+		if (ChunkType == EChunkType::Event)
+		{
+			Events.Pop();
+		}
+	}
+
+	return true;
+}
+
+#if FLOW_WITH_EXECUTION_RECORDER
+TUniquePtr<IFileHandle> FFlowExecutionRecorder::FileHandle;
+FString FFlowExecutionRecorder::FilePath;
+TArray<uint8> FFlowExecutionRecorder::Buffer;
+double FFlowExecutionRecorder::StartTime = 0.0;
+TMap<FObjectKey, uint32> FFlowExecutionRecorder::InstanceIds;
+
+bool FFlowExecutionRecorder::Start(const FString& InFilePath)
+{
+	using namespace FlowExecutionRecorder;
+
+	Stop();
+
+	FilePath = InFilePath.IsEmpty()
+		? FPaths::ProfilingDir() / TEXT("Flow") / FString::Printf(TEXT("FlowRecording_%s.flowrec"), *FDateTime::Now().ToString())
+		: InFilePath;
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Flow Recorder: can't open %s for writing"), *FilePath);
+		return false;
+	}
+
+	Buffer.Reset(FlushThreshold * 2);
+	InstanceIds.Reset();
+	StartTime = FPlatformTime::Seconds();
+
+	FMemoryWriter Writer(Buffer);
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Writer << FileMagic;
+	Writer << FileVersion;
+
+	UE_LOG(LogFlow, Display, TEXT("Flow Recorder: started recording to %s"), *FilePath);
+	return true;
+}
+
+void FFlowExecutionRecorder::Stop()
+{
+	if (!FileHandle.IsValid())
+	{
+		return;
+	}
+
+	Flush();
+	FileHandle.Reset();
+
+	UE_LOG(LogFlow, Display, TEXT("Flow Recorder: recorded %d instances to %s"), InstanceIds.Num(), *FilePath);
+
+	Buffer.Empty();
+	InstanceIds.Empty();
+}
+
+void FFlowExecutionRecorder::RecordPin(const UFlowNode& Node, const int32 PinIndex, const EFlowRecordedEventType EventType)
+{
+	using namespace FlowExecutionRecorder;
+
+	UFlowAsset* FlowInstance = Node.GetFlowAsset();
+	const int32 NodeIndex = Node.GetCompiledNodeIndex();
+	if (FlowInstance == nullptr || FlowInstance->GetTemplateAsset() == nullptr || !IsInGameThread()
+		|| NodeIndex < 0 || NodeIndex > MAX_uint16 || PinIndex < 0 || PinIndex > MAX_uint8)
+	{
+		return;
+	}
+
+	FMemoryWriter Writer(Buffer);
+	Writer.Seek(Buffer.Num());
+
+	uint32* InstanceId = InstanceIds.Find(FObjectKey(FlowInstance));
+	if (InstanceId == nullptr)
+	{
+		InstanceId = &InstanceIds.Add(FObjectKey(FlowInstance), InstanceIds.Num() + 1);
+
+		FFlowRecordedInstance Instance;
+		Instance.TemplatePath = FlowInstance->GetTemplateAsset()->GetPathName();
+		Instance.InstanceName = FlowInstance->GetDisplayName().ToString();
+		Instance.NodeGuids = FlowInstance->GetTemplateAsset()->GetOrCompileGraph().NodeGuids;
+
+		EChunkType ChunkType = EChunkType::Instance;
+		Writer << ChunkType;
+		Writer << *InstanceId;
+		Writer << Instance;
+	}
+
+	FFlowRecordedEvent Event;
+	Event.Time = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+	Event.InstanceId = *InstanceId;
+	Event.NodeIndex = static_cast<uint16>(NodeIndex);
+	Event.PinIndex = static_cast<uint8>(PinIndex);
+	Event.EventType = EventType;
+
+	EChunkType ChunkType = EChunkType::Event;
+	Writer << ChunkType;
+	Writer << Event;
+
+	if (Buffer.Num() >= FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void FFlowExecutionRecorder::Flush()
+{
+	if (FileHandle.IsValid() && Buffer.Num() > 0)
+	{
+		FileHandle->Write(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
+
+static FAutoConsoleCommand FlowRecorderStartCommand(
+	TEXT("Flow.Recorder.Start"),
+	TEXT("Starts recording every Flow pin activation to a binary file, which can be loaded in the Flow Asset editor. Arguments: [FilePath]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FFlowExecutionRecorder::Start(Args.IsValidIndex(0) ? Args[0] : FString());
+	}));
+
+static FAutoConsoleCommand FlowRecorderStopCommand(
+	TEXT("Flow.Recorder.Stop"),
+	TEXT("Stops recording Flow pin activations and closes the file"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowExecutionRecorder::Stop));
+#endif
@@ -0,0 +1,706 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowLightweightProgram.h"
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Graph/FlowNode_CustomInput.h"
+#include "Nodes/Graph/FlowNode_CustomOutput.h"
+#include "Nodes/Graph/FlowNode_Finish.h"
+#include "Nodes/Graph/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_Counter.h"
+#include "Nodes/Route/FlowNode_ExecutionSequence.h"
+#include "Nodes/Route/FlowNode_LogicalAND.h"
+#include "Nodes/Route/FlowNode_LogicalOR.h"
+#include "Nodes/Route/FlowNode_Reroute.h"
+#include "Nodes/Route/FlowNode_Timer.h"
+
+TSharedPtr<const FFlowLightweightProgram> FFlowLightweightProgram::Compile(UFlowAsset& TemplateAsset, const bool bStubUnsupportedNodes)
+{
+	const TSharedRef<FFlowLightweightProgram> Program = MakeShared<FFlowLightweightProgram>();
+
+	TemplateAsset.GetOrCompileGraph();
+	Program->Graph = TemplateAsset.CompiledGraph;
+
+	const FFlowCompiledGraph& CompiledGraph = *Program->Graph;
+	Program->Nodes.SetNum(CompiledGraph.GetNodesNum());
+
+	for (int32 NodeIndex = 0; NodeIndex < CompiledGraph.GetNodesNum(); ++NodeIndex)
+	{
+		const UFlowNode* FlowNode = TemplateAsset.GetNodes().FindRef(CompiledGraph.NodeGuids[NodeIndex]);
+		if (!IsValid(FlowNode) || !Program->CompileNode(*FlowNode, Program->Nodes[NodeIndex]))
+		{
+			if (!bStubUnsupportedNodes)
+			{
+				UE_LOG(LogFlow, Verbose, TEXT("Flow Asset %s can't be executed as lightweight instance, node %s isn't supported"), *TemplateAsset.GetPathName(), *GetNameSafe(FlowNode));
+				return nullptr;
+			}
+
+			// compiling might have failed halfway, slots of the node are never read
+			Program->Nodes[NodeIndex] = FNode();
+			Program->Nodes[NodeIndex].Op = EOp::Stub;
+			Program->StubNodesNum++;
+		}
+
+		const FNode& Node = Program->Nodes[NodeIndex];
+		switch (Node.Op)
+		{
+			case EOp::Start:
+				Program->StartNodeIndex = NodeIndex;
+				break;
+			case EOp::CustomInput:
+				Program->CustomInputNodes.Add(Node.EventName, NodeIndex);
+				break;
+			case EOp::Timer:
+				Program->TimerNodes.Add(NodeIndex);
+				break;
+			default: ;
+		}
+	}
+
+	return Program;
+}
+
+bool FFlowLightweightProgram::CompileNode(const UFlowNode& FlowNode, FNode& OutNode)
+{
+	if (!FlowNode.GetFlowNodeAddOnChildren().IsEmpty())
+	{
+		return false;
+	}
+
+	// only exact classes are supported, subclasses might change the behavior
+	const UClass* NodeClass = FlowNode.GetClass();
+	const TArray<FFlowPin>& InputPins = FlowNode.GetInputPins();
+	const TArray<FFlowPin>& OutputPins = FlowNode.GetOutputPins();
+
+	OutNode.Inputs.Init(EInput::In, InputPins.Num());
+
+	const auto MapInput = [&InputPins, &OutNode](const TCHAR* PinName, const EInput Input)
+	{
+		const int32 PinIndex = InputPins.IndexOfByKey(FName(PinName));
+		if (PinIndex != INDEX_NONE)
+		{
+			OutNode.Inputs[PinIndex] = Input;
+		}
+	};
+
+	const auto MapOutputs = [&OutputPins, &OutNode](std::initializer_list<const TCHAR*> PinNames)
+	{
+		for (const TCHAR* PinName : PinNames)
+		{
+			OutNode.Outputs.Add(OutputPins.IndexOfByKey(FName(PinName)));
+		}
+	};
+
+	if (NodeClass == UFlowNode_Start::StaticClass())
+	{
+		OutNode.Op = EOp::Start;
+	}
+	else if (NodeClass == UFlowNode_CustomInput::StaticClass())
+	{
+		OutNode.Op = EOp::CustomInput;
+		OutNode.EventName = CastChecked<UFlowNode_CustomInput>(&FlowNode)->GetEventName();
+	}
+	else if (NodeClass == UFlowNode_Reroute::StaticClass())
+	{
+		OutNode.Op = EOp::Reroute;
+	}
+	else if (NodeClass == UFlowNode_Finish::StaticClass())
+	{
+		OutNode.Op = EOp::Finish;
+	}
+	else if (NodeClass == UFlowNode_CustomOutput::StaticClass())
+	{
+		OutNode.Op = EOp::CustomOutput;
+		OutNode.EventName = CastChecked<UFlowNode_CustomOutput>(&FlowNode)->GetEventName();
+	}
+	else if (NodeClass == UFlowNode_ExecutionSequence::StaticClass())
+	{
+		// per-frame branch limit relies on the Flow Subsystem timers
+		if (CastChecked<UFlowNode_ExecutionSequence>(&FlowNode)->MaxBranchesPerFrame > 0)
+		{
+			return false;
+		}
+
+		OutNode.Op = EOp::Sequence;
+	}
+	else if (NodeClass == UFlowNode_LogicalAND::StaticClass())
+	{
+		// executed inputs are stored as the bit mask
+		if (InputPins.Num() > 31)
+		{
+			return false;
+		}
+
+		OutNode.Op = EOp::AND;
+		OutNode.IntParam = (1 << InputPins.Num()) - 1;
+		OutNode.SlotOffset = IntSlotsNum;
+		IntSlotsNum += 1;
+	}
+	else if (NodeClass == UFlowNode_LogicalOR::StaticClass())
+	{
+		const UFlowNode_LogicalOR* LogicalOR = CastChecked<UFlowNode_LogicalOR>(&FlowNode);
+
+		OutNode.Op = EOp::OR;
+		OutNode.IntParam = LogicalOR->ExecutionLimit;
+		OutNode.bBoolParam = LogicalOR->bEnabled;
+		OutNode.SlotOffset = IntSlotsNum;
+		IntSlotsNum += 2;
+
+		// numbered pins are the default
+		MapInput(TEXT("Enable"), EInput::Enable);
+		MapInput(TEXT("Disable"), EInput::Disable);
+	}
+	else if (NodeClass == UFlowNode_Counter::StaticClass())
+	{
+		OutNode.Op = EOp::Counter;
+		OutNode.IntParam = CastChecked<UFlowNode_Counter>(&FlowNode)->Goal;
+		OutNode.SlotOffset = IntSlotsNum;
+		IntSlotsNum += 1;
+
+		MapInput(TEXT("Increment"), EInput::Increment);
+		MapInput(TEXT("Decrement"), EInput::Decrement);
+		MapInput(TEXT("Skip"), EInput::Skip);
+		MapOutputs({TEXT("Zero"), TEXT("Step"), TEXT("Goal"), TEXT("Skipped")});
+	}
+	else if (NodeClass == UFlowNode_Timer::StaticClass())
+	{
+		// data pins are resolved through node instances
+		if (FlowNode.IsInputConnected(UFlowNode_Timer::INPIN_CompletionTime, false))
+		{
+			return false;
+		}
+
+		const UFlowNode_Timer* Timer = CastChecked<UFlowNode_Timer>(&FlowNode);
+
+		OutNode.Op = EOp::Timer;
+		OutNode.CompletionTime = Timer->CompletionTime;
+		OutNode.StepTime = Timer->StepTime;
+		OutNode.SlotOffset = TimeSlotsNum;
+		TimeSlotsNum += 2;
+
+		MapInput(TEXT("Skip"), EInput::Skip);
+		MapInput(TEXT("Restart"), EInput::Restart);
+		MapOutputs({TEXT("Completed"), TEXT("Step"), TEXT("Skipped")});
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void FFlowLightweightProgram::InitializeState(FFlowLightweightState& State) const
+{
+	State.ActiveNodes.Init(false, Nodes.Num());
+	State.IntSlots.Init(0, IntSlotsNum);
+	State.TimeSlots.Init(-1.0f, TimeSlotsNum);
+	State.RunningTimers = 0;
+	State.bStarted = false;
+	State.bFinished = false;
+
+	for (const FNode& Node : Nodes)
+	{
+		if (Node.Op == EOp::OR)
+		{
+			State.IntSlots[Node.SlotOffset + 1] = Node.bBoolParam;
+		}
+	}
+}
+
+void FFlowLightweightProgram::InitializeState(FFlowLightweightFork& Fork) const
+{
+	Fork.ActiveNodes.Reset();
+	Fork.IntSlots.Reset();
+	Fork.TimeSlots.Reset();
+	Fork.bBaseDiscarded = true;
+	Fork.RunningTimers = 0;
+	Fork.bStarted = false;
+	Fork.bFinished = false;
+
+	for (const FNode& Node : Nodes)
+	{
+		if (Node.Op == EOp::OR && Node.bBoolParam)
+		{
+			Fork.SetIntSlot(Node.SlotOffset + 1, 1);
+		}
+	}
+}
+
+bool FFlowLightweightProgram::CaptureState(const UFlowAsset& Instance, FFlowLightweightState& OutState) const
+{
+	if (!Instance.IsInstanceInitialized() || Instance.CompiledGraph != Graph)
+	{
+		return false;
+	}
+
+	InitializeState(OutState);
+	OutState.bStarted = Instance.HasStartedFlow();
+
+	const UFlowSubsystem* FlowSubsystem = Instance.GetFlowSubsystem();
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FNode& Node = Nodes[NodeIndex];
+		OutState.ActiveNodes[NodeIndex] = Instance.GetCompiledNodeState(NodeIndex) == EFlowNodeState::Active;
+
+		// the template node stands in for nodes which aren't instantiated, its state is the initial one
+		const UFlowNode* FlowNode = Instance.GetCompiledNode(NodeIndex);
+		if (FlowNode == nullptr || !Instance.IsNodeInstantiated(FlowNode))
+		{
+			continue;
+		}
+
+		switch (Node.Op)
+		{
+			case EOp::AND:
+			{
+				const FFlowBitState& ExecutedInputs = CastChecked<UFlowNode_LogicalAND>(FlowNode)->ExecutedInputs;
+				int32 Mask = 0;
+				for (int32 PinIndex = 0; PinIndex < FMath::Min(ExecutedInputs.Num(), 31); ++PinIndex)
+				{
+					Mask |= ExecutedInputs.IsSet(PinIndex) ? 1 << PinIndex : 0;
+				}
+				OutState.IntSlots[Node.SlotOffset] = Mask;
+				break;
+			}
+			case EOp::OR:
+			{
+				const UFlowNode_LogicalOR* LogicalOR = CastChecked<UFlowNode_LogicalOR>(FlowNode);
+				OutState.IntSlots[Node.SlotOffset] = LogicalOR->ExecutionCount;
+				OutState.IntSlots[Node.SlotOffset + 1] = LogicalOR->bEnabled;
+				break;
+			}
+			case EOp::Counter:
+				OutState.IntSlots[Node.SlotOffset] = CastChecked<UFlowNode_Counter>(FlowNode)->CurrentSum;
+				break;
+			case EOp::Timer:
+			{
+				const UFlowNode_Timer* Timer = CastChecked<UFlowNode_Timer>(FlowNode);
+				if (FlowSubsystem && Timer->CompletionTimerHandle.IsValid())
+				{
+					OutState.TimeSlots[Node.SlotOffset] = FMath::Max(FlowSubsystem->GetFlowTimerRemaining(Timer->CompletionTimerHandle), 0.0f);
+					OutState.TimeSlots[Node.SlotOffset + 1] = Timer->StepTimerHandle.IsValid() ? FlowSubsystem->GetFlowTimerRemaining(Timer->StepTimerHandle) : Node.StepTime;
+					++OutState.RunningTimers;
+				}
+				break;
+			}
+			default: ;
+		}
+	}
+
+	return true;
+}
+
+FGuid FFlowLightweightProgram::GetNodeGuid(const int32 NodeIndex) const
+{
+	return Graph.IsValid() && Graph->NodeGuids.IsValidIndex(NodeIndex) ? Graph->NodeGuids[NodeIndex] : FGuid();
+}
+
+SIZE_T FFlowLightweightProgram::GetAllocatedSize() const
+{
+	SIZE_T Size = Nodes.GetAllocatedSize() + CustomInputNodes.GetAllocatedSize() + TimerNodes.GetAllocatedSize();
+	for (const FNode& Node : Nodes)
+	{
+		Size += Node.Inputs.GetAllocatedSize() + Node.Outputs.GetAllocatedSize();
+	}
+	return Size;
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::StartInternal(StateType& State, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	if (State.bStarted || StartNodeIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	State.bStarted = true;
+
+	TExecution<StateType> Execution{State, InstanceIndex, OutEvents};
+	Execution.Pending.Add({StartNodeIndex, 0});
+	Execute(Execution);
+}
+
+template <typename StateType>
+bool FFlowLightweightProgram::TriggerCustomInputInternal(StateType& State, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	const int32* NodeIndex = CustomInputNodes.Find(EventName);
+	if (NodeIndex == nullptr)
+	{
+		return false;
+	}
+
+	if (State.IsRunning())
+	{
+		TExecution<StateType> Execution{State, InstanceIndex, OutEvents};
+		Execution.Pending.Add({*NodeIndex, 0});
+		Execute(Execution);
+	}
+
+	return true;
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::TickInternal(StateType& State, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	if (State.RunningTimers == 0 || !State.IsRunning())
+	{
+		return;
+	}
+
+	TExecution<StateType> Execution{State, InstanceIndex, OutEvents};
+
+	for (const int32 NodeIndex : TimerNodes)
+	{
+		const FNode& Node = Nodes[NodeIndex];
+		float RemainingCompletionTime = State.GetTimeSlot(Node.SlotOffset);
+		if (RemainingCompletionTime < 0.0f)
+		{
+			continue;
+		}
+
+		if (Node.StepTime > 0.0f)
+		{
+			const float RemainingStepTime = State.GetTimeSlot(Node.SlotOffset + 1) - DeltaTime;
+			if (RemainingStepTime <= 0.0f)
+			{
+				// like a looping timer, fires once per tick
+				State.SetTimeSlot(Node.SlotOffset + 1, FMath::Max(RemainingStepTime + Node.StepTime, UE_KINDA_SMALL_NUMBER));
+				TriggerOutput(Execution, NodeIndex, Node.Outputs[1], false);
+			}
+			else
+			{
+				State.SetTimeSlot(Node.SlotOffset + 1, RemainingStepTime);
+			}
+		}
+
+		RemainingCompletionTime = FMath::Max(RemainingCompletionTime - DeltaTime, 0.0f);
+		State.SetTimeSlot(Node.SlotOffset, RemainingCompletionTime);
+		if (RemainingCompletionTime <= 0.0f)
+		{
+			StopTimer(State, Node);
+			TriggerOutput(Execution, NodeIndex, Node.Outputs[0], true);
+		}
+	}
+
+	Execute(Execution);
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::Execute(TExecution<StateType>& Execution) const
+{
+	// the same protection against infinite loops as the trigger storm watchdog of Flow Asset instances
+	const int32 MaxTriggers = UFlowSettings::Get()->MaxTriggersPerInstancePerFrame;
+
+	for (int32 Head = 0; Head < Execution.Pending.Num() && !Execution.State.bFinished; ++Head)
+	{
+		if (MaxTriggers > 0 && Head >= MaxTriggers)
+		{
+			UE_LOG(LogFlow, Error, TEXT("Lightweight Flow instance %d executed more than %d node inputs at once, remaining inputs are dropped"), Execution.InstanceIndex, MaxTriggers);
+			break;
+		}
+
+		const FTrigger Trigger = Execution.Pending[Head];
+		ExecuteNode(Execution, Trigger.NodeIndex, Trigger.PinIndex);
+	}
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::ExecuteNode(TExecution<StateType>& Execution, const int32 NodeIndex, const int32 PinIndex) const
+{
+	StateType& State = Execution.State;
+	const FNode& Node = Nodes[NodeIndex];
+	State.SetNodeActive(NodeIndex, true);
+
+	switch (Node.Op)
+	{
+		case EOp::Start:
+		case EOp::CustomInput:
+		case EOp::Reroute:
+			TriggerOutput(Execution, NodeIndex, 0, true);
+			break;
+		case EOp::Finish:
+			FinishInstance(Execution);
+			break;
+		case EOp::CustomOutput:
+			Execution.OutEvents.Add({Execution.InstanceIndex, Node.EventName});
+			FinishNode(State, NodeIndex);
+			break;
+		case EOp::Sequence:
+		{
+			const int32 OutputsNum = Graph->OutputOffsets[NodeIndex + 1] - Graph->OutputOffsets[NodeIndex];
+			for (int32 OutputPinIndex = 0; OutputPinIndex < OutputsNum; ++OutputPinIndex)
+			{
+				TriggerOutput(Execution, NodeIndex, OutputPinIndex, false);
+			}
+			FinishNode(State, NodeIndex);
+			break;
+		}
+		case EOp::AND:
+		{
+			int32 ExecutedInputs = State.GetIntSlot(Node.SlotOffset);
+			if (PinIndex >= 0 && PinIndex < 31)
+			{
+				ExecutedInputs |= 1 << PinIndex;
+				State.SetIntSlot(Node.SlotOffset, ExecutedInputs);
+			}
+
+			if (ExecutedInputs == Node.IntParam)
+			{
+				TriggerOutput(Execution, NodeIndex, 0, true);
+			}
+			break;
+		}
+		case EOp::OR:
+		{
+			const bool bEnabled = State.GetIntSlot(Node.SlotOffset + 1) != 0;
+			switch (GetInput(Node, PinIndex))
+			{
+				case EInput::Enable:
+					if (!bEnabled)
+					{
+						State.SetIntSlot(Node.SlotOffset, 0);
+						State.SetIntSlot(Node.SlotOffset + 1, 1);
+					}
+					break;
+				case EInput::Disable:
+					if (bEnabled)
+					{
+						State.SetIntSlot(Node.SlotOffset + 1, 0);
+						FinishNode(State, NodeIndex);
+					}
+					break;
+				case EInput::In:
+					if (bEnabled)
+					{
+						const int32 ExecutionCount = State.GetIntSlot(Node.SlotOffset) + 1;
+						State.SetIntSlot(Node.SlotOffset, ExecutionCount);
+						if (Node.IntParam > 0 && ExecutionCount == Node.IntParam)
+						{
+							State.SetIntSlot(Node.SlotOffset + 1, 0);
+						}
+
+						TriggerOutput(Execution, NodeIndex, 0, true);
+					}
+					break;
+				default: ;
+			}
+			break;
+		}
+		case EOp::Counter:
+		{
+			const int32 CurrentSum = State.GetIntSlot(Node.SlotOffset);
+			switch (GetInput(Node, PinIndex))
+			{
+				case EInput::Increment:
+					State.SetIntSlot(Node.SlotOffset, CurrentSum + 1);
+					if (CurrentSum + 1 == Node.IntParam)
+					{
+						TriggerOutput(Execution, NodeIndex, Node.Outputs[2], true);
+					}
+					else
+					{
+						TriggerOutput(Execution, NodeIndex, Node.Outputs[1], false);
+					}
+					break;
+				case EInput::Decrement:
+					State.SetIntSlot(Node.SlotOffset, CurrentSum - 1);
+					if (CurrentSum - 1 == 0)
+					{
+						TriggerOutput(Execution, NodeIndex, Node.Outputs[0], true);
+					}
+					else
+					{
+						TriggerOutput(Execution, NodeIndex, Node.Outputs[1], false);
+					}
+					break;
+				case EInput::Skip:
+					TriggerOutput(Execution, NodeIndex, Node.Outputs[3], true);
+					break;
+				default: ;
+			}
+			break;
+		}
+		case EOp::Timer:
+			switch (GetInput(Node, PinIndex))
+			{
+				case EInput::In:
+					if (State.GetTimeSlot(Node.SlotOffset) < 0.0f)
+					{
+						StartTimer(State, Node);
+					}
+					break;
+				case EInput::Skip:
+					StopTimer(State, Node);
+					TriggerOutput(Execution, NodeIndex, Node.Outputs[2], true);
+					break;
+				case EInput::Restart:
+					StopTimer(State, Node);
+					StartTimer(State, Node);
+					break;
+				default: ;
+			}
+			break;
+		case EOp::Stub:
+		{
+			// the node stays active, as the caller can't tell which of its outputs would be triggered
+			FFlowLightweightEvent& Event = Execution.OutEvents.AddDefaulted_GetRef();
+			Event.InstanceIndex = Execution.InstanceIndex;
+			Event.StubNodeIndex = NodeIndex;
+			break;
+		}
+		default:
+			checkNoEntry();
+	}
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::TriggerOutput(TExecution<StateType>& Execution, const int32 NodeIndex, const int32 OutputPinIndex, const bool bFinish) const
+{
+	if (bFinish)
+	{
+		FinishNode(Execution.State, NodeIndex);
+	}
+
+	const FFlowCompiledConnection* Connection = Graph->FindOutputConnection(NodeIndex, OutputPinIndex);
+	if (Connection && Connection->IsResolved())
+	{
+		Execution.Pending.Add({Connection->NodeIndex, Connection->PinIndex});
+	}
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::FinishNode(StateType& State, const int32 NodeIndex) const
+{
+	State.SetNodeActive(NodeIndex, false);
+
+	// the same state as Cleanup() resets on node instances
+	const FNode& Node = Nodes[NodeIndex];
+	switch (Node.Op)
+	{
+		case EOp::AND:
+		case EOp::Counter:
+		case EOp::OR:
+			State.SetIntSlot(Node.SlotOffset, 0);
+			break;
+		case EOp::Timer:
+			StopTimer(State, Node);
+			break;
+		default: ;
+	}
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::FinishInstance(TExecution<StateType>& Execution) const
+{
+	StateType& State = Execution.State;
+
+	InitializeState(State);
+	State.bStarted = true;
+	State.bFinished = true;
+
+	Execution.OutEvents.Add({Execution.InstanceIndex, NAME_None});
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::StartTimer(StateType& State, const FNode& Node) const
+{
+	// zero completion time completes on the next tick, like SetFlowTimerForNextTick
+	State.SetTimeSlot(Node.SlotOffset, FMath::Max(Node.CompletionTime, 0.0f));
+	State.SetTimeSlot(Node.SlotOffset + 1, Node.StepTime);
+	++State.RunningTimers;
+}
+
+template <typename StateType>
+void FFlowLightweightProgram::StopTimer(StateType& State, const FNode& Node) const
+{
+	if (State.GetTimeSlot(Node.SlotOffset) >= 0.0f)
+	{
+		State.SetTimeSlot(Node.SlotOffset, -1.0f);
+		State.SetTimeSlot(Node.SlotOffset + 1, -1.0f);
+		--State.RunningTimers;
+	}
+}
+
+void FFlowLightweightProgram::Start(FFlowLightweightState& State, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	StartInternal(State, InstanceIndex, OutEvents);
+}
+
+void FFlowLightweightProgram::Start(FFlowLightweightFork& Fork, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	StartInternal(Fork, InstanceIndex, OutEvents);
+}
+
+bool FFlowLightweightProgram::TriggerCustomInput(FFlowLightweightState& State, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	return TriggerCustomInputInternal(State, EventName, InstanceIndex, OutEvents);
+}
+
+bool FFlowLightweightProgram::TriggerCustomInput(FFlowLightweightFork& Fork, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	return TriggerCustomInputInternal(Fork, EventName, InstanceIndex, OutEvents);
+}
+
+void FFlowLightweightProgram::Tick(FFlowLightweightState& State, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	TickInternal(State, DeltaTime, InstanceIndex, OutEvents);
+}
+
+void FFlowLightweightProgram::Tick(FFlowLightweightFork& Fork, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	TickInternal(Fork, DeltaTime, InstanceIndex, OutEvents);
+}
+
+void FFlowLightweightProgram::Tick(TArrayView<FFlowLightweightState> States, const float DeltaTime, TArray<FFlowLightweightEvent>& OutEvents) const
+{
+	if (TimerNodes.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 InstanceIndex = 0; InstanceIndex < States.Num(); ++InstanceIndex)
+	{
+		Tick(States[InstanceIndex], DeltaTime, InstanceIndex, OutEvents);
+	}
+}
+
+bool FFlowLightweightFork::IsNodeActive(const int32 NodeIndex) const
+{
+	if (const bool* bActive = ActiveNodes.Find(NodeIndex))
+	{
+		return *bActive;
+	}
+	return !bBaseDiscarded && Base->ActiveNodes[NodeIndex];
+}
+
+int32 FFlowLightweightFork::GetIntSlot(const int32 SlotIndex) const
+{
+	if (const int32* Value = IntSlots.Find(SlotIndex))
+	{
+		return *Value;
+	}
+	return bBaseDiscarded ? 0 : Base->IntSlots[SlotIndex];
+}
+
+float FFlowLightweightFork::GetTimeSlot(const int32 SlotIndex) const
+{
+	if (const float* Value = TimeSlots.Find(SlotIndex))
+	{
+		return *Value;
+	}
+	return bBaseDiscarded ? -1.0f : Base->TimeSlots[SlotIndex];
+}
+
+void FFlowLightweightFork::Reset()
+{
+	ActiveNodes.Reset();
+	IntSlots.Reset();
+	TimeSlots.Reset();
+	bBaseDiscarded = false;
+	RunningTimers = Base->RunningTimers;
+	bStarted = Base->bStarted;
+	bFinished = Base->bFinished;
+}
@@ -0,0 +1,79 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+#if !UE_BUILD_SHIPPING
+namespace FlowLoadBenchmark
+{
+	void Run(const TArray<FString>& Args)
+	{
+		const FName PackagePath = Args.IsValidIndex(0) ? FName(*Args[0]) : FName(TEXT("/Game"));
+		const int32 MaxAssets = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 500;
+
+		const IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+		TArray<FAssetData> AssetDatas;
+		AssetRegistry.GetAssetsByPath(PackagePath, AssetDatas, true);
+
+		// only packages loaded by this run are measured, the benchmark should run in a fresh process
+		TArray<FSoftObjectPath> AssetPaths;
+		for (const FAssetData& AssetData : AssetDatas)
+		{
+			if (AssetPaths.Num() < MaxAssets && AssetData.IsInstanceOf(UFlowAsset::StaticClass()) && !AssetData.IsAssetLoaded())
+			{
+				AssetPaths.Add(AssetData.GetSoftObjectPath());
+			}
+		}
+
+		if (AssetPaths.IsEmpty())
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Flow.Benchmark.Load found no unloaded Flow Assets under %s"), *PackagePath.ToString());
+			return;
+		}
+
+		int32 LoadedNum = 0;
+		int32 CompiledNum = 0;
+		int32 NodesNum = 0;
+		double SlowestTime = 0.0;
+		FString SlowestAsset;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FSoftObjectPath& AssetPath : AssetPaths)
+		{
+			const double AssetStartTime = FPlatformTime::Seconds();
+			const UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetPath.TryLoad());
+			const double AssetTime = FPlatformTime::Seconds() - AssetStartTime;
+
+			if (FlowAsset)
+			{
+				LoadedNum++;
+				CompiledNum += FlowAsset->HasCompiledGraph() ? 1 : 0;
+				NodesNum += FlowAsset->GetNodes().Num();
+
+				if (AssetTime > SlowestTime)
+				{
+					SlowestTime = AssetTime;
+					SlowestAsset = AssetPath.ToString();
+				}
+			}
+		}
+		const double TotalTime = FPlatformTime::Seconds() - StartTime;
+
+		// includes loading of dependencies, i.e. node Blueprints and content referenced by nodes
+		UE_LOG(LogFlow, Display, TEXT("Flow.Benchmark.Load: %d Flow Assets with %d nodes in %.3f ms, %.3f ms per asset, %d loaded with the cooked compiled graph"),
+			LoadedNum, NodesNum, TotalTime * 1000.0, LoadedNum > 0 ? TotalTime * 1000.0 / LoadedNum : 0.0, CompiledNum);
+		UE_LOG(LogFlow, Display, TEXT("  slowest %s, %.3f ms"), *SlowestAsset, SlowestTime * 1000.0);
+	}
+}
+
+static FAutoConsoleCommand FlowLoadBenchmarkCommand(
+	TEXT("Flow.Benchmark.Load"),
+	TEXT("Synchronously loads Flow Assets which aren't loaded yet, reports load time per asset. ")
+	TEXT("Compare cooked and editor builds to see the cost of load-time fix-ups. ")
+	TEXT("Arguments: [PackagePath=/Game] [MaxAssets=500]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FlowLoadBenchmark::Run));
+#endif
@@ -1,3 +1,60 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
 #include "FlowLogChannels.h"
 
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
 DEFINE_LOG_CATEGORY(LogFlow);
+DEFINE_LOG_CATEGORY(LogFlowExecution);
+
+static int32 GFlowLogMaxMessagesPerSecond = 10;
+static FAutoConsoleVariableRef CVarFlowLogMaxMessagesPerSecond(
+	TEXT("Flow.Log.MaxMessagesPerSecond"),
+	GFlowLogMaxMessagesPerSecond,
+	TEXT("Messages logged by a single node from a single FLOW_LOG_NODE call site per second, further messages are counted and skipped. 0: unlimited"));
+
+bool FFlowLogRateLimiter::TryConsume(const UObject* Node, int32& OutSuppressedNum)
+{
+	OutSuppressedNum = 0;
+
+	const int32 MaxMessages = GFlowLogMaxMessagesPerSecond;
+	if (MaxMessages <= 0)
+	{
+		return true;
+	}
+
+	const int64 CurrentWindow = static_cast<int64>(FPlatformTime::Seconds());
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (WindowStart != CurrentWindow)
+	{
+		WindowStart = CurrentWindow;
+
+		// nodes with skipped messages are kept, so their next message reports the count
+		for (TMap<FObjectKey, FNodeMessages>::TIterator It = NodeMessages.CreateIterator(); It; ++It)
+		{
+			if (It->Value.SuppressedNum == 0)
+			{
+				It.RemoveCurrent();
+			}
+			else
+			{
+				It->Value.MessagesNum = 0;
+			}
+		}
+	}
+
+	FNodeMessages& Messages = NodeMessages.FindOrAdd(FObjectKey(Node));
+	if (Messages.MessagesNum++ < MaxMessages)
+	{
+		OutSuppressedNum = Messages.SuppressedNum;
+		Messages.SuppressedNum = 0;
+		return true;
+	}
+
+	Messages.SuppressedNum++;
+	return false;
+}
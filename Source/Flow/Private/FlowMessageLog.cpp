@@ -83,6 +83,93 @@ TSharedPtr<IMessageToken> FFlowGraphToken::Create(const UEdGraphPin* InPin, FTok
 	return nullptr;
 }
 
+FFlowRuntimeMessageLog::FFlowRuntimeMessageLog(const int32 InMaxMessages)
+	: MaxMessages(FMath::Max(0, InMaxMessages))
+{
+}
+
+TSharedRef<FTokenizedMessage> FFlowRuntimeMessageLog::AddMessage(const EMessageSeverity::Type Severity, const FString& Text, const UFlowNodeBase* Node)
+{
+	++Version;
+
+	FEntryKey Key{Text, Node, Severity};
+	if (const uint64* Serial = EntrySerials.Find(Key))
+	{
+		const int32 EntryIndex = GetEntryIndex(*Serial);
+		if (EntryIndex != INDEX_NONE)
+		{
+			FEntry& Entry = Entries[EntryIndex];
+			Entry.Count++;
+			Entry.Message = CreateMessage(Entry.Key, Entry.Count);
+			return Entry.Message;
+		}
+	}
+
+	const TSharedRef<FTokenizedMessage> Message = CreateMessage(Key, 1);
+	const uint64 Serial = NextSerial++;
+
+	if (MaxMessages > 0 && Entries.Num() >= MaxMessages)
+	{
+		// overwrite the oldest line
+		FEntry& Oldest = Entries[OldestIndex];
+		EntrySerials.Remove(Oldest.Key);
+		Oldest = FEntry(MoveTemp(Key), Message);
+		EntrySerials.Add(Oldest.Key, Serial);
+
+		OldestIndex = (OldestIndex + 1) % Entries.Num();
+		DroppedNum++;
+	}
+	else
+	{
+		const FEntry& Entry = Entries.Emplace_GetRef(MoveTemp(Key), Message);
+		EntrySerials.Add(Entry.Key, Serial);
+	}
+
+	return Message;
+}
+
+void FFlowRuntimeMessageLog::GetMessages(TArray<TSharedRef<FTokenizedMessage>>& OutMessages) const
+{
+	OutMessages.Reset(Entries.Num());
+	for (int32 Offset = 0; Offset < Entries.Num(); ++Offset)
+	{
+		OutMessages.Add(Entries[(OldestIndex + Offset) % Entries.Num()].Message);
+	}
+}
+
+TSharedRef<FTokenizedMessage> FFlowRuntimeMessageLog::CreateMessage(const FEntryKey& Key, const int32 Count)
+{
+	TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(Key.Severity);
+
+	if (const UFlowNodeBase* Node = Key.Node.Get())
+	{
+		if (FFlowGraphToken::Create(Node, Message.Get()))
+		{
+			Message->SetMessageLink(FUObjectToken::Create(Node));
+		}
+	}
+
+	Message->AddToken(FTextToken::Create(FText::FromString(Key.Text)));
+	if (Count > 1)
+	{
+		Message->AddToken(FTextToken::Create(FText::Format(LOCTEXT("RepeatedMessage", "(x{0})"), Count)));
+	}
+
+	return Message;
+}
+
+int32 FFlowRuntimeMessageLog::GetEntryIndex(const uint64 Serial) const
+{
+	// lines are added in the serial order, the ring only rotates the storage
+	const uint64 FirstSerial = NextSerial - Entries.Num();
+	if (Serial < FirstSerial || Serial >= NextSerial)
+	{
+		return INDEX_NONE;
+	}
+
+	return (OldestIndex + static_cast<int32>(Serial - FirstSerial)) % Entries.Num();
+}
+
 #undef LOCTEXT_NAMESPACE
 
 #endif // WITH_EDITOR
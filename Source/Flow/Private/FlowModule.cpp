@@ -1,15 +1,24 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "FlowModule.h"
+#include "FlowExecutionRecorder.h"
+#include "FlowRemoteDebug.h"
 
 #include "Modules/ModuleManager.h"
 
 void FFlowModule::StartupModule()
 {
+#if FLOW_WITH_REMOTE_DEBUG
+	FFlowRemoteDebug::Initialize();
+#endif
 }
 
 void FFlowModule::ShutdownModule()
 {
+#if FLOW_WITH_EXECUTION_RECORDER
+	// flush the recording still in progress
+	FFlowExecutionRecorder::Stop();
+#endif
 }
 
 IMPLEMENT_MODULE(FFlowModule, Flow)
@@ -0,0 +1,212 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowProfiler.h"
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "Nodes/FlowNode.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+#if FLOW_WITH_PROFILER
+bool FFlowProfiler::bEnabled = false;
+TMap<FObjectKey, FFlowTemplateProfile> FFlowProfiler::TemplateProfiles;
+TMap<FObjectKey, FFlowNodeClassProfile> FFlowProfiler::NodeClassProfiles;
+FFlowProfilerScope* FFlowProfiler::CurrentScope = nullptr;
+
+double FFlowProfileEntry::GetMetric(const EFlowProfileMetric Metric) const
+{
+	switch (Metric)
+	{
+		case EFlowProfileMetric::ExclusiveTime:
+			return ExclusiveTime;
+		case EFlowProfileMetric::InclusiveTime:
+			return InclusiveTime;
+		case EFlowProfileMetric::Triggers:
+			return static_cast<double>(Triggers);
+		default: ;
+	}
+
+	return 0.0;
+}
+
+void FFlowProfiler::SetEnabled(const bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+}
+
+void FFlowProfiler::Reset()
+{
+	TemplateProfiles.Empty();
+	NodeClassProfiles.Empty();
+}
+
+const FFlowTemplateProfile* FFlowProfiler::FindTemplateProfile(const UFlowAsset* Template)
+{
+	return TemplateProfiles.Find(FObjectKey(Template));
+}
+
+void FFlowProfiler::Dump(const EFlowProfileMetric Metric, const int32 MaxEntries)
+{
+	auto LogEntries = [Metric, MaxEntries](const TCHAR* Title, TArray<TPair<FString, FFlowProfileEntry>>& Entries)
+	{
+		Entries.Sort([Metric](const TPair<FString, FFlowProfileEntry>& A, const TPair<FString, FFlowProfileEntry>& B)
+		{
+			return A.Value.GetMetric(Metric) > B.Value.GetMetric(Metric);
+		});
+
+		UE_LOG(LogFlow, Display, TEXT("%s"), Title);
+		UE_LOG(LogFlow, Display, TEXT("  %12s %12s %10s  %s"), TEXT("Excl. ms"), TEXT("Incl. ms"), TEXT("Triggers"), TEXT("Name"));
+		for (int32 Index = 0; Index < Entries.Num() && (MaxEntries <= 0 || Index < MaxEntries); Index++)
+		{
+			const FFlowProfileEntry& Entry = Entries[Index].Value;
+			UE_LOG(LogFlow, Display, TEXT("  %12.3f %12.3f %10lld  %s"), Entry.ExclusiveTime * 1000.0, Entry.InclusiveTime * 1000.0, Entry.Triggers, *Entries[Index].Key);
+		}
+	};
+
+	TArray<TPair<FString, FFlowProfileEntry>> Entries;
+	for (const TPair<FObjectKey, FFlowTemplateProfile>& TemplateProfile : TemplateProfiles)
+	{
+		Entries.Emplace(TemplateProfile.Value.TemplateName, TemplateProfile.Value.Total);
+	}
+	LogEntries(TEXT("Flow Profiler: templates"), Entries);
+
+	Entries.Reset();
+	for (const TPair<FObjectKey, FFlowNodeClassProfile>& ClassProfile : NodeClassProfiles)
+	{
+		Entries.Emplace(ClassProfile.Value.ClassName, ClassProfile.Value.Total);
+	}
+	LogEntries(TEXT("Flow Profiler: node classes"), Entries);
+}
+
+FFlowProfilerScope::FFlowProfilerScope(const UFlowNode& Node)
+{
+	if (!FFlowProfiler::bEnabled || !IsInGameThread())
+	{
+		return;
+	}
+
+	const UFlowAsset* FlowAsset = Node.GetFlowAsset();
+	const UFlowAsset* Template = FlowAsset ? FlowAsset->GetTemplateAsset() : nullptr;
+	if (Template == nullptr)
+	{
+		return;
+	}
+
+	bActive = true;
+	TemplateKey = FObjectKey(Template);
+	ClassKey = FObjectKey(Node.GetClass());
+	NodeGuid = Node.GetGuid();
+
+	FFlowTemplateProfile& TemplateProfile = FFlowProfiler::TemplateProfiles.FindOrAdd(TemplateKey);
+	if (TemplateProfile.TemplateName.IsEmpty())
+	{
+		TemplateProfile.TemplateName = Template->GetPathName();
+	}
+	TemplateProfile.Total.Triggers++;
+	TemplateProfile.Nodes.FindOrAdd(NodeGuid).Triggers++;
+
+	FFlowNodeClassProfile& ClassProfile = FFlowProfiler::NodeClassProfiles.FindOrAdd(ClassKey);
+	if (ClassProfile.ClassName.IsEmpty())
+	{
+		ClassProfile.ClassName = Node.GetClass()->GetPathName();
+	}
+	ClassProfile.Total.Triggers++;
+
+	Parent = FFlowProfiler::CurrentScope;
+	FFlowProfiler::CurrentScope = this;
+	StartTime = FPlatformTime::Seconds();
+}
+
+FFlowProfilerScope::~FFlowProfilerScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+	const double ExclusiveTime = ElapsedTime - ChildTime;
+
+	FFlowProfiler::CurrentScope = Parent;
+	if (Parent)
+	{
+		Parent->ChildTime += ElapsedTime;
+	}
+
+	// recursive scopes would count the same time twice, the outermost one includes it already
+	bool bNestedTemplate = false;
+	bool bNestedClass = false;
+	bool bNestedNode = false;
+	for (const FFlowProfilerScope* Scope = Parent; Scope; Scope = Scope->Parent)
+	{
+		if (Scope->TemplateKey == TemplateKey)
+		{
+			bNestedTemplate = true;
+			bNestedNode |= Scope->NodeGuid == NodeGuid;
+		}
+		bNestedClass |= Scope->ClassKey == ClassKey;
+	}
+
+	// profiles could have been reset while the scope was open
+	if (FFlowTemplateProfile* TemplateProfile = FFlowProfiler::TemplateProfiles.Find(TemplateKey))
+	{
+		TemplateProfile->Total.ExclusiveTime += ExclusiveTime;
+		TemplateProfile->Total.InclusiveTime += bNestedTemplate ? 0.0 : ElapsedTime;
+
+		FFlowProfileEntry& NodeEntry = TemplateProfile->Nodes.FindOrAdd(NodeGuid);
+		NodeEntry.ExclusiveTime += ExclusiveTime;
+		NodeEntry.InclusiveTime += bNestedNode ? 0.0 : ElapsedTime;
+	}
+
+	if (FFlowNodeClassProfile* ClassProfile = FFlowProfiler::NodeClassProfiles.Find(ClassKey))
+	{
+		ClassProfile->Total.ExclusiveTime += ExclusiveTime;
+		ClassProfile->Total.InclusiveTime += bNestedClass ? 0.0 : ElapsedTime;
+	}
+}
+
+namespace FlowProfiler
+{
+	EFlowProfileMetric ParseMetric(const TArray<FString>& Args)
+	{
+		if (Args.IsValidIndex(0))
+		{
+			if (Args[0].Equals(TEXT("Inclusive"), ESearchCase::IgnoreCase))
+			{
+				return EFlowProfileMetric::InclusiveTime;
+			}
+			if (Args[0].Equals(TEXT("Triggers"), ESearchCase::IgnoreCase))
+			{
+				return EFlowProfileMetric::Triggers;
+			}
+		}
+
+		return EFlowProfileMetric::ExclusiveTime;
+	}
+}
+
+static FAutoConsoleCommand FlowProfilerStartCommand(
+	TEXT("Flow.Profiler.Start"),
+	TEXT("Starts accumulating time and trigger count of Flow node inputs per template, node and node class"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowProfiler::SetEnabled, true));
+
+static FAutoConsoleCommand FlowProfilerStopCommand(
+	TEXT("Flow.Profiler.Stop"),
+	TEXT("Stops the Flow Profiler, accumulated data is kept until Flow.Profiler.Reset"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowProfiler::SetEnabled, false));
+
+static FAutoConsoleCommand FlowProfilerResetCommand(
+	TEXT("Flow.Profiler.Reset"),
+	TEXT("Clears data accumulated by the Flow Profiler"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowProfiler::Reset));
+
+static FAutoConsoleCommand FlowProfilerDumpCommand(
+	TEXT("Flow.Profiler.Dump"),
+	TEXT("Logs Flow templates and node classes sorted by cost. Arguments: [Exclusive|Inclusive|Triggers] [MaxEntries=20]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 MaxEntries = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 20;
+		FFlowProfiler::Dump(FlowProfiler::ParseMetric(Args), MaxEntries);
+	}));
+#endif
@@ -0,0 +1,345 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowBenchmarkGraphs.h"
+#include "FlowComponent.h"
+#include "FlowLogChannels.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Actor/FlowNode_OnActorRegistered.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Measures the component registry: registering, changing Identity Tags, queries and the fan-out to active observers
+ * Friend of UFlowSubsystem, so registration is timed without the engine cost of registering components with the world
+ */
+struct FFlowRegistryBenchmark
+{
+	UFlowSubsystem& FlowSubsystem;
+	UWorld& World;
+	FRandomStream Random;
+
+	// Every registered tag, so identity sets follow the hierarchy depth of the project's tag dictionary
+	TArray<FGameplayTag> Tags;
+
+	TArray<AActor*> Actors;
+	TArray<UFlowComponent*> Components;
+
+	FFlowRegistryBenchmark(UFlowSubsystem& InFlowSubsystem, UWorld& InWorld)
+		: FlowSubsystem(InFlowSubsystem)
+		, World(InWorld)
+		, Random(0x5EED)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+		AllTags.GetGameplayTagArray(Tags);
+	}
+
+	const FGameplayTag& GetRandomTag() const
+	{
+		return Tags[Random.RandHelper(Tags.Num())];
+	}
+
+	FGameplayTagContainer GetRandomTags(const int32 Num) const
+	{
+		FGameplayTagContainer Container;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Container.AddTag(GetRandomTag());
+		}
+		return Container;
+	}
+
+	// Registered through BeginPlay, like components spawned during gameplay
+	void SpawnComponents(const int32 Num, const int32 TagsPerComponent)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			AActor* Actor = World.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+			UFlowComponent* Component = NewObject<UFlowComponent>(Actor, NAME_None, RF_Transient);
+			Component->AddIdentityTags(GetRandomTags(TagsPerComponent));
+			Component->RegisterComponent();
+
+			Actors.Add(Actor);
+			Components.Add(Component);
+		}
+	}
+
+	void DestroyComponents()
+	{
+		for (AActor* Actor : Actors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+			}
+		}
+
+		Actors.Empty();
+		Components.Empty();
+	}
+
+	// Observers are never satisfied, so they keep receiving registrations until the flow is aborted
+	FFlowBenchmarkGraphs::FGraph MakeObservers(const int32 Depth) const
+	{
+		return FFlowBenchmarkGraphs::MakeFanOut(TEXT("FlowBenchmark_RegistryObservers"), Depth, [this](UFlowAsset& Asset)
+		{
+			UFlowNode_OnActorRegistered* Observer = FFlowBenchmarkGraphs::AddNode<UFlowNode_OnActorRegistered>(Asset);
+			Observer->SetIdentityTags(FGameplayTagContainer(GetRandomTag()));
+			Observer->SetSuccessLimit(0);
+			return Observer;
+		}, TEXT("Start"));
+	}
+
+	static void Report(const TCHAR* Operation, const double Seconds, const int32 Operations, const int32 Results = INDEX_NONE)
+	{
+		const double Microseconds = Operations > 0 ? Seconds * 1000000.0 / Operations : 0.0;
+		if (Results == INDEX_NONE)
+		{
+			UE_LOG(LogFlow, Display, TEXT("  %-22s %10.3f us per operation, %d operations"), Operation, Microseconds, Operations);
+		}
+		else
+		{
+			UE_LOG(LogFlow, Display, TEXT("  %-22s %10.3f us per operation, %d operations, %.1f results per query"), Operation, Microseconds, Operations, Operations > 0 ? static_cast<double>(Results) / Operations : 0.0);
+		}
+	}
+
+	// Unregisters and registers every component directly in the subsystem
+	double MeasureRegistration(double& OutUnregisterSeconds)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		for (UFlowComponent* Component : Components)
+		{
+			FlowSubsystem.UnregisterComponent(Component);
+		}
+		OutUnregisterSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (UFlowComponent* Component : Components)
+		{
+			FlowSubsystem.RegisterComponent(Component);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	// Coalesced changes are committed right away, so the subsystem update is part of the measured cost
+	void MeasureTagChanges(const int32 Iterations)
+	{
+		double AddedSeconds = 0.0;
+		double RemovedSeconds = 0.0;
+		int32 Operations = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (UFlowComponent* Component : Components)
+			{
+				const FGameplayTag& Tag = GetRandomTag();
+				if (Component->IdentityTags.HasTagExact(Tag))
+				{
+					continue;
+				}
+
+				double StartTime = FPlatformTime::Seconds();
+				Component->AddIdentityTag(Tag);
+				Component->CommitIdentityTagChanges();
+				AddedSeconds += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				Component->RemoveIdentityTag(Tag);
+				Component->CommitIdentityTagChanges();
+				RemovedSeconds += FPlatformTime::Seconds() - StartTime;
+
+				Operations++;
+			}
+		}
+
+		Report(TEXT("OnIdentityTagsAdded"), AddedSeconds, Operations);
+		Report(TEXT("OnIdentityTagsRemoved"), RemovedSeconds, Operations);
+	}
+
+	void MeasureQuery(const TCHAR* Name, const int32 Queries, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<FGameplayTagContainer()> MakeTags)
+	{
+		TArray<FGameplayTagContainer> QueryTags;
+		QueryTags.Reserve(Queries);
+		for (int32 Index = 0; Index < Queries; Index++)
+		{
+			QueryTags.Add(MakeTags());
+		}
+
+		int32 Results = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FGameplayTagContainer& Container : QueryTags)
+		{
+			FlowSubsystem.ForEachComponent(Container, MatchType, bExactMatch, [&Results](UFlowComponent&)
+			{
+				Results++;
+				return true;
+			});
+		}
+
+		Report(Name, FPlatformTime::Seconds() - StartTime, Queries, Results);
+	}
+
+	void MeasureQueries(const int32 Queries)
+	{
+		MeasureQuery(TEXT("FindComponents Exact"), Queries, EGameplayContainerMatchType::Any, true, [this]()
+		{
+			return FGameplayTagContainer(GetRandomTag());
+		});
+
+		// parent tags match components tagged with any of their children
+		MeasureQuery(TEXT("FindComponents Parent"), Queries, EGameplayContainerMatchType::Any, false, [this]()
+		{
+			const FGameplayTag Tag = GetRandomTag();
+			const FGameplayTag Parent = Tag.RequestDirectParent();
+			return FGameplayTagContainer(Parent.IsValid() ? Parent : Tag);
+		});
+
+		MeasureQuery(TEXT("FindComponents Any"), Queries, EGameplayContainerMatchType::Any, true, [this]()
+		{
+			return GetRandomTags(3);
+		});
+
+		// tags of a registered component, so there's at least one result
+		MeasureQuery(TEXT("FindComponents All"), Queries, EGameplayContainerMatchType::All, true, [this]()
+		{
+			const FGameplayTagContainer& ComponentTags = Components[Random.RandHelper(Components.Num())]->IdentityTags;
+			FGameplayTagContainer Container;
+			for (const FGameplayTag& Tag : ComponentTags)
+			{
+				if (Container.Num() < 2)
+				{
+					Container.AddTag(Tag);
+				}
+			}
+			return Container;
+		});
+	}
+
+	// Random mix of re-registrations and tag changes, like actors streaming in and changing state
+	void MeasureChurn(const int32 Operations)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Operations; Index++)
+		{
+			UFlowComponent* Component = Components[Random.RandHelper(Components.Num())];
+			switch (Random.RandHelper(3))
+			{
+				case 0:
+					FlowSubsystem.UnregisterComponent(Component);
+					FlowSubsystem.RegisterComponent(Component);
+					break;
+				case 1:
+					Component->AddIdentityTag(GetRandomTag());
+					Component->CommitIdentityTagChanges();
+					break;
+				default:
+					if (Component->IdentityTags.Num() > 1)
+					{
+						Component->RemoveIdentityTag(Component->IdentityTags.GetByIndex(Random.RandHelper(Component->IdentityTags.Num())));
+						Component->CommitIdentityTagChanges();
+					}
+					break;
+			}
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogFlow, Display, TEXT("  %-22s %10.0f operations/s"), TEXT("Churn"), Seconds > 0.0 ? Operations / Seconds : 0.0);
+	}
+
+	void Run(const int32 ComponentsNum, const int32 ObserversDepth, const int32 TagsPerComponent, const int32 Iterations, const int32 Queries, const int32 ChurnOperations)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		SpawnComponents(ComponentsNum, TagsPerComponent);
+		Report(TEXT("Spawn and BeginPlay"), FPlatformTime::Seconds() - StartTime, ComponentsNum);
+
+		double RegisterSeconds = 0.0;
+		double UnregisterSeconds = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			double IterationUnregisterSeconds = 0.0;
+			RegisterSeconds += MeasureRegistration(IterationUnregisterSeconds);
+			UnregisterSeconds += IterationUnregisterSeconds;
+		}
+		Report(TEXT("RegisterComponent"), RegisterSeconds, ComponentsNum * Iterations);
+		Report(TEXT("UnregisterComponent"), UnregisterSeconds, ComponentsNum * Iterations);
+
+		MeasureTagChanges(Iterations);
+		MeasureQueries(Queries);
+
+		// observers receive every registration matching their tags, the difference to the plain registration is the fan-out cost
+		const FFlowBenchmarkGraphs::FGraph Observers = MakeObservers(ObserversDepth);
+		const TStrongObjectPtr<UObject> Owner(NewObject<UObject>(&World, UObject::StaticClass(), NAME_None, RF_Transient));
+		if (UFlowAsset* Instance = FlowSubsystem.CreateRootFlow(Owner.Get(), Observers.Asset, true))
+		{
+			const int32 ObserversNum = 1 << ObserversDepth;
+
+			// observers visit already registered components on start
+			StartTime = FPlatformTime::Seconds();
+			Instance->StartFlow();
+			Report(TEXT("Start Observers"), FPlatformTime::Seconds() - StartTime, ObserversNum);
+
+			double ObservedRegisterSeconds = 0.0;
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				double IterationUnregisterSeconds = 0.0;
+				ObservedRegisterSeconds += MeasureRegistration(IterationUnregisterSeconds);
+			}
+			Report(TEXT("Observed Register"), ObservedRegisterSeconds, ComponentsNum * Iterations);
+			Report(TEXT("Observer Fan-out"), FMath::Max(ObservedRegisterSeconds - RegisterSeconds, 0.0), ComponentsNum * Iterations * ObserversNum);
+
+			MeasureChurn(ChurnOperations);
+
+			FlowSubsystem.FinishRootFlow(Owner.Get(), Observers.Asset, EFlowFinishPolicy::Abort);
+		}
+
+		DestroyComponents();
+	}
+
+	static void RunCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UFlowSubsystem* FlowSubsystem = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UFlowSubsystem>() : nullptr;
+		if (FlowSubsystem == nullptr || !World->HasBegunPlay())
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Flow.Benchmark.Registry requires a game world with the Flow Subsystem"));
+			return;
+		}
+
+		const int32 ComponentsNum = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const int32 ObserversDepth = Args.IsValidIndex(1) ? FMath::Clamp(FCString::Atoi(*Args[1]), 0, 12) : 6;
+		const int32 TagsPerComponent = Args.IsValidIndex(2) ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 4;
+		const int32 Iterations = Args.IsValidIndex(3) ? FMath::Max(FCString::Atoi(*Args[3]), 1) : 5;
+		const int32 Queries = Args.IsValidIndex(4) ? FMath::Max(FCString::Atoi(*Args[4]), 1) : 10000;
+		const int32 ChurnOperations = Args.IsValidIndex(5) ? FMath::Max(FCString::Atoi(*Args[5]), 0) : 100000;
+
+		FFlowRegistryBenchmark Benchmark(*FlowSubsystem, *World);
+		if (Benchmark.Tags.IsEmpty())
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Flow.Benchmark.Registry found no registered gameplay tags"));
+			return;
+		}
+
+		UE_LOG(LogFlow, Display, TEXT("Flow.Benchmark.Registry: %d components with %d of %d tags, %d observers, %d iterations"),
+			ComponentsNum, TagsPerComponent, Benchmark.Tags.Num(), 1 << ObserversDepth, Iterations);
+
+		Benchmark.Run(ComponentsNum, ObserversDepth, TagsPerComponent, Iterations, Queries, ChurnOperations);
+	}
+};
+
+static FAutoConsoleCommandWithWorldAndArgs FlowRegistryBenchmarkCommand(
+	TEXT("Flow.Benchmark.Registry"),
+	TEXT("Spawns actors with Flow Components tagged by random registered gameplay tags, reports the cost of registering, changing Identity Tags, ")
+	TEXT("exact, parent, Any and All queries, the fan-out to On Actor Registered observers and a random churn of these operations. ")
+	TEXT("Arguments: [Components=10000] [ObserversDepth=6] [TagsPerComponent=4] [Iterations=5] [Queries=10000] [ChurnOperations=100000], observers are 2^ObserversDepth"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FFlowRegistryBenchmark::RunCommand));
+#endif
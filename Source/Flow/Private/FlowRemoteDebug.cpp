@@ -0,0 +1,206 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowRemoteDebug.h"
+
+#if FLOW_WITH_REMOTE_DEBUG
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "Nodes/FlowNode.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+UE_TRACE_CHANNEL_DEFINE(FlowDebugChannel);
+
+// sent once per instance, important events are cached by Trace and delivered to the editor connecting later
+UE_TRACE_EVENT_BEGIN(Flow, RemoteInstance, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(uint32, InstanceId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, TemplatePath)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, InstanceName)
+	UE_TRACE_EVENT_FIELD(uint32[], NodeGuids)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Flow, RemotePin)
+	UE_TRACE_EVENT_FIELD(float, Time)
+	UE_TRACE_EVENT_FIELD(uint32, InstanceId)
+	UE_TRACE_EVENT_FIELD(uint16, NodeIndex)
+	UE_TRACE_EVENT_FIELD(uint8, PinIndex)
+	UE_TRACE_EVENT_FIELD(uint8, EventType)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Flow, RemoteNodeState)
+	UE_TRACE_EVENT_FIELD(float, Time)
+	UE_TRACE_EVENT_FIELD(uint32, InstanceId)
+	UE_TRACE_EVENT_FIELD(uint16, NodeIndex)
+	UE_TRACE_EVENT_FIELD(uint8, State)
+UE_TRACE_EVENT_END()
+
+TSet<FName> FFlowRemoteDebug::WatchedNames;
+bool FFlowRemoteDebug::bHasWatches = false;
+TMap<FObjectKey, uint32> FFlowRemoteDebug::InstanceIds;
+uint32 FFlowRemoteDebug::NextInstanceId = 1;
+double FFlowRemoteDebug::StartTime = 0.0;
+
+void FFlowRemoteDebug::Initialize()
+{
+	FString WatchedNamesList;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FlowRemoteDebugWatch="), WatchedNamesList))
+	{
+		TArray<FString> Names;
+		WatchedNamesList.ParseIntoArray(Names, TEXT("+"));
+		for (const FString& Name : Names)
+		{
+			Watch(*Name);
+		}
+	}
+}
+
+void FFlowRemoteDebug::Watch(const FName& Name)
+{
+	if (!Name.IsNone())
+	{
+		WatchedNames.Add(Name);
+		OnWatchesChanged();
+	}
+}
+
+void FFlowRemoteDebug::Unwatch(const FName& Name)
+{
+	if (WatchedNames.Remove(Name) > 0)
+	{
+		OnWatchesChanged();
+	}
+}
+
+void FFlowRemoteDebug::UnwatchAll()
+{
+	WatchedNames.Empty();
+	OnWatchesChanged();
+}
+
+void FFlowRemoteDebug::OnWatchesChanged()
+{
+	if (!bHasWatches && WatchedNames.Num() > 0)
+	{
+		StartTime = FPlatformTime::Seconds();
+	}
+	bHasWatches = WatchedNames.Num() > 0;
+
+	// instances are matched again, ids keep increasing, so the editor never confuses instances
+	InstanceIds.Empty();
+
+	UE_LOG(LogFlow, Display, TEXT("Flow Remote Debug: watching %d names"), WatchedNames.Num());
+}
+
+float FFlowRemoteDebug::GetTime()
+{
+	return static_cast<float>(FPlatformTime::Seconds() - StartTime);
+}
+
+uint32 FFlowRemoteDebug::GetInstanceId(const UFlowAsset& Instance)
+{
+	if (const uint32* InstanceId = InstanceIds.Find(FObjectKey(&Instance)))
+	{
+		return *InstanceId;
+	}
+
+	UFlowAsset* Template = Instance.GetTemplateAsset();
+	const bool bWatched = Template && (WatchedNames.Contains(TEXT("*")) || WatchedNames.Contains(Template->GetFName()) || WatchedNames.Contains(Instance.GetDisplayName()));
+	if (!bWatched)
+	{
+		InstanceIds.Add(FObjectKey(&Instance), 0);
+		return 0;
+	}
+
+	const uint32 InstanceId = NextInstanceId++;
+	InstanceIds.Add(FObjectKey(&Instance), InstanceId);
+
+	const FString TemplatePath = Template->GetPathName();
+	const FString InstanceName = Instance.GetDisplayName().ToString();
+	const TArray<FGuid>& NodeGuids = Template->GetOrCompileGraph().NodeGuids;
+
+	UE_TRACE_LOG(Flow, RemoteInstance, FlowDebugChannel)
+		<< RemoteInstance.InstanceId(InstanceId)
+		<< RemoteInstance.TemplatePath(*TemplatePath, TemplatePath.Len())
+		<< RemoteInstance.InstanceName(*InstanceName, InstanceName.Len())
+		<< RemoteInstance.NodeGuids(reinterpret_cast<const uint32*>(NodeGuids.GetData()), NodeGuids.Num() * 4);
+
+	return InstanceId;
+}
+
+void FFlowRemoteDebug::OnInstanceDeinitialized(const UFlowAsset& Instance)
+{
+	if (InstanceIds.Num() > 0)
+	{
+		InstanceIds.Remove(FObjectKey(&Instance));
+	}
+}
+
+void FFlowRemoteDebug::TracePin(const UFlowNode& Node, const int32 PinIndex, const EFlowRecordedEventType EventType)
+{
+	const UFlowAsset* FlowInstance = Node.GetFlowAsset();
+	const int32 NodeIndex = Node.GetCompiledNodeIndex();
+	if (FlowInstance == nullptr || !IsInGameThread() || NodeIndex < 0 || NodeIndex > MAX_uint16 || PinIndex < 0 || PinIndex > MAX_uint8)
+	{
+		return;
+	}
+
+	if (const uint32 InstanceId = GetInstanceId(*FlowInstance))
+	{
+		UE_TRACE_LOG(Flow, RemotePin, FlowDebugChannel)
+			<< RemotePin.Time(GetTime())
+			<< RemotePin.InstanceId(InstanceId)
+			<< RemotePin.NodeIndex(static_cast<uint16>(NodeIndex))
+			<< RemotePin.PinIndex(static_cast<uint8>(PinIndex))
+			<< RemotePin.EventType(static_cast<uint8>(EventType));
+	}
+}
+
+void FFlowRemoteDebug::TraceNodeState(const UFlowNode& Node, const EFlowNodeState State)
+{
+	const UFlowAsset* FlowInstance = Node.GetFlowAsset();
+	const int32 NodeIndex = Node.GetCompiledNodeIndex();
+	if (FlowInstance == nullptr || !IsInGameThread() || NodeIndex < 0 || NodeIndex > MAX_uint16)
+	{
+		return;
+	}
+
+	if (const uint32 InstanceId = GetInstanceId(*FlowInstance))
+	{
+		UE_TRACE_LOG(Flow, RemoteNodeState, FlowDebugChannel)
+			<< RemoteNodeState.Time(GetTime())
+			<< RemoteNodeState.InstanceId(InstanceId)
+			<< RemoteNodeState.NodeIndex(static_cast<uint16>(NodeIndex))
+			<< RemoteNodeState.State(static_cast<uint8>(State));
+	}
+}
+
+static FAutoConsoleCommand FlowRemoteDebugWatchCommand(
+	TEXT("Flow.RemoteDebug.Watch"),
+	TEXT("Streams activations of matching Flow instances over the FlowDebug trace channel. Arguments: TemplateOrInstanceName... (* for all)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		for (const FString& Arg : Args)
+		{
+			FFlowRemoteDebug::Watch(*Arg);
+		}
+	}));
+
+static FAutoConsoleCommand FlowRemoteDebugUnwatchCommand(
+	TEXT("Flow.RemoteDebug.Unwatch"),
+	TEXT("Stops streaming activations of Flow instances. Arguments: [TemplateOrInstanceName...], all if empty"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.IsEmpty())
+		{
+			FFlowRemoteDebug::UnwatchAll();
+		}
+
+		for (const FString& Arg : Args)
+		{
+			FFlowRemoteDebug::Unwatch(*Arg);
+		}
+	}));
+#endif
@@ -0,0 +1,363 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowSave.h"
+#include "FlowLogChannels.h"
+#include "FlowSettings.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Serialization/ArchiveUObject.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowSave)
+
+int32 FFlowSaveDataTables::AddName(const FName& Name)
+{
+	if (const int32* ExistingIndex = NameIndices.Find(Name))
+	{
+		return *ExistingIndex;
+	}
+
+	const int32 NewIndex = Names.Add(Name);
+	NameIndices.Add(Name, NewIndex);
+	return NewIndex;
+}
+
+int32 FFlowSaveDataTables::AddObjectPath(const FSoftObjectPath& ObjectPath)
+{
+	if (const int32* ExistingIndex = ObjectPathIndices.Find(ObjectPath))
+	{
+		return *ExistingIndex;
+	}
+
+	const int32 NewIndex = ObjectPaths.Add(ObjectPath);
+	ObjectPathIndices.Add(ObjectPath, NewIndex);
+	return NewIndex;
+}
+
+void FFlowSaveDataTables::RebuildIndices()
+{
+	NameIndices.Reset();
+	for (int32 Index = 0; Index < Names.Num(); Index++)
+	{
+		NameIndices.Add(Names[Index], Index);
+	}
+
+	ObjectPathIndices.Reset();
+	for (int32 Index = 0; Index < ObjectPaths.Num(); Index++)
+	{
+		ObjectPathIndices.Add(ObjectPaths[Index], Index);
+	}
+}
+
+void FFlowSaveDataTables::Reset()
+{
+	Names.Reset();
+	ObjectPaths.Reset();
+	NameIndices.Reset();
+	ObjectPathIndices.Reset();
+}
+
+FFlowCompactArchive::FFlowCompactArchive(FArchive& InInnerArchive, FFlowSaveDataTables& InTables)
+	: FArchiveProxy(InInnerArchive)
+	, Tables(InTables)
+{
+	ArIsSaveGame = true;
+}
+
+// zero is reserved for None and null references, so the table index is shifted by one
+FArchive& FFlowCompactArchive::operator<<(FName& Value)
+{
+	uint32 PackedIndex = 0;
+
+	if (IsLoading())
+	{
+		InnerArchive.SerializeIntPacked(PackedIndex);
+		const int32 TableIndex = static_cast<int32>(PackedIndex) - 1;
+		Value = Tables.Names.IsValidIndex(TableIndex) ? Tables.Names[TableIndex] : NAME_None;
+	}
+	else
+	{
+		PackedIndex = Value.IsNone() ? 0 : Tables.AddName(Value) + 1;
+		InnerArchive.SerializeIntPacked(PackedIndex);
+	}
+
+	return *this;
+}
+
+FArchive& FFlowCompactArchive::operator<<(FSoftObjectPath& Value)
+{
+	uint32 PackedIndex = 0;
+
+	if (IsLoading())
+	{
+		InnerArchive.SerializeIntPacked(PackedIndex);
+		const int32 TableIndex = static_cast<int32>(PackedIndex) - 1;
+		Value = Tables.ObjectPaths.IsValidIndex(TableIndex) ? Tables.ObjectPaths[TableIndex] : FSoftObjectPath();
+	}
+	else
+	{
+		PackedIndex = Value.IsNull() ? 0 : Tables.AddObjectPath(Value) + 1;
+		InnerArchive.SerializeIntPacked(PackedIndex);
+	}
+
+	return *this;
+}
+
+FArchive& FFlowCompactArchive::operator<<(UObject*& Value)
+{
+	FSoftObjectPath ObjectPath;
+
+	if (IsLoading())
+	{
+		*this << ObjectPath;
+
+		// matches FFlowArchive, which loads the object if it can't be found
+		Value = ObjectPath.IsNull() ? nullptr : ObjectPath.ResolveObject();
+		if (Value == nullptr && !ObjectPath.IsNull())
+		{
+			Value = ObjectPath.TryLoad();
+		}
+	}
+	else
+	{
+		ObjectPath = FSoftObjectPath(Value);
+		*this << ObjectPath;
+	}
+
+	return *this;
+}
+
+FArchive& FFlowCompactArchive::operator<<(FObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeObjectPtr(*this, Value);
+}
+
+FArchive& FFlowCompactArchive::operator<<(FWeakObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeWeakObjectPtr(*this, Value);
+}
+
+FArchive& FFlowCompactArchive::operator<<(FSoftObjectPtr& Value)
+{
+	FSoftObjectPath ObjectPath = Value.ToSoftObjectPath();
+	*this << ObjectPath;
+
+	if (IsLoading())
+	{
+		Value = ObjectPath;
+	}
+
+	return *this;
+}
+
+void FlowSave::SerializeSaveData(UObject& Object, FArchive& InnerArchive, FFlowSaveDataTables* Tables, UObject* DeltaArchetype)
+{
+	// loading applies whatever has been written, the delta only affects saving
+	if (InnerArchive.IsLoading())
+	{
+		DeltaArchetype = nullptr;
+	}
+
+	if (Tables)
+	{
+		FFlowCompactArchive Ar(InnerArchive, *Tables);
+		Ar.SetDeltaArchetype(&Object, DeltaArchetype);
+		Object.Serialize(Ar);
+	}
+	else
+	{
+		FFlowArchive Ar(InnerArchive);
+		Ar.SetDeltaArchetype(&Object, DeltaArchetype);
+		Object.Serialize(Ar);
+	}
+}
+
+void FlowSave::ResetSaveGameProperties(UObject& Object, const UObject& Archetype)
+{
+	if (!Object.IsA(Archetype.GetClass()))
+	{
+		return;
+	}
+
+	for (TFieldIterator<FProperty> It(Archetype.GetClass()); It; ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_SaveGame))
+		{
+			It->CopyCompleteValue_InContainer(&Object, &Archetype);
+		}
+	}
+}
+
+// sizes read from the SaveGame can't be trusted, the slot might be corrupted or tampered with
+static int32 GFlowSaveGameMaxUncompressedSizeMB = 256;
+static FAutoConsoleVariableRef CVarFlowSaveGameMaxUncompressedSizeMB(
+	TEXT("Flow.SaveGame.MaxUncompressedSizeMB"),
+	GFlowSaveGameMaxUncompressedSizeMB,
+	TEXT("Compressed Flow data of the SaveGame is rejected if it declares a larger uncompressed size."));
+
+static int32 GFlowSaveGameMaxCompressionRatio = 1024;
+static FAutoConsoleVariableRef CVarFlowSaveGameMaxCompressionRatio(
+	TEXT("Flow.SaveGame.MaxCompressionRatio"),
+	GFlowSaveGameMaxCompressionRatio,
+	TEXT("Compressed Flow data of the SaveGame is rejected if its declared uncompressed size exceeds the compressed size by more than this factor."));
+
+namespace FlowSaveRecords
+{
+	// loaded records are appended to the array
+	template <typename RecordType>
+	void Serialize(FArchive& Ar, TArray<RecordType>& Records)
+	{
+		int32 RecordsNum = Records.Num();
+		Ar << RecordsNum;
+
+		int32 FirstIndex = 0;
+		if (Ar.IsLoading())
+		{
+			// every record takes at least one byte, protects against corrupted data
+			if (RecordsNum < 0 || RecordsNum > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+
+			FirstIndex = Records.Num();
+			Records.AddDefaulted(RecordsNum);
+		}
+
+		for (int32 Index = FirstIndex; Index < Records.Num() && !Ar.IsError(); Index++)
+		{
+			RecordType::StaticStruct()->SerializeItem(Ar, &Records[Index], nullptr);
+		}
+	}
+}
+
+void FFlowLevelSaveData::Encode(FFlowLevelRecords& Records)
+{
+	RecordsData.Reset();
+
+	FMemoryWriter MemoryWriter(RecordsData, true);
+	FFlowArchive Ar(MemoryWriter);
+
+	FlowSaveRecords::Serialize(Ar, Records.FlowComponents);
+	FlowSaveRecords::Serialize(Ar, Records.FlowInstances);
+}
+
+void FFlowLevelSaveData::Decode(FFlowLevelRecords& OutRecords) const
+{
+	FMemoryReader MemoryReader(RecordsData, true);
+	FFlowArchive Ar(MemoryReader);
+
+	FlowSaveRecords::Serialize(Ar, OutRecords.FlowComponents);
+	FlowSaveRecords::Serialize(Ar, OutRecords.FlowInstances);
+}
+
+void UFlowSaveGame::Serialize(FArchive& Ar)
+{
+	// only data written to SaveGame slots and memory is compressed, not editor transactions
+	const bool bPersistentData = Ar.IsPersistent() && !Ar.IsTransacting() && !Ar.IsObjectReferenceCollector();
+	const FName& CompressionFormat = UFlowSettings::Get()->SaveGameCompressionFormat;
+
+	if (bPersistentData && Ar.IsSaving() && !CompressionFormat.IsNone() && CompressFlowData(CompressionFormat))
+	{
+		// records are written only in the compressed form, moving arrays keeps pointers to their elements valid
+		TArray<FFlowComponentSaveData> SavedFlowComponents = MoveTemp(FlowComponents);
+		TArray<FFlowAssetSaveData> SavedFlowInstances = MoveTemp(FlowInstances);
+		TArray<FFlowLevelSaveData> SavedFlowLevels = MoveTemp(FlowLevels);
+
+		Super::Serialize(Ar);
+
+		FlowComponents = MoveTemp(SavedFlowComponents);
+		FlowInstances = MoveTemp(SavedFlowInstances);
+		FlowLevels = MoveTemp(SavedFlowLevels);
+
+		CompressedFlowData.Empty();
+		CompressedFlowDataFormat = NAME_None;
+		UncompressedFlowDataSize = 0;
+		return;
+	}
+
+	Super::Serialize(Ar);
+
+	if (bPersistentData && Ar.IsLoading() && CompressedFlowData.Num() > 0)
+	{
+		if (!DecompressFlowData())
+		{
+			UE_LOG(LogFlow, Error, TEXT("Failed to decompress Flow data of %s"), *GetName());
+		}
+	}
+}
+
+void UFlowSaveGame::SerializeFlowRecords(FArchive& Ar)
+{
+	FlowSaveRecords::Serialize(Ar, FlowComponents);
+	FlowSaveRecords::Serialize(Ar, FlowInstances);
+	FlowSaveRecords::Serialize(Ar, FlowLevels);
+}
+
+bool UFlowSaveGame::CompressFlowData(const FName& FormatName)
+{
+	TArray<uint8> UncompressedData;
+	{
+		FMemoryWriter MemoryWriter(UncompressedData, true);
+		FFlowArchive Ar(MemoryWriter);
+		SerializeFlowRecords(Ar);
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, UncompressedData.Num());
+	CompressedFlowData.SetNumUninitialized(CompressedSize);
+
+	if (!FCompression::CompressMemory(FormatName, CompressedFlowData.GetData(), CompressedSize, UncompressedData.GetData(), UncompressedData.Num()))
+	{
+		CompressedFlowData.Empty();
+		return false;
+	}
+
+	CompressedFlowData.SetNum(CompressedSize);
+	CompressedFlowDataFormat = FormatName;
+	UncompressedFlowDataSize = UncompressedData.Num();
+	return true;
+}
+
+bool UFlowSaveGame::DecompressFlowData()
+{
+	// validate the declared size before allocating it
+	const int64 MaxUncompressedSize = FMath::Min<int64>(static_cast<int64>(GFlowSaveGameMaxUncompressedSizeMB) * 1024 * 1024,
+		static_cast<int64>(CompressedFlowData.Num()) * GFlowSaveGameMaxCompressionRatio);
+	const bool bValidSize = UncompressedFlowDataSize >= 0 && UncompressedFlowDataSize <= MaxUncompressedSize;
+	const bool bValidFormat = !CompressedFlowDataFormat.IsNone() && FCompression::IsFormatValid(CompressedFlowDataFormat);
+
+	if (!bValidSize || !bValidFormat)
+	{
+		UE_LOG(LogFlow, Error, TEXT("Compressed Flow data of %s declares invalid uncompressed size %d (compressed %d bytes) or format %s"),
+			*GetName(), UncompressedFlowDataSize, CompressedFlowData.Num(), *CompressedFlowDataFormat.ToString());
+
+		CompressedFlowData.Empty();
+		CompressedFlowDataFormat = NAME_None;
+		UncompressedFlowDataSize = 0;
+		return false;
+	}
+
+	TArray<uint8> UncompressedData;
+	UncompressedData.SetNumUninitialized(UncompressedFlowDataSize);
+
+	const bool bDecompressed = FCompression::UncompressMemory(CompressedFlowDataFormat, UncompressedData.GetData(), UncompressedFlowDataSize, CompressedFlowData.GetData(), CompressedFlowData.Num());
+
+	CompressedFlowData.Empty();
+	CompressedFlowDataFormat = NAME_None;
+	UncompressedFlowDataSize = 0;
+
+	if (!bDecompressed)
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(UncompressedData, true);
+	FFlowArchive Ar(MemoryReader);
+	SerializeFlowRecords(Ar);
+
+	return !Ar.IsError();
+}
@@ -0,0 +1,194 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "FlowSave.h"
+#include "FlowSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+
+#if !UE_BUILD_SHIPPING
+namespace FlowSaveBenchmark
+{
+	struct FPhaseTimes
+	{
+		double Snapshot = 0.0;
+		double Encode = 0.0;
+		double Decode = 0.0;
+		double Reload = 0.0;
+		int64 Bytes = 0;
+	};
+
+	bool AreRecordsEqual(const UFlowSaveGame& Saved, const UFlowSaveGame& Loaded)
+	{
+		if (Saved.FlowInstances.Num() != Loaded.FlowInstances.Num() || Saved.FlowComponents.Num() != Loaded.FlowComponents.Num() || Saved.FlowLevels.Num() != Loaded.FlowLevels.Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Saved.FlowInstances.Num(); Index++)
+		{
+			const FFlowAssetSaveData& SavedRecord = Saved.FlowInstances[Index];
+			const FFlowAssetSaveData& LoadedRecord = Loaded.FlowInstances[Index];
+			if (SavedRecord.InstanceName != LoadedRecord.InstanceName || SavedRecord.InstanceId != LoadedRecord.InstanceId || SavedRecord.AssetData != LoadedRecord.AssetData || SavedRecord.NodeRecords.Num() != LoadedRecord.NodeRecords.Num())
+			{
+				return false;
+			}
+
+			for (int32 NodeIndex = 0; NodeIndex < SavedRecord.NodeRecords.Num(); NodeIndex++)
+			{
+				if (SavedRecord.NodeRecords[NodeIndex].NodeGuid != LoadedRecord.NodeRecords[NodeIndex].NodeGuid
+					|| SavedRecord.NodeRecords[NodeIndex].NodeData != LoadedRecord.NodeRecords[NodeIndex].NodeData)
+				{
+					return false;
+				}
+			}
+		}
+
+		for (int32 Index = 0; Index < Saved.FlowComponents.Num(); Index++)
+		{
+			if (Saved.FlowComponents[Index].ActorInstanceName != Loaded.FlowComponents[Index].ActorInstanceName
+				|| Saved.FlowComponents[Index].ComponentData != Loaded.FlowComponents[Index].ComponentData)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Reloaded instance gets a new name, so instances are compared by the template and the active nodes
+	TArray<FString> GetActiveStateSignatures(const UFlowSubsystem& FlowSubsystem, const UObject* Owner)
+	{
+		TArray<FString> Signatures;
+		for (const UFlowAsset* Instance : FlowSubsystem.GetRootInstancesViewByOwner(Owner))
+		{
+			TArray<FGuid> ActiveNodeGuids;
+			for (const UFlowNode* ActiveNode : Instance->GetActiveNodes())
+			{
+				ActiveNodeGuids.Add(ActiveNode->GetGuid());
+			}
+			ActiveNodeGuids.Sort();
+
+			FString& Signature = Signatures.Add_GetRef(GetNameSafe(Instance->GetTemplateAsset()));
+			for (const FGuid& NodeGuid : ActiveNodeGuids)
+			{
+				Signature += TEXT(":") + NodeGuid.ToString();
+			}
+		}
+
+		Signatures.Sort();
+		return Signatures;
+	}
+
+	void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UFlowSubsystem* FlowSubsystem = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UFlowSubsystem>() : nullptr;
+		if (FlowSubsystem == nullptr)
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Flow.SaveGame.Benchmark requires a game world with the Flow Subsystem"));
+			return;
+		}
+
+		const int32 Iterations = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+		UFlowAsset* BenchmarkAsset = Args.IsValidIndex(1) ? LoadObject<UFlowAsset>(nullptr, *Args[1]) : nullptr;
+		const int32 BenchmarkInstances = Args.IsValidIndex(2) ? FMath::Max(FCString::Atoi(*Args[2]), 0) : 0;
+
+		// benchmark flows are owned by the World Settings, so they don't mix with flows of actors
+		UObject* BenchmarkOwner = World->GetWorldSettings();
+		if (BenchmarkAsset && BenchmarkOwner)
+		{
+			for (int32 Index = 0; Index < BenchmarkInstances; Index++)
+			{
+				FlowSubsystem->StartRootFlow(BenchmarkOwner, BenchmarkAsset, true);
+			}
+		}
+		const bool bReloadBenchmarkFlows = BenchmarkAsset && BenchmarkOwner && BenchmarkInstances > 0;
+
+		UFlowSaveGame* PreviousLoadedSaveGame = FlowSubsystem->GetLoadedSaveGame();
+		UFlowSaveGame* SaveGame = Cast<UFlowSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlowSaveGame::StaticClass()));
+
+		FPhaseTimes Total;
+		int32 FailedRoundTrips = 0;
+		int32 FailedReloads = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			// same SaveGame is reused, as it happens with autosaves
+			double StartTime = FPlatformTime::Seconds();
+			FlowSubsystem->OnGameSaved(SaveGame);
+			Total.Snapshot += FPlatformTime::Seconds() - StartTime;
+
+			TArray<uint8> SaveData;
+			StartTime = FPlatformTime::Seconds();
+			UGameplayStatics::SaveGameToMemory(SaveGame, SaveData);
+			Total.Encode += FPlatformTime::Seconds() - StartTime;
+			Total.Bytes += SaveData.Num();
+
+			StartTime = FPlatformTime::Seconds();
+			UFlowSaveGame* LoadedSaveGame = Cast<UFlowSaveGame>(UGameplayStatics::LoadGameFromMemory(SaveData));
+			Total.Decode += FPlatformTime::Seconds() - StartTime;
+
+			if (LoadedSaveGame == nullptr || !AreRecordsEqual(*SaveGame, *LoadedSaveGame))
+			{
+				FailedRoundTrips++;
+				continue;
+			}
+
+			if (bReloadBenchmarkFlows)
+			{
+				const TArray<FString> SignaturesBeforeReload = GetActiveStateSignatures(*FlowSubsystem, BenchmarkOwner);
+
+				TArray<uint64> SavedInstanceIds;
+				for (const UFlowAsset* Instance : FlowSubsystem->GetRootInstancesViewByOwner(BenchmarkOwner))
+				{
+					SavedInstanceIds.Add(Instance->GetInstanceId());
+				}
+
+				FlowSubsystem->FinishRootFlow(BenchmarkOwner, BenchmarkAsset, EFlowFinishPolicy::Abort);
+
+				StartTime = FPlatformTime::Seconds();
+				FlowSubsystem->OnGameLoaded(LoadedSaveGame);
+				for (const uint64 InstanceId : SavedInstanceIds)
+				{
+					FlowSubsystem->LoadRootFlowById(BenchmarkOwner, BenchmarkAsset, InstanceId, true);
+				}
+				Total.Reload += FPlatformTime::Seconds() - StartTime;
+
+				if (GetActiveStateSignatures(*FlowSubsystem, BenchmarkOwner) != SignaturesBeforeReload)
+				{
+					FailedReloads++;
+				}
+			}
+		}
+
+		if (bReloadBenchmarkFlows)
+		{
+			FlowSubsystem->FinishRootFlow(BenchmarkOwner, BenchmarkAsset, EFlowFinishPolicy::Abort);
+			FlowSubsystem->OnGameLoaded(PreviousLoadedSaveGame);
+		}
+
+		const double ToMs = 1000.0 / Iterations;
+		UE_LOG(LogFlow, Display, TEXT("Flow.SaveGame.Benchmark: %d iterations, %d root instances, %d instance records, %d component records"),
+			Iterations, FlowSubsystem->GetRootInstancesNum(), SaveGame->FlowInstances.Num(), SaveGame->FlowComponents.Num());
+		UE_LOG(LogFlow, Display, TEXT("  snapshot %.3f ms, encode %.3f ms, decode %.3f ms, reload %.3f ms, %lld bytes per iteration"),
+			Total.Snapshot * ToMs, Total.Encode * ToMs, Total.Decode * ToMs, Total.Reload * ToMs, Total.Bytes / Iterations);
+
+		if (FailedRoundTrips > 0 || FailedReloads > 0)
+		{
+			UE_LOG(LogFlow, Error, TEXT("  %d round trips didn't match the saved records, %d reloads didn't restore active nodes"), FailedRoundTrips, FailedReloads);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs FlowSaveBenchmarkCommand(
+	TEXT("Flow.SaveGame.Benchmark"),
+	TEXT("Saves and loads Flow Graphs of the world repeatedly, reporting time and size per phase and verifying the round trip. ")
+	TEXT("Arguments: [Iterations=10] [FlowAssetPath] [Instances=0], the asset is started as additional root flows and reloaded on every iteration"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FlowSaveBenchmark::Run));
+#endif
@@ -2,15 +2,73 @@
 
 #include "FlowSettings.h"
 #include "FlowComponent.h"
+#include "Nodes/FlowPin.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowSettings)
 
+#if FLOW_WITH_PIN_RECORDS
+static int32 GFlowPinRecordingModeOverride = -1;
+static FAutoConsoleVariableRef CVarFlowPinRecordingMode(
+	TEXT("Flow.PinRecordingMode"),
+	GFlowPinRecordingModeOverride,
+	TEXT("Overrides Pin Recording Mode from Flow Settings. -1: use Flow Settings, 0: Off, 1: Ring Buffer, 2: Full"));
+#endif
+
 UFlowSettings::UFlowSettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bCreateFlowSubsystemOnClients(true)
+	, bCosmeticFlowsOnlyOnClients(false)
+	, bReplicateActorNotifiesByReceiver(false)
+	, bRecordFlowStateInReplays(false)
+	, ReplayFlowStateInterval(1.0f)
+	, MaxReplayFlowStateKB(256)
+	, MaxClientCustomInputsPerSecond(10.0f)
+	, MaxClientCustomInputsPerBatch(16)
 	, bWarnAboutMissingIdentityTags(true)
+	, bIncrementalSaveGame(false)
+	, bCompactSaveGameFormat(false)
+	, bParallelSaveGame(false)
+	, bGroupSaveGameByLevel(false)
+	, bSaveGameDeltaFromTemplate(false)
+	, SaveGameCompressionFormat(NAME_None)
+	, bPartitionComponentRegistryByClass(false)
+	, bShardComponentRegistryByWorld(false)
+	, bBatchComponentRegistrationPerFrame(false)
+	, bCoalesceIdentityTagChanges(false)
+	, bSpatialComponentRegistry(false)
+	, SpatialComponentRegistryCellSize(5000.0f)
+	, bPublishComponentRegistrySnapshot(false)
+#if WITH_EDITORONLY_DATA
+	, RuntimeLogMaxMessages(1000)
+#endif
 	, bLogOnSignalDisabled(true)
 	, bLogOnSignalPassthrough(true)
+	, bOptimizeGraphsOnCook(false)
+	, bBatchRootFlowStartsPerFrame(false)
+	, bUseTriggerQueue(false)
+	, MaxQueuedTriggersPerFrame(0)
+	, TriggerQueueFrameBudget(0.0f)
+	, MaxTriggersPerInstancePerFrame(10000)
+	, TriggerStormResponse(EFlowTriggerStormResponse::Log)
+	, bShareTemplateNodeData(false)
+	, bMemoizeDataPinValues(false)
+	, LookaheadPreloadDepth(0)
+	, MaxLookaheadPreloadedNodes(8)
+	, PreloadedNodeTimeout(0.0f)
+	, PreloadedContentBudgetMB(0)
+	, PreloadEvictionInterval(1.0f)
+	, InstanceHibernationDelay(0.0f)
+	, ThrottledSignificance(0.5f)
+	, PausedSignificance(0.1f)
+	, ThrottledTimerInterval(0.5f)
+	, ThrottledQueuedTriggersPerFrame(16)
+	, SignificanceUpdateInterval(0.25f)
+	, PinRecordingMode(EFlowPinRecordingMode::RingBuffer)
+	, MaxPinRecords(16)
+	, bLeanDedicatedServer(false)
 	, bUseAdaptiveNodeTitles(false)
 	, DefaultExpectedOwnerClass(UFlowComponent::StaticClass())
 {
@@ -41,4 +99,27 @@ UClass* UFlowSettings::TryResolveOrLoadSoftClass(const FSoftClassPath& SoftClass
 	}
 
 	return SoftClassPath.TryLoadClass<UObject>();
-}
\ No newline at end of file
+}
+
+EFlowPinRecordingMode UFlowSettings::GetPinRecordingMode() const
+{
+#if FLOW_WITH_PIN_RECORDS
+	if (GFlowPinRecordingModeOverride >= 0 && GFlowPinRecordingModeOverride <= static_cast<int32>(EFlowPinRecordingMode::Full))
+	{
+		return static_cast<EFlowPinRecordingMode>(GFlowPinRecordingModeOverride);
+	}
+
+	return PinRecordingMode;
+#else
+	return EFlowPinRecordingMode::Off;
+#endif
+}
+
+bool UFlowSettings::IsLeanServer(const UWorld* World) const
+{
+#if FLOW_LEAN_SERVER
+	return true;
+#else
+	return bLeanDedicatedServer && World && World->GetNetMode() == NM_DedicatedServer;
+#endif
+}
@@ -0,0 +1,93 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(FlowChannel);
+
+DEFINE_STAT(STAT_FlowRootInstances);
+DEFINE_STAT(STAT_FlowSubGraphInstances);
+DEFINE_STAT(STAT_FlowActiveNodes);
+DEFINE_STAT(STAT_FlowPreloadedNodes);
+DEFINE_STAT(STAT_FlowRegisteredComponents);
+DEFINE_STAT(STAT_FlowPublishLiveStats);
+DEFINE_STAT(STAT_FlowPublishRegistrySnapshot);
+
+DEFINE_STAT(STAT_FlowPinTriggers);
+DEFINE_STAT(STAT_FlowRegistryQueries);
+DEFINE_STAT(STAT_FlowStartedInstances);
+DEFINE_STAT(STAT_FlowFinishedInstances);
+DEFINE_STAT(STAT_FlowTeardownRootFlows);
+DEFINE_STAT(STAT_FlowTriggerStorms);
+
+DEFINE_STAT(STAT_FlowShouldCreateSubsystem);
+DEFINE_STAT(STAT_FlowInitializeSubsystem);
+
+DEFINE_STAT(STAT_FlowDrainTriggerQueue);
+DEFINE_STAT(STAT_FlowDeferredTriggers);
+DEFINE_STAT(STAT_FlowDeferredInstances);
+DEFINE_STAT(STAT_FlowIsolatedExecution);
+DEFINE_STAT(STAT_FlowIsolatedInstances);
+
+DEFINE_STAT(STAT_FlowActiveTimers);
+DEFINE_STAT(STAT_FlowFiredTimers);
+DEFINE_STAT(STAT_FlowTickTimers);
+
+DEFINE_STAT(STAT_FlowWokenEventWaiters);
+
+DEFINE_STAT(STAT_FlowPostedEvents);
+DEFINE_STAT(STAT_FlowDrainPostedEvents);
+
+DEFINE_STAT(STAT_FlowTickableNodes);
+DEFINE_STAT(STAT_FlowTickNodes);
+
+DEFINE_STAT(STAT_FlowPooledInstances);
+DEFINE_STAT(STAT_FlowCreatedInstances);
+DEFINE_STAT(STAT_FlowReusedInstances);
+DEFINE_STAT(STAT_FlowWarmupTemplates);
+
+DEFINE_STAT(STAT_FlowPooledComponents);
+DEFINE_STAT(STAT_FlowReusedComponents);
+
+DEFINE_STAT(STAT_FlowPreloadedAssets);
+DEFINE_STAT(STAT_FlowPreloadedMemory);
+DEFINE_STAT(STAT_FlowPreloadHits);
+DEFINE_STAT(STAT_FlowPreloadMisses);
+DEFINE_STAT(STAT_FlowEvictedPreloads);
+DEFINE_STAT(STAT_FlowHibernatedNodes);
+
+DEFINE_STAT(STAT_FlowDataPinMemoHits);
+DEFINE_STAT(STAT_FlowDataPinMemoMisses);
+DEFINE_STAT(STAT_FlowResolveDataPin);
+DEFINE_STAT(STAT_FlowResolvedDataPins);
+DEFINE_STAT(STAT_FlowDataPinSuppliersVisited);
+
+DEFINE_STAT(STAT_FlowPredicateCacheHits);
+DEFINE_STAT(STAT_FlowPredicateCacheMisses);
+
+DEFINE_STAT(STAT_FlowSaveGame);
+DEFINE_STAT(STAT_FlowLoadGame);
+DEFINE_STAT(STAT_FlowLoadInstance);
+DEFINE_STAT(STAT_FlowLoadComponent);
+DEFINE_STAT(STAT_FlowSerializedSaveRecords);
+DEFINE_STAT(STAT_FlowReusedSaveRecords);
+DEFINE_STAT(STAT_FlowSkippedComponentSaves);
+
+DEFINE_STAT(STAT_FlowPinRecords);
+DEFINE_STAT(STAT_FlowDebuggerPinNotifies);
+
+DEFINE_STAT(STAT_FlowReplicatedBytes);
+DEFINE_STAT(STAT_FlowReplicatedNotifies);
+DEFINE_STAT(STAT_FlowDroppedNotifies);
+DEFINE_STAT(STAT_FlowMergedNotifies);
+DEFINE_STAT(STAT_FlowReplicatedRegistryQueries);
+DEFINE_STAT(STAT_FlowClientCustomInputs);
+DEFINE_STAT(STAT_FlowDroppedClientCustomInputs);
+DEFINE_STAT(STAT_FlowReceiveReplicatedNotifies);
+DEFINE_STAT(STAT_FlowReceiveReplicatedState);
+DEFINE_STAT(STAT_FlowRecordReplayState);
+DEFINE_STAT(STAT_FlowRestoreReplayState);
+
+CSV_DEFINE_CATEGORY_MODULE(FLOW_API, Flow, true);
+CSV_DEFINE_CATEGORY_MODULE(FLOW_API, FlowDataPins, false);
+CSV_DEFINE_CATEGORY_MODULE(FLOW_API, FlowNetworking, false);
+CSV_DEFINE_CATEGORY_MODULE(FLOW_API, FlowTelemetry, false);
@@ -4,15 +4,31 @@
 
 #include "FlowAsset.h"
 #include "FlowComponent.h"
+#include "FlowExecutionRecorder.h"
 #include "FlowLogChannels.h"
+#include "FlowProfiler.h"
+#include "FlowTelemetry.h"
 #include "FlowSave.h"
 #include "FlowSettings.h"
+#include "FlowStats.h"
+#include "FlowWorldSettings.h"
+#include "Nodes/FlowNodeTickable.h"
 #include "Nodes/Graph/FlowNode_SubGraph.h"
+#include "Types/FlowActorOwnerComponentRef.h"
+#include "Types/FlowClassUtils.h"
 
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/Level.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
 #include "Logging/MessageLog.h"
-#include "Misc/Paths.h"
+#include "Misc/App.h"
+#include "UObject/UObjectGlobals.h"
 #include "UObject/UObjectHash.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowSubsystem)
@@ -31,10 +47,10 @@ UFlowSubsystem::UFlowSubsystem()
 
 bool UFlowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_FlowShouldCreateSubsystem);
+
 	// Only create an instance if there is no override implementation defined elsewhere
-	TArray<UClass*> ChildClasses;
-	GetDerivedClasses(GetClass(), ChildClasses, false);
-	if (ChildClasses.Num() > 0)
+	if (FlowClassUtils::HasDerivedClasses(GetClass()))
 	{
 		return false;
 	}
@@ -50,11 +66,161 @@ bool UFlowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void UFlowSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FlowInitializeSubsystem);
+	FLOW_TRACE_SCOPE(TEXT("InitializeFlowSubsystem"));
+
+	bPartitionRegistryByClass = UFlowSettings::Get()->bPartitionComponentRegistryByClass;
+	bShardRegistryByWorld = UFlowSettings::Get()->bShardComponentRegistryByWorld;
+	bBatchRegistrationPerFrame = UFlowSettings::Get()->bBatchComponentRegistrationPerFrame;
+	bBatchRootFlowStartsPerFrame = UFlowSettings::Get()->bBatchRootFlowStartsPerFrame;
+	bSpatialRegistry = UFlowSettings::Get()->bSpatialComponentRegistry;
+	SpatialCellSize = FMath::Max(UFlowSettings::Get()->SpatialComponentRegistryCellSize, 100.0f);
+
+	if (UFlowSettings::Get()->bPublishComponentRegistrySnapshot)
+	{
+		RegistrySnapshot = MakeShared<FFlowComponentRegistrySnapshotBuffer, ESPMode::ThreadSafe>();
+		RegistrySnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::PublishRegistrySnapshot));
+	}
+
+	LevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemovedFromWorld);
+	WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &ThisClass::OnWorldInitializedActors);
+	WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::TickTimers);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::OnPostGarbageCollect);
+
+	if (UFlowSettings::Get()->PreloadedNodeTimeout > 0.0f || UFlowSettings::Get()->PreloadedContentBudgetMB > 0)
+	{
+		// preloads are meant to be held for a while, so there's no need to check them every frame
+		const float EvictionInterval = FMath::Max(UFlowSettings::Get()->PreloadEvictionInterval, 0.1f);
+		PreloadEvictionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::EvictPreloadedContent), EvictionInterval);
+	}
+
+	if (UFlowSettings::Get()->InstanceHibernationDelay > 0.0f)
+	{
+		HibernationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HibernateIdleInstances), 1.0f);
+	}
+
+#if STATS || CSV_PROFILER
+	LiveStatsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::PublishLiveStats));
+#endif
+
+	// registered upfront, as ticker handle can't be safely stored by posting threads
+	PostedEventsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::DrainPostedEvents));
 }
 
 void UFlowSubsystem::Deinitialize()
 {
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldHandle);
+	LevelRemovedFromWorldHandle.Reset();
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	WorldInitializedActorsHandle.Reset();
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+	WorldPostActorTickHandle.Reset();
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	PostGarbageCollectHandle.Reset();
+
+	if (StaleComponentsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(StaleComponentsTickerHandle);
+		StaleComponentsTickerHandle.Reset();
+	}
+	LoadedLevelRecords.Empty();
+
+	if (DeferredTriggerQueuesHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredTriggerQueuesHandle);
+		DeferredTriggerQueuesHandle.Reset();
+	}
+	DeferredTriggerQueues.Empty();
+
+	if (ComponentRegistrationBatchHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ComponentRegistrationBatchHandle);
+		ComponentRegistrationBatchHandle.Reset();
+	}
+	PendingRegisteredComponents.Empty();
+	PendingRegisteredComponentsSet.Empty();
+
+	if (RootFlowStartBatchHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RootFlowStartBatchHandle);
+		RootFlowStartBatchHandle.Reset();
+	}
+	PendingRootFlowStarts.Empty();
+	RootFlowStartBatchDepth = 0;
+
+	if (PreloadEvictionTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PreloadEvictionTickerHandle);
+		PreloadEvictionTickerHandle.Reset();
+	}
+
+	if (HibernationTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(HibernationTickerHandle);
+		HibernationTickerHandle.Reset();
+	}
+
+	if (SignificanceTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SignificanceTickerHandle);
+		SignificanceTickerHandle.Reset();
+	}
+	SignificanceCallback.Unbind();
+	SignificancePausedInstances.Empty();
+
+	if (LiveStatsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LiveStatsTickerHandle);
+		LiveStatsTickerHandle.Reset();
+	}
+
+	if (PostedEventsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PostedEventsTickerHandle);
+		PostedEventsTickerHandle.Reset();
+	}
+	PostedEvents.Empty();
+
+	// worker threads might still hold the buffer, it's released with their last reference
+	if (RegistrySnapshotTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RegistrySnapshotTickerHandle);
+		RegistrySnapshotTickerHandle.Reset();
+	}
+	RegistrySnapshot.Reset();
+
+	ComponentListeners.Empty();
+	ComponentListenersPerTag.Empty();
+	UnfilteredComponentListeners.Empty();
+	LiveQueries.Empty();
+	LiveQueryFilters.Empty();
+	LiveQueryFiltersPerTag.Empty();
+	UnroutedLiveQueryFilters.Empty();
+	PendingLiveQueryEvents.Empty();
+	PendingLiveQueryResolves.Empty();
+	LiveQueryBatchDepth = 0;
+
+	ComponentRegions.Empty();
+	ComponentRegionsPerCell.Empty();
+	PendingRegionEvents.Empty();
+	ComponentClassSaveGameStates.Empty();
+
 	AbortActiveFlows();
+
+	// aborted nodes already cleared their timers
+	TimerWheel.Reset();
+	TimerWorld.Reset();
+
+	for (const TUniquePtr<FFlowNodeTickFunction>& TickFunction : NodeTickFunctions)
+	{
+		TickFunction->UnRegisterTickFunction();
+	}
+	NodeTickFunctions.Empty();
+
+	// aborted nodes already destroyed their coroutines
+	CoroutineFramePool.Trim();
+
+	EventBus.Reset();
 }
 
 void UFlowSubsystem::AbortActiveFlows()
@@ -73,12 +239,35 @@ void UFlowSubsystem::AbortActiveFlows()
 	InstancedTemplates.Empty();
 	InstancedSubFlows.Empty();
 
+	// batched requests would start flows again right after aborting them
+	PendingRootFlowStarts.Empty();
+
 	RootInstances.Empty();
+	RootInstancesPerOwner.Empty();
+	InstancesById.Empty();
+
+	// finishing instances above might have returned them to the pool
+	ClearInstancePools();
+	ClearInjectedComponentPools();
+	WarmedTemplates.Empty();
+	WarmupContentHandles.Empty();
+
+	// nodes of finished instances have flushed their preloads already, this releases leftovers of nodes that never got flushed
+	ClearSharedPreloads();
 }
 
 void UFlowSubsystem::StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances /* = true */)
 {
-	if (FlowAsset)
+	if (FlowAsset && IsRootFlowStartBatched())
+	{
+		PendingRootFlowStarts.Add({Owner, FlowAsset, bAllowMultipleInstances});
+
+		if (RootFlowStartBatchDepth == 0 && !RootFlowStartBatchHandle.IsValid())
+		{
+			RootFlowStartBatchHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickRootFlowStartBatch));
+		}
+	}
+	else if (FlowAsset)
 	{
 		if (UFlowAsset* NewFlow = CreateRootFlow(Owner, FlowAsset, bAllowMultipleInstances))
 		{
@@ -98,12 +287,15 @@ void UFlowSubsystem::StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const
 
 UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances, const FString& NewInstanceName)
 {
-	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	if (const TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = FindRootInstances(Owner))
 	{
-		if (Owner == RootInstance.Value.Get() && FlowAsset == RootInstance.Key->GetTemplateAsset())
+		for (const UFlowAsset* RootInstance : *OwnerInstances)
 		{
-			UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow for the same Owner again. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
-			return nullptr;
+			if (FlowAsset == RootInstance->GetTemplateAsset())
+			{
+				UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow for the same Owner again. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
+				return nullptr;
+			}
 		}
 	}
 
@@ -116,52 +308,257 @@ UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset
 	UFlowAsset* NewFlow = CreateFlowInstance(Owner, FlowAsset, NewInstanceName);
 	if (NewFlow)
 	{
-		RootInstances.Add(NewFlow, Owner);
+		AddRootInstance(NewFlow, Owner);
 	}
 
 	return NewFlow;
 }
 
+void UFlowSubsystem::AddRootInstance(UFlowAsset* Instance, UObject* Owner)
+{
+	RootInstances.Add(Instance, Owner);
+	RootInstancesPerOwner.FindOrAdd(TWeakObjectPtr<const UObject>(Owner)).Add(Instance);
+}
+
+void UFlowSubsystem::RemoveRootInstance(UFlowAsset* Instance)
+{
+	TWeakObjectPtr<UObject> Owner;
+	if (!RootInstances.RemoveAndCopyValue(Instance, Owner))
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<const UObject> OwnerKey = Owner;
+	if (TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = RootInstancesPerOwner.Find(OwnerKey))
+	{
+		OwnerInstances->RemoveSingleSwap(Instance);
+		if (OwnerInstances->IsEmpty())
+		{
+			RootInstancesPerOwner.Remove(OwnerKey);
+		}
+	}
+}
+
+const TArray<UFlowAsset*, TInlineAllocator<1>>* UFlowSubsystem::FindRootInstances(const UObject* Owner) const
+{
+	return Owner ? RootInstancesPerOwner.Find(TWeakObjectPtr<const UObject>(Owner)) : nullptr;
+}
+
+void UFlowSubsystem::BeginRootFlowStartBatch()
+{
+	++RootFlowStartBatchDepth;
+}
+
+void UFlowSubsystem::EndRootFlowStartBatch()
+{
+	check(RootFlowStartBatchDepth > 0);
+
+	if (--RootFlowStartBatchDepth == 0 && !bBatchRootFlowStartsPerFrame)
+	{
+		FlushRootFlowStartBatch();
+	}
+}
+
+bool UFlowSubsystem::TickRootFlowStartBatch(float DeltaTime)
+{
+	RootFlowStartBatchHandle.Reset();
+	FlushRootFlowStartBatch();
+	return false;
+}
+
+void UFlowSubsystem::FlushRootFlowStartBatch()
+{
+	if (PendingRootFlowStarts.IsEmpty())
+	{
+		return;
+	}
+
+	// flows started by starting flows go to the next batch
+	const TArray<FFlowRootFlowStartRequest> Requests = MoveTemp(PendingRootFlowStarts);
+	PendingRootFlowStarts.Reset();
+
+	StartRootFlowRequests(Requests);
+}
+
+bool UFlowSubsystem::HasPendingRootFlowStart(const UObject* Owner) const
+{
+	return Owner && PendingRootFlowStarts.ContainsByPredicate([Owner](const FFlowRootFlowStartRequest& Request)
+	{
+		return Request.Owner.Get() == Owner;
+	});
+}
+
+void UFlowSubsystem::FlushPendingRootFlowStarts(const UObject* Owner)
+{
+	TArray<FFlowRootFlowStartRequest> Requests;
+	for (int32 Index = 0; Index < PendingRootFlowStarts.Num(); Index++)
+	{
+		if (PendingRootFlowStarts[Index].Owner.Get() == Owner)
+		{
+			Requests.Add(PendingRootFlowStarts[Index]);
+		}
+	}
+
+	if (Requests.Num() > 0)
+	{
+		RemovePendingRootFlowStarts(Owner);
+		StartRootFlowRequests(Requests);
+	}
+}
+
+void UFlowSubsystem::RemovePendingRootFlowStarts(const UObject* Owner, const UFlowAsset* TemplateAsset)
+{
+	if (Owner == nullptr || PendingRootFlowStarts.IsEmpty())
+	{
+		return;
+	}
+
+	// keeps the order of remaining requests, flows are started in the order of requests
+	PendingRootFlowStarts.RemoveAll([Owner, TemplateAsset](const FFlowRootFlowStartRequest& Request)
+	{
+		return Request.Owner.Get() == Owner && (TemplateAsset == nullptr || Request.FlowAsset.Get() == TemplateAsset);
+	});
+}
+
+void UFlowSubsystem::StartRootFlowRequests(const TArray<FFlowRootFlowStartRequest>& Requests)
+{
+	// all instances exist before any graph runs, so graphs can already find each other
+	TArray<UFlowAsset*> NewFlows;
+	NewFlows.Reserve(Requests.Num());
+	for (const FFlowRootFlowStartRequest& Request : Requests)
+	{
+		UObject* Owner = Request.Owner.Get();
+		UFlowAsset* FlowAsset = Request.FlowAsset.Get();
+		if (Owner && FlowAsset)
+		{
+			if (UFlowAsset* NewFlow = CreateRootFlow(Owner, FlowAsset, Request.bAllowMultipleInstances))
+			{
+				NewFlows.Add(NewFlow);
+			}
+		}
+	}
+
+	for (UFlowAsset* NewFlow : NewFlows)
+	{
+		// earlier flow might have finished this one already
+		if (RootInstances.Contains(NewFlow))
+		{
+			NewFlow->StartFlow();
+		}
+	}
+}
+
 void UFlowSubsystem::FinishRootFlow(UObject* Owner, UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy)
 {
+	// flow finished before the end of its start batch mustn't be started anymore
+	RemovePendingRootFlowStarts(Owner, TemplateAsset);
+
 	UFlowAsset* InstanceToFinish = nullptr;
 
-	for (TPair<TObjectPtr<UFlowAsset>, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
+	if (const TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = FindRootInstances(Owner))
 	{
-		if (Owner && Owner == RootInstance.Value.Get() && RootInstance.Key && RootInstance.Key->GetTemplateAsset() == TemplateAsset)
+		for (UFlowAsset* RootInstance : *OwnerInstances)
 		{
-			InstanceToFinish = RootInstance.Key;
-			break;
+			if (RootInstance && RootInstance->GetTemplateAsset() == TemplateAsset)
+			{
+				InstanceToFinish = RootInstance;
+				break;
+			}
 		}
 	}
 
 	if (InstanceToFinish)
 	{
-		RootInstances.Remove(InstanceToFinish);
+		RemoveRootInstance(InstanceToFinish);
 		InstanceToFinish->FinishFlow(FinishPolicy);
 	}
 }
 
+void UFlowSubsystem::FinishRootInstance(UFlowAsset* Instance, const EFlowFinishPolicy FinishPolicy)
+{
+	if (Instance && RootInstances.Contains(Instance))
+	{
+		RemoveRootInstance(Instance);
+		Instance->FinishFlow(FinishPolicy);
+	}
+}
+
 void UFlowSubsystem::FinishAllRootFlows(UObject* Owner, const EFlowFinishPolicy FinishPolicy)
 {
+	RemovePendingRootFlowStarts(Owner);
+
+	if (FinishPolicy == EFlowFinishPolicy::Abort)
+	{
+		TeardownRootFlows(Owner);
+		return;
+	}
+
 	TArray<UFlowAsset*> InstancesToFinish;
 
-	for (TPair<TObjectPtr<UFlowAsset>, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
+	if (const TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = FindRootInstances(Owner))
+	{
+		InstancesToFinish.Append(*OwnerInstances);
+	}
+
+	for (UFlowAsset* InstanceToFinish : InstancesToFinish)
 	{
-		if (Owner && Owner == RootInstance.Value.Get() && RootInstance.Key)
+		if (InstanceToFinish)
 		{
-			InstancesToFinish.Emplace(RootInstance.Key);
+			RemoveRootInstance(InstanceToFinish);
+			InstanceToFinish->FinishFlow(FinishPolicy);
 		}
 	}
+}
+
+void UFlowSubsystem::TeardownRootFlows(UObject* Owner)
+{
+	TArray<UFlowAsset*, TInlineAllocator<1>> InstancesToFinish;
+	if (Owner == nullptr || !RootInstancesPerOwner.RemoveAndCopyValue(TWeakObjectPtr<const UObject>(Owner), InstancesToFinish))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowTeardownRootFlows);
+	FLOW_TRACE_SCOPE_TEXT(TEXT("TeardownRootFlows %s"), *GetNameSafe(Owner));
+
+	TMap<UFlowAsset*, TSet<const UFlowAsset*>> InstancesPerTemplate;
+	TArray<TPair<UFlowAsset*, UFlowAsset*>, TInlineAllocator<4>> FinishedInstances;
 
 	for (UFlowAsset* InstanceToFinish : InstancesToFinish)
 	{
 		RootInstances.Remove(InstanceToFinish);
-		InstanceToFinish->FinishFlow(FinishPolicy);
+
+		UFlowAsset* Template = InstanceToFinish ? InstanceToFinish->GetTemplateAsset() : nullptr;
+		if (Template == nullptr)
+		{
+			continue;
+		}
+
+		InstanceToFinish->FinishFlow(EFlowFinishPolicy::Abort, false);
+
+		TGuardValue<bool> TeardownGuard(InstanceToFinish->bTeardownBatched, true);
+		InstanceToFinish->DeinitializeInstance();
+
+		InstancesPerTemplate.FindOrAdd(Template).Add(InstanceToFinish);
+		FinishedInstances.Emplace(InstanceToFinish, Template);
+	}
+
+	for (const TPair<UFlowAsset*, TSet<const UFlowAsset*>>& TemplateInstances : InstancesPerTemplate)
+	{
+		if (TemplateInstances.Key->RemoveInstances(TemplateInstances.Value) == 0)
+		{
+			RemoveInstancedTemplate(TemplateInstances.Key);
+		}
+	}
+
+	// pooled only after leaving the template, as nothing can acquire them in the middle of the batch
+	for (const TPair<UFlowAsset*, UFlowAsset*>& FinishedInstance : FinishedInstances)
+	{
+		ReleaseFlowInstance(FinishedInstance.Key, FinishedInstance.Value);
 	}
 }
 
-UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedInstanceName, const bool bPreloading /* = false */)
+UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedInstanceName, const bool bPreloading /* = false */, const bool bLoading /* = false */)
 {
 	UFlowAsset* NewInstance = nullptr;
 
@@ -190,7 +587,7 @@ UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, cons
 		SubGraphNode->GetFlowAsset()->ActiveSubGraphs.Add(SubGraphNode, AssetInstance);
 
 		// don't activate Start Node if we're loading Sub Graph from SaveGame
-		if (SavedInstanceName.IsEmpty())
+		if (!bLoading && SavedInstanceName.IsEmpty())
 		{
 			AssetInstance->StartFlow(SubGraphNode);
 		}
@@ -217,35 +614,104 @@ void UFlowSubsystem::RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlow
 
 UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, UFlowAsset* LoadedFlowAsset, FString NewInstanceName)
 {
+	FLOW_TRACE_SCOPE_TEXT(TEXT("CreateFlowInstance %s"), *GetNameSafe(LoadedFlowAsset));
+
 	if (LoadedFlowAsset == nullptr)
 	{
 		return nullptr;
 	}
 
+	if (!LoadedFlowAsset->bCosmetic && IsCosmeticOnly())
+	{
+		UE_LOG(LogFlow, Verbose, TEXT("Skipped non-cosmetic Flow Asset %s on the cosmetic-only client"), *LoadedFlowAsset->GetName());
+		return nullptr;
+	}
+
 	AddInstancedTemplate(LoadedFlowAsset);
 
 #if WITH_EDITOR
 	if (GetWorld()->WorldType != EWorldType::Game)
 	{
-		// Fix connections - even in packaged game if assets haven't been re-saved in the editor after changing node's definition
-		LoadedFlowAsset->HarvestNodeConnections();
+		// Fix connections, if assets haven't been re-saved in the editor after changing node's definition. Cooked assets are fixed by ApplyCookFixups
+		// skipped if the template hasn't changed since it was harvested for the previous instance
+		LoadedFlowAsset->HarvestNodeConnectionsIfNeeded();
 	}
 #endif
 
-	// it won't be empty, if we're restoring Flow Asset instance from the SaveGame
-	if (NewInstanceName.IsEmpty())
+	const uint32 InstanceSerial = NextInstanceSerial++;
+
+	UFlowAsset* NewInstance = AcquirePooledInstance(LoadedFlowAsset, NewInstanceName);
+	if (NewInstance == nullptr)
 	{
-		NewInstanceName = MakeUniqueObjectName(this, UFlowAsset::StaticClass(), *FPaths::GetBaseFilename(LoadedFlowAsset->GetPathName())).ToString();
+		// it won't be empty, if we're restoring Flow Asset instance from the SaveGame written before instance ids
+		const FName InstanceName = NewInstanceName.IsEmpty() ? MakeInstanceName(*LoadedFlowAsset, InstanceSerial) : FName(*NewInstanceName);
+
+		NewInstance = NewObject<UFlowAsset>(this, LoadedFlowAsset->GetClass(), InstanceName, RF_Transient, LoadedFlowAsset, false, nullptr);
+		INC_DWORD_STAT(STAT_FlowCreatedInstances);
+		CSV_CUSTOM_STAT(Flow, InstancesAllocated, 1, ECsvCustomStatOp::Accumulate);
 	}
 
-	UFlowAsset* NewInstance = NewObject<UFlowAsset>(this, LoadedFlowAsset->GetClass(), *NewInstanceName, RF_Transient, LoadedFlowAsset, false, nullptr);
 	NewInstance->InitializeInstance(Owner, *LoadedFlowAsset);
+	AssignInstanceId(*NewInstance, *LoadedFlowAsset, InstanceSerial);
+	INC_DWORD_STAT(STAT_FlowStartedInstances);
+	CSV_CUSTOM_STAT(Flow, InstancesStarted, 1, ECsvCustomStatOp::Accumulate);
 
 	LoadedFlowAsset->AddInstance(NewInstance);
 
 	return NewInstance;
 }
 
+FName UFlowSubsystem::MakeInstanceName(const UFlowAsset& Template, const uint32 InstanceSerial)
+{
+	const FName InstanceName(Template.GetFName(), NAME_EXTERNAL_TO_INTERNAL(static_cast<int32>(InstanceSerial)));
+
+	// only instances named explicitly could take it
+	if (StaticFindObjectFast(nullptr, this, InstanceName) == nullptr)
+	{
+		return InstanceName;
+	}
+
+	return MakeUniqueObjectName(this, UFlowAsset::StaticClass(), Template.GetFName());
+}
+
+void UFlowSubsystem::AssignInstanceId(UFlowAsset& Instance, const UFlowAsset& Template, const uint32 InstanceSerial)
+{
+	UnregisterInstanceId(Instance);
+
+	Instance.InstanceId = (static_cast<uint64>(Template.GetInstanceTemplateId()) << 32) | InstanceSerial;
+	InstancesById.Add(Instance.InstanceId, &Instance);
+}
+
+void UFlowSubsystem::UnregisterInstanceId(UFlowAsset& Instance)
+{
+	if (Instance.InstanceId != 0)
+	{
+		InstancesById.Remove(Instance.InstanceId);
+		Instance.InstanceId = 0;
+	}
+}
+
+void UFlowSubsystem::RestoreInstanceId(UFlowAsset& Instance, const uint64 SavedInstanceId)
+{
+	if (SavedInstanceId == 0 || SavedInstanceId == Instance.InstanceId || InstancesById.Contains(SavedInstanceId))
+	{
+		return;
+	}
+
+	InstancesById.Remove(Instance.InstanceId);
+	Instance.InstanceId = SavedInstanceId;
+	InstancesById.Add(SavedInstanceId, &Instance);
+
+	// instances created later won't reuse serials of the loaded ones
+	NextInstanceSerial = FMath::Max(NextInstanceSerial, GetSerialOfInstance(SavedInstanceId) + 1);
+}
+
+UFlowAsset* UFlowSubsystem::FindInstanceById(const uint64 InstanceId) const
+{
+	UFlowAsset* const* Instance = InstancesById.Find(InstanceId);
+	return Instance ? *Instance : nullptr;
+}
+
 void UFlowSubsystem::AddInstancedTemplate(UFlowAsset* Template)
 {
 	if (!InstancedTemplates.Contains(Template))
@@ -253,7 +719,11 @@ void UFlowSubsystem::AddInstancedTemplate(UFlowAsset* Template)
 		InstancedTemplates.Add(Template);
 
 #if WITH_EDITOR
-		Template->RuntimeLog = MakeShareable(new FFlowMessageLog());
+		// lean server instances don't write to the message log
+		if (!UFlowSettings::Get()->IsLeanServer(GetWorld()))
+		{
+			Template->RuntimeLog = MakeShareable(new FFlowRuntimeMessageLog(UFlowSettings::Get()->RuntimeLogMaxMessages));
+		}
 		OnInstancedTemplateAdded.ExecuteIfBound(Template);
 #endif
 	}
@@ -269,399 +739,3698 @@ void UFlowSubsystem::RemoveInstancedTemplate(UFlowAsset* Template)
 	InstancedTemplates.Remove(Template);
 }
 
-TMap<UObject*, UFlowAsset*> UFlowSubsystem::GetRootInstances() const
+UFlowAsset* UFlowSubsystem::AcquirePooledInstance(UFlowAsset* Template, const FString& NewInstanceName)
 {
-	TMap<UObject*, UFlowAsset*> Result;
-	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	FFlowInstancePool* Pool = InstancePools.Find(Template);
+	if (Pool == nullptr || Pool->Instances.IsEmpty())
 	{
-		Result.Emplace(RootInstance.Value.Get(), RootInstance.Key);
+		return nullptr;
 	}
-	return Result;
-}
 
-TSet<UFlowAsset*> UFlowSubsystem::GetRootInstancesByOwner(const UObject* Owner) const
-{
-	TSet<UFlowAsset*> Result;
-	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	// template has been modified since pooling these instances
+	if (Pool->CompiledGraph.Get() != &Template->GetOrCompileGraph())
+	{
+		DEC_DWORD_STAT_BY(STAT_FlowPooledInstances, Pool->Instances.Num());
+		InstancePools.Remove(Template);
+		return nullptr;
+	}
+
+	while (Pool->Instances.Num() > 0)
 	{
-		if (Owner && RootInstance.Value == Owner)
+		UFlowAsset* PooledInstance = Pool->Instances.Pop(EAllowShrinking::No);
+		DEC_DWORD_STAT(STAT_FlowPooledInstances);
+
+		if (!IsValid(PooledInstance))
+		{
+			continue;
+		}
+
+		// restoring instance from the SaveGame requires the saved name
+		if (!NewInstanceName.IsEmpty() && PooledInstance->GetName() != NewInstanceName)
 		{
-			Result.Emplace(RootInstance.Key);
+			const ERenameFlags RenameFlags = REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty;
+			if (!PooledInstance->Rename(*NewInstanceName, nullptr, RenameFlags | REN_Test))
+			{
+				Pool->Instances.Push(PooledInstance);
+				INC_DWORD_STAT(STAT_FlowPooledInstances);
+				return nullptr;
+			}
+
+			PooledInstance->Rename(*NewInstanceName, nullptr, RenameFlags);
 		}
+
+		INC_DWORD_STAT(STAT_FlowReusedInstances);
+		CSV_CUSTOM_STAT(Flow, InstancesReused, 1, ECsvCustomStatOp::Accumulate);
+		return PooledInstance;
 	}
-	return Result;
+
+	return nullptr;
 }
 
-UFlowAsset* UFlowSubsystem::GetRootFlow(const UObject* Owner) const
+bool UFlowSubsystem::ReleaseFlowInstance(UFlowAsset* Instance, UFlowAsset* Template)
 {
-	const TSet<UFlowAsset*> Result = GetRootInstancesByOwner(Owner);
-	if (Result.Num() > 0)
+	if (!IsValid(Instance) || !IsValid(Template) || Template->MaxPooledInstances <= 0)
 	{
-		return Result.Array()[0];
+		return false;
 	}
 
-	return nullptr;
-}
+	FFlowInstancePool& Pool = InstancePools.FindOrAdd(Template);
 
-UWorld* UFlowSubsystem::GetWorld() const
-{
-	return GetGameInstance()->GetWorld();
-}
+	const FFlowCompiledGraph* TemplateGraph = &Template->GetOrCompileGraph();
+	if (Pool.CompiledGraph.Get() != TemplateGraph)
+	{
+		DEC_DWORD_STAT_BY(STAT_FlowPooledInstances, Pool.Instances.Num());
+		Pool.Instances.Empty();
+		Pool.CompiledGraph = Template->CompiledGraph;
+	}
 
-void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
-{
-	// clear existing data, in case we received reused SaveGame instance
-	// we only remove data for the current world + global Flow Graph instances (i.e. not bound to any world if created by UGameInstanceSubsystem)
-	// we keep data bound to other worlds
-	if (GetWorld())
+	if (Pool.Instances.Num() >= Template->MaxPooledInstances || Pool.Instances.Contains(Instance))
 	{
-		const FString& WorldName = GetWorld()->GetName();
+		return false;
+	}
+
+	Instance->Owner.Reset();
+	Instance->ActiveSubGraphs.Empty();
+
+	Pool.Instances.Add(Instance);
+	INC_DWORD_STAT(STAT_FlowPooledInstances);
+
+	return true;
+}
+
+void UFlowSubsystem::ClearInstancePools()
+{
+	for (const TPair<TObjectPtr<UFlowAsset>, FFlowInstancePool>& Pool : InstancePools)
+	{
+		DEC_DWORD_STAT_BY(STAT_FlowPooledInstances, Pool.Value.Instances.Num());
+	}
+
+	InstancePools.Empty();
+}
+
+FFlowInjectedComponentPool* UFlowSubsystem::FindInjectedComponentPool(const UActorComponent& Archetype)
+{
+	const FObjectKey ArchetypeKey(&Archetype);
+	return InjectedComponentPools.FindByPredicate([&ArchetypeKey](const FFlowInjectedComponentPool& Pool)
+	{
+		return Pool.Archetype == ArchetypeKey;
+	});
+}
+
+UActorComponent* UFlowSubsystem::AcquirePooledComponent(AActor& Actor, const UActorComponent& Archetype)
+{
+	FFlowInjectedComponentPool* Pool = FindInjectedComponentPool(Archetype);
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	// pooled components are destroyed together with their last owner
+	const int32 NumRemoved = Pool->Components.RemoveAll([](const UActorComponent* Component)
+	{
+		return !IsValid(Component) || !IsValid(Component->GetOwner()) || Component->GetOwner()->IsActorBeingDestroyed();
+	});
+	DEC_DWORD_STAT_BY(STAT_FlowPooledComponents, NumRemoved);
+
+	if (Pool->Components.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	int32 ComponentIndex = Pool->Components.IndexOfByPredicate([&Actor](const UActorComponent* Component)
+	{
+		return Component->GetOwner() == &Actor;
+	});
+	if (ComponentIndex == INDEX_NONE)
+	{
+		ComponentIndex = Pool->Components.Num() - 1;
+	}
+
+	UActorComponent* Component = Pool->Components[ComponentIndex];
+	Pool->Components.RemoveAtSwap(ComponentIndex, 1, EAllowShrinking::No);
+	DEC_DWORD_STAT(STAT_FlowPooledComponents);
+
+	if (Component->GetOwner() != &Actor)
+	{
+		// render and physics state belong to the world of the owner, so they're created again while registering with the new actor
+		if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+		{
+			SceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+		}
+		Component->UnregisterComponent();
+
+		// Rename moves the component between OwnedComponents of both actors, instance components have to be moved explicitly
+		AActor* PreviousOwner = Component->GetOwner();
+		const bool bInstanceComponent = PreviousOwner && PreviousOwner->GetInstanceComponents().Contains(Component);
+		if (bInstanceComponent)
+		{
+			PreviousOwner->RemoveInstanceComponent(Component);
+		}
+
+		const FName NewName = StaticFindObjectFast(nullptr, &Actor, Component->GetFName())
+			? MakeUniqueObjectName(&Actor, Component->GetClass(), Component->GetFName())
+			: Component->GetFName();
+		Component->Rename(*NewName.ToString(), &Actor, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+
+		if (bInstanceComponent)
+		{
+			Actor.AddInstanceComponent(Component);
+		}
+
+		// components resolved by name mustn't find the pooled component on its previous owner anymore
+		if (PreviousOwner)
+		{
+			FFlowActorOwnerComponentRef::InvalidateComponentNameIndex(*PreviousOwner);
+		}
+		FFlowActorOwnerComponentRef::InvalidateComponentNameIndex(Actor);
+	}
+
+	INC_DWORD_STAT(STAT_FlowReusedComponents);
+	return Component;
+}
+
+bool UFlowSubsystem::ReleaseComponentToPool(UActorComponent& Component, const UActorComponent& Archetype, const int32 MaxPooledComponents)
+{
+	// replicated components can't move between actors, clients know them through their owner
+	const AActor* Owner = Component.GetOwner();
+	if (MaxPooledComponents <= 0 || Component.GetIsReplicated() || !IsValid(Owner) || Owner->IsActorBeingDestroyed())
+	{
+		return false;
+	}
+
+	FFlowInjectedComponentPool* Pool = FindInjectedComponentPool(Archetype);
+	if (Pool == nullptr)
+	{
+		Pool = &InjectedComponentPools.AddDefaulted_GetRef();
+		Pool->Archetype = FObjectKey(&Archetype);
+	}
+
+	if (Pool->Components.Num() >= MaxPooledComponents || Pool->Components.Contains(&Component))
+	{
+		return false;
+	}
+
+	// stays registered with its owner, so reusing it on the same actor only activates it again
+	Component.Deactivate();
+
+	Pool->Components.Add(&Component);
+	INC_DWORD_STAT(STAT_FlowPooledComponents);
+
+	return true;
+}
+
+bool UFlowSubsystem::IsPooledComponent(const UActorComponent& Component, const UActorComponent& Archetype) const
+{
+	const FObjectKey ArchetypeKey(&Archetype);
+	for (const FFlowInjectedComponentPool& Pool : InjectedComponentPools)
+	{
+		if (Pool.Archetype == ArchetypeKey)
+		{
+			return Pool.Components.Contains(&Component);
+		}
+	}
+
+	return false;
+}
+
+void UFlowSubsystem::ClearInjectedComponentPools()
+{
+	for (const FFlowInjectedComponentPool& Pool : InjectedComponentPools)
+	{
+		DEC_DWORD_STAT_BY(STAT_FlowPooledComponents, Pool.Components.Num());
+
+		for (UActorComponent* Component : Pool.Components)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+				Component->SetFlags(RF_Transient);
+			}
+		}
+	}
+
+	InjectedComponentPools.Empty();
+}
+
+void UFlowSubsystem::ClearSequencePlayerPools()
+{
+	// FlowLevelSequence module depends on this module, so its subsystem is reached through reflection
+	static const FTopLevelAssetPath SubsystemClassPath(TEXT("/Script/FlowLevelSequence"), TEXT("FlowLevelSequenceSubsystem"));
+	UClass* SubsystemClass = FindObject<UClass>(SubsystemClassPath);
+	if (SubsystemClass == nullptr || !SubsystemClass->IsChildOf<UGameInstanceSubsystem>())
+	{
+		return;
+	}
+
+	USubsystem* SequenceSubsystem = GetGameInstance()->GetSubsystemBase(SubsystemClass);
+	if (UFunction* ClearFunction = SequenceSubsystem ? SequenceSubsystem->FindFunction(GET_FUNCTION_NAME_CHECKED(UFlowSubsystem, ClearSequencePlayerPools)) : nullptr)
+	{
+		SequenceSubsystem->ProcessEvent(ClearFunction, nullptr);
+	}
+}
+
+void UFlowSubsystem::OnWorldInitializedActors(const FActorsInitializedParams& Params)
+{
+	// actors are initialized before BeginPlay, so it still happens under the loading screen
+	if (Params.World == nullptr || Params.World != GetWorld() || !Params.World->IsGameWorld())
+	{
+		return;
+	}
+
+	if (const AFlowWorldSettings* WorldSettings = Cast<AFlowWorldSettings>(Params.World->GetWorldSettings()))
+	{
+		WarmupTemplates(WorldSettings->WarmupFlowAssets);
+	}
+}
+
+void UFlowSubsystem::WarmupTemplates(const TArray<FFlowTemplateWarmup>& Warmups)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowWarmupTemplates);
+
+	WarmedTemplates.Reset();
+	WarmupContentHandles.Reset();
+	for (const FFlowTemplateWarmup& Warmup : Warmups)
+	{
+		if (UFlowAsset* Template = Warmup.FlowAsset.LoadSynchronous())
+		{
+			WarmupTemplate(Template, Warmup.PooledInstances);
+		}
+	}
+}
+
+void UFlowSubsystem::WarmupTemplate(UFlowAsset* Template, const int32 PooledInstances)
+{
+	if (!IsValid(Template) || (!Template->bCosmetic && IsCosmeticOnly()))
+	{
+		return;
+	}
+
+	WarmedTemplates.AddUnique(Template);
+
+	if (TSharedPtr<FStreamableHandle> ContentHandle = RequestContentDependencies(Template))
+	{
+		WarmupContentHandles.Add(MoveTemp(ContentHandle));
+	}
+
+#if WITH_EDITOR
+	if (GetWorld()->WorldType != EWorldType::Game)
+	{
+		Template->HarvestNodeConnectionsIfNeeded();
+	}
+#endif
+
+	Template->GetOrCompileGraph();
+
+	const FFlowInstancePool* Pool = InstancePools.Find(Template);
+	const int32 InstancesToCreate = FMath::Min(PooledInstances, Template->MaxPooledInstances) - (Pool ? Pool->Instances.Num() : 0);
+	for (int32 Index = 0; Index < InstancesToCreate; Index++)
+	{
+		const FName InstanceName = MakeInstanceName(*Template, NextInstanceSerial++);
+		UFlowAsset* NewInstance = NewObject<UFlowAsset>(this, Template->GetClass(), InstanceName, RF_Transient, Template, false, nullptr);
+		INC_DWORD_STAT(STAT_FlowCreatedInstances);
+		CSV_CUSTOM_STAT(Flow, InstancesAllocated, 1, ECsvCustomStatOp::Accumulate);
+
+		// nodes are only duplicated, initializing them would reach for the owner which isn't known yet
+		NewInstance->CreateNodeInstances();
+		ReleaseFlowInstance(NewInstance, Template);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UFlowSubsystem::RequestContentDependencies(const UFlowAsset* Template) const
+{
+	if (!IsValid(Template) || Template->ContentDependencies.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(Template->ContentDependencies, FStreamableDelegate());
+}
+
+void UFlowSubsystem::AcquirePreload(const FSoftObjectPath& Path)
+{
+	if (Path.IsNull())
+	{
+		return;
+	}
+
+	FFlowSharedPreload& Preload = SharedPreloads.FindOrAdd(Path);
+	Preload.RefCount++;
+
+	if (Preload.Handle.IsValid())
+	{
+		INC_DWORD_STAT(STAT_FlowPreloadHits);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_FlowPreloadMisses);
+	INC_DWORD_STAT(STAT_FlowPreloadedAssets);
+
+	Preload.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate::CreateUObject(this, &UFlowSubsystem::OnSharedPreloadCompleted, Path));
+}
+
+void UFlowSubsystem::OnSharedPreloadCompleted(const FSoftObjectPath Path)
+{
+	FFlowSharedPreload* Preload = SharedPreloads.Find(Path);
+	if (Preload == nullptr || Preload->ResidentBytes > 0)
+	{
+		return;
+	}
+
+	if (const UObject* LoadedAsset = Path.ResolveObject())
+	{
+		Preload->ResidentBytes = LoadedAsset->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		SharedPreloadBytes += Preload->ResidentBytes;
+		INC_MEMORY_STAT_BY(STAT_FlowPreloadedMemory, Preload->ResidentBytes);
+	}
+}
+
+void UFlowSubsystem::ReleasePreload(const FSoftObjectPath& Path)
+{
+	FFlowSharedPreload* Preload = SharedPreloads.Find(Path);
+	if (Preload == nullptr || --Preload->RefCount > 0)
+	{
+		return;
+	}
+
+	if (Preload->Handle.IsValid())
+	{
+		Preload->Handle->ReleaseHandle();
+	}
+
+	SharedPreloadBytes -= Preload->ResidentBytes;
+	DEC_MEMORY_STAT_BY(STAT_FlowPreloadedMemory, Preload->ResidentBytes);
+	DEC_DWORD_STAT(STAT_FlowPreloadedAssets);
+	SharedPreloads.Remove(Path);
+}
+
+bool UFlowSubsystem::IsPreloaded(const FSoftObjectPath& Path) const
+{
+	const FFlowSharedPreload* Preload = SharedPreloads.Find(Path);
+	return Preload && Preload->Handle.IsValid() && Preload->Handle->HasLoadCompleted();
+}
+
+void UFlowSubsystem::ClearSharedPreloads()
+{
+	for (TPair<FSoftObjectPath, FFlowSharedPreload>& Preload : SharedPreloads)
+	{
+		if (Preload.Value.Handle.IsValid())
+		{
+			Preload.Value.Handle->ReleaseHandle();
+		}
+
+		DEC_MEMORY_STAT_BY(STAT_FlowPreloadedMemory, Preload.Value.ResidentBytes);
+	}
+
+	DEC_DWORD_STAT_BY(STAT_FlowPreloadedAssets, SharedPreloads.Num());
+	SharedPreloads.Empty();
+	SharedPreloadBytes = 0;
+}
+
+bool UFlowSubsystem::EvictPreloadedContent(float DeltaTime)
+{
+	struct FPreloadedNode
+	{
+		UFlowAsset* Instance;
+		UFlowNode* Node;
+	};
+
+	const double Now = FPlatformTime::Seconds();
+	const float Timeout = UFlowSettings::Get()->PreloadedNodeTimeout;
+	const int64 BudgetBytes = static_cast<int64>(UFlowSettings::Get()->PreloadedContentBudgetMB) * 1024 * 1024;
+
+	// nothing to do until the budget is exceeded, if nodes don't time out
+	if (Timeout <= 0.0f && (BudgetBytes <= 0 || SharedPreloadBytes <= BudgetBytes))
+	{
+		return true;
+	}
+
+	TArray<FPreloadedNode> EvictableNodes;
+	for (UFlowAsset* Template : InstancedTemplates)
+	{
+		if (!IsValid(Template))
+		{
+			continue;
+		}
 
-		for (int32 i = SaveGame->FlowInstances.Num() - 1; i >= 0; i--)
+		for (UFlowAsset* Instance : Template->ActiveInstances)
 		{
-			if (SaveGame->FlowInstances[i].WorldName.IsEmpty() || SaveGame->FlowInstances[i].WorldName == WorldName)
+			if (!IsValid(Instance))
+			{
+				continue;
+			}
+
+			for (UFlowNode* Node : Instance->PreloadedNodes)
 			{
-				SaveGame->FlowInstances.RemoveAt(i);
+				if (Node && !Instance->IsNodeActive(*Node))
+				{
+					EvictableNodes.Add({Instance, Node});
+				}
 			}
 		}
+	}
+
+	EvictableNodes.Sort([](const FPreloadedNode& A, const FPreloadedNode& B)
+	{
+		return A.Node->LastPreloadUseTime < B.Node->LastPreloadUseTime;
+	});
+
+	int32 EvictedNodes = 0;
+	for (const FPreloadedNode& Preloaded : EvictableNodes)
+	{
+		const bool bTimedOut = Timeout > 0.0f && Now - Preloaded.Node->LastPreloadUseTime > Timeout;
+		const bool bOverBudget = BudgetBytes > 0 && SharedPreloadBytes > BudgetBytes;
+		if (!bTimedOut && !bOverBudget)
+		{
+			// nodes are sorted from the least recently used, so the remaining ones haven't expired either
+			break;
+		}
+
+		if (Preloaded.Instance->FlushPreloadedNode(Preloaded.Node))
+		{
+			EvictedNodes++;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_FlowEvictedPreloads, EvictedNodes);
+	return true;
+}
+
+bool UFlowSubsystem::HibernateIdleInstances(float DeltaTime)
+{
+	const double Now = FApp::GetCurrentTime();
+	const float Delay = UFlowSettings::Get()->InstanceHibernationDelay;
+
+	int32 HibernatedNodes = 0;
+	for (UFlowAsset* Template : InstancedTemplates)
+	{
+		if (!IsValid(Template) || !Template->bLazyNodeInstantiation)
+		{
+			continue;
+		}
 
-		for (int32 i = SaveGame->FlowComponents.Num() - 1; i >= 0; i--)
+		for (UFlowAsset* Instance : Template->ActiveInstances)
 		{
-			if (SaveGame->FlowComponents[i].WorldName.IsEmpty() || SaveGame->FlowComponents[i].WorldName == WorldName)
+			if (IsValid(Instance) && !Instance->AreNodesHibernated() && Now - Instance->GetLastTriggerTime() >= Delay)
 			{
-				SaveGame->FlowComponents.RemoveAt(i);
+				HibernatedNodes += Instance->HibernateInactiveNodes();
 			}
 		}
 	}
 
-	// save Flow Graphs
-	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	INC_DWORD_STAT_BY(STAT_FlowHibernatedNodes, HibernatedNodes);
+	return true;
+}
+
+bool UFlowSubsystem::PublishLiveStats(float DeltaTime)
+{
+#if STATS || CSV_PROFILER
+#if CSV_PROFILER
+	const bool bCsvCapturing = FCsvProfiler::Get()->IsCapturing();
+#else
+	const bool bCsvCapturing = false;
+#endif
+#if STATS
+	const bool bStatsEnabled = FThreadStats::IsCollectingData();
+#else
+	const bool bStatsEnabled = false;
+#endif
+
+	// counting active nodes walks all instances, so it only happens while anybody is looking
+	if (!bCsvCapturing && !bStatsEnabled)
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowPublishLiveStats);
+
+	int32 ActiveNodesNum = 0;
+	int32 PreloadedNodesNum = 0;
+	for (const UFlowAsset* Template : InstancedTemplates)
 	{
-		if (RootInstance.Key && RootInstance.Value.IsValid())
+		if (!IsValid(Template))
 		{
-			if (UFlowComponent* FlowComponent = Cast<UFlowComponent>(RootInstance.Value))
+			continue;
+		}
+
+		for (const UFlowAsset* Instance : Template->ActiveInstances)
+		{
+			if (IsValid(Instance))
+			{
+				ActiveNodesNum += Instance->ActiveNodes.Num();
+				PreloadedNodesNum += Instance->PreloadedNodes.Num();
+			}
+		}
+	}
+
+	const int32 RegisteredComponentsNum = ComponentSlots.Num() - FreeComponentSlots.Num();
+
+	SET_DWORD_STAT(STAT_FlowRootInstances, RootInstances.Num());
+	SET_DWORD_STAT(STAT_FlowSubGraphInstances, InstancedSubFlows.Num());
+	SET_DWORD_STAT(STAT_FlowActiveNodes, ActiveNodesNum);
+	SET_DWORD_STAT(STAT_FlowPreloadedNodes, PreloadedNodesNum);
+	SET_DWORD_STAT(STAT_FlowRegisteredComponents, RegisteredComponentsNum);
+
+	CSV_CUSTOM_STAT(Flow, RootInstances, RootInstances.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Flow, SubGraphInstances, InstancedSubFlows.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Flow, ActiveNodes, ActiveNodesNum, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Flow, PreloadedNodes, PreloadedNodesNum, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Flow, RegisteredComponents, RegisteredComponentsNum, ECsvCustomStatOp::Set);
+#endif
+
+	return true;
+}
+
+TMap<UObject*, UFlowAsset*> UFlowSubsystem::GetRootInstances() const
+{
+	TMap<UObject*, UFlowAsset*> Result;
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	{
+		Result.Emplace(RootInstance.Value.Get(), RootInstance.Key);
+	}
+	return Result;
+}
+
+TSet<UFlowAsset*> UFlowSubsystem::GetRootInstancesByOwner(const UObject* Owner) const
+{
+	TSet<UFlowAsset*> Result;
+	if (const TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = FindRootInstances(Owner))
+	{
+		Result.Append(*OwnerInstances);
+	}
+	return Result;
+}
+
+TConstArrayView<UFlowAsset*> UFlowSubsystem::GetRootInstancesViewByOwner(const UObject* Owner) const
+{
+	if (const TArray<UFlowAsset*, TInlineAllocator<1>>* OwnerInstances = FindRootInstances(Owner))
+	{
+		return *OwnerInstances;
+	}
+	return TConstArrayView<UFlowAsset*>();
+}
+
+bool UFlowSubsystem::ForEachRootInstance(TFunctionRef<bool(UFlowAsset& Instance, UObject* Owner)> Function) const
+{
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	{
+		if (RootInstance.Key && !Function(*RootInstance.Key, RootInstance.Value.Get()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+UFlowAsset* UFlowSubsystem::GetRootInstanceByOwner(const UObject* Owner, const int32 Index) const
+{
+	const TConstArrayView<UFlowAsset*> OwnerInstances = GetRootInstancesViewByOwner(Owner);
+	return OwnerInstances.IsValidIndex(Index) ? OwnerInstances[Index] : nullptr;
+}
+
+UFlowAsset* UFlowSubsystem::FindRootInstanceByTemplate(const UObject* Owner, const UFlowAsset* TemplateAsset) const
+{
+	for (UFlowAsset* Instance : GetRootInstancesViewByOwner(Owner))
+	{
+		if (Instance && Instance->GetTemplateAsset() == TemplateAsset)
+		{
+			return Instance;
+		}
+	}
+	return nullptr;
+}
+
+UObject* UFlowSubsystem::GetRootInstanceOwner(const UFlowAsset* Instance) const
+{
+	const TWeakObjectPtr<UObject>* Owner = RootInstances.Find(Instance);
+	return Owner ? Owner->Get() : nullptr;
+}
+
+UFlowAsset* UFlowSubsystem::GetRootFlow(const UObject* Owner) const
+{
+	return GetRootInstanceByOwner(Owner);
+}
+
+UWorld* UFlowSubsystem::GetWorld() const
+{
+	return GetGameInstance()->GetWorld();
+}
+
+void UFlowSubsystem::DeferTriggerQueue(UFlowAsset* FlowInstance)
+{
+	DeferredTriggerQueues.AddUnique(FlowInstance);
+
+	if (!DeferredTriggerQueuesHandle.IsValid())
+	{
+		DeferredTriggerQueuesHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickDeferredTriggerQueues));
+	}
+}
+
+void UFlowSubsystem::BeginTriggerQueueDrain()
+{
+	if (TriggerQueueDrainDepth++ == 0)
+	{
+		if (TriggerQueueBudgetFrame != GFrameCounter)
+		{
+			TriggerQueueBudgetFrame = GFrameCounter;
+			TriggerQueueBudgetUsed = 0.0;
+		}
+
+		TriggerQueueDrainStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UFlowSubsystem::EndTriggerQueueDrain()
+{
+	check(TriggerQueueDrainDepth > 0);
+
+	if (--TriggerQueueDrainDepth == 0)
+	{
+		TriggerQueueBudgetUsed += FPlatformTime::Seconds() - TriggerQueueDrainStartTime;
+	}
+}
+
+bool UFlowSubsystem::IsTriggerQueueFrameBudgetExceeded() const
+{
+	const float FrameBudget = UFlowSettings::Get()->TriggerQueueFrameBudget;
+	if (FrameBudget <= 0.0f)
+	{
+		return false;
+	}
+
+	double BudgetUsed = TriggerQueueBudgetFrame == GFrameCounter ? TriggerQueueBudgetUsed : 0.0;
+	if (TriggerQueueDrainDepth > 0)
+	{
+		BudgetUsed += FPlatformTime::Seconds() - TriggerQueueDrainStartTime;
+	}
+
+	return BudgetUsed * 1000000.0 >= FrameBudget;
+}
+
+void UFlowSubsystem::DrainIsolatedTriggerQueues(TArray<TWeakObjectPtr<UFlowAsset>>& InOutQueuesToDrain)
+{
+	// profiler scopes and recorded events are kept in the static state of the game thread
+#if FLOW_WITH_PROFILER
+	if (FFlowProfiler::IsEnabled())
+	{
+		return;
+	}
+#endif
+#if FLOW_WITH_EXECUTION_RECORDER
+	if (FFlowExecutionRecorder::IsRecording())
+	{
+		return;
+	}
+#endif
+#if FLOW_WITH_TELEMETRY
+	if (FFlowTelemetry::IsEnabled())
+	{
+		return;
+	}
+#endif
+
+	TArray<UFlowAsset*> IsolatedInstances;
+	for (const TWeakObjectPtr<UFlowAsset>& FlowInstance : InOutQueuesToDrain)
+	{
+		if (FlowInstance.IsValid() && FlowInstance->CanExecuteIsolated() && FlowInstance->GetSignificanceLevel() == EFlowSignificance::Full)
+		{
+			IsolatedInstances.Add(FlowInstance.Get());
+		}
+	}
+
+	// a single instance isn't worth dispatching to the task graph
+	if (IsolatedInstances.Num() < 2)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowIsolatedExecution);
+	INC_DWORD_STAT_BY(STAT_FlowIsolatedInstances, IsolatedInstances.Num());
+
+	// the whole batch counts towards the frame budget, like a single drain
+	BeginTriggerQueueDrain();
+
+	ParallelFor(IsolatedInstances.Num(), [&IsolatedInstances](const int32 Index)
+	{
+		IsolatedInstances[Index]->DrainIsolatedTriggerQueue();
+	});
+
+	// side effects are applied in the priority order, as if instances were drained one after another
+	for (UFlowAsset* FlowInstance : IsolatedInstances)
+	{
+		FlowInstance->FlushIsolatedSideEffects();
+	}
+
+	EndTriggerQueueDrain();
+
+	InOutQueuesToDrain.RemoveAll([&IsolatedInstances](const TWeakObjectPtr<UFlowAsset>& FlowInstance)
+	{
+		return IsolatedInstances.Contains(FlowInstance.Get());
+	});
+}
+
+bool UFlowSubsystem::TickDeferredTriggerQueues(float DeltaTime)
+{
+	// instances might defer themselves again while draining
+	TArray<TWeakObjectPtr<UFlowAsset>> QueuesToDrain = MoveTemp(DeferredTriggerQueues);
+	DeferredTriggerQueues.Reset();
+
+	SET_DWORD_STAT(STAT_FlowDeferredInstances, QueuesToDrain.Num());
+
+	// this runs at the start of the frame, so the most important instances get the fresh budget
+	QueuesToDrain.RemoveAll([](const TWeakObjectPtr<UFlowAsset>& FlowInstance) { return !FlowInstance.IsValid(); });
+	QueuesToDrain.StableSort([](const TWeakObjectPtr<UFlowAsset>& A, const TWeakObjectPtr<UFlowAsset>& B)
+	{
+		return A->GetExecutionPriority() > B->GetExecutionPriority();
+	});
+
+	DrainIsolatedTriggerQueues(QueuesToDrain);
+
+	for (const TWeakObjectPtr<UFlowAsset>& FlowInstance : QueuesToDrain)
+	{
+		if (FlowInstance.IsValid())
+		{
+			FlowInstance->DrainTriggerQueue();
+		}
+	}
+
+	if (DeferredTriggerQueues.IsEmpty())
+	{
+		DeferredTriggerQueuesHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UFlowSubsystem::TickTimers(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// world time respects pause and time dilation, like FTimerManager
+	const double WorldTime = World->GetTimeSeconds();
+	const bool bSameWorld = TimerWorld.Get() == World && WorldTime >= LastTimerWorldTime;
+	const double DeltaTime = bSameWorld ? WorldTime - LastTimerWorldTime : 0.0;
+	TimerWorld = World;
+	LastTimerWorldTime = WorldTime;
+
+	SET_DWORD_STAT(STAT_FlowActiveTimers, TimerWheel.NumActive());
+	if (TimerWheel.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowTickTimers);
+
+	const int32 FiredTimers = TimerWheel.Advance(DeltaTime);
+	INC_DWORD_STAT_BY(STAT_FlowFiredTimers, FiredTimers);
+	CSV_CUSTOM_STAT(Flow, FiredTimers, FiredTimers, ECsvCustomStatOp::Accumulate);
+}
+
+FFlowTimerHandle UFlowSubsystem::SetFlowTimer(const UFlowAsset* FlowInstance, FFlowTimerDelegate&& Delegate, const float Rate, const bool bLoop, const float FirstDelay)
+{
+	return TimerWheel.SetTimer(FObjectKey(FlowInstance), MoveTemp(Delegate), Rate, bLoop, FirstDelay);
+}
+
+FFlowTimerHandle UFlowSubsystem::SetFlowTimerForNextTick(const UFlowAsset* FlowInstance, FFlowTimerDelegate&& Delegate)
+{
+	return TimerWheel.SetTimerForNextTick(FObjectKey(FlowInstance), MoveTemp(Delegate));
+}
+
+void UFlowSubsystem::ClearFlowTimer(FFlowTimerHandle& Handle)
+{
+	TimerWheel.ClearTimer(Handle);
+}
+
+void UFlowSubsystem::ClearFlowTimers(const UFlowAsset* FlowInstance)
+{
+	TimerWheel.ClearTimers(FObjectKey(FlowInstance));
+	SignificancePausedInstances.Remove(FObjectKey(FlowInstance));
+}
+
+int32 UFlowSubsystem::FastForwardFlowTimers(const UFlowAsset* FlowInstance, const float DeltaTime)
+{
+	if (FlowInstance == nullptr || DeltaTime <= 0.0f)
+	{
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowTickTimers);
+
+	const int32 FiredTimers = TimerWheel.FastForwardTimers(FObjectKey(FlowInstance), DeltaTime);
+	INC_DWORD_STAT_BY(STAT_FlowFiredTimers, FiredTimers);
+	CSV_CUSTOM_STAT(Flow, FiredTimers, FiredTimers, ECsvCustomStatOp::Accumulate);
+	return FiredTimers;
+}
+
+void UFlowSubsystem::PauseFlowTimers(UFlowAsset* FlowInstance)
+{
+	if (FlowInstance)
+	{
+		TimerWheel.PauseTimers(FObjectKey(FlowInstance));
+	}
+}
+
+void UFlowSubsystem::UnPauseFlowTimers(UFlowAsset* FlowInstance)
+{
+	if (FlowInstance)
+	{
+		TimerWheel.UnPauseTimers(FObjectKey(FlowInstance));
+	}
+}
+
+bool UFlowSubsystem::AreFlowTimersPaused(const UFlowAsset* FlowInstance) const
+{
+	return FlowInstance && TimerWheel.AreTimersPaused(FObjectKey(FlowInstance));
+}
+
+void UFlowSubsystem::SetSignificanceCallback(FFlowSignificanceCallback&& Callback)
+{
+	SignificanceCallback = MoveTemp(Callback);
+
+	if (SignificanceCallback.IsBound())
+	{
+		if (!SignificanceTickerHandle.IsValid())
+		{
+			SignificanceTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::UpdateSignificance), UFlowSettings::Get()->SignificanceUpdateInterval);
+		}
+		UpdateSignificance(0.0f);
+	}
+	else
+	{
+		if (SignificanceTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(SignificanceTickerHandle);
+			SignificanceTickerHandle.Reset();
+		}
+
+		for (UFlowAsset* Template : InstancedTemplates)
+		{
+			if (IsValid(Template))
+			{
+				for (UFlowAsset* Instance : Template->ActiveInstances)
+				{
+					SetFlowSignificance(Instance, 1.0f);
+				}
+			}
+		}
+	}
+}
+
+bool UFlowSubsystem::UpdateSignificance(float DeltaTime)
+{
+	if (!SignificanceCallback.IsBound())
+	{
+		SignificanceTickerHandle.Reset();
+		return false;
+	}
+
+	// resuming might start other instances
+	TArray<UFlowAsset*> Instances;
+	for (UFlowAsset* Template : InstancedTemplates)
+	{
+		if (IsValid(Template))
+		{
+			Instances.Append(ObjectPtrDecay(Template->ActiveInstances));
+		}
+	}
+
+	for (UFlowAsset* Instance : Instances)
+	{
+		if (IsValid(Instance))
+		{
+			// Sub Graphs share the owner of their root instance
+			SetFlowSignificance(Instance, SignificanceCallback.Execute(Instance->GetOwner()));
+		}
+	}
+
+	return true;
+}
+
+void UFlowSubsystem::SetFlowSignificance(UFlowAsset* FlowInstance, const float Significance)
+{
+	if (!IsValid(FlowInstance))
+	{
+		return;
+	}
+
+	const UFlowSettings* Settings = UFlowSettings::Get();
+	const EFlowSignificance NewLevel = Significance < Settings->PausedSignificance ? EFlowSignificance::Paused
+		: Significance < Settings->ThrottledSignificance ? EFlowSignificance::Throttled : EFlowSignificance::Full;
+
+	FlowInstance->Significance = Significance;
+	if (FlowInstance->SignificanceLevel == NewLevel)
+	{
+		return;
+	}
+
+	const EFlowSignificance OldLevel = FlowInstance->SignificanceLevel;
+	FlowInstance->SignificanceLevel = NewLevel;
+
+	const FObjectKey InstanceKey(FlowInstance);
+	TimerWheel.SetTimersInterval(InstanceKey, NewLevel == EFlowSignificance::Throttled ? Settings->ThrottledTimerInterval : 0.0);
+
+	if (NewLevel == EFlowSignificance::Paused)
+	{
+		if (!TimerWheel.AreTimersPaused(InstanceKey))
+		{
+			TimerWheel.PauseTimers(InstanceKey);
+			SignificancePausedInstances.Add(InstanceKey);
+		}
+	}
+	else if (OldLevel == EFlowSignificance::Paused)
+	{
+		// timers expired while paused fire during the next timer tick, as if the instance was never paused
+		if (SignificancePausedInstances.Remove(InstanceKey) > 0)
+		{
+			TimerWheel.UnPauseTimers(InstanceKey, true);
+		}
+
+		if (FlowInstance->HasQueuedTriggers())
+		{
+			DeferTriggerQueue(FlowInstance);
+		}
+	}
+}
+
+void UFlowSubsystem::BroadcastComponentEvent(const EFlowEventType Type, UFlowComponent* Component, const FGameplayTag& NotifyTag, UFlowComponent* Sender)
+{
+	if (EventBus.IsEmpty() || Component == nullptr)
+	{
+		return;
+	}
+
+	FFlowEvent Event;
+	Event.Type = Type;
+	Event.Component = Component;
+	Event.NotifyTag = NotifyTag;
+	Event.Sender = Sender;
+	Event.Serial = EventBus.MakeEventSerial();
+
+	// parent tags too, so waiters parked on A are woken by the component tagged A.B, like by non-exact registry queries
+	// copy, as woken nodes might change Identity Tags of the component
+	const FGameplayTagContainer IdentityTags = Component->IdentityTags.GetGameplayTagParents();
+	for (const FGameplayTag& IdentityTag : IdentityTags)
+	{
+		INC_DWORD_STAT_BY(STAT_FlowWokenEventWaiters, EventBus.Broadcast({IdentityTag, Type}, Event));
+	}
+}
+
+void UFlowSubsystem::PostNotifyFromAnyThread(UFlowComponent* Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode)
+{
+	FFlowPostedEvent Event;
+	Event.Component = Component;
+	Event.NotifyTag = NotifyTag;
+	Event.NetMode = NetMode;
+	PostedEvents.Enqueue(MoveTemp(Event));
+}
+
+void UFlowSubsystem::PostCustomInputFromAnyThread(UFlowAsset* FlowInstance, const FName& EventName)
+{
+	FFlowPostedEvent Event;
+	Event.FlowInstance = FlowInstance;
+	Event.EventName = EventName;
+	PostedEvents.Enqueue(MoveTemp(Event));
+}
+
+bool UFlowSubsystem::DrainPostedEvents(float DeltaTime)
+{
+	if (PostedEvents.IsEmpty())
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowDrainPostedEvents);
+
+	// events posted while draining wait for the next frame, so a busy worker can't starve the game thread
+	TArray<FFlowPostedEvent, TInlineAllocator<16>> Events;
+	FFlowPostedEvent Event;
+	while (PostedEvents.Dequeue(Event))
+	{
+		Events.Add(MoveTemp(Event));
+	}
+
+	INC_DWORD_STAT_BY(STAT_FlowPostedEvents, Events.Num());
+
+	for (const FFlowPostedEvent& PostedEvent : Events)
+	{
+		if (UFlowComponent* Component = PostedEvent.Component.Get())
+		{
+			Component->NotifyGraph(PostedEvent.NotifyTag, PostedEvent.NetMode);
+		}
+		else if (UFlowAsset* FlowInstance = PostedEvent.FlowInstance.Get())
+		{
+			FlowInstance->TriggerCustomInput(PostedEvent.EventName);
+		}
+	}
+
+	return true;
+}
+
+void FFlowNodeTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->TickNodes(*this, DeltaTime);
+	}
+}
+
+FString FFlowNodeTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("FlowSubsystem[TickNodes %s]"), *StaticEnum<ETickingGroup>()->GetNameStringByValue(TickGroup));
+}
+
+FName FFlowNodeTickFunction::DiagnosticContext(bool bDetailed)
+{
+	static const FName ContextName(TEXT("FlowNodes"));
+	return ContextName;
+}
+
+FFlowNodeTickFunction& UFlowSubsystem::FindOrAddNodeTickFunction(const ETickingGroup TickGroup)
+{
+	for (const TUniquePtr<FFlowNodeTickFunction>& TickFunction : NodeTickFunctions)
+	{
+		if (TickFunction->TickGroup == TickGroup)
+		{
+			return *TickFunction;
+		}
+	}
+
+	FFlowNodeTickFunction& TickFunction = *NodeTickFunctions.Add_GetRef(MakeUnique<FFlowNodeTickFunction>());
+	TickFunction.Subsystem = this;
+	TickFunction.TickGroup = TickGroup;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = false;
+	return TickFunction;
+}
+
+void UFlowSubsystem::RegisterTickableNode(UFlowNodeTickable* Node)
+{
+	UWorld* World = GetWorld();
+	if (Node == nullptr || World == nullptr || World->PersistentLevel == nullptr)
+	{
+		return;
+	}
+
+	FFlowNodeTickFunction& TickFunction = FindOrAddNodeTickFunction(Node->TickGroup);
+
+	// tick functions are unregistered together with the level, i.e. after the world travel
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	// only a few node classes tick, so the linear search is fine
+	int32 BucketIndex = TickFunction.Buckets.IndexOfByPredicate([Node](const FFlowNodeTickBucket& Bucket)
+	{
+		return Bucket.NodeClass == Node->GetClass();
+	});
+	if (BucketIndex == INDEX_NONE)
+	{
+		BucketIndex = TickFunction.Buckets.AddDefaulted();
+		TickFunction.Buckets[BucketIndex].NodeClass = Node->GetClass();
+	}
+
+	Node->RegisteredTickGroup = TickFunction.TickGroup;
+	Node->TickBucketIndex = BucketIndex;
+	Node->TickEntryIndex = TickFunction.Buckets[BucketIndex].Entries.Add({Node, 0.0f});
+
+	TickFunction.NodesNum++;
+	INC_DWORD_STAT(STAT_FlowTickableNodes);
+
+	if (!TickFunction.IsTickFunctionEnabled())
+	{
+		TickFunction.SetTickFunctionEnable(true);
+	}
+}
+
+void UFlowSubsystem::UnregisterTickableNode(UFlowNodeTickable* Node)
+{
+	const TUniquePtr<FFlowNodeTickFunction>* TickFunctionPtr = NodeTickFunctions.FindByPredicate([Node](const TUniquePtr<FFlowNodeTickFunction>& TickFunction)
+	{
+		return TickFunction->TickGroup == Node->RegisteredTickGroup;
+	});
+	if (TickFunctionPtr == nullptr || !(*TickFunctionPtr)->Buckets.IsValidIndex(Node->TickBucketIndex))
+	{
+		return;
+	}
+
+	FFlowNodeTickFunction& TickFunction = **TickFunctionPtr;
+	TArray<FFlowNodeTickEntry>& Entries = TickFunction.Buckets[Node->TickBucketIndex].Entries;
+	const int32 EntryIndex = Node->TickEntryIndex;
+	if (!Entries.IsValidIndex(EntryIndex) || Entries[EntryIndex].Node != Node)
+	{
+		return;
+	}
+
+	TickFunction.NodesNum--;
+	DEC_DWORD_STAT(STAT_FlowTickableNodes);
+
+	if (TickFunction.bTicking)
+	{
+		// indices of entries have to stay until the tick ends
+		Entries[EntryIndex].Node.Reset();
+		TickFunction.bPendingCompaction = true;
+		return;
+	}
+
+	Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	if (Entries.IsValidIndex(EntryIndex))
+	{
+		if (UFlowNodeTickable* MovedNode = Entries[EntryIndex].Node.Get())
+		{
+			MovedNode->TickEntryIndex = EntryIndex;
+		}
+	}
+
+	if (TickFunction.NodesNum <= 0)
+	{
+		TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void UFlowSubsystem::TickNodes(FFlowNodeTickFunction& TickFunction, const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowTickNodes);
+
+	TickFunction.bTicking = true;
+
+	// nodes registered while ticking wait for the next frame
+	const int32 BucketsNum = TickFunction.Buckets.Num();
+	for (int32 BucketIndex = 0; BucketIndex < BucketsNum; ++BucketIndex)
+	{
+		const int32 EntriesNum = TickFunction.Buckets[BucketIndex].Entries.Num();
+		for (int32 EntryIndex = 0; EntryIndex < EntriesNum; ++EntryIndex)
+		{
+			// accessed by index, as ticked nodes might register other nodes and reallocate the list
+			FFlowNodeTickEntry& Entry = TickFunction.Buckets[BucketIndex].Entries[EntryIndex];
+			UFlowNodeTickable* Node = Entry.Node.Get();
+			if (Node == nullptr)
+			{
+				TickFunction.bPendingCompaction = true;
+				continue;
+			}
+
+			Entry.AccumulatedTime += DeltaTime;
+			if (Entry.AccumulatedTime < Node->TickInterval)
+			{
+				continue;
+			}
+
+			const float NodeDeltaTime = Entry.AccumulatedTime;
+			Entry.AccumulatedTime = 0.0f;
+
+			Node->TickNode(NodeDeltaTime);
+		}
+	}
+
+	TickFunction.bTicking = false;
+
+	if (TickFunction.bPendingCompaction)
+	{
+		CompactNodeTickFunction(TickFunction);
+	}
+
+	if (TickFunction.NodesNum <= 0)
+	{
+		TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void UFlowSubsystem::CompactNodeTickFunction(FFlowNodeTickFunction& TickFunction)
+{
+	// also drops entries of nodes destroyed without unregistering, so the count is rebuilt
+	int32 NodesNum = 0;
+	for (FFlowNodeTickBucket& Bucket : TickFunction.Buckets)
+	{
+		Bucket.Entries.RemoveAll([](const FFlowNodeTickEntry& Entry)
+		{
+			return !Entry.Node.IsValid();
+		});
+
+		for (int32 EntryIndex = 0; EntryIndex < Bucket.Entries.Num(); ++EntryIndex)
+		{
+			Bucket.Entries[EntryIndex].Node->TickEntryIndex = EntryIndex;
+		}
+
+		NodesNum += Bucket.Entries.Num();
+	}
+
+	DEC_DWORD_STAT_BY(STAT_FlowTickableNodes, TickFunction.NodesNum - NodesNum);
+	TickFunction.NodesNum = NodesNum;
+	TickFunction.bPendingCompaction = false;
+}
+
+void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowSaveGame);
+	CSV_SCOPED_TIMING_STAT(Flow, SaveGame);
+
+	// clear existing data, in case we received reused SaveGame instance
+	// we only remove data for the current world + global Flow Graph instances (i.e. not bound to any world if created by UGameInstanceSubsystem)
+	// we keep data bound to other worlds
+	if (GetWorld())
+	{
+		const FString& WorldName = GetWorld()->GetName();
+
+		// single pass compacting the arrays, instead of shifting them on every removed record
+		SaveGame->FlowInstances.RemoveAll([&WorldName](const FFlowAssetSaveData& AssetRecord)
+		{
+			return AssetRecord.WorldName.IsEmpty() || AssetRecord.WorldName == WorldName;
+		});
+
+		SaveGame->FlowComponents.RemoveAll([&WorldName](const FFlowComponentSaveData& ComponentRecord)
+		{
+			return ComponentRecord.WorldName.IsEmpty() || ComponentRecord.WorldName == WorldName;
+		});
+
+		SaveGame->FlowLevels.RemoveAll([&WorldName](const FFlowLevelSaveData& LevelRecord)
+		{
+			return LevelRecord.WorldName.IsEmpty() || LevelRecord.WorldName == WorldName;
+		});
+	}
+
+	// records of other worlds have been kept above, so objects living in another world mustn't be saved again
+	// objects without a world (i.e. owned by the Game Instance) are always saved, their records have been cleared above
+	const UWorld* SaveWorld = GetWorld();
+	auto IsInOtherWorld = [SaveWorld](const UObject* Object)
+	{
+		const UWorld* ObjectWorld = Object ? Object->GetWorld() : nullptr;
+		return SaveWorld && ObjectWorld && ObjectWorld != SaveWorld;
+	};
+
+	// records of actors placed in streaming levels, by the level name
+	const bool bGroupByLevel = UFlowSettings::Get()->bGroupSaveGameByLevel && GetWorld();
+	TMap<FString, FFlowLevelRecords> LevelRecords;
+	TMap<FString, TArray<int32>> LevelInstanceIndices;
+
+	// save Flow Graphs
+	bCollectingParallelSaves = UFlowSettings::Get()->bParallelSaveGame;
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : ObjectPtrDecay(RootInstances))
+	{
+		if (RootInstance.Key && RootInstance.Value.IsValid() && !IsInOtherWorld(RootInstance.Value.Get()))
+		{
+			if (UFlowComponent* FlowComponent = Cast<UFlowComponent>(RootInstance.Value))
+			{
+				const int32 FirstRecordIndex = SaveGame->FlowInstances.Num();
+				FlowComponent->SaveRootFlow(SaveGame->FlowInstances);
+
+				// root flow and its SubGraphs are grouped with the component
+				const FString LevelName = bGroupByLevel && FlowComponent->GetOwner() ? GetSaveLevelName(FlowComponent->GetOwner()->GetLevel()) : FString();
+				if (!LevelName.IsEmpty())
+				{
+					TArray<int32>& RecordIndices = LevelInstanceIndices.FindOrAdd(LevelName);
+					for (int32 RecordIndex = FirstRecordIndex; RecordIndex < SaveGame->FlowInstances.Num(); RecordIndex++)
+					{
+						RecordIndices.Add(RecordIndex);
+					}
+				}
+			}
+			else
+			{
+				RootInstance.Key->SaveInstance(SaveGame->FlowInstances);
+			}
+		}
+	}
+	bCollectingParallelSaves = false;
+
+	// every instance writes only its own placeholder record, all OnSave() hooks have already run on the game thread
+	if (PendingParallelSaves.Num() > 0)
+	{
+		ParallelFor(PendingParallelSaves.Num(), [this](const int32 Index)
+		{
+			const FFlowAssetPendingSave& PendingSave = PendingParallelSaves[Index];
+			PendingSave.Instance->SerializeSaveInstance(PendingSave);
+		});
+
+		PendingParallelSaves.Reset();
+	}
+
+	// save Flow Components
+	{
+		// every registered component has a single slot, write archives to SaveGame
+		for (const FFlowComponentRegistrySlot& Slot : ComponentSlots)
+		{
+			if (SaveWorld && Slot.World != TObjectKey<UWorld>() && Slot.World != TObjectKey<UWorld>(SaveWorld))
+			{
+				continue;
+			}
+
+			if (Slot.Component && !Slot.Component->HasSaveGameState())
+			{
+				INC_DWORD_STAT(STAT_FlowSkippedComponentSaves);
+			}
+			else if (Slot.Component)
+			{
+				const FString LevelName = bGroupByLevel && Slot.Component->GetOwner() ? GetSaveLevelName(Slot.Component->GetOwner()->GetLevel()) : FString();
+				if (LevelName.IsEmpty())
+				{
+					SaveGame->FlowComponents.Emplace(Slot.Component->SaveInstance());
+				}
+				else
+				{
+					LevelRecords.FindOrAdd(LevelName).FlowComponents.Emplace(Slot.Component->SaveInstance());
+				}
+			}
+		}
+	}
+
+	// move grouped Flow Graph records out of the flat array, after their serialization finished
+	if (LevelInstanceIndices.Num() > 0)
+	{
+		TBitArray<> GroupedRecords(false, SaveGame->FlowInstances.Num());
+		for (TPair<FString, TArray<int32>>& LevelIndices : LevelInstanceIndices)
+		{
+			TArray<FFlowAssetSaveData>& LevelInstances = LevelRecords.FindOrAdd(LevelIndices.Key).FlowInstances;
+			for (const int32 RecordIndex : LevelIndices.Value)
+			{
+				LevelInstances.Emplace(MoveTemp(SaveGame->FlowInstances[RecordIndex]));
+				GroupedRecords[RecordIndex] = true;
+			}
+		}
+
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < SaveGame->FlowInstances.Num(); ReadIndex++)
+		{
+			if (!GroupedRecords[ReadIndex])
+			{
+				if (WriteIndex != ReadIndex)
+				{
+					SaveGame->FlowInstances[WriteIndex] = MoveTemp(SaveGame->FlowInstances[ReadIndex]);
+				}
+				WriteIndex++;
+			}
+		}
+		SaveGame->FlowInstances.SetNum(WriteIndex);
+	}
+
+	for (TPair<FString, FFlowLevelRecords>& Level : LevelRecords)
+	{
+		FFlowLevelSaveData& LevelRecord = SaveGame->FlowLevels.AddDefaulted_GetRef();
+		LevelRecord.WorldName = GetWorld()->GetName();
+		LevelRecord.LevelName = Level.Key;
+		LevelRecord.Encode(Level.Value);
+	}
+
+	// records moved, if the same SaveGame instance has been loaded and saved
+	if (SaveGame == LoadedSaveGame)
+	{
+		LoadedLevelRecords.Reset();
+		BuildLoadedSaveGameIndex();
+	}
+}
+
+void UFlowSubsystem::AsyncSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, const FNativeFlowSaveGameWritten& OnWritten)
+{
+	check(SaveGame);
+
+	const FString SlotSaveKey = GetSlotSaveKey(SaveGame->SaveSlotName, UserIndex);
+	if (SlotSavesInProgress.Contains(SlotSaveKey))
+	{
+		// the write in progress would be overwritten anyway, so only the latest request is snapshotted after it
+		FFlowQueuedSlotSave& QueuedSave = QueuedSlotSaves.FindOrAdd(SlotSaveKey);
+		QueuedSave.SaveGame = SaveGame;
+		QueuedSave.UserIndex = UserIndex;
+		QueuedSave.OnWritten.Add(OnWritten);
+		return;
+	}
+
+	StartSaveGameToSlot(SaveGame, UserIndex, {OnWritten});
+}
+
+bool UFlowSubsystem::IsSavingToSlot(const FString& SlotName, const int32 UserIndex) const
+{
+	return SlotSavesInProgress.Contains(GetSlotSaveKey(SlotName, UserIndex));
+}
+
+void UFlowSubsystem::StartSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, TArray<FNativeFlowSaveGameWritten>&& OnWritten)
+{
+	SlotSavesInProgress.Add(GetSlotSaveKey(SaveGame->SaveSlotName, UserIndex));
+
+	// node and asset data are serialized into plain byte buffers here, reusing unchanged data if incremental SaveGame is enabled
+	OnGameSaved(SaveGame);
+
+	// SaveGame object is converted to memory right away, so it can be modified again before the worker task writes it
+	TWeakObjectPtr<UFlowSubsystem> WeakSubsystem(this);
+	UGameplayStatics::AsyncSaveGameToSlot(SaveGame, SaveGame->SaveSlotName, UserIndex,
+		FAsyncSaveGameToSlotDelegate::CreateLambda([WeakSubsystem, OnWritten = MoveTemp(OnWritten)](const FString& SlotName, const int32 InUserIndex, const bool bSuccess)
+		{
+			if (UFlowSubsystem* Subsystem = WeakSubsystem.Get())
+			{
+				Subsystem->OnSaveGameToSlotWritten(SlotName, InUserIndex, bSuccess, OnWritten);
+			}
+			else
+			{
+				for (const FNativeFlowSaveGameWritten& Callback : OnWritten)
+				{
+					Callback.ExecuteIfBound(bSuccess);
+				}
+			}
+		}));
+}
+
+void UFlowSubsystem::OnSaveGameToSlotWritten(const FString& SlotName, const int32 UserIndex, const bool bSuccess, TArray<FNativeFlowSaveGameWritten> OnWritten)
+{
+	const FString SlotSaveKey = GetSlotSaveKey(SlotName, UserIndex);
+	SlotSavesInProgress.Remove(SlotSaveKey);
+
+	for (const FNativeFlowSaveGameWritten& Callback : OnWritten)
+	{
+		Callback.ExecuteIfBound(bSuccess);
+	}
+
+	FFlowQueuedSlotSave QueuedSave;
+	if (QueuedSlotSaves.RemoveAndCopyValue(SlotSaveKey, QueuedSave) && QueuedSave.SaveGame)
+	{
+		StartSaveGameToSlot(QueuedSave.SaveGame, QueuedSave.UserIndex, MoveTemp(QueuedSave.OnWritten));
+	}
+}
+
+bool UFlowSubsystem::HasComponentClassSaveGameState(const UClass* ComponentClass)
+{
+	if (const bool* bCachedState = ComponentClassSaveGameStates.Find(ComponentClass))
+	{
+		return *bCachedState;
+	}
+
+	// SaveGame properties of UFlowComponent itself only store the Root Flow instance
+	bool bHasState = ComponentClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UFlowComponent, OnSave))
+		|| ComponentClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UFlowComponent, OnLoad));
+
+	for (TFieldIterator<FProperty> It(ComponentClass); It && !bHasState; ++It)
+	{
+		bHasState = It->HasAnyPropertyFlags(CPF_SaveGame) && It->GetOwnerClass() != UFlowComponent::StaticClass();
+	}
+
+	ComponentClassSaveGameStates.Add(ComponentClass, bHasState);
+	return bHasState;
+}
+
+bool UFlowSubsystem::TryDeferSaveSerialization(TArray<FFlowAssetPendingSave>& PendingSaves)
+{
+	if (!bCollectingParallelSaves)
+	{
+		return false;
+	}
+
+	PendingParallelSaves.Append(MoveTemp(PendingSaves));
+	return true;
+}
+
+void UFlowSubsystem::OnGameLoaded(UFlowSaveGame* SaveGame)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowLoadGame);
+	CSV_SCOPED_TIMING_STAT(Flow, LoadGame);
+
+	LoadedSaveGame = SaveGame;
+	LoadedLevelRecords.Reset();
+	BuildLoadedSaveGameIndex();
+
+	// here's opportunity to apply loaded data to custom systems
+	// it's recommended to do this by overriding method in the subclass
+}
+
+void UFlowSubsystem::BuildLoadedSaveGameIndex()
+{
+	LoadedFlowInstanceRecords.Reset();
+	LoadedFlowInstanceRecordsById.Reset();
+	LoadedFlowComponentRecords.Reset();
+
+	if (LoadedSaveGame == nullptr)
+	{
+		return;
+	}
+
+	AddToLoadedSaveGameIndex(LoadedSaveGame->FlowInstances, LoadedSaveGame->FlowComponents);
+
+	for (const TPair<FString, FFlowLevelRecords>& Level : LoadedLevelRecords)
+	{
+		AddToLoadedSaveGameIndex(Level.Value.FlowInstances, Level.Value.FlowComponents);
+	}
+}
+
+void UFlowSubsystem::AddToLoadedSaveGameIndex(const TArray<FFlowAssetSaveData>& FlowInstances, const TArray<FFlowComponentSaveData>& FlowComponents)
+{
+	for (const FFlowAssetSaveData& AssetRecord : FlowInstances)
+	{
+		if (AssetRecord.InstanceId != 0)
+		{
+			LoadedFlowInstanceRecordsById.FindOrAdd(AssetRecord.InstanceId).Add(&AssetRecord);
+		}
+		else
+		{
+			LoadedFlowInstanceRecords.FindOrAdd(AssetRecord.InstanceName).Add(&AssetRecord);
+		}
+	}
+
+	// the first record wins, as in the linear search
+	for (const FFlowComponentSaveData& ComponentRecord : FlowComponents)
+	{
+		LoadedFlowComponentRecords.FindOrAdd(TPair<FString, FString>(ComponentRecord.WorldName, ComponentRecord.ActorInstanceName), &ComponentRecord);
+	}
+}
+
+const FFlowAssetSaveData* UFlowSubsystem::FindLoadedFlowInstance(const FString& InstanceName, const FString& WorldName) const
+{
+	if (const TArray<const FFlowAssetSaveData*>* AssetRecords = LoadedSaveGame ? LoadedFlowInstanceRecords.Find(InstanceName) : nullptr)
+	{
+		for (const FFlowAssetSaveData* AssetRecord : *AssetRecords)
+		{
+			if (WorldName.IsEmpty() || AssetRecord->WorldName == WorldName)
+			{
+				return AssetRecord;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+const FFlowAssetSaveData* UFlowSubsystem::FindLoadedFlowInstanceById(const uint64 InstanceId, const FString& WorldName) const
+{
+	if (const TArray<const FFlowAssetSaveData*>* AssetRecords = LoadedSaveGame ? LoadedFlowInstanceRecordsById.Find(InstanceId) : nullptr)
+	{
+		for (const FFlowAssetSaveData* AssetRecord : *AssetRecords)
+		{
+			if (WorldName.IsEmpty() || AssetRecord->WorldName == WorldName)
+			{
+				return AssetRecord;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+const FFlowComponentSaveData* UFlowSubsystem::FindLoadedFlowComponent(const FString& WorldName, const FString& ActorInstanceName) const
+{
+	if (const FFlowComponentSaveData* const* ComponentRecord = LoadedSaveGame ? LoadedFlowComponentRecords.Find(TPair<FString, FString>(WorldName, ActorInstanceName)) : nullptr)
+	{
+		return *ComponentRecord;
+	}
+
+	return nullptr;
+}
+
+void UFlowSubsystem::LoadLevelSaveData(const ULevel* Level)
+{
+	if (LoadedSaveGame == nullptr || LoadedSaveGame->FlowLevels.Num() == 0 || GetWorld() == nullptr)
+	{
+		return;
+	}
+
+	const FString LevelName = GetSaveLevelName(Level);
+	if (LevelName.IsEmpty() || LoadedLevelRecords.Contains(LevelName))
+	{
+		return;
+	}
+
+	// empty groups are kept as well, so the records aren't searched again until the level is removed
+	FFlowLevelRecords& Records = LoadedLevelRecords.Add(LevelName);
+
+	const FString& WorldName = GetWorld()->GetName();
+	for (const FFlowLevelSaveData& LevelRecord : LoadedSaveGame->FlowLevels)
+	{
+		if (LevelRecord.LevelName == LevelName && (LevelRecord.WorldName.IsEmpty() || LevelRecord.WorldName == WorldName))
+		{
+			LevelRecord.Decode(Records);
+		}
+	}
+
+	AddToLoadedSaveGameIndex(Records.FlowInstances, Records.FlowComponents);
+}
+
+FString UFlowSubsystem::GetSaveLevelName(const ULevel* Level)
+{
+	if (Level == nullptr || Level->IsPersistentLevel())
+	{
+		return FString();
+	}
+
+	return UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName());
+}
+
+void UFlowSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	// nullptr level means all levels are removed
+	if (Level == nullptr)
+	{
+		if (LoadedLevelRecords.Num() > 0)
+		{
+			LoadedLevelRecords.Reset();
+			BuildLoadedSaveGameIndex();
+		}
+		return;
+	}
+
+	if (World == GetWorld() && LoadedLevelRecords.Remove(GetSaveLevelName(Level)) > 0)
+	{
+		BuildLoadedSaveGameIndex();
+	}
+}
+
+void UFlowSubsystem::LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName, const bool bAllowMultipleInstances)
+{
+	if (FlowAsset == nullptr || SavedAssetInstanceName.IsEmpty())
+	{
+		return;
+	}
+
+	const FString WorldName = FlowAsset->IsBoundToWorld() ? GetWorld()->GetName() : FString();
+	if (const FFlowAssetSaveData* AssetRecord = FindLoadedFlowInstance(SavedAssetInstanceName, WorldName))
+	{
+		UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, bAllowMultipleInstances);
+		if (LoadedInstance)
+		{
+			LoadedInstance->LoadInstance(*AssetRecord);
+		}
+	}
+}
+
+void UFlowSubsystem::LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedAssetInstanceName)
+{
+	if (SubGraphNode->Asset.IsNull())
+	{
+		return;
+	}
+
+	UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
+
+	const FString WorldName = (SubGraphAsset && SubGraphAsset->IsBoundToWorld() == false) ? FString() : GetWorld()->GetName();
+	if (const FFlowAssetSaveData* AssetRecord = FindLoadedFlowInstance(SavedAssetInstanceName, WorldName))
+	{
+		UFlowAsset* LoadedInstance = CreateSubFlow(SubGraphNode, SavedAssetInstanceName);
+		if (LoadedInstance)
+		{
+			LoadedInstance->LoadInstance(*AssetRecord);
+		}
+	}
+}
+
+void UFlowSubsystem::LoadRootFlowById(UObject* Owner, UFlowAsset* FlowAsset, const uint64 SavedAssetInstanceId, const bool bAllowMultipleInstances)
+{
+	if (FlowAsset == nullptr || SavedAssetInstanceId == 0)
+	{
+		return;
+	}
+
+	const FString WorldName = FlowAsset->IsBoundToWorld() ? GetWorld()->GetName() : FString();
+	if (const FFlowAssetSaveData* AssetRecord = FindLoadedFlowInstanceById(SavedAssetInstanceId, WorldName))
+	{
+		UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, bAllowMultipleInstances);
+		if (LoadedInstance)
+		{
+			RestoreInstanceId(*LoadedInstance, SavedAssetInstanceId);
+			LoadedInstance->LoadInstance(*AssetRecord);
+		}
+	}
+}
+
+void UFlowSubsystem::LoadSubFlowById(UFlowNode_SubGraph* SubGraphNode, const uint64 SavedAssetInstanceId)
+{
+	if (SubGraphNode->Asset.IsNull() || SavedAssetInstanceId == 0)
+	{
+		return;
+	}
+
+	UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
+
+	const FString WorldName = (SubGraphAsset && SubGraphAsset->IsBoundToWorld() == false) ? FString() : GetWorld()->GetName();
+	if (const FFlowAssetSaveData* AssetRecord = FindLoadedFlowInstanceById(SavedAssetInstanceId, WorldName))
+	{
+		UFlowAsset* LoadedInstance = CreateSubFlow(SubGraphNode, FString(), false, true);
+		if (LoadedInstance)
+		{
+			RestoreInstanceId(*LoadedInstance, SavedAssetInstanceId);
+			LoadedInstance->LoadInstance(*AssetRecord);
+		}
+	}
+}
+
+void UFlowSubsystem::LoadReplayFlowState(UObject* Owner, UFlowAsset* FlowAsset, const uint64 RootInstanceId, TArray<FFlowAssetSaveData>&& FlowInstances)
+{
+	// scrubbing jumps to the recorded state, the running instance isn't advanced from its previous state
+	FinishRootFlow(Owner, FlowAsset, EFlowFinishPolicy::Abort);
+
+	if (RootInstanceId == 0 || FlowInstances.IsEmpty())
+	{
+		return;
+	}
+
+	UFlowSaveGame* ReplaySaveGame = NewObject<UFlowSaveGame>(this);
+	ReplaySaveGame->FlowInstances = MoveTemp(FlowInstances);
+
+	// loaded through the SaveGame index, so Sub Graphs find their records as well
+	{
+		TGuardValue<TObjectPtr<UFlowSaveGame>> SaveGameGuard(LoadedSaveGame, ReplaySaveGame);
+		BuildLoadedSaveGameIndex();
+		LoadRootFlowById(Owner, FlowAsset, RootInstanceId, true);
+	}
+
+	BuildLoadedSaveGameIndex();
+}
+
+namespace FlowComponentRegistry
+{
+	template <typename KeyType>
+	void RemoveSlotFromBucket(TMap<KeyType, TArray<int32>>& Buckets, const KeyType& Key, const int32 SlotIndex)
+	{
+		if (TArray<int32>* Bucket = Buckets.Find(Key))
+		{
+			Bucket->RemoveSingleSwap(SlotIndex, EAllowShrinking::No);
+
+			if (Bucket->IsEmpty())
+			{
+				Buckets.Remove(Key);
+			}
+		}
+	}
+
+	bool IsSlotMatchingTag(const FFlowComponentRegistrySlot& Slot, const FGameplayTag& Tag, const bool bExactMatch)
+	{
+		return bExactMatch ? Slot.RegisteredTags.HasTagExact(Tag) : Slot.RegisteredTags.HasTag(Tag);
+	}
+
+	bool IsSlotInsideRegion(const FFlowComponentRegistrySlot& Slot, const FFlowComponentRegionListener& Region)
+	{
+		return Slot.Component && !Slot.RegisteredTags.IsEmpty()
+			&& (Region.Tags.IsEmpty() || FlowTypes::HasMatchingTags(Slot.RegisteredTags, Region.Tags, Region.MatchType))
+			&& FVector::DistSquared(Slot.Location, Region.Center) <= FMath::Square(Region.Radius);
+	}
+}
+
+void UFlowSubsystem::AddToComponentRegistry(const FGameplayTag& Tag, UFlowComponent* Component)
+{
+	const int32* ExistingSlotIndex = ComponentSlotIndices.Find(Component);
+	const int32 SlotIndex = ExistingSlotIndex ? *ExistingSlotIndex : AcquireComponentSlot(Component);
+
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+	if (Slot.RegisteredTags.HasTagExact(Tag))
+	{
+		return;
+	}
+
+	ComponentSlotsPerTag.FindOrAdd(Tag).Add(SlotIndex);
+
+	FFlowComponentRegistryShard* Shard = bShardRegistryByWorld ? RegistryShards.Find(Slot.World) : nullptr;
+	if (Shard)
+	{
+		Shard->ComponentSlotsPerTag.FindOrAdd(Tag).Add(SlotIndex);
+	}
+
+	// tag itself and all of its parents, unless component is already there through its other tags
+	for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		if (!Slot.RegisteredTags.HasTag(ParentTag))
+		{
+			ComponentSlotsUnderTag.FindOrAdd(ParentTag).Add(SlotIndex);
+
+			if (Shard)
+			{
+				Shard->ComponentSlotsUnderTag.FindOrAdd(ParentTag).Add(SlotIndex);
+			}
+		}
+	}
+
+	if (bPartitionRegistryByClass)
+	{
+		ComponentSlotsPerClass.FindOrAdd(Tag).FindOrAdd(Slot.ComponentClass).Add(SlotIndex);
+	}
+
+	Slot.RegisteredTags.AddTag(Tag);
+	MarkRegistrySnapshotDirty();
+
+	if (LiveQueries.Num() > 0)
+	{
+		RefreshLiveQueries(SlotIndex, Tag);
+	}
+
+	if (ComponentRegions.Num() > 0)
+	{
+		RefreshComponentRegions(SlotIndex, Slot.Cell);
+	}
+}
+
+void UFlowSubsystem::RemoveFromComponentRegistry(const FGameplayTag& Tag, UFlowComponent* Component)
+{
+	if (const int32* SlotIndex = ComponentSlotIndices.Find(Component))
+	{
+		RemoveSlotTag(*SlotIndex, Tag);
+	}
+}
+
+void UFlowSubsystem::RemoveSlotTag(const int32 SlotIndex, const FGameplayTag& Tag)
+{
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+	if (!Slot.RegisteredTags.RemoveTag(Tag))
+	{
+		return;
+	}
+	MarkRegistrySnapshotDirty();
+
+	FlowComponentRegistry::RemoveSlotFromBucket(ComponentSlotsPerTag, Tag, SlotIndex);
+
+	FFlowComponentRegistryShard* Shard = bShardRegistryByWorld ? RegistryShards.Find(Slot.World) : nullptr;
+	if (Shard)
+	{
+		FlowComponentRegistry::RemoveSlotFromBucket(Shard->ComponentSlotsPerTag, Tag, SlotIndex);
+	}
+
+	// component might be still registered under the same parent through its other tags
+	for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		if (!Slot.RegisteredTags.HasTag(ParentTag))
+		{
+			FlowComponentRegistry::RemoveSlotFromBucket(ComponentSlotsUnderTag, ParentTag, SlotIndex);
+
+			if (Shard)
+			{
+				FlowComponentRegistry::RemoveSlotFromBucket(Shard->ComponentSlotsUnderTag, ParentTag, SlotIndex);
+			}
+		}
+	}
+
+	if (bPartitionRegistryByClass)
+	{
+		if (TMap<const UClass*, TArray<int32>>* ClassPartitions = ComponentSlotsPerClass.Find(Tag))
+		{
+			FlowComponentRegistry::RemoveSlotFromBucket(*ClassPartitions, Slot.ComponentClass, SlotIndex);
+
+			if (ClassPartitions->IsEmpty())
+			{
+				ComponentSlotsPerClass.Remove(Tag);
+			}
+		}
+	}
+
+	if (LiveQueries.Num() > 0)
+	{
+		RefreshLiveQueries(SlotIndex, Tag);
+	}
+
+	if (ComponentRegions.Num() > 0)
+	{
+		RefreshComponentRegions(SlotIndex, Slot.Cell);
+	}
+
+	if (Slot.RegisteredTags.IsEmpty())
+	{
+		ReleaseComponentSlot(SlotIndex);
+	}
+}
+
+int32 UFlowSubsystem::AcquireComponentSlot(UFlowComponent* Component)
+{
+	const int32 SlotIndex = FreeComponentSlots.IsEmpty() ? ComponentSlots.AddDefaulted() : FreeComponentSlots.Pop(EAllowShrinking::No);
+
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+	Slot.Component = Component;
+	Slot.ComponentKey = Component;
+	Slot.ComponentClass = Component->GetClass();
+	Slot.World = Component->GetWorld();
+
+	ComponentSlotIndices.Add(Slot.ComponentKey, SlotIndex);
+
+	if (bShardRegistryByWorld)
+	{
+		RegistryShards.FindOrAdd(Slot.World).ComponentsNum++;
+	}
+
+	if (bSpatialRegistry)
+	{
+		AddToSpatialRegistry(SlotIndex);
+	}
+
+	return SlotIndex;
+}
+
+void UFlowSubsystem::ReleaseComponentSlot(const int32 SlotIndex)
+{
+	if (bSpatialRegistry)
+	{
+		RemoveFromSpatialRegistry(SlotIndex);
+	}
+
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+	ComponentSlotIndices.Remove(Slot.ComponentKey);
+
+	if (bShardRegistryByWorld)
+	{
+		FFlowComponentRegistryShard* Shard = RegistryShards.Find(Slot.World);
+		if (Shard && --Shard->ComponentsNum <= 0)
+		{
+			RegistryShards.Remove(Slot.World);
+		}
+	}
+
+	Slot.Component = nullptr;
+	Slot.ComponentKey = TObjectKey<UFlowComponent>();
+	Slot.ComponentClass = nullptr;
+	Slot.World = TObjectKey<UWorld>();
+	Slot.RegisteredTags.Reset();
+	++Slot.Generation;
+
+	FreeComponentSlots.Add(SlotIndex);
+}
+
+void UFlowSubsystem::RemoveStaleComponents()
+{
+	for (int32 SlotIndex = 0; SlotIndex < ComponentSlots.Num(); ++SlotIndex)
+	{
+		FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+		if (Slot.Component == nullptr && !Slot.RegisteredTags.IsEmpty())
+		{
+			// copy, as removing the last tag releases the slot
+			const FGameplayTagContainer StaleTags = Slot.RegisteredTags;
+			for (const FGameplayTag& Tag : StaleTags)
+			{
+				RemoveSlotTag(SlotIndex, Tag);
+			}
+		}
+	}
+
+	DispatchRegistryEvents();
+}
+
+void UFlowSubsystem::OnPostGarbageCollect()
+{
+	if (!StaleComponentsTickerHandle.IsValid() && ComponentSlots.Num() > FreeComponentSlots.Num())
+	{
+		StaleComponentsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickRemoveStaleComponents));
+	}
+}
+
+bool UFlowSubsystem::TickRemoveStaleComponents(float DeltaTime)
+{
+	StaleComponentsTickerHandle.Reset();
+	RemoveStaleComponents();
+
+	return false;
+}
+
+FFlowComponentHandle UFlowSubsystem::GetComponentHandle(const UFlowComponent* Component) const
+{
+	FFlowComponentHandle Handle;
+	if (const int32* SlotIndex = ComponentSlotIndices.Find(Component))
+	{
+		Handle.SlotIndex = *SlotIndex;
+		Handle.Generation = ComponentSlots[*SlotIndex].Generation;
+	}
+
+	return Handle;
+}
+
+UFlowComponent* UFlowSubsystem::ResolveComponentHandle(const FFlowComponentHandle& Handle) const
+{
+	if (ComponentSlots.IsValidIndex(Handle.SlotIndex) && ComponentSlots[Handle.SlotIndex].Generation == Handle.Generation)
+	{
+		return ComponentSlots[Handle.SlotIndex].Component;
+	}
+
+	return nullptr;
+}
+
+bool UFlowSubsystem::VisitComponentSlots(const TArray<int32>& SlotIndices, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		UFlowComponent* Component = ComponentSlots[SlotIndex].Component;
+		if (Component && !Function(*Component))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UFlowSubsystem::BroadcastComponentRegistered(UFlowComponent* Component)
+{
+	DispatchRegistryEvents();
+
+	if (IsComponentRegistrationBatched())
+	{
+		bool bAlreadyPending = false;
+		PendingRegisteredComponentsSet.Add(Component, &bAlreadyPending);
+		if (!bAlreadyPending)
+		{
+			PendingRegisteredComponents.Add(Component);
+		}
+
+		if (ComponentRegistrationBatchDepth == 0)
+		{
+			ScheduleComponentRegistrationBatch();
+		}
+		return;
+	}
+
+	NotifyComponentListeners(Component->IdentityTags, [Component](const FFlowComponentListener& Listener)
+	{
+		Listener.OnComponentsRegistered.ExecuteIfBound({Component});
+	});
+
+	if (OnComponentsRegisteredNative.IsBound() || OnComponentsRegistered.IsBound())
+	{
+		const TArray<UFlowComponent*> RegisteredComponents = {Component};
+		OnComponentsRegisteredNative.Broadcast(RegisteredComponents);
+		OnComponentsRegistered.Broadcast(RegisteredComponents);
+	}
+
+	OnComponentRegisteredNative.Broadcast(Component);
+	OnComponentRegistered.Broadcast(Component);
+}
+
+void UFlowSubsystem::BeginComponentRegistrationBatch()
+{
+	++ComponentRegistrationBatchDepth;
+}
+
+void UFlowSubsystem::EndComponentRegistrationBatch()
+{
+	check(ComponentRegistrationBatchDepth > 0);
+
+	if (--ComponentRegistrationBatchDepth == 0)
+	{
+		if (bBatchRegistrationPerFrame)
+		{
+			// components registered inside the scope didn't schedule the per-frame flush
+			ScheduleComponentRegistrationBatch();
+		}
+		else
+		{
+			FlushComponentRegistrationBatch();
+		}
+	}
+}
+
+void UFlowSubsystem::ScheduleComponentRegistrationBatch()
+{
+	if (!PendingRegisteredComponents.IsEmpty() && !ComponentRegistrationBatchHandle.IsValid())
+	{
+		ComponentRegistrationBatchHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickComponentRegistrationBatch));
+	}
+}
+
+void UFlowSubsystem::FlushComponentRegistrationBatch()
+{
+	DispatchRegistryEvents();
+
+	if (PendingRegisteredComponents.IsEmpty())
+	{
+		return;
+	}
+
+	// listeners might register components while handling the batch, these go to the next batch
+	TArray<UFlowComponent*> RegisteredComponents = ObjectPtrDecay(PendingRegisteredComponents);
+	TSet<const UFlowComponent*> PendingComponents = MoveTemp(PendingRegisteredComponentsSet);
+	PendingRegisteredComponents.Reset();
+	PendingRegisteredComponentsSet.Reset();
+
+	// component might have unregistered, lost all its tags in the meantime or been destroyed without unregistering
+	// removing from the set also skips the duplicate entry of the component registered again after unregistering
+	RegisteredComponents.RemoveAll([this, &PendingComponents](const UFlowComponent* Component)
+	{
+		return Component == nullptr || PendingComponents.Remove(Component) == 0 || !ComponentSlotIndices.Contains(Component);
+	});
+
+	if (RegisteredComponents.IsEmpty())
+	{
+		return;
+	}
+
+	if (ComponentListeners.Num() > 0)
+	{
+		// every listener receives a single batch of components it might be interested in
+		TArray<TPair<int32, FDelegateHandle>> BatchListeners;
+		TArray<TArray<UFlowComponent*>> BatchComponents;
+
+		for (UFlowComponent* Component : RegisteredComponents)
+		{
+			TArray<TPair<int32, FDelegateHandle>, TInlineAllocator<16>> Listeners;
+			CollectComponentListeners(Component->IdentityTags, Listeners);
+
+			for (const TPair<int32, FDelegateHandle>& Listener : Listeners)
+			{
+				int32 BatchIndex = BatchListeners.Find(Listener);
+				if (BatchIndex == INDEX_NONE)
+				{
+					BatchIndex = BatchListeners.Add(Listener);
+					BatchComponents.AddDefaulted();
+				}
+				BatchComponents[BatchIndex].Add(Component);
+			}
+		}
+
+		for (int32 BatchIndex = 0; BatchIndex < BatchListeners.Num(); ++BatchIndex)
+		{
+			const TPair<int32, FDelegateHandle>& Listener = BatchListeners[BatchIndex];
+
+			// previous listener might have removed this one
+			if (ComponentListeners.IsValidIndex(Listener.Key) && ComponentListeners[Listener.Key].Handle == Listener.Value)
+			{
+				// copy, as the delegate might add listeners and reallocate the storage
+				const FNativeMultipleFlowComponentsEvent Delegate = ComponentListeners[Listener.Key].OnComponentsRegistered;
+				Delegate.ExecuteIfBound(BatchComponents[BatchIndex]);
+			}
+		}
+	}
+
+	OnComponentsRegisteredNative.Broadcast(RegisteredComponents);
+	OnComponentsRegistered.Broadcast(RegisteredComponents);
+
+	if (OnComponentRegisteredNative.IsBound() || OnComponentRegistered.IsBound())
+	{
+		for (UFlowComponent* Component : RegisteredComponents)
+		{
+			OnComponentRegisteredNative.Broadcast(Component);
+			OnComponentRegistered.Broadcast(Component);
+		}
+	}
+}
+
+bool UFlowSubsystem::TickComponentRegistrationBatch(float DeltaTime)
+{
+	ComponentRegistrationBatchHandle.Reset();
+	FlushComponentRegistrationBatch();
+
+	return false;
+}
+
+FDelegateHandle UFlowSubsystem::AddComponentListener(const FFlowComponentListener& Listener)
+{
+	const int32 ListenerIndex = ComponentListeners.Add(Listener);
+
+	FFlowComponentListener& AddedListener = ComponentListeners[ListenerIndex];
+	AddedListener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+
+	if (AddedListener.Tags.IsEmpty())
+	{
+		UnfilteredComponentListeners.Add(ListenerIndex);
+	}
+	else if (AddedListener.MatchType == EFlowTagContainerMatchType::HasAll || AddedListener.MatchType == EFlowTagContainerMatchType::HasAllExact)
+	{
+		// component has to match every tag, so it always matches the first one
+		ComponentListenersPerTag.FindOrAdd(AddedListener.Tags.First()).Add(ListenerIndex);
+	}
+	else
+	{
+		for (const FGameplayTag& Tag : AddedListener.Tags)
+		{
+			ComponentListenersPerTag.FindOrAdd(Tag).Add(ListenerIndex);
+		}
+	}
+
+	return AddedListener.Handle;
+}
+
+void UFlowSubsystem::RemoveComponentListener(FDelegateHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	for (auto It = ComponentListeners.CreateIterator(); It; ++It)
+	{
+		if (It->Handle == Handle)
+		{
+			const int32 ListenerIndex = It.GetIndex();
+
+			UnfilteredComponentListeners.RemoveSingleSwap(ListenerIndex, EAllowShrinking::No);
+			for (const FGameplayTag& Tag : It->Tags)
+			{
+				FlowComponentRegistry::RemoveSlotFromBucket(ComponentListenersPerTag, Tag, ListenerIndex);
+			}
+
+			It.RemoveCurrent();
+			break;
+		}
+	}
+
+	Handle.Reset();
+}
+
+void UFlowSubsystem::CollectComponentListeners(const FGameplayTagContainer& ComponentTags, TArray<TPair<int32, FDelegateHandle>, TInlineAllocator<16>>& OutListeners) const
+{
+	const auto AddListener = [this, &OutListeners](const int32 ListenerIndex)
+	{
+		OutListeners.AddUnique(TPair<int32, FDelegateHandle>(ListenerIndex, ComponentListeners[ListenerIndex].Handle));
+	};
+
+	for (const int32 ListenerIndex : UnfilteredComponentListeners)
+	{
+		AddListener(ListenerIndex);
+	}
+
+	if (ComponentListenersPerTag.IsEmpty())
+	{
+		return;
+	}
+
+	// listener's tag matches the component tag or one of its parents
+	for (const FGameplayTag& ComponentTag : ComponentTags)
+	{
+		for (FGameplayTag ParentTag = ComponentTag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+		{
+			if (const TArray<int32>* Listeners = ComponentListenersPerTag.Find(ParentTag))
+			{
+				for (const int32 ListenerIndex : *Listeners)
+				{
+					const EFlowTagContainerMatchType MatchType = ComponentListeners[ListenerIndex].MatchType;
+					const bool bExactMatch = MatchType == EFlowTagContainerMatchType::HasAnyExact || MatchType == EFlowTagContainerMatchType::HasAllExact;
+
+					if (!bExactMatch || ParentTag == ComponentTag)
+					{
+						AddListener(ListenerIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::NotifyComponentListeners(const FGameplayTagContainer& ComponentTags, TFunctionRef<void(const FFlowComponentListener&)> Notify) const
+{
+	if (ComponentListeners.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<TPair<int32, FDelegateHandle>, TInlineAllocator<16>> Listeners;
+	CollectComponentListeners(ComponentTags, Listeners);
+
+	for (const TPair<int32, FDelegateHandle>& Listener : Listeners)
+	{
+		// previous listener might have removed this one
+		if (ComponentListeners.IsValidIndex(Listener.Key) && ComponentListeners[Listener.Key].Handle == Listener.Value)
+		{
+			// copy, as the delegate might add listeners and reallocate the storage
+			const FFlowComponentListener ListenerCopy = ComponentListeners[Listener.Key];
+			Notify(ListenerCopy);
+		}
+	}
+}
+
+FFlowComponentLiveQueryHandle UFlowSubsystem::CreateLiveQuery(const FFlowComponentLiveQuery& Query)
+{
+	FFlowComponentLiveQueryHandle QueryHandle;
+	if (Query.Tags.IsEmpty() && Query.TagQuery.IsEmpty())
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Attempted to create the Flow Component live query without tags."));
+		return QueryHandle;
+	}
+
+	QueryHandle.QueryIndex = LiveQueries.Add(Query);
+	QueryHandle.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+
+	const int32 FilterIndex = FindOrAddLiveQueryFilter(Query);
+	LiveQueryFilters[FilterIndex].Queries.Add(QueryHandle.QueryIndex);
+
+	FFlowComponentLiveQuery& AddedQuery = LiveQueries[QueryHandle.QueryIndex];
+	AddedQuery.Handle = QueryHandle.Handle;
+	AddedQuery.FilterIndex = FilterIndex;
+	AddedQuery.bResolved = false;
+
+	// registry changes are already tracked by the filter, only components registered before it are resolved later
+	if (LiveQueryBatchDepth > 0)
+	{
+		PendingLiveQueryResolves.Add(QueryHandle.QueryIndex);
+		return QueryHandle;
+	}
+
+	ResolveLiveQueryFilter(LiveQueryFilters[FilterIndex]);
+	AddedQuery.bResolved = true;
+
+	return QueryHandle;
+}
+
+void UFlowSubsystem::DestroyLiveQuery(FFlowComponentLiveQueryHandle& Handle)
+{
+	if (LiveQueries.IsValidIndex(Handle.QueryIndex) && LiveQueries[Handle.QueryIndex].Handle == Handle.Handle)
+	{
+		const int32 FilterIndex = LiveQueries[Handle.QueryIndex].FilterIndex;
+		LiveQueries.RemoveAt(Handle.QueryIndex);
+
+		FFlowComponentLiveQueryFilter& Filter = LiveQueryFilters[FilterIndex];
+		Filter.Queries.RemoveSingleSwap(Handle.QueryIndex, EAllowShrinking::No);
+
+		if (Filter.Queries.IsEmpty())
+		{
+			for (const FGameplayTag& Tag : Filter.GetRoutingTags())
+			{
+				FlowComponentRegistry::RemoveSlotFromBucket(LiveQueryFiltersPerTag, Tag, FilterIndex);
+			}
+			UnroutedLiveQueryFilters.RemoveSingleSwap(FilterIndex, EAllowShrinking::No);
+
+			LiveQueryFilters.RemoveAt(FilterIndex);
+		}
+	}
+
+	Handle.Reset();
+}
+
+int32 UFlowSubsystem::FindOrAddLiveQueryFilter(const FFlowComponentLiveQuery& Query)
+{
+	const bool bUseTagQuery = !Query.TagQuery.IsEmpty();
+	const FFlowCompiledTagQuery TagQuery = bUseTagQuery ? FFlowCompiledTagQuery(Query.TagQuery) : FFlowCompiledTagQuery();
+
+	// filters are routed by the first tag in any case
+	const TArray<int32>* Candidates = nullptr;
+	if (TagQuery.bMatchesEmpty)
+	{
+		Candidates = &UnroutedLiveQueryFilters;
+	}
+	else if (bUseTagQuery ? TagQuery.Tags.Num() > 0 : Query.Tags.Num() > 0)
+	{
+		Candidates = LiveQueryFiltersPerTag.Find(bUseTagQuery ? TagQuery.Tags[0] : Query.Tags.First());
+	}
+
+	if (Candidates)
+	{
+		for (const int32 FilterIndex : *Candidates)
+		{
+			const FFlowComponentLiveQueryFilter& Filter = LiveQueryFilters[FilterIndex];
+			if (bUseTagQuery ? Filter.TagQuery == TagQuery : Filter.TagQuery.IsEmpty() && Filter.MatchType == Query.MatchType && Filter.Tags == Query.Tags)
+			{
+				return FilterIndex;
+			}
+		}
+	}
+
+	const int32 FilterIndex = LiveQueryFilters.Add(FFlowComponentLiveQueryFilter());
+
+	FFlowComponentLiveQueryFilter& Filter = LiveQueryFilters[FilterIndex];
+	Filter.Tags = Query.Tags;
+	Filter.MatchType = Query.MatchType;
+	Filter.TagQuery = TagQuery;
+
+	if (TagQuery.bMatchesEmpty)
+	{
+		UnroutedLiveQueryFilters.Add(FilterIndex);
+	}
+	else if (!bUseTagQuery && (Query.MatchType == EFlowTagContainerMatchType::HasAll || Query.MatchType == EFlowTagContainerMatchType::HasAllExact))
+	{
+		// component has to match every tag, so it always matches the first one
+		LiveQueryFiltersPerTag.FindOrAdd(Query.Tags.First()).Add(FilterIndex);
+	}
+	else
+	{
+		for (const FGameplayTag& Tag : Filter.GetRoutingTags())
+		{
+			LiveQueryFiltersPerTag.FindOrAdd(Tag).Add(FilterIndex);
+		}
+	}
+
+	return FilterIndex;
+}
+
+void UFlowSubsystem::ResolveLiveQueryFilter(FFlowComponentLiveQueryFilter& Filter)
+{
+	if (Filter.bResolved)
+	{
+		return;
+	}
+
+	if (!Filter.TagQuery.IsEmpty())
+	{
+		ForEachComponentMatchingQuery(Filter.TagQuery, [&Filter](UFlowComponent& Component)
+		{
+			Filter.Components.Emplace(&Component);
+			return true;
+		});
+
+		Filter.bResolved = true;
+		return;
+	}
+
+	const bool bMatchAll = Filter.MatchType == EFlowTagContainerMatchType::HasAll || Filter.MatchType == EFlowTagContainerMatchType::HasAllExact;
+	const bool bExactMatch = Filter.MatchType == EFlowTagContainerMatchType::HasAnyExact || Filter.MatchType == EFlowTagContainerMatchType::HasAllExact;
+
+	// components registered inside the batch have been already added by the registry refresh
+	ForEachComponent(Filter.Tags, bMatchAll ? EGameplayContainerMatchType::All : EGameplayContainerMatchType::Any, bExactMatch, [&Filter](UFlowComponent& Component)
+	{
+		Filter.Components.Emplace(&Component);
+		return true;
+	});
+
+	Filter.bResolved = true;
+}
+
+void UFlowSubsystem::BeginLiveQueryBatch()
+{
+	++LiveQueryBatchDepth;
+}
+
+void UFlowSubsystem::EndLiveQueryBatch()
+{
+	check(LiveQueryBatchDepth > 0);
+
+	if (--LiveQueryBatchDepth == 0)
+	{
+		ResolvePendingLiveQueries();
+	}
+}
+
+void UFlowSubsystem::ResolvePendingLiveQueries()
+{
+	if (PendingLiveQueryResolves.IsEmpty())
+	{
+		return;
+	}
+
+	const TArray<int32> QueryIndices = MoveTemp(PendingLiveQueryResolves);
+	PendingLiveQueryResolves.Reset();
+
+	for (const int32 QueryIndex : QueryIndices)
+	{
+		// query might have been destroyed inside the batch, its index could be reused by a newer pending query
+		if (!LiveQueries.IsValidIndex(QueryIndex) || LiveQueries[QueryIndex].bResolved)
+		{
+			continue;
+		}
+
+		FFlowComponentLiveQuery& Query = LiveQueries[QueryIndex];
+		Query.bResolved = true;
+
+		// many loaded observers share the same filter, it's resolved by a single registry pass
+		FFlowComponentLiveQueryFilter& Filter = LiveQueryFilters[Query.FilterIndex];
+		ResolveLiveQueryFilter(Filter);
+
+		// unresolved queries didn't receive events of the registry refresh, so every component is delivered once
+		for (const TWeakObjectPtr<UFlowComponent>& Component : Filter.Components)
+		{
+			if (Component.IsValid())
+			{
+				PendingLiveQueryEvents.Add({QueryIndex, Query.Handle, Component, true});
+			}
+		}
+	}
+
+	DispatchRegistryEvents();
+}
+
+const TSet<TWeakObjectPtr<UFlowComponent>>* UFlowSubsystem::GetLiveQueryComponents(const FFlowComponentLiveQueryHandle& Handle) const
+{
+	if (LiveQueries.IsValidIndex(Handle.QueryIndex) && LiveQueries[Handle.QueryIndex].Handle == Handle.Handle && LiveQueries[Handle.QueryIndex].bResolved)
+	{
+		return &LiveQueryFilters[LiveQueries[Handle.QueryIndex].FilterIndex].Components;
+	}
+
+	return nullptr;
+}
+
+void UFlowSubsystem::RefreshLiveQueries(const int32 SlotIndex, const FGameplayTag& ChangedTag)
+{
+	const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+
+	// filter's tag matches the component tag or one of its parents, including the tag just removed
+	TArray<int32, TInlineAllocator<16>> FilterIndices;
+	const auto CollectFilters = [this, &FilterIndices](const FGameplayTag& ComponentTag)
+	{
+		for (FGameplayTag ParentTag = ComponentTag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+		{
+			if (const TArray<int32>* Filters = LiveQueryFiltersPerTag.Find(ParentTag))
+			{
+				for (const int32 FilterIndex : *Filters)
+				{
+					FilterIndices.AddUnique(FilterIndex);
+				}
+			}
+		}
+	};
+
+	CollectFilters(ChangedTag);
+	for (const FGameplayTag& Tag : Slot.RegisteredTags)
+	{
+		CollectFilters(Tag);
+	}
+
+	for (const int32 FilterIndex : UnroutedLiveQueryFilters)
+	{
+		FilterIndices.AddUnique(FilterIndex);
+	}
+
+	for (const int32 FilterIndex : FilterIndices)
+	{
+		FFlowComponentLiveQueryFilter& Filter = LiveQueryFilters[FilterIndex];
+
+		if (Slot.Component == nullptr)
+		{
+			// component destroyed without unregistering, its weak pointer is already invalid
+			for (auto It = Filter.Components.CreateIterator(); It; ++It)
+			{
+				if (!It->IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			continue;
+		}
+
+		bool bAdded = false;
+		const bool bMatches = !Slot.RegisteredTags.IsEmpty() && Filter.Matches(Slot.RegisteredTags);
+		if (bMatches)
+		{
+			bool bAlreadyInFilter = false;
+			Filter.Components.Add(Slot.Component.Get(), &bAlreadyInFilter);
+
+			if (bAlreadyInFilter)
+			{
+				continue;
+			}
+			bAdded = true;
+		}
+		else if (Filter.Components.Remove(Slot.Component.Get()) == 0)
+		{
+			continue;
+		}
+
+		for (const int32 QueryIndex : Filter.Queries)
+		{
+			const FFlowComponentLiveQuery& Query = LiveQueries[QueryIndex];
+			if (Query.bResolved)
+			{
+				PendingLiveQueryEvents.Add({QueryIndex, Query.Handle, Slot.Component.Get(), bAdded});
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::DispatchRegistryEvents()
+{
+	// the registration batch dispatches these once it ends
+	if (ComponentRegistrationBatchDepth > 0 || (PendingRegionEvents.IsEmpty() && PendingLiveQueryEvents.IsEmpty()))
+	{
+		return;
+	}
+
+	// listeners might move or register components, these events are dispatched in the next call
+	const TArray<FFlowComponentRegistryEvent> RegionEvents = MoveTemp(PendingRegionEvents);
+	PendingRegionEvents.Reset();
+
+	const TArray<FFlowComponentRegistryEvent> LiveQueryEvents = MoveTemp(PendingLiveQueryEvents);
+	PendingLiveQueryEvents.Reset();
+
+	for (const FFlowComponentRegistryEvent& LiveQueryEvent : LiveQueryEvents)
+	{
+		UFlowComponent* Component = LiveQueryEvent.Component.Get();
+
+		// previous listener might have destroyed this query
+		if (Component && LiveQueries.IsValidIndex(LiveQueryEvent.ListenerIndex) && LiveQueries[LiveQueryEvent.ListenerIndex].Handle == LiveQueryEvent.Handle)
+		{
+			// copy, as the delegate might create queries and reallocate the storage
+			const FFlowComponentLiveQuery& Query = LiveQueries[LiveQueryEvent.ListenerIndex];
+			const FNativeFlowComponentEvent Delegate = LiveQueryEvent.bAdded ? Query.OnComponentAdded : Query.OnComponentRemoved;
+			Delegate.ExecuteIfBound(Component);
+		}
+	}
+
+	for (const FFlowComponentRegistryEvent& RegionEvent : RegionEvents)
+	{
+		UFlowComponent* Component = RegionEvent.Component.Get();
+
+		// previous listener might have removed this one
+		if (Component && ComponentRegions.IsValidIndex(RegionEvent.ListenerIndex) && ComponentRegions[RegionEvent.ListenerIndex].Handle == RegionEvent.Handle)
+		{
+			// copy, as the delegate might add listeners and reallocate the storage
+			const FFlowComponentRegionListener& Region = ComponentRegions[RegionEvent.ListenerIndex];
+			const FNativeFlowComponentEvent Delegate = RegionEvent.bAdded ? Region.OnComponentEntered : Region.OnComponentLeft;
+			Delegate.ExecuteIfBound(Component);
+		}
+	}
+}
+
+bool UFlowSubsystem::IsCosmeticOnly() const
+{
+	return UFlowSettings::Get()->bCosmeticFlowsOnlyOnClients && GetWorld() && GetWorld()->GetNetMode() == NM_Client;
+}
+
+bool UFlowSubsystem::ShouldRegisterComponent(const UFlowComponent* Component) const
+{
+	return Component->IsCosmetic() || !IsCosmeticOnly();
+}
+
+void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Component->IdentityTags)
+	{
+		if (Tag.IsValid())
+		{
+			AddToComponentRegistry(Tag, Component);
+		}
+	}
+
+	BroadcastComponentRegistered(Component);
+}
+
+void UFlowSubsystem::OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	AddToComponentRegistry(AddedTag, Component);
+
+	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
+	if (Component->IdentityTags.Num() > 1)
+	{
+		BroadcastComponentTagAdded(Component, FGameplayTagContainer(AddedTag));
+	}
+	else
+	{
+		BroadcastComponentRegistered(Component);
+	}
+}
+
+void UFlowSubsystem::OnIdentityTagsAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : AddedTags)
+	{
+		AddToComponentRegistry(Tag, Component);
+	}
+
+	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
+	if (Component->IdentityTags.Num() > AddedTags.Num())
+	{
+		BroadcastComponentTagAdded(Component, AddedTags);
+	}
+	else
+	{
+		BroadcastComponentRegistered(Component);
+	}
+}
+
+void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Component->IdentityTags)
+	{
+		if (Tag.IsValid())
+		{
+			RemoveFromComponentRegistry(Tag, Component);
+		}
+	}
+
+	// the array entry is skipped by the flush, so unregistering doesn't search the whole batch
+	PendingRegisteredComponentsSet.Remove(Component);
+
+	BroadcastComponentUnregistered(Component, Component->IdentityTags);
+}
+
+void UFlowSubsystem::OnIdentityTagRemoved(UFlowComponent* Component, const FGameplayTag& RemovedTag)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	RemoveFromComponentRegistry(RemovedTag, Component);
+
+	const FGameplayTagContainer RemovedTags(RemovedTag);
+
+	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
+	if (Component->IdentityTags.Num() > 0)
+	{
+		BroadcastComponentTagRemoved(Component, RemovedTags);
+	}
+	else
+	{
+		BroadcastComponentUnregistered(Component, RemovedTags);
+	}
+}
+
+void UFlowSubsystem::OnIdentityTagsRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+{
+	if (!ShouldRegisterComponent(Component))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : RemovedTags)
+	{
+		RemoveFromComponentRegistry(Tag, Component);
+	}
+
+	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
+	if (Component->IdentityTags.Num() > 0)
+	{
+		BroadcastComponentTagRemoved(Component, RemovedTags);
+	}
+	else
+	{
+		BroadcastComponentUnregistered(Component, RemovedTags);
+	}
+}
+
+void UFlowSubsystem::BroadcastComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+{
+	DispatchRegistryEvents();
+
+	NotifyComponentListeners(Component->IdentityTags, [Component, &AddedTags](const FFlowComponentListener& Listener)
+	{
+		Listener.OnComponentTagAdded.ExecuteIfBound(Component, AddedTags);
+	});
+
+	OnComponentTagAddedNative.Broadcast(Component, AddedTags);
+	OnComponentTagAdded.Broadcast(Component, AddedTags);
+}
+
+void UFlowSubsystem::BroadcastComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+{
+	DispatchRegistryEvents();
+
+	if (ComponentListeners.Num() > 0)
+	{
+		// component might have matched the listener's filter through removed tags
+		FGameplayTagContainer PreviousTags = Component->IdentityTags;
+		PreviousTags.AppendTags(RemovedTags);
+
+		NotifyComponentListeners(PreviousTags, [Component, &RemovedTags](const FFlowComponentListener& Listener)
+		{
+			Listener.OnComponentTagRemoved.ExecuteIfBound(Component, RemovedTags);
+		});
+	}
+
+	OnComponentTagRemovedNative.Broadcast(Component, RemovedTags);
+	OnComponentTagRemoved.Broadcast(Component, RemovedTags);
+}
+
+void UFlowSubsystem::BroadcastComponentUnregistered(UFlowComponent* Component, const FGameplayTagContainer& RegisteredTags)
+{
+	DispatchRegistryEvents();
+
+	NotifyComponentListeners(RegisteredTags, [Component](const FFlowComponentListener& Listener)
+	{
+		Listener.OnComponentUnregistered.ExecuteIfBound(Component);
+	});
+
+	OnComponentUnregisteredNative.Broadcast(Component);
+	OnComponentUnregistered.Broadcast(Component);
+}
+
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTag(const FGameplayTag Tag, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+{
+	TSet<UFlowComponent*> Result;
+	ForEachComponentOfClass(Tag, bExactMatch, ComponentClass, [&Result](UFlowComponent& Component)
+	{
+		Result.Emplace(&Component);
+		return true;
+	});
+
+	return Result;
+}
+
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+{
+	TSet<UFlowComponent*> Result;
+	ForEachComponent(Tags, MatchType, bExactMatch, [&Result, &ComponentClass](UFlowComponent& Component)
+	{
+		if (Component.GetClass()->IsChildOf(ComponentClass))
+		{
+			Result.Emplace(&Component);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTagQuery(const FGameplayTagQuery& TagQuery, const TSubclassOf<UFlowComponent> ComponentClass) const
+{
+	TSet<UFlowComponent*> Result;
+	if (TagQuery.IsEmpty())
+	{
+		return Result;
+	}
+
+	ForEachComponentMatchingQuery(FFlowCompiledTagQuery(TagQuery), [&Result, &ComponentClass](UFlowComponent& Component)
+	{
+		if (Component.GetClass()->IsChildOf(ComponentClass))
+		{
+			Result.Emplace(&Component);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+TSet<AActor*> UFlowSubsystem::GetFlowActorsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TSet<AActor*> Result;
+	ForEachComponent(Tag, bExactMatch, [&Result, &ActorClass](UFlowComponent& Component)
+	{
+		AActor* Owner = Component.GetOwner();
+		if (Owner && Owner->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Owner);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+TSet<AActor*> UFlowSubsystem::GetFlowActorsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TSet<AActor*> Result;
+	ForEachComponent(Tags, MatchType, bExactMatch, [&Result, &ActorClass](UFlowComponent& Component)
+	{
+		AActor* Owner = Component.GetOwner();
+		if (Owner && Owner->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Owner);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TMap<AActor*, UFlowComponent*> Result;
+	ForEachComponent(Tag, bExactMatch, [&Result, &ActorClass](UFlowComponent& Component)
+	{
+		AActor* Owner = Component.GetOwner();
+		if (Owner && Owner->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Owner, &Component);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TMap<AActor*, UFlowComponent*> Result;
+	ForEachComponent(Tags, MatchType, bExactMatch, [&Result, &ActorClass](UFlowComponent& Component)
+	{
+		AActor* Owner = Component.GetOwner();
+		if (Owner && Owner->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Owner, &Component);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+bool UFlowSubsystem::ForEachComponent(const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	return ForEachComponentInWorld(nullptr, Tag, bExactMatch, Function);
+}
+
+bool UFlowSubsystem::ForEachComponentInWorld(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	INC_DWORD_STAT(STAT_FlowRegistryQueries);
+	CSV_CUSTOM_STAT(Flow, RegistryQueries, 1, ECsvCustomStatOp::Accumulate);
+
+	const TArray<int32>* SlotIndices = FindComponentSlots(World, Tag, bExactMatch);
+	if (SlotIndices == nullptr)
+	{
+		return true;
+	}
+
+	if (World == nullptr || bShardRegistryByWorld)
+	{
+		return VisitComponentSlots(*SlotIndices, Function);
+	}
+
+	const TObjectKey<UWorld> WorldKey(World);
+	for (const int32 SlotIndex : *SlotIndices)
+	{
+		const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+		if (Slot.Component && Slot.World == WorldKey && !Function(*Slot.Component))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FFlowCompiledTagQuery::FFlowCompiledTagQuery(const FGameplayTagQuery& InQuery)
+	: Query(InQuery)
+	, Tags(InQuery.GetGameplayTagArray())
+	, bMatchesEmpty(!InQuery.IsEmpty() && InQuery.Matches(FGameplayTagContainer::EmptyContainer))
+{
+}
+
+bool UFlowSubsystem::ForEachComponentMatchingQuery(const FFlowCompiledTagQuery& TagQuery, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	INC_DWORD_STAT(STAT_FlowRegistryQueries);
+	CSV_CUSTOM_STAT(Flow, RegistryQueries, 1, ECsvCustomStatOp::Accumulate);
+
+	if (TagQuery.IsEmpty())
+	{
+		return true;
+	}
+
+	if (TagQuery.bMatchesEmpty)
+	{
+		for (const FFlowComponentRegistrySlot& Slot : ComponentSlots)
+		{
+			if (Slot.Component && !Slot.RegisteredTags.IsEmpty() && TagQuery.Matches(Slot.RegisteredTags) && !Function(*Slot.Component))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// tags of the query evaluate the same for components with none of them and the empty container, so candidates are components under any referenced tag
+	for (int32 TagIndex = 0; TagIndex < TagQuery.Tags.Num(); ++TagIndex)
+	{
+		const TArray<int32>* SlotIndices = ComponentSlotsUnderTag.Find(TagQuery.Tags[TagIndex]);
+		if (SlotIndices == nullptr)
+		{
+			continue;
+		}
+
+		for (const int32 SlotIndex : *SlotIndices)
+		{
+			const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+			if (Slot.Component == nullptr)
+			{
+				continue;
+			}
+
+			// already tested through one of the previous tags
+			bool bVisited = false;
+			for (int32 PreviousIndex = 0; PreviousIndex < TagIndex && !bVisited; ++PreviousIndex)
 			{
-				FlowComponent->SaveRootFlow(SaveGame->FlowInstances);
+				bVisited = Slot.RegisteredTags.HasTag(TagQuery.Tags[PreviousIndex]);
 			}
-			else
+
+			if (!bVisited && TagQuery.Matches(Slot.RegisteredTags) && !Function(*Slot.Component))
 			{
-				RootInstance.Key->SaveInstance(SaveGame->FlowInstances);
+				return false;
 			}
 		}
 	}
 
-	// save Flow Components
-	{
-		// retrieve all registered components
-		TArray<TWeakObjectPtr<UFlowComponent>> ComponentsArray;
-		FlowComponentRegistry.GenerateValueArray(ComponentsArray);
-
-		// ensure uniqueness of entries
-		const TSet<TWeakObjectPtr<UFlowComponent>> RegisteredComponents = TSet<TWeakObjectPtr<UFlowComponent>>(ComponentsArray);
+	return true;
+}
 
-		// write archives to SaveGame
-		for (const TWeakObjectPtr<UFlowComponent> RegisteredComponent : RegisteredComponents)
+const TArray<int32>* UFlowSubsystem::FindComponentSlots(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch) const
+{
+	if (World && bShardRegistryByWorld)
+	{
+		const FFlowComponentRegistryShard* Shard = RegistryShards.Find(World);
+		if (Shard == nullptr)
 		{
-			SaveGame->FlowComponents.Emplace(RegisteredComponent->SaveInstance());
+			return nullptr;
 		}
+
+		Shard->QueriesNum++;
+		return bExactMatch ? Shard->ComponentSlotsPerTag.Find(Tag) : Shard->ComponentSlotsUnderTag.Find(Tag);
 	}
+
+	return bExactMatch ? ComponentSlotsPerTag.Find(Tag) : ComponentSlotsUnderTag.Find(Tag);
 }
 
-void UFlowSubsystem::OnGameLoaded(UFlowSaveGame* SaveGame)
+void UFlowSubsystem::BatchNotifyActors(const TArray<FFlowActorNotify>& Notifies, const EFlowNetMode NetMode) const
 {
-	LoadedSaveGame = SaveGame;
-
-	// here's opportunity to apply loaded data to custom systems
-	// it's recommended to do this by overriding method in the subclass
+	BatchNotifyActorsInWorld(nullptr, Notifies, NetMode);
 }
 
-void UFlowSubsystem::LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName, const bool bAllowMultipleInstances)
+void UFlowSubsystem::BatchNotifyActorsInWorld(const UWorld* World, const TArray<FFlowActorNotify>& Notifies, const EFlowNetMode NetMode) const
 {
-	if (FlowAsset == nullptr || SavedAssetInstanceName.IsEmpty())
+	FGameplayTagContainer ActorTags;
+	for (const FFlowActorNotify& Notify : Notifies)
+	{
+		if (Notify.ActorTag.IsValid() && Notify.NotifyTag.IsValid())
+		{
+			ActorTags.AddTag(Notify.ActorTag);
+		}
+	}
+
+	if (ActorTags.IsEmpty())
 	{
 		return;
 	}
 
-	for (const FFlowAssetSaveData& AssetRecord : LoadedSaveGame->FlowInstances)
+	// components are visited once, even if identified by several Actor Tags
+	TArray<TPair<TWeakObjectPtr<UFlowComponent>, FGameplayTagContainer>, TInlineAllocator<16>> Targets;
+	ForEachComponentInWorld(World, ActorTags, EGameplayContainerMatchType::Any, true, [&Notifies, &Targets](UFlowComponent& Component)
 	{
-		if (AssetRecord.InstanceName == SavedAssetInstanceName
-			&& (FlowAsset->IsBoundToWorld() == false || AssetRecord.WorldName == GetWorld()->GetName()))
+		FGameplayTagContainer NotifyTags;
+		for (const FFlowActorNotify& Notify : Notifies)
 		{
-			UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, bAllowMultipleInstances);
-			if (LoadedInstance)
+			if (Notify.NotifyTag.IsValid() && Component.IdentityTags.HasTagExact(Notify.ActorTag))
 			{
-				LoadedInstance->LoadInstance(AssetRecord);
+				NotifyTags.AddTag(Notify.NotifyTag);
 			}
-			return;
 		}
-	}
-}
 
-void UFlowSubsystem::LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedAssetInstanceName)
-{
-	if (SubGraphNode->Asset.IsNull())
+		if (NotifyTags.Num() > 0)
+		{
+			Targets.Emplace(&Component, MoveTemp(NotifyTags));
+		}
+		return true;
+	});
+
+	// receivers might register or unregister components, so notifies are sent after the registry pass
+	for (const TPair<TWeakObjectPtr<UFlowComponent>, FGameplayTagContainer>& Target : Targets)
 	{
-		return;
+		if (UFlowComponent* Component = Target.Key.Get())
+		{
+			Component->NotifyFromGraph(Target.Value, NetMode);
+		}
 	}
+}
 
-	UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
+bool UFlowSubsystem::ForEachComponent(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	return ForEachComponentInWorld(nullptr, Tags, MatchType, bExactMatch, Function);
+}
 
-	for (const FFlowAssetSaveData& AssetRecord : LoadedSaveGame->FlowInstances)
+bool UFlowSubsystem::ForEachComponentInWorld(const UWorld* World, const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	if (MatchType == EGameplayContainerMatchType::Any)
 	{
-		if (AssetRecord.InstanceName == SavedAssetInstanceName
-			&& ((SubGraphAsset && SubGraphAsset->IsBoundToWorld() == false) || AssetRecord.WorldName == GetWorld()->GetName()))
+		for (int32 TagIndex = 0; TagIndex < Tags.Num(); ++TagIndex)
 		{
-			UFlowAsset* LoadedInstance = CreateSubFlow(SubGraphNode, SavedAssetInstanceName);
-			if (LoadedInstance)
+			const bool bContinue = ForEachComponentInWorld(World, Tags.GetByIndex(TagIndex), bExactMatch, [&](UFlowComponent& Component)
 			{
-				LoadedInstance->LoadInstance(AssetRecord);
+				// already visited through one of the previous tags
+				for (int32 PreviousIndex = 0; PreviousIndex < TagIndex; ++PreviousIndex)
+				{
+					const FGameplayTag& PreviousTag = Tags.GetByIndex(PreviousIndex);
+					if (bExactMatch ? Component.IdentityTags.HasTagExact(PreviousTag) : Component.IdentityTags.HasTag(PreviousTag))
+					{
+						return true;
+					}
+				}
+
+				return Function(Component);
+			});
+
+			if (!bContinue)
+			{
+				return false;
 			}
-			return;
 		}
+
+		return true;
+	}
+
+	// EGameplayContainerMatchType::All
+	// component needs to have all tags exactly, so visit exact matches of the most selective tag and check the others
+	FGameplayTag MostSelectiveTag;
+	int32 MostSelectiveCount = MAX_int32;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		// count of all worlds is a good enough estimate without sharding
+		const int32 ComponentCount = bShardRegistryByWorld ? GetComponentCountInWorld(World, Tag) : GetComponentCount(Tag);
+		if (ComponentCount == 0)
+		{
+			// nothing can match all tags
+			return true;
+		}
+
+		if (ComponentCount < MostSelectiveCount)
+		{
+			MostSelectiveTag = Tag;
+			MostSelectiveCount = ComponentCount;
+		}
+	}
+
+	if (!MostSelectiveTag.IsValid())
+	{
+		return true;
 	}
+
+	return ForEachComponentInWorld(World, MostSelectiveTag, true, [&](UFlowComponent& Component)
+	{
+		return !Component.IdentityTags.HasAllExact(Tags) || Function(Component);
+	});
 }
 
-void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
+bool UFlowSubsystem::ForEachComponentOfClass(const FGameplayTag& Tag, const bool bExactMatch, const UClass* ComponentClass, TFunctionRef<bool(UFlowComponent&)> Function) const
 {
-	for (const FGameplayTag& Tag : Component->IdentityTags)
+	if (bExactMatch && bPartitionRegistryByClass)
 	{
-		if (Tag.IsValid())
+		INC_DWORD_STAT(STAT_FlowRegistryQueries);
+		CSV_CUSTOM_STAT(Flow, RegistryQueries, 1, ECsvCustomStatOp::Accumulate);
+
+		if (const TMap<const UClass*, TArray<int32>>* ClassPartitions = ComponentSlotsPerClass.Find(Tag))
 		{
-			FlowComponentRegistry.Emplace(Tag, Component);
+			for (const TPair<const UClass*, TArray<int32>>& ClassPartition : *ClassPartitions)
+			{
+				if (ClassPartition.Key->IsChildOf(ComponentClass) && !VisitComponentSlots(ClassPartition.Value, Function))
+				{
+					return false;
+				}
+			}
 		}
+
+		return true;
 	}
 
-	OnComponentRegistered.Broadcast(Component);
+	return ForEachComponent(Tag, bExactMatch, [ComponentClass, &Function](UFlowComponent& Component)
+	{
+		return !Component.GetClass()->IsChildOf(ComponentClass) || Function(Component);
+	});
 }
 
-void UFlowSubsystem::OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag)
+int32 UFlowSubsystem::GetComponentCount(const FGameplayTag& Tag, const bool bExactMatch) const
 {
-	FlowComponentRegistry.Emplace(AddedTag, Component);
+	const TArray<int32>* SlotIndices = bExactMatch ? ComponentSlotsPerTag.Find(Tag) : ComponentSlotsUnderTag.Find(Tag);
+	return SlotIndices ? SlotIndices->Num() : 0;
+}
 
-	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
-	if (Component->IdentityTags.Num() > 1)
+int32 UFlowSubsystem::GetComponentCountInWorld(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch) const
+{
+	if (World == nullptr || bShardRegistryByWorld)
 	{
-		OnComponentTagAdded.Broadcast(Component, FGameplayTagContainer(AddedTag));
+		const TArray<int32>* SlotIndices = FindComponentSlots(World, Tag, bExactMatch);
+		return SlotIndices ? SlotIndices->Num() : 0;
 	}
-	else
+
+	int32 ComponentCount = 0;
+	ForEachComponentInWorld(World, Tag, bExactMatch, [&ComponentCount](UFlowComponent&)
 	{
-		OnComponentRegistered.Broadcast(Component);
-	}
+		ComponentCount++;
+		return true;
+	});
+
+	return ComponentCount;
 }
 
-void UFlowSubsystem::OnIdentityTagsAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+bool UFlowSubsystem::PublishRegistrySnapshot(float DeltaTime)
 {
-	for (const FGameplayTag& Tag : AddedTags)
+	// without the spatial registry, owners might have moved without notifying us
+	if (!bRegistrySnapshotDirty && bSpatialRegistry)
 	{
-		FlowComponentRegistry.Emplace(Tag, Component);
+		return true;
 	}
 
-	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
-	if (Component->IdentityTags.Num() > AddedTags.Num())
-	{
-		OnComponentTagAdded.Broadcast(Component, AddedTags);
-	}
-	else
+	FFlowComponentRegistrySnapshot* Snapshot = RegistrySnapshot->BeginWrite();
+	if (Snapshot == nullptr)
 	{
-		OnComponentRegistered.Broadcast(Component);
+		// stays dirty, so it's published on the next frame
+		return true;
 	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowPublishRegistrySnapshot);
+
+	BuildRegistrySnapshot(*Snapshot);
+	RegistrySnapshot->EndWrite();
+
+	bRegistrySnapshotDirty = false;
+	return true;
 }
 
-void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
+void UFlowSubsystem::BuildRegistrySnapshot(FFlowComponentRegistrySnapshot& OutSnapshot) const
 {
-	for (const FGameplayTag& Tag : Component->IdentityTags)
+	OutSnapshot.Reset();
+	OutSnapshot.FrameNumber = GFrameCounter;
+	OutSnapshot.Entries.Reserve(ComponentSlotIndices.Num());
+
+	// slots are dense, so there's no need for a map
+	TArray<int32> EntryPerSlot;
+	EntryPerSlot.Init(INDEX_NONE, ComponentSlots.Num());
+
+	for (int32 SlotIndex = 0; SlotIndex < ComponentSlots.Num(); ++SlotIndex)
 	{
-		if (Tag.IsValid())
+		const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+		if (Slot.Component == nullptr || Slot.RegisteredTags.IsEmpty())
 		{
-			FlowComponentRegistry.Remove(Tag, Component);
+			continue;
 		}
+
+		EntryPerSlot[SlotIndex] = OutSnapshot.Entries.Num();
+
+		FFlowComponentSnapshotEntry& Entry = OutSnapshot.Entries.AddDefaulted_GetRef();
+		Entry.Actor = Slot.Component->GetOwner();
+		Entry.Component = Slot.ComponentKey;
+		Entry.Handle.SlotIndex = SlotIndex;
+		Entry.Handle.Generation = Slot.Generation;
+		Entry.Location = GetSlotLocation(Slot);
+		Entry.Tags = Slot.RegisteredTags;
 	}
 
-	OnComponentUnregistered.Broadcast(Component);
+	const auto CopyBuckets = [&EntryPerSlot](const TMap<FGameplayTag, TArray<int32>>& SlotBuckets, TMap<FGameplayTag, TArray<int32>>& OutEntryBuckets)
+	{
+		OutEntryBuckets.Reserve(SlotBuckets.Num());
+		for (const TPair<FGameplayTag, TArray<int32>>& Bucket : SlotBuckets)
+		{
+			// buckets emptied by FFlowComponentRegistrySnapshot::Reset are reused with their allocation
+			TArray<int32>& EntryIndices = OutEntryBuckets.FindOrAdd(Bucket.Key);
+			EntryIndices.Reserve(Bucket.Value.Num());
+
+			for (const int32 SlotIndex : Bucket.Value)
+			{
+				if (EntryPerSlot[SlotIndex] != INDEX_NONE)
+				{
+					EntryIndices.Add(EntryPerSlot[SlotIndex]);
+				}
+			}
+		}
+	};
+
+	CopyBuckets(ComponentSlotsPerTag, OutSnapshot.EntriesPerTag);
+	CopyBuckets(ComponentSlotsUnderTag, OutSnapshot.EntriesUnderTag);
 }
 
-void UFlowSubsystem::OnIdentityTagRemoved(UFlowComponent* Component, const FGameplayTag& RemovedTag)
+FIntPoint UFlowSubsystem::GetSpatialCell(const FVector& Location) const
 {
-	FlowComponentRegistry.Remove(RemovedTag, Component);
+	return FIntPoint(FMath::FloorToInt32(Location.X / SpatialCellSize), FMath::FloorToInt32(Location.Y / SpatialCellSize));
+}
 
-	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
-	if (Component->IdentityTags.Num() > 0)
+FVector UFlowSubsystem::GetSlotLocation(const FFlowComponentRegistrySlot& Slot) const
+{
+	if (bSpatialRegistry)
 	{
-		OnComponentTagRemoved.Broadcast(Component, FGameplayTagContainer(RemovedTag));
+		return Slot.Location;
 	}
-	else
+
+	const AActor* Owner = Slot.Component ? Slot.Component->GetOwner() : nullptr;
+	return Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+}
+
+void UFlowSubsystem::AddToSpatialRegistry(const int32 SlotIndex)
+{
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+
+	const AActor* Owner = Slot.Component->GetOwner();
+	USceneComponent* RootComponent = Owner ? Owner->GetRootComponent() : nullptr;
+
+	Slot.Location = RootComponent ? RootComponent->GetComponentLocation() : FVector::ZeroVector;
+	Slot.Cell = GetSpatialCell(Slot.Location);
+	ComponentSlotsPerCell.FindOrAdd(Slot.Cell).Add(SlotIndex);
+
+	// static actors never leave their cell
+	if (RootComponent && RootComponent->Mobility != EComponentMobility::Static)
 	{
-		OnComponentUnregistered.Broadcast(Component);
+		Slot.TrackedSceneComponent = RootComponent;
+		Slot.TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ThisClass::OnComponentOwnerMoved, SlotIndex);
 	}
 }
 
-void UFlowSubsystem::OnIdentityTagsRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+void UFlowSubsystem::RemoveFromSpatialRegistry(const int32 SlotIndex)
 {
-	for (const FGameplayTag& Tag : RemovedTags)
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+
+	if (USceneComponent* TrackedSceneComponent = Slot.TrackedSceneComponent.Get())
 	{
-		FlowComponentRegistry.Remove(Tag, Component);
+		TrackedSceneComponent->TransformUpdated.Remove(Slot.TransformUpdatedHandle);
 	}
+	Slot.TrackedSceneComponent.Reset();
+	Slot.TransformUpdatedHandle.Reset();
 
-	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
-	if (Component->IdentityTags.Num() > 0)
+	FlowComponentRegistry::RemoveSlotFromBucket(ComponentSlotsPerCell, Slot.Cell, SlotIndex);
+	Slot.Location = FVector::ZeroVector;
+	Slot.Cell = FIntPoint::ZeroValue;
+}
+
+void UFlowSubsystem::OnComponentOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, const int32 SlotIndex)
+{
+	if (!ComponentSlots.IsValidIndex(SlotIndex))
 	{
-		OnComponentTagRemoved.Broadcast(Component, RemovedTags);
+		return;
 	}
-	else
+
+	FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+	const FIntPoint PreviousCell = Slot.Cell;
+
+	Slot.Location = UpdatedComponent->GetComponentLocation();
+	Slot.Cell = GetSpatialCell(Slot.Location);
+	MarkRegistrySnapshotDirty();
+
+	if (Slot.Cell != PreviousCell)
+	{
+		FlowComponentRegistry::RemoveSlotFromBucket(ComponentSlotsPerCell, PreviousCell, SlotIndex);
+		ComponentSlotsPerCell.FindOrAdd(Slot.Cell).Add(SlotIndex);
+	}
+
+	if (ComponentRegions.Num() > 0)
 	{
-		OnComponentUnregistered.Broadcast(Component);
+		RefreshComponentRegions(SlotIndex, PreviousCell);
+		DispatchRegistryEvents();
 	}
 }
 
-TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTag(const FGameplayTag Tag, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+void UFlowSubsystem::RefreshComponentRegions(const int32 SlotIndex, const FIntPoint& PreviousCell)
 {
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
 
-	TSet<UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	const auto RefreshRegions = [this, &Slot](const TArray<int32>* RegionIndices)
 	{
-		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
+		if (RegionIndices == nullptr)
 		{
-			Result.Emplace(Component.Get());
+			return;
 		}
-	}
 
-	return Result;
+		for (const int32 RegionIndex : *RegionIndices)
+		{
+			FFlowComponentRegionListener& Region = ComponentRegions[RegionIndex];
+
+			// region covering both cells is refreshed twice, but notifies only once
+			if (FlowComponentRegistry::IsSlotInsideRegion(Slot, Region))
+			{
+				bool bAlreadyInside = false;
+				Region.ComponentsInside.Add(Slot.ComponentKey, &bAlreadyInside);
+
+				if (!bAlreadyInside)
+				{
+					PendingRegionEvents.Add({RegionIndex, Region.Handle, Slot.Component.Get(), true});
+				}
+			}
+			else if (Region.ComponentsInside.Remove(Slot.ComponentKey) > 0)
+			{
+				PendingRegionEvents.Add({RegionIndex, Region.Handle, Slot.Component.Get(), false});
+			}
+		}
+	};
+
+	RefreshRegions(ComponentRegionsPerCell.Find(Slot.Cell));
+
+	if (PreviousCell != Slot.Cell)
+	{
+		RefreshRegions(ComponentRegionsPerCell.Find(PreviousCell));
+	}
 }
 
-TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+bool UFlowSubsystem::VisitComponentSlotsInBox(const FGameplayTag& Tag, const bool bExactMatch, const FBox& Box, TFunctionRef<bool(const FFlowComponentRegistrySlot&, const FVector&)> Function) const
 {
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+	const TArray<int32>* SlotIndices = bExactMatch ? ComponentSlotsPerTag.Find(Tag) : ComponentSlotsUnderTag.Find(Tag);
+	if (SlotIndices == nullptr)
+	{
+		return true;
+	}
 
-	TSet<UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	const auto VisitSlot = [this, &Box, &Function](const FFlowComponentRegistrySlot& Slot)
 	{
-		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
+		if (Slot.Component == nullptr)
 		{
-			Result.Emplace(Component.Get());
+			return true;
 		}
-	}
 
-	return Result;
-}
+		const FVector Location = GetSlotLocation(Slot);
+		return !Box.IsInsideOrOn(Location) || Function(Slot, Location);
+	};
 
-TSet<AActor*> UFlowSubsystem::GetFlowActorsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
-{
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	if (bSpatialRegistry)
+	{
+		const FIntPoint MinCell = GetSpatialCell(Box.Min);
+		const FIntPoint MaxCell = GetSpatialCell(Box.Max);
+		const int64 CellCount = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
 
-	TSet<AActor*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		// few components with the tag are cheaper to check directly than many empty cells
+		if (CellCount < SlotIndices->Num())
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+				{
+					if (const TArray<int32>* CellSlotIndices = ComponentSlotsPerCell.Find(FIntPoint(X, Y)))
+					{
+						for (const int32 SlotIndex : *CellSlotIndices)
+						{
+							const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+							if (FlowComponentRegistry::IsSlotMatchingTag(Slot, Tag, bExactMatch) && !VisitSlot(Slot))
+							{
+								return false;
+							}
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+	}
+
+	for (const int32 SlotIndex : *SlotIndices)
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		if (!VisitSlot(ComponentSlots[SlotIndex]))
 		{
-			Result.Emplace(Component->GetOwner());
+			return false;
 		}
 	}
 
-	return Result;
+	return true;
 }
 
-TSet<AActor*> UFlowSubsystem::GetFlowActorsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+bool UFlowSubsystem::ForEachComponentInRadius(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const float Radius, TFunctionRef<bool(UFlowComponent&)> Function) const
 {
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+	const double RadiusSquared = FMath::Square(Radius);
 
-	TSet<AActor*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	return VisitComponentSlotsInBox(Tag, bExactMatch, FBox::BuildAABB(Origin, FVector(Radius)), [&Origin, RadiusSquared, &Function](const FFlowComponentRegistrySlot& Slot, const FVector& Location)
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
-		{
-			Result.Emplace(Component->GetOwner());
-		}
-	}
+		return FVector::DistSquared(Origin, Location) > RadiusSquared || Function(*Slot.Component);
+	});
+}
 
-	return Result;
+bool UFlowSubsystem::ForEachComponentInBox(const FGameplayTag& Tag, const bool bExactMatch, const FBox& Box, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	return VisitComponentSlotsInBox(Tag, bExactMatch, Box, [&Function](const FFlowComponentRegistrySlot& Slot, const FVector& Location)
+	{
+		return Function(*Slot.Component);
+	});
 }
 
-TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+void UFlowSubsystem::FindNearestComponents(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const int32 Count, TArray<UFlowComponent*>& OutComponents, const float MaxRadius, const UClass* ComponentClass) const
 {
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	OutComponents.Reset();
 
-	TMap<AActor*, UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	const TArray<int32>* SlotIndices = bExactMatch ? ComponentSlotsPerTag.Find(Tag) : ComponentSlotsUnderTag.Find(Tag);
+	if (SlotIndices == nullptr || Count <= 0)
+	{
+		return;
+	}
+
+	// max-heap of the closest candidates found so far, its top is the farthest one
+	TArray<TPair<double, int32>> Candidates;
+	const auto IsFarther = [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; };
+	const double MaxRadiusSquared = FMath::Square(static_cast<double>(MaxRadius));
+
+	const auto AddCandidate = [&](const int32 SlotIndex)
+	{
+		const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+		if (Slot.Component == nullptr || (ComponentClass && !Slot.ComponentClass->IsChildOf(ComponentClass)))
+		{
+			return;
+		}
+
+		const double DistanceSquared = FVector::DistSquared(Origin, GetSlotLocation(Slot));
+		if (DistanceSquared <= MaxRadiusSquared)
+		{
+			Candidates.HeapPush(TPair<double, int32>(DistanceSquared, SlotIndex), IsFarther);
+			if (Candidates.Num() > Count)
+			{
+				Candidates.HeapPopDiscard(IsFarther, EAllowShrinking::No);
+			}
+		}
+	};
+
+	bool bVisitAllSlots = !bSpatialRegistry || SlotIndices->Num() <= Count;
+	if (!bVisitAllSlots)
+	{
+		// visit rings of cells around the origin, until every cell left is farther than the farthest candidate
+		const FIntPoint OriginCell = GetSpatialCell(Origin);
+		const int32 MaxRing = static_cast<int32>(FMath::Min(FMath::CeilToDouble(MaxRadius / SpatialCellSize), static_cast<double>(MAX_int32 / 2)));
+		int32 VisitedSlots = 0;
+		int32 VisitedCells = 0;
+
+		for (int32 Ring = 0; Ring <= MaxRing && VisitedSlots < SlotIndices->Num(); ++Ring)
+		{
+			// sparse components are cheaper to check directly than many empty cells
+			VisitedCells += FMath::Max(Ring * 8, 1);
+			if (VisitedCells > SlotIndices->Num())
+			{
+				Candidates.Reset();
+				bVisitAllSlots = true;
+				break;
+			}
+
+			for (int32 X = OriginCell.X - Ring; X <= OriginCell.X + Ring; ++X)
+			{
+				// inner cells were visited by the previous rings
+				const bool bEdgeColumn = X == OriginCell.X - Ring || X == OriginCell.X + Ring;
+				const int32 StepY = bEdgeColumn ? 1 : FMath::Max(Ring * 2, 1);
+
+				for (int32 Y = OriginCell.Y - Ring; Y <= OriginCell.Y + Ring; Y += StepY)
+				{
+					if (const TArray<int32>* CellSlotIndices = ComponentSlotsPerCell.Find(FIntPoint(X, Y)))
+					{
+						for (const int32 SlotIndex : *CellSlotIndices)
+						{
+							if (FlowComponentRegistry::IsSlotMatchingTag(ComponentSlots[SlotIndex], Tag, bExactMatch))
+							{
+								++VisitedSlots;
+								AddCandidate(SlotIndex);
+							}
+						}
+					}
+				}
+			}
+
+			if (Candidates.Num() == Count && Candidates.HeapTop().Key <= FMath::Square(Ring * static_cast<double>(SpatialCellSize)))
+			{
+				break;
+			}
+		}
+	}
+
+	if (bVisitAllSlots)
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		for (const int32 SlotIndex : *SlotIndices)
 		{
-			Result.Emplace(Component->GetOwner(), Component.Get());
+			AddCandidate(SlotIndex);
 		}
 	}
 
-	return Result;
+	Candidates.Sort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+
+	OutComponents.Reserve(Candidates.Num());
+	for (const TPair<double, int32>& Candidate : Candidates)
+	{
+		OutComponents.Add(ComponentSlots[Candidate.Value].Component);
+	}
 }
 
-TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsInRadius(const FGameplayTag Tag, const FVector Origin, const float Radius, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
 {
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
-
-	TMap<AActor*, UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	TSet<UFlowComponent*> Result;
+	ForEachComponentInRadius(Tag, bExactMatch, Origin, Radius, [&Result, &ComponentClass](UFlowComponent& Component)
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		if (Component.GetClass()->IsChildOf(ComponentClass))
 		{
-			Result.Emplace(Component->GetOwner(), Component.Get());
+			Result.Emplace(&Component);
 		}
-	}
+		return true;
+	});
 
 	return Result;
 }
 
-void UFlowSubsystem::FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+UFlowComponent* UFlowSubsystem::FindNearestFlowComponent(const FGameplayTag Tag, const FVector Origin, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+{
+	TArray<UFlowComponent*> NearestComponents;
+	FindNearestComponents(Tag, bExactMatch, Origin, 1, NearestComponents, UE_BIG_NUMBER, ComponentClass);
+
+	return NearestComponents.IsEmpty() ? nullptr : NearestComponents[0];
+}
+
+FDelegateHandle UFlowSubsystem::AddComponentRegionListener(const FFlowComponentRegionListener& Listener)
 {
-	if (bExactMatch)
+	if (!bSpatialRegistry)
 	{
-		FlowComponentRegistry.MultiFind(Tag, OutComponents);
+		UE_LOG(LogFlow, Warning, TEXT("Attempted to add the Flow Component region listener, although the spatial registry is disabled in Flow Settings."));
+		return FDelegateHandle();
 	}
-	else
+
+	const int32 RegionIndex = ComponentRegions.Add(Listener);
+
+	FFlowComponentRegionListener& Region = ComponentRegions[RegionIndex];
+	Region.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Region.ComponentsInside.Reset();
+
+	const FIntPoint MinCell = GetSpatialCell(Region.Center - FVector(Region.Radius));
+	const FIntPoint MaxCell = GetSpatialCell(Region.Center + FVector(Region.Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
 	{
-		for (TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>>::TConstIterator It(FlowComponentRegistry); It; ++It)
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
 		{
-			if (It.Key().MatchesTag(Tag))
+			const FIntPoint Cell(X, Y);
+			ComponentRegionsPerCell.FindOrAdd(Cell).Add(RegionIndex);
+
+			// components already inside don't trigger OnComponentEntered
+			if (const TArray<int32>* CellSlotIndices = ComponentSlotsPerCell.Find(Cell))
 			{
-				OutComponents.Emplace(It.Value());
+				for (const int32 SlotIndex : *CellSlotIndices)
+				{
+					const FFlowComponentRegistrySlot& Slot = ComponentSlots[SlotIndex];
+					if (FlowComponentRegistry::IsSlotInsideRegion(Slot, Region))
+					{
+						Region.ComponentsInside.Add(Slot.ComponentKey);
+					}
+				}
 			}
 		}
 	}
+
+	return Region.Handle;
 }
 
-void UFlowSubsystem::FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+void UFlowSubsystem::RemoveComponentRegionListener(FDelegateHandle& Handle)
 {
-	if (MatchType == EGameplayContainerMatchType::Any)
+	if (!Handle.IsValid())
 	{
-		for (const FGameplayTag& Tag : Tags)
-		{
-			TArray<TWeakObjectPtr<UFlowComponent>> ComponentsPerTag;
-			FindComponents(Tag, bExactMatch, ComponentsPerTag);
-			OutComponents.Append(ComponentsPerTag);
-		}
+		return;
 	}
-	else // EGameplayContainerMatchType::All
+
+	for (auto It = ComponentRegions.CreateIterator(); It; ++It)
 	{
-		TSet<TWeakObjectPtr<UFlowComponent>> ComponentsWithAnyTag;
-		for (const FGameplayTag& Tag : Tags)
+		if (It->Handle == Handle)
 		{
-			TArray<TWeakObjectPtr<UFlowComponent>> ComponentsPerTag;
-			FindComponents(Tag, bExactMatch, ComponentsPerTag);
-			ComponentsWithAnyTag.Append(ComponentsPerTag);
+			const FIntPoint MinCell = GetSpatialCell(It->Center - FVector(It->Radius));
+			const FIntPoint MaxCell = GetSpatialCell(It->Center + FVector(It->Radius));
+
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+				{
+					FlowComponentRegistry::RemoveSlotFromBucket(ComponentRegionsPerCell, FIntPoint(X, Y), It.GetIndex());
+				}
+			}
+
+			It.RemoveCurrent();
+			break;
 		}
+	}
+
+	Handle.Reset();
+}
 
-		for (const TWeakObjectPtr<UFlowComponent>& Component : ComponentsWithAnyTag)
+bool UFlowSubsystem::ForEachComponentInRegion(const FDelegateHandle& Handle, TFunctionRef<bool(UFlowComponent&)> Function) const
+{
+	for (const FFlowComponentRegionListener& Region : ComponentRegions)
+	{
+		if (Region.Handle == Handle)
 		{
-			if (Component.IsValid() && Component->IdentityTags.HasAllExact(Tags))
+			// copy, as the Function might change the region
+			const TArray<TObjectKey<UFlowComponent>> ComponentsInside = Region.ComponentsInside.Array();
+			for (const TObjectKey<UFlowComponent>& ComponentKey : ComponentsInside)
 			{
-				OutComponents.Emplace(Component);
+				UFlowComponent* Component = ComponentKey.ResolveObjectPtr();
+				if (Component && !Function(*Component))
+				{
+					return false;
+				}
 			}
+
+			return true;
 		}
 	}
+
+	return true;
 }
 
 #undef LOCTEXT_NAMESPACE
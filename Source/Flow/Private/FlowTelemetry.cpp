@@ -0,0 +1,373 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowTelemetry.h"
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "FlowStats.h"
+#include "Nodes/FlowNode.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if FLOW_WITH_TELEMETRY
+bool FFlowTelemetry::bEnabled = false;
+TMap<FObjectKey, FFlowTemplateTelemetry> FFlowTelemetry::TemplateTelemetry;
+FFlowTelemetryReportEvent FFlowTelemetry::OnReport;
+
+namespace FlowTelemetry
+{
+	constexpr double Percentiles[] = {0.5, 0.95, 0.99};
+
+	double GetBucketLowerBound(const int32 BucketIndex)
+	{
+		return BucketIndex == 0 ? 0.0 : static_cast<double>(1ull << BucketIndex) / 1000000.0;
+	}
+}
+
+void FFlowTelemetryHistogram::Add(const double Seconds)
+{
+	const uint64 Microseconds = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1000000.0);
+	const int32 BucketIndex = Microseconds > 0 ? FMath::Min(static_cast<int32>(FMath::FloorLog2_64(Microseconds)), BucketsNum - 1) : 0;
+	Buckets[BucketIndex]++;
+
+	Min = Count == 0 ? Seconds : FMath::Min(Min, Seconds);
+	Max = Count == 0 ? Seconds : FMath::Max(Max, Seconds);
+	Sum += Seconds;
+	Count++;
+}
+
+void FFlowTelemetryHistogram::Merge(const FFlowTelemetryHistogram& Other)
+{
+	if (Other.Count == 0)
+	{
+		return;
+	}
+
+	for (int32 BucketIndex = 0; BucketIndex < BucketsNum; BucketIndex++)
+	{
+		Buckets[BucketIndex] += Other.Buckets[BucketIndex];
+	}
+
+	Min = Count == 0 ? Other.Min : FMath::Min(Min, Other.Min);
+	Max = Count == 0 ? Other.Max : FMath::Max(Max, Other.Max);
+	Sum += Other.Sum;
+	Count += Other.Count;
+}
+
+double FFlowTelemetryHistogram::GetPercentile(const double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const double TargetCount = FMath::Clamp(Percentile, 0.0, 1.0) * Count;
+	uint32 CountBelow = 0;
+	for (int32 BucketIndex = 0; BucketIndex < BucketsNum; BucketIndex++)
+	{
+		if (Buckets[BucketIndex] > 0 && CountBelow + Buckets[BucketIndex] >= TargetCount)
+		{
+			const double LowerBound = FlowTelemetry::GetBucketLowerBound(BucketIndex);
+			const double UpperBound = FlowTelemetry::GetBucketLowerBound(BucketIndex + 1);
+			const double Alpha = (TargetCount - CountBelow) / Buckets[BucketIndex];
+			return FMath::Clamp(FMath::Lerp(LowerBound, UpperBound, Alpha), Min, Max);
+		}
+		CountBelow += Buckets[BucketIndex];
+	}
+
+	return Max;
+}
+
+void FFlowTelemetry::SetEnabled(const bool bInEnabled)
+{
+#if CSV_PROFILER
+	static bool bCsvProfileEndBound = false;
+	if (bInEnabled && !bCsvProfileEndBound)
+	{
+		FCsvProfiler::Get()->OnCSVProfileEnd().AddStatic(&FFlowTelemetry::OnCsvProfileEnd);
+		bCsvProfileEndBound = true;
+	}
+#endif
+
+	bEnabled = bInEnabled;
+}
+
+void FFlowTelemetry::Reset()
+{
+	TemplateTelemetry.Empty();
+}
+
+FFlowTemplateTelemetry* FFlowTelemetry::FindOrAddTemplateTelemetry(const UFlowAsset* FlowInstance)
+{
+	// samples are kept in the static state of the game thread, callers running isolated instances are skipped
+	const UFlowAsset* Template = FlowInstance ? FlowInstance->GetTemplateAsset() : nullptr;
+	if (Template == nullptr || !IsInGameThread())
+	{
+		return nullptr;
+	}
+
+	FFlowTemplateTelemetry& Telemetry = TemplateTelemetry.FindOrAdd(FObjectKey(Template));
+	if (Telemetry.TemplateName.IsEmpty())
+	{
+		Telemetry.TemplateName = Template->GetPathName();
+	}
+	return &Telemetry;
+}
+
+void FFlowTelemetry::RecordSince(const UFlowAsset* FlowInstance, const EFlowTelemetryMetric Metric, const double StartTime)
+{
+	if (!bEnabled || StartTime <= 0.0)
+	{
+		return;
+	}
+
+	if (FFlowTemplateTelemetry* Telemetry = FindOrAddTemplateTelemetry(FlowInstance))
+	{
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		Telemetry->Histograms[static_cast<int32>(Metric)].Add(Seconds);
+		RecordCsvStat(Metric, Seconds);
+	}
+}
+
+void FFlowTelemetry::RecordNodeSince(const UFlowNode& Node, const double StartTime)
+{
+	if (!bEnabled || StartTime <= 0.0)
+	{
+		return;
+	}
+
+	if (FFlowTemplateTelemetry* Telemetry = FindOrAddTemplateTelemetry(Node.GetFlowAsset()))
+	{
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		Telemetry->Histograms[static_cast<int32>(EFlowTelemetryMetric::NodeActiveDuration)].Add(Seconds);
+		Telemetry->Nodes.FindOrAdd(Node.GetGuid()).Add(Seconds);
+		RecordCsvStat(EFlowTelemetryMetric::NodeActiveDuration, Seconds);
+	}
+}
+
+void FFlowTelemetry::RecordCsvStat(const EFlowTelemetryMetric Metric, const double Seconds)
+{
+#if CSV_PROFILER
+	// the longest sample of the frame, percentiles of the whole capture are added to its metadata
+	const float Milliseconds = static_cast<float>(Seconds * 1000.0);
+	switch (Metric)
+	{
+		case EFlowTelemetryMetric::InstanceLifetime:
+			CSV_CUSTOM_STAT(FlowTelemetry, InstanceLifetime, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+		case EFlowTelemetryMetric::FirstOutputLatency:
+			CSV_CUSTOM_STAT(FlowTelemetry, FirstOutputLatency, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+		case EFlowTelemetryMetric::NodeActiveDuration:
+			CSV_CUSTOM_STAT(FlowTelemetry, NodeActiveDuration, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+		case EFlowTelemetryMetric::TriggerQueueDelay:
+			CSV_CUSTOM_STAT(FlowTelemetry, TriggerQueueDelay, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+		case EFlowTelemetryMetric::AsyncLoadWait:
+			CSV_CUSTOM_STAT(FlowTelemetry, AsyncLoadWait, Milliseconds, ECsvCustomStatOp::Max);
+			break;
+		default: ;
+	}
+#endif
+}
+
+void FFlowTelemetry::OnCsvProfileEnd()
+{
+#if CSV_PROFILER
+	if (TemplateTelemetry.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(EFlowTelemetryMetric::Max); MetricIndex++)
+	{
+		const EFlowTelemetryMetric Metric = static_cast<EFlowTelemetryMetric>(MetricIndex);
+		const FFlowTelemetryHistogram Histogram = GetTotalHistogram(Metric);
+		if (Histogram.Count == 0)
+		{
+			continue;
+		}
+
+		CSV_METADATA(*FString::Printf(TEXT("FlowTelemetry.%s.Count"), GetMetricName(Metric)), *FString::FromInt(Histogram.Count));
+		for (const double Percentile : FlowTelemetry::Percentiles)
+		{
+			const FString Key = FString::Printf(TEXT("FlowTelemetry.%s.P%d"), GetMetricName(Metric), FMath::RoundToInt(Percentile * 100.0));
+			CSV_METADATA(*Key, *FString::Printf(TEXT("%.3f"), Histogram.GetPercentile(Percentile) * 1000.0));
+		}
+	}
+#endif
+}
+
+const FFlowTemplateTelemetry* FFlowTelemetry::FindTemplateTelemetry(const UFlowAsset* Template)
+{
+	return TemplateTelemetry.Find(FObjectKey(Template));
+}
+
+FFlowTelemetryHistogram FFlowTelemetry::GetTotalHistogram(const EFlowTelemetryMetric Metric)
+{
+	FFlowTelemetryHistogram Total;
+	for (const TPair<FObjectKey, FFlowTemplateTelemetry>& Telemetry : TemplateTelemetry)
+	{
+		Total.Merge(Telemetry.Value.GetHistogram(Metric));
+	}
+	return Total;
+}
+
+const TCHAR* FFlowTelemetry::GetMetricName(const EFlowTelemetryMetric Metric)
+{
+	switch (Metric)
+	{
+		case EFlowTelemetryMetric::InstanceLifetime:
+			return TEXT("InstanceLifetime");
+		case EFlowTelemetryMetric::FirstOutputLatency:
+			return TEXT("FirstOutputLatency");
+		case EFlowTelemetryMetric::NodeActiveDuration:
+			return TEXT("NodeActiveDuration");
+		case EFlowTelemetryMetric::TriggerQueueDelay:
+			return TEXT("TriggerQueueDelay");
+		case EFlowTelemetryMetric::AsyncLoadWait:
+			return TEXT("AsyncLoadWait");
+		default: ;
+	}
+
+	return TEXT("Invalid");
+}
+
+void FFlowTelemetry::Dump(const EFlowTelemetryMetric Metric, const int32 MaxEntries)
+{
+	TArray<const FFlowTemplateTelemetry*> Entries;
+	for (const TPair<FObjectKey, FFlowTemplateTelemetry>& Telemetry : TemplateTelemetry)
+	{
+		if (Telemetry.Value.GetHistogram(Metric).Count > 0)
+		{
+			Entries.Add(&Telemetry.Value);
+		}
+	}
+
+	Entries.Sort([Metric](const FFlowTemplateTelemetry& A, const FFlowTemplateTelemetry& B)
+	{
+		return A.GetHistogram(Metric).GetPercentile(0.95) > B.GetHistogram(Metric).GetPercentile(0.95);
+	});
+
+	UE_LOG(LogFlow, Display, TEXT("Flow Telemetry: %s"), GetMetricName(Metric));
+	UE_LOG(LogFlow, Display, TEXT("  %8s %12s %12s %12s %12s  %s"), TEXT("Count"), TEXT("P50 ms"), TEXT("P95 ms"), TEXT("P99 ms"), TEXT("Max ms"), TEXT("Template"));
+	for (int32 Index = 0; Index < Entries.Num() && (MaxEntries <= 0 || Index < MaxEntries); Index++)
+	{
+		const FFlowTelemetryHistogram& Histogram = Entries[Index]->GetHistogram(Metric);
+		UE_LOG(LogFlow, Display, TEXT("  %8u %12.3f %12.3f %12.3f %12.3f  %s"), Histogram.Count,
+			Histogram.GetPercentile(0.5) * 1000.0, Histogram.GetPercentile(0.95) * 1000.0, Histogram.GetPercentile(0.99) * 1000.0, Histogram.Max * 1000.0,
+			*Entries[Index]->TemplateName);
+	}
+}
+
+FString FFlowTelemetry::Export(const FString& InFilePath)
+{
+	auto AddRow = [](FString& Csv, const FString& TemplateName, const FString& NodeGuid, const TCHAR* MetricName, const FFlowTelemetryHistogram& Histogram)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%s,%u,%.3f,%.3f"), *TemplateName, *NodeGuid, MetricName, Histogram.Count, Histogram.GetMean() * 1000.0, Histogram.Min * 1000.0);
+		for (const double Percentile : FlowTelemetry::Percentiles)
+		{
+			Csv += FString::Printf(TEXT(",%.3f"), Histogram.GetPercentile(Percentile) * 1000.0);
+		}
+		Csv += FString::Printf(TEXT(",%.3f") LINE_TERMINATOR, Histogram.Max * 1000.0);
+	};
+
+	FString Csv = TEXT("Template,Node,Metric,Count,MeanMs,MinMs,P50Ms,P95Ms,P99Ms,MaxMs") LINE_TERMINATOR;
+	for (const TPair<FObjectKey, FFlowTemplateTelemetry>& Telemetry : TemplateTelemetry)
+	{
+		for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(EFlowTelemetryMetric::Max); MetricIndex++)
+		{
+			const EFlowTelemetryMetric Metric = static_cast<EFlowTelemetryMetric>(MetricIndex);
+			if (Telemetry.Value.GetHistogram(Metric).Count > 0)
+			{
+				AddRow(Csv, Telemetry.Value.TemplateName, FString(), GetMetricName(Metric), Telemetry.Value.GetHistogram(Metric));
+			}
+		}
+
+		for (const TPair<FGuid, FFlowTelemetryHistogram>& Node : Telemetry.Value.Nodes)
+		{
+			AddRow(Csv, Telemetry.Value.TemplateName, Node.Key.ToString(), GetMetricName(EFlowTelemetryMetric::NodeActiveDuration), Node.Value);
+		}
+	}
+
+	const FString FilePath = InFilePath.IsEmpty()
+		? FPaths::ProfilingDir() / TEXT("Flow") / FString::Printf(TEXT("FlowTelemetry-%s.csv"), *FDateTime::Now().ToString())
+		: InFilePath;
+
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Flow Telemetry: can't write %s"), *FilePath);
+		return FString();
+	}
+
+	UE_LOG(LogFlow, Display, TEXT("Flow Telemetry: %d templates written to %s"), TemplateTelemetry.Num(), *FilePath);
+	return FilePath;
+}
+
+void FFlowTelemetry::Report()
+{
+	for (const TPair<FObjectKey, FFlowTemplateTelemetry>& Telemetry : TemplateTelemetry)
+	{
+		OnReport.Broadcast(Telemetry.Value);
+	}
+}
+
+namespace FlowTelemetry
+{
+	EFlowTelemetryMetric ParseMetric(const TArray<FString>& Args)
+	{
+		if (Args.IsValidIndex(0))
+		{
+			for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(EFlowTelemetryMetric::Max); MetricIndex++)
+			{
+				const EFlowTelemetryMetric Metric = static_cast<EFlowTelemetryMetric>(MetricIndex);
+				if (Args[0].Equals(FFlowTelemetry::GetMetricName(Metric), ESearchCase::IgnoreCase))
+				{
+					return Metric;
+				}
+			}
+		}
+
+		return EFlowTelemetryMetric::InstanceLifetime;
+	}
+}
+
+static FAutoConsoleCommand FlowTelemetryStartCommand(
+	TEXT("Flow.Telemetry.Start"),
+	TEXT("Starts gathering histograms of Flow instance lifetime, latency and wait times per template"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowTelemetry::SetEnabled, true));
+
+static FAutoConsoleCommand FlowTelemetryStopCommand(
+	TEXT("Flow.Telemetry.Stop"),
+	TEXT("Stops Flow Telemetry, gathered data is kept until Flow.Telemetry.Reset"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowTelemetry::SetEnabled, false));
+
+static FAutoConsoleCommand FlowTelemetryResetCommand(
+	TEXT("Flow.Telemetry.Reset"),
+	TEXT("Clears data gathered by Flow Telemetry"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowTelemetry::Reset));
+
+static FAutoConsoleCommand FlowTelemetryDumpCommand(
+	TEXT("Flow.Telemetry.Dump"),
+	TEXT("Logs Flow templates sorted by the 95th percentile. Arguments: [InstanceLifetime|FirstOutputLatency|NodeActiveDuration|TriggerQueueDelay|AsyncLoadWait] [MaxEntries=20]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 MaxEntries = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 20;
+		FFlowTelemetry::Dump(FlowTelemetry::ParseMetric(Args), MaxEntries);
+	}));
+
+static FAutoConsoleCommand FlowTelemetryExportCommand(
+	TEXT("Flow.Telemetry.Export"),
+	TEXT("Writes percentiles of every Flow template and node to the CSV file. Arguments: [FilePath]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FFlowTelemetry::Export(Args.IsValidIndex(0) ? Args[0] : FString());
+	}));
+
+static FAutoConsoleCommand FlowTelemetryReportCommand(
+	TEXT("Flow.Telemetry.Report"),
+	TEXT("Sends gathered Flow Telemetry to listeners of FFlowTelemetry::OnReport"),
+	FConsoleCommandDelegate::CreateStatic(&FFlowTelemetry::Report));
+#endif
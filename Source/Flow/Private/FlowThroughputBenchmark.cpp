@@ -0,0 +1,165 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowBenchmarkGraphs.h"
+#include "FlowLogChannels.h"
+#include "FlowSubsystem.h"
+#include "FlowTags.h"
+#include "Nodes/Actor/FlowNode_OnActorRegistered.h"
+#include "Nodes/Route/FlowNode_Reroute.h"
+#include "Nodes/Route/FlowNode_Timer.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectHash.h"
+
+#if !UE_BUILD_SHIPPING
+namespace FlowThroughputBenchmark
+{
+	struct FScenarioTimes
+	{
+		double Create = 0.0;
+		double Start = 0.0;
+		double Finish = 0.0;
+		double GarbageCollection = 0.0;
+		int64 InstanceBytes = 0;
+	};
+
+	// Instance with its node copies and everything else outered to it
+	int64 GetInstanceBytes(UFlowAsset* Instance)
+	{
+		TArray<UObject*> Objects;
+		GetObjectsWithOuter(Instance, Objects, true);
+		Objects.Add(Instance);
+
+		int64 Bytes = 0;
+		for (UObject* Object : Objects)
+		{
+			FArchiveCountMem CountMem(Object);
+			Bytes += CountMem.GetMax();
+		}
+		return Bytes;
+	}
+
+	void RunScenario(const TCHAR* Name, const FFlowBenchmarkGraphs::FGraph& Graph, UFlowSubsystem& FlowSubsystem, const TArray<TStrongObjectPtr<UObject>>& Owners, const int32 Iterations)
+	{
+		FScenarioTimes Total;
+
+		TArray<UFlowAsset*> Instances;
+		Instances.Reserve(Owners.Num());
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Instances.Reset();
+
+			double StartTime = FPlatformTime::Seconds();
+			for (const TStrongObjectPtr<UObject>& Owner : Owners)
+			{
+				if (UFlowAsset* Instance = FlowSubsystem.CreateRootFlow(Owner.Get(), Graph.Asset, true))
+				{
+					Instances.Add(Instance);
+				}
+			}
+			Total.Create += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (UFlowAsset* Instance : Instances)
+			{
+				Instance->StartFlow();
+			}
+			Total.Start += FPlatformTime::Seconds() - StartTime;
+
+			// finished graphs remove their instance already, the remaining ones are latent
+			for (UFlowAsset* Instance : FlowSubsystem.GetRootInstancesViewByOwner(Owners[0].Get()))
+			{
+				if (Instance->GetTemplateAsset() == Graph.Asset)
+				{
+					Total.InstanceBytes += GetInstanceBytes(Instance);
+				}
+			}
+
+			StartTime = FPlatformTime::Seconds();
+			for (const TStrongObjectPtr<UObject>& Owner : Owners)
+			{
+				FlowSubsystem.FinishRootFlow(Owner.Get(), Graph.Asset, EFlowFinishPolicy::Abort);
+			}
+			Total.Finish += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+			Total.GarbageCollection += FPlatformTime::Seconds() - StartTime;
+		}
+
+		const double Roots = static_cast<double>(Owners.Num()) * Iterations;
+		const double CreatedInstances = Roots * Graph.InstancesPerRoot;
+		const double Triggers = Roots * Graph.TriggersPerInstance;
+
+		UE_LOG(LogFlow, Display, TEXT("  %-14s %10.0f triggers/s %10.0f instances/s, create %.3f ms, start %.3f ms, finish %.3f ms, GC %.3f ms, %lld bytes per latent instance"),
+			Name,
+			Total.Start > 0.0 ? Triggers / Total.Start : 0.0,
+			Total.Create + Total.Start > 0.0 ? CreatedInstances / (Total.Create + Total.Start) : 0.0,
+			Total.Create * 1000.0 / Iterations,
+			Total.Start * 1000.0 / Iterations,
+			Total.Finish * 1000.0 / Iterations,
+			Total.GarbageCollection * 1000.0 / Iterations,
+			Total.InstanceBytes / Iterations);
+	}
+
+	void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UFlowSubsystem* FlowSubsystem = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UFlowSubsystem>() : nullptr;
+		if (FlowSubsystem == nullptr)
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Flow.Benchmark.Throughput requires a game world with the Flow Subsystem"));
+			return;
+		}
+
+		const int32 RootFlows = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+		const int32 Iterations = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 5;
+		const int32 Size = Args.IsValidIndex(2) ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, 12) : 6;
+
+		// a single root flow per owner and template is allowed, owners are outered to the world so nodes can find it
+		TArray<TStrongObjectPtr<UObject>> Owners;
+		Owners.Reserve(RootFlows);
+		for (int32 Index = 0; Index < RootFlows; Index++)
+		{
+			Owners.Emplace(NewObject<UObject>(World, UObject::StaticClass(), NAME_None, RF_Transient));
+		}
+
+		UE_LOG(LogFlow, Display, TEXT("Flow.Benchmark.Throughput: %d root flows, %d iterations, size %d"), RootFlows, Iterations, Size);
+
+		RunScenario(TEXT("Chain"), FFlowBenchmarkGraphs::MakeChain(1 << Size), *FlowSubsystem, Owners, Iterations);
+
+		RunScenario(TEXT("FanOut"), FFlowBenchmarkGraphs::MakeFanOut(TEXT("FlowBenchmark_FanOut"), Size, [](UFlowAsset& Asset)
+		{
+			return FFlowBenchmarkGraphs::AddNode<UFlowNode_Reroute>(Asset);
+		}, UFlowNode::DefaultInputPin.PinName), *FlowSubsystem, Owners, Iterations);
+
+		RunScenario(TEXT("Timers"), FFlowBenchmarkGraphs::MakeFanOut(TEXT("FlowBenchmark_Timers"), Size, [](UFlowAsset& Asset)
+		{
+			return FFlowBenchmarkGraphs::AddNode<UFlowNode_Timer>(Asset);
+		}, UFlowNode::DefaultInputPin.PinName), *FlowSubsystem, Owners, Iterations);
+
+		// observed tag isn't used by any component, so observers stay active until the flow is aborted
+		RunScenario(TEXT("Observers"), FFlowBenchmarkGraphs::MakeFanOut(TEXT("FlowBenchmark_Observers"), Size, [](UFlowAsset& Asset)
+		{
+			UFlowNode_OnActorRegistered* Observer = FFlowBenchmarkGraphs::AddNode<UFlowNode_OnActorRegistered>(Asset);
+			Observer->SetIdentityTags(FGameplayTagContainer(FlowNodeStyle::Node));
+			return Observer;
+		}, TEXT("Start")), *FlowSubsystem, Owners, Iterations);
+
+		RunScenario(TEXT("SubGraphs"), FFlowBenchmarkGraphs::MakeNestedSubGraphs(Size), *FlowSubsystem, Owners, Iterations);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs FlowThroughputBenchmarkCommand(
+	TEXT("Flow.Benchmark.Throughput"),
+	TEXT("Starts and aborts root flows of synthetic graphs: chain, fan-out, timers, observers and nested sub graphs. ")
+	TEXT("Reports triggers and created instances per second, memory per latent instance and GC time. ")
+	TEXT("Arguments: [RootFlows=1000] [Iterations=5] [Size=6], size is log2 of chain length and fan-out width, or sub graph depth. ")
+	TEXT("Runs headless with -nullrhi -ExecCmds=\"Flow.Benchmark.Throughput\""),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FlowThroughputBenchmark::Run));
+#endif
@@ -0,0 +1,489 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowTimerWheel.h"
+
+FFlowTimerHandle FFlowTimerWheel::SetTimer(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate, const float Rate, const bool bLoop, const float FirstDelay)
+{
+	if (Rate <= 0.f)
+	{
+		return FFlowTimerHandle();
+	}
+
+	return AddTimer(Owner, MoveTemp(Delegate), Rate, bLoop, FirstDelay >= 0.f ? FirstDelay : Rate);
+}
+
+FFlowTimerHandle FFlowTimerWheel::SetTimerForNextTick(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate)
+{
+	return AddTimer(Owner, MoveTemp(Delegate), 0.0, false, 0.0);
+}
+
+void FFlowTimerWheel::ClearTimer(FFlowTimerHandle& Handle)
+{
+	if (Find(Handle))
+	{
+		RemoveTimer(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+void FFlowTimerWheel::ClearTimers(const FObjectKey& Owner)
+{
+	if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+	{
+		// removing timers modifies the owner's list
+		const TArray<int32, TInlineAllocator<2>> TimersToRemove = *OwnerTimers;
+		for (const int32 Index : TimersToRemove)
+		{
+			RemoveTimer(Index);
+		}
+	}
+
+	PausedOwners.Remove(Owner);
+	OwnerIntervals.Remove(Owner);
+}
+
+bool FFlowTimerWheel::IsTimerActive(const FFlowTimerHandle& Handle) const
+{
+	const FTimer* Timer = Find(Handle);
+	return Timer && !Timer->bPaused;
+}
+
+float FFlowTimerWheel::GetTimerRemaining(const FFlowTimerHandle& Handle) const
+{
+	if (const FTimer* Timer = Find(Handle))
+	{
+		return static_cast<float>(Timer->bPaused ? Timer->PausedRemaining : FMath::Max(Timer->ExpireTime - Time, 0.0));
+	}
+
+	return -1.f;
+}
+
+float FFlowTimerWheel::GetTimerElapsed(const FFlowTimerHandle& Handle) const
+{
+	if (const FTimer* Timer = Find(Handle))
+	{
+		const double Remaining = Timer->bPaused ? Timer->PausedRemaining : FMath::Max(Timer->ExpireTime - Time, 0.0);
+		return static_cast<float>(FMath::Max(Timer->Rate - Remaining, 0.0));
+	}
+
+	return -1.f;
+}
+
+void FFlowTimerWheel::PauseTimers(const FObjectKey& Owner)
+{
+	bool bAlreadyPaused = false;
+	PausedOwners.Add(Owner, &bAlreadyPaused);
+	if (bAlreadyPaused)
+	{
+		return;
+	}
+
+	if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+	{
+		for (const int32 Index : *OwnerTimers)
+		{
+			FTimer& Timer = Timers[Index];
+			Timer.PausedRemaining = FMath::Max(Timer.ExpireTime - Time, 0.0);
+			Timer.PauseTime = Time;
+			Timer.bPaused = true;
+
+			// entries left in the wheel are skipped
+			Timer.ScheduleSerial = NextSerial++;
+			ActiveTimersNum--;
+		}
+	}
+}
+
+void FFlowTimerWheel::UnPauseTimers(const FObjectKey& Owner, const bool bCatchUp)
+{
+	if (PausedOwners.Remove(Owner) == 0)
+	{
+		return;
+	}
+
+	if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+	{
+		for (const int32 Index : *OwnerTimers)
+		{
+			FTimer& Timer = Timers[Index];
+			// expiration time in the past is scheduled for the next tick, looping timers fire multiple times then
+			Timer.ExpireTime = (bCatchUp ? Timer.PauseTime : Time) + Timer.PausedRemaining;
+			Timer.bPaused = false;
+			ActiveTimersNum++;
+
+			Schedule(Index);
+		}
+	}
+}
+
+void FFlowTimerWheel::SetTimersInterval(const FObjectKey& Owner, const double Interval)
+{
+	if (Interval > Resolution)
+	{
+		double& OwnerInterval = OwnerIntervals.FindOrAdd(Owner);
+		if (OwnerInterval == Interval)
+		{
+			return;
+		}
+		OwnerInterval = Interval;
+	}
+	else if (OwnerIntervals.Remove(Owner) == 0)
+	{
+		return;
+	}
+
+	if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+	{
+		for (const int32 Index : *OwnerTimers)
+		{
+			if (!Timers[Index].bPaused)
+			{
+				Schedule(Index);
+			}
+		}
+	}
+}
+
+int32 FFlowTimerWheel::Advance(const double DeltaTime)
+{
+	Time += FMath::Max(DeltaTime, 0.0);
+	const uint64 TargetTick = static_cast<uint64>(Time / Resolution);
+
+	if (ActiveTimersNum == 0)
+	{
+		// nothing to fire, stale entries are dropped whenever their slots are reached
+		CurrentTick = FMath::Max(CurrentTick, TargetTick);
+		return 0;
+	}
+
+	TArray<FSlotEntry, TInlineAllocator<64>> Expired;
+	while (CurrentTick < TargetTick)
+	{
+		CurrentTick++;
+
+		// higher levels are moved down as the lower level wraps around
+		for (int32 Level = LevelsNum - 1; Level > 0; Level--)
+		{
+			if ((CurrentTick & ((uint64(1) << (SlotBits * Level)) - 1)) == 0)
+			{
+				Cascade(Level);
+			}
+		}
+
+		TArray<FSlotEntry>& Slot = Slots[0][CurrentTick & (SlotsPerLevel - 1)];
+		for (const FSlotEntry& Entry : Slot)
+		{
+			if (IsEntryValid(Entry))
+			{
+				Expired.Add(Entry);
+			}
+		}
+		Slot.Reset();
+	}
+
+	if (Expired.Num() > 1)
+	{
+		Expired.Sort([this](const FSlotEntry& A, const FSlotEntry& B)
+		{
+			const FTimer& TimerA = Timers[A.Index];
+			const FTimer& TimerB = Timers[B.Index];
+			return TimerA.ExpireTime < TimerB.ExpireTime || (TimerA.ExpireTime == TimerB.ExpireTime && TimerA.Serial < TimerB.Serial);
+		});
+	}
+
+	int32 FiredNum = 0;
+	for (const FSlotEntry& Entry : Expired)
+	{
+		// earlier callbacks might have cleared, paused or restarted this timer
+		if (!IsEntryValid(Entry))
+		{
+			continue;
+		}
+
+		FTimer& Timer = Timers[Entry.Index];
+		if (Timer.bLoop)
+		{
+			// long frames fire the looping timer multiple times, like FTimerManager does
+			const int32 CallCount = 1 + FMath::Max(FMath::FloorToInt32((Time - Timer.ExpireTime) / Timer.Rate), 0);
+			Timer.ExpireTime += CallCount * Timer.Rate;
+			Schedule(Entry.Index);
+
+			const uint32 ScheduleSerial = Timer.ScheduleSerial;
+
+			// callbacks might add timers and reallocate the array
+			const FFlowTimerDelegate Delegate = Timer.Delegate;
+			for (int32 CallIndex = 0; CallIndex < CallCount; CallIndex++)
+			{
+				FiredNum++;
+				Delegate.ExecuteIfBound();
+
+				if (!Timers.IsValidIndex(Entry.Index) || Timers[Entry.Index].ScheduleSerial != ScheduleSerial)
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			const FFlowTimerDelegate Delegate = MoveTemp(Timer.Delegate);
+			RemoveTimer(Entry.Index);
+
+			FiredNum++;
+			Delegate.ExecuteIfBound();
+		}
+	}
+
+	return FiredNum;
+}
+
+int32 FFlowTimerWheel::FastForwardTimers(const FObjectKey& Owner, const double DeltaTime)
+{
+	// timers added by callbacks from this point are told apart by serial
+	const uint32 FirstAddedSerial = NextSerial;
+
+	double TimeLeft = FMath::Max(DeltaTime, 0.0);
+	int32 FiredNum = 0;
+
+	auto ShiftOwnerTimers = [this, &Owner](const double Step)
+	{
+		if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+		{
+			for (const int32 Index : *OwnerTimers)
+			{
+				FTimer& Timer = Timers[Index];
+				if (Timer.bPaused)
+				{
+					Timer.PausedRemaining = FMath::Max(Timer.PausedRemaining - Step, 0.0);
+				}
+				else
+				{
+					Timer.ExpireTime -= Step;
+				}
+			}
+		}
+	};
+
+	while (true)
+	{
+		const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner);
+		if (OwnerTimers == nullptr)
+		{
+			break;
+		}
+
+		// the list changes with every callback, so the earliest timer is searched again, owners rarely have more than a few timers
+		int32 NextIndex = INDEX_NONE;
+		double NextRemaining = TimeLeft;
+		for (const int32 Index : *OwnerTimers)
+		{
+			const FTimer& Timer = Timers[Index];
+			if (Timer.Rate <= 0.0 && Timer.Serial >= FirstAddedSerial)
+			{
+				// otherwise the callback setting the timer for the next tick again would never let this end
+				continue;
+			}
+
+			const double Remaining = FMath::Max(GetRemaining(Timer), 0.0);
+			if (Remaining < NextRemaining || (Remaining == NextRemaining && (NextIndex == INDEX_NONE || Timer.Serial < Timers[NextIndex].Serial)))
+			{
+				NextIndex = Index;
+				NextRemaining = Remaining;
+			}
+		}
+
+		if (NextIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		ShiftOwnerTimers(NextRemaining);
+		TimeLeft -= NextRemaining;
+
+		FTimer& Timer = Timers[NextIndex];
+		FiredNum++;
+
+		if (Timer.bLoop)
+		{
+			if (Timer.bPaused)
+			{
+				Timer.PausedRemaining += Timer.Rate;
+			}
+			else
+			{
+				Timer.ExpireTime = FMath::Max(Timer.ExpireTime, Time) + Timer.Rate;
+			}
+
+			// callbacks might add timers and reallocate the array
+			const FFlowTimerDelegate Delegate = Timer.Delegate;
+			Delegate.ExecuteIfBound();
+		}
+		else
+		{
+			const FFlowTimerDelegate Delegate = MoveTemp(Timer.Delegate);
+			RemoveTimer(NextIndex);
+			Delegate.ExecuteIfBound();
+		}
+	}
+
+	ShiftOwnerTimers(TimeLeft);
+
+	// wheel entries still point to the expiration before shifting
+	if (const TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Owner))
+	{
+		for (const int32 Index : *OwnerTimers)
+		{
+			if (!Timers[Index].bPaused)
+			{
+				Schedule(Index);
+			}
+		}
+	}
+
+	return FiredNum;
+}
+
+void FFlowTimerWheel::Reset()
+{
+	Timers.Empty();
+	for (int32 Level = 0; Level < LevelsNum; Level++)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < SlotsPerLevel; SlotIndex++)
+		{
+			Slots[Level][SlotIndex].Empty();
+		}
+	}
+
+	TimersPerOwner.Empty();
+	PausedOwners.Empty();
+	OwnerIntervals.Empty();
+
+	Time = 0.0;
+	CurrentTick = 0;
+	ActiveTimersNum = 0;
+}
+
+FFlowTimerHandle FFlowTimerWheel::AddTimer(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate, const double Rate, const bool bLoop, const double Delay)
+{
+	const int32 Index = Timers.Add(FTimer());
+
+	FTimer& Timer = Timers[Index];
+	Timer.Delegate = MoveTemp(Delegate);
+	Timer.Owner = Owner;
+	Timer.ExpireTime = Time + Delay;
+	Timer.Rate = Rate;
+	Timer.Serial = NextSerial++;
+	Timer.bLoop = bLoop;
+
+	TimersPerOwner.FindOrAdd(Owner).Add(Index);
+
+	if (PausedOwners.Contains(Owner))
+	{
+		Timer.PausedRemaining = Delay;
+		Timer.PauseTime = Time;
+		Timer.bPaused = true;
+	}
+	else
+	{
+		ActiveTimersNum++;
+		Schedule(Index);
+	}
+
+	FFlowTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Timer.Serial;
+	return Handle;
+}
+
+void FFlowTimerWheel::RemoveTimer(const int32 Index)
+{
+	const FTimer& Timer = Timers[Index];
+	if (!Timer.bPaused)
+	{
+		ActiveTimersNum--;
+	}
+
+	if (TArray<int32, TInlineAllocator<2>>* OwnerTimers = TimersPerOwner.Find(Timer.Owner))
+	{
+		OwnerTimers->RemoveSingleSwap(Index);
+		if (OwnerTimers->IsEmpty())
+		{
+			TimersPerOwner.Remove(Timer.Owner);
+		}
+	}
+
+	// entries left in the wheel are skipped, as the index is either free or used by the timer of another serial
+	Timers.RemoveAt(Index);
+}
+
+void FFlowTimerWheel::Schedule(const int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.ScheduleSerial = NextSerial++;
+
+	// throttled owners fire at multiples of their interval, ExpireTime stays exact, so remaining time and looping don't drift
+	double FireTime = Timer.ExpireTime;
+	if (!OwnerIntervals.IsEmpty())
+	{
+		if (const double* Interval = OwnerIntervals.Find(Timer.Owner))
+		{
+			FireTime = FMath::CeilToDouble(FireTime / *Interval) * *Interval;
+		}
+	}
+
+	// rounding up never fires the timer early, and the timer set now never fires in the tick already processed
+	Timer.ExpireTick = FMath::Max(CurrentTick + 1, static_cast<uint64>(FMath::CeilToDouble(FireTime / Resolution)));
+
+	InsertEntry({Index, Timer.ScheduleSerial}, Timer.ExpireTick);
+}
+
+void FFlowTimerWheel::InsertEntry(const FSlotEntry& Entry, const uint64 ExpireTick)
+{
+	// timers beyond the range of the wheel wait in its furthest slot, and are inserted again once it cascades
+	constexpr uint64 MaxDelta = (uint64(1) << (SlotBits * LevelsNum)) - 1;
+	const uint64 Delta = FMath::Min(ExpireTick - CurrentTick, MaxDelta);
+	const uint64 SlotTick = CurrentTick + Delta;
+
+	int32 Level = 0;
+	while (Level < LevelsNum - 1 && Delta >= (uint64(1) << (SlotBits * (Level + 1))))
+	{
+		Level++;
+	}
+
+	Slots[Level][(SlotTick >> (SlotBits * Level)) & (SlotsPerLevel - 1)].Add(Entry);
+}
+
+void FFlowTimerWheel::Cascade(const int32 Level)
+{
+	TArray<FSlotEntry>& Slot = Slots[Level][(CurrentTick >> (SlotBits * Level)) & (SlotsPerLevel - 1)];
+	if (Slot.IsEmpty())
+	{
+		return;
+	}
+
+	// entries land on lower levels, or other slots of the top level, so the slot can be emptied up front
+	const TArray<FSlotEntry> Entries = MoveTemp(Slot);
+
+	for (const FSlotEntry& Entry : Entries)
+	{
+		if (IsEntryValid(Entry))
+		{
+			InsertEntry(Entry, Timers[Entry.Index].ExpireTick);
+		}
+	}
+}
+
+bool FFlowTimerWheel::IsEntryValid(const FSlotEntry& Entry) const
+{
+	return Timers.IsValidIndex(Entry.Index) && Timers[Entry.Index].ScheduleSerial == Entry.ScheduleSerial && !Timers[Entry.Index].bPaused;
+}
+
+FFlowTimerWheel::FTimer* FFlowTimerWheel::Find(const FFlowTimerHandle& Handle)
+{
+	return Timers.IsValidIndex(Handle.Index) && Timers[Handle.Index].Serial == Handle.Serial ? &Timers[Handle.Index] : nullptr;
+}
+
+const FFlowTimerWheel::FTimer* FFlowTimerWheel::Find(const FFlowTimerHandle& Handle) const
+{
+	return Timers.IsValidIndex(Handle.Index) && Timers[Handle.Index].Serial == Handle.Serial ? &Timers[Handle.Index] : nullptr;
+}
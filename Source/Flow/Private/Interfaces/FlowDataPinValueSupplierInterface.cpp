@@ -0,0 +1,10 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Interfaces/FlowDataPinValueSupplierInterface.h"
+#include "Types/FlowBlueprintEvents.h"
+
+bool IFlowDataPinValueSupplierInterface::IsNativeSupplier(const UObject* Supplier)
+{
+	const UClass* SupplierClass = Supplier->GetClass();
+	return SupplierClass->HasAnyClassFlags(CLASS_Native) || FFlowBlueprintEvents::Get(*SupplierClass)->bNativeDataPinSupplier;
+}
@@ -0,0 +1,68 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/Actor/FlowNode_BatchNotifyActors.h"
+#include "FlowSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_BatchNotifyActors)
+
+UFlowNode_BatchNotifyActors::UFlowNode_BatchNotifyActors(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, NetMode(EFlowNetMode::Authority)
+{
+#if WITH_EDITOR
+	Category = TEXT("Actor");
+#endif
+}
+
+void UFlowNode_BatchNotifyActors::ExecuteInput(const FName& PinName)
+{
+	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->BatchNotifyActorsInWorld(GetWorld(), Notifies, NetMode);
+	}
+
+	TriggerFirstOutput(true);
+}
+
+#if WITH_EDITOR
+FString UFlowNode_BatchNotifyActors::GetNodeDescription() const
+{
+	FString Description;
+	for (const FFlowActorNotify& Notify : Notifies)
+	{
+		if (!Description.IsEmpty())
+		{
+			Description.Append(LINE_TERMINATOR);
+		}
+
+		Description.Append(GetIdentityTagDescription(Notify.ActorTag)).Append(TEXT(" -> ")).Append(Notify.NotifyTag.IsValid() ? Notify.NotifyTag.ToString() : MissingNotifyTag);
+	}
+	return Description;
+}
+
+EDataValidationResult UFlowNode_BatchNotifyActors::ValidateNode()
+{
+	if (Notifies.IsEmpty())
+	{
+		ValidationLog.Error<UFlowNode>(TEXT("No notifies to send"), this);
+		return EDataValidationResult::Invalid;
+	}
+
+	for (const FFlowActorNotify& Notify : Notifies)
+	{
+		if (!Notify.ActorTag.IsValid())
+		{
+			ValidationLog.Error<UFlowNode>(*UFlowNode::MissingIdentityTag, this);
+			return EDataValidationResult::Invalid;
+		}
+
+		if (!Notify.NotifyTag.IsValid())
+		{
+			ValidationLog.Error<UFlowNode>(*UFlowNode::MissingNotifyTag, this);
+			return EDataValidationResult::Invalid;
+		}
+	}
+
+	return EDataValidationResult::Valid;
+}
+#endif
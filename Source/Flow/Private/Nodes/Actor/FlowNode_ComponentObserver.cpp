@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Actor/FlowNode_ComponentObserver.h"
+#include "FlowComponent.h"
 #include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ComponentObserver)
@@ -22,7 +23,7 @@ UFlowNode_ComponentObserver::UFlowNode_ComponentObserver(const FObjectInitialize
 
 void UFlowNode_ComponentObserver::ExecuteInput(const FName& PinName)
 {
-	if (IdentityTags.IsValid())
+	if (HasIdentityFilter())
 	{
 		if (PinName == TEXT("Start"))
 		{
@@ -41,7 +42,7 @@ void UFlowNode_ComponentObserver::ExecuteInput(const FName& PinName)
 
 void UFlowNode_ComponentObserver::OnLoad_Implementation()
 {
-	if (IdentityTags.IsValid())
+	if (HasIdentityFilter())
 	{
 		StartObserving();
 	}
@@ -49,17 +50,36 @@ void UFlowNode_ComponentObserver::OnLoad_Implementation()
 
 void UFlowNode_ComponentObserver::StartObserving()
 {
-	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr || LiveQueryHandle.IsValid())
+	{
+		return;
+	}
+
+	// subsystem keeps track of components matching our Identity Tags
+	FFlowComponentLiveQuery LiveQuery;
+	LiveQuery.Tags = IdentityTags;
+	LiveQuery.MatchType = IdentityMatchType;
+	if (UsesIdentityTagQuery())
 	{
-		// translate Flow name into engine types
-		const EGameplayContainerMatchType ContainerMatchType = (IdentityMatchType == EFlowTagContainerMatchType::HasAny || IdentityMatchType == EFlowTagContainerMatchType::HasAnyExact) ? EGameplayContainerMatchType::Any : EGameplayContainerMatchType::All;
-		const bool bExactMatch = (IdentityMatchType == EFlowTagContainerMatchType::HasAnyExact || IdentityMatchType == EFlowTagContainerMatchType::HasAllExact);
+		LiveQuery.TagQuery = IdentityTagQuery;
+	}
+	LiveQuery.OnComponentAdded.BindUObject(this, &UFlowNode_ComponentObserver::OnComponentRegistered);
+	LiveQuery.OnComponentRemoved.BindUObject(this, &UFlowNode_ComponentObserver::OnComponentUnregistered);
+
+	LiveQueryHandle = FlowSubsystem->CreateLiveQuery(LiveQuery);
 
-		// collect already registered components
-		for (const TWeakObjectPtr<UFlowComponent>& FoundComponent : FlowSubsystem->GetComponents<UFlowComponent>(IdentityTags, ContainerMatchType, bExactMatch))
+	// collect already registered components
+	if (const TSet<TWeakObjectPtr<UFlowComponent>>* FoundComponents = FlowSubsystem->GetLiveQueryComponents(LiveQueryHandle))
+	{
+		// copy, as observing might change the registry
+		for (const TWeakObjectPtr<UFlowComponent>& FoundComponent : FoundComponents->Array())
 		{
-			ObserveActor(FoundComponent->GetOwner(), FoundComponent);
-			
+			if (FoundComponent.IsValid())
+			{
+				OnComponentRegistered(FoundComponent.Get());
+			}
+
 			// node might finish work immediately as the effect of ObserveActor()
 			// we should terminate iteration in this case
 			if (GetActivationState() != EFlowNodeState::Active)
@@ -67,11 +87,6 @@ void UFlowNode_ComponentObserver::StartObserving()
 				return;
 			}
 		}
-		
-		FlowSubsystem->OnComponentRegistered.AddUniqueDynamic(this, &UFlowNode_ComponentObserver::OnComponentRegistered);
-		FlowSubsystem->OnComponentTagAdded.AddUniqueDynamic(this, &UFlowNode_ComponentObserver::OnComponentTagAdded);
-		FlowSubsystem->OnComponentTagRemoved.AddUniqueDynamic(this, &UFlowNode_ComponentObserver::OnComponentTagRemoved);
-		FlowSubsystem->OnComponentUnregistered.AddUniqueDynamic(this, &UFlowNode_ComponentObserver::OnComponentUnregistered);
 	}
 }
 
@@ -79,16 +94,41 @@ void UFlowNode_ComponentObserver::StopObserving()
 {
 	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		FlowSubsystem->OnComponentRegistered.RemoveAll(this);
-		FlowSubsystem->OnComponentUnregistered.RemoveAll(this);
-		FlowSubsystem->OnComponentTagAdded.RemoveAll(this);
-		FlowSubsystem->OnComponentTagRemoved.RemoveAll(this);
+		FlowSubsystem->DestroyLiveQuery(LiveQueryHandle);
+	}
+	LiveQueryHandle.Reset();
+}
+
+bool UFlowNode_ComponentObserver::MatchesIdentity(const UFlowComponent* Component) const
+{
+	if (UsesIdentityTagQuery())
+	{
+		return IdentityTagQuery.Matches(Component->IdentityTags);
+	}
+
+	return FlowTypes::HasMatchingTags(Component->IdentityTags, IdentityTags, IdentityMatchType);
+}
+
+void UFlowNode_ComponentObserver::OnComponentsRegistered(const TArray<UFlowComponent*>& Components)
+{
+	for (UFlowComponent* Component : Components)
+	{
+		if (Component && MatchesIdentity(Component))
+		{
+			OnComponentRegistered(Component);
+		}
+
+		// node might finish work as the effect of ObserveActor()
+		if (GetActivationState() != EFlowNodeState::Active)
+		{
+			return;
+		}
 	}
 }
 
 void UFlowNode_ComponentObserver::OnComponentRegistered(UFlowComponent* Component)
 {
-	if (!RegisteredActors.Contains(Component->GetOwner()) && FlowTypes::HasMatchingTags(Component->IdentityTags, IdentityTags, IdentityMatchType) == true)
+	if (!RegisteredActors.Contains(Component->GetOwner()))
 	{
 		ObserveActor(Component->GetOwner(), Component);
 	}
@@ -96,18 +136,17 @@ void UFlowNode_ComponentObserver::OnComponentRegistered(UFlowComponent* Componen
 
 void UFlowNode_ComponentObserver::OnComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
 {
-	if (!RegisteredActors.Contains(Component->GetOwner()) && FlowTypes::HasMatchingTags(Component->IdentityTags, IdentityTags, IdentityMatchType) == true)
+	if (Component && MatchesIdentity(Component))
 	{
-		ObserveActor(Component->GetOwner(), Component);
+		OnComponentRegistered(Component);
 	}
 }
 
 void UFlowNode_ComponentObserver::OnComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
 {
-	if (RegisteredActors.Contains(Component->GetOwner()) && FlowTypes::HasMatchingTags(Component->IdentityTags, IdentityTags, IdentityMatchType) == false)
+	if (Component && !MatchesIdentity(Component))
 	{
-		RegisteredActors.Remove(Component->GetOwner());
-		ForgetActor(Component->GetOwner(), Component);
+		OnComponentUnregistered(Component);
 	}
 }
 
@@ -152,12 +191,17 @@ void UFlowNode_ComponentObserver::Cleanup()
 #if WITH_EDITOR
 FString UFlowNode_ComponentObserver::GetNodeDescription() const
 {
+	if (UsesIdentityTagQuery())
+	{
+		return IdentityTagQuery.GetDescription();
+	}
+
 	return GetIdentityTagsDescription(IdentityTags);
 }
 
 EDataValidationResult UFlowNode_ComponentObserver::ValidateNode()
 {
-	if (IdentityTags.IsEmpty())
+	if (!HasIdentityFilter())
 	{
 		ValidationLog.Error<UFlowNode>(*UFlowNode::MissingIdentityTag, this);
 		return EDataValidationResult::Invalid;
@@ -7,6 +7,7 @@
 #include "FlowAsset.h"
 #include "FlowLogChannels.h"
 #include "FlowSettings.h"
+#include "FlowSubsystem.h"
 #include "Types/FlowInjectComponentsHelper.h"
 #include "Types/FlowInjectComponentsManager.h"
 #include "GameFramework/Actor.h"
@@ -33,13 +34,13 @@ void UFlowNode_ExecuteComponent::InitializeInstance()
 
 	(void) TryInjectComponent();
 
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->InitializeInstance();
+			NativeCoreExecutable->InitializeInstance();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_InitializeInstance(ResolvedComp);
 		}
@@ -48,13 +49,13 @@ void UFlowNode_ExecuteComponent::InitializeInstance()
 
 void UFlowNode_ExecuteComponent::DeinitializeInstance()
 {
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->DeinitializeInstance();
+			NativeCoreExecutable->DeinitializeInstance();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_DeinitializeInstance(ResolvedComp);
 		}
@@ -69,6 +70,7 @@ void UFlowNode_ExecuteComponent::DeinitializeInstance()
 	}
 
 	InjectComponentsManager = nullptr;
+	ResetExecutableInterfaces();
 
 	Super::DeinitializeInstance();
 }
@@ -77,13 +79,27 @@ void UFlowNode_ExecuteComponent::PreloadContent()
 {
 	Super::PreloadContent();
 
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	// class of the component is a hard reference, but assets it references softly would be loaded on its first use
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem && PreloadedPaths.IsEmpty())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (const UActorComponent* ComponentDefaults = GetComponentToInjectDefaults())
 		{
-			ComponentAsCoreExecutable->PreloadContent();
+			FFlowInjectComponentsHelper::GatherSoftReferences(*ComponentDefaults, PreloadedPaths);
+			for (const FSoftObjectPath& Path : PreloadedPaths)
+			{
+				FlowSubsystem->AcquirePreload(Path);
+			}
+		}
+	}
+
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
+	{
+		if (NativeCoreExecutable)
+		{
+			NativeCoreExecutable->PreloadContent();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_PreloadContent(ResolvedComp);
 		}
@@ -92,18 +108,27 @@ void UFlowNode_ExecuteComponent::PreloadContent()
 
 void UFlowNode_ExecuteComponent::FlushContent()
 {
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->FlushContent();
+			NativeCoreExecutable->FlushContent();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_FlushContent(ResolvedComp);
 		}
 	}
 
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		for (const FSoftObjectPath& Path : PreloadedPaths)
+		{
+			FlowSubsystem->ReleasePreload(Path);
+		}
+	}
+	PreloadedPaths.Empty();
+
 	Super::FlushContent();
 }
 
@@ -111,15 +136,15 @@ void UFlowNode_ExecuteComponent::OnActivate()
 {
 	Super::OnActivate();
 
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowExternalExecutableInterface* ComponentAsExternalExecutable = Cast<IFlowExternalExecutableInterface>(ResolvedComp))
+		if (NativeExternalExecutable)
 		{
 			// By convention, we must call the PreActivateExternalFlowExecutable() before OnActivate 
 			// when we (this node) are acting as the proxy for an IFlowExternalExecutableInterface object
-			ComponentAsExternalExecutable->PreActivateExternalFlowExecutable(*this);
+			NativeExternalExecutable->PreActivateExternalFlowExecutable(*this);
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptExternalExecutable)
 		{
 			IFlowExternalExecutableInterface::Execute_K2_PreActivateExternalFlowExecutable(ResolvedComp, this);
 		}
@@ -128,11 +153,11 @@ void UFlowNode_ExecuteComponent::OnActivate()
 			UE_LOG(LogFlow, Error, TEXT("Expected a valid UActorComponent that implemented the IFlowExternalExecutableInterface"));
 		}
 
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->OnActivate();
+			NativeCoreExecutable->OnActivate();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_OnActivate(ResolvedComp);
 		}
@@ -145,13 +170,13 @@ void UFlowNode_ExecuteComponent::OnActivate()
 
 void UFlowNode_ExecuteComponent::Cleanup()
 {
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->Cleanup();
+			NativeCoreExecutable->Cleanup();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_Cleanup(ResolvedComp);
 		}
@@ -162,13 +187,13 @@ void UFlowNode_ExecuteComponent::Cleanup()
 
 void UFlowNode_ExecuteComponent::ForceFinishNode()
 {
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->ForceFinishNode();
+			NativeCoreExecutable->ForceFinishNode();
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_ForceFinishNode(ResolvedComp);
 		}
@@ -181,13 +206,13 @@ void UFlowNode_ExecuteComponent::ExecuteInput(const FName& PinName)
 {
 	Super::ExecuteInput(PinName);
 
-	if (UActorComponent* ResolvedComp = TryResolveComponent())
+	if (UActorComponent* ResolvedComp = TryResolveExecutableComponent())
 	{
-		if (IFlowCoreExecutableInterface* ComponentAsCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp))
+		if (NativeCoreExecutable)
 		{
-			ComponentAsCoreExecutable->ExecuteInput(PinName);
+			NativeCoreExecutable->ExecuteInput(PinName);
 		}
-		else if (ResolvedComp->Implements<UFlowCoreExecutableInterface>())
+		else if (bScriptCoreExecutable)
 		{
 			IFlowCoreExecutableInterface::Execute_K2_ExecuteInput(ResolvedComp, PinName);
 		}
@@ -217,6 +242,10 @@ TArray<FFlowPin> UFlowNode_ExecuteComponent::GetContextInputs() const
 			ContextInputs = PinSupplierInterface->GetContextInputs();
 		}
 	}
+	else if (const FFlowExecuteComponentPinCache* PinCache = FindExpectedComponentPins())
+	{
+		ContextInputs = PinCache->InputPins;
+	}
 	else if (const UActorComponent* ExpectedComponent = TryGetExpectedComponent())
 	{
 		if (const IFlowContextPinSupplierInterface* PinSupplierInterface = Cast<IFlowContextPinSupplierInterface>(ExpectedComponent))
@@ -246,6 +275,10 @@ TArray<FFlowPin> UFlowNode_ExecuteComponent::GetContextOutputs() const
 			ContextOutputs = PinSupplierInterface->GetContextOutputs();
 		}
 	}
+	else if (const FFlowExecuteComponentPinCache* PinCache = FindExpectedComponentPins())
+	{
+		ContextOutputs = PinCache->OutputPins;
+	}
 	else if (const UActorComponent* ExpectedComponent = TryGetExpectedComponent())
 	{
 		if (const IFlowContextPinSupplierInterface* PinSupplierInterface = Cast<IFlowContextPinSupplierInterface>(ExpectedComponent))
@@ -537,6 +570,57 @@ FFlowDataPinResult_Class UFlowNode_ExecuteComponent::TrySupplyDataPinAsClass_Imp
 	return Super::TrySupplyDataPinAsClass_Implementation(PinName);
 }
 
+const UActorComponent* UFlowNode_ExecuteComponent::GetComponentToInjectDefaults() const
+{
+	if (ComponentSource == EExecuteComponentSource::InjectFromTemplate && IsValid(ComponentTemplate))
+	{
+		return ComponentTemplate;
+	}
+
+	if (ComponentSource == EExecuteComponentSource::InjectFromClass && IsValid(ComponentClass))
+	{
+		return ComponentClass->GetDefaultObject<UActorComponent>();
+	}
+
+	return nullptr;
+}
+
+const UActorComponent* UFlowNode_ExecuteComponent::GetComponentPoolArchetype() const
+{
+	// instanced template is duplicated for every node instance, so the template of the asset node identifies the pool
+	if (ComponentSource == EExecuteComponentSource::InjectFromTemplate)
+	{
+		const UFlowNode_ExecuteComponent* TemplateNode = Cast<UFlowNode_ExecuteComponent>(GetArchetype());
+		if (TemplateNode && IsValid(TemplateNode->ComponentTemplate))
+		{
+			return TemplateNode->ComponentTemplate;
+		}
+	}
+
+	return GetComponentToInjectDefaults();
+}
+
+UActorComponent* UFlowNode_ExecuteComponent::TryAcquirePooledComponent(AActor& ActorOwner) const
+{
+	const UActorComponent* PoolArchetype = GetComponentPoolArchetype();
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+
+	if (MaxPooledComponents > 0 && PoolArchetype && FlowSubsystem)
+	{
+		return FlowSubsystem->AcquirePooledComponent(ActorOwner, *PoolArchetype);
+	}
+
+	return nullptr;
+}
+
+bool UFlowNode_ExecuteComponent::IsPooledComponent(const UActorComponent& Component) const
+{
+	const UActorComponent* PoolArchetype = GetComponentPoolArchetype();
+	const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+
+	return PoolArchetype && FlowSubsystem && FlowSubsystem->IsPooledComponent(Component, *PoolArchetype);
+}
+
 bool UFlowNode_ExecuteComponent::TryInjectComponent()
 {
 	if (!EExecuteComponentSource_Classifiers::DoesComponentSourceUseInjectManager(ComponentSource))
@@ -561,7 +645,13 @@ bool UFlowNode_ExecuteComponent::TryInjectComponent()
 		{
 			if (IsValid(ComponentTemplate))
 			{
-				if (UActorComponent* ComponentInstance = FFlowInjectComponentsHelper::TryCreateComponentInstanceForActorFromTemplate(*ActorOwner, *ComponentTemplate))
+				UActorComponent* ComponentInstance = TryAcquirePooledComponent(*ActorOwner);
+				if (ComponentInstance == nullptr)
+				{
+					ComponentInstance = FFlowInjectComponentsHelper::TryCreateComponentInstanceForActorFromTemplate(*ActorOwner, *ComponentTemplate);
+				}
+
+				if (ComponentInstance)
 				{
 					ComponentInstances.Add(ComponentInstance);
 				}
@@ -577,8 +667,9 @@ bool UFlowNode_ExecuteComponent::TryInjectComponent()
 				{
 					// Look for the component class existing already on the actor, for potential re-use
 
+					// pooled components are reused below, through the inject manager returning them to the pool
 					UActorComponent* ExistingComponent = ActorOwner->FindComponentByClass(ComponentClass);
-					if (IsValid(ExistingComponent))
+					if (IsValid(ExistingComponent) && !IsPooledComponent(*ExistingComponent))
 					{
 						// Set the ComponentRef directly (for later lookup via TryResolveComponent)
 						ComponentRef.SetResolvedComponentDirect(*ExistingComponent);
@@ -592,8 +683,14 @@ bool UFlowNode_ExecuteComponent::TryInjectComponent()
 					}
 				}
 
-				const FName InstanceBaseName = ComponentClass->GetFName();
-				if (UActorComponent* ComponentInstance = FFlowInjectComponentsHelper::TryCreateComponentInstanceForActorFromClass(*ActorOwner, *ComponentClass, InstanceBaseName))
+				UActorComponent* ComponentInstance = TryAcquirePooledComponent(*ActorOwner);
+				if (ComponentInstance == nullptr)
+				{
+					const FName InstanceBaseName = ComponentClass->GetFName();
+					ComponentInstance = FFlowInjectComponentsHelper::TryCreateComponentInstanceForActorFromClass(*ActorOwner, *ComponentClass, InstanceBaseName);
+				}
+
+				if (ComponentInstance)
 				{
 					ComponentInstances.Add(ComponentInstance);
 				}
@@ -610,6 +707,14 @@ bool UFlowNode_ExecuteComponent::TryInjectComponent()
 	InjectComponentsManager = NewObject<UFlowInjectComponentsManager>(this);
 	InjectComponentsManager->InitializeRuntime();
 
+	if (MaxPooledComponents > 0)
+	{
+		if (const UActorComponent* PoolArchetype = GetComponentPoolArchetype())
+		{
+			InjectComponentsManager->SetComponentPooling(*PoolArchetype, MaxPooledComponents);
+		}
+	}
+
 	// Inject the desired component
 	if (!ComponentInstances.IsEmpty())
 	{
@@ -624,6 +729,35 @@ bool UFlowNode_ExecuteComponent::TryInjectComponent()
 	return true;
 }
 
+UActorComponent* UFlowNode_ExecuteComponent::TryResolveExecutableComponent()
+{
+	UActorComponent* ResolvedComp = TryResolveComponent();
+	if (ResolvedComp != ExecutableComponent.Get())
+	{
+		ResetExecutableInterfaces();
+
+		if (ResolvedComp)
+		{
+			ExecutableComponent = ResolvedComp;
+			NativeCoreExecutable = Cast<IFlowCoreExecutableInterface>(ResolvedComp);
+			NativeExternalExecutable = Cast<IFlowExternalExecutableInterface>(ResolvedComp);
+			bScriptCoreExecutable = NativeCoreExecutable == nullptr && ResolvedComp->Implements<UFlowCoreExecutableInterface>();
+			bScriptExternalExecutable = NativeExternalExecutable == nullptr && ResolvedComp->Implements<UFlowExternalExecutableInterface>();
+		}
+	}
+
+	return ResolvedComp;
+}
+
+void UFlowNode_ExecuteComponent::ResetExecutableInterfaces()
+{
+	ExecutableComponent.Reset();
+	NativeCoreExecutable = nullptr;
+	NativeExternalExecutable = nullptr;
+	bScriptCoreExecutable = false;
+	bScriptExternalExecutable = false;
+}
+
 UActorComponent* UFlowNode_ExecuteComponent::TryResolveComponent()
 {
 	UActorComponent* ResolvedComp = ComponentRef.GetResolvedComponent();
@@ -692,6 +826,48 @@ const UActorComponent* UFlowNode_ExecuteComponent::TryGetExpectedComponent() con
 	}
 }
 
+const FFlowExecuteComponentPinCache* UFlowNode_ExecuteComponent::FindExpectedComponentPins() const
+{
+	// templates and class defaults of injected components are already loaded with the node
+	if (ComponentSource != EExecuteComponentSource::BindToExisting || !ExpectedComponentPins.bIsSet)
+	{
+		return nullptr;
+	}
+
+	if (ExpectedComponentPins.ComponentName != ComponentRef.ComponentName || ExpectedComponentPins.OwnerClass != FSoftClassPath(TryGetExpectedActorOwnerClass()))
+	{
+		return nullptr;
+	}
+
+	return &ExpectedComponentPins;
+}
+
+void UFlowNode_ExecuteComponent::UpdateExpectedComponentPins()
+{
+	ExpectedComponentPins = FFlowExecuteComponentPinCache();
+
+	if (ComponentSource != EExecuteComponentSource::BindToExisting)
+	{
+		return;
+	}
+
+	const UActorComponent* ExpectedComponent = TryGetExpectedComponent();
+	if (!IsValid(ExpectedComponent))
+	{
+		return;
+	}
+
+	ExpectedComponentPins.OwnerClass = FSoftClassPath(TryGetExpectedActorOwnerClass());
+	ExpectedComponentPins.ComponentName = ComponentRef.ComponentName;
+	ExpectedComponentPins.bIsSet = true;
+
+	if (const IFlowContextPinSupplierInterface* PinSupplierInterface = Cast<IFlowContextPinSupplierInterface>(ExpectedComponent))
+	{
+		ExpectedComponentPins.InputPins = PinSupplierInterface->GetContextInputs();
+		ExpectedComponentPins.OutputPins = PinSupplierInterface->GetContextOutputs();
+	}
+}
+
 void UFlowNode_ExecuteComponent::PostLoad()
 {
 	Super::PostLoad();
@@ -709,6 +885,7 @@ void UFlowNode_ExecuteComponent::PostEditChangeProperty(struct FPropertyChangedE
 		PropertyName == GET_MEMBER_NAME_CHECKED(UFlowNode_ExecuteComponent, ComponentClass))
 	{
 		RefreshComponentSource();
+		UpdateExpectedComponentPins();
 
 		RefreshPins();
 	}
@@ -739,6 +916,16 @@ void UFlowNode_ExecuteComponent::RefreshPins()
 	OnReconstructionRequested.ExecuteIfBound();
 }
 
+void UFlowNode_ExecuteComponent::GatherContentDependencies(TArray<FSoftObjectPath>& OutPaths) const
+{
+	Super::GatherContentDependencies(OutPaths);
+
+	if (const UActorComponent* ComponentDefaults = GetComponentToInjectDefaults())
+	{
+		FFlowInjectComponentsHelper::GatherSoftReferences(*ComponentDefaults, OutPaths);
+	}
+}
+
 EDataValidationResult UFlowNode_ExecuteComponent::ValidateNode()
 {
 	const EDataValidationResult SuperResult = Super::ValidateNode();
@@ -790,6 +977,9 @@ EDataValidationResult UFlowNode_ExecuteComponent::ValidateNode()
 
 			return EDataValidationResult::Invalid;
 		}
+
+		// the component is resolved anyway, so validation keeps the pin cache up to date with the owner Blueprint
+		UpdateExpectedComponentPins();
 	}
 		
 	return FinalResult;
@@ -24,9 +24,20 @@ void UFlowNode_NotifyActor::ExecuteInput(const FName& PinName)
 {
 	if (const UFlowSubsystem* FlowSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UFlowSubsystem>())
 	{
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(IdentityTags, MatchType, bExactMatch))
+		// receivers might register or unregister components, so notifies are sent after the registry pass
+		TArray<TWeakObjectPtr<UFlowComponent>, TInlineAllocator<16>> Components;
+		FlowSubsystem->ForEachComponentInWorld(GetWorld(), IdentityTags, MatchType, bExactMatch, [&Components](UFlowComponent& Component)
 		{
-			Component->NotifyFromGraph(NotifyTags, NetMode);
+			Components.Emplace(&Component);
+			return true;
+		});
+
+		for (const TWeakObjectPtr<UFlowComponent>& Component : Components)
+		{
+			if (Component.IsValid())
+			{
+				Component->NotifyFromGraph(NotifyTags, NetMode);
+			}
 		}
 	}
 
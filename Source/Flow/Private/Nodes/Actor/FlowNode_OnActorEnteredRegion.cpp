@@ -0,0 +1,86 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/Actor/FlowNode_OnActorEnteredRegion.h"
+#include "FlowSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_OnActorEnteredRegion)
+
+UFlowNode_OnActorEnteredRegion::UFlowNode_OnActorEnteredRegion(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, RegionCenter(FVector::ZeroVector)
+	, RegionRadius(500.0f)
+{
+}
+
+void UFlowNode_OnActorEnteredRegion::StartObserving()
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr || RegionListenerHandle.IsValid())
+	{
+		return;
+	}
+
+	if (!FlowSubsystem->IsSpatialRegistryEnabled())
+	{
+		LogError(TEXT("Spatial Component Registry is disabled in Flow Settings"));
+		return;
+	}
+
+	FFlowComponentRegionListener Listener;
+	Listener.Tags = IdentityTags;
+	Listener.MatchType = IdentityMatchType;
+	Listener.Center = RegionCenter;
+	Listener.Radius = RegionRadius;
+	Listener.OnComponentEntered.BindUObject(this, &UFlowNode_OnActorEnteredRegion::OnComponentEntered);
+	Listener.OnComponentLeft.BindUObject(this, &UFlowNode_OnActorEnteredRegion::OnComponentLeft);
+
+	RegionListenerHandle = FlowSubsystem->AddComponentRegionListener(Listener);
+
+	// actors already inside the region
+	FlowSubsystem->ForEachComponentInRegion(RegionListenerHandle, [this](UFlowComponent& Component)
+	{
+		OnComponentEntered(&Component);
+
+		// node might finish work immediately as the effect of ObserveActor()
+		return GetActivationState() == EFlowNodeState::Active;
+	});
+}
+
+void UFlowNode_OnActorEnteredRegion::StopObserving()
+{
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->RemoveComponentRegionListener(RegionListenerHandle);
+	}
+	RegionListenerHandle.Reset();
+}
+
+void UFlowNode_OnActorEnteredRegion::OnComponentEntered(UFlowComponent* Component)
+{
+	if (!RegisteredActors.Contains(Component->GetOwner()))
+	{
+		ObserveActor(Component->GetOwner(), Component);
+	}
+}
+
+void UFlowNode_OnActorEnteredRegion::OnComponentLeft(UFlowComponent* Component)
+{
+	if (RegisteredActors.Contains(Component->GetOwner()))
+	{
+		RegisteredActors.Remove(Component->GetOwner());
+		ForgetActor(Component->GetOwner(), Component);
+	}
+}
+
+void UFlowNode_OnActorEnteredRegion::ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
+{
+	RegisteredActors.Emplace(Actor, Component);
+	OnEventReceived();
+}
+
+#if WITH_EDITOR
+FString UFlowNode_OnActorEnteredRegion::GetNodeDescription() const
+{
+	return FString::Printf(TEXT("%s\n%s, radius %.0f"), *Super::GetNodeDescription(), *RegionCenter.ToCompactString(), RegionRadius);
+}
+#endif
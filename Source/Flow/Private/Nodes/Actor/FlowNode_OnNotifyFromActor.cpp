@@ -2,6 +2,7 @@
 
 #include "Nodes/Actor/FlowNode_OnNotifyFromActor.h"
 #include "FlowComponent.h"
+#include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_OnNotifyFromActor)
 
@@ -14,12 +15,43 @@ UFlowNode_OnNotifyFromActor::UFlowNode_OnNotifyFromActor(const FObjectInitialize
 #endif
 }
 
+void UFlowNode_OnNotifyFromActor::StartObserving()
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem && NotifyWaiters.IsEmpty())
+	{
+		// parked before collecting components, as the retroactive notify might finish the node immediately
+		NotifyWaiters.SetNum(IdentityTags.Num());
+		for (int32 TagIndex = 0; TagIndex < IdentityTags.Num(); ++TagIndex)
+		{
+			FFlowEventWaiter& Waiter = NotifyWaiters[TagIndex];
+			Waiter.OnEvent.BindUObject(this, &UFlowNode_OnNotifyFromActor::OnFlowEvent);
+			FlowSubsystem->GetEventBus().Park(Waiter, {IdentityTags.GetByIndex(TagIndex), EFlowEventType::NotifyFromComponent});
+		}
+	}
+
+	Super::StartObserving();
+}
+
+void UFlowNode_OnNotifyFromActor::StopObserving()
+{
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		for (FFlowEventWaiter& Waiter : NotifyWaiters)
+		{
+			FlowSubsystem->GetEventBus().Unpark(Waiter);
+		}
+	}
+	NotifyWaiters.Empty();
+
+	Super::StopObserving();
+}
+
 void UFlowNode_OnNotifyFromActor::ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
 {
 	if (!RegisteredActors.Contains(Actor))
 	{
 		RegisteredActors.Emplace(Actor, Component);
-		Component->OnNotifyFromComponent.AddUObject(this, &UFlowNode_OnNotifyFromActor::OnNotifyFromComponent);
 
 		if (bRetroactive && Component->GetRecentlySentNotifyTags().HasAnyExact(NotifyTags))
 		{
@@ -28,14 +60,24 @@ void UFlowNode_OnNotifyFromActor::ObserveActor(TWeakObjectPtr<AActor> Actor, TWe
 	}
 }
 
-void UFlowNode_OnNotifyFromActor::ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
+void UFlowNode_OnNotifyFromActor::OnFlowEvent(const FFlowEvent& Event)
 {
-	Component->OnNotifyFromComponent.RemoveAll(this);
+	if (Event.Serial == LastEventSerial)
+	{
+		return;
+	}
+	LastEventSerial = Event.Serial;
+
+	// live query of the base class still decides, which components are observed
+	if (Event.Component && RegisteredActors.Contains(Event.Component->GetOwner()))
+	{
+		OnNotifyFromComponent(Event.Component, Event.NotifyTag);
+	}
 }
 
 void UFlowNode_OnNotifyFromActor::OnNotifyFromComponent(UFlowComponent* Component, const FGameplayTag& Tag)
 {
-	if (Component->IdentityTags.HasAnyExact(IdentityTags) && (!NotifyTags.IsValid() || NotifyTags.HasTagExact(Tag)))
+	if (FlowTypes::HasMatchingTags(Component->IdentityTags, IdentityTags, IdentityMatchType) && (!NotifyTags.IsValid() || NotifyTags.HasTagExact(Tag)))
 	{
 		OnEventReceived();
 	}
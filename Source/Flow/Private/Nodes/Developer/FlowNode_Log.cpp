@@ -28,6 +28,20 @@ UFlowNode_Log::UFlowNode_Log(const FObjectInitializer& ObjectInitializer)
 
 void UFlowNode_Log::ExecuteInput(const FName& PinName)
 {
+	// don't resolve and format the message nobody would see
+#if NO_LOGGING
+	const bool bLogActive = false;
+#else
+	// EFlowLogVerbosity matches ELogVerbosity, offset by NoLogging and Fatal
+	const ELogVerbosity::Type LogVerbosity = static_cast<ELogVerbosity::Type>(static_cast<uint8>(Verbosity) + ELogVerbosity::Error);
+	const bool bLogActive = !LogFlow.IsSuppressed(LogVerbosity);
+#endif
+	if (!bLogActive && !(bPrintToScreen && GEngine))
+	{
+		TriggerFirstOutput(true);
+		return;
+	}
+
 	// Get the Message from either the default (Message property) or the data pin (if connected)
 	FFlowDataPinResult_String MessageResult = TryResolveDataPinAsString(GET_MEMBER_NAME_CHECKED(UFlowNode_Log, Message));
 
@@ -48,30 +62,33 @@ void UFlowNode_Log::ExecuteInput(const FName& PinName)
 	// Display the message
 	check(MessageResult.Result == EFlowDataPinResolveResult::Success);
 
-	switch (Verbosity)
+	if (bLogActive)
 	{
-		case EFlowLogVerbosity::Error:
-			UE_LOG(LogFlow, Error, TEXT("%s"), *MessageResult.Value);
-			break;
-		case EFlowLogVerbosity::Warning:
-			UE_LOG(LogFlow, Warning, TEXT("%s"), *MessageResult.Value);
-			break;
-		case EFlowLogVerbosity::Display:
-			UE_LOG(LogFlow, Display, TEXT("%s"), *MessageResult.Value);
-			break;
-		case EFlowLogVerbosity::Log:
-			UE_LOG(LogFlow, Log, TEXT("%s"), *MessageResult.Value);
-			break;
-		case EFlowLogVerbosity::Verbose:
-			UE_LOG(LogFlow, Verbose, TEXT("%s"), *MessageResult.Value);
-			break;
-		case EFlowLogVerbosity::VeryVerbose:
-			UE_LOG(LogFlow, VeryVerbose, TEXT("%s"), *MessageResult.Value);
-			break;
-		default: ;
+		switch (Verbosity)
+		{
+			case EFlowLogVerbosity::Error:
+				UE_LOG(LogFlow, Error, TEXT("%s"), *MessageResult.Value);
+				break;
+			case EFlowLogVerbosity::Warning:
+				UE_LOG(LogFlow, Warning, TEXT("%s"), *MessageResult.Value);
+				break;
+			case EFlowLogVerbosity::Display:
+				UE_LOG(LogFlow, Display, TEXT("%s"), *MessageResult.Value);
+				break;
+			case EFlowLogVerbosity::Log:
+				UE_LOG(LogFlow, Log, TEXT("%s"), *MessageResult.Value);
+				break;
+			case EFlowLogVerbosity::Verbose:
+				UE_LOG(LogFlow, Verbose, TEXT("%s"), *MessageResult.Value);
+				break;
+			case EFlowLogVerbosity::VeryVerbose:
+				UE_LOG(LogFlow, VeryVerbose, TEXT("%s"), *MessageResult.Value);
+				break;
+			default: ;
+		}
 	}
 
-	if (bPrintToScreen)
+	if (bPrintToScreen && GEngine)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, Duration, TextColor, MessageResult.Value);
 	}
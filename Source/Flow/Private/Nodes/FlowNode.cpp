@@ -4,9 +4,14 @@
 #include "AddOns/FlowNodeAddOn.h"
 
 #include "FlowAsset.h"
+#include "FlowExecutionRecorder.h"
+#include "FlowProfiler.h"
+#include "FlowRemoteDebug.h"
 #include "FlowSettings.h"
+#include "FlowStats.h"
 #include "Interfaces/FlowNodeWithExternalDataPinSupplierInterface.h"
 #include "Types/FlowDataPinProperties.h"
+#include "Types/FlowInjectComponentsHelper.h"
 
 #include "Components/ActorComponent.h"
 #if WITH_EDITOR
@@ -32,6 +37,7 @@ UFlowNode::UFlowNode(const FObjectInitializer& ObjectInitializer)
 	, AllowedSignalModes({EFlowSignalMode::Enabled, EFlowSignalMode::Disabled, EFlowSignalMode::PassThrough})
 	, SignalMode(EFlowSignalMode::Enabled)
 	, bPreloaded(false)
+	, LastPreloadUseTime(0.0)
 	, ActivationState(EFlowNodeState::NeverActivated)
 {
 #if WITH_EDITOR
@@ -54,6 +60,13 @@ void UFlowNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEve
 		return;
 	}
 
+	// compiled lightweight program copies node properties
+	if (UFlowAsset* FlowAsset = Cast<UFlowAsset>(GetOuter()))
+	{
+		FlowAsset->InvalidateLightweightProgram();
+		FlowAsset->SchedulePatchRunningInstances();
+	}
+
 	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
 	const FName MemberPropertyName = PropertyChangedEvent.GetMemberPropertyName();
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UFlowNode, InputPins) || PropertyName == GET_MEMBER_NAME_CHECKED(UFlowNode, OutputPins)
@@ -74,6 +87,27 @@ void UFlowNode::PostLoad()
 
 #endif
 
+void UFlowNode::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(InputPins.GetAllocatedSize() + OutputPins.GetAllocatedSize()
+		+ AutoInputDataPins.GetAllocatedSize() + AutoOutputDataPins.GetAllocatedSize()
+		+ Connections.GetAllocatedSize() + PinNameToBoundPropertyNameMap.GetAllocatedSize()
+		+ DataPinVersions.GetAllocatedSize() + CachedSaveData.GetAllocatedSize());
+
+#if FLOW_WITH_PIN_RECORDS
+	for (const TMap<FName, FPinRecordHistory>* Records : {&InputRecords, &OutputRecords})
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Records->GetAllocatedSize());
+		for (const TPair<FName, FPinRecordHistory>& Record : *Records)
+		{
+			CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Record.Value.GetAllocatedSize());
+		}
+	}
+#endif
+}
+
 bool UFlowNode::IsSupportedInputPinName(const FName& PinName) const
 {
 	const FFlowPin* InputPin = FindFlowPinByName(PinName, InputPins);
@@ -367,6 +401,7 @@ void UFlowNode::RemoveUserOutput(const FName& PinName)
 void UFlowNode::SetPinNameToBoundPropertyNameMap(const TMap<FName, FName>& Map)
 {
 	PinNameToBoundPropertyNameMap = Map;
+	BoundPropertyCache.Empty();
 }
 
 void UFlowNode::SetAutoInputDataPins(const TArray<FFlowPin>& AutoInputPins)
@@ -379,11 +414,57 @@ void UFlowNode::SetAutoOutputDataPins(const TArray<FFlowPin>& AutoOutputPins)
 	AutoOutputDataPins = AutoOutputPins;
 }
 
+void UFlowNode::GatherContentDependencies(TArray<FSoftObjectPath>& OutPaths) const
+{
+	FFlowInjectComponentsHelper::GatherSoftReferences(*this, OutPaths);
+
+	(void) ForEachAddOnConst([&OutPaths](const UFlowNodeAddOn& AddOn)
+	{
+		FFlowInjectComponentsHelper::GatherSoftReferences(AddOn, OutPaths);
+		return EFlowForEachAddOnFunctionReturnValue::Continue;
+	});
+}
+
+void UFlowNode::GatherGameplayTags(FGameplayTagContainer& OutTags) const
+{
+	auto GatherPropertyTags = [&OutTags](const UObject& Object)
+	{
+		// editor-only properties hold tags like the NodeDisplayStyle
+		for (TFieldIterator<FStructProperty> It(Object.GetClass()); It; ++It)
+		{
+			if (It->IsEditorOnlyProperty())
+			{
+				continue;
+			}
+
+			for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ArrayIndex++)
+			{
+				if (It->Struct == FGameplayTag::StaticStruct())
+				{
+					OutTags.AddTag(*It->ContainerPtrToValuePtr<FGameplayTag>(&Object, ArrayIndex));
+				}
+				else if (It->Struct == FGameplayTagContainer::StaticStruct())
+				{
+					OutTags.AppendTags(*It->ContainerPtrToValuePtr<FGameplayTagContainer>(&Object, ArrayIndex));
+				}
+			}
+		}
+	};
+
+	GatherPropertyTags(*this);
+
+	(void) ForEachAddOnConst([&GatherPropertyTags](const UFlowNodeAddOn& AddOn)
+	{
+		GatherPropertyTags(AddOn);
+		return EFlowForEachAddOnFunctionReturnValue::Continue;
+	});
+}
+
 #endif // WITH_EDITOR
 
 bool UFlowNode::CanSupplyDataPinValues_Implementation() const
 {
-	if (!PinNameToBoundPropertyNameMap.IsEmpty())
+	if (!GetPinNameToBoundPropertyNameMap().IsEmpty())
 	{
 		return true;
 	}
@@ -393,11 +474,11 @@ bool UFlowNode::CanSupplyDataPinValues_Implementation() const
 
 bool UFlowNode::TryGetFlowDataPinSupplierDatasForPinName(
 	const FName& PinName,
-	TArray<FFlowPinValueSupplierData>& InOutPinValueSupplierDatas) const
+	FFlowPinValueSupplierDataArray& InOutPinValueSupplierDatas) const
 {
 	const IFlowDataPinValueSupplierInterface* ThisAsPinValueSupplier = Cast<IFlowDataPinValueSupplierInterface>(this);
 
-	// This function will build the priority-ordered array of data suppliers for a given PinName.
+	// This function will build the priority-ordered array of data suppliers for a given PinName, the most preferred supplier is the last one.
 	// It works in two modes:
 	// - Standard case - Add a connected node as the priority supplier, and this node as the default value supplier
 	// - Exception case - for External data supplied nodes, we recurse (below) to crawl further and add the supplier
@@ -408,14 +489,16 @@ bool UFlowNode::TryGetFlowDataPinSupplierDatasForPinName(
 
 	// Potentially add this current node as a default value supplier
 	// (this will be pushed down the priority queue as higher priority suppliers are found)
-	if (ThisAsPinValueSupplier && IFlowDataPinValueSupplierInterface::Execute_CanSupplyDataPinValues(this))
+	if (ThisAsPinValueSupplier && IFlowDataPinValueSupplierInterface::CanSupplyDataPinValuesFast(this))
 	{
 		FFlowPinValueSupplierData NewPinValueSupplier;
 		NewPinValueSupplier.PinValueSupplier = ThisAsPinValueSupplier;
 		NewPinValueSupplier.SupplierPinName = PinName;
+		NewPinValueSupplier.bNativeSupplier = IFlowDataPinValueSupplierInterface::IsNativeSupplier(this);
+		NewPinValueSupplier.SupplierFlowNode = this;
 
 		// Put this node as the backup supplier
-		InOutPinValueSupplierDatas.Insert(NewPinValueSupplier, 0);
+		InOutPinValueSupplierDatas.Add(NewPinValueSupplier);
 	}
 
 	// If the pin is connected, try to add the connected node as the priority supplier
@@ -424,23 +507,33 @@ bool UFlowNode::TryGetFlowDataPinSupplierDatasForPinName(
 
 	if (FindConnectedNodeForPinFast(PinName, &ConnectedNodeGuid, &ConnectedPinValueSupplier.SupplierPinName))
 	{
-		if (const UFlowAsset* FlowAsset = GetFlowAsset())
+		if (UFlowAsset* FlowAsset = GetFlowAsset())
 		{
-			const UFlowNode* SupplierFlowNode = FlowAsset->GetNode(ConnectedNodeGuid);
+			// supplier might compute its value from the runtime state, so it can't be the template node
+			const UFlowNode* SupplierFlowNode = FlowAsset->GetOrCreateNodeInstance(ConnectedNodeGuid);
 
-			// If the connected node can supply data pin values, insert it into the top of the priority queue
+			// If the connected node can supply data pin values, add it on the top of the priority queue
 			const IFlowDataPinValueSupplierInterface* SupplierFlowNodeAsInterface = Cast<IFlowDataPinValueSupplierInterface>(SupplierFlowNode);
-			if (SupplierFlowNodeAsInterface && IFlowDataPinValueSupplierInterface::Execute_CanSupplyDataPinValues(SupplierFlowNode))
+			if (SupplierFlowNodeAsInterface && IFlowDataPinValueSupplierInterface::CanSupplyDataPinValuesFast(SupplierFlowNode))
 			{
 				ConnectedPinValueSupplier.PinValueSupplier = SupplierFlowNodeAsInterface;
+				ConnectedPinValueSupplier.bNativeSupplier = IFlowDataPinValueSupplierInterface::IsNativeSupplier(SupplierFlowNode);
+				ConnectedPinValueSupplier.SupplierFlowNode = SupplierFlowNode;
 
-				InOutPinValueSupplierDatas.Insert(ConnectedPinValueSupplier, 0);
+				InOutPinValueSupplierDatas.Add(ConnectedPinValueSupplier);
 			}
 
 			// Exception case for nodes with external suppliers, recurse here to crawl further 
 			// to the external supplier's connected pin as our most preferred source (see block comment above).
 			if (const IFlowNodeWithExternalDataPinSupplierInterface* HasExternalPinSupplierInterface = Cast<IFlowNodeWithExternalDataPinSupplierInterface>(SupplierFlowNode))
 			{
+				if (const FFlowPinValueSupplierDataArray* FlattenedSupplierDatas = HasExternalPinSupplierInterface->FindFlattenedExternalSuppliers(ConnectedPinValueSupplier.SupplierPinName))
+				{
+					InOutPinValueSupplierDatas.Append(*FlattenedSupplierDatas);
+
+					return !InOutPinValueSupplierDatas.IsEmpty();
+				}
+
 				if (const UFlowNode* ExternalDataPinSupplierFlowNode = Cast<UFlowNode>(HasExternalPinSupplierInterface->GetExternalDataPinSupplier()))
 				{
 					return ExternalDataPinSupplierFlowNode->TryGetFlowDataPinSupplierDatasForPinName(ConnectedPinValueSupplier.SupplierPinName, InOutPinValueSupplierDatas);
@@ -452,13 +545,35 @@ bool UFlowNode::TryGetFlowDataPinSupplierDatasForPinName(
 	return !InOutPinValueSupplierDatas.IsEmpty();
 }
 
+void UFlowNode::MarkDataPinDirty(const FName& PinName)
+{
+	uint32& Version = DataPinVersions.FindOrAdd(PinName);
+
+	// skip zero on wrap-around, it stands for the unversioned pin
+	if (++Version == 0)
+	{
+		Version = 1;
+	}
+
+	if (UFlowAsset* FlowAsset = GetFlowAsset())
+	{
+		FlowAsset->InvalidateDataPinMemo(*this);
+	}
+}
+
+uint32 UFlowNode::GetDataPinVersion(const FName& PinName) const
+{
+	const uint32* Version = DataPinVersions.Find(PinName);
+	return Version ? *Version : 0;
+}
+
 bool UFlowNode::TryFindPropertyByPinName(
 	const FName& PinName,
 	const FProperty*& OutFoundProperty,
 	TInstancedStruct<FFlowDataPinProperty>& OutFoundInstancedStruct,
 	EFlowDataPinResolveResult& InOutResult) const
 {
-	const FName* RemappedPinName = PinNameToBoundPropertyNameMap.Find(PinName);
+	const FName* RemappedPinName = GetPinNameToBoundPropertyNameMap().Find(PinName);
 	if (!RemappedPinName)
 	{
 		InOutResult = EFlowDataPinResolveResult::FailedUnknownPin;
@@ -480,8 +595,7 @@ bool UFlowNode::TryFindPropertyByRemappedPinName(
 	TInstancedStruct<FFlowDataPinProperty>& OutFoundInstancedStruct,
 	EFlowDataPinResolveResult& InOutResult) const
 {
-	const UClass* ThisClass = GetClass();
-	OutFoundProperty = ThisClass->FindPropertyByName(RemappedPinName);
+	OutFoundProperty = FindBoundProperty(RemappedPinName);
 
 	if (!OutFoundProperty)
 	{
@@ -495,10 +609,38 @@ bool UFlowNode::TryFindPropertyByRemappedPinName(
 	return true;
 }
 
+void UFlowNode::ShareTemplateNodeData(const UFlowNode& TemplateNode)
+{
+	check(TemplateNode.SharedDataNode == nullptr);
+	SharedDataNode = &TemplateNode;
+
+	Connections.Empty();
+	PinNameToBoundPropertyNameMap.Empty();
+}
+
+const FProperty* UFlowNode::FindBoundProperty(const FName& RemappedPinName) const
+{
+	// template node has the same class, so its cache is valid for this instance
+	const UFlowNode* CacheOwner = SharedDataNode ? SharedDataNode : this;
+
+	if (const FProperty* const* CachedProperty = CacheOwner->BoundPropertyCache.Find(RemappedPinName))
+	{
+		return *CachedProperty;
+	}
+
+	const FProperty* FoundProperty = GetClass()->FindPropertyByName(RemappedPinName);
+	if (FoundProperty)
+	{
+		CacheOwner->BoundPropertyCache.Add(RemappedPinName, FoundProperty);
+	}
+
+	return FoundProperty;
+}
+
 TSet<UFlowNode*> UFlowNode::GatherConnectedNodes() const
 {
 	TSet<UFlowNode*> Result;
-	for (const TPair<FName, FConnectedPin>& Connection : Connections)
+	for (const TPair<FName, FConnectedPin>& Connection : GetConnections())
 	{
 		Result.Emplace(GetFlowAsset()->GetNode(Connection.Value.NodeGuid));
 	}
@@ -508,7 +650,7 @@ TSet<UFlowNode*> UFlowNode::GatherConnectedNodes() const
 
 FName UFlowNode::GetPinConnectedToNode(const FGuid& OtherNodeGuid)
 {
-	for (const TPair<FName, FConnectedPin>& Connection : Connections)
+	for (const TPair<FName, FConnectedPin>& Connection : GetConnections())
 	{
 		if (Connection.Value.NodeGuid == OtherNodeGuid)
 		{
@@ -582,7 +724,7 @@ bool UFlowNode::IsInputConnected(const FFlowPin& FlowPin) const
 	}
 	else
 	{
-		// We don't cache the input exec pins for fast lookup in Connections, so use the slow path for them:
+		// We don't cache the input exec pins for fast lookup in Connections, so use the reverse index for them:
 
 		return FindConnectedNodeForPinSlow(FlowPin.PinName);
 	}
@@ -601,7 +743,7 @@ bool UFlowNode::IsOutputConnected(const FFlowPin& FlowPin) const
 	}
 	else
 	{
-		// We don't cache the input data pins for fast lookup in Connections, so use the slow path for them:
+		// We don't cache the output data pins for fast lookup in Connections, so use the reverse index for them:
 
 		return FindConnectedNodeForPinSlow(FlowPin.PinName);
 	}
@@ -609,7 +751,7 @@ bool UFlowNode::IsOutputConnected(const FFlowPin& FlowPin) const
 
 bool UFlowNode::FindConnectedNodeForPinFast(const FName& PinName, FGuid* OutGuid, FName* OutConnectedPinName) const
 {
-	const FConnectedPin* FoundConnectedPin = Connections.Find(PinName);
+	const FConnectedPin* FoundConnectedPin = GetConnections().Find(PinName);
 	if (FoundConnectedPin)
 	{
 		if (OutGuid)
@@ -635,6 +777,26 @@ bool UFlowNode::FindConnectedNodeForPinSlow(const FName& PinName, FGuid* OutGuid
 		return false;
 	}
 
+	if (FlowAsset->HasReverseConnections())
+	{
+		const FConnectedPin* ConnectedFrom = FlowAsset->FindReverseConnection(NodeGuid, PinName);
+		if (ConnectedFrom)
+		{
+			if (OutGuid)
+			{
+				*OutGuid = ConnectedFrom->NodeGuid;
+			}
+
+			if (OutConnectedPinName)
+			{
+				*OutConnectedPinName = ConnectedFrom->PinName;
+			}
+		}
+
+		return ConnectedFrom != nullptr;
+	}
+
+	// fallback for assets without the reverse index
 	for (const TPair<FGuid, UFlowNode*>& Pair : ObjectPtrDecay(FlowAsset->Nodes))
 	{
 		const FGuid& ConnectedFromGuid = Pair.Key;
@@ -645,7 +807,7 @@ bool UFlowNode::FindConnectedNodeForPinSlow(const FName& PinName, FGuid* OutGuid
 			continue;
 		}
 
-		for (const TPair<FName, FConnectedPin>& Connection : Pair.Value->Connections)
+		for (const TPair<FName, FConnectedPin>& Connection : Pair.Value->GetConnections())
 		{
 			const FConnectedPin& ConnectedPinStruct = Connection.Value;
 
@@ -672,6 +834,35 @@ bool UFlowNode::FindConnectedNodeForPinSlow(const FName& PinName, FGuid* OutGuid
 // Must implement TrySupplyDataPinAs... for every EFlowPinType 
 FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
 
+FFlowDataPinArrayView UFlowNode::TrySupplyDataPinAsArray(const FName& PinName) const
+{
+	const FName* RemappedPinName = GetPinNameToBoundPropertyNameMap().Find(PinName);
+	if (!RemappedPinName)
+	{
+		return FFlowDataPinArrayView(EFlowDataPinResolveResult::FailedUnknownPin);
+	}
+
+	const FProperty* BoundProperty = FindBoundProperty(*RemappedPinName);
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(BoundProperty))
+	{
+		if (StructProperty->Struct->IsChildOf(FFlowDataPinArrayProperty::StaticStruct()))
+		{
+			return StructProperty->ContainerPtrToValuePtr<FFlowDataPinArrayProperty>(this)->GetArrayView();
+		}
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(BoundProperty))
+	{
+		const EFlowPinType ElementPinType = FFlowDataPinProperty::GetArrayElementPinType(*ArrayProperty->Inner);
+		if (ElementPinType != EFlowPinType::Invalid)
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(this));
+			return FFlowDataPinArrayView(ElementPinType, ArrayHelper.GetRawPtr(), ArrayHelper.Num());
+		}
+	}
+
+	return FFlowDataPinArrayView(EFlowDataPinResolveResult::FailedMismatchedType);
+}
+
 FFlowDataPinResult_Bool UFlowNode::TrySupplyDataPinAsBool_Implementation(const FName& PinName) const
 {
 	return TrySupplyDataPinAsType<FFlowDataPinResult_Bool, FFlowDataPinOutputProperty_Bool, FBoolProperty>(PinName);
@@ -773,6 +964,7 @@ void UFlowNode::RecursiveFindNodesByClass(UFlowNode* Node, const TSubclassOf<UFl
 void UFlowNode::TriggerPreload()
 {
 	bPreloaded = true;
+	LastPreloadUseTime = FPlatformTime::Seconds();
 	PreloadContent();
 }
 
@@ -784,12 +976,22 @@ void UFlowNode::TriggerFlush()
 
 void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType ActivationType /*= Default*/)
 {
+	TriggerInput_Internal(PinName, InputPins.Contains(PinName), ActivationType);
+}
+
+void UFlowNode::TriggerInput_Internal(const FName& PinName, const bool bIsKnownPin, const EFlowPinActivationType ActivationType /*= Default*/)
+{
+	FLOW_TRACE_SCOPE_TEXT(TEXT("TriggerInput %s.%s (%s)"), *GetClass()->GetName(), *PinName.ToString(), *GetNameSafe(GetFlowAsset()->GetTemplateAsset()));
+	INC_DWORD_STAT(STAT_FlowPinTriggers);
+	CSV_CUSTOM_STAT(Flow, PinTriggers, 1, ECsvCustomStatOp::Accumulate);
+	FLOW_PROFILER_NODE_SCOPE(*this);
+
 	if (SignalMode == EFlowSignalMode::Disabled)
 	{
 		// entirely ignore any Input activation
 	}
 
-	if (InputPins.Contains(PinName))
+	if (bIsKnownPin)
 	{
 		if (SignalMode == EFlowSignalMode::Enabled)
 		{
@@ -799,24 +1001,37 @@ void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType
 				OnActivate();
 			}
 
-			ActivationState = EFlowNodeState::Active;
+			SetActivationState(EFlowNodeState::Active);
+			MarkSaveDataDirty();
 		}
 
-#if !UE_BUILD_SHIPPING
-		// record for debugging
-		TArray<FPinRecord>& Records = InputRecords.FindOrAdd(PinName);
-		Records.Add(FPinRecord(FApp::GetCurrentTime(), ActivationType));
+		FLOW_RECORD_PIN(*this, InputPins.IndexOfByKey(PinName), EFlowRecordedEventType::Input);
+		FLOW_REMOTE_DEBUG_PIN(*this, InputPins.IndexOfByKey(PinName), EFlowRecordedEventType::Input);
 
-		if (const UFlowAsset* FlowAssetTemplate = GetFlowAsset()->GetTemplateAsset())
+#if FLOW_WITH_PIN_RECORDS || !UE_BUILD_SHIPPING
+		if (!GetFlowAsset()->IsLeanServerInstance())
 		{
-			(void)FlowAssetTemplate->OnPinTriggered.ExecuteIfBound(NodeGuid, PinName);
+#if FLOW_WITH_PIN_RECORDS
+			// record for debugging
+			AddPinRecord(InputRecords, PinName, ActivationType);
+#endif
+
+#if !UE_BUILD_SHIPPING
+			// bound by the debugger only to templates with breakpoints
+			const UFlowAsset* FlowAssetTemplate = GetFlowAsset()->GetTemplateAsset();
+			if (FlowAssetTemplate && FlowAssetTemplate->OnPinTriggered.IsBound())
+			{
+				INC_DWORD_STAT(STAT_FlowDebuggerPinNotifies);
+				FlowAssetTemplate->OnPinTriggered.Execute(*this, PinName);
+			}
+#endif
 		}
 #endif
 	}
 #if !UE_BUILD_SHIPPING
 	else
 	{
-		LogError(FString::Printf(TEXT("Input Pin name %s invalid"), *PinName.ToString()));
+		FLOW_LOG_NODE(LogFlowExecution, Error, TEXT("Input Pin name %s invalid"), *PinName.ToString());
 		return;
 	}
 #endif
@@ -829,15 +1044,18 @@ void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType
 		case EFlowSignalMode::Disabled:
 			if (UFlowSettings::Get()->bLogOnSignalDisabled)
 			{
-				LogNote(FString::Printf(TEXT("Node disabled while triggering input %s"), *PinName.ToString()));
+				FLOW_LOG_NODE(LogFlowExecution, Log, TEXT("Node disabled while triggering input %s"), *PinName.ToString());
 			}
 			break;
 		case EFlowSignalMode::PassThrough:
 			if (UFlowSettings::Get()->bLogOnSignalPassthrough)
 			{
-				LogNote(FString::Printf(TEXT("Signal pass-through on triggering input %s"), *PinName.ToString()));
+				FLOW_LOG_NODE(LogFlowExecution, Log, TEXT("Signal pass-through on triggering input %s"), *PinName.ToString());
+			}
+			if (!ProcessBlueprintEvent(GetBlueprintEvents().OnPassThrough))
+			{
+				OnPassThrough_Implementation();
 			}
-			OnPassThrough();
 			break;
 		default: ;
 	}
@@ -853,42 +1071,58 @@ void UFlowNode::TriggerFirstOutput(const bool bFinish)
 
 void UFlowNode::TriggerOutput(const FName PinName, const bool bFinish /*= false*/, const EFlowPinActivationType ActivationType /*= Default*/)
 {
+	FLOW_TRACE_SCOPE_TEXT(TEXT("TriggerOutput %s.%s (%s)"), *GetClass()->GetName(), *PinName.ToString(), *GetNameSafe(GetFlowAsset()->GetTemplateAsset()));
+
 	if (HasFinished())
 	{
 		// do not trigger output if node is already finished or aborted
-		LogError(TEXT("Trying to TriggerOutput after finished or aborted"));
+		FLOW_LOG_NODE(LogFlowExecution, Error, TEXT("Trying to TriggerOutput after finished or aborted"));
 		return;
 	}
 
+	MarkSaveDataDirty();
+
 	// clean up node, if needed
 	if (bFinish)
 	{
 		Finish();
 	}
 
+	const int32 OutputPinIndex = OutputPins.IndexOfByKey(PinName);
+	FLOW_RECORD_PIN(*this, OutputPinIndex, EFlowRecordedEventType::Output);
+	FLOW_REMOTE_DEBUG_PIN(*this, OutputPinIndex, EFlowRecordedEventType::Output);
+
 #if !UE_BUILD_SHIPPING
-	if (OutputPins.Contains(PinName))
+	if (OutputPinIndex != INDEX_NONE)
 	{
-		// record for debugging, even if nothing is connected to this pin
-		TArray<FPinRecord>& Records = OutputRecords.FindOrAdd(PinName);
-		Records.Add(FPinRecord(FApp::GetCurrentTime(), ActivationType));
-
-		if (const UFlowAsset* FlowAssetTemplate = GetFlowAsset()->GetTemplateAsset())
+		if (!GetFlowAsset()->IsLeanServerInstance())
 		{
-			FlowAssetTemplate->OnPinTriggered.ExecuteIfBound(NodeGuid, PinName);
+#if FLOW_WITH_PIN_RECORDS
+			// record for debugging, even if nothing is connected to this pin
+			AddPinRecord(OutputRecords, PinName, ActivationType);
+#if WITH_EDITOR
+			GetFlowAsset()->RecordWire(*this, OutputPinIndex);
+#endif
+#endif
+
+			const UFlowAsset* FlowAssetTemplate = GetFlowAsset()->GetTemplateAsset();
+			if (FlowAssetTemplate && FlowAssetTemplate->OnPinTriggered.IsBound())
+			{
+				INC_DWORD_STAT(STAT_FlowDebuggerPinNotifies);
+				FlowAssetTemplate->OnPinTriggered.Execute(*this, PinName);
+			}
 		}
 	}
 	else
 	{
-		LogError(FString::Printf(TEXT("Output Pin name %s invalid"), *PinName.ToString()));
+		FLOW_LOG_NODE(LogFlowExecution, Error, TEXT("Output Pin name %s invalid"), *PinName.ToString());
 	}
 #endif
 
 	// call the next node
-	if (OutputPins.Contains(PinName) && Connections.Contains(PinName))
+	if (OutputPinIndex != INDEX_NONE)
 	{
-		const FConnectedPin FlowPin = GetConnection(PinName);
-		GetFlowAsset()->TriggerInput(FlowPin.NodeGuid, FlowPin.PinName);
+		GetFlowAsset()->TriggerConnectedInput(*this, OutputPinIndex);
 	}
 }
 
@@ -906,53 +1140,136 @@ void UFlowNode::Deactivate()
 		return;
 	}
 
-	if (GetFlowAsset()->FinishPolicy == EFlowFinishPolicy::Abort)
-	{
-		ActivationState = EFlowNodeState::Aborted;
-	}
-	else
+	SetActivationState(GetFlowAsset()->FinishPolicy == EFlowFinishPolicy::Abort ? EFlowNodeState::Aborted : EFlowNodeState::Completed);
+
+	Cleanup();
+}
+
+void UFlowNode::SetActivationState(const EFlowNodeState NewState)
+{
+	ActivationState = NewState;
+
+	if (UFlowAsset* FlowAsset = GetFlowAsset())
 	{
-		ActivationState = EFlowNodeState::Completed;
+		FlowAsset->SetNodeState(CompiledNodeIndex, NewState);
 	}
 
-	Cleanup();
+	FLOW_REMOTE_DEBUG_NODE_STATE(*this, NewState);
 }
 
 void UFlowNode::ResetRecords()
 {
-	ActivationState = EFlowNodeState::NeverActivated;
+	SetActivationState(EFlowNodeState::NeverActivated);
 
-#if !UE_BUILD_SHIPPING
+	CachedSaveData.Empty();
+	bSaveDataDirty = true;
+
+#if FLOW_WITH_PIN_RECORDS
 	InputRecords.Empty();
 	OutputRecords.Empty();
 #endif
 }
 
+#if FLOW_WITH_PIN_RECORDS
+int32 UFlowNode::GetPinRecordsCapacity() const
+{
+	const UFlowSettings* FlowSettings = UFlowSettings::Get();
+	return FlowSettings->GetPinRecordingMode() == EFlowPinRecordingMode::RingBuffer ? FMath::Max(1, FlowSettings->MaxPinRecords) : 0;
+}
+
+void UFlowNode::AddPinRecord(TMap<FName, FPinRecordHistory>& Records, const FName& PinName, const EFlowPinActivationType ActivationType) const
+{
+	if (UFlowSettings::Get()->GetPinRecordingMode() == EFlowPinRecordingMode::Off)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_FlowPinRecords);
+	Records.FindOrAdd(PinName).Add(FPinRecord(FApp::GetCurrentTime(), ActivationType), GetPinRecordsCapacity());
+}
+#endif
+
 void UFlowNode::SaveInstance(FFlowNodeSaveData& NodeRecord)
+{
+	PrepareSaveInstance();
+	SerializeSaveInstance(NodeRecord);
+}
+
+void UFlowNode::PrepareSaveInstance()
+{
+	if (ShouldReuseSaveData())
+	{
+		return;
+	}
+
+	if (!ProcessBlueprintEvent(GetBlueprintEvents().OnSave))
+	{
+		OnSave_Implementation();
+	}
+}
+
+void UFlowNode::SerializeSaveInstance(FFlowNodeSaveData& NodeRecord, const bool bSnapshot)
 {
 	NodeRecord.NodeGuid = NodeGuid;
-	OnSave();
+
+	if (!bSnapshot && ShouldReuseSaveData())
+	{
+		NodeRecord.NodeData = CachedSaveData;
+		INC_DWORD_STAT(STAT_FlowReusedSaveRecords);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_FlowSerializedSaveRecords);
 
 	FMemoryWriter MemoryWriter(NodeRecord.NodeData, true);
-	FFlowArchive Ar(MemoryWriter);
-	Serialize(Ar);
+	UFlowAsset* FlowAsset = GetFlowAsset();
+	FlowSave::SerializeSaveData(*this, MemoryWriter, FlowAsset ? FlowAsset->GetSaveDataTablesForSave() : nullptr, FlowAsset ? FlowAsset->GetSaveDataDeltaArchetype(this) : nullptr);
+
+	if (UFlowSettings::Get()->bIncrementalSaveGame && !bSnapshot)
+	{
+		CachedSaveData = NodeRecord.NodeData;
+		bSaveDataDirty = false;
+	}
 }
 
 void UFlowNode::LoadInstance(const FFlowNodeSaveData& NodeRecord)
 {
+	DeserializeSaveInstance(NodeRecord);
+	PostLoadInstance();
+}
+
+void UFlowNode::DeserializeSaveInstance(const FFlowNodeSaveData& NodeRecord)
+{
+	// pooled node might contain values from its previous run, which aren't included in the delta
+	UFlowAsset* FlowAsset = GetFlowAsset();
+	if (FlowAsset && FlowAsset->IsLoadingDeltaSaveData() && FlowAsset->GetTemplateAsset())
+	{
+		if (const UFlowNode* TemplateNode = FlowAsset->GetTemplateAsset()->GetNode(NodeGuid))
+		{
+			FlowSave::ResetSaveGameProperties(*this, *TemplateNode);
+		}
+	}
+
 	FMemoryReader MemoryReader(NodeRecord.NodeData, true);
-	FFlowArchive Ar(MemoryReader);
-	Serialize(Ar);
+	FlowSave::SerializeSaveData(*this, MemoryReader, FlowAsset ? FlowAsset->GetSaveDataTablesForLoad() : nullptr);
 
-	if (UFlowAsset* FlowAsset = GetFlowAsset())
+	MarkSaveDataDirty();
+
+	if (FlowAsset)
 	{
 		FlowAsset->OnActivationStateLoaded(this);
 	}
+}
 
+void UFlowNode::PostLoadInstance()
+{
 	switch (SignalMode)
 	{
 		case EFlowSignalMode::Enabled:
-			OnLoad();
+			if (!ProcessBlueprintEvent(GetBlueprintEvents().OnLoad))
+			{
+				OnLoad_Implementation();
+			}
 			break;
 		case EFlowSignalMode::Disabled:
 			// designer doesn't want to execute this node's logic at all, so we kill it
@@ -961,12 +1278,36 @@ void UFlowNode::LoadInstance(const FFlowNodeSaveData& NodeRecord)
 			break;
 		case EFlowSignalMode::PassThrough:
 			LogNote(TEXT("Signal pass-through on loading Flow Node from SaveGame"));
-			OnPassThrough();
+			if (!ProcessBlueprintEvent(GetBlueprintEvents().OnPassThrough))
+			{
+				OnPassThrough_Implementation();
+			}
 			break;
 		default: ;
 	}
 }
 
+void UFlowNode::MarkSaveDataDirty()
+{
+	bSaveDataDirty = true;
+
+	if (UFlowAsset* FlowAsset = GetFlowAsset())
+	{
+		FlowAsset->MarkSaveDataDirty();
+		FlowAsset->MarkReplicatedNodeDirty(CompiledNodeIndex);
+	}
+}
+
+bool UFlowNode::CanReuseSaveData() const
+{
+	return !GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+}
+
+bool UFlowNode::ShouldReuseSaveData() const
+{
+	return UFlowSettings::Get()->bIncrementalSaveGame && !bSaveDataDirty && CanReuseSaveData();
+}
+
 void UFlowNode::OnSave_Implementation()
 {
 }
@@ -981,7 +1322,7 @@ void UFlowNode::OnPassThrough_Implementation()
 	// pin connections aren't serialized to the SaveGame, so users can safely change connections post game release
 	for (const FFlowPin& OutputPin : OutputPins)
 	{
-		if (Connections.Contains(OutputPin.PinName))
+		if (GetConnections().Contains(OutputPin.PinName))
 		{
 			TriggerOutput(OutputPin.PinName, false, EFlowPinActivationType::PassThrough);
 		}
@@ -995,24 +1336,38 @@ void UFlowNode::OnPassThrough_Implementation()
 TMap<uint8, FPinRecord> UFlowNode::GetWireRecords() const
 {
 	TMap<uint8, FPinRecord> Result;
-	for (const TPair<FName, TArray<FPinRecord>>& Record : OutputRecords)
+#if FLOW_WITH_PIN_RECORDS
+	for (const TPair<FName, FPinRecordHistory>& Record : OutputRecords)
 	{
-		Result.Emplace(OutputPins.IndexOfByKey(Record.Key), Record.Value.Last());
+		if (!Record.Value.IsEmpty())
+		{
+			Result.Emplace(OutputPins.IndexOfByKey(Record.Key), Record.Value.Last());
+		}
 	}
+#endif
 	return Result;
 }
 
 TArray<FPinRecord> UFlowNode::GetPinRecords(const FName& PinName, const EEdGraphPinDirection PinDirection) const
 {
+#if FLOW_WITH_PIN_RECORDS
+	const FPinRecordHistory* History = nullptr;
 	switch (PinDirection)
 	{
 		case EGPD_Input:
-			return InputRecords.FindRef(PinName);
+			History = InputRecords.Find(PinName);
+			break;
 		case EGPD_Output:
-			return OutputRecords.FindRef(PinName);
+			History = OutputRecords.Find(PinName);
+			break;
 		default:
-			return TArray<FPinRecord>();
+			break;
 	}
+
+	return History ? History->ToArray() : TArray<FPinRecord>();
+#else
+	return TArray<FPinRecord>();
+#endif
 }
 
 #endif
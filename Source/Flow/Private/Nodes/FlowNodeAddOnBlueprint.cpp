@@ -1,8 +1,21 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/FlowNodeAddOnBlueprint.h"
+#include "Nodes/FlowNodeBlueprint.h"
+
+#if WITH_EDITOR
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
 
 UFlowNodeAddOnBlueprint::UFlowNodeAddOnBlueprint(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
+
+#if WITH_EDITOR
+void UFlowNodeAddOnBlueprint::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+	FFlowNodeBlueprintMetadata::AddAssetRegistryTags(*this, Context);
+}
+#endif
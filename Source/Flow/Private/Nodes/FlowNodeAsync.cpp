@@ -0,0 +1,144 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/FlowNodeAsync.h"
+#include "FlowLogChannels.h"
+
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNodeAsync)
+
+#define LOCTEXT_NAMESPACE "FlowNodeAsync"
+
+UFlowNodeAsync::UFlowNodeAsync(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bTaskRunning(false)
+{
+#if WITH_EDITOR
+	NodeDisplayStyle = FlowNodeStyle::Latent;
+#endif
+}
+
+void UFlowNodeAsync::ExecuteInput(const FName& PinName)
+{
+	if (PinName == DefaultInputPin.PinName)
+	{
+		if (bTaskRunning)
+		{
+			FLOW_LOG_NODE(LogFlowExecution, Error, TEXT("Async task already running"));
+			return;
+		}
+
+		LaunchTask();
+	}
+}
+
+void UFlowNodeAsync::RunErasedAsyncTask(TUniqueFunction<TUniqueFunction<void()>(const FFlowAsyncTaskCancellation&)>&& Work)
+{
+	CancelTask();
+
+	bTaskRunning = true;
+	MarkSaveDataDirty();
+
+	const uint32 LaunchedSerial = TaskSerial;
+	TaskCancellation = MakeShared<FFlowAsyncTaskCancellation>();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = TWeakObjectPtr<UFlowNodeAsync>(this), LaunchedSerial, Cancellation = TaskCancellation.ToSharedRef(), Work = MoveTemp(Work)]() mutable
+	{
+		if (Cancellation->IsCancelled())
+		{
+			return;
+		}
+
+		TUniqueFunction<void()> OnCompleted = Work(*Cancellation);
+		if (Cancellation->IsCancelled())
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, LaunchedSerial, OnCompleted = MoveTemp(OnCompleted)]() mutable
+		{
+			// the node might have been destroyed, or finished and activated again meanwhile
+			if (UFlowNodeAsync* Node = WeakThis.Get())
+			{
+				Node->CompleteTask(LaunchedSerial, MoveTemp(OnCompleted));
+			}
+		});
+	});
+}
+
+void UFlowNodeAsync::CompleteTask(const uint32 CompletedSerial, TUniqueFunction<void()>&& OnCompleted)
+{
+	if (!bTaskRunning || CompletedSerial != TaskSerial)
+	{
+		return;
+	}
+
+	bTaskRunning = false;
+	TaskSerial++;
+	TaskCancellation.Reset();
+	MarkSaveDataDirty();
+
+	OnCompleted();
+}
+
+void UFlowNodeAsync::CancelTask()
+{
+	if (TaskCancellation.IsValid())
+	{
+		TaskCancellation->Cancel();
+		TaskCancellation.Reset();
+	}
+
+	if (bTaskRunning)
+	{
+		bTaskRunning = false;
+		MarkSaveDataDirty();
+	}
+
+	TaskSerial++;
+}
+
+void UFlowNodeAsync::ForceFinishNode()
+{
+	CancelTask();
+
+	Super::ForceFinishNode();
+}
+
+void UFlowNodeAsync::Cleanup()
+{
+	CancelTask();
+
+	Super::Cleanup();
+}
+
+void UFlowNodeAsync::DeinitializeInstance()
+{
+	CancelTask();
+
+	Super::DeinitializeInstance();
+}
+
+void UFlowNodeAsync::OnLoad_Implementation()
+{
+	Super::OnLoad_Implementation();
+
+	// the result wasn't saved, so the task runs again from the loaded inputs
+	if (bTaskRunning)
+	{
+		bTaskRunning = false;
+		LaunchTask();
+	}
+}
+
+#if WITH_EDITOR
+
+FString UFlowNodeAsync::GetStatusString() const
+{
+	return bTaskRunning ? LOCTEXT("TaskRunning", "Running async task").ToString() : FString();
+}
+
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -5,23 +5,29 @@
 #include "AddOns/FlowNodeAddOn.h"
 #include "FlowAsset.h"
 #include "FlowLogChannels.h"
+#include "FlowStats.h"
 #include "FlowSubsystem.h"
 #include "FlowTypes.h"
 #include "Interfaces/FlowDataPinValueSupplierInterface.h"
+#include "Interfaces/FlowPredicateInterface.h"
 #include "Types/FlowArray.h"
+#include "Types/FlowDataPinHandle.h"
 
 #include "Components/ActorComponent.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #endif
 
+#include "Engine/AssetManager.h"
 #include "Engine/Blueprint.h"
 #include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/ViewportStatsSubsystem.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Misc/App.h"
 #include "Misc/Paths.h"
+#include "Misc/ReverseIterate.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 
@@ -62,9 +68,19 @@ UWorld* UFlowNodeBase::GetWorld() const
 	return nullptr;
 }
 
+void UFlowNodeBase::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// AddOns instanced with the node are its subobjects, UObject::GetResourceSizeEx already visits them in the EstimatedTotal mode
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(AddOns.GetAllocatedSize());
+}
+
 void UFlowNodeBase::InitializeInstance()
 {
-	IFlowCoreExecutableInterface::InitializeInstance();
+	// Blueprint events not implemented by this class are skipped without going through ProcessEvent
+	BlueprintEvents = FFlowBlueprintEvents::Get(*GetClass());
+	ProcessBlueprintEvent(BlueprintEvents->InitializeInstance);
 
 	if (!AddOns.IsEmpty())
 	{
@@ -73,8 +89,13 @@ void UFlowNodeBase::InitializeInstance()
 
 		for (UFlowNodeAddOn* SourceAddOn : SourceAddOns)
 		{
+			// Reuse AddOn instance, if this node has been taken from the Flow Subsystem pool
+			if (IsValid(SourceAddOn) && SourceAddOn->GetOuter() == this)
+			{
+				AddOns.Add(SourceAddOn);
+			}
 			// Create a new instance of each AddOn
-			if (IsValid(SourceAddOn))
+			else if (IsValid(SourceAddOn))
 			{
 				UFlowNodeAddOn* NewAddOnInstance = NewObject<UFlowNodeAddOn>(this, SourceAddOn->GetClass(), NAME_None, RF_Transient, SourceAddOn, false, nullptr);
 				AddOns.Add(NewAddOnInstance);
@@ -91,21 +112,30 @@ void UFlowNodeBase::InitializeInstance()
 			AddOn->InitializeInstance();
 		}
 	}
+
+	// only nodes dispatch to AddOns, nested AddOns are covered by the node's tables
+	if (GetFlowNodeSelfOrOwner() == this)
+	{
+		BuildAddOnDispatchTables();
+	}
 }
 
 void UFlowNodeBase::DeinitializeInstance()
 {
+	AddOnDispatchTables.Reset();
+
 	for (UFlowNodeAddOn* AddOn : AddOns)
 	{
 		AddOn->DeinitializeInstance();
 	}
 
-	IFlowCoreExecutableInterface::DeinitializeInstance();
+	ProcessBlueprintEvent(GetBlueprintEvents().DeinitializeInstance);
+	BlueprintEvents.Reset();
 }
 
 void UFlowNodeBase::PreloadContent()
 {
-	IFlowCoreExecutableInterface::PreloadContent();
+	ProcessBlueprintEvent(GetBlueprintEvents().PreloadContent);
 
 	for (UFlowNodeAddOn* AddOn : AddOns)
 	{
@@ -120,12 +150,12 @@ void UFlowNodeBase::FlushContent()
 		AddOn->FlushContent();
 	}
 
-	IFlowCoreExecutableInterface::FlushContent();
+	ProcessBlueprintEvent(GetBlueprintEvents().FlushContent);
 }
 
 void UFlowNodeBase::OnActivate()
 {
-	IFlowCoreExecutableInterface::OnActivate();
+	ProcessBlueprintEvent(GetBlueprintEvents().OnActivate);
 
 	for (UFlowNodeAddOn* AddOn : AddOns)
 	{
@@ -135,6 +165,8 @@ void UFlowNodeBase::OnActivate()
 
 void UFlowNodeBase::ExecuteInputForSelfAndAddOns(const FName& PinName)
 {
+	FLOW_TRACE_SCOPE_TEXT(TEXT("ExecuteInput %s.%s"), *GetClass()->GetName(), *PinName.ToString());
+
 	// AddOns can introduce input pins to Nodes without the Node being aware of the addition.
 	// To ensure that Nodes and AddOns only get the input pins signalled that they expect,
 	// we are filtering the PinName vs. the expected InputPins before carrying on with the ExecuteInput
@@ -144,6 +176,22 @@ void UFlowNodeBase::ExecuteInputForSelfAndAddOns(const FName& PinName)
 		ExecuteInput(PinName);
 	}
 
+	// pinned, as finishing the flow from an AddOn deinitializes this node
+	if (const TSharedPtr<const FFlowAddOnDispatchTables> Tables = AddOnDispatchTables)
+	{
+		// the whole AddOn tree in the order of the recursive dispatch below
+		for (UFlowNodeAddOn* AddOn : Tables->AddOns)
+		{
+			FLOW_TRACE_SCOPE_TEXT(TEXT("ExecuteInput %s.%s"), *AddOn->GetClass()->GetName(), *PinName.ToString());
+
+			if (AddOn->IsSupportedInputPinName(PinName))
+			{
+				AddOn->ExecuteInput(PinName);
+			}
+		}
+		return;
+	}
+
 	for (UFlowNodeAddOn* AddOn : AddOns)
 	{
 		AddOn->ExecuteInputForSelfAndAddOns(PinName);
@@ -152,7 +200,16 @@ void UFlowNodeBase::ExecuteInputForSelfAndAddOns(const FName& PinName)
 
 void UFlowNodeBase::ExecuteInput(const FName& PinName)
 {
-	IFlowCoreExecutableInterface::ExecuteInput(PinName);
+	if (UFunction* Function = GetBlueprintEvents().ExecuteInput)
+	{
+		// matches parameters of IFlowCoreExecutableInterface::K2_ExecuteInput
+		struct FParms
+		{
+			FName PinName;
+		} Parms{PinName};
+
+		ProcessEvent(Function, &Parms);
+	}
 }
 
 void UFlowNodeBase::ForceFinishNode()
@@ -162,7 +219,7 @@ void UFlowNodeBase::ForceFinishNode()
 		AddOn->ForceFinishNode();
 	}
 
-	IFlowCoreExecutableInterface::ForceFinishNode();
+	ProcessBlueprintEvent(GetBlueprintEvents().ForceFinishNode);
 }
 
 void UFlowNodeBase::Cleanup()
@@ -172,7 +229,7 @@ void UFlowNodeBase::Cleanup()
 		AddOn->Cleanup();
 	}
 
-	IFlowCoreExecutableInterface::Cleanup();
+	ProcessBlueprintEvent(GetBlueprintEvents().Cleanup);
 }
 
 void UFlowNodeBase::TriggerOutputPin(const FFlowOutputPinHandle Pin, const bool bFinish, const EFlowPinActivationType ActivationType)
@@ -285,26 +342,9 @@ UFlowSubsystem* UFlowNodeBase::GetFlowSubsystem() const
 
 AActor* UFlowNodeBase::TryGetRootFlowActorOwner() const
 {
-	AActor* OwningActor = nullptr;
-
-	UObject* RootFlowOwner = TryGetRootFlowObjectOwner();
-
-	if (IsValid(RootFlowOwner))
-	{
-		// Check if the immediate parent is an AActor
-		OwningActor = Cast<AActor>(RootFlowOwner);
-
-		if (!IsValid(OwningActor))
-		{
-			// Check if the immediate parent is an UActorComponent and return that Component's Owning actor
-			if (const UActorComponent* OwningComponent = Cast<UActorComponent>(RootFlowOwner))
-			{
-				OwningActor = OwningComponent->GetOwner();
-			}
-		}
-	}
-
-	return OwningActor;
+	// resolved once by the instance, instead of casting the owner on every call
+	const UFlowAsset* FlowAsset = GetFlowAsset();
+	return IsValid(FlowAsset) ? FlowAsset->GetRootFlowActorOwner() : nullptr;
 }
 
 UObject* UFlowNodeBase::TryGetRootFlowObjectOwner() const
@@ -322,34 +362,7 @@ UObject* UFlowNodeBase::TryGetRootFlowObjectOwner() const
 IFlowOwnerInterface* UFlowNodeBase::GetFlowOwnerInterface() const
 {
 	const UFlowAsset* FlowAsset = GetFlowAsset();
-	if (!IsValid(FlowAsset))
-	{
-		return nullptr;
-	}
-
-	const UClass* ExpectedOwnerClass = FlowAsset->GetExpectedOwnerClass();
-	if (!IsValid(ExpectedOwnerClass))
-	{
-		return nullptr;
-	}
-
-	UObject* RootFlowOwner = FlowAsset->GetOwner();
-	if (!IsValid(RootFlowOwner))
-	{
-		return nullptr;
-	}
-
-	if (IFlowOwnerInterface* FlowOwnerInterface = TryGetFlowOwnerInterfaceFromRootFlowOwner(*RootFlowOwner, *ExpectedOwnerClass))
-	{
-		return FlowOwnerInterface;
-	}
-
-	if (IFlowOwnerInterface* FlowOwnerInterface = TryGetFlowOwnerInterfaceActor(*RootFlowOwner, *ExpectedOwnerClass))
-	{
-		return FlowOwnerInterface;
-	}
-
-	return nullptr;
+	return IsValid(FlowAsset) ? FlowAsset->GetFlowOwnerInterface() : nullptr;
 }
 
 TArray<UFlowNodeBase*> UFlowNodeBase::BuildFlowNodeBaseAncestorChain(UFlowNodeBase& FromFlowNodeBase, bool bIncludeFromFlowNodeBase)
@@ -464,12 +477,88 @@ EFlowAddOnAcceptResult UFlowNodeBase::CheckAcceptFlowNodeAddOnChild(
 }
 #endif // WITH_EDITOR
 
+const TArray<UFlowNodeAddOn*>* FFlowAddOnDispatchTables::FindTableForClass(const UClass& InterfaceOrClass) const
+{
+	if (&InterfaceOrClass == UFlowPredicateInterface::StaticClass())
+	{
+		return &Predicates;
+	}
+
+	if (&InterfaceOrClass == UFlowDataPinValueSupplierInterface::StaticClass())
+	{
+		return &DataPinSuppliers;
+	}
+
+	if (&InterfaceOrClass == UFlowNodeAddOn::StaticClass())
+	{
+		return &AddOns;
+	}
+
+	return nullptr;
+}
+
+template <typename TFunction>
+static EFlowForEachAddOnFunctionReturnValue ForEachAddOnInTable(const TArray<UFlowNodeAddOn*>& Table, const TFunction& Function)
+{
+	EFlowForEachAddOnFunctionReturnValue ReturnValue = EFlowForEachAddOnFunctionReturnValue::Continue;
+
+	for (UFlowNodeAddOn* AddOn : Table)
+	{
+		ReturnValue = Function(*AddOn);
+
+		if (!ShouldContinueForEach(ReturnValue))
+		{
+			break;
+		}
+	}
+
+	return ReturnValue;
+}
+
+void UFlowNodeBase::BuildAddOnDispatchTables()
+{
+	AddOnDispatchTables.Reset();
+
+	if (AddOns.IsEmpty())
+	{
+		return;
+	}
+
+	const TSharedRef<FFlowAddOnDispatchTables> Tables = MakeShared<FFlowAddOnDispatchTables>();
+
+	(void) ForEachAddOn([&Tables](UFlowNodeAddOn& AddOn)
+	{
+		Tables->AddOns.Add(&AddOn);
+
+		if (AddOn.IsClassOrImplementsInterface<UFlowPredicateInterface>())
+		{
+			Tables->Predicates.Add(&AddOn);
+		}
+
+		if (AddOn.IsClassOrImplementsInterface<UFlowDataPinValueSupplierInterface>())
+		{
+			Tables->DataPinSuppliers.Add(&AddOn);
+		}
+
+		return EFlowForEachAddOnFunctionReturnValue::Continue;
+	});
+
+	AddOnDispatchTables = Tables;
+}
+
 EFlowForEachAddOnFunctionReturnValue UFlowNodeBase::ForEachAddOnConst(
 	const FConstFlowNodeAddOnFunction& Function,
 	EFlowForEachAddOnChildRule AddOnChildRule) const
 {
 	FLOW_ASSERT_ENUM_MAX(EFlowForEachAddOnFunctionReturnValue, 3);
 
+	// pinned, as the function might deinitialize this node
+	const TSharedPtr<const FFlowAddOnDispatchTables> Tables = AddOnDispatchTables;
+	if (Tables.IsValid() && AddOnChildRule == EFlowForEachAddOnChildRule::AllChildren)
+	{
+		return ForEachAddOnInTable(Tables->AddOns, Function);
+	}
+
 	EFlowForEachAddOnFunctionReturnValue ReturnValue = EFlowForEachAddOnFunctionReturnValue::Continue;
 
 	for (const UFlowNodeAddOn* AddOn : AddOns)
@@ -507,6 +596,13 @@ EFlowForEachAddOnFunctionReturnValue UFlowNodeBase::ForEachAddOn(
 {
 	FLOW_ASSERT_ENUM_MAX(EFlowForEachAddOnFunctionReturnValue, 3);
 
+	// pinned, as the function might deinitialize this node
+	const TSharedPtr<const FFlowAddOnDispatchTables> Tables = AddOnDispatchTables;
+	if (Tables.IsValid() && AddOnChildRule == EFlowForEachAddOnChildRule::AllChildren)
+	{
+		return ForEachAddOnInTable(Tables->AddOns, Function);
+	}
+
 	EFlowForEachAddOnFunctionReturnValue ReturnValue = EFlowForEachAddOnFunctionReturnValue::Continue;
 
 	for (UFlowNodeAddOn* AddOn : AddOns)
@@ -545,6 +641,16 @@ EFlowForEachAddOnFunctionReturnValue UFlowNodeBase::ForEachAddOnForClassConst(
 {
 	FLOW_ASSERT_ENUM_MAX(EFlowForEachAddOnFunctionReturnValue, 3);
 
+	// pinned, as the function might deinitialize this node
+	const TSharedPtr<const FFlowAddOnDispatchTables> Tables = AddOnDispatchTables;
+	if (Tables.IsValid() && AddOnChildRule == EFlowForEachAddOnChildRule::AllChildren)
+	{
+		if (const TArray<UFlowNodeAddOn*>* Table = Tables->FindTableForClass(InterfaceOrClass))
+		{
+			return ForEachAddOnInTable(*Table, Function);
+		}
+	}
+
 	EFlowForEachAddOnFunctionReturnValue ReturnValue = EFlowForEachAddOnFunctionReturnValue::Continue;
 
 	for (const UFlowNodeAddOn* AddOn : AddOns)
@@ -586,6 +692,16 @@ EFlowForEachAddOnFunctionReturnValue UFlowNodeBase::ForEachAddOnForClass(
 {
 	FLOW_ASSERT_ENUM_MAX(EFlowForEachAddOnFunctionReturnValue, 3);
 
+	// pinned, as the function might deinitialize this node
+	const TSharedPtr<const FFlowAddOnDispatchTables> Tables = AddOnDispatchTables;
+	if (Tables.IsValid() && AddOnChildRule == EFlowForEachAddOnChildRule::AllChildren)
+	{
+		if (const TArray<UFlowNodeAddOn*>* Table = Tables->FindTableForClass(InterfaceOrClass))
+		{
+			return ForEachAddOnInTable(*Table, Function);
+		}
+	}
+
 	EFlowForEachAddOnFunctionReturnValue ReturnValue = EFlowForEachAddOnFunctionReturnValue::Continue;
 
 	for (UFlowNodeAddOn* AddOn : AddOns)
@@ -845,10 +961,58 @@ void UFlowNodeBase::UpdateNodeConfigText_Implementation()
 
 void UFlowNodeBase::LogError(FString Message, const EFlowOnScreenMessageType OnScreenMessageType) const
 {
-#if !UE_BUILD_SHIPPING
-	if (BuildMessage(Message))
+	LogMessage(LogFlow, ELogVerbosity::Error, MoveTemp(Message), OnScreenMessageType);
+}
+
+void UFlowNodeBase::LogWarning(FString Message) const
+{
+	LogMessage(LogFlow, ELogVerbosity::Warning, MoveTemp(Message));
+}
+
+void UFlowNodeBase::LogNote(FString Message) const
+{
+	LogMessage(LogFlow, ELogVerbosity::Log, MoveTemp(Message));
+}
+
+void UFlowNodeBase::LogVerbose(FString Message) const
+{
+	LogMessage(LogFlow, ELogVerbosity::Verbose, MoveTemp(Message));
+}
+
+void UFlowNodeBase::LogMessage(const FLogCategoryBase& Category, const ELogVerbosity::Type Verbosity, FString Message, const EFlowOnScreenMessageType OnScreenMessageType) const
+{
+#if !UE_BUILD_SHIPPING && !NO_LOGGING
+	const bool bError = Verbosity == ELogVerbosity::Error;
+
+	// errors are displayed on screen even if the category is silenced
+	if (!bError && Category.IsSuppressed(Verbosity))
+	{
+		return;
+	}
+
+	// on-screen messages and Message Log are game thread only
+	if (UFlowAsset* FlowAsset = GetFlowAsset(); FlowAsset && FlowAsset->IsExecutingIsolated() && Verbosity <= ELogVerbosity::Log)
+	{
+		FlowAsset->DeferIsolatedSideEffect([WeakThis = TWeakObjectPtr<const UFlowNodeBase>(this), &Category, Verbosity, Message = MoveTemp(Message), OnScreenMessageType]() mutable
+		{
+			if (const UFlowNodeBase* ThisPtr = WeakThis.Get())
+			{
+				ThisPtr->LogMessage(Category, Verbosity, MoveTemp(Message), OnScreenMessageType);
+			}
+		});
+		return;
+	}
+
+	if (!BuildMessage(Message))
+	{
+		return;
+	}
+
+	const bool bLeanServer = GetFlowAsset()->IsLeanServerInstance();
+
+	// OnScreen Message, nobody would see it on the lean server
+	if (bError && !bLeanServer)
 	{
-		// OnScreen Message
 		if (OnScreenMessageType == EFlowOnScreenMessageType::Permanent)
 		{
 			if (UWorld* World = GetWorld())
@@ -874,67 +1038,34 @@ void UFlowNodeBase::LogError(FString Message, const EFlowOnScreenMessageType OnS
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, Message);
 		}
-
-		// Output Log
-		UE_LOG(LogFlow, Error, TEXT("%s"), *Message);
-
-#if WITH_EDITOR
-		if (GEditor)
-		{
-			// Message Log
-			GetFlowAsset()->GetTemplateAsset()->LogError(Message, this);
-		}
-#endif
 	}
-#endif
-}
 
-void UFlowNodeBase::LogWarning(FString Message) const
-{
-#if !UE_BUILD_SHIPPING
-	if (BuildMessage(Message))
+	// Output Log
+	if (!Category.IsSuppressed(Verbosity))
 	{
-		// Output Log
-		UE_LOG(LogFlow, Warning, TEXT("%s"), *Message);
-
-#if WITH_EDITOR
-		if (GEditor)
-		{
-			// Message Log
-			GetFlowAsset()->GetTemplateAsset()->LogWarning(Message, this);
-		}
-#endif
+		FMsg::Logf(__FILE__, __LINE__, Category.GetCategoryName(), Verbosity, TEXT("%s"), *Message);
 	}
-#endif
-}
-
-void UFlowNodeBase::LogNote(FString Message) const
-{
-#if !UE_BUILD_SHIPPING
-	if (BuildMessage(Message))
-	{
-		// Output Log
-		UE_LOG(LogFlow, Log, TEXT("%s"), *Message);
 
 #if WITH_EDITOR
-		if (GEditor)
+	if (GEditor && !bLeanServer)
+	{
+		// Message Log
+		switch (Verbosity)
 		{
-			// Message Log
-			GetFlowAsset()->GetTemplateAsset()->LogNote(Message, this);
+			case ELogVerbosity::Error:
+				GetFlowAsset()->GetTemplateAsset()->LogError(Message, this);
+				break;
+			case ELogVerbosity::Warning:
+				GetFlowAsset()->GetTemplateAsset()->LogWarning(Message, this);
+				break;
+			case ELogVerbosity::Display:
+			case ELogVerbosity::Log:
+				GetFlowAsset()->GetTemplateAsset()->LogNote(Message, this);
+				break;
+			default: ;
 		}
-#endif
 	}
 #endif
-}
-
-void UFlowNodeBase::LogVerbose(FString Message) const
-{
-#if !UE_BUILD_SHIPPING
-	if (BuildMessage(Message))
-	{
-		// Output Log
-		UE_LOG(LogFlow, Verbose, TEXT("%s"), *Message);
-	}
 #endif
 }
 
@@ -962,8 +1093,19 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 		return false;
 	}
 
-	const EFlowPinType FlowPinType = FlowDataPinProperty->GetFlowPinType();
+	FFormatArgumentValue Value;
+	if (TryResolveDataPinAsFormatArgumentValue(NamedDataPinProperty.Name, FlowDataPinProperty->GetFlowPinType(), Value))
+	{
+		InOutArguments.Add(NamedDataPinProperty.Name.ToString(), MoveTemp(Value));
+
+		return true;
+	}
+
+	return false;
+}
 
+bool UFlowNodeBase::TryResolveDataPinAsFormatArgumentValue(const FName& PinName, const EFlowPinType FlowPinType, FFormatArgumentValue& OutValue) const
+{
 	FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
 	switch (FlowPinType)
 	{
@@ -981,10 +1123,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Bool:
 		{
-			const FFlowDataPinResult_Bool ResolvedResult = TryResolveDataPinAsBool(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Bool ResolvedResult = TryResolveDataPinAsBool(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(ResolvedResult.Value));
+				OutValue = FFormatArgumentValue(ResolvedResult.Value);
 
 				return true;
 			}
@@ -993,10 +1135,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Int:
 		{
-			const FFlowDataPinResult_Int ResolvedResult = TryResolveDataPinAsInt(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Int ResolvedResult = TryResolveDataPinAsInt(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(ResolvedResult.Value));
+				OutValue = FFormatArgumentValue(ResolvedResult.Value);
 
 				return true;
 			}
@@ -1005,10 +1147,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Float:
 		{
-			const FFlowDataPinResult_Float ResolvedResult = TryResolveDataPinAsFloat(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Float ResolvedResult = TryResolveDataPinAsFloat(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(ResolvedResult.Value));
+				OutValue = FFormatArgumentValue(ResolvedResult.Value);
 
 				return true;
 			}
@@ -1017,10 +1159,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Name:
 		{
-			const FFlowDataPinResult_Name ResolvedResult = TryResolveDataPinAsName(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Name ResolvedResult = TryResolveDataPinAsName(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1029,10 +1171,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::String:
 		{
-			const FFlowDataPinResult_String ResolvedResult = TryResolveDataPinAsString(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_String ResolvedResult = TryResolveDataPinAsString(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value)));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value));
 
 				return true;
 			}
@@ -1041,10 +1183,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Text:
 		{
-			const FFlowDataPinResult_Text ResolvedResult = TryResolveDataPinAsText(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Text ResolvedResult = TryResolveDataPinAsText(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(ResolvedResult.Value));
+				OutValue = FFormatArgumentValue(ResolvedResult.Value);
 
 				return true;
 			}
@@ -1053,10 +1195,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Enum:
 		{
-			const FFlowDataPinResult_Enum ResolvedResult = TryResolveDataPinAsEnum(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Enum ResolvedResult = TryResolveDataPinAsEnum(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1065,10 +1207,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Vector:
 		{
-			const FFlowDataPinResult_Vector ResolvedResult = TryResolveDataPinAsVector(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Vector ResolvedResult = TryResolveDataPinAsVector(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1077,10 +1219,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Rotator:
 		{
-			const FFlowDataPinResult_Rotator ResolvedResult = TryResolveDataPinAsRotator(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Rotator ResolvedResult = TryResolveDataPinAsRotator(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1089,10 +1231,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Transform:
 		{
-			const FFlowDataPinResult_Transform ResolvedResult = TryResolveDataPinAsTransform(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Transform ResolvedResult = TryResolveDataPinAsTransform(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1101,10 +1243,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::GameplayTag:
 		{
-			const FFlowDataPinResult_GameplayTag ResolvedResult = TryResolveDataPinAsGameplayTag(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_GameplayTag ResolvedResult = TryResolveDataPinAsGameplayTag(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1113,10 +1255,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::GameplayTagContainer:
 		{
-			const FFlowDataPinResult_GameplayTagContainer ResolvedResult = TryResolveDataPinAsGameplayTagContainer(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_GameplayTagContainer ResolvedResult = TryResolveDataPinAsGameplayTagContainer(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value.ToString()));
 
 				return true;
 			}
@@ -1125,16 +1267,16 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Object:
 		{
-			const FFlowDataPinResult_Object ResolvedResult = TryResolveDataPinAsObject(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Object ResolvedResult = TryResolveDataPinAsObject(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
 				if (IsValid(ResolvedResult.Value))
 				{
-					InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.Value->GetName())));
+					OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.Value->GetName()));
 				}
 				else
 				{
-					InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(TEXT("null"))));
+					OutValue = FFormatArgumentValue(FText::FromString(TEXT("null")));
 				}
 
 				return true;
@@ -1144,10 +1286,10 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 
 	case EFlowPinType::Class:
 		{
-			const FFlowDataPinResult_Class ResolvedResult = TryResolveDataPinAsClass(NamedDataPinProperty.Name);
+			const FFlowDataPinResult_Class ResolvedResult = TryResolveDataPinAsClass(PinName);
 			if (ResolvedResult.Result == EFlowDataPinResolveResult::Success)
 			{
-				InOutArguments.Add(NamedDataPinProperty.Name.ToString(), FFormatArgumentValue(FText::FromString(ResolvedResult.GetAsSoftClass().ToString())));
+				OutValue = FFormatArgumentValue(FText::FromString(ResolvedResult.GetAsSoftClass().ToString()));
 
 				return true;
 			}
@@ -1160,7 +1302,7 @@ bool UFlowNodeBase::TryAddValueToFormatNamedArguments(const FFlowNamedDataPinPro
 	return false;
 }
 
-EFlowDataPinResolveResult UFlowNodeBase::TryResolveDataPinPrerequisites(const FName& PinName, const UFlowNode*& FlowNode, const FFlowPin*& FlowPin, EFlowPinType PinType) const
+EFlowDataPinResolveResult UFlowNodeBase::TryResolveDataPinPrerequisites(const FName& PinName, const UFlowNode*& FlowNode, const FFlowPin*& FlowPin, EFlowPinType PinType, bool bIsArray) const
 {
 	FlowNode = GetFlowNodeSelfOrOwner();
 
@@ -1177,7 +1319,7 @@ EFlowDataPinResolveResult UFlowNodeBase::TryResolveDataPinPrerequisites(const FN
 		return EFlowDataPinResolveResult::FailedMissingPin;
 	}
 
-	if (FlowPin->GetPinType() != PinType)
+	if (FlowPin->GetPinType() != PinType || FlowPin->IsArray() != bIsArray)
 	{
 		return EFlowDataPinResolveResult::FailedMismatchedType;
 	}
@@ -1202,6 +1344,8 @@ bool TResolveDataPinWorkingData<TFlowDataPinResultType, PinType>::TrySetupWorkin
 		return false;
 	}
 
+	INC_DWORD_STAT_BY(STAT_FlowDataPinSuppliersVisited, PinValueSupplierDatas.Num());
+
 	// If we could not build the PinValueDataSuppliers array, 
 	// then the pin must be disconnected and have no default value available.
 	DataPinResult.Result = EFlowDataPinResolveResult::FailedUnconnected;
@@ -1211,15 +1355,17 @@ bool TResolveDataPinWorkingData<TFlowDataPinResultType, PinType>::TrySetupWorkin
 
 FFlowDataPinResult_Bool UFlowNodeBase::TryResolveDataPinAsBool(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Bool, EFlowPinType::Bool> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsBool(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Bool>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1232,15 +1378,17 @@ FFlowDataPinResult_Bool UFlowNodeBase::TryResolveDataPinAsBool(const FName& PinN
 
 FFlowDataPinResult_Int UFlowNodeBase::TryResolveDataPinAsInt(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Int, EFlowPinType::Int> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInt(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Int>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1253,15 +1401,17 @@ FFlowDataPinResult_Int UFlowNodeBase::TryResolveDataPinAsInt(const FName& PinNam
 
 FFlowDataPinResult_Float UFlowNodeBase::TryResolveDataPinAsFloat(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Float, EFlowPinType::Float> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsFloat(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Float>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1274,15 +1424,17 @@ FFlowDataPinResult_Float UFlowNodeBase::TryResolveDataPinAsFloat(const FName& Pi
 
 FFlowDataPinResult_Name UFlowNodeBase::TryResolveDataPinAsName(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Name, EFlowPinType::Name> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsName(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Name>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1295,15 +1447,17 @@ FFlowDataPinResult_Name UFlowNodeBase::TryResolveDataPinAsName(const FName& PinN
 
 FFlowDataPinResult_String UFlowNodeBase::TryResolveDataPinAsString(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_String, EFlowPinType::String> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsString(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_String>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1316,15 +1470,17 @@ FFlowDataPinResult_String UFlowNodeBase::TryResolveDataPinAsString(const FName&
 
 FFlowDataPinResult_Text UFlowNodeBase::TryResolveDataPinAsText(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Text, EFlowPinType::Text> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsText(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Text>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1337,15 +1493,17 @@ FFlowDataPinResult_Text UFlowNodeBase::TryResolveDataPinAsText(const FName& PinN
 
 FFlowDataPinResult_Enum UFlowNodeBase::TryResolveDataPinAsEnum(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Enum, EFlowPinType::Enum> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsEnum(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Enum>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1358,15 +1516,17 @@ FFlowDataPinResult_Enum UFlowNodeBase::TryResolveDataPinAsEnum(const FName& PinN
 
 FFlowDataPinResult_Vector UFlowNodeBase::TryResolveDataPinAsVector(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Vector, EFlowPinType::Vector> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsVector(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Vector>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1379,15 +1539,17 @@ FFlowDataPinResult_Vector UFlowNodeBase::TryResolveDataPinAsVector(const FName&
 
 FFlowDataPinResult_Rotator UFlowNodeBase::TryResolveDataPinAsRotator(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Rotator, EFlowPinType::Rotator> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsRotator(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Rotator>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1400,15 +1562,17 @@ FFlowDataPinResult_Rotator UFlowNodeBase::TryResolveDataPinAsRotator(const FName
 
 FFlowDataPinResult_Transform UFlowNodeBase::TryResolveDataPinAsTransform(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Transform, EFlowPinType::Transform> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsTransform(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Transform>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1421,15 +1585,17 @@ FFlowDataPinResult_Transform UFlowNodeBase::TryResolveDataPinAsTransform(const F
 
 FFlowDataPinResult_GameplayTag UFlowNodeBase::TryResolveDataPinAsGameplayTag(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_GameplayTag, EFlowPinType::GameplayTag> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTag(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_GameplayTag>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1442,15 +1608,17 @@ FFlowDataPinResult_GameplayTag UFlowNodeBase::TryResolveDataPinAsGameplayTag(con
 
 FFlowDataPinResult_GameplayTagContainer UFlowNodeBase::TryResolveDataPinAsGameplayTagContainer(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_GameplayTagContainer, EFlowPinType::GameplayTagContainer> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTagContainer(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_GameplayTagContainer>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1463,15 +1631,17 @@ FFlowDataPinResult_GameplayTagContainer UFlowNodeBase::TryResolveDataPinAsGamepl
 
 FFlowDataPinResult_InstancedStruct UFlowNodeBase::TryResolveDataPinAsInstancedStruct(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_InstancedStruct, EFlowPinType::InstancedStruct> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInstancedStruct(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_InstancedStruct>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1484,15 +1654,17 @@ FFlowDataPinResult_InstancedStruct UFlowNodeBase::TryResolveDataPinAsInstancedSt
 
 FFlowDataPinResult_Object UFlowNodeBase::TryResolveDataPinAsObject(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Object, EFlowPinType::Object> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsObject(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Object>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1505,15 +1677,17 @@ FFlowDataPinResult_Object UFlowNodeBase::TryResolveDataPinAsObject(const FName&
 
 FFlowDataPinResult_Class UFlowNodeBase::TryResolveDataPinAsClass(const FName& PinName) const
 {
+	FLOW_RESOLVE_DATA_PIN_SCOPE(PinName);
+
 	TResolveDataPinWorkingData<FFlowDataPinResult_Class, EFlowPinType::Class> WorkData;
 	if (!WorkData.TrySetupWorkingData(PinName, *this))
 	{
 		return WorkData.DataPinResult;
 	}
 
-	for (const FFlowPinValueSupplierData& SupplierData : WorkData.PinValueSupplierDatas)
+	for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(WorkData.PinValueSupplierDatas))
 	{
-		WorkData.DataPinResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsClass(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName);
+		WorkData.DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_Class>(SupplierData);
 
 		if (WorkData.DataPinResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -1523,3 +1697,152 @@ FFlowDataPinResult_Class UFlowNodeBase::TryResolveDataPinAsClass(const FName& Pi
 
 	return WorkData.DataPinResult;
 }
+
+TSharedPtr<FStreamableHandle> UFlowNodeBase::TryResolveDataPinAsObjectAsync(const FName& PinName, TFunction<void(const FFlowDataPinResult_Object&)> OnResolved) const
+{
+	FFlowDataPinResult_Object ResolvedResult = TryResolveDataPinAsObject(PinName);
+	if (ResolvedResult.Result != EFlowDataPinResolveResult::Success || ResolvedResult.Value || ResolvedResult.ValuePath.IsNull())
+	{
+		OnResolved(ResolvedResult);
+		return nullptr;
+	}
+
+	const FSoftObjectPath PathToLoad = ResolvedResult.ValuePath;
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(PathToLoad, FStreamableDelegate::CreateWeakLambda(this, [ResolvedResult = MoveTemp(ResolvedResult), OnResolved = MoveTemp(OnResolved)]() mutable
+	{
+		ResolvedResult.Value = ResolvedResult.ValuePath.ResolveObject();
+		OnResolved(ResolvedResult);
+	}));
+}
+
+TSharedPtr<FStreamableHandle> UFlowNodeBase::TryResolveDataPinAsClassAsync(const FName& PinName, TFunction<void(const FFlowDataPinResult_Class&)> OnResolved) const
+{
+	FFlowDataPinResult_Class ResolvedResult = TryResolveDataPinAsClass(PinName);
+	const FSoftClassPath PathToLoad = ResolvedResult.GetAsSoftClass();
+	if (ResolvedResult.Result != EFlowDataPinResolveResult::Success || ResolvedResult.GetOrResolveClass() || PathToLoad.IsNull())
+	{
+		OnResolved(ResolvedResult);
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(PathToLoad, FStreamableDelegate::CreateWeakLambda(this, [ResolvedResult = MoveTemp(ResolvedResult), PathToLoad, OnResolved = MoveTemp(OnResolved)]() mutable
+	{
+		ResolvedResult.SetValueSoftClassAndClassPtr(PathToLoad, PathToLoad.ResolveClass());
+		OnResolved(ResolvedResult);
+	}));
+}
+
+int32 UFlowNodeBase::TryResolveDataPins(TConstArrayView<FName> PinNames, TArray<TInstancedStruct<FFlowDataPinResult>>& OutResults) const
+{
+	OutResults.Reset(PinNames.Num());
+
+	const UFlowNode* FlowNode = GetFlowNodeSelfOrOwner();
+	if (!IsValid(FlowNode))
+	{
+		LogError(FString::Printf(TEXT("Unexpected for %s to not have an associated FlowNode"), *GetName()), EFlowOnScreenMessageType::Temporary);
+
+		for (int32 Index = 0; Index < PinNames.Num(); ++Index)
+		{
+			OutResults.Add(TInstancedStruct<FFlowDataPinResult>::Make(EFlowDataPinResolveResult::FailedWithError));
+		}
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlowResolveDataPin);
+	CSV_SCOPED_TIMING_STAT(FlowDataPins, ResolveDataPins);
+	INC_DWORD_STAT_BY(STAT_FlowResolvedDataPins, PinNames.Num());
+
+	const TArray<FFlowPin>& InputPins = FlowNode->GetInputPins();
+	FFlowPinValueSupplierDataArray PinValueSupplierDatas;
+	int32 ResolvedCount = 0;
+
+	for (const FName& PinName : PinNames)
+	{
+		const FFlowPin* FlowPin = FindFlowPinByName(PinName, InputPins);
+		if (FlowPin == nullptr || !FlowPin->IsDataPin())
+		{
+			OutResults.Add(TInstancedStruct<FFlowDataPinResult>::Make(FlowPin ? EFlowDataPinResolveResult::FailedMismatchedType : EFlowDataPinResolveResult::FailedMissingPin));
+			continue;
+		}
+
+		PinValueSupplierDatas.Reset();
+		FlowNode->TryGetFlowDataPinSupplierDatasForPinName(FlowPin->PinName, PinValueSupplierDatas);
+		INC_DWORD_STAT_BY(STAT_FlowDataPinSuppliersVisited, PinValueSupplierDatas.Num());
+
+		TInstancedStruct<FFlowDataPinResult>& Result = OutResults.Add_GetRef(TryResolveDataPinWithSuppliers(*FlowPin, PinValueSupplierDatas));
+		if (Result.Get().Result == EFlowDataPinResolveResult::Success)
+		{
+			++ResolvedCount;
+		}
+	}
+
+	return ResolvedCount;
+}
+
+int32 UFlowNodeBase::TryResolveAllInputDataPins(TArray<FName>& OutPinNames, TArray<TInstancedStruct<FFlowDataPinResult>>& OutResults) const
+{
+	OutPinNames.Reset();
+
+	if (const UFlowNode* FlowNode = GetFlowNodeSelfOrOwner())
+	{
+		for (const FFlowPin& FlowPin : FlowNode->GetInputPins())
+		{
+			if (FlowPin.IsDataPin())
+			{
+				OutPinNames.Add(FlowPin.PinName);
+			}
+		}
+	}
+
+	return TryResolveDataPins(OutPinNames, OutResults);
+}
+
+TInstancedStruct<FFlowDataPinResult> UFlowNodeBase::TryResolveDataPinWithSuppliers(const FFlowPin& FlowPin, const FFlowPinValueSupplierDataArray& PinValueSupplierDatas)
+{
+	FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
+
+	// array pins are resolved as views only, see FlowDataPin::TryResolveArray
+	if (FlowPin.IsArray())
+	{
+		return TInstancedStruct<FFlowDataPinResult>::Make(EFlowDataPinResolveResult::FailedMismatchedType);
+	}
+
+#define FLOW_RESOLVE_DATA_PIN_CASE(PinTypeName) \
+	case EFlowPinType::PinTypeName: \
+		{ \
+			FFlowDataPinResult_##PinTypeName DataPinResult(EFlowDataPinResolveResult::FailedUnconnected); \
+			for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(PinValueSupplierDatas)) \
+			{ \
+				DataPinResult = FlowDataPin::Supply<FFlowDataPinResult_##PinTypeName>(SupplierData); \
+				if (DataPinResult.Result == EFlowDataPinResolveResult::Success) \
+				{ \
+					break; \
+				} \
+			} \
+			return TInstancedStruct<FFlowDataPinResult>::Make<FFlowDataPinResult_##PinTypeName>(MoveTemp(DataPinResult)); \
+		}
+
+	switch (FlowPin.GetPinType())
+	{
+	FLOW_RESOLVE_DATA_PIN_CASE(Bool)
+	FLOW_RESOLVE_DATA_PIN_CASE(Int)
+	FLOW_RESOLVE_DATA_PIN_CASE(Float)
+	FLOW_RESOLVE_DATA_PIN_CASE(Name)
+	FLOW_RESOLVE_DATA_PIN_CASE(String)
+	FLOW_RESOLVE_DATA_PIN_CASE(Text)
+	FLOW_RESOLVE_DATA_PIN_CASE(Enum)
+	FLOW_RESOLVE_DATA_PIN_CASE(Vector)
+	FLOW_RESOLVE_DATA_PIN_CASE(Rotator)
+	FLOW_RESOLVE_DATA_PIN_CASE(Transform)
+	FLOW_RESOLVE_DATA_PIN_CASE(GameplayTag)
+	FLOW_RESOLVE_DATA_PIN_CASE(GameplayTagContainer)
+	FLOW_RESOLVE_DATA_PIN_CASE(InstancedStruct)
+	FLOW_RESOLVE_DATA_PIN_CASE(Object)
+	FLOW_RESOLVE_DATA_PIN_CASE(Class)
+	default: break;
+	}
+
+#undef FLOW_RESOLVE_DATA_PIN_CASE
+
+	return TInstancedStruct<FFlowDataPinResult>::Make(EFlowDataPinResolveResult::FailedMismatchedType);
+}
@@ -1,6 +1,12 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/FlowNodeBlueprint.h"
+#include "Nodes/FlowNode.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetData.h"
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNodeBlueprint)
 
@@ -8,3 +14,134 @@ UFlowNodeBlueprint::UFlowNodeBlueprint(const FObjectInitializer& ObjectInitializ
 	: Super(ObjectInitializer)
 {
 }
+
+#if WITH_EDITOR
+void UFlowNodeBlueprint::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+	FFlowNodeBlueprintMetadata::AddAssetRegistryTags(*this, Context);
+}
+
+namespace FlowNodeBlueprintTags
+{
+	static const FName Placeable(TEXT("FlowNodePlaceable"));
+	static const FName Category(TEXT("FlowNodeCategory"));
+	static const FName DisplayName(TEXT("FlowNodeDisplayName"));
+	static const FName ToolTip(TEXT("FlowNodeToolTip"));
+	static const FName Keywords(TEXT("FlowNodeKeywords"));
+	static const FName ClassAncestry(TEXT("FlowNodeClassAncestry"));
+	static const FName AllowedAssetClasses(TEXT("FlowNodeAllowedAssetClasses"));
+	static const FName DeniedAssetClasses(TEXT("FlowNodeDeniedAssetClasses"));
+
+	static const TCHAR* Separator = TEXT(";");
+
+	static FString JoinClassPaths(const TArray<TSubclassOf<UFlowAsset>>& Classes)
+	{
+		TArray<FString> Paths;
+		for (const UClass* Class : Classes)
+		{
+			if (Class)
+			{
+				Paths.Add(Class->GetPathName());
+			}
+		}
+		return FString::Join(Paths, Separator);
+	}
+
+	static void ParseClassPaths(const FString& Value, TArray<FTopLevelAssetPath>& OutPaths)
+	{
+		TArray<FString> Paths;
+		Value.ParseIntoArray(Paths, Separator);
+
+		OutPaths.Reserve(Paths.Num());
+		for (const FString& Path : Paths)
+		{
+			OutPaths.Emplace(Path);
+		}
+	}
+}
+
+void FFlowNodeBlueprintMetadata::AddAssetRegistryTags(const UBlueprint& Blueprint, FAssetRegistryTagsContext Context)
+{
+	using namespace FlowNodeBlueprintTags;
+
+	const UClass* GeneratedClass = Blueprint.GeneratedClass;
+	const UFlowNodeBase* NodeDefaults = GeneratedClass ? GeneratedClass->GetDefaultObject<UFlowNodeBase>() : nullptr;
+	if (NodeDefaults == nullptr)
+	{
+		return;
+	}
+
+	// matches UFlowGraphSchema::IsFlowNodeOrAddOnPlaceable
+	const bool bPlaceable = !GeneratedClass->HasAnyClassFlags(CLASS_Abstract | CLASS_NotPlaceable | CLASS_Deprecated) && !NodeDefaults->bNodeDeprecated;
+	Context.AddTag(UObject::FAssetRegistryTag(Placeable, bPlaceable ? TEXT("True") : TEXT("False"), UObject::FAssetRegistryTag::TT_Hidden));
+
+	Context.AddTag(UObject::FAssetRegistryTag(Category, NodeDefaults->GetNodeCategory(), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(DisplayName, NodeDefaults->GetNodeTitle().ToString(), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(ToolTip, NodeDefaults->GetNodeToolTip().ToString(), UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(Keywords, GeneratedClass->GetMetaData(TEXT("Keywords")), UObject::FAssetRegistryTag::TT_Hidden));
+
+	TArray<FString> Ancestry;
+	for (const UClass* Class = GeneratedClass; Class && Class->IsChildOf(UFlowNodeBase::StaticClass()); Class = Class->GetSuperClass())
+	{
+		Ancestry.Add(Class->GetPathName());
+	}
+	Context.AddTag(UObject::FAssetRegistryTag(ClassAncestry, FString::Join(Ancestry, Separator), UObject::FAssetRegistryTag::TT_Hidden));
+
+	if (const UFlowNode* FlowNodeDefaults = Cast<UFlowNode>(NodeDefaults))
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(AllowedAssetClasses, JoinClassPaths(FlowNodeDefaults->AllowedAssetClasses), UObject::FAssetRegistryTag::TT_Hidden));
+		Context.AddTag(UObject::FAssetRegistryTag(DeniedAssetClasses, JoinClassPaths(FlowNodeDefaults->DeniedAssetClasses), UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+
+bool FFlowNodeBlueprintMetadata::FromAssetData(const FAssetData& AssetData, FFlowNodeBlueprintMetadata& OutMetadata)
+{
+	using namespace FlowNodeBlueprintTags;
+
+	FString PlaceableValue;
+	FString AncestryValue;
+	if (!AssetData.GetTagValue(Placeable, PlaceableValue) || !AssetData.GetTagValue(ClassAncestry, AncestryValue))
+	{
+		return false;
+	}
+
+	OutMetadata = FFlowNodeBlueprintMetadata();
+	OutMetadata.bPlaceable = PlaceableValue.ToBool();
+
+	FString Value;
+	AssetData.GetTagValue(Category, OutMetadata.Category);
+	if (AssetData.GetTagValue(DisplayName, Value))
+	{
+		OutMetadata.DisplayName = FText::FromString(Value);
+	}
+	if (AssetData.GetTagValue(ToolTip, Value))
+	{
+		OutMetadata.ToolTip = FText::FromString(Value);
+	}
+	AssetData.GetTagValue(Keywords, OutMetadata.Keywords);
+
+	ParseClassPaths(AncestryValue, OutMetadata.ClassAncestry);
+	if (OutMetadata.ClassAncestry.IsEmpty())
+	{
+		return false;
+	}
+	OutMetadata.GeneratedClassPath = OutMetadata.ClassAncestry[0];
+
+	if (AssetData.GetTagValue(AllowedAssetClasses, Value))
+	{
+		ParseClassPaths(Value, OutMetadata.AllowedAssetClasses);
+	}
+	if (AssetData.GetTagValue(DeniedAssetClasses, Value))
+	{
+		ParseClassPaths(Value, OutMetadata.DeniedAssetClasses);
+	}
+
+	return true;
+}
+
+bool FFlowNodeBlueprintMetadata::IsChildOf(const UClass* Class) const
+{
+	return Class && ClassAncestry.Contains(Class->GetClassPathName());
+}
+#endif
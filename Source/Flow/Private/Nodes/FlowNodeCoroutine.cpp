@@ -0,0 +1,369 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/FlowNodeCoroutine.h"
+#include "FlowAsset.h"
+#include "FlowLogChannels.h"
+#include "FlowSubsystem.h"
+
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNodeCoroutine)
+
+#define LOCTEXT_NAMESPACE "FlowNodeCoroutine"
+
+namespace FlowCoroutine
+{
+	// Precedes the frame, so the frame returns to the pool it came from. Keeps the default new alignment of the frame
+	struct alignas(16) FFrameHeader
+	{
+		FFlowCoroutineFramePool* Pool = nullptr;
+	};
+}
+
+void* FFlowCoroutine::promise_type::AllocateFrame(const SIZE_T Size, const UFlowNodeCoroutine& Node)
+{
+	UFlowSubsystem* FlowSubsystem = Node.GetFlowSubsystem();
+	FFlowCoroutineFramePool* Pool = FlowSubsystem ? &FlowSubsystem->GetCoroutineFramePool() : nullptr;
+
+	const SIZE_T BlockSize = sizeof(FlowCoroutine::FFrameHeader) + Size;
+	void* Block = Pool ? Pool->Allocate(BlockSize) : FMemory::Malloc(BlockSize);
+
+	FlowCoroutine::FFrameHeader* Header = new (Block) FlowCoroutine::FFrameHeader();
+	Header->Pool = Pool;
+	return Header + 1;
+}
+
+void FFlowCoroutine::promise_type::FreeFrame(void* Frame, const SIZE_T Size)
+{
+	FlowCoroutine::FFrameHeader* Header = static_cast<FlowCoroutine::FFrameHeader*>(Frame) - 1;
+	if (Header->Pool)
+	{
+		Header->Pool->Free(Header, sizeof(FlowCoroutine::FFrameHeader) + Size);
+	}
+	else
+	{
+		FMemory::Free(Header);
+	}
+}
+
+UFlowNodeCoroutine::UFlowNodeCoroutine(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bDeferResumedOutputs(true)
+	, bCoroutineRunning(false)
+	, Checkpoint(0)
+{
+#if WITH_EDITOR
+	NodeDisplayStyle = FlowNodeStyle::Latent;
+#endif
+}
+
+void UFlowNodeCoroutine::ExecuteInput(const FName& PinName)
+{
+	if (!bCoroutineRunning)
+	{
+		if (PinName == DefaultInputPin.PinName)
+		{
+			StartCoroutine(0);
+		}
+		return;
+	}
+
+	if (!AwaitedInput.IsNone() && PinName == AwaitedInput)
+	{
+		ResumeCoroutine(false);
+	}
+	else
+	{
+		LatchedInputs.AddUnique(PinName);
+	}
+}
+
+void UFlowNodeCoroutine::StartCoroutine(const int32 FromCheckpoint)
+{
+	bCoroutineRunning = true;
+	Checkpoint = FromCheckpoint;
+	MarkSaveDataDirty();
+
+	Coroutine = RunCoroutine(FromCheckpoint);
+	if (!Coroutine.IsValid())
+	{
+		LogError(TEXT("RunCoroutine isn't implemented"));
+		bCoroutineRunning = false;
+		return;
+	}
+
+	ResumeCoroutine(false);
+}
+
+void UFlowNodeCoroutine::ResumeCoroutine(const bool bDeferOutputs)
+{
+	ClearAwait();
+
+	UFlowAsset* FlowAsset = bDeferOutputs ? GetFlowAsset() : nullptr;
+	if (FlowAsset)
+	{
+		FlowAsset->BeginDeferredInputs();
+	}
+
+	bCoroutineExecuting = true;
+	Coroutine.Resume();
+	bCoroutineExecuting = false;
+
+	if (FlowAsset)
+	{
+		FlowAsset->EndDeferredInputs();
+	}
+
+	if (bDestroyCoroutinePending)
+	{
+		bDestroyCoroutinePending = false;
+		Coroutine.Destroy();
+
+		// body might have waited again after finishing the node
+		ClearAwait();
+	}
+	else if (Coroutine.IsDone())
+	{
+		// body returned without finishing the node, the node stays active
+		Coroutine.Destroy();
+		LatchedInputs.Reset();
+		bCoroutineRunning = false;
+		MarkSaveDataDirty();
+	}
+}
+
+void UFlowNodeCoroutine::ClearAwait()
+{
+	++AwaitSerial;
+	AwaitedInput = NAME_None;
+
+	if (AwaitTimerHandle.IsValid())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->ClearFlowTimer(AwaitTimerHandle);
+		}
+		AwaitTimerHandle.Invalidate();
+	}
+
+	if (AwaitEventWaiter.IsParked())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->GetEventBus().Unpark(AwaitEventWaiter);
+		}
+	}
+	AwaitedNotify = nullptr;
+
+	if (AwaitTaskCancellation.IsValid())
+	{
+		AwaitTaskCancellation->Cancel();
+		AwaitTaskCancellation.Reset();
+	}
+}
+
+void UFlowNodeCoroutine::SetCheckpoint(const int32 NewCheckpoint)
+{
+	if (Checkpoint != NewCheckpoint)
+	{
+		Checkpoint = NewCheckpoint;
+		MarkSaveDataDirty();
+	}
+}
+
+void UFlowNodeCoroutine::CancelCoroutine()
+{
+	ClearAwait();
+	LatchedInputs.Reset();
+
+	if (bCoroutineExecuting)
+	{
+		bDestroyCoroutinePending = true;
+	}
+	else
+	{
+		Coroutine.Destroy();
+	}
+
+	if (bCoroutineRunning)
+	{
+		bCoroutineRunning = false;
+		Checkpoint = 0;
+		MarkSaveDataDirty();
+	}
+}
+
+bool UFlowNodeCoroutine::ConsumeLatchedInput(const FName& PinName)
+{
+	return LatchedInputs.RemoveSingle(PinName) > 0;
+}
+
+void UFlowNodeCoroutine::AwaitInput(const FName& PinName)
+{
+	AwaitedInput = PinName;
+}
+
+void UFlowNodeCoroutine::AwaitTime(const float Seconds)
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr)
+	{
+		LogError(TEXT("Coroutine can't wait without the Flow Subsystem"));
+		return;
+	}
+
+	FFlowTimerDelegate Delegate = FFlowTimerDelegate::CreateUObject(this, &UFlowNodeCoroutine::OnAwaitedTime, AwaitSerial);
+	AwaitTimerHandle = Seconds > 0.f
+		? FlowSubsystem->SetFlowTimer(GetFlowAsset(), MoveTemp(Delegate), Seconds, false)
+		: FlowSubsystem->SetFlowTimerForNextTick(GetFlowAsset(), MoveTemp(Delegate));
+}
+
+void UFlowNodeCoroutine::AwaitNotify(FFlowAwaitNotify& Awaiter)
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr)
+	{
+		LogError(TEXT("Coroutine can't wait without the Flow Subsystem"));
+		return;
+	}
+
+	AwaitedNotify = &Awaiter;
+	AwaitEventWaiter.OnEvent.BindUObject(this, &UFlowNodeCoroutine::OnAwaitedEvent);
+	FlowSubsystem->GetEventBus().Park(AwaitEventWaiter, {Awaiter.IdentityTag, Awaiter.EventType});
+}
+
+void UFlowNodeCoroutine::AwaitTask(TUniqueFunction<TUniqueFunction<void()>(const FFlowAsyncTaskCancellation&)>&& Work)
+{
+	const uint32 Serial = AwaitSerial;
+	AwaitTaskCancellation = MakeShared<FFlowAsyncTaskCancellation>();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = TWeakObjectPtr<UFlowNodeCoroutine>(this), Serial, Cancellation = AwaitTaskCancellation.ToSharedRef(), Work = MoveTemp(Work)]() mutable
+	{
+		if (Cancellation->IsCancelled())
+		{
+			return;
+		}
+
+		TUniqueFunction<void()> StoreResult = Work(*Cancellation);
+		if (Cancellation->IsCancelled())
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, StoreResult = MoveTemp(StoreResult)]() mutable
+		{
+			if (UFlowNodeCoroutine* Node = WeakThis.Get())
+			{
+				Node->OnAwaitedTask(Serial, MoveTemp(StoreResult));
+			}
+		});
+	});
+}
+
+void UFlowNodeCoroutine::OnAwaitedTime(const uint32 Serial)
+{
+	if (Serial == AwaitSerial && bCoroutineRunning)
+	{
+		// one-shot timer already fired, the handle only needs to be forgotten
+		AwaitTimerHandle.Invalidate();
+		ResumeCoroutine(bDeferResumedOutputs);
+	}
+}
+
+void UFlowNodeCoroutine::OnAwaitedEvent(const FFlowEvent& Event)
+{
+	if (AwaitedNotify == nullptr || !bCoroutineRunning)
+	{
+		return;
+	}
+
+	if (AwaitedNotify->NotifyTag.IsValid() && AwaitedNotify->NotifyTag != Event.NotifyTag)
+	{
+		return;
+	}
+
+	AwaitedNotify->Event = Event;
+	ResumeCoroutine(bDeferResumedOutputs);
+}
+
+void UFlowNodeCoroutine::OnAwaitedTask(const uint32 Serial, TUniqueFunction<void()>&& StoreResult)
+{
+	if (Serial == AwaitSerial && bCoroutineRunning)
+	{
+		AwaitTaskCancellation.Reset();
+		StoreResult();
+		ResumeCoroutine(bDeferResumedOutputs);
+	}
+}
+
+void UFlowNodeCoroutine::ForceFinishNode()
+{
+	CancelCoroutine();
+
+	Super::ForceFinishNode();
+}
+
+void UFlowNodeCoroutine::Cleanup()
+{
+	CancelCoroutine();
+
+	Super::Cleanup();
+}
+
+void UFlowNodeCoroutine::DeinitializeInstance()
+{
+	CancelCoroutine();
+
+	Super::DeinitializeInstance();
+}
+
+void UFlowNodeCoroutine::OnLoad_Implementation()
+{
+	Super::OnLoad_Implementation();
+
+	// frame wasn't saved, so the body starts again from the recorded progress
+	if (bCoroutineRunning)
+	{
+		StartCoroutine(Checkpoint);
+	}
+}
+
+#if WITH_EDITOR
+
+FString UFlowNodeCoroutine::GetStatusString() const
+{
+	if (!bCoroutineRunning)
+	{
+		return FString();
+	}
+
+	if (!AwaitedInput.IsNone())
+	{
+		return FString::Printf(TEXT("Waiting for %s"), *AwaitedInput.ToString());
+	}
+
+	if (AwaitedNotify)
+	{
+		return FString::Printf(TEXT("Waiting for notify from %s"), *AwaitedNotify->IdentityTag.ToString());
+	}
+
+	if (AwaitTaskCancellation.IsValid())
+	{
+		return LOCTEXT("WaitingForTask", "Waiting for async task").ToString();
+	}
+
+	if (AwaitTimerHandle.IsValid())
+	{
+		if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			return FString::Printf(TEXT("Waiting %.2f s"), FlowSubsystem->GetFlowTimerRemaining(AwaitTimerHandle));
+		}
+	}
+
+	return FString::Printf(TEXT("Checkpoint %d"), Checkpoint);
+}
+
+#endif
+
+#undef LOCTEXT_NAMESPACE
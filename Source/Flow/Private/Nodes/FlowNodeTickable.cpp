@@ -0,0 +1,109 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/FlowNodeTickable.h"
+#include "FlowSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNodeTickable)
+
+UFlowNodeTickable::UFlowNodeTickable(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, TickGroup(TG_PrePhysics)
+	, TickInterval(0.0f)
+	, bStartWithTickEnabled(true)
+	, bTickEnabled(false)
+{
+}
+
+void UFlowNodeTickable::SetNodeTickEnabled(const bool bEnabled)
+{
+	if (bTickEnabled == bEnabled)
+	{
+		return;
+	}
+
+	bTickEnabled = bEnabled;
+	MarkSaveDataDirty();
+
+	if (bEnabled)
+	{
+		RegisterTick();
+	}
+	else
+	{
+		UnregisterTick();
+	}
+}
+
+void UFlowNodeTickable::TickNode(const float DeltaTime)
+{
+	if (UFunction* Function = GetBlueprintEvents().TickNode)
+	{
+		// matches parameters of K2_TickNode
+		struct FParms
+		{
+			float DeltaTime;
+		} Parms{DeltaTime};
+
+		ProcessEvent(Function, &Parms);
+	}
+}
+
+void UFlowNodeTickable::OnActivate()
+{
+	Super::OnActivate();
+
+	if (bStartWithTickEnabled)
+	{
+		SetNodeTickEnabled(true);
+	}
+}
+
+void UFlowNodeTickable::Cleanup()
+{
+	SetNodeTickEnabled(false);
+
+	Super::Cleanup();
+}
+
+void UFlowNodeTickable::DeinitializeInstance()
+{
+	UnregisterTick();
+	bTickEnabled = false;
+
+	Super::DeinitializeInstance();
+}
+
+void UFlowNodeTickable::OnLoad_Implementation()
+{
+	Super::OnLoad_Implementation();
+
+	if (bTickEnabled)
+	{
+		RegisterTick();
+	}
+}
+
+void UFlowNodeTickable::RegisterTick()
+{
+	if (TickEntryIndex == INDEX_NONE)
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->RegisterTickableNode(this);
+		}
+	}
+}
+
+void UFlowNodeTickable::UnregisterTick()
+{
+	if (TickEntryIndex != INDEX_NONE)
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->UnregisterTickableNode(this);
+		}
+
+		TickBucketIndex = INDEX_NONE;
+		TickEntryIndex = INDEX_NONE;
+	}
+}
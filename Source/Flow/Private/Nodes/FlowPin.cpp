@@ -15,7 +15,7 @@
 //////////////////////////////////////////////////////////////////////////
 // Pin Record
 
-#if !UE_BUILD_SHIPPING
+#if FLOW_WITH_PIN_RECORDS
 FString FPinRecord::NoActivations = TEXT("No activations");
 FString FPinRecord::PinActivations = TEXT("Pin activations");
 FString FPinRecord::ForcedActivation = TEXT(" (forced activation)");
@@ -43,6 +43,75 @@ FORCEINLINE FString FPinRecord::DoubleDigit(const int32 Number)
 {
 	return Number > 9 ? FString::FromInt(Number) : TEXT("0") + FString::FromInt(Number);
 }
+
+void FPinRecordHistory::Add(FPinRecord&& Record, const int32 InCapacity)
+{
+	if (InCapacity != Capacity)
+	{
+		SetCapacity(InCapacity);
+	}
+
+	if (Capacity > 0 && Records.Num() >= Capacity)
+	{
+		Records[Head] = MoveTemp(Record);
+		Head = (Head + 1) % Capacity;
+	}
+	else
+	{
+		Records.Add(MoveTemp(Record));
+	}
+}
+
+void FPinRecordHistory::Reset()
+{
+	Records.Empty();
+	Head = 0;
+}
+
+const FPinRecord& FPinRecordHistory::Last() const
+{
+	check(Records.Num() > 0);
+	return Records[(Head + Records.Num() - 1) % Records.Num()];
+}
+
+TArray<FPinRecord> FPinRecordHistory::ToArray() const
+{
+	TArray<FPinRecord> Result;
+	Result.Reserve(Records.Num());
+
+	for (int32 Index = 0; Index < Records.Num(); Index++)
+	{
+		Result.Add(Records[(Head + Index) % Records.Num()]);
+	}
+
+	return Result;
+}
+
+SIZE_T FPinRecordHistory::GetAllocatedSize() const
+{
+	SIZE_T Size = Records.GetAllocatedSize();
+	for (const FPinRecord& Record : Records)
+	{
+		Size += Record.HumanReadableTime.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FPinRecordHistory::SetCapacity(const int32 InCapacity)
+{
+	// restore chronological order, then drop the oldest records exceeding the new capacity
+	if (Head != 0)
+	{
+		Records = ToArray();
+		Head = 0;
+	}
+
+	Capacity = FMath::Max(0, InCapacity);
+	if (Capacity > 0 && Records.Num() > Capacity)
+	{
+		Records.RemoveAt(0, Records.Num() - Capacity);
+	}
+}
 #endif
 
 //////////////////////////////////////////////////////////////////////////
@@ -195,6 +264,23 @@ void FFlowPin::TrySetStructSubCategoryObjectFromPinType()
 	}
 }
 
+bool FFlowPin::IsArraySupportedPinType(EFlowPinType FlowPinType)
+{
+	switch (FlowPinType)
+	{
+		case EFlowPinType::Int:
+		case EFlowPinType::Float:
+		case EFlowPinType::Name:
+		case EFlowPinType::Vector:
+		case EFlowPinType::GameplayTag:
+		case EFlowPinType::Object:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
 const FName& FFlowPin::GetPinCategoryFromPinType(EFlowPinType FlowPinType)
 {
 	FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
@@ -294,6 +380,10 @@ FText FFlowPin::BuildHeaderText() const
 	{
 		return PinNameToUse;
 	}
+	else if (bIsArray)
+	{
+		return FText::Format(LOCTEXT("FlowPinNameAndArrayType", "{0} ({1} Array)"), {PinNameToUse, UEnum::GetDisplayValueAsText(PinType)});
+	}
 	else
 	{
 		return FText::Format(LOCTEXT("FlowPinNameAndType", "{0} ({1})"), {PinNameToUse, UEnum::GetDisplayValueAsText(PinType)});
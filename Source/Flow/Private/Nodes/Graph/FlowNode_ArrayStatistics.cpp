@@ -0,0 +1,120 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/Graph/FlowNode_ArrayStatistics.h"
+#include "FlowAsset.h"
+#include "Types/FlowDataPinHandle.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ArrayStatistics)
+
+const FName UFlowNode_ArrayStatistics::OUTPIN_Count(TEXT("Count"));
+const FName UFlowNode_ArrayStatistics::OUTPIN_Sum(TEXT("Sum"));
+const FName UFlowNode_ArrayStatistics::OUTPIN_Min(TEXT("Min"));
+const FName UFlowNode_ArrayStatistics::OUTPIN_Max(TEXT("Max"));
+const FName UFlowNode_ArrayStatistics::OUTPIN_Average(TEXT("Average"));
+
+UFlowNode_ArrayStatistics::UFlowNode_ArrayStatistics(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+#if WITH_EDITOR
+	Category = TEXT("Graph");
+	NodeDisplayStyle = FlowNodeStyle::Terminal;
+#endif
+
+	InputPins.Empty();
+	OutputPins.Empty();
+
+	OutputPins.Add(FFlowPin(OUTPIN_Count, EFlowPinType::Int));
+	OutputPins.Add(FFlowPin(OUTPIN_Sum, EFlowPinType::Float));
+	OutputPins.Add(FFlowPin(OUTPIN_Min, EFlowPinType::Float));
+	OutputPins.Add(FFlowPin(OUTPIN_Max, EFlowPinType::Float));
+	OutputPins.Add(FFlowPin(OUTPIN_Average, EFlowPinType::Float));
+}
+
+EFlowDataPinResolveResult UFlowNode_ArrayStatistics::TryComputeStatistics(FArrayStatistics& OutStatistics) const
+{
+	const TFlowDataPinArrayResult<double> ArrayResult = FlowDataPin::TryResolveArray<double>(*this, GET_MEMBER_NAME_CHECKED(UFlowNode_ArrayStatistics, Values));
+	if (ArrayResult.Result != EFlowDataPinResolveResult::Success)
+	{
+		return ArrayResult.Result;
+	}
+
+	OutStatistics = FArrayStatistics();
+	OutStatistics.Count = ArrayResult.Values.Num();
+
+	if (OutStatistics.Count > 0)
+	{
+		OutStatistics.Min = ArrayResult.Values[0];
+		OutStatistics.Max = ArrayResult.Values[0];
+
+		for (const double Value : ArrayResult.Values)
+		{
+			OutStatistics.Sum += Value;
+			OutStatistics.Min = FMath::Min(OutStatistics.Min, Value);
+			OutStatistics.Max = FMath::Max(OutStatistics.Max, Value);
+		}
+	}
+
+	// other outputs resolved during the same trigger chain reuse this pass
+	UFlowAsset* FlowAsset = Cast<UFlowAsset>(GetOuter());
+	if (FlowAsset && FlowAsset->IsDataPinMemoActive())
+	{
+		FlowAsset->MemoizeDataPinValue(*this, OUTPIN_Count, FFlowDataPinResult_Int(static_cast<int64>(OutStatistics.Count)));
+		for (const FName& PinName : {OUTPIN_Sum, OUTPIN_Min, OUTPIN_Max, OUTPIN_Average})
+		{
+			FlowAsset->MemoizeDataPinValue(*this, PinName, GetFloatResult(OutStatistics, PinName));
+		}
+	}
+
+	return EFlowDataPinResolveResult::Success;
+}
+
+FFlowDataPinResult_Float UFlowNode_ArrayStatistics::GetFloatResult(const FArrayStatistics& Statistics, const FName& PinName)
+{
+	if (PinName == OUTPIN_Sum)
+	{
+		return FFlowDataPinResult_Float(Statistics.Sum);
+	}
+
+	// there's no minimum, maximum or average of no values
+	if (Statistics.Count == 0)
+	{
+		return FFlowDataPinResult_Float(EFlowDataPinResolveResult::FailedWithError);
+	}
+
+	if (PinName == OUTPIN_Min)
+	{
+		return FFlowDataPinResult_Float(Statistics.Min);
+	}
+
+	if (PinName == OUTPIN_Max)
+	{
+		return FFlowDataPinResult_Float(Statistics.Max);
+	}
+
+	return FFlowDataPinResult_Float(Statistics.Sum / Statistics.Count);
+}
+
+FFlowDataPinResult_Int UFlowNode_ArrayStatistics::TrySupplyDataPinAsInt_Implementation(const FName& PinName) const
+{
+	if (PinName != OUTPIN_Count)
+	{
+		return Super::TrySupplyDataPinAsInt_Implementation(PinName);
+	}
+
+	FArrayStatistics Statistics;
+	const EFlowDataPinResolveResult Result = TryComputeStatistics(Statistics);
+
+	return Result == EFlowDataPinResolveResult::Success ? FFlowDataPinResult_Int(static_cast<int64>(Statistics.Count)) : FFlowDataPinResult_Int(Result);
+}
+
+FFlowDataPinResult_Float UFlowNode_ArrayStatistics::TrySupplyDataPinAsFloat_Implementation(const FName& PinName) const
+{
+	if (PinName != OUTPIN_Sum && PinName != OUTPIN_Min && PinName != OUTPIN_Max && PinName != OUTPIN_Average)
+	{
+		return Super::TrySupplyDataPinAsFloat_Implementation(PinName);
+	}
+
+	FArrayStatistics Statistics;
+	const EFlowDataPinResolveResult Result = TryComputeStatistics(Statistics);
+	return Result == EFlowDataPinResolveResult::Success ? GetFloatResult(Statistics, PinName) : FFlowDataPinResult_Float(Result);
+}
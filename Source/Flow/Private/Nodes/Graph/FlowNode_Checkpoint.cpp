@@ -7,28 +7,64 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Checkpoint)
 
+FName UFlowNode_Checkpoint::OUTPIN_Saved(TEXT("Saved"));
+
 UFlowNode_Checkpoint::UFlowNode_Checkpoint(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 #if WITH_EDITOR
 	Category = TEXT("Graph");
 #endif
+
+	OutputPins.Add(FFlowPin(OUTPIN_Saved));
 }
 
 void UFlowNode_Checkpoint::ExecuteInput(const FName& PinName)
 {
+	bOutTriggered = false;
+
 	if (GetFlowSubsystem())
 	{
 		UFlowSaveGame* NewSaveGame = Cast<UFlowSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlowSaveGame::StaticClass()));
-		GetFlowSubsystem()->OnGameSaved(NewSaveGame);
+		GetFlowSubsystem()->AsyncSaveGameToSlot(NewSaveGame, 0, FNativeFlowSaveGameWritten::CreateWeakLambda(this, [this](const bool bSuccess)
+		{
+			OnSaveGameWritten(bSuccess);
+		}));
 
-		UGameplayStatics::SaveGameToSlot(NewSaveGame, NewSaveGame->SaveSlotName, 0);
+		// node stays active until the file is written
+		bOutTriggered = true;
+		TriggerFirstOutput(false);
+		return;
 	}
 
 	TriggerFirstOutput(true);
 }
 
+void UFlowNode_Checkpoint::OnSaveGameWritten(const bool bSuccess)
+{
+	if (GetActivationState() != EFlowNodeState::Active)
+	{
+		return;
+	}
+
+	if (bSuccess)
+	{
+		TriggerOutput(OUTPIN_Saved, true);
+	}
+	else
+	{
+		LogError(TEXT("Failed to write the SaveGame"));
+		Finish();
+	}
+}
+
 void UFlowNode_Checkpoint::OnLoad_Implementation()
 {
-	TriggerFirstOutput(true);
+	// loaded from the save this checkpoint started, so the file was already written
+	if (!bOutTriggered)
+	{
+		bOutTriggered = true;
+		TriggerFirstOutput(false);
+	}
+	TriggerOutput(OUTPIN_Saved, true);
 }
@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Graph/FlowNode_CustomEventBase.h"
+#include "FlowAsset.h"
 #include "FlowSettings.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_CustomEventBase)
@@ -22,6 +23,12 @@ void UFlowNode_CustomEventBase::SetEventName(const FName& InEventName)
 	{
 		EventName = InEventName;
 
+		if (UFlowAsset* FlowAsset = Cast<UFlowAsset>(GetOuter()))
+		{
+			FlowAsset->InvalidateCustomEventNodes();
+			FlowAsset->InvalidateLightweightProgram();
+		}
+
 #if WITH_EDITOR
 		// Must reconstruct the visual representation if anything that is included in AdaptiveNodeTitles changes
 		OnReconstructionRequested.ExecuteIfBound();
@@ -31,6 +38,18 @@ void UFlowNode_CustomEventBase::SetEventName(const FName& InEventName)
 
 #if WITH_EDITOR
 
+void UFlowNode_CustomEventBase::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// the event name might have been restored, the asset isn't always part of the same transaction
+	if (UFlowAsset* FlowAsset = Cast<UFlowAsset>(GetOuter()))
+	{
+		FlowAsset->InvalidateCustomEventNodes();
+		FlowAsset->InvalidateLightweightProgram();
+	}
+}
+
 FString UFlowNode_CustomEventBase::GetNodeDescription() const
 {
 	if (UFlowSettings::Get()->bUseAdaptiveNodeTitles)
@@ -39,6 +39,25 @@ bool UFlowNode_DefineProperties::TryFindPropertyByRemappedPinName(
 	return Super::TryFindPropertyByRemappedPinName(RemappedPinName, OutFoundProperty, OutFoundInstancedStruct, InOutResult);
 }
 
+FFlowDataPinArrayView UFlowNode_DefineProperties::TrySupplyDataPinAsArray(const FName& PinName) const
+{
+	// TryFindPropertyByRemappedPinName copies the instanced struct, arrays are viewed in place instead
+	for (const FFlowNamedDataPinProperty& NamedProperty : NamedProperties)
+	{
+		if (NamedProperty.Name == PinName && NamedProperty.IsValid())
+		{
+			if (const FFlowDataPinArrayProperty* ArrayProperty = NamedProperty.DataPinProperty.GetPtr<FFlowDataPinArrayProperty>())
+			{
+				return ArrayProperty->GetArrayView();
+			}
+
+			return FFlowDataPinArrayView(EFlowDataPinResolveResult::FailedMismatchedType);
+		}
+	}
+
+	return Super::TrySupplyDataPinAsArray(PinName);
+}
+
 #if WITH_EDITOR
 void UFlowNode_DefineProperties::AutoGenerateDataPins(TMap<FName, FName>& PinNameToBoundPropertyMap, TArray<FFlowPin>& InputDataPins, TArray<FFlowPin>& OutputDataPins) const
 {
@@ -0,0 +1,270 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/Graph/FlowNode_Expression.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Expression)
+
+#define LOCTEXT_NAMESPACE "FlowNode_Expression"
+
+EFlowPinType FFlowExpressionOutput::GetPinType() const
+{
+	switch (ResultType)
+	{
+		case EFlowExpressionResultType::Int:
+			return EFlowPinType::Int;
+		case EFlowExpressionResultType::Bool:
+			return EFlowPinType::Bool;
+		default:
+			return EFlowPinType::Float;
+	}
+}
+
+UFlowNode_Expression::UFlowNode_Expression(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+#if WITH_EDITOR
+	Category = TEXT("Graph");
+	NodeDisplayStyle = FlowNodeStyle::Terminal;
+#endif
+}
+
+void UFlowNode_Expression::InitializeInstance()
+{
+	Super::InitializeInstance();
+
+	// expressions are compiled while editing, this only covers nodes saved before their last change
+	for (FFlowExpressionOutput& Output : Expressions)
+	{
+		FString Error;
+		if (!Output.Program.IsCompiled() && !Output.Expression.IsEmpty() && !CompileExpression(Output, Error))
+		{
+			LogError(FString::Printf(TEXT("Could not compile expression %s: %s"), *Output.Name.ToString(), *Error));
+		}
+	}
+}
+
+bool UFlowNode_Expression::CompileExpression(FFlowExpressionOutput& Output, FString& OutError) const
+{
+	if (!FFlowExpressionProgram::Compile(Output.Expression, Output.Program, OutError))
+	{
+		return false;
+	}
+
+	for (const FName& InputName : Output.Program.InputNames)
+	{
+		if (FindInputPinType(InputName) == EFlowPinType::Invalid)
+		{
+			OutError = FString::Printf(TEXT("%s isn't a Bool, Int or Float input property"), *InputName.ToString());
+			Output.Program = FFlowExpressionProgram();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+EFlowPinType UFlowNode_Expression::FindInputPinType(const FName& InputName) const
+{
+	for (const FFlowNamedDataPinProperty& NamedProperty : NamedProperties)
+	{
+		if (NamedProperty.Name == InputName && NamedProperty.IsValid() && NamedProperty.IsInputProperty() && !NamedProperty.DataPinProperty.Get().IsArrayProperty())
+		{
+			const EFlowPinType PinType = NamedProperty.DataPinProperty.Get().GetFlowPinType();
+			if (PinType == EFlowPinType::Bool || PinType == EFlowPinType::Int || PinType == EFlowPinType::Float)
+			{
+				return PinType;
+			}
+		}
+	}
+
+	return EFlowPinType::Invalid;
+}
+
+EFlowDataPinResolveResult UFlowNode_Expression::TryEvaluateExpression(const FName& PinName, const EFlowPinType PinType, double& OutValue) const
+{
+	const FFlowExpressionOutput* Output = Expressions.FindByPredicate([&PinName](const FFlowExpressionOutput& Candidate)
+	{
+		return Candidate.Name == PinName;
+	});
+
+	if (Output == nullptr)
+	{
+		return EFlowDataPinResolveResult::Invalid;
+	}
+
+	if (Output->GetPinType() != PinType)
+	{
+		return EFlowDataPinResolveResult::FailedMismatchedType;
+	}
+
+	const FFlowExpressionProgram& Program = Output->Program;
+	auto ResolveInput = [this, &Program](const int32 InputIndex, double& OutInputValue)
+	{
+		const FName& InputName = Program.InputNames[InputIndex];
+		switch (FindInputPinType(InputName))
+		{
+			case EFlowPinType::Bool:
+			{
+				const FFlowDataPinResult_Bool Result = TryResolveDataPinAsBool(InputName);
+				OutInputValue = Result.Value ? 1.0 : 0.0;
+				return Result.Result == EFlowDataPinResolveResult::Success;
+			}
+			case EFlowPinType::Int:
+			{
+				const FFlowDataPinResult_Int Result = TryResolveDataPinAsInt(InputName);
+				OutInputValue = static_cast<double>(Result.Value);
+				return Result.Result == EFlowDataPinResolveResult::Success;
+			}
+			case EFlowPinType::Float:
+			{
+				const FFlowDataPinResult_Float Result = TryResolveDataPinAsFloat(InputName);
+				OutInputValue = Result.Value;
+				return Result.Result == EFlowDataPinResolveResult::Success;
+			}
+			default:
+				return false;
+		}
+	};
+
+	FString Error;
+	if (!Program.Evaluate(ResolveInput, OutValue, Error))
+	{
+		LogError(FString::Printf(TEXT("Could not evaluate expression %s: %s"), *PinName.ToString(), *Error));
+		return EFlowDataPinResolveResult::FailedWithError;
+	}
+
+	return EFlowDataPinResolveResult::Success;
+}
+
+FFlowDataPinResult_Bool UFlowNode_Expression::TrySupplyDataPinAsBool_Implementation(const FName& PinName) const
+{
+	double Value = 0.0;
+	const EFlowDataPinResolveResult Result = TryEvaluateExpression(PinName, EFlowPinType::Bool, Value);
+	if (Result == EFlowDataPinResolveResult::Invalid)
+	{
+		return Super::TrySupplyDataPinAsBool_Implementation(PinName);
+	}
+
+	return Result == EFlowDataPinResolveResult::Success ? FFlowDataPinResult_Bool(Value != 0.0) : FFlowDataPinResult_Bool(Result);
+}
+
+FFlowDataPinResult_Int UFlowNode_Expression::TrySupplyDataPinAsInt_Implementation(const FName& PinName) const
+{
+	double Value = 0.0;
+	const EFlowDataPinResolveResult Result = TryEvaluateExpression(PinName, EFlowPinType::Int, Value);
+	if (Result == EFlowDataPinResolveResult::Invalid)
+	{
+		return Super::TrySupplyDataPinAsInt_Implementation(PinName);
+	}
+
+	return Result == EFlowDataPinResolveResult::Success ? FFlowDataPinResult_Int(FMath::TruncToInt64(Value)) : FFlowDataPinResult_Int(Result);
+}
+
+FFlowDataPinResult_Float UFlowNode_Expression::TrySupplyDataPinAsFloat_Implementation(const FName& PinName) const
+{
+	double Value = 0.0;
+	const EFlowDataPinResolveResult Result = TryEvaluateExpression(PinName, EFlowPinType::Float, Value);
+	if (Result == EFlowDataPinResolveResult::Invalid)
+	{
+		return Super::TrySupplyDataPinAsFloat_Implementation(PinName);
+	}
+
+	return Result == EFlowDataPinResolveResult::Success ? FFlowDataPinResult_Float(Value) : FFlowDataPinResult_Float(Result);
+}
+
+#if WITH_EDITOR
+
+void UFlowNode_Expression::PostLoad()
+{
+	Super::PostLoad();
+
+	// restores compile errors, which aren't serialized
+	for (FFlowExpressionOutput& Output : Expressions)
+	{
+		Output.CompileError.Reset();
+		if (!Output.Expression.IsEmpty())
+		{
+			CompileExpression(Output, Output.CompileError);
+		}
+	}
+}
+
+void UFlowNode_Expression::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
+{
+	// input properties might have been renamed or retyped, so all expressions are compiled again
+	for (FFlowExpressionOutput& Output : Expressions)
+	{
+		Output.CompileError.Reset();
+		Output.Program = FFlowExpressionProgram();
+		if (!Output.Expression.IsEmpty())
+		{
+			CompileExpression(Output, Output.CompileError);
+		}
+	}
+
+	Super::PostEditChangeChainProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.PropertyChain.Num() > 0)
+	{
+		const FProperty* MemberProperty = PropertyChangedEvent.PropertyChain.GetActiveMemberNode()->GetValue();
+		if (MemberProperty && MemberProperty->GetFName() == GET_MEMBER_NAME_CHECKED(UFlowNode_Expression, Expressions))
+		{
+			OnReconstructionRequested.ExecuteIfBound();
+		}
+	}
+}
+
+void UFlowNode_Expression::AutoGenerateDataPins(TMap<FName, FName>& PinNameToBoundPropertyMap, TArray<FFlowPin>& InputDataPins, TArray<FFlowPin>& OutputDataPins) const
+{
+	Super::AutoGenerateDataPins(PinNameToBoundPropertyMap, InputDataPins, OutputDataPins);
+
+	// supplied by TrySupplyDataPinAs..., not bound to any property
+	for (const FFlowExpressionOutput& Output : Expressions)
+	{
+		if (!Output.Name.IsNone())
+		{
+			OutputDataPins.AddUnique(FFlowPin(Output.Name, Output.GetPinType()));
+		}
+	}
+}
+
+EDataValidationResult UFlowNode_Expression::ValidateNode()
+{
+	EDataValidationResult Result = EDataValidationResult::Valid;
+
+	for (const FFlowExpressionOutput& Output : Expressions)
+	{
+		if (Output.Name.IsNone())
+		{
+			ValidationLog.Error<UFlowNode>(TEXT("Expression output has no name"), this);
+			Result = EDataValidationResult::Invalid;
+		}
+		else if (!Output.CompileError.IsEmpty())
+		{
+			ValidationLog.Error<UFlowNode>(*FString::Printf(TEXT("Expression %s: %s"), *Output.Name.ToString(), *Output.CompileError), this);
+			Result = EDataValidationResult::Invalid;
+		}
+		else if (Output.Expression.IsEmpty())
+		{
+			ValidationLog.Error<UFlowNode>(*FString::Printf(TEXT("Expression %s is empty"), *Output.Name.ToString()), this);
+			Result = EDataValidationResult::Invalid;
+		}
+	}
+
+	return Result;
+}
+
+void UFlowNode_Expression::UpdateNodeConfigText_Implementation()
+{
+	TArray<FString> Lines;
+	for (const FFlowExpressionOutput& Output : Expressions)
+	{
+		Lines.Add(FString::Printf(TEXT("%s = %s"), *Output.Name.ToString(), *Output.Expression));
+	}
+
+	SetNodeConfigText(FText::FromString(FString::Join(Lines, LINE_TERMINATOR)));
+}
+
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,124 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/Graph/FlowNode_FilterObjects.h"
+#include "Types/FlowDataPinHandle.h"
+
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_FilterObjects)
+
+#define LOCTEXT_NAMESPACE "FlowNode_FilterObjects"
+
+const FName UFlowNode_FilterObjects::OUTPIN_Filtered(TEXT("Filtered"));
+const FName UFlowNode_FilterObjects::OUTPIN_Count(TEXT("Count"));
+
+UFlowNode_FilterObjects::UFlowNode_FilterObjects(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+#if WITH_EDITOR
+	Category = TEXT("Graph");
+	NodeDisplayStyle = FlowNodeStyle::Terminal;
+#endif
+
+	InputPins.Empty();
+	OutputPins.Empty();
+
+	FFlowPin FilteredPin(OUTPIN_Filtered, EFlowPinType::Object);
+	FilteredPin.SetIsArray(true);
+	OutputPins.Add(FilteredPin);
+
+	OutputPins.Add(FFlowPin(OUTPIN_Count, EFlowPinType::Int));
+}
+
+bool UFlowNode_FilterObjects::PassesFilter(const UObject* Object) const
+{
+	if (!IsValid(Object))
+	{
+		return false;
+	}
+
+	if (ObjectClass && !Object->IsA(ObjectClass))
+	{
+		return false;
+	}
+
+	if (ActorTag.IsNone())
+	{
+		return true;
+	}
+
+	const AActor* Actor = Cast<AActor>(Object);
+	return Actor && Actor->ActorHasTag(ActorTag);
+}
+
+FFlowDataPinArrayView UFlowNode_FilterObjects::TrySupplyDataPinAsArray(const FName& PinName) const
+{
+	if (PinName != OUTPIN_Filtered)
+	{
+		return Super::TrySupplyDataPinAsArray(PinName);
+	}
+
+	const TFlowDataPinArrayResult<TObjectPtr<UObject>> ArrayResult = FlowDataPin::TryResolveArray<TObjectPtr<UObject>>(*this, GET_MEMBER_NAME_CHECKED(UFlowNode_FilterObjects, Objects));
+	if (ArrayResult.Result != EFlowDataPinResolveResult::Success)
+	{
+		return FFlowDataPinArrayView(ArrayResult.Result);
+	}
+
+	// owned by the returned view, so the consumer's values stay valid even if this pin is resolved again meanwhile
+	const TSharedRef<TArray<TObjectPtr<UObject>>> FilteredObjects = MakeShared<TArray<TObjectPtr<UObject>>>();
+	FilteredObjects->Reserve(ArrayResult.Values.Num());
+	for (const TObjectPtr<UObject>& Object : ArrayResult.Values)
+	{
+		if (PassesFilter(Object))
+		{
+			FilteredObjects->Add(Object);
+		}
+	}
+
+	return FFlowDataPinArrayView(TSharedRef<const TArray<TObjectPtr<UObject>>>(FilteredObjects));
+}
+
+FFlowDataPinResult_Int UFlowNode_FilterObjects::TrySupplyDataPinAsInt_Implementation(const FName& PinName) const
+{
+	if (PinName != OUTPIN_Count)
+	{
+		return Super::TrySupplyDataPinAsInt_Implementation(PinName);
+	}
+
+	const TFlowDataPinArrayResult<TObjectPtr<UObject>> ArrayResult = FlowDataPin::TryResolveArray<TObjectPtr<UObject>>(*this, GET_MEMBER_NAME_CHECKED(UFlowNode_FilterObjects, Objects));
+	if (ArrayResult.Result != EFlowDataPinResolveResult::Success)
+	{
+		return FFlowDataPinResult_Int(ArrayResult.Result);
+	}
+
+	int64 Count = 0;
+	for (const TObjectPtr<UObject>& Object : ArrayResult.Values)
+	{
+		if (PassesFilter(Object))
+		{
+			++Count;
+		}
+	}
+
+	return FFlowDataPinResult_Int(Count);
+}
+
+#if WITH_EDITOR
+void UFlowNode_FilterObjects::UpdateNodeConfigText_Implementation()
+{
+	TArray<FString> Lines;
+	if (ObjectClass)
+	{
+		Lines.Add(FString::Printf(TEXT("Class: %s"), *ObjectClass->GetName()));
+	}
+
+	if (!ActorTag.IsNone())
+	{
+		Lines.Add(FString::Printf(TEXT("Actor Tag: %s"), *ActorTag.ToString()));
+	}
+
+	SetNodeConfigText(FText::FromString(FString::Join(Lines, LINE_TERMINATOR)));
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
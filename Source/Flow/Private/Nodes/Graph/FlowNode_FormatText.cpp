@@ -2,6 +2,8 @@
 
 #include "Nodes/Graph/FlowNode_FormatText.h"
 
+#include "Internationalization/TextFormatter.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_FormatText)
 
 #define LOCTEXT_NAMESPACE "FlowNode_FormatText"
@@ -19,15 +21,114 @@ UFlowNode_FormatText::UFlowNode_FormatText(const FObjectInitializer& ObjectIniti
 	OutputPins.Add(FFlowPin(OUTPIN_TextOutput, EFlowPinType::Text));
 }
 
+void UFlowNode_FormatText::InitializeInstance()
+{
+	Super::InitializeInstance();
+
+	CompileFormat();
+}
+
+void UFlowNode_FormatText::DeinitializeInstance()
+{
+	bFormatCompiled = false;
+	CompiledFormat = FTextFormat();
+	ArgumentSlots.Empty();
+	FormatArguments.Empty();
+
+	Super::DeinitializeInstance();
+}
+
+void UFlowNode_FormatText::CompileFormat()
+{
+	ArgumentSlots.Reset();
+	FormatArguments.Reset();
+
+	CompiledFormat = FTextFormat(FormatText);
+
+	TArray<FString> FormatArgumentNames;
+	CompiledFormat.GetFormatArgumentNames(FormatArgumentNames);
+
+	for (const FFlowNamedDataPinProperty& NamedProperty : NamedProperties)
+	{
+		const FFlowDataPinProperty* FlowDataPinProperty = NamedProperty.DataPinProperty.GetPtr();
+		if (!NamedProperty.Name.IsValid())
+		{
+			LogWarning(TEXT("Could not format text with a nameless named property"));
+		}
+		else if (!FlowDataPinProperty)
+		{
+			LogWarning(FString::Printf(TEXT("Could not format text for named property %s"), *NamedProperty.Name.ToString()));
+		}
+		else
+		{
+			FString ArgumentName = NamedProperty.Name.ToString();
+
+			// FString comparison ignores case, like argument lookup in FText::Format
+			if (FormatArgumentNames.Contains(ArgumentName))
+			{
+				ArgumentSlots.Add({MoveTemp(ArgumentName), NamedProperty.Name, FlowDataPinProperty->GetFlowPinType()});
+			}
+		}
+	}
+
+	bFormatCompiled = true;
+}
+
+void UFlowNode_FormatText::ResolveFormatArguments() const
+{
+	for (const FFormatArgumentSlot& Slot : ArgumentSlots)
+	{
+		FFormatArgumentValue Value;
+		if (TryResolveDataPinAsFormatArgumentValue(Slot.PinName, Slot.PinType, Value))
+		{
+			FormatArguments.FindOrAdd(Slot.ArgumentName) = MoveTemp(Value);
+		}
+		else
+		{
+			// unresolved arguments are left in the output as they are, like before
+			FormatArguments.Remove(Slot.ArgumentName);
+			LogWarning(FString::Printf(TEXT("Could not format text for named property %s"), *Slot.PinName.ToString()));
+		}
+	}
+}
+
+bool UFlowNode_FormatText::TryFormatString(FString& OutFormattedString) const
+{
+	if (!bFormatCompiled)
+	{
+		FText FormattedText;
+		if (TryFormatTextWithNamedPropertiesAsParameters(FormatText, FormattedText))
+		{
+			OutFormattedString = FormattedText.ToString();
+			return true;
+		}
+
+		return false;
+	}
+
+	if (NamedProperties.IsEmpty())
+	{
+		return false;
+	}
+
+	ResolveFormatArguments();
+
+	constexpr bool bRebuildText = false;
+	constexpr bool bRebuildAsSource = false;
+	OutFormattedString = FTextFormatter::FormatStr(CompiledFormat, FormatArguments, bRebuildText, bRebuildAsSource);
+
+	return true;
+}
+
 FFlowDataPinResult_Name UFlowNode_FormatText::TrySupplyDataPinAsName_Implementation(const FName& PinName) const
 {
-	FText FormattedText;
-	const EFlowDataPinResolveResult FormatResult = TryResolveFormatText(PinName, FormattedText);
+	FString FormattedString;
+	const EFlowDataPinResolveResult FormatResult = TryResolveFormatString(PinName, FormattedString);
 	if (FormatResult != EFlowDataPinResolveResult::Invalid)
 	{
 		if (FormatResult == EFlowDataPinResolveResult::Success)
 		{
-			return FFlowDataPinResult_Name(FName(FormattedText.ToString()));
+			return FFlowDataPinResult_Name(FName(FormattedString));
 		}
 		else
 		{
@@ -40,13 +141,13 @@ FFlowDataPinResult_Name UFlowNode_FormatText::TrySupplyDataPinAsName_Implementat
 
 FFlowDataPinResult_String UFlowNode_FormatText::TrySupplyDataPinAsString_Implementation(const FName& PinName) const
 {
-	FText FormattedText;
-	const EFlowDataPinResolveResult FormatResult = TryResolveFormatText(PinName, FormattedText);
+	FString FormattedString;
+	const EFlowDataPinResolveResult FormatResult = TryResolveFormatString(PinName, FormattedString);
 	if (FormatResult != EFlowDataPinResolveResult::Invalid)
 	{
 		if (FormatResult == EFlowDataPinResolveResult::Success)
 		{
-			return FFlowDataPinResult_String(FormattedText.ToString());
+			return FFlowDataPinResult_String(FormattedString);
 		}
 		else
 		{
@@ -80,14 +181,30 @@ EFlowDataPinResolveResult UFlowNode_FormatText::TryResolveFormatText(const FName
 {
 	if (PinName == OUTPIN_TextOutput)
 	{
-		if (TryFormatTextWithNamedPropertiesAsParameters(FormatText, OutFormattedText))
+		if (!bFormatCompiled)
 		{
-			return EFlowDataPinResolveResult::Success;
+			return TryFormatTextWithNamedPropertiesAsParameters(FormatText, OutFormattedText) ? EFlowDataPinResolveResult::Success : EFlowDataPinResolveResult::FailedWithError;
 		}
-		else
+
+		if (NamedProperties.IsEmpty())
 		{
 			return EFlowDataPinResolveResult::FailedWithError;
 		}
+
+		ResolveFormatArguments();
+		OutFormattedText = FText::Format(CompiledFormat, FormatArguments);
+
+		return EFlowDataPinResolveResult::Success;
+	}
+
+	return EFlowDataPinResolveResult::Invalid;
+}
+
+EFlowDataPinResolveResult UFlowNode_FormatText::TryResolveFormatString(const FName& PinName, FString& OutFormattedString) const
+{
+	if (PinName == OUTPIN_TextOutput)
+	{
+		return TryFormatString(OutFormattedString) ? EFlowDataPinResolveResult::Success : EFlowDataPinResolveResult::FailedWithError;
 	}
 
 	return EFlowDataPinResolveResult::Invalid;
@@ -24,6 +24,21 @@ void UFlowNode_Start::ExecuteInput(const FName& PinName)
 void UFlowNode_Start::SetDataPinValueSupplier(IFlowDataPinValueSupplierInterface* DataPinValueSupplier)
 {
 	FlowDataPinValueSupplierInterface = Cast<UObject>(DataPinValueSupplier);
+
+	FlattenedExternalSuppliers.Reset();
+
+	// SubGraph node resolves its chain through the outer graphs, so nested subgraphs are flattened level by level
+	if (const UFlowNode* SupplierFlowNode = Cast<UFlowNode>(FlowDataPinValueSupplierInterface.GetObject()))
+	{
+		for (const FFlowPin& OutputPin : GetOutputPins())
+		{
+			if (OutputPin.IsDataPin())
+			{
+				FFlowPinValueSupplierDataArray& SupplierDatas = FlattenedExternalSuppliers.Add(OutputPin.PinName);
+				SupplierFlowNode->TryGetFlowDataPinSupplierDatasForPinName(OutputPin.PinName, SupplierDatas);
+			}
+		}
+	}
 }
 
 #if WITH_EDITOR
@@ -51,7 +66,9 @@ FFlowDataPinResult_Bool UFlowNode_Start::TrySupplyDataPinAsBool_Implementation(c
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Bool SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsBool(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Bool SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsBool_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsBool(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -66,7 +83,9 @@ FFlowDataPinResult_Int UFlowNode_Start::TrySupplyDataPinAsInt_Implementation(con
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Int SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInt(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Int SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsInt_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInt(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -81,7 +100,9 @@ FFlowDataPinResult_Float UFlowNode_Start::TrySupplyDataPinAsFloat_Implementation
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Float SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsFloat(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Float SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsFloat_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsFloat(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -96,7 +117,9 @@ FFlowDataPinResult_Name UFlowNode_Start::TrySupplyDataPinAsName_Implementation(c
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Name SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsName(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Name SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsName_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsName(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -111,7 +134,9 @@ FFlowDataPinResult_String UFlowNode_Start::TrySupplyDataPinAsString_Implementati
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_String SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsString(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_String SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsString_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsString(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -126,7 +151,9 @@ FFlowDataPinResult_Text UFlowNode_Start::TrySupplyDataPinAsText_Implementation(c
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Text SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsText(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Text SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsText_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsText(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -141,7 +168,9 @@ FFlowDataPinResult_Enum UFlowNode_Start::TrySupplyDataPinAsEnum_Implementation(c
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Enum SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsEnum(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Enum SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsEnum_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsEnum(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -156,7 +185,9 @@ FFlowDataPinResult_Vector UFlowNode_Start::TrySupplyDataPinAsVector_Implementati
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Vector SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsVector(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Vector SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsVector_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsVector(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -171,7 +202,9 @@ FFlowDataPinResult_Rotator UFlowNode_Start::TrySupplyDataPinAsRotator_Implementa
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Rotator SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsRotator(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Rotator SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsRotator_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsRotator(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -186,7 +219,9 @@ FFlowDataPinResult_Transform UFlowNode_Start::TrySupplyDataPinAsTransform_Implem
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Transform SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsTransform(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Transform SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsTransform_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsTransform(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -201,7 +236,9 @@ FFlowDataPinResult_GameplayTag UFlowNode_Start::TrySupplyDataPinAsGameplayTag_Im
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_GameplayTag SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTag(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_GameplayTag SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsGameplayTag_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTag(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -216,7 +253,9 @@ FFlowDataPinResult_GameplayTagContainer UFlowNode_Start::TrySupplyDataPinAsGamep
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_GameplayTagContainer SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTagContainer(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_GameplayTagContainer SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsGameplayTagContainer_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsGameplayTagContainer(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -231,7 +270,9 @@ FFlowDataPinResult_InstancedStruct UFlowNode_Start::TrySupplyDataPinAsInstancedS
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_InstancedStruct SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInstancedStruct(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_InstancedStruct SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsInstancedStruct_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsInstancedStruct(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -246,7 +287,9 @@ FFlowDataPinResult_Object UFlowNode_Start::TrySupplyDataPinAsObject_Implementati
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Object SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsObject(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Object SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsObject_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsObject(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
@@ -261,7 +304,9 @@ FFlowDataPinResult_Class UFlowNode_Start::TrySupplyDataPinAsClass_Implementation
 {
 	if (FlowDataPinValueSupplierInterface)
 	{
-		FFlowDataPinResult_Class SuppliedResult = IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsClass(FlowDataPinValueSupplierInterface.GetObject(), PinName);
+		FFlowDataPinResult_Class SuppliedResult = IFlowDataPinValueSupplierInterface::IsNativeSupplier(FlowDataPinValueSupplierInterface.GetObject())
+			? FlowDataPinValueSupplierInterface->TrySupplyDataPinAsClass_Implementation(PinName)
+			: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAsClass(FlowDataPinValueSupplierInterface.GetObject(), PinName);
 
 		if (SuppliedResult.Result == EFlowDataPinResolveResult::Success)
 		{
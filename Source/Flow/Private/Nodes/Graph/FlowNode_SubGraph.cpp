@@ -5,8 +5,12 @@
 #include "FlowAsset.h"
 #include "FlowSettings.h"
 #include "FlowSubsystem.h"
+#include "FlowTelemetry.h"
 #include "Interfaces/FlowNodeWithExternalDataPinSupplierInterface.h"
 
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_SubGraph)
 
 #define LOCTEXT_NAMESPACE "FlowNode_SubGraph"
@@ -17,6 +21,7 @@ FFlowPin UFlowNode_SubGraph::FinishPin(TEXT("Finish"));
 UFlowNode_SubGraph::UFlowNode_SubGraph(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bCanInstanceIdenticalAsset(false)
+	, LoadPolicy(EFlowSubGraphLoadPolicy::Blocking)
 {
 #if WITH_EDITOR
 	Category = TEXT("Graph");
@@ -34,16 +39,54 @@ bool UFlowNode_SubGraph::CanBeAssetInstanced() const
 	return !Asset.IsNull() && (bCanInstanceIdenticalAsset || Asset.ToString() != GetFlowAsset()->GetTemplateAsset()->GetPathName());
 }
 
+void UFlowNode_SubGraph::RequestAssetLoad(TFunction<void()>&& OnLoaded)
+{
+	CancelAssetLoad();
+
+	AssetLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this, [this, OnLoaded = MoveTemp(OnLoaded), RequestTime = FLOW_TELEMETRY_TIME()]()
+	{
+		FLOW_TELEMETRY_RECORD(GetFlowAsset(), AsyncLoadWait, RequestTime);
+		AssetLoadHandle.Reset();
+		OnLoaded();
+	}));
+}
+
+void UFlowNode_SubGraph::CancelAssetLoad()
+{
+	if (AssetLoadHandle.IsValid())
+	{
+		// handle has to be reset before canceling, as canceling releases the lambda holding this node
+		const TSharedPtr<FStreamableHandle> Handle = MoveTemp(AssetLoadHandle);
+		Handle->CancelHandle();
+	}
+}
+
 void UFlowNode_SubGraph::PreloadContent()
 {
 	if (CanBeAssetInstanced() && GetFlowSubsystem())
 	{
-		GetFlowSubsystem()->CreateSubFlow(this, FString(), true);
+		if (LoadPolicy == EFlowSubGraphLoadPolicy::Blocking || Asset.IsValid())
+		{
+			GetFlowSubsystem()->CreateSubFlow(this, FString(), true);
+		}
+		else
+		{
+			RequestAssetLoad([this]()
+			{
+				if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+				{
+					FlowSubsystem->CreateSubFlow(this, FString(), true);
+				}
+			});
+		}
 	}
 }
 
 void UFlowNode_SubGraph::FlushContent()
 {
+	CancelAssetLoad();
+	SkippedAssetLoadHandle.Reset();
+
 	if (CanBeAssetInstanced() && GetFlowSubsystem())
 	{
 		GetFlowSubsystem()->RemoveSubFlow(this, EFlowFinishPolicy::Abort);
@@ -69,19 +112,67 @@ void UFlowNode_SubGraph::ExecuteInput(const FName& PinName)
 
 	if (PinName == TEXT("Start"))
 	{
-		if (GetFlowSubsystem())
+		if (LoadPolicy == EFlowSubGraphLoadPolicy::Blocking || Asset.IsValid())
+		{
+			StartSubFlow();
+		}
+		else if (LoadPolicy == EFlowSubGraphLoadPolicy::AsyncWait)
+		{
+			// might be already loading, requested by PreloadContent
+			RequestAssetLoad([this]()
+			{
+				if (GetActivationState() == EFlowNodeState::Active)
+				{
+					StartSubFlow();
+				}
+			});
+		}
+		else
 		{
-			GetFlowSubsystem()->CreateSubFlow(this);
+			LogNote(FString::Printf(TEXT("Asset %s isn't loaded yet, skipping the Sub Graph"), *Asset.ToString()));
+			if (!SkippedAssetLoadHandle.IsValid())
+			{
+				// not AssetLoadHandle, as finishing the node below cancels that one
+				SkippedAssetLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset.ToSoftObjectPath(), FStreamableDelegate());
+			}
+			TriggerOutput(FinishPin.PinName, true);
 		}
 	}
 	else if (!PinName.IsNone())
 	{
-		GetFlowAsset()->TriggerCustomInput_FromSubGraph(this, PinName);
+		if (IsLoadingAsset())
+		{
+			PendingCustomInputs.Add(PinName);
+		}
+		else
+		{
+			GetFlowAsset()->TriggerCustomInput_FromSubGraph(this, PinName);
+		}
+	}
+}
+
+void UFlowNode_SubGraph::StartSubFlow()
+{
+	if (GetFlowSubsystem())
+	{
+		GetFlowSubsystem()->CreateSubFlow(this);
+	}
+
+	// the Sub Graph instance keeps the asset loaded from now on
+	SkippedAssetLoadHandle.Reset();
+
+	const TArray<FName> CustomInputs = MoveTemp(PendingCustomInputs);
+	for (const FName& CustomInput : CustomInputs)
+	{
+		GetFlowAsset()->TriggerCustomInput_FromSubGraph(this, CustomInput);
 	}
 }
 
 void UFlowNode_SubGraph::Cleanup()
 {
+	CancelAssetLoad();
+	PendingCustomInputs.Empty();
+
 	if (CanBeAssetInstanced() && GetFlowSubsystem())
 	{
 		GetFlowSubsystem()->RemoveSubFlow(this, EFlowFinishPolicy::Keep);
@@ -97,7 +188,17 @@ void UFlowNode_SubGraph::ForceFinishNode()
 
 void UFlowNode_SubGraph::OnLoad_Implementation()
 {
-	if (!SavedAssetInstanceName.IsEmpty() && !Asset.IsNull())
+	if (Asset.IsNull())
+	{
+		return;
+	}
+
+	if (SavedAssetInstanceId != 0)
+	{
+		GetFlowSubsystem()->LoadSubFlowById(this, SavedAssetInstanceId);
+		SavedAssetInstanceId = 0;
+	}
+	else if (!SavedAssetInstanceName.IsEmpty())
 	{
 		GetFlowSubsystem()->LoadSubFlow(this, SavedAssetInstanceName);
 		SavedAssetInstanceName = FString();
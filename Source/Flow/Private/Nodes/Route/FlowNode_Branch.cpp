@@ -36,8 +36,22 @@ EFlowAddOnAcceptResult UFlowNode_Branch::AcceptFlowNodeAddOnChild_Implementation
 	return Super::AcceptFlowNodeAddOnChild_Implementation(AddOnTemplate, AdditionalAddOnsToAssumeAreChildren);
 }
 
+void UFlowNode_Branch::InitializeInstance()
+{
+	Super::InitializeInstance();
+
+	PredicateProgram.Compile(AddOns);
+}
+
+void UFlowNode_Branch::DeinitializeInstance()
+{
+	PredicateProgram.Reset();
+
+	Super::DeinitializeInstance();
+}
+
 void UFlowNode_Branch::ExecuteInput(const FName& PinName)
 {
-	const bool bResult = UFlowNodeAddOn_PredicateAND::EvaluatePredicateAND(AddOns);
+	const bool bResult = PredicateProgram.IsCompiled() ? PredicateProgram.Evaluate() : UFlowNodeAddOn_PredicateAND::EvaluatePredicateAND(AddOns);
 	TriggerOutput(bResult ? OUTPIN_True : OUTPIN_False, true);
 }
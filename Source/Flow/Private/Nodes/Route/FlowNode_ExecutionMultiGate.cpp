@@ -26,43 +26,23 @@ void UFlowNode_ExecutionMultiGate::ExecuteInput(const FName& PinName)
 {
 	if (PinName == DefaultInputPin.PinName)
 	{
-		if (Completed.Num() == 0)
+		if (!Completed.IsInitialized())
 		{
-			Completed.Init(false, OutputPins.Num());
+			Completed.Init(OutputPins.Num());
 		}
 
-		if (!Completed.Contains(false))
+		if (Completed.AreAllSet())
 		{
 			return;
 		}
 
-		const bool bUseStartIndex = !Completed.Contains(true) && Completed.IsValidIndex(StartIndex);
+		const bool bUseStartIndex = !Completed.IsAnySet() && Completed.IsValidIndex(StartIndex);
 
 		if (bRandom)
 		{
-			int32 Index;
-			if (bUseStartIndex)
-			{
-				Index = StartIndex;
-			}
-			else
-			{
-				TArray<int32> AvailableIndexes;
-				AvailableIndexes.Reserve(Completed.Num()); // todo
-
-				for (int32 i = 0; i < Completed.Num(); i++)
-				{
-					if (Completed[i] == false)
-					{
-						AvailableIndexes.Emplace(i);
-					}
-				}
-
-				const int32 Random = FMath::RandRange(0, AvailableIndexes.Num() - 1);
-				Index = AvailableIndexes[Random];
-			}
+			const int32 Index = bUseStartIndex ? StartIndex : Completed.PickRandomUnset();
 
-			Completed[Index] = true;
+			Completed.Set(Index);
 			TriggerOutput(OutputPins[Index].PinName, false);
 		}
 		else
@@ -77,11 +57,11 @@ void UFlowNode_ExecutionMultiGate::ExecuteInput(const FName& PinName)
 			// TriggerOutput may call Reset and Cleanup
 			NextOutput = ++NextOutput % OutputPins.Num();
 
-			Completed[CurrentOutput] = true;
+			Completed.Set(CurrentOutput);
 			TriggerOutput(OutputPins[CurrentOutput].PinName, false);
 		}
 
-		if (!Completed.Contains(false) && bLoop)
+		if (bLoop && Completed.AreAllSet())
 		{
 			Finish();
 		}
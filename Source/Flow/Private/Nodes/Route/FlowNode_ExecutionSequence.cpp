@@ -1,12 +1,15 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_ExecutionSequence.h"
+#include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ExecutionSequence)
 
 UFlowNode_ExecutionSequence::UFlowNode_ExecutionSequence(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bSavePinExecutionState(true)
+	, MaxBranchesPerFrame(0)
+	, NextBranchIndex(0)
 {
 #if WITH_EDITOR
 	Category = TEXT("Route");
@@ -19,56 +22,114 @@ UFlowNode_ExecutionSequence::UFlowNode_ExecutionSequence(const FObjectInitialize
 
 void UFlowNode_ExecutionSequence::ExecuteInput(const FName& PinName)
 {
-	if (bSavePinExecutionState)
+	if (NextBranchesTimerHandle.IsValid())
 	{
-		ExecuteNewConnections();
+		// branches of the previous activation are still being triggered
+		return;
 	}
-	else
-	{
-		for (const FFlowPin& Output : OutputPins)
-		{
-			TriggerOutput(Output.PinName, false);
-		}
 
-		Finish();
-	}
+	NextBranchIndex = 0;
+	ExecuteBranches();
 }
 
 void UFlowNode_ExecutionSequence::OnLoad_Implementation()
 {
-	ExecuteNewConnections();
+	// connections might have changed since saving, executed ones are recognized by the connected node
+	if (bSavePinExecutionState)
+	{
+		NextBranchIndex = 0;
+	}
+
+	ExecuteBranches();
 }
 
 void UFlowNode_ExecutionSequence::Cleanup()
 {
+	if (NextBranchesTimerHandle.IsValid())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->ClearFlowTimer(NextBranchesTimerHandle);
+		}
+		NextBranchesTimerHandle.Invalidate();
+	}
+
 	ExecutedConnections.Empty();
+	NextBranchIndex = 0;
 
 	Super::Cleanup();
 }
 
-void UFlowNode_ExecutionSequence::ExecuteNewConnections()
+void UFlowNode_ExecutionSequence::ExecuteBranches()
 {
-	for (const FFlowPin& Output : OutputPins)
+	NextBranchesTimerHandle.Invalidate();
+
+	int32 BranchesThisFrame = 0;
+	while (OutputPins.IsValidIndex(NextBranchIndex))
 	{
-		const FConnectedPin& Connection = GetConnection(Output.PinName);
-		if (!ExecutedConnections.Contains(Connection.NodeGuid))
+		const FName PinName = OutputPins[NextBranchIndex].PinName;
+
+		if (bSavePinExecutionState)
+		{
+			const FConnectedPin& Connection = GetConnection(PinName);
+			if (ExecutedConnections.Contains(Connection.NodeGuid))
+			{
+				++NextBranchIndex;
+				continue;
+			}
+		}
+
+		if (ShouldDeferBranches(BranchesThisFrame))
 		{
-			ExecutedConnections.Emplace(Connection.NodeGuid);
-			TriggerOutput(Output.PinName, false);
+			NextBranchesTimerHandle = GetFlowSubsystem()->SetFlowTimerForNextTick(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_ExecutionSequence::ExecuteBranches));
+			return;
 		}
+
+		if (bSavePinExecutionState)
+		{
+			ExecutedConnections.Emplace(GetConnection(PinName).NodeGuid);
+		}
+
+		++NextBranchIndex;
+		++BranchesThisFrame;
+		TriggerOutput(PinName, false);
 	}
 
 	Finish();
 }
 
+bool UFlowNode_ExecutionSequence::ShouldDeferBranches(const int32 BranchesThisFrame) const
+{
+	// at least one branch per frame, so the sequence always progresses
+	if (MaxBranchesPerFrame <= 0 || BranchesThisFrame == 0)
+	{
+		return false;
+	}
+
+	const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	return BranchesThisFrame >= MaxBranchesPerFrame || FlowSubsystem->IsTriggerQueueFrameBudgetExceeded();
+}
+
 #if WITH_EDITOR
 FString UFlowNode_ExecutionSequence::GetNodeDescription() const
 {
+	TArray<FString> Lines;
+
 	if (bSavePinExecutionState)
 	{
-		return TEXT("Saves pin execution state");
+		Lines.Add(TEXT("Saves pin execution state"));
+	}
+
+	if (MaxBranchesPerFrame > 0)
+	{
+		Lines.Add(FString::Printf(TEXT("%d branches per frame"), MaxBranchesPerFrame));
 	}
 
-	return Super::GetNodeDescription();
+	return Lines.IsEmpty() ? Super::GetNodeDescription() : FString::Join(Lines, LINE_TERMINATOR);
 }
 #endif
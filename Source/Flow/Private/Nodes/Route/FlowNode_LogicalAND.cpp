@@ -17,9 +17,20 @@ UFlowNode_LogicalAND::UFlowNode_LogicalAND(const FObjectInitializer& ObjectIniti
 
 void UFlowNode_LogicalAND::ExecuteInput(const FName& PinName)
 {
-	ExecutedInputNames.Add(PinName);
+	const int32 PinIndex = InputPins.IndexOfByKey(PinName);
+	if (PinIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (ExecutedInputs.Num() != InputPins.Num())
+	{
+		ExecutedInputs.Init(InputPins.Num());
+	}
+
+	ExecutedInputs.Set(PinIndex);
 
-	if (ExecutedInputNames.Num() == InputPins.Num())
+	if (ExecutedInputs.AreAllSet())
 	{
 		TriggerFirstOutput(true);
 	}
@@ -27,5 +38,5 @@ void UFlowNode_LogicalAND::ExecuteInput(const FName& PinName)
 
 void UFlowNode_LogicalAND::Cleanup()
 {
-	ExecutedInputNames.Empty();
+	ExecutedInputs.Reset();
 }
@@ -2,9 +2,7 @@
 
 #include "Nodes/Route/FlowNode_Timer.h"
 #include "FlowSettings.h"
-
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Timer)
 
@@ -52,7 +50,7 @@ void UFlowNode_Timer::ExecuteInput(const FName& PinName)
 	{
 		if (CompletionTimerHandle.IsValid() || StepTimerHandle.IsValid())
 		{
-			LogError(TEXT("Timer already active"));
+			FLOW_LOG_NODE(LogFlowExecution, Error, TEXT("Timer already active"));
 			return;
 		}
 
@@ -70,26 +68,26 @@ void UFlowNode_Timer::ExecuteInput(const FName& PinName)
 
 void UFlowNode_Timer::SetTimer()
 {
-	if (GetWorld())
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
 		if (StepTime > 0.0f)
 		{
-			GetWorld()->GetTimerManager().SetTimer(StepTimerHandle, this, &UFlowNode_Timer::OnStep, StepTime, true);
+			StepTimerHandle = FlowSubsystem->SetFlowTimer(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnStep), StepTime, true);
 		}
 
 		ResolvedCompletionTime = ResolveCompletionTime();
 		if (ResolvedCompletionTime > UE_KINDA_SMALL_NUMBER)
 		{
-			GetWorld()->GetTimerManager().SetTimer(CompletionTimerHandle, this, &UFlowNode_Timer::OnCompletion, ResolvedCompletionTime, false);
+			CompletionTimerHandle = FlowSubsystem->SetFlowTimer(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion), ResolvedCompletionTime, false);
 		}
 		else
 		{
-			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UFlowNode_Timer::OnCompletion);
+			CompletionTimerHandle = FlowSubsystem->SetFlowTimerForNextTick(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion));
 		}
 	}
 	else
 	{
-		LogError(TEXT("No valid world"));
+		LogError(TEXT("No valid Flow Subsystem"));
 		TriggerOutput(TEXT("Completed"), true);
 	}
 }
@@ -142,16 +140,12 @@ void UFlowNode_Timer::OnCompletion()
 
 void UFlowNode_Timer::Cleanup()
 {
-	if (GetWorld())
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(CompletionTimerHandle);
+		FlowSubsystem->ClearFlowTimer(CompletionTimerHandle);
+		FlowSubsystem->ClearFlowTimer(StepTimerHandle);
 	}
 	CompletionTimerHandle.Invalidate();
-
-	if (GetWorld())
-	{
-		GetWorld()->GetTimerManager().ClearTimer(StepTimerHandle);
-	}
 	StepTimerHandle.Invalidate();
 
 	SumOfSteps = 0.0f;
@@ -161,30 +155,32 @@ void UFlowNode_Timer::Cleanup()
 
 void UFlowNode_Timer::OnSave_Implementation()
 {
-	if (GetWorld())
+	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
+		// remaining time of paused timers is frozen, so the loaded timer continues from the same point
 		if (CompletionTimerHandle.IsValid())
 		{
-			RemainingCompletionTime = GetWorld()->GetTimerManager().GetTimerRemaining(CompletionTimerHandle);
+			RemainingCompletionTime = FlowSubsystem->GetFlowTimerRemaining(CompletionTimerHandle);
 		}
 
 		if (StepTimerHandle.IsValid())
 		{
-			RemainingStepTime = GetWorld()->GetTimerManager().GetTimerRemaining(StepTimerHandle);
+			RemainingStepTime = FlowSubsystem->GetFlowTimerRemaining(StepTimerHandle);
 		}
 	}
 }
 
 void UFlowNode_Timer::OnLoad_Implementation()
 {
-	if (RemainingStepTime > 0.0f || RemainingCompletionTime > 0.0f)
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem && (RemainingStepTime > 0.0f || RemainingCompletionTime > 0.0f))
 	{
 		if (RemainingStepTime > 0.0f)
 		{
-			GetWorld()->GetTimerManager().SetTimer(StepTimerHandle, this, &UFlowNode_Timer::OnStep, StepTime, true, RemainingStepTime);
+			StepTimerHandle = FlowSubsystem->SetFlowTimer(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnStep), StepTime, true, RemainingStepTime);
 		}
 
-		GetWorld()->GetTimerManager().SetTimer(CompletionTimerHandle, this, &UFlowNode_Timer::OnCompletion, RemainingCompletionTime, false);
+		CompletionTimerHandle = FlowSubsystem->SetFlowTimer(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion), RemainingCompletionTime, false);
 
 		RemainingStepTime = 0.0f;
 		RemainingCompletionTime = 0.0f;
@@ -244,9 +240,9 @@ FString UFlowNode_Timer::GetStatusString() const
 	{
 		ProgressString = FString::Printf(TEXT("%.*f"), 2, SumOfSteps);
 	}
-	else if (CompletionTimerHandle.IsValid() && GetWorld())
+	else if (CompletionTimerHandle.IsValid() && GetFlowSubsystem())
 	{
-		ProgressString = FString::Printf(TEXT("%.*f"), 2, GetWorld()->GetTimerManager().GetTimerElapsed(CompletionTimerHandle));
+		ProgressString = FString::Printf(TEXT("%.*f"), 2, GetFlowSubsystem()->GetFlowTimerElapsed(CompletionTimerHandle));
 	}
 
 	if (!ProgressString.IsEmpty())
@@ -0,0 +1,58 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Misc/AutomationTest.h"
+#include "FlowBenchmarkGraphs.h"
+#include "FlowTags.h"
+#include "Nodes/Actor/FlowNode_OnActorRegistered.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowBenchmarkGraphsTest, "Flow.Benchmark.Graphs", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFlowBenchmarkGraphsTest::RunTest(const FString& Parameters)
+{
+	// throughput benchmark divides its timings by TriggersPerInstance, every connection of these graphs is triggered exactly once per instance
+	auto CountConnections = [](const FFlowBenchmarkGraphs::FGraph& Graph)
+	{
+		int32 Connections = 0;
+		for (const TStrongObjectPtr<UFlowAsset>& Asset : Graph.KeepAlive)
+		{
+			for (const TPair<FGuid, UFlowNode*>& Node : Asset->GetNodes())
+			{
+				Connections += Node.Value->GetConnections().Num();
+			}
+		}
+		return Connections;
+	};
+
+	for (int32 Size = 0; Size <= 3; Size++)
+	{
+		const FFlowBenchmarkGraphs::FGraph Chain = FFlowBenchmarkGraphs::MakeChain(1 << Size);
+		TestEqual(FString::Printf(TEXT("Chain %d triggers"), Size), CountConnections(Chain), Chain.TriggersPerInstance);
+		TestEqual(FString::Printf(TEXT("Chain %d nodes"), Size), Chain.Asset->GetNodes().Num(), (1 << Size) + 2);
+
+		const FFlowBenchmarkGraphs::FGraph FanOut = FFlowBenchmarkGraphs::MakeFanOut(TEXT("FlowBenchmark_FanOut"), Size, [](UFlowAsset& Asset)
+		{
+			UFlowNode_OnActorRegistered* Observer = FFlowBenchmarkGraphs::AddNode<UFlowNode_OnActorRegistered>(Asset);
+			Observer->SetIdentityTags(FGameplayTagContainer(FlowNodeStyle::Node));
+			return Observer;
+		}, TEXT("Start"));
+		TestEqual(FString::Printf(TEXT("FanOut %d triggers"), Size), CountConnections(FanOut), FanOut.TriggersPerInstance);
+
+		for (const TPair<FGuid, UFlowNode*>& Node : FanOut.Asset->GetNodes())
+		{
+			if (const UFlowNode_OnActorRegistered* Observer = Cast<UFlowNode_OnActorRegistered>(Node.Value))
+			{
+				TestTrue(FString::Printf(TEXT("FanOut %d observer tags"), Size), Observer->GetIdentityTags().HasTagExact(FlowNodeStyle::Node));
+			}
+		}
+
+		const FFlowBenchmarkGraphs::FGraph SubGraphs = FFlowBenchmarkGraphs::MakeNestedSubGraphs(Size);
+		TestEqual(FString::Printf(TEXT("SubGraphs %d triggers"), Size), CountConnections(SubGraphs), SubGraphs.TriggersPerInstance);
+		TestEqual(FString::Printf(TEXT("SubGraphs %d instances"), Size), SubGraphs.InstancesPerRoot, Size + 1);
+	}
+
+	return true;
+}
+
+#endif
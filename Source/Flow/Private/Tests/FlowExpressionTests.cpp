@@ -0,0 +1,67 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Misc/AutomationTest.h"
+#include "Types/FlowExpression.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowExpressionShortCircuitTest, "Flow.Expression.ShortCircuit", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFlowExpressionShortCircuitTest::RunTest(const FString& Parameters)
+{
+	struct FCase
+	{
+		const TCHAR* Expression;
+		double X;
+		double Expected;
+	};
+
+	// the branch not taken would divide by zero, or resolve the input that isn't available
+	static const FCase Cases[] =
+	{
+		{TEXT("x != 0 ? 10 / x : 0"), 0.0, 0.0},
+		{TEXT("x != 0 ? 10 / x : 0"), 4.0, 2.5},
+		{TEXT("x != 0 && 10 / x > 1"), 0.0, 0.0},
+		{TEXT("x == 0 || 10 / x > 1"), 0.0, 1.0},
+		{TEXT("x != 0 && missing"), 0.0, 0.0},
+		{TEXT("x == 0 || missing"), 0.0, 1.0},
+		{TEXT("true ? x : 10 / 0"), 3.0, 3.0},
+		{TEXT("(x > 1 ? 2 : 3) + 1"), 0.0, 4.0},
+		{TEXT("x && 5"), 2.0, 1.0}
+	};
+
+	for (const FCase& Case : Cases)
+	{
+		FFlowExpressionProgram Program;
+		FString Error;
+		if (!TestTrue(FString::Printf(TEXT("Compile %s"), Case.Expression), FFlowExpressionProgram::Compile(Case.Expression, Program, Error)))
+		{
+			AddError(Error);
+			continue;
+		}
+
+		auto ResolveInput = [&Program, &Case](const int32 InputIndex, double& OutValue)
+		{
+			if (Program.InputNames[InputIndex] == TEXT("x"))
+			{
+				OutValue = Case.X;
+				return true;
+			}
+			return false;
+		};
+
+		double Value = 0.0;
+		if (TestTrue(FString::Printf(TEXT("Evaluate %s"), Case.Expression), Program.Evaluate(ResolveInput, Value, Error)))
+		{
+			TestEqual(FString::Printf(TEXT("%s with x = %g"), Case.Expression, Case.X), Value, Case.Expected);
+		}
+		else
+		{
+			AddError(Error);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Misc/AutomationTest.h"
+#include "FlowSave.h"
+#include "FlowSettings.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowSaveGameMemoryRoundTripTest, "Flow.SaveGame.MemoryRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFlowSaveGameMemoryRoundTripTest::RunTest(const FString& Parameters)
+{
+	// records are moved out of the arrays while writing the compressed buffer, and restored after decompressing it on load
+	UFlowSettings* Settings = UFlowSettings::Get();
+	const FName PreviousFormat = Settings->SaveGameCompressionFormat;
+
+	for (const FName& Format : {FName(NAME_None), FName(NAME_Zlib)})
+	{
+		Settings->SaveGameCompressionFormat = Format;
+
+		const TStrongObjectPtr<UFlowSaveGame> SaveGame(NewObject<UFlowSaveGame>());
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			FFlowAssetSaveData& AssetRecord = SaveGame->FlowInstances.AddDefaulted_GetRef();
+			AssetRecord.WorldName = TEXT("TestWorld");
+			AssetRecord.InstanceName = FString::Printf(TEXT("Instance_%d"), Index);
+			AssetRecord.InstanceId = 100 + Index;
+			AssetRecord.AssetData.Init(static_cast<uint8>(Index), 64);
+
+			FFlowComponentSaveData& ComponentRecord = SaveGame->FlowComponents.AddDefaulted_GetRef();
+			ComponentRecord.WorldName = TEXT("TestWorld");
+			ComponentRecord.ActorInstanceName = FString::Printf(TEXT("Actor_%d"), Index);
+			ComponentRecord.ComponentData.Init(static_cast<uint8>(Index), 16);
+		}
+
+		TArray<uint8> SaveData;
+		if (!TestTrue(FString::Printf(TEXT("Save with %s"), *Format.ToString()), UGameplayStatics::SaveGameToMemory(SaveGame.Get(), SaveData)))
+		{
+			continue;
+		}
+
+		// saving restores the records of the saved object
+		TestEqual(FString::Printf(TEXT("Saved instances kept with %s"), *Format.ToString()), SaveGame->FlowInstances.Num(), 3);
+
+		const UFlowSaveGame* LoadedSaveGame = Cast<UFlowSaveGame>(UGameplayStatics::LoadGameFromMemory(SaveData));
+		if (!TestNotNull(FString::Printf(TEXT("Load with %s"), *Format.ToString()), LoadedSaveGame))
+		{
+			continue;
+		}
+
+		if (TestEqual(FString::Printf(TEXT("Loaded instances with %s"), *Format.ToString()), LoadedSaveGame->FlowInstances.Num(), SaveGame->FlowInstances.Num()))
+		{
+			for (int32 Index = 0; Index < SaveGame->FlowInstances.Num(); Index++)
+			{
+				const FFlowAssetSaveData& Saved = SaveGame->FlowInstances[Index];
+				const FFlowAssetSaveData& Loaded = LoadedSaveGame->FlowInstances[Index];
+				TestEqual(TEXT("Instance name"), Loaded.InstanceName, Saved.InstanceName);
+				TestEqual(TEXT("Instance id"), Loaded.InstanceId, Saved.InstanceId);
+				TestTrue(TEXT("Asset data"), Loaded.AssetData == Saved.AssetData);
+			}
+		}
+
+		if (TestEqual(FString::Printf(TEXT("Loaded components with %s"), *Format.ToString()), LoadedSaveGame->FlowComponents.Num(), SaveGame->FlowComponents.Num()))
+		{
+			for (int32 Index = 0; Index < SaveGame->FlowComponents.Num(); Index++)
+			{
+				const FFlowComponentSaveData& Saved = SaveGame->FlowComponents[Index];
+				const FFlowComponentSaveData& Loaded = LoadedSaveGame->FlowComponents[Index];
+				TestEqual(TEXT("Actor name"), Loaded.ActorInstanceName, Saved.ActorInstanceName);
+				TestTrue(TEXT("Component data"), Loaded.ComponentData == Saved.ComponentData);
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("Compressed buffer released with %s"), *Format.ToString()), LoadedSaveGame->CompressedFlowData.IsEmpty());
+	}
+
+	Settings->SaveGameCompressionFormat = PreviousFormat;
+	return true;
+}
+
+#endif
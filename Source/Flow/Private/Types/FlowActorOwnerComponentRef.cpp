@@ -5,6 +5,98 @@
 #include "GameFramework/Actor.h"
 #include "Misc/RuntimeErrors.h"
 #include "FlowLogChannels.h"
+#include "UObject/ObjectKey.h"
+
+namespace FlowActorOwnerComponentRef
+{
+	// Components of a single actor by their name, and by the name without the Blueprint "_C" suffix
+	struct FComponentNameIndex
+	{
+		TWeakObjectPtr<const AActor> Actor;
+		TMap<FName, TWeakObjectPtr<UActorComponent>> Components;
+
+		// Names matching several components, the first one found is used
+		TSet<FName> AmbiguousNames;
+
+		// Names not matching any component, so failed resolves don't scan the actor again
+		TSet<FName> Misses;
+
+		// Cheap validation catching components added or removed without calling InvalidateComponentNameIndex
+		int32 NumComponents = 0;
+
+		void Build(const AActor& InActor);
+	};
+
+	TMap<FObjectKey, FComponentNameIndex> ComponentNameIndices;
+
+	// Indices of destroyed actors are pruned, once the map grows above this
+	int32 PruneIndicesThreshold = 64;
+
+	void FComponentNameIndex::Build(const AActor& InActor)
+	{
+		constexpr bool bIncludeFromChildActors = false;
+
+		Actor = &InActor;
+		Components.Reset();
+		AmbiguousNames.Reset();
+		Misses.Reset();
+		NumComponents = InActor.GetComponents().Num();
+
+		InActor.ForEachComponent(
+			bIncludeFromChildActors,
+			[this](UActorComponent* Component)
+			{
+				const FName ComponentName = Component->GetFName();
+
+				FString CleanedName = Component->GetName();
+				const FName CleanedFName = CleanedName.RemoveFromEnd(TEXT("_C")) ? FName(CleanedName) : ComponentName;
+
+				for (const FName& Name : {ComponentName, CleanedFName})
+				{
+					TWeakObjectPtr<UActorComponent>& IndexedComponent = Components.FindOrAdd(Name);
+					if (!IndexedComponent.IsValid())
+					{
+						IndexedComponent = Component;
+					}
+					else if (IndexedComponent.Get() != Component)
+					{
+						AmbiguousNames.Add(Name);
+					}
+				}
+			});
+	}
+
+	FComponentNameIndex& FindOrBuildIndex(const AActor& InActor)
+	{
+		check(IsInGameThread());
+
+		const FObjectKey ActorKey(&InActor);
+		if (FComponentNameIndex* Index = ComponentNameIndices.Find(ActorKey))
+		{
+			if (Index->NumComponents != InActor.GetComponents().Num())
+			{
+				Index->Build(InActor);
+			}
+			return *Index;
+		}
+
+		if (ComponentNameIndices.Num() >= PruneIndicesThreshold)
+		{
+			for (auto It = ComponentNameIndices.CreateIterator(); It; ++It)
+			{
+				if (!It.Value().Actor.IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			PruneIndicesThreshold = FMath::Max(64, ComponentNameIndices.Num() * 2);
+		}
+
+		FComponentNameIndex& Index = ComponentNameIndices.Add(ActorKey);
+		Index.Build(InActor);
+		return Index;
+	}
+}
 
 UActorComponent* FFlowActorOwnerComponentRef::TryResolveComponent(const AActor& InActor, bool bWarnIfFailed)
 {
@@ -30,26 +122,38 @@ void FFlowActorOwnerComponentRef::SetResolvedComponentDirect(UActorComponent& Co
 
 UActorComponent* FFlowActorOwnerComponentRef::TryResolveComponentByName(const AActor& InActor, const FName& InComponentName)
 {
-	constexpr bool bIncludeFromChildActors = false;
+	using namespace FlowActorOwnerComponentRef;
 
-	UActorComponent* FoundComponent = nullptr;
+	FComponentNameIndex* Index = &FindOrBuildIndex(InActor);
+	if (Index->Misses.Contains(InComponentName))
+	{
+		return nullptr;
+	}
 
-	// Search for the component (by name) on the given actor
-	InActor.ForEachComponent(
-		bIncludeFromChildActors,
-		[&FoundComponent, &InComponentName](UActorComponent* Component)
-		{
-			FString CleanedName = Component->GetName();
-			CleanedName.RemoveFromEnd(TEXT("_C"));
+	const TWeakObjectPtr<UActorComponent>* FoundComponent = Index->Components.Find(InComponentName);
+	if (FoundComponent && !IsValid(FoundComponent->Get()))
+	{
+		// component was destroyed while keeping the number of components, i.e. replaced by another one
+		Index->Build(InActor);
+		FoundComponent = Index->Components.Find(InComponentName);
+	}
 
-			if ((InComponentName == Component->GetFName() || InComponentName == FName(CleanedName)) &&
-				ensureAsRuntimeWarning(FoundComponent == nullptr))
-			{
-				FoundComponent = Component;
-			}
-		});
+	if (FoundComponent == nullptr)
+	{
+		Index->Misses.Add(InComponentName);
+		return nullptr;
+	}
+
+	ensureAsRuntimeWarning(!Index->AmbiguousNames.Contains(InComponentName));
+
+	return FoundComponent->Get();
+}
+
+void FFlowActorOwnerComponentRef::InvalidateComponentNameIndex(const AActor& InActor)
+{
+	check(IsInGameThread());
 
-	return FoundComponent;
+	FlowActorOwnerComponentRef::ComponentNameIndices.Remove(FObjectKey(&InActor));
 }
 
 bool FFlowActorOwnerComponentRef::IsResolved() const
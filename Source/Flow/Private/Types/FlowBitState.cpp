@@ -0,0 +1,77 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Types/FlowBitState.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowBitState)
+
+void FFlowBitState::Init(const int32 InNumBits)
+{
+	NumBits = FMath::Max(InNumBits, 0);
+	Words.Init(0, FMath::DivideAndRoundUp(NumBits, BitsPerWord));
+}
+
+void FFlowBitState::Reset()
+{
+	NumBits = 0;
+	Words.Reset();
+}
+
+int32 FFlowBitState::CountSet() const
+{
+	int32 Count = 0;
+	for (const uint32 Word : Words)
+	{
+		Count += FMath::CountBits(Word);
+	}
+	return Count;
+}
+
+bool FFlowBitState::IsAnySet() const
+{
+	for (const uint32 Word : Words)
+	{
+		if (Word != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FFlowBitState::PickRandomUnset() const
+{
+	const int32 UnsetNum = CountUnset();
+	if (UnsetNum == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// same distribution as picking from the array of unset indexes, without building it
+	int32 Remaining = FMath::RandRange(0, UnsetNum - 1);
+
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); WordIndex++)
+	{
+		// bits past NumBits in the last word don't count as unset
+		const int32 WordBits = FMath::Min(NumBits - WordIndex * BitsPerWord, BitsPerWord);
+		const uint32 WordMask = WordBits == BitsPerWord ? MAX_uint32 : (1u << WordBits) - 1;
+		uint32 UnsetBits = ~Words[WordIndex] & WordMask;
+
+		const int32 WordUnsetNum = FMath::CountBits(UnsetBits);
+		if (Remaining >= WordUnsetNum)
+		{
+			Remaining -= WordUnsetNum;
+			continue;
+		}
+
+		for (; Remaining > 0; Remaining--)
+		{
+			// drop the lowest unset bit
+			UnsetBits &= UnsetBits - 1;
+		}
+
+		return WordIndex * BitsPerWord + FMath::CountTrailingZeros(UnsetBits);
+	}
+
+	checkNoEntry();
+	return INDEX_NONE;
+}
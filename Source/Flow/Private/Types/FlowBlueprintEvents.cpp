@@ -0,0 +1,93 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Types/FlowBlueprintEvents.h"
+#include "Interfaces/FlowDataPinValueSupplierInterface.h"
+
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectHash.h"
+
+namespace FlowBlueprintEvents
+{
+	static bool ImplementsInterfaceNatively(const UClass& Class, const UClass& InterfaceClass)
+	{
+		for (const UClass* CurrentClass = &Class; CurrentClass; CurrentClass = CurrentClass->GetSuperClass())
+		{
+			for (const FImplementedInterface& Interface : CurrentClass->Interfaces)
+			{
+				if (Interface.Class && Interface.Class->IsChildOf(&InterfaceClass))
+				{
+					return !Interface.bImplementedByK2;
+				}
+			}
+		}
+
+		return false;
+	}
+}
+
+FFlowBlueprintEvents::FFlowBlueprintEvents(const UClass& Class)
+{
+	// some of these events are protected, so names can't be checked by GET_FUNCTION_NAME_CHECKED
+	InitializeInstance = FindBlueprintEvent(Class, TEXT("K2_InitializeInstance"));
+	DeinitializeInstance = FindBlueprintEvent(Class, TEXT("K2_DeinitializeInstance"));
+	PreloadContent = FindBlueprintEvent(Class, TEXT("K2_PreloadContent"));
+	FlushContent = FindBlueprintEvent(Class, TEXT("K2_FlushContent"));
+	OnActivate = FindBlueprintEvent(Class, TEXT("K2_OnActivate"));
+	Cleanup = FindBlueprintEvent(Class, TEXT("K2_Cleanup"));
+	ForceFinishNode = FindBlueprintEvent(Class, TEXT("K2_ForceFinishNode"));
+	ExecuteInput = FindBlueprintEvent(Class, TEXT("K2_ExecuteInput"));
+
+	OnSave = FindBlueprintEvent(Class, TEXT("OnSave"));
+	OnLoad = FindBlueprintEvent(Class, TEXT("OnLoad"));
+	OnPassThrough = FindBlueprintEvent(Class, TEXT("OnPassThrough"));
+
+	TickNode = FindBlueprintEvent(Class, TEXT("K2_TickNode"));
+
+	EvaluatePredicate = FindBlueprintEvent(Class, TEXT("EvaluatePredicate"));
+	GetPredicateCacheDependencies = FindBlueprintEvent(Class, TEXT("GetPredicateCacheDependencies"));
+
+	const UClass* SupplierInterface = UFlowDataPinValueSupplierInterface::StaticClass();
+	bNativeDataPinSupplier = FlowBlueprintEvents::ImplementsInterfaceNatively(Class, *SupplierInterface);
+	for (TFieldIterator<UFunction> FunctionIt(SupplierInterface, EFieldIteratorFlags::ExcludeSuper); FunctionIt && bNativeDataPinSupplier; ++FunctionIt)
+	{
+		bNativeDataPinSupplier = FindBlueprintEvent(Class, FunctionIt->GetFName()) == nullptr;
+	}
+}
+
+TSharedRef<const FFlowBlueprintEvents> FFlowBlueprintEvents::Get(const UClass& Class)
+{
+	check(IsInGameThread());
+
+	// keyed by FObjectKey, as Blueprint classes might be garbage collected
+	static TMap<FObjectKey, TSharedRef<const FFlowBlueprintEvents>> CachedEvents;
+	static uint64 CachedClassesVersion = 0;
+
+	// compiling Blueprints registers new classes, the cached functions might belong to the old class layout
+	// instances keep their shared reference until deinitialized, reinstanced objects resolve the events again
+	const uint64 ClassesVersion = GetRegisteredClassesVersionNumber();
+	if (CachedClassesVersion != ClassesVersion)
+	{
+		CachedEvents.Reset();
+		CachedClassesVersion = ClassesVersion;
+	}
+
+	if (const TSharedRef<const FFlowBlueprintEvents>* Events = CachedEvents.Find(&Class))
+	{
+		return *Events;
+	}
+
+	return CachedEvents.Add(&Class, MakeShareable(new FFlowBlueprintEvents(Class)));
+}
+
+UFunction* FFlowBlueprintEvents::FindBlueprintEvent(const UClass& Class, const FName& FunctionName)
+{
+	// native classes never implement events in script, only Blueprint classes in the hierarchy can
+	if (Class.HasAnyClassFlags(CLASS_Native))
+	{
+		return nullptr;
+	}
+
+	UFunction* Function = Class.FindFunctionByName(FunctionName);
+	return Function && !Function->GetOwnerClass()->HasAnyClassFlags(CLASS_Native) ? Function : nullptr;
+}
@@ -2,8 +2,37 @@
 
 #include "Types/FlowClassUtils.h"
 #include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectHash.h"
 #include "UObject/UObjectIterator.h"
 
+bool FlowClassUtils::HasDerivedClasses(const UClass* Class)
+{
+	check(IsInGameThread());
+
+	// keyed by FObjectKey, as Blueprint classes might be garbage collected
+	static TMap<FObjectKey, bool> CachedResults;
+	static uint64 CachedClassesVersion = 0;
+
+	// loading Blueprint classes or hot reload registers new classes
+	const uint64 ClassesVersion = GetRegisteredClassesVersionNumber();
+	if (CachedClassesVersion != ClassesVersion)
+	{
+		CachedResults.Reset();
+		CachedClassesVersion = ClassesVersion;
+	}
+
+	if (const bool* CachedResult = CachedResults.Find(Class))
+	{
+		return *CachedResult;
+	}
+
+	TArray<UClass*> ChildClasses;
+	GetDerivedClasses(Class, ChildClasses, false);
+
+	return CachedResults.Add(Class, ChildClasses.Num() > 0);
+}
+
 #if WITH_EDITOR
 TArray<UClass*> FlowClassUtils::GetClassesFromMetadataString(const FString& MetadataString)
 {
@@ -11,6 +11,48 @@
 
 #define LOCTEXT_NAMESPACE "FlowDataPinProperties"
 
+EFlowPinType FFlowDataPinProperty::GetArrayElementPinType(const FProperty& ElementProperty)
+{
+	// must match the storage types of TFlowDataPinArrayElementTraits
+	if (ElementProperty.IsA<FInt64Property>())
+	{
+		return EFlowPinType::Int;
+	}
+
+	if (ElementProperty.IsA<FDoubleProperty>())
+	{
+		return EFlowPinType::Float;
+	}
+
+	if (ElementProperty.IsA<FNameProperty>())
+	{
+		return EFlowPinType::Name;
+	}
+
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(&ElementProperty))
+	{
+		if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+		{
+			return EFlowPinType::Vector;
+		}
+
+		if (StructProperty->Struct == TBaseStructure<FGameplayTag>::Get())
+		{
+			return EFlowPinType::GameplayTag;
+		}
+
+		return EFlowPinType::Invalid;
+	}
+
+	// class properties share the storage, but they're supplied as the Class pin type
+	if (ElementProperty.IsA<FObjectProperty>() && !ElementProperty.IsA<FClassProperty>())
+	{
+		return EFlowPinType::Object;
+	}
+
+	return EFlowPinType::Invalid;
+}
+
 #if WITH_EDITOR
 
 FFlowPin FFlowDataPinProperty::CreateFlowPin(const FName& PinName, const TInstancedStruct<FFlowDataPinProperty>& DataPinProperty)
@@ -50,9 +92,18 @@ FFlowPin FFlowDataPinProperty::CreateFlowPin(const FName& PinName, const TInstan
 
 	case EFlowPinType::Object:
 		{
-			const FFlowDataPinOutputProperty_Object& ObjectDataPinProperty = DataPinProperty.Get<FFlowDataPinOutputProperty_Object>();
-
-			FlowPin.SetPinType(FlowPinType, ObjectDataPinProperty.ClassFilter);
+			if (Property->IsArrayProperty())
+			{
+				const FFlowDataPinOutputProperty_ObjectArray& ObjectArrayDataPinProperty = DataPinProperty.Get<FFlowDataPinOutputProperty_ObjectArray>();
+
+				FlowPin.SetPinType(FlowPinType, ObjectArrayDataPinProperty.ClassFilter);
+			}
+			else
+			{
+				const FFlowDataPinOutputProperty_Object& ObjectDataPinProperty = DataPinProperty.Get<FFlowDataPinOutputProperty_Object>();
+
+				FlowPin.SetPinType(FlowPinType, ObjectDataPinProperty.ClassFilter);
+			}
 		}
 		break;
 
@@ -63,6 +114,8 @@ FFlowPin FFlowDataPinProperty::CreateFlowPin(const FName& PinName, const TInstan
 		break;
 	}
 
+	FlowPin.SetIsArray(Property->IsArrayProperty());
+
 	return FlowPin;
 }
 
@@ -86,6 +139,11 @@ FText FFlowNamedDataPinProperty::BuildHeaderText() const
 	if (const FFlowDataPinProperty* DataPinPropertyPtr = DataPinProperty.GetPtr<FFlowDataPinProperty>())
 	{
 		PinType = DataPinPropertyPtr->GetFlowPinType();
+
+		if (DataPinPropertyPtr->IsArrayProperty())
+		{
+			return FText::Format(LOCTEXT("FlowNamedDataPinArrayPropertyHeader", "{0} ({1} Array)"), { FText::FromName(Name), UEnum::GetDisplayValueAsText(PinType) });
+		}
 	}
 
 	return FText::Format(LOCTEXT("FlowNamedDataPinPropertyHeader", "{0} ({1})"), { FText::FromName(Name), UEnum::GetDisplayValueAsText(PinType) });
@@ -187,6 +245,16 @@ bool FFlowNamedDataPinProperty::IsOutputProperty() const
 	return false;
 }
 
+UClass* FFlowDataPinOutputProperty_Class::GetResolvedClass() const
+{
+	if (ResolvedValue.GetUniqueID() != Value)
+	{
+		ResolvedValue = FSoftObjectPtr(Value);
+	}
+
+	return Cast<UClass>(ResolvedValue.Get());
+}
+
 FFlowDataPinOutputProperty_Object::FFlowDataPinOutputProperty_Object(UObject* InValue, UClass* InClassFilter)
 	: Super()
 #if WITH_EDITOR
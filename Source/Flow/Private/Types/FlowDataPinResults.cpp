@@ -32,13 +32,28 @@ FFlowDataPinResult_Class::FFlowDataPinResult_Class(UClass* InValueClass)
 
 void FFlowDataPinResult_Class::SetValueFromPropertyWrapper(const FFlowDataPinOutputProperty_Class& PropertyWrapper)
 {
-	SetValueFromSoftPath(PropertyWrapper.GetAsSoftClass());
+	SetValueSoftClassAndClassPtr(PropertyWrapper.GetAsSoftClass(), PropertyWrapper.GetResolvedClass());
+}
+
+namespace FlowDataPinResults
+{
+	// FSoftClassPath only adds the class-specific API, so the path is copied as it is, without the string round-trip
+	static FSoftClassPath ToSoftClassPath(const FSoftObjectPath& SoftObjectPath)
+	{
+		FSoftClassPath SoftClassPath;
+		static_cast<FSoftObjectPath&>(SoftClassPath) = SoftObjectPath;
+		return SoftClassPath;
+	}
 }
 
 void FFlowDataPinResult_Class::SetValueFromSoftPath(const FSoftObjectPath& SoftObjectPath)
 {
-	const FSoftClassPath SoftClassPath(SoftObjectPath.ToString());
-	SetValueSoftClassAndClassPtr(SoftClassPath, SoftClassPath.ResolveClass());
+	SetValueSoftClassAndClassPtr(FlowDataPinResults::ToSoftClassPath(SoftObjectPath), Cast<UClass>(SoftObjectPath.ResolveObject()));
+}
+
+void FFlowDataPinResult_Class::SetValueFromSoftObjectPtr(const FSoftObjectPtr& SoftObjectPtr)
+{
+	SetValueSoftClassAndClassPtr(FlowDataPinResults::ToSoftClassPath(SoftObjectPtr.GetUniqueID()), Cast<UClass>(SoftObjectPtr.Get()));
 }
 
 void FFlowDataPinResult_Class::SetValueSoftClassAndClassPtr(const FSoftClassPath& SoftPath, UClass* ObjectPtr)
@@ -0,0 +1,674 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Types/FlowExpression.h"
+
+#include "Math/UnrealMathUtility.h"
+#include "Misc/CString.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowExpression)
+
+namespace FlowExpression
+{
+	static int32 GetArity(const EFlowExpressionOp Op)
+	{
+		switch (Op)
+		{
+			case EFlowExpressionOp::Constant:
+			case EFlowExpressionOp::Input:
+			case EFlowExpressionOp::Jump:
+				return 0;
+			case EFlowExpressionOp::Negate:
+			case EFlowExpressionOp::Not:
+			case EFlowExpressionOp::Abs:
+			case EFlowExpressionOp::Floor:
+			case EFlowExpressionOp::Ceil:
+			case EFlowExpressionOp::Round:
+			case EFlowExpressionOp::Sqrt:
+			case EFlowExpressionOp::Sign:
+			case EFlowExpressionOp::Bool:
+			case EFlowExpressionOp::JumpIfFalse:
+				return 1;
+			case EFlowExpressionOp::Clamp:
+			case EFlowExpressionOp::Lerp:
+				return 3;
+			default:
+				return 2;
+		}
+	}
+
+	// Shared by the evaluation and constant folding, returns false on division by zero
+	static bool Apply(const EFlowExpressionOp Op, const double* Args, double& OutValue)
+	{
+		switch (Op)
+		{
+			case EFlowExpressionOp::Negate: OutValue = -Args[0]; return true;
+			case EFlowExpressionOp::Not: OutValue = Args[0] == 0.0 ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::Abs: OutValue = FMath::Abs(Args[0]); return true;
+			case EFlowExpressionOp::Floor: OutValue = FMath::FloorToDouble(Args[0]); return true;
+			case EFlowExpressionOp::Ceil: OutValue = FMath::CeilToDouble(Args[0]); return true;
+			case EFlowExpressionOp::Round: OutValue = FMath::RoundToDouble(Args[0]); return true;
+			case EFlowExpressionOp::Sqrt: OutValue = FMath::Sqrt(FMath::Max(Args[0], 0.0)); return true;
+			case EFlowExpressionOp::Sign: OutValue = FMath::Sign(Args[0]); return true;
+			case EFlowExpressionOp::Bool: OutValue = Args[0] != 0.0 ? 1.0 : 0.0; return true;
+
+			case EFlowExpressionOp::Add: OutValue = Args[0] + Args[1]; return true;
+			case EFlowExpressionOp::Subtract: OutValue = Args[0] - Args[1]; return true;
+			case EFlowExpressionOp::Multiply: OutValue = Args[0] * Args[1]; return true;
+			case EFlowExpressionOp::Divide:
+				if (Args[1] == 0.0)
+				{
+					return false;
+				}
+				OutValue = Args[0] / Args[1];
+				return true;
+			case EFlowExpressionOp::Modulo:
+				if (Args[1] == 0.0)
+				{
+					return false;
+				}
+				OutValue = FMath::Fmod(Args[0], Args[1]);
+				return true;
+			case EFlowExpressionOp::Less: OutValue = Args[0] < Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::LessEqual: OutValue = Args[0] <= Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::Greater: OutValue = Args[0] > Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::GreaterEqual: OutValue = Args[0] >= Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::Equal: OutValue = Args[0] == Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::NotEqual: OutValue = Args[0] != Args[1] ? 1.0 : 0.0; return true;
+			case EFlowExpressionOp::Min: OutValue = FMath::Min(Args[0], Args[1]); return true;
+			case EFlowExpressionOp::Max: OutValue = FMath::Max(Args[0], Args[1]); return true;
+			case EFlowExpressionOp::Pow: OutValue = FMath::Pow(Args[0], Args[1]); return true;
+
+			case EFlowExpressionOp::Clamp: OutValue = FMath::Clamp(Args[0], Args[1], Args[2]); return true;
+			case EFlowExpressionOp::Lerp: OutValue = FMath::Lerp(Args[0], Args[1], Args[2]); return true;
+
+			default:
+				checkNoEntry();
+				return false;
+		}
+	}
+
+	struct FFunction
+	{
+		const TCHAR* Name;
+		EFlowExpressionOp Op;
+	};
+
+	static const FFunction Functions[] =
+	{
+		{TEXT("min"), EFlowExpressionOp::Min},
+		{TEXT("max"), EFlowExpressionOp::Max},
+		{TEXT("clamp"), EFlowExpressionOp::Clamp},
+		{TEXT("lerp"), EFlowExpressionOp::Lerp},
+		{TEXT("abs"), EFlowExpressionOp::Abs},
+		{TEXT("floor"), EFlowExpressionOp::Floor},
+		{TEXT("ceil"), EFlowExpressionOp::Ceil},
+		{TEXT("round"), EFlowExpressionOp::Round},
+		{TEXT("sqrt"), EFlowExpressionOp::Sqrt},
+		{TEXT("pow"), EFlowExpressionOp::Pow},
+		{TEXT("sign"), EFlowExpressionOp::Sign}
+	};
+
+	// Recursive descent parser, emitting instructions in postfix order
+	class FCompiler
+	{
+	public:
+		FCompiler(const FString& InExpression, FFlowExpressionProgram& InProgram)
+			: Expression(InExpression)
+			, Program(InProgram)
+		{
+		}
+
+		bool Compile(FString& OutError)
+		{
+			bool bParsed = ParseTernary();
+			if (bParsed)
+			{
+				SkipWhitespace();
+				bParsed = Position == Expression.Len() || Fail(TEXT("unexpected character"));
+			}
+
+			if (!bParsed)
+			{
+				OutError = FString::Printf(TEXT("%s at position %d"), *Error, Position + 1);
+			}
+			return bParsed;
+		}
+
+	private:
+		const FString& Expression;
+		FFlowExpressionProgram& Program;
+
+		int32 Position = 0;
+		int32 StackDepth = 0;
+		FString Error;
+
+		// Instructions before it might be skipped by a jump, so they can't be folded with the following ones
+		int32 FoldBarrier = 0;
+
+		bool Fail(const TCHAR* Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = Message;
+			}
+			return false;
+		}
+
+		TCHAR Peek(const int32 Offset = 0) const
+		{
+			return Expression.IsValidIndex(Position + Offset) ? Expression[Position + Offset] : TCHAR('\0');
+		}
+
+		void SkipWhitespace()
+		{
+			while (FChar::IsWhitespace(Peek()))
+			{
+				Position++;
+			}
+		}
+
+		bool Match(const TCHAR* Token)
+		{
+			SkipWhitespace();
+
+			const int32 TokenLength = FCString::Strlen(Token);
+			if (FCString::Strncmp(*Expression + Position, Token, TokenLength) == 0)
+			{
+				// keeps <= from being read as <, followed by =
+				if (TokenLength == 1 && Peek(1) == TCHAR('=') && FCString::Strchr(TEXT("<>=!"), Token[0]))
+				{
+					return false;
+				}
+
+				Position += TokenLength;
+				return true;
+			}
+			return false;
+		}
+
+		void EmitConstant(const double Value)
+		{
+			int32 ConstantIndex = Program.Constants.IndexOfByKey(Value);
+			if (ConstantIndex == INDEX_NONE)
+			{
+				ConstantIndex = Program.Constants.Add(Value);
+			}
+
+			Program.Instructions.Add({EFlowExpressionOp::Constant, ConstantIndex});
+			Program.MaxStackDepth = FMath::Max(Program.MaxStackDepth, ++StackDepth);
+		}
+
+		void EmitInput(const FName& InputName)
+		{
+			Program.Instructions.Add({EFlowExpressionOp::Input, Program.InputNames.AddUnique(InputName)});
+			Program.MaxStackDepth = FMath::Max(Program.MaxStackDepth, ++StackDepth);
+		}
+
+		void EmitOp(const EFlowExpressionOp Op)
+		{
+			const int32 Arity = GetArity(Op);
+			StackDepth -= Arity - 1;
+
+			// folds operators over literals only, unless it would divide by zero at runtime
+			const int32 FirstInstruction = Program.Instructions.Num() - Arity;
+			double Args[3];
+			bool bFoldable = FirstInstruction >= FoldBarrier;
+			for (int32 ArgIndex = 0; bFoldable && ArgIndex < Arity; ArgIndex++)
+			{
+				const FFlowExpressionInstruction& Instruction = Program.Instructions[FirstInstruction + ArgIndex];
+				bFoldable = Instruction.Op == EFlowExpressionOp::Constant;
+				Args[ArgIndex] = bFoldable ? Program.Constants[Instruction.Operand] : 0.0;
+			}
+
+			double FoldedValue = 0.0;
+			if (bFoldable && Apply(Op, Args, FoldedValue))
+			{
+				Program.Instructions.RemoveAt(FirstInstruction, Arity, EAllowShrinking::No);
+				StackDepth--;
+				EmitConstant(FoldedValue);
+				return;
+			}
+
+			Program.Instructions.Add({Op, INDEX_NONE});
+		}
+
+		void SetJumpTarget(const int32 JumpIndex)
+		{
+			Program.Instructions[JumpIndex].Operand = Program.Instructions.Num() - JumpIndex - 1;
+			FoldBarrier = Program.Instructions.Num();
+		}
+
+		// Emits the branches after the condition on the stack, so only the taken one is evaluated
+		// Each branch pushes a single value, the constant condition keeps the taken branch only
+		bool EmitConditional(TFunctionRef<bool()> EmitThen, TFunctionRef<bool()> EmitElse)
+		{
+			const int32 ConditionIndex = Program.Instructions.Num() - 1;
+			const FFlowExpressionInstruction& Condition = Program.Instructions[ConditionIndex];
+			if (ConditionIndex >= FoldBarrier && Condition.Op == EFlowExpressionOp::Constant)
+			{
+				const bool bCondition = Program.Constants[Condition.Operand] != 0.0;
+				const int32 PreviousFoldBarrier = FoldBarrier;
+
+				Program.Instructions.RemoveAt(ConditionIndex, 1, EAllowShrinking::No);
+				StackDepth--;
+				if (!EmitThen())
+				{
+					return false;
+				}
+
+				const int32 ElseStart = Program.Instructions.Num();
+				StackDepth--;
+				if (!EmitElse())
+				{
+					return false;
+				}
+
+				if (bCondition)
+				{
+					Program.Instructions.RemoveAt(ElseStart, Program.Instructions.Num() - ElseStart, EAllowShrinking::No);
+				}
+				else
+				{
+					Program.Instructions.RemoveAt(ConditionIndex, ElseStart - ConditionIndex, EAllowShrinking::No);
+				}
+
+				// the taken branch can be folded with the following operators, unless it has jumps of its own
+				FoldBarrier = PreviousFoldBarrier;
+				for (int32 Index = ConditionIndex; Index < Program.Instructions.Num(); Index++)
+				{
+					const EFlowExpressionOp Op = Program.Instructions[Index].Op;
+					if (Op == EFlowExpressionOp::JumpIfFalse || Op == EFlowExpressionOp::Jump)
+					{
+						FoldBarrier = Program.Instructions.Num();
+						break;
+					}
+				}
+				return true;
+			}
+
+			const int32 JumpIfFalseIndex = Program.Instructions.Add({EFlowExpressionOp::JumpIfFalse, INDEX_NONE});
+			StackDepth--;
+			if (!EmitThen())
+			{
+				return false;
+			}
+
+			const int32 JumpIndex = Program.Instructions.Add({EFlowExpressionOp::Jump, INDEX_NONE});
+			SetJumpTarget(JumpIfFalseIndex);
+
+			// the else branch starts from the stack depth before the then branch
+			StackDepth--;
+			if (!EmitElse())
+			{
+				return false;
+			}
+
+			SetJumpTarget(JumpIndex);
+			return true;
+		}
+
+		bool ParseTernary()
+		{
+			if (!ParseBinary(0))
+			{
+				return false;
+			}
+
+			if (Match(TEXT("?")))
+			{
+				return EmitConditional(
+					[this]()
+					{
+						return ParseTernary() && (Match(TEXT(":")) || Fail(TEXT("expected ':'")));
+					},
+					[this]()
+					{
+						return ParseTernary();
+					});
+			}
+			return true;
+		}
+
+		bool ParseRightOperandAsBool(const int32 Level)
+		{
+			if (!ParseBinary(Level))
+			{
+				return false;
+			}
+			EmitOp(EFlowExpressionOp::Bool);
+			return true;
+		}
+
+		// a && b is a ? bool(b) : 0, a || b is a ? 1 : bool(b)
+		bool EmitLogical(const bool bAnd, const int32 RightLevel)
+		{
+			if (bAnd)
+			{
+				return EmitConditional(
+					[this, RightLevel]() { return ParseRightOperandAsBool(RightLevel); },
+					[this]() { EmitConstant(0.0); return true; });
+			}
+
+			return EmitConditional(
+				[this]() { EmitConstant(1.0); return true; },
+				[this, RightLevel]() { return ParseRightOperandAsBool(RightLevel); });
+		}
+
+		struct FBinaryOperator
+		{
+			const TCHAR* Token;
+			EFlowExpressionOp Op;
+		};
+
+		// By precedence, from the lowest, || and && are emitted as jumps by ParseBinary
+		bool MatchBinaryOperator(const int32 Level, EFlowExpressionOp& OutOp)
+		{
+			static const FBinaryOperator OrOperators[] = {{TEXT("||"), EFlowExpressionOp::JumpIfFalse}};
+			static const FBinaryOperator AndOperators[] = {{TEXT("&&"), EFlowExpressionOp::JumpIfFalse}};
+			static const FBinaryOperator EqualityOperators[] = {{TEXT("=="), EFlowExpressionOp::Equal}, {TEXT("!="), EFlowExpressionOp::NotEqual}};
+			static const FBinaryOperator RelationalOperators[] = {{TEXT("<="), EFlowExpressionOp::LessEqual}, {TEXT(">="), EFlowExpressionOp::GreaterEqual}, {TEXT("<"), EFlowExpressionOp::Less}, {TEXT(">"), EFlowExpressionOp::Greater}};
+			static const FBinaryOperator AdditiveOperators[] = {{TEXT("+"), EFlowExpressionOp::Add}, {TEXT("-"), EFlowExpressionOp::Subtract}};
+			static const FBinaryOperator MultiplicativeOperators[] = {{TEXT("*"), EFlowExpressionOp::Multiply}, {TEXT("/"), EFlowExpressionOp::Divide}, {TEXT("%"), EFlowExpressionOp::Modulo}};
+			static const TArrayView<const FBinaryOperator> Levels[] = {OrOperators, AndOperators, EqualityOperators, RelationalOperators, AdditiveOperators, MultiplicativeOperators};
+
+			for (const FBinaryOperator& Operator : Levels[Level])
+			{
+				if (Match(Operator.Token))
+				{
+					OutOp = Operator.Op;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool ParseBinary(const int32 Level)
+		{
+			static constexpr int32 LevelsNum = 6;
+			if (Level == LevelsNum)
+			{
+				return ParseUnary();
+			}
+
+			if (!ParseBinary(Level + 1))
+			{
+				return false;
+			}
+
+			// || and && short-circuit, so they're emitted as jumps
+			static constexpr int32 OrLevel = 0;
+			static constexpr int32 AndLevel = 1;
+
+			EFlowExpressionOp Op;
+			while (MatchBinaryOperator(Level, Op))
+			{
+				if (Level == OrLevel || Level == AndLevel)
+				{
+					if (!EmitLogical(Level == AndLevel, Level + 1))
+					{
+						return false;
+					}
+					continue;
+				}
+
+				if (!ParseBinary(Level + 1))
+				{
+					return false;
+				}
+				EmitOp(Op);
+			}
+			return true;
+		}
+
+		bool ParseUnary()
+		{
+			if (Match(TEXT("-")))
+			{
+				if (!ParseUnary())
+				{
+					return false;
+				}
+				EmitOp(EFlowExpressionOp::Negate);
+				return true;
+			}
+			if (Match(TEXT("!")))
+			{
+				if (!ParseUnary())
+				{
+					return false;
+				}
+				EmitOp(EFlowExpressionOp::Not);
+				return true;
+			}
+			if (Match(TEXT("+")))
+			{
+				return ParseUnary();
+			}
+			return ParsePrimary();
+		}
+
+		bool ParsePrimary()
+		{
+			SkipWhitespace();
+			const TCHAR Char = Peek();
+
+			if (Match(TEXT("(")))
+			{
+				return ParseTernary() && (Match(TEXT(")")) || Fail(TEXT("expected ')'")));
+			}
+
+			if (FChar::IsDigit(Char) || (Char == TCHAR('.') && FChar::IsDigit(Peek(1))))
+			{
+				return ParseNumber();
+			}
+
+			if (Char == TCHAR('{'))
+			{
+				const int32 NameStart = Position + 1;
+				const int32 NameEnd = Expression.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, NameStart);
+				if (NameEnd == INDEX_NONE)
+				{
+					return Fail(TEXT("expected '}'"));
+				}
+
+				const FString InputName = Expression.Mid(NameStart, NameEnd - NameStart).TrimStartAndEnd();
+				if (InputName.IsEmpty())
+				{
+					return Fail(TEXT("empty input name"));
+				}
+
+				Position = NameEnd + 1;
+				EmitInput(FName(InputName));
+				return true;
+			}
+
+			if (FChar::IsAlpha(Char) || Char == TCHAR('_'))
+			{
+				const int32 IdentifierStart = Position;
+				while (FChar::IsAlnum(Peek()) || Peek() == TCHAR('_'))
+				{
+					Position++;
+				}
+				const FString Identifier = Expression.Mid(IdentifierStart, Position - IdentifierStart);
+
+				if (Identifier.Equals(TEXT("true"), ESearchCase::IgnoreCase))
+				{
+					EmitConstant(1.0);
+					return true;
+				}
+				if (Identifier.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+				{
+					EmitConstant(0.0);
+					return true;
+				}
+
+				if (Match(TEXT("(")))
+				{
+					return ParseFunction(Identifier);
+				}
+
+				EmitInput(FName(Identifier));
+				return true;
+			}
+
+			return Fail(Char == TCHAR('\0') ? TEXT("unexpected end of expression") : TEXT("unexpected character"));
+		}
+
+		bool ParseNumber()
+		{
+			const int32 NumberStart = Position;
+			bool bFraction = false;
+			while (FChar::IsDigit(Peek()) || Peek() == TCHAR('.'))
+			{
+				if (Peek() == TCHAR('.'))
+				{
+					if (bFraction)
+					{
+						return Fail(TEXT("invalid number"));
+					}
+					bFraction = true;
+				}
+				Position++;
+			}
+			if ((Peek() == TCHAR('e') || Peek() == TCHAR('E')) && (FChar::IsDigit(Peek(1)) || ((Peek(1) == TCHAR('-') || Peek(1) == TCHAR('+')) && FChar::IsDigit(Peek(2)))))
+			{
+				Position += 2;
+				while (FChar::IsDigit(Peek()))
+				{
+					Position++;
+				}
+			}
+
+			const FString Number = Expression.Mid(NumberStart, Position - NumberStart);
+			EmitConstant(FCString::Atod(*Number));
+			return true;
+		}
+
+		bool ParseFunction(const FString& FunctionName)
+		{
+			const FFunction* Function = nullptr;
+			for (const FFunction& Candidate : Functions)
+			{
+				if (FunctionName.Equals(Candidate.Name, ESearchCase::IgnoreCase))
+				{
+					Function = &Candidate;
+					break;
+				}
+			}
+			if (Function == nullptr)
+			{
+				return Fail(TEXT("unknown function"));
+			}
+
+			const int32 Arity = GetArity(Function->Op);
+			for (int32 ArgIndex = 0; ArgIndex < Arity; ArgIndex++)
+			{
+				if (ArgIndex > 0 && !Match(TEXT(",")))
+				{
+					return Fail(TEXT("expected ','"));
+				}
+				if (!ParseTernary())
+				{
+					return false;
+				}
+			}
+
+			if (!Match(TEXT(")")))
+			{
+				return Fail(TEXT("expected ')'"));
+			}
+
+			EmitOp(Function->Op);
+			return true;
+		}
+	};
+}
+
+bool FFlowExpressionProgram::Compile(const FString& Expression, FFlowExpressionProgram& OutProgram, FString& OutError)
+{
+	OutProgram = FFlowExpressionProgram();
+
+	FlowExpression::FCompiler Compiler(Expression, OutProgram);
+	if (!Compiler.Compile(OutError))
+	{
+		OutProgram = FFlowExpressionProgram();
+		return false;
+	}
+
+	OutProgram.Instructions.Shrink();
+	OutProgram.Constants.Shrink();
+	OutProgram.InputNames.Shrink();
+	return true;
+}
+
+bool FFlowExpressionProgram::Evaluate(TFunctionRef<bool(int32 InputIndex, double& OutValue)> ResolveInput, double& OutValue, FString& OutError) const
+{
+	if (!IsCompiled())
+	{
+		OutError = TEXT("Expression isn't compiled");
+		return false;
+	}
+
+	TArray<double, TInlineAllocator<16>> Stack;
+	Stack.SetNumUninitialized(MaxStackDepth);
+	int32 StackNum = 0;
+
+	// resolved once per evaluation, even if referenced multiple times
+	TArray<double, TInlineAllocator<8>> InputValues;
+	InputValues.SetNumUninitialized(InputNames.Num());
+	TBitArray<TInlineAllocator<1>> ResolvedInputs(false, InputNames.Num());
+
+	for (int32 InstructionIndex = 0; InstructionIndex < Instructions.Num(); InstructionIndex++)
+	{
+		const FFlowExpressionInstruction& Instruction = Instructions[InstructionIndex];
+		switch (Instruction.Op)
+		{
+			case EFlowExpressionOp::Constant:
+				Stack[StackNum++] = Constants[Instruction.Operand];
+				break;
+			case EFlowExpressionOp::Input:
+				if (!ResolvedInputs[Instruction.Operand])
+				{
+					if (!ResolveInput(Instruction.Operand, InputValues[Instruction.Operand]))
+					{
+						OutError = FString::Printf(TEXT("Could not resolve input %s"), *InputNames[Instruction.Operand].ToString());
+						return false;
+					}
+					ResolvedInputs[Instruction.Operand] = true;
+				}
+				Stack[StackNum++] = InputValues[Instruction.Operand];
+				break;
+			case EFlowExpressionOp::JumpIfFalse:
+				if (Stack[--StackNum] == 0.0)
+				{
+					InstructionIndex += Instruction.Operand;
+				}
+				break;
+			case EFlowExpressionOp::Jump:
+				InstructionIndex += Instruction.Operand;
+				break;
+			default:
+			{
+				const int32 Arity = FlowExpression::GetArity(Instruction.Op);
+				StackNum -= Arity;
+
+				double Result;
+				if (!FlowExpression::Apply(Instruction.Op, &Stack[StackNum], Result))
+				{
+					OutError = TEXT("Division by zero");
+					return false;
+				}
+				Stack[StackNum++] = Result;
+			}
+		}
+	}
+
+	check(StackNum == 1);
+	OutValue = Stack[0];
+	return true;
+}
+
+SIZE_T FFlowExpressionProgram::GetAllocatedSize() const
+{
+	return Instructions.GetAllocatedSize() + Constants.GetAllocatedSize() + InputNames.GetAllocatedSize();
+}
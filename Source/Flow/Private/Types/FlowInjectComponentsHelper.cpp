@@ -11,7 +11,7 @@ TArray<UActorComponent*> FFlowInjectComponentsHelper::CreateComponentInstancesFo
 {
 	TArray<UActorComponent*> ComponentInstances;
 
-	if (ComponentTemplates.IsEmpty() && ComponentClasses.IsEmpty())
+	if (ComponentTemplates.IsEmpty() && ComponentClasses.IsEmpty() && SoftComponentClasses.IsEmpty())
 	{
 		return ComponentInstances;
 	}
@@ -48,9 +48,80 @@ TArray<UActorComponent*> FFlowInjectComponentsHelper::CreateComponentInstancesFo
 		}
 	}
 
+	for (const TSoftClassPtr<UActorComponent>& SoftComponentClass : SoftComponentClasses)
+	{
+		// resolves without loading if the class has been preloaded
+		const TSubclassOf<UActorComponent> ComponentClass = SoftComponentClass.LoadSynchronous();
+		if (!IsValid(ComponentClass))
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Cannot inject a null component class %s!"), *SoftComponentClass.ToString());
+
+			continue;
+		}
+
+		const FName InstanceBaseName = ComponentClass->GetFName();
+		if (UActorComponent* ComponentInstance = TryCreateComponentInstanceForActorFromClass(Actor, ComponentClass, InstanceBaseName))
+		{
+			ComponentInstances.Add(ComponentInstance);
+		}
+	}
+
 	return ComponentInstances;
 }
 
+void FFlowInjectComponentsHelper::GatherPreloadPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const UActorComponent* ComponentTemplate : ComponentTemplates)
+	{
+		if (IsValid(ComponentTemplate))
+		{
+			GatherSoftReferences(*ComponentTemplate, OutPaths);
+		}
+	}
+
+	for (const TSubclassOf<UActorComponent> ComponentClass : ComponentClasses)
+	{
+		if (IsValid(ComponentClass))
+		{
+			GatherSoftReferences(*ComponentClass->GetDefaultObject(), OutPaths);
+		}
+	}
+
+	// soft references of the class defaults are known only after the class is loaded
+	for (const TSoftClassPtr<UActorComponent>& SoftComponentClass : SoftComponentClasses)
+	{
+		if (!SoftComponentClass.IsNull())
+		{
+			OutPaths.AddUnique(SoftComponentClass.ToSoftObjectPath());
+		}
+	}
+}
+
+void FFlowInjectComponentsHelper::GatherSoftReferences(const UObject& Object, TArray<FSoftObjectPath>& OutPaths)
+{
+	for (TFieldIterator<FSoftObjectProperty> It(Object.GetClass()); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ArrayIndex++)
+		{
+			const FSoftObjectPath& Path = It->GetPropertyValue_InContainer(&Object, ArrayIndex).ToSoftObjectPath();
+			if (!Path.IsNull())
+			{
+				OutPaths.AddUnique(Path);
+			}
+		}
+	}
+
+	TArray<UObject*> DefaultSubobjects;
+	Object.GetDefaultSubobjects(DefaultSubobjects);
+	for (const UObject* Subobject : DefaultSubobjects)
+	{
+		if (IsValid(Subobject))
+		{
+			GatherSoftReferences(*Subobject, OutPaths);
+		}
+	}
+}
+
 UActorComponent* FFlowInjectComponentsHelper::TryCreateComponentInstanceForActorFromTemplate(AActor& Actor, UActorComponent& ComponentTemplate)
 {
 	// Following pattern from UGameFrameworkComponentManager::CreateComponentOnInstance()
@@ -83,6 +154,16 @@ UActorComponent* FFlowInjectComponentsHelper::TryCreateComponentInstanceForActor
 
 void FFlowInjectComponentsHelper::InjectCreatedComponent(AActor& Actor, UActorComponent& ComponentInstance)
 {
+	// pooled component reused on the same actor, registering would activate it the same way
+	if (ComponentInstance.IsRegistered())
+	{
+		if (ComponentInstance.bAutoActivate)
+		{
+			ComponentInstance.Activate(true);
+		}
+		return;
+	}
+
 	// Following pattern from UGameFrameworkComponentManager::CreateComponentOnInstance()
 	if (USceneComponent* SceneComponentInstance = Cast<USceneComponent>(&ComponentInstance))
 	{
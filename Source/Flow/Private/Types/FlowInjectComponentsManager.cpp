@@ -1,10 +1,14 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Types/FlowInjectComponentsManager.h"
+#include "Types/FlowActorOwnerComponentRef.h"
 #include "Types/FlowInjectComponentsHelper.h"
 #include "Components/ActorComponent.h"
 #include "GameFramework/Actor.h"
 #include "FlowLogChannels.h"
+#include "FlowSubsystem.h"
+
+#include "Engine/GameInstance.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowInjectComponentsManager)
 
@@ -15,6 +19,8 @@ void UFlowInjectComponentsManager::InitializeRuntime()
 
 void UFlowInjectComponentsManager::ShutdownRuntime()
 {
+	CancelPendingInjections();
+
 	if (bRemoveInjectedComponentsWhenDeinitializing)
 	{
 		RemoveInjectedComponents();
@@ -34,6 +40,90 @@ void UFlowInjectComponentsManager::InjectComponentsOnActor(AActor& Actor, const
 	}
 }
 
+void UFlowInjectComponentsManager::InjectComponentsDeferred(const TArray<FFlowPendingComponentInjection>& Injections, const int32 InMaxInjectionsPerFrame, const float FrameBudget, FFlowComponentInjectionComplete&& OnComplete)
+{
+	PendingInjections.Append(Injections);
+	PendingInjectionCallbacks.Emplace(PendingInjections.Num(), MoveTemp(OnComplete));
+
+	MaxInjectionsPerFrame = InMaxInjectionsPerFrame;
+	InjectionFrameBudget = FrameBudget;
+
+	// the first part is injected right away like with InjectComponentsOnActor, unless injecting is already in progress
+	if (PendingInjectionsHandle.IsValid() || bIsInjectingPending)
+	{
+		return;
+	}
+
+	if (TickPendingInjections(0.0f))
+	{
+		PendingInjectionsHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickPendingInjections));
+	}
+}
+
+void UFlowInjectComponentsManager::CancelPendingInjections()
+{
+	if (PendingInjectionsHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingInjectionsHandle);
+		PendingInjectionsHandle.Reset();
+	}
+
+	PendingInjections.Empty();
+	PendingInjectionsHead = 0;
+	PendingInjectionCallbacks.Empty();
+}
+
+bool UFlowInjectComponentsManager::TickPendingInjections(float DeltaTime)
+{
+	TGuardValue<bool> InjectingGuard(bIsInjectingPending, true);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 InjectionsThisFrame = 0;
+
+	while (PendingInjectionsHead < PendingInjections.Num())
+	{
+		if (InjectionsThisFrame > 0
+			&& ((MaxInjectionsPerFrame > 0 && InjectionsThisFrame >= MaxInjectionsPerFrame)
+				|| (InjectionFrameBudget > 0.0f && (FPlatformTime::Seconds() - StartTime) * 1000000.0 >= InjectionFrameBudget)))
+		{
+			return true;
+		}
+
+		const FFlowPendingComponentInjection& Injection = PendingInjections[PendingInjectionsHead++];
+		if (IsValid(Injection.Actor) && IsValid(Injection.Component))
+		{
+			AddAndRegisterComponent(*Injection.Actor, *Injection.Component);
+			++InjectionsThisFrame;
+		}
+
+		ExecuteCompletedInjectionCallbacks();
+	}
+
+	// covers batches without any components
+	ExecuteCompletedInjectionCallbacks();
+	if (HasPendingInjections())
+	{
+		return true;
+	}
+
+	PendingInjections.Reset();
+	PendingInjectionsHead = 0;
+	PendingInjectionsHandle.Reset();
+
+	return false;
+}
+
+void UFlowInjectComponentsManager::ExecuteCompletedInjectionCallbacks()
+{
+	// callbacks might start another deferred injection, appending to the pending injections
+	while (!PendingInjectionCallbacks.IsEmpty() && PendingInjectionCallbacks[0].Key <= PendingInjectionsHead)
+	{
+		FFlowComponentInjectionComplete Callback = MoveTemp(PendingInjectionCallbacks[0].Value);
+		PendingInjectionCallbacks.RemoveAt(0);
+		Callback.ExecuteIfBound();
+	}
+}
+
 void UFlowInjectComponentsManager::RemoveInjectedComponents()
 {
 	for (auto& KV : ActorToComponentsMap)
@@ -59,15 +149,20 @@ void UFlowInjectComponentsManager::RemoveInjectedComponents()
 void UFlowInjectComponentsManager::AddAndRegisterComponent(AActor& Actor, UActorComponent& ComponentInstance)
 {
 	FFlowInjectComponentsHelper::InjectCreatedComponent(Actor, ComponentInstance);
+	FFlowActorOwnerComponentRef::InvalidateComponentNameIndex(Actor);
 
 	if (bRemoveInjectedComponentsWhenDeinitializing)
 	{
 		// If we will be responsible for removing them later,
 		// we need to keep track of the spawned components
-		FFlowComponentInstances& ComponentInstances = ActorToComponentsMap.FindOrAdd(&Actor);
-		ComponentInstances.Components.Add(&ComponentInstance);
-
-		RegisterOnDestroyedDelegate(Actor);
+		// actor is monitored since injecting its first component
+		FFlowComponentInstances* ComponentInstances = ActorToComponentsMap.Find(&Actor);
+		if (ComponentInstances == nullptr)
+		{
+			ComponentInstances = &ActorToComponentsMap.Add(&Actor);
+			RegisterOnDestroyedDelegate(Actor);
+		}
+		ComponentInstances->Components.Add(&ComponentInstance);
 	}
 }
 
@@ -77,7 +172,21 @@ void UFlowInjectComponentsManager::RemoveAndUnregisterComponent(AActor& Actor, U
 
 	UnregisterOnDestroyedDelegate(Actor);
 
-	FFlowInjectComponentsHelper::DestroyInjectedComponent(Actor, ComponentInstance);
+	const UActorComponent* Archetype = PoolArchetype.Get();
+	const UGameInstance* GameInstance = Actor.GetGameInstance();
+	UFlowSubsystem* FlowSubsystem = GameInstance ? GameInstance->GetSubsystem<UFlowSubsystem>() : nullptr;
+
+	if (Archetype == nullptr || FlowSubsystem == nullptr || !FlowSubsystem->ReleaseComponentToPool(ComponentInstance, *Archetype, MaxPooledComponents))
+	{
+		FFlowInjectComponentsHelper::DestroyInjectedComponent(Actor, ComponentInstance);
+	}
+	FFlowActorOwnerComponentRef::InvalidateComponentNameIndex(Actor);
+}
+
+void UFlowInjectComponentsManager::SetComponentPooling(const UActorComponent& Archetype, const int32 InMaxPooledComponents)
+{
+	PoolArchetype = &Archetype;
+	MaxPooledComponents = InMaxPooledComponents;
 }
 
 void UFlowInjectComponentsManager::RegisterOnDestroyedDelegate(AActor& Actor)
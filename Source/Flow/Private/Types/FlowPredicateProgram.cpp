@@ -0,0 +1,267 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Types/FlowPredicateProgram.h"
+#include "AddOns/FlowNodeAddOn_PredicateAND.h"
+#include "AddOns/FlowNodeAddOn_PredicateNOT.h"
+#include "AddOns/FlowNodeAddOn_PredicateOR.h"
+#include "FlowComponent.h"
+#include "FlowStats.h"
+#include "Interfaces/FlowPredicateInterface.h"
+#include "Nodes/FlowNode.h"
+#include "Types/FlowBlueprintEvents.h"
+
+#include "GameFramework/Actor.h"
+
+void FFlowPredicateProgram::Compile(const TArray<UFlowNodeAddOn*>& AddOns)
+{
+	Reset();
+
+	CompileComposite(AddOns, EOp::JumpIfFalse);
+
+	// nested composites end on the jump of their parent, which doesn't change the result, so jump straight to its target
+	for (FInstruction& Instruction : Instructions)
+	{
+		if (Instruction.Op == EOp::JumpIfFalse || Instruction.Op == EOp::JumpIfTrue)
+		{
+			while (Instructions.IsValidIndex(Instruction.Operand) && Instructions[Instruction.Operand].Op == Instruction.Op)
+			{
+				Instruction.Operand = Instructions[Instruction.Operand].Operand;
+			}
+		}
+	}
+}
+
+void FFlowPredicateProgram::Reset()
+{
+	Instructions.Reset();
+	Leaves.Reset();
+	Caches.Reset();
+}
+
+SIZE_T FFlowPredicateProgram::GetAllocatedSize() const
+{
+	SIZE_T Size = Instructions.GetAllocatedSize() + Leaves.GetAllocatedSize() + Caches.GetAllocatedSize();
+	for (const FLeafCache& Cache : Caches)
+	{
+		Size += Cache.DataPinNames.GetAllocatedSize() + Cache.DataPinDependencies.GetAllocatedSize() + Cache.CachedVersions.GetAllocatedSize();
+	}
+	return Size;
+}
+
+bool FFlowPredicateProgram::Evaluate() const
+{
+	bool bResult = true;
+
+	int32 Index = 0;
+	while (Index < Instructions.Num())
+	{
+		const FInstruction& Instruction = Instructions[Index];
+		switch (Instruction.Op)
+		{
+			case EOp::Leaf:
+				bResult = EvaluateLeaf(Leaves[Instruction.Operand]);
+				++Index;
+				break;
+			case EOp::True:
+				bResult = true;
+				++Index;
+				break;
+			case EOp::Not:
+				bResult = !bResult;
+				++Index;
+				break;
+			case EOp::JumpIfFalse:
+				Index = bResult ? Index + 1 : Instruction.Operand;
+				break;
+			case EOp::JumpIfTrue:
+				Index = bResult ? Instruction.Operand : Index + 1;
+				break;
+			default:
+				checkNoEntry();
+				return bResult;
+		}
+	}
+
+	return bResult;
+}
+
+void FFlowPredicateProgram::CompilePredicate(const UFlowNodeAddOn* AddOn)
+{
+	// only exact composite classes are flattened, subclasses might change the evaluation
+	const UClass* AddOnClass = AddOn->GetClass();
+	if (AddOnClass == UFlowNodeAddOn_PredicateAND::StaticClass())
+	{
+		CompileComposite(AddOn->GetFlowNodeAddOnChildren(), EOp::JumpIfFalse);
+		return;
+	}
+
+	if (AddOnClass == UFlowNodeAddOn_PredicateOR::StaticClass())
+	{
+		CompileComposite(AddOn->GetFlowNodeAddOnChildren(), EOp::JumpIfTrue);
+		return;
+	}
+
+	if (AddOnClass == UFlowNodeAddOn_PredicateNOT::StaticClass())
+	{
+		const TArray<UFlowNodeAddOn*>& Children = AddOn->GetFlowNodeAddOnChildren();
+		if (Children.IsEmpty())
+		{
+			Instructions.Add({EOp::True, 0});
+			return;
+		}
+
+		if (Children.Num() == 1 && IFlowPredicateInterface::ImplementsInterfaceSafe(Children[0]))
+		{
+			CompilePredicate(Children[0]);
+			Instructions.Add({EOp::Not, 0});
+			return;
+		}
+
+		// misconfigured NOT stays a leaf, so it keeps reporting errors on evaluation
+	}
+
+	FLeaf& Leaf = Leaves.AddDefaulted_GetRef();
+	Leaf.AddOn = AddOn;
+	Leaf.CacheIndex = INDEX_NONE;
+
+	// Blueprint subclasses of native predicates are evaluated natively too, unless they override the event
+	const FFlowBlueprintEvents& BlueprintEvents = AddOn->GetBlueprintEvents();
+	const IFlowPredicateInterface* NativePredicate = Cast<IFlowPredicateInterface>(AddOn);
+	Leaf.NativePredicate = BlueprintEvents.EvaluatePredicate == nullptr ? NativePredicate : nullptr;
+
+	const FFlowPredicateCacheDependencies Dependencies = NativePredicate && BlueprintEvents.GetPredicateCacheDependencies == nullptr
+		? NativePredicate->GetPredicateCacheDependencies_Implementation()
+		: IFlowPredicateInterface::Execute_GetPredicateCacheDependencies(AddOn);
+	if (Dependencies.bCacheResult)
+	{
+		Leaf.CacheIndex = Caches.Num();
+
+		FLeafCache& Cache = Caches.AddDefaulted_GetRef();
+		Cache.bOwnerIdentityTags = Dependencies.bOwnerIdentityTags;
+		Cache.DataPinNames = Dependencies.DataPinNames;
+	}
+
+	Instructions.Add({EOp::Leaf, Leaves.Num() - 1});
+}
+
+void FFlowPredicateProgram::CompileComposite(const TArray<UFlowNodeAddOn*>& AddOns, const EOp ShortCircuitOp)
+{
+	TArray<int32, TInlineAllocator<8>> PendingJumps;
+	bool bHasPredicates = false;
+
+	for (const UFlowNodeAddOn* AddOn : AddOns)
+	{
+		// AddOns not implementing the interface are skipped, like in EvaluatePredicateAND and EvaluatePredicateOR
+		if (!IFlowPredicateInterface::ImplementsInterfaceSafe(AddOn))
+		{
+			continue;
+		}
+
+		// the result of the previous child decides, if the remaining children are evaluated
+		if (bHasPredicates)
+		{
+			PendingJumps.Add(Instructions.Add({ShortCircuitOp, INDEX_NONE}));
+		}
+
+		CompilePredicate(AddOn);
+		bHasPredicates = true;
+	}
+
+	if (!bHasPredicates)
+	{
+		// composites without predicates evaluate to true
+		Instructions.Add({EOp::True, 0});
+	}
+
+	for (const int32 JumpIndex : PendingJumps)
+	{
+		Instructions[JumpIndex].Operand = Instructions.Num();
+	}
+}
+
+bool FFlowPredicateProgram::EvaluateLeaf(const FLeaf& Leaf) const
+{
+	if (Leaf.CacheIndex == INDEX_NONE)
+	{
+		return EvaluatePredicate(Leaf);
+	}
+
+	FLeafCache& Cache = Caches[Leaf.CacheIndex];
+	if (!Cache.bDependenciesResolved)
+	{
+		ResolveCacheDependencies(Leaf, Cache);
+	}
+
+	bool bCacheable = true;
+	TArray<uint32, TInlineAllocator<4>> Versions;
+
+	if (Cache.bOwnerIdentityTags)
+	{
+		const UFlowComponent* OwnerComponent = Cache.OwnerComponent.Get();
+		bCacheable = OwnerComponent != nullptr;
+		Versions.Add(OwnerComponent ? OwnerComponent->GetIdentityTagsVersion() : 0);
+	}
+
+	for (const FDataPinDependency& Dependency : Cache.DataPinDependencies)
+	{
+		// zero stands for the unversioned pin, its value might change anytime
+		const UFlowNode* SupplierFlowNode = Dependency.SupplierFlowNode.Get();
+		const uint32 Version = SupplierFlowNode ? SupplierFlowNode->GetDataPinVersion(Dependency.SupplierPinName) : 0;
+		bCacheable &= Version != 0;
+		Versions.Add(Version);
+	}
+
+	if (bCacheable && Cache.bHasCachedResult && Cache.CachedVersions == Versions)
+	{
+		INC_DWORD_STAT(STAT_FlowPredicateCacheHits);
+		return Cache.bCachedResult;
+	}
+
+	INC_DWORD_STAT(STAT_FlowPredicateCacheMisses);
+
+	const bool bResult = EvaluatePredicate(Leaf);
+
+	Cache.bHasCachedResult = bCacheable;
+	Cache.bCachedResult = bResult;
+	Cache.CachedVersions = MoveTemp(Versions);
+
+	return bResult;
+}
+
+bool FFlowPredicateProgram::EvaluatePredicate(const FLeaf& Leaf)
+{
+	return Leaf.NativePredicate ? Leaf.NativePredicate->EvaluatePredicate_Implementation() : IFlowPredicateInterface::Execute_EvaluatePredicate(Leaf.AddOn);
+}
+
+void FFlowPredicateProgram::ResolveCacheDependencies(const FLeaf& Leaf, FLeafCache& Cache)
+{
+	Cache.bDependenciesResolved = true;
+
+	if (Cache.bOwnerIdentityTags)
+	{
+		UObject* RootFlowOwner = Leaf.AddOn->TryGetRootFlowObjectOwner();
+		const UFlowComponent* OwnerComponent = Cast<UFlowComponent>(RootFlowOwner);
+		if (OwnerComponent == nullptr)
+		{
+			if (const AActor* OwnerActor = Leaf.AddOn->TryGetRootFlowActorOwner())
+			{
+				OwnerComponent = OwnerActor->FindComponentByClass<UFlowComponent>();
+			}
+		}
+
+		Cache.OwnerComponent = OwnerComponent;
+	}
+
+	const UFlowNode* FlowNode = Leaf.AddOn->GetFlowNodeSelfOrOwner();
+	for (const FName& PinName : Cache.DataPinNames)
+	{
+		// only the preferred supplier is versioned, as lower priority values are used only while it fails
+		FFlowPinValueSupplierDataArray SupplierDatas;
+		FDataPinDependency& Dependency = Cache.DataPinDependencies.AddDefaulted_GetRef();
+		if (IsValid(FlowNode) && FlowNode->TryGetFlowDataPinSupplierDatasForPinName(PinName, SupplierDatas))
+		{
+			Dependency.SupplierFlowNode = SupplierDatas.Last().SupplierFlowNode;
+			Dependency.SupplierPinName = SupplierDatas.Last().SupplierPinName;
+		}
+	}
+}
@@ -10,21 +10,29 @@
 #include "FlowMessageLog.h"
 #endif
 
+#include "StructUtils/InstancedStruct.h"
 #include "UObject/ObjectKey.h"
 #include "FlowAsset.generated.h"
 
+class FFlowLightweightProgram;
+class IFlowOwnerInterface;
+class UFlowComponent;
 class UFlowNode_CustomOutput;
 class UFlowNode_CustomInput;
 class UFlowNode_SubGraph;
 class UFlowSubsystem;
+struct FAssetData;
+struct FFlowLightweightState;
+struct FFlowNodeBlueprintMetadata;
 
+class FScopedTransaction;
 class UEdGraph;
 class UEdGraphNode;
 class UFlowAsset;
 
 #if !UE_BUILD_SHIPPING
 DECLARE_DELEGATE(FFlowGraphEvent);
-DECLARE_DELEGATE_TwoParams(FFlowSignalEvent, const FGuid& /*NodeGuid*/, const FName& /*PinName*/);
+DECLARE_DELEGATE_TwoParams(FFlowSignalEvent, const UFlowNode& /*NodeInstance*/, const FName& /*PinName*/);
 #endif
 
 // Working Data struct for the Harvest Data Pins operation
@@ -57,6 +65,177 @@ struct FFlowHarvestDataPinsWorkingData
 	bool bPinNameMapChanged = false;
 };
 
+#if WITH_EDITOR
+/**
+ * Scope of a bulk graph edit, i.e. pasting or deleting many nodes
+ * Opens a single transaction, harvests connections once and calls PostEditChange once per changed node when the outermost scope ends
+ * Graph refreshes requested inside the scope are coalesced into a single NotifyGraphChanged
+ */
+struct FLOW_API FFlowAssetEditBatch
+{
+	FFlowAssetEditBatch(UFlowAsset* InFlowAsset, const FText& TransactionDescription);
+	~FFlowAssetEditBatch();
+
+private:
+	TWeakObjectPtr<UFlowAsset> FlowAsset;
+	TUniquePtr<FScopedTransaction> Transaction;
+};
+#endif
+
+// Pin activation waiting in the trigger queue of the Flow Asset instance (see UFlowSettings::bUseTriggerQueue)
+struct FFlowQueuedTrigger
+{
+	UFlowNode* Node = nullptr;
+	FName PinName = NAME_None;
+	bool bIsKnownPin = false;
+
+	// See FFlowTelemetry::GetTime
+	double QueuedTime = 0.0;
+
+	FFlowQueuedTrigger() {}
+
+	FFlowQueuedTrigger(UFlowNode* InNode, const FName& InPinName, const bool bInIsKnownPin, const double InQueuedTime = 0.0)
+		: Node(InNode)
+		, PinName(InPinName)
+		, bIsKnownPin(bInIsKnownPin)
+		, QueuedTime(InQueuedTime)
+	{
+	}
+};
+
+// Output pin connection resolved to dense indices
+struct FLOW_API FFlowCompiledConnection
+{
+	// Index of the connected node in FFlowCompiledGraph::NodeGuids, INDEX_NONE if output isn't connected
+	int32 NodeIndex = INDEX_NONE;
+
+	// Index of the connected pin in the InputPins array of the connected node, INDEX_NONE if pin couldn't be resolved
+	int32 PinIndex = INDEX_NONE;
+
+	FORCEINLINE bool IsConnected() const { return NodeIndex != INDEX_NONE; }
+	FORCEINLINE bool IsResolved() const { return NodeIndex != INDEX_NONE && PinIndex != INDEX_NONE; }
+
+	friend FArchive& operator<<(FArchive& Ar, FFlowCompiledConnection& Connection)
+	{
+		return Ar << Connection.NodeIndex << Connection.PinIndex;
+	}
+};
+
+// Dense node indices in the execution order
+struct FLOW_API FFlowCompiledNodeList
+{
+	TArray<int32> NodeIndices;
+
+	// Leading entries of NodeIndices reachable from the entry node, the rest is reachable only from Custom Inputs
+	int32 EntryNodesNum = 0;
+};
+
+// Runtime form of the graph connections, built once per template asset and shared by all its instances
+// Nodes get dense indices, so triggering an output pin doesn't require any FGuid or FName lookups
+struct FLOW_API FFlowCompiledGraph
+{
+	// Node guids, ordered by the dense node index
+	TArray<FGuid> NodeGuids;
+
+	// OutputOffsets[NodeIndex] is the index of the first OutputConnections entry of the node
+	// Contains an additional trailing entry, so the OutputPins count of any node is OutputOffsets[NodeIndex + 1] - OutputOffsets[NodeIndex]
+	TArray<int32> OutputOffsets;
+
+	// One entry for every OutputPins element of every node
+	TArray<FFlowCompiledConnection> OutputConnections;
+
+	// Reverse lookup of NodeGuids
+	TMap<FGuid, int32> NodeIndices;
+
+	// ExecutionOrder[NodeIndex] is the position of the node when iterating the graph from the entry node and Custom Inputs
+	// Nodes not connected to any input follow, in the dense index order
+	TArray<int32> ExecutionOrder;
+
+	// Nodes connected to the entry node and Custom Inputs, as gathered by UFlowAsset::GatherNodesConnectedToAllInputs
+	FFlowCompiledNodeList ConnectedNodes;
+
+	// ConnectedNodes filtered by the node class, lazily gathered by GetConnectedNodesOfClass on the game thread
+	mutable TMap<TObjectKey<UClass>, FFlowCompiledNodeList> ConnectedNodesByClass;
+
+	void Compile(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes);
+	void CompileExecutionOrder(const TArray<UFlowNode*>& NodesInExecutionOrder, const int32 EntryNodesNum);
+
+	// Flat tables cooked by UFlowAsset::Serialize, bump the version after changing the layout
+	static constexpr int32 SerializationVersion = 1;
+	void Serialize(FArchive& Ar);
+
+	// Loaded tables are used without bounds checks, so offsets and indices have to be within the dense index range
+	bool HasValidTables() const;
+
+	// Connections of every node match its OutputPins, call once the nodes have been loaded
+	bool MatchesOutputPins(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes) const;
+
+	const FFlowCompiledNodeList& GetConnectedNodesOfClass(const UClass* NodeClass, const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes) const;
+
+	int32 GetExecutionOrder(const int32 NodeIndex) const
+	{
+		return ExecutionOrder.IsValidIndex(NodeIndex) ? ExecutionOrder[NodeIndex] : MAX_int32;
+	}
+
+	int32 GetNodesNum() const { return NodeGuids.Num(); }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = NodeGuids.GetAllocatedSize() + OutputOffsets.GetAllocatedSize() + OutputConnections.GetAllocatedSize()
+			+ NodeIndices.GetAllocatedSize() + ExecutionOrder.GetAllocatedSize() + ConnectedNodes.NodeIndices.GetAllocatedSize();
+
+		for (const TPair<TObjectKey<UClass>, FFlowCompiledNodeList>& NodeList : ConnectedNodesByClass)
+		{
+			Size += NodeList.Value.NodeIndices.GetAllocatedSize();
+		}
+
+		return Size + ConnectedNodesByClass.GetAllocatedSize();
+	}
+	int32 FindNodeIndex(const FGuid& NodeGuid) const
+	{
+		const int32* NodeIndex = NodeIndices.Find(NodeGuid);
+		return NodeIndex ? *NodeIndex : INDEX_NONE;
+	}
+
+	FORCEINLINE const FFlowCompiledConnection* FindOutputConnection(const int32 NodeIndex, const int32 OutputPinIndex) const
+	{
+		if (NodeGuids.IsValidIndex(NodeIndex))
+		{
+			const int32 ConnectionIndex = OutputOffsets[NodeIndex] + OutputPinIndex;
+			if (OutputPinIndex >= 0 && ConnectionIndex < OutputOffsets[NodeIndex + 1])
+			{
+				return &OutputConnections[ConnectionIndex];
+			}
+		}
+
+		return nullptr;
+	}
+};
+
+// Custom Input and Custom Output nodes of the template asset, gathered once and shared by all its instances
+// Nodes are referenced by guid, so instances can resolve them in their own Nodes map
+struct FLOW_API FFlowCustomEventNodes
+{
+	// Event names in the Nodes order, names shared by multiple nodes are listed multiple times
+	TArray<FName> InputNames;
+	TArray<FName> OutputNames;
+
+	// The first node with the given event name
+	TMap<FName, FGuid> InputNodes;
+	TMap<FName, FGuid> OutputNodes;
+
+	// Unique input names in the lexical order, so the index of the event is the same on every machine loading the asset
+	TArray<FName> SortedInputNames;
+
+	void Gather(const TMap<FGuid, TObjectPtr<UFlowNode>>& Nodes);
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return InputNames.GetAllocatedSize() + OutputNames.GetAllocatedSize() + InputNodes.GetAllocatedSize() + OutputNodes.GetAllocatedSize()
+			+ SortedInputNames.GetAllocatedSize();
+	}
+};
+
 /**
  * Single asset containing flow nodes.
  */
@@ -75,14 +254,74 @@ public:
 	friend class FFlowNode_SubGraphDetails;
 	friend class UFlowGraphSchema;
 
+	friend struct FFlowBenchmarkGraphs;
+	friend class FFlowExecutionRecorder;
+	friend class FFlowLightweightProgram;
+	friend class FFlowAssetOptimizer;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow Asset")
 	FGuid AssetGuid;
 
+	// Instances with higher priority are resumed first, if queued pin activations had been carried over to the next frame
+	// See UFlowSettings::TriggerQueueFrameBudget
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
+	int32 ExecutionPriority;
+
+	// Number of finished instances kept by the Flow Subsystem for reuse, avoids creating objects every time this asset is instantiated
+	// Node instances are reused too, so nodes must reset their runtime state in Cleanup()
+	// 0 disables pooling
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset", meta = (ClampMin = 0))
+	int32 MaxPooledInstances;
+
+	// Root instances of this asset drain their trigger queue on worker threads, in parallel with other such instances
+	// Applies only if every node supports it (see UFlowNode::SupportsIsolatedExecution) and the instance doesn't replicate
+	// Pin activations always go through the trigger queue and are executed by the Flow Subsystem tick
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
+	bool bIsolatedExecution;
+
+	// Instance creates node instance the first time node is triggered or loaded from SaveGame, instead of all nodes on initialization
+	// Until then, instance contains the template node, which should be used only for read-only queries like IsOutputConnected
+	// Start and Custom Input nodes are always instantiated on initialization
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
+	bool bLazyNodeInstantiation;
+
+	// Cooked builds: instance and its nodes form a single GC cluster, so garbage collection doesn't analyze every node separately
+	// Applies only if every node returns true from UFlowNode::CanBeInInstanceCluster and has no AddOns, as clusters don't track references added later
+	// All nodes are instantiated on initialization then, the cluster is dissolved when the instance is deinitialized, i.e. before pooling it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
+	bool bClusterInstances;
+
 	// Set it to False, if this asset is instantiated as Root Flow for owner that doesn't live in the world
 	// This allows to SaveGame support works properly, if owner of Root Flow would be Game Instance or its subsystem
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
 	bool bWorldBound;
 
+	// Server instances owned by the Flow Component replicate their active nodes and SaveGame properties of nodes
+	// Clients can display the server state without running the graph, see UFlowComponent::IsNodeActiveOnServer
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Networking")
+	bool bReplicateInstanceState;
+
+	// Only cosmetic assets are instantiated on clients, if bCosmeticFlowsOnlyOnClients is enabled in Flow Settings
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Networking")
+	bool bCosmetic;
+
+	// Sub Graph nodes starting this asset are replaced with copies of its nodes while cooking, so no instance is created at runtime
+	// Meant for small utility graphs: reaching Finish doesn't finish other nodes, Custom Inputs work even before the Start
+	// Requires UFlowSettings::bOptimizeGraphsOnCook, see FFlowAssetOptimizer for the rest of the limitations
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sub Graph")
+	bool bInlineWhenCooked;
+
+	// Content soft-referenced by nodes of this asset and its Sub Graphs, gathered by the Flow Editor while cooking
+	// Allows requesting all content of the graph in one batch, see UFlowSubsystem::RequestContentDependencies
+	UPROPERTY()
+	TArray<FSoftObjectPath> ContentDependencies;
+
+	// Guids of nodes stripped while cooking, mapped to the node they were collapsed into or the invalid guid
+	// Written by FFlowAssetOptimizer, if UFlowSettings::bOptimizeGraphsOnCook is enabled
+	// Loading a SaveGame of the unoptimized graph skips records of stripped nodes, see LoadInstance
+	UPROPERTY()
+	TMap<FGuid, FGuid> StrippedNodeRedirects;
+
 //////////////////////////////////////////////////////////////////////////
 // Graph (editor-only)
 
@@ -95,9 +334,42 @@ public:
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	virtual void PostLoad() override;
+	virtual void PostEditUndo() override;
+
+	// Sub Graphs, node classes, gameplay tags and custom pins, see FFlowAssetRegistryTags
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+
+	// Requests the cooked CompiledGraph from the Derived Data Cache, cooker overlaps these requests across packages
+	virtual void BeginCacheForCookedPlatformData(const ITargetPlatform* TargetPlatform) override;
+	virtual bool IsCachedCookedPlatformDataLoaded(const ITargetPlatform* TargetPlatform) override;
+	virtual void ClearAllCachedCookedPlatformData() override;
 	// --
+
+private:
+	// Compiled graph versioned by CompiledGraphCacheVersion, bump it after changing the compilation, cook fix-ups or the optimizer
+	// Keyed on the saved package and pins of nodes, so it doesn't depend on the fix-ups applied later in PreSave
+	FString BuildCompiledGraphCacheKey() const;
+
+	FString CompiledGraphCacheKey;
+	uint32 CompiledGraphCacheHandle = 0;
+
+	// Serialized CompiledGraph found in the Derived Data Cache, saved instead of compiling the graph again
+	TArray<uint8> CachedCompiledGraphData;
 #endif	
 
+public:
+	// UObject
+	// Instance memory: runtime containers and, in the EstimatedTotal mode, node instances owned by this asset
+	// Template memory: also the CompiledGraph shared with all instances
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	// Cooked packages also contain the CompiledGraph, so cooked templates don't compile it on the first instantiation
+	virtual void Serialize(FArchive& Ar) override;
+	// --
+
+	// True if the graph is compiled or has been loaded from the cooked package
+	bool HasCompiledGraph() const { return CompiledGraph.IsValid(); }
+
 #if WITH_EDITORONLY_DATA
 public:
 	FSimpleDelegate OnDetailsRefreshRequested;
@@ -119,13 +391,23 @@ public:
 	// Returns whether the node class is allowed in this flow asset
 	bool IsNodeOrAddOnClassAllowed(const UClass* FlowNodeClass, FText* OutOptionalFailureReason = nullptr) const;
 
+	// Variant of IsNodeOrAddOnClassAllowed working on the Asset Registry tags, without loading the blueprint
+	bool IsNodeOrAddOnBlueprintAllowed(const FAssetData& BlueprintAssetData, const FFlowNodeBlueprintMetadata& Metadata, FText* OutOptionalFailureReason = nullptr) const;
+
 protected:
 	bool CanFlowNodeClassBeUsedByFlowAsset(const UClass& FlowNodeClass) const;
 	bool CanFlowAssetUseFlowNodeClass(const UClass& FlowNodeClass) const;
 	bool CanFlowAssetReferenceFlowNode(const UClass& FlowNodeClass, FText* OutOptionalFailureReason = nullptr) const;
+	bool CanFlowAssetReferenceFlowNode(const FAssetData& FlowNodeAssetData, FText* OutOptionalFailureReason = nullptr) const;
 
 	bool IsFlowNodeClassInAllowedClasses(const UClass& FlowNodeClass, const TSubclassOf<UFlowNodeBase>& RequiredAncestor = nullptr) const;
 	bool IsFlowNodeClassInDeniedClasses(const UClass& FlowNodeClass) const;
+
+	// Shared by classes and FFlowNodeBlueprintMetadata, anything providing IsChildOf(const UClass*)
+	template <typename TNodeClass>
+	bool IsFlowNodeClassInAllowedClasses_Impl(const TNodeClass& FlowNodeClass, const TSubclassOf<UFlowNodeBase>& RequiredAncestor) const;
+	template <typename TNodeClass>
+	bool IsFlowNodeClassInDeniedClasses_Impl(const TNodeClass& FlowNodeClass) const;
 #endif
 
 //////////////////////////////////////////////////////////////////////////
@@ -144,6 +426,11 @@ private:
 	UPROPERTY()
 	TMap<FGuid, TObjectPtr<UFlowNode>> Nodes;
 
+	// Reverse index of node Connections, maps the connected pin back to the node and pin that holds the connection
+	// For exec pins: input pin -> output pin triggering it, for data pins: output pin -> (first) input pin reading it
+	UPROPERTY()
+	TMap<FConnectedPin, FConnectedPin> ReverseConnections;
+
 #if WITH_EDITORONLY_DATA
 protected:
 	/**
@@ -173,10 +460,28 @@ public:
 	// Processes nodes and updates pin connections from the graph to the UFlowNode (processes all nodes in the graph if passed nullptr)
 	void HarvestNodeConnections(UFlowNode* TargetNode = nullptr);
 
+	// Harvests all nodes only if the graph might have changed since the last harvest of all nodes, i.e. on creating PIE instances
+	void HarvestNodeConnectionsIfNeeded();
+
+	// Called if graph pins changed without harvesting, i.e. while reconstructing nodes
+	void MarkFullHarvestPending() { bFullHarvestPending = true; }
+
+	// Template: patches instances running in PIE with the edited graph at the end of the frame, see PatchInstance
+	void SchedulePatchRunningInstances();
+
+	// Applies fix-ups of PostLoad and editor instancing to the cooked package, so cooked templates load without any of them
+	void ApplyCookFixups();
+
 	// Updates the auto-generated pins and bindings for a given FlowNode,
 	// returns true if any changes were made.
 	bool TryUpdateManagedFlowPinsForNode(UFlowNode& FlowNode);
 
+	// True inside FFlowAssetEditBatch, harvesting and node notifications are deferred until the batch ends
+	bool IsEditBatchActive() const { return EditBatchDepth > 0; }
+
+	// Called by the graph instead of refreshing itself while the batch is active
+	void MarkEditBatchGraphChanged() { bEditBatchGraphChanged = true; }
+
 protected:
 	void AddDataPinPropertyBindingToMap(
 		const FName& PinAuthoredName,
@@ -191,9 +496,43 @@ protected:
 		TArray<FFlowPin>* InOutDataPinsNext) const;
 
 	void HarvestFlowPinMetadataForProperty(const FProperty* Property, FFlowHarvestDataPinsWorkingData& InOutData);
+
+	// Properties of the class with any metadata read by HarvestFlowPinMetadataForProperty, in the TFieldIterator order
+	static const TArray<const FProperty*>& GetFlowPinMetadataProperties(const UClass& NativeClass);
+	static bool HasFlowPinMetadata(const FProperty& Property);
+
+private:
+	// Set until all nodes are harvested, harvesting a single node might leave connections of its neighbours outdated
+	bool bFullHarvestPending = true;
+
+	friend struct FFlowAssetEditBatch;
+
+	void BeginEditBatch();
+	void EndEditBatch();
+
+	FTSTicker::FDelegateHandle PatchInstancesTickerHandle;
+	bool PatchRunningInstances(float DeltaTime);
+
+	// Calls PostEditChange on the node, or defers it to the end of the edit batch
+	void NotifyNodeEdited(UFlowNode& FlowNode);
+
+	int32 EditBatchDepth = 0;
+	bool bEditBatchHarvestPending = false;
+	bool bEditBatchGraphChanged = false;
+	TSet<TWeakObjectPtr<UFlowNode>> EditBatchChangedNodes;
+
+	// Nodes of removed or moved Blueprint classes without redirectors are loaded as nulls
+	void RemoveInvalidNodes();
 #endif
 
 public:
+	// Rebuilds ReverseConnections from Connections of all nodes
+	void RebuildReverseConnections();
+
+	// Returns the node and pin holding connection to the given pin, see ReverseConnections
+	const FConnectedPin* FindReverseConnection(const FGuid& NodeGuid, const FName& PinName) const { return ReverseConnections.Find(FConnectedPin(NodeGuid, PinName)); }
+	bool HasReverseConnections() const { return !ReverseConnections.IsEmpty(); }
+
 	const TMap<FGuid, UFlowNode*>& GetNodes() const { return ObjectPtrDecay(Nodes); }
 	UFlowNode* GetNode(const FGuid& Guid) const { return Nodes.FindRef(Guid); }
 
@@ -216,6 +555,10 @@ public:
 	// Gathers all of the nodes that are connected to the Start & Custom Inputs of the flow graph
 	TArray<UFlowNode*> GatherNodesConnectedToAllInputs() const;
 
+	// Dense indices of nodes connected to the Start & Custom Inputs, in the execution order, precomputed once per template
+	// Empty until the graph is compiled on the first instantiation, see GetCompiledNode
+	TConstArrayView<int32> GetCompiledNodesInExecutionOrder(const UClass* NodeClass) const;
+
 	UFUNCTION(BlueprintPure, Category = "FlowAsset", meta = (DeterminesOutputType = "FlowNodeClass"))
 	TArray<UFlowNode*> GetNodesInExecutionOrder(UFlowNode* FirstIteratedNode, const TSubclassOf<UFlowNode> FlowNodeClass);
 
@@ -226,12 +569,31 @@ public:
 
 		if (FirstIteratedNode)
 		{
+			// iterating from the entry node of the compiled graph doesn't need to walk the graph
+			if (const FFlowCompiledNodeList* EntryNodes = FindCompiledEntryNodes(FirstIteratedNode, T::StaticClass()))
+			{
+				OutNodes.Reserve(OutNodes.Num() + EntryNodes->EntryNodesNum);
+				for (int32 Position = 0; Position < EntryNodes->EntryNodesNum; ++Position)
+				{
+					if (T* Node = Cast<T>(Nodes.FindRef(CompiledGraph->NodeGuids[EntryNodes->NodeIndices[Position]])))
+					{
+						OutNodes.Emplace(Node);
+					}
+				}
+				return;
+			}
+
 			TSet<TObjectKey<UFlowNode>> IteratedNodes;
 			GetNodesInExecutionOrder_Recursive(FirstIteratedNode, IteratedNodes, OutNodes);
 		}
 	}
 
 protected:
+	TArray<UFlowNode*> GatherNodesConnectedToAllInputs(int32& OutEntryNodesNum) const;
+
+	// Nodes of the class reachable from FirstIteratedNode, nullptr if the graph isn't compiled or FirstIteratedNode isn't its entry node
+	const FFlowCompiledNodeList* FindCompiledEntryNodes(const UFlowNode* FirstIteratedNode, const UClass* NodeClass) const;
+
 	template <class T>
 	void GetNodesInExecutionOrder_Recursive(UFlowNode* Node, TSet<TObjectKey<UFlowNode>>& IteratedNodes, TArray<T*>& OutNodes) const
 	{
@@ -251,6 +613,12 @@ protected:
 		}
 	}
 
+private:
+	// Template: lazily gathered, reset together with the compiled graph or after renaming the event of a node
+	mutable TSharedPtr<const FFlowCustomEventNodes> CustomEventNodes;
+
+	const FFlowCustomEventNodes& GetCustomEventNodes() const;
+
 public:	
 	UFlowNode_CustomInput* TryFindCustomInputNodeByEventName(const FName& EventName) const;
 	UFlowNode_CustomOutput* TryFindCustomOutputNodeByEventName(const FName& EventName) const;
@@ -258,6 +626,12 @@ public:
 	TArray<FName> GatherCustomInputNodeEventNames() const;
 	TArray<FName> GatherCustomOutputNodeEventNames() const;
 
+	// Compact network reference to the Custom Input, INDEX_NONE if there's no input of this name
+	int32 FindCustomInputIndex(const FName& EventName) const;
+	FName GetCustomInputName(const int32 InputIndex) const;
+
+	void InvalidateCustomEventNodes();
+
 #if WITH_EDITOR
 	const TArray<FName>& GetCustomInputs() const { return CustomInputs; }
 	const TArray<FName>& GetCustomOutputs() const { return CustomOutputs; }
@@ -281,24 +655,48 @@ private:
 #if WITH_EDITORONLY_DATA
 	TWeakObjectPtr<UFlowAsset> InspectedInstance;
 
+	// Lookups of the debugger instance picker, updated with ActiveInstances
+	TMap<FName, TWeakObjectPtr<UFlowAsset>> InstancesByDisplayName;
+	TMultiMap<TWeakObjectPtr<AActor>, TWeakObjectPtr<UFlowAsset>> InstancesByActorOwner;
+
 	// Message log for storing runtime errors/notes/warnings that will only last until the next game run
 	// Log lives in the asset template, so it can be inspected after ending the PIE
-	TSharedPtr<class FFlowMessageLog> RuntimeLog;
+	// Bounded by UFlowSettings::RuntimeLogMaxMessages, repeated messages are coalesced
+	TSharedPtr<class FFlowRuntimeMessageLog> RuntimeLog;
 #endif
 
 public:
 	void AddInstance(UFlowAsset* Instance);
 	int32 RemoveInstance(UFlowAsset* Instance);
 
+	// Removes many instances in a single pass, returns the number of instances left
+	int32 RemoveInstances(const TSet<const UFlowAsset*>& Instances);
+
 	void ClearInstances();
 	int32 GetInstancesNum() const { return ActiveInstances.Num(); }
 
+	// Summed EstimatedTotal resource size of all active instances of this template
+	SIZE_T GetInstancesResourceSize() const;
+
 #if WITH_EDITOR
 	void GetInstanceDisplayNames(TArray<TSharedPtr<FName>>& OutDisplayNames) const;
 
 	void SetInspectedInstance(const FName& NewInspectedInstanceName);
+	void SetInspectedInstance(UFlowAsset* NewInspectedInstance);
 	UFlowAsset* GetInspectedInstance() const { return InspectedInstance.IsValid() ? InspectedInstance.Get() : nullptr; }
 
+	const TArray<TObjectPtr<UFlowAsset>>& GetActiveInstances() const { return ActiveInstances; }
+	UFlowAsset* FindInstanceByDisplayName(const FName& DisplayName) const;
+
+	// Instance started by the actor or its component, the inspected one if the actor runs several instances of this template
+	UFlowAsset* FindInstanceByActorOwner(const AActor* ActorOwner) const;
+
+	// Instance is nullptr if the whole list changed
+	DECLARE_EVENT_TwoParams(UFlowAsset, FInstanceListChangedEvent, UFlowAsset* /*Instance*/, const bool /*bAdded*/);
+
+	FInstanceListChangedEvent& OnInstanceListChanged() { return InstanceListChangedEvent; }
+	FInstanceListChangedEvent InstanceListChangedEvent;
+
 	DECLARE_EVENT(UFlowAsset, FRefreshDebuggerEvent);
 
 	FRefreshDebuggerEvent& OnDebuggerRefresh() { return RefreshDebuggerEvent; }
@@ -309,9 +707,13 @@ public:
 	FRuntimeMessageEvent& OnRuntimeMessageAdded() { return RuntimeMessageEvent; }
 	FRuntimeMessageEvent RuntimeMessageEvent;
 
+	const FFlowRuntimeMessageLog* GetRuntimeLog() const { return RuntimeLog.Get(); }
+
 private:
 	void BroadcastDebuggerRefresh() const;
 	void BroadcastRuntimeMessageAdded(const TSharedRef<FTokenizedMessage>& Message) const;
+
+	void RemoveInstanceLookups(const UFlowAsset* Instance);
 #endif
 
 //////////////////////////////////////////////////////////////////////////
@@ -321,6 +723,11 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UFlowAsset> TemplateAsset;
 
+	uint64 InstanceId = 0;
+
+	// Cached on the template, so creating instances doesn't build the path string
+	mutable uint32 InstanceTemplateId = 0;
+
 	// Object that spawned Root Flow instance, i.e. World Settings or Player Controller
 	// This pointer is passed to child instances: Flow Asset instances created by the SubGraph nodes
 	TWeakObjectPtr<UObject> Owner;
@@ -331,15 +738,17 @@ protected:
 	// Flow Asset instances created by SubGraph nodes placed in the current graph
 	TMap<TWeakObjectPtr<UFlowNode_SubGraph>, TWeakObjectPtr<UFlowAsset>> ActiveSubGraphs;
 
-	// Optional entry points to the graph, similar to blueprint Custom Events
+	// Optional entry points to the graph, similar to blueprint Custom Events, by the event name
 	// Contains nodes only if it is initialized instance (see InitializeInstance, IsInstanceInitialized), empty otherwise
-	UPROPERTY()
-	TSet<TObjectPtr<UFlowNode_CustomInput>> CustomInputNodes;
+	// Node instances are referenced by the Nodes map, so it's safe to keep raw pointers here
+	TMultiMap<FName, UFlowNode_CustomInput*> CustomInputNodes;
 
+	// Nodes preloaded ahead of active nodes, see UFlowSettings::LookaheadPreloadDepth
 	UPROPERTY()
 	TSet<TObjectPtr<UFlowNode>> PreloadedNodes;
 
 	// Nodes that have any work left, not marked as Finished yet
+	// Unordered, every node keeps its slot index, so membership checks and removals are constant-time (see AddActiveNode)
 	UPROPERTY()
 	TArray<TObjectPtr<UFlowNode>> ActiveNodes;
 
@@ -347,14 +756,105 @@ protected:
 	UPROPERTY()
 	TArray<TObjectPtr<UFlowNode>> RecordedNodes;
 
+	// Node instances ordered by the dense node index of the CompiledGraph
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFlowNode>> CompiledNodes;
+
+	// Activation states of all nodes by the dense node index, a single allocation per instance reset in one pass
+	// Kept for nodes which aren't instantiated, so finished nodes released by HibernateInactiveNodes remember their state
+	TArray<EFlowNodeState> NodeStates;
+
+	void SetNodeState(const int32 NodeIndex, const EFlowNodeState NewState)
+	{
+		if (NodeStates.IsValidIndex(NodeIndex))
+		{
+			NodeStates[NodeIndex] = NewState;
+		}
+	}
+
+	// Template: lazily compiled on the first instantiation, reset if connections changed in editor
+	// Instance: shared with the template, so it stays valid even if the template recompiles
+	TSharedPtr<const FFlowCompiledGraph> CompiledGraph;
+
 	EFlowFinishPolicy FinishPolicy;
 
+	// Pending pin activations, executed in FIFO order, if UFlowSettings::bUseTriggerQueue is enabled
+	// Nodes are referenced by the Nodes map, so it's safe to keep raw pointers here
+	TArray<FFlowQueuedTrigger> TriggerQueue;
+	int32 TriggerQueueHead = 0;
+	bool bIsDrainingTriggerQueue = false;
+
+	// See BeginDeferredInputs
+	int32 DeferredInputsDepth = 0;
+
+	uint64 TriggerQueueFrame = 0;
+	int32 TriggersExecutedThisFrame = 0;
+
+	// Applied by the Flow Subsystem, paused instance keeps queued pin activations until it's resumed
+	EFlowSignificance SignificanceLevel = EFlowSignificance::Full;
+	float Significance = 1.0f;
+
+	// Trigger storm watchdog, see UFlowSettings::MaxTriggersPerInstancePerFrame
+	uint64 WatchdogFrame = 0;
+	int32 WatchdogTriggers = 0;
+	bool bTriggerStormDetected = false;
+	bool bAbortRequested = false;
+
+	// Returns false if the node input shouldn't be executed, because of the trigger storm response
+	bool CheckTriggerStorm(const UFlowNode& Node, const FName& PinName);
+	void AbortFromWatchdog();
+
+	// Set by UFlowSubsystem::TeardownRootFlows, which removes the torn down instances from the template in one pass
+	bool bTeardownBatched = false;
+
+	// See FFlowTelemetry::GetTime, zero if telemetry was disabled when the flow started
+	double TelemetryStartTime = 0.0;
+	bool bTelemetryFirstOutputRecorded = false;
+
+	// Resolved on initialization, see bIsolatedExecution
+	bool bCanExecuteIsolated = false;
+	bool bIsExecutingIsolated = false;
+	bool bIsolatedFinishRequested = false;
+
+	// Game thread work requested while draining the trigger queue on a worker thread, in the order of requests
+	TArray<TUniqueFunction<void()>> IsolatedSideEffects;
+
+	void UpdateCanExecuteIsolated();
+
+	// True if all nodes are instantiated, support isolated execution and have no AddOns
+	bool AreNodesSelfContained() const;
+
+	// Resolved on initialization, see bClusterInstances
+	bool bInstanceClusterRoot = false;
+
+	// True if all nodes are instantiated, can be in the cluster and have no AddOns
+	bool CanCreateInstanceCluster() const;
+
+	void CreateInstanceCluster();
+	void DissolveInstanceCluster();
+
 public:
+	// UObject
+	virtual bool CanBeClusterRoot() const override { return bInstanceClusterRoot; }
+	// --
+
 	UE_DEPRECATED(5.4, "Use version that takes a UFlowAssetReference instead.")
 	virtual void InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlowAsset* InTemplateAsset) { InitializeInstance(InOwner, *InTemplateAsset); }
 
 	virtual void InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlowAsset& InTemplateAsset);
 	virtual void DeinitializeInstance();
+
+#if WITH_EDITOR
+	// Applies edits of the template made during PIE, without restarting the instance or losing its active nodes
+	// Instantiated nodes get edited properties, pins and connections of the template node, new nodes are added and removed nodes are deactivated
+	void PatchInstance();
+
+private:
+	// Copies editable properties except SaveGame ones, which hold the runtime state, and instanced references owned by the template
+	static void PatchNodeInstance(UFlowNode& NodeInstance, const UFlowNode& TemplateNode);
+
+public:
+#endif
 	bool IsInstanceInitialized() const { return IsValid(TemplateAsset); }
 
 	UFlowAsset* GetTemplateAsset() const { return TemplateAsset; }
@@ -394,18 +894,180 @@ protected:
 
 	void TriggerInput(const FGuid& NodeGuid, const FName& PinName);
 
+	// Triggers whatever is connected to the given output pin of the node, using the CompiledGraph if possible
+	void TriggerConnectedInput(const UFlowNode& FromNode, const int32 OutputPinIndex);
+
+	// Executes the input immediately or pushes it to the trigger queue, depending on UFlowSettings::bUseTriggerQueue
+	void TriggerNodeInput(UFlowNode& Node, const FName& PinName, const bool bIsKnownPin);
+	void ExecuteNodeInput(UFlowNode& Node, const FName& PinName, const bool bIsKnownPin);
+
+public:
+	// Iteratively executes queued pin activations, until the queue is empty or the per-frame limit is reached
+	void DrainTriggerQueue();
+	bool HasQueuedTriggers() const { return TriggerQueueHead < TriggerQueue.Num(); }
+
+	// Inputs triggered until the paired EndDeferredInputs are pushed to the trigger queue and drained by the Flow Subsystem in the next frame
+	// Used to move execution out of external callbacks, i.e. Sequencer evaluation, regardless of UFlowSettings::bUseTriggerQueue
+	void BeginDeferredInputs() { ++DeferredInputsDepth; }
+	void EndDeferredInputs() { check(DeferredInputsDepth > 0); --DeferredInputsDepth; }
+
+	// True if the Flow Subsystem can drain the trigger queue of this instance on a worker thread
+	bool CanExecuteIsolated() const;
+	bool IsExecutingIsolated() const { return bIsExecutingIsolated; }
+
+	// Drains the trigger queue on a worker thread, touching only this instance, must be followed by FlushIsolatedSideEffects
+	void DrainIsolatedTriggerQueue();
+
+	// Executes game thread work requested by the isolated drain
+	void FlushIsolatedSideEffects();
+
+	// Executes the function immediately, or after the isolated drain on the game thread
+	void DeferIsolatedSideEffect(TUniqueFunction<void()>&& SideEffect);
+
+	// Asset's ExecutionPriority adjusted by the owner, if it implements IFlowOwnerInterface
+	virtual int32 GetExecutionPriority() const;
+
+protected:
+	void ClearTriggerQueue();
+
+	const FFlowCompiledGraph& GetOrCompileGraph();
+	void InvalidateCompiledGraph();
+
+	UFlowNode* InstantiateNode(TObjectPtr<UFlowNode>& Node);
+	UFlowNode* CreateNodeInstance(TObjectPtr<UFlowNode>& Node);
+
+	// Duplicates all template nodes into this uninitialized instance, used to warm up pooled instances
+	void CreateNodeInstances();
+
+	UFlowNode* GetOrCreateCompiledNodeInstance(const int32 NodeIndex);
+
+	// Preloads nodes reachable within LookaheadPreloadDepth from active nodes, flushes the ones left behind
+	void UpdateLookaheadPreload();
+
+	// Flushes preloaded node of this instance, unless it's active
+	bool FlushPreloadedNode(UFlowNode* Node);
+
+	// Node instance can be replaced with the template node while the instance is idle, see HibernateInactiveNodes
+	bool CanHibernateNode(const UFlowNode& Node) const;
+
+	// Time of the last input triggered in this instance, see UFlowSettings::InstanceHibernationDelay
+	double LastTriggerTime = 0.0;
+
+	// Set after releasing nodes, cleared by the next triggered input
+	bool bNodesHibernated = false;
+
+public:
+	// Releases inactive node instances opted in by UFlowNode::CanHibernate, except preloaded nodes, entry points and data suppliers
+	// Released nodes are instantiated again from the template when triggered, only their activation state is kept (see NodeStates)
+	// Requires bLazyNodeInstantiation, returns the number of released nodes
+	int32 HibernateInactiveNodes();
+
+	bool AreNodesHibernated() const { return bNodesHibernated; }
+
+	// Advances timers of this instance and its active Sub Graphs by DeltaTime in one pass, i.e. to catch up after hibernation or the offline time
+	// Step and Completed outputs of Timer nodes fire in order during this call, without waiting for the world tick. Returns the number of fired timers
+	// Instances are advanced one after another, Sub Graphs started meanwhile aren't advanced
+	UFUNCTION(BlueprintCallable, Category = "Flow")
+	int32 FastForward(const float DeltaTime);
+
+	EFlowSignificance GetSignificanceLevel() const { return SignificanceLevel; }
+	float GetSignificance() const { return Significance; }
+	bool HasQueuedTriggers() const { return TriggerQueueHead < TriggerQueue.Num(); }
+	double GetLastTriggerTime() const { return LastTriggerTime; }
+
+public:
+	// Returns node instance, creates it if instance uses lazy node instantiation and the node hasn't been instantiated yet
+	UFlowNode* GetOrCreateNodeInstance(const FGuid& NodeGuid);
+
+	// False if instance still contains the template node, see bLazyNodeInstantiation
+	bool IsNodeInstantiated(const UFlowNode* Node) const { return Node && Node->GetOuter() == this; }
+
+	// Dense index of the node in the compiled graph, used to replicate node state compactly
+	int32 GetCompiledNodeIndex(const FGuid& NodeGuid);
+	UFlowNode* GetCompiledNode(const int32 NodeIndex) const { return CompiledNodes.IsValidIndex(NodeIndex) ? CompiledNodes[NodeIndex].Get() : nullptr; }
+
+	// Doesn't instantiate the node, NeverActivated for invalid index
+	EFlowNodeState GetCompiledNodeState(const int32 NodeIndex) const { return NodeStates.IsValidIndex(NodeIndex) ? NodeStates[NodeIndex] : EFlowNodeState::NeverActivated; }
+	int32 GetCompiledNodesNum() const { return CompiledNodes.Num(); }
+
+//////////////////////////////////////////////////////////////////////////
+// Lightweight instances
+
+private:
+	// Template: lazily compiled, reset together with the compiled graph or after editing a node
+	TSharedPtr<const FFlowLightweightProgram> LightweightProgram;
+	bool bLightweightProgramCompiled = false;
+
+	// Template: compiled on the first fork, unsupported nodes are stubs
+	TSharedPtr<const FFlowLightweightProgram> SpeculativeProgram;
+
+public:
+	// Template: executes this graph for plain per-entity states instead of UObject instances, nullptr if any node isn't supported
+	TSharedPtr<const FFlowLightweightProgram> GetLightweightProgram();
+	void InvalidateLightweightProgram();
+
+	// Template: program for the speculative evaluation, nodes with side effects are stubs reported as FFlowLightweightEvent::IsStub
+	TSharedPtr<const FFlowLightweightProgram> GetSpeculativeProgram();
+
+	// Instance: captures the state of this instance for the speculative program of the template, the basis of any number of FFlowLightweightFork
+	// Nothing executed on the forks affects this instance, returns nullptr if the instance isn't initialized
+	TSharedPtr<const FFlowLightweightProgram> CaptureSpeculativeState(FFlowLightweightState& OutState) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Replicated state
+
+private:
+	// Server component replicating this instance, see bReplicateInstanceState
+	TWeakObjectPtr<UFlowComponent> ReplicatingComponent;
+
+	// Nodes changed since the state has been replicated, by the dense node index
+	TSet<int32> DirtyReplicatedNodes;
+
+	void MarkReplicatedNodeDirty(const int32 NodeIndex);
+
+public:
+	bool IsReplicatingState() const { return ReplicatingComponent.IsValid(); }
+	TSet<int32> TakeDirtyReplicatedNodes() { return MoveTemp(DirtyReplicatedNodes); }
+
+protected:
 	void FinishNode(UFlowNode* Node);
+
+	// Called after the node able to finish the graph has finished
+	void FinishGraph();
 	void ResetNodes();
 
+	// Returns true if node wasn't active yet
+	bool AddActiveNode(UFlowNode& Node);
+
+	// Returns true if node was active
+	bool RemoveActiveNode(UFlowNode& Node);
+
+	void ClearActiveNodes();
+
 #if !UE_BUILD_SHIPPING
 public:	
 	FFlowSignalEvent OnPinTriggered;
 #endif
+
+private:
+	// Resolved once per instance, see bLeanDedicatedServer
+	bool bLeanServerInstance = false;
+
+public:
+	// True if this instance skips pin records, debugger hooks and on-screen messages
+	bool IsLeanServerInstance() const { return FLOW_LEAN_SERVER || bLeanServerInstance; }
 	
 public:
 	UFlowSubsystem* GetFlowSubsystem() const;
 	FName GetDisplayName() const;
 
+	// Identifies the instance within its Flow Subsystem and in the SaveGame, zero if this isn't an initialized instance
+	// Template id in the high 32 bits, serial in the low 32 bits, see UFlowSubsystem::FindInstanceById
+	uint64 GetInstanceId() const { return InstanceId; }
+
+	// Hash of the template path, stable between sessions
+	uint32 GetInstanceTemplateId() const;
+
 	UFlowNode_SubGraph* GetNodeOwningThisAssetInstance() const;
 	UFlowAsset* GetParentInstance() const;
 
@@ -413,6 +1075,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Flow")
 	bool IsActive() const { return ActiveNodes.Num() > 0; }
 
+	bool IsNodeActive(const UFlowNode& Node) const
+	{
+		return ActiveNodes.IsValidIndex(Node.ActiveNodeIndex) && ActiveNodes[Node.ActiveNodeIndex] == &Node;
+	}
+
 	// Returns nodes that have any work left, not marked as Finished yet
 	UFUNCTION(BlueprintPure, Category = "Flow")
 	const TArray<UFlowNode*>& GetActiveNodes() const { return ActiveNodes; }
@@ -421,12 +1088,63 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Flow")
 	const TArray<UFlowNode*>& GetRecordedNodes() const { return RecordedNodes; }
 
+#if WITH_EDITOR
+protected:
+	// Last activation time of connected outputs, by the node guid and the output pin index
+	TMap<FGuid, TMap<uint8, double>> WireRecords;
+
+	// Incremented on every change of WireRecords, so the graph editor rebuilds highlighted wires only if needed
+	uint32 WireRecordsVersion = 0;
+
+public:
+	void RecordWire(const UFlowNode& Node, const int32 OutputPinIndex);
+
+	const TMap<FGuid, TMap<uint8, double>>& GetWireRecords() const { return WireRecords; }
+	uint32 GetWireRecordsVersion() const { return WireRecordsVersion; }
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// Data pin memoization
+
+protected:
+	// Values supplied by nodes of this instance during the current trigger chain, see UFlowSettings::bMemoizeDataPinValues
+	TMap<TPair<const UFlowNode*, FName>, FInstancedStruct> DataPinMemo;
+	int32 DataPinMemoScopeDepth = 0;
+
+	void BeginDataPinMemoScope();
+	void EndDataPinMemoScope();
+
+public:
+	// Called before the supplier executes or when it marks its data pin dirty, its outputs might change
+	void InvalidateDataPinMemo(const UFlowNode& SupplierNode);
+
+	bool IsDataPinMemoActive() const { return DataPinMemoScopeDepth > 0; }
+
+	template <typename TFlowDataPinResultType>
+	const TFlowDataPinResultType* FindMemoizedDataPinValue(const UFlowNode& SupplierNode, const FName& PinName) const
+	{
+		const FInstancedStruct* Memoized = DataPinMemo.Find(TPair<const UFlowNode*, FName>(&SupplierNode, PinName));
+		return Memoized ? Memoized->GetPtr<TFlowDataPinResultType>() : nullptr;
+	}
+
+	template <typename TFlowDataPinResultType>
+	void MemoizeDataPinValue(const UFlowNode& SupplierNode, const FName& PinName, const TFlowDataPinResultType& Value)
+	{
+		DataPinMemo.Add(TPair<const UFlowNode*, FName>(&SupplierNode, PinName), FInstancedStruct::Make(Value));
+	}
+
 //////////////////////////////////////////////////////////////////////////
 // Expected Owner Class support (for use with CallOwnerFunction nodes)
 
 public:
 	UClass* GetExpectedOwnerClass() const { return ExpectedOwnerClass; }
 
+	// Owner resolved at InitializeInstance, see UFlowNodeBase::GetFlowOwnerInterface
+	IFlowOwnerInterface* GetFlowOwnerInterface() const { return FlowOwnerInterfaceObject.IsValid() ? FlowOwnerInterface : nullptr; }
+
+	// Owner as an Actor, or the Actor owning the component Owner, resolved at InitializeInstance
+	AActor* GetRootFlowActorOwner() const { return Owner.IsValid() ? RootFlowActorOwner.Get() : nullptr; }
+
 protected:
 	// Expects to be owned (at runtime) by an object with this class (or one of its subclasses)
 	// NOTE - If the class is an AActor, and the flow asset is owned by a component,
@@ -434,6 +1152,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Flow", meta = (MustImplement = "/Script/Flow.FlowOwnerInterface"))
 	TSubclassOf<UObject> ExpectedOwnerClass;
 
+	// Owner doesn't change during the instance lifetime, so nodes don't repeat the class checks and casts
+	IFlowOwnerInterface* FlowOwnerInterface = nullptr;
+	TWeakObjectPtr<UObject> FlowOwnerInterfaceObject;
+	TWeakObjectPtr<AActor> RootFlowActorOwner;
+
+	void ResolveFlowOwner();
+	void ResetFlowOwner();
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame support
 
@@ -444,9 +1170,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
 	void LoadInstance(const FFlowAssetSaveData& AssetRecord);
 
+	// Records the same data as SaveInstance() without calling OnSave() hooks or updating data reused by the incremental SaveGame
+	// Meant for frequent snapshots, i.e. replays, where the game doesn't expect its save logic to run
+	FFlowAssetSaveData SnapshotInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances);
+
+	// Game thread part of SaveInstance(), calls OnSave() hooks and adds placeholder records of this instance and its SubGraphs
+	void PrepareSaveInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances, TArray<FFlowAssetPendingSave>& OutPendingSaves, const bool bSnapshot = false);
+
+	// Fills the placeholder record, doesn't call Blueprint code so it can run on a worker thread
+	void SerializeSaveInstance(const FFlowAssetPendingSave& PendingSave);
+
+	// Forces the next SaveInstance() to serialize the asset, called by nodes whenever their state changes
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	void MarkSaveDataDirty();
+
+	bool IsSaveDataDirty() const { return bSaveDataDirty; }
+
+	// Tables shared by the asset and its nodes, nullptr if the data is written or was loaded with names as strings
+	FFlowSaveDataTables* GetSaveDataTablesForSave();
+	FFlowSaveDataTables* GetSaveDataTablesForLoad();
+
+	// Template counterpart of the instance or its node, if the save data is written as a delta against the template
+	UObject* GetSaveDataDeltaArchetype(const UObject* InstancedObject) const;
+	bool IsLoadingDeltaSaveData() const { return bLoadedDeltaSaveData; }
+
 protected:
 	virtual void OnActivationStateLoaded(UFlowNode* Node);
 
+	// Return false if the asset's SaveGame data changes while none of its nodes is updated
+	virtual bool CanReuseSaveData() const;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "SaveGame")
 	void OnSave();
 
@@ -457,6 +1210,16 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "SaveGame")
 	bool IsBoundToWorld();
 
+private:
+	// Serialized data from the previous save, reused by the incremental SaveGame
+	TArray<uint8> CachedSaveData;
+	bool bSaveDataDirty = true;
+
+	// Only grows during the instance lifetime, so cached data of nodes stays valid
+	FFlowSaveDataTables SaveDataTables;
+	EFlowSaveDataFormat LoadedSaveDataFormat = EFlowSaveDataFormat::NameAsString;
+	bool bLoadedDeltaSaveData = false;
+
 //////////////////////////////////////////////////////////////////////////
 // Utils
 
@@ -0,0 +1,48 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Templates/Function.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+class FAssetRegistryTagsContext;
+
+/**
+ * Dependencies of the Flow Asset, stored as Asset Registry tags on saving the asset
+ * Tools and runtime systems can find assets referencing a Sub Graph, a node class or a gameplay tag from FAssetData alone, without loading them
+ */
+struct FLOW_API FFlowAssetRegistryTags
+{
+	// Assets started by Sub Graph nodes
+	TArray<FSoftObjectPath> SubGraphs;
+
+	// Classes of nodes and AddOns
+	TArray<FTopLevelAssetPath> NodeClasses;
+
+	// Tags held by properties of nodes and AddOns, i.e. Identity Tags of observers and Notify Tags
+	FGameplayTagContainer GameplayTags;
+
+	TArray<FName> CustomInputs;
+	TArray<FName> CustomOutputs;
+
+#if WITH_EDITOR
+	void AddAssetRegistryTags(FAssetRegistryTagsContext Context) const;
+#endif
+
+	// Returns false if the asset has been saved without the tags, it has to be loaded then
+	static bool FromAssetData(const FAssetData& AssetData, FFlowAssetRegistryTags& OutTags);
+
+	// Flow Assets known to the Asset Registry whose tags pass the predicate, assets saved without the tags are skipped
+	static void FindAssets(TFunctionRef<bool(const FAssetData& AssetData, const FFlowAssetRegistryTags& Tags)> Predicate, TArray<FAssetData>& OutAssets);
+
+	static void FindAssetsReferencingSubGraph(const FSoftObjectPath& SubGraph, TArray<FAssetData>& OutAssets);
+
+	// Exact class, subclasses aren't matched
+	static void FindAssetsUsingNodeClass(const UClass* NodeClass, TArray<FAssetData>& OutAssets);
+
+	// Parent tag matches also assets using its child tags
+	static void FindAssetsUsingGameplayTag(const FGameplayTag& Tag, TArray<FAssetData>& OutAssets);
+};
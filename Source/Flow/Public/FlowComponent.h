@@ -4,6 +4,8 @@
 
 #include "Components/ActorComponent.h"
 #include "GameplayTagContainer.h"
+#include "Containers/Ticker.h"
+#include "Net/Serialization/FastArraySerializer.h"
 
 #include "FlowSave.h"
 #include "FlowTypes.h"
@@ -11,28 +13,326 @@
 #include "FlowComponent.generated.h"
 
 class UFlowAsset;
+class UFlowComponent;
+class UFlowNode;
 class UFlowSubsystem;
 
+UENUM()
+enum class EFlowNotifyType : uint8
+{
+	ToGraph,	// NotifyGraph, BulkNotifyGraph
+	FromGraph,	// NotifyFromGraph
+	ToActor,	// NotifyActor
+	Received	// NotifyActor replicated by the receiving component, see UFlowSettings::bReplicateActorNotifiesByReceiver
+};
+
+UENUM(BlueprintType)
+enum class EFlowNotifyThrottleMode : uint8
+{
+	LatestWins,	// notifies over the limit are dropped, the latest one is sent once the interval passes
+	Accumulate	// notifies over the limit are merged into one sent once the interval passes, carrying their count
+};
+
+/** Limits how often notifies matching the tag are sent by the component, see UFlowComponent::NotifyThrottles */
+USTRUCT(BlueprintType)
+struct FFlowNotifyThrottle
+{
+	GENERATED_BODY()
+
+	// Child tags are throttled separately
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
+	FGameplayTag NotifyTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow", meta = (ClampMin = 0.1))
+	float MaxNotifiesPerSecond = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
+	EFlowNotifyThrottleMode Mode = EFlowNotifyThrottleMode::LatestWins;
+};
+
+/** Single notify sent by the server, replicated as an element of FFlowNotifyRing */
 USTRUCT()
-struct FNotifyTagReplication
+struct FFlowNotifyItem : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
+	UPROPERTY()
+	EFlowNotifyType Type = EFlowNotifyType::ToGraph;
+
+	// Only used by ToActor notifies
 	UPROPERTY()
 	FGameplayTag ActorTag;
 
 	UPROPERTY()
-	FGameplayTag NotifyTag;
+	FGameplayTagContainer NotifyTags;
+
+	// Only used by Received notifies, null if the sender isn't relevant to the client
+	UPROPERTY()
+	TObjectPtr<UFlowComponent> Sender = nullptr;
+
+	// Increases with every notify of the component, clients deliver notifies in this order
+	UPROPERTY()
+	int32 Sequence = 0;
+
+	// Number of throttled notifies merged into this one, see EFlowNotifyThrottleMode::Accumulate
+	UPROPERTY()
+	int32 Count = 1;
+};
+
+/**
+ * Recent notifies of the component, replicated as the delta of added notifies
+ * Any number of notifies sent in one net update is delivered in order, the oldest ones are dropped once the ring is full
+ * Clients joining later receive notifies still kept in the ring
+ */
+USTRUCT()
+struct FLOW_API FFlowNotifyRing : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	static constexpr int32 Capacity = 16;
 
-	FNotifyTagReplication() {}
+	UPROPERTY()
+	TArray<FFlowNotifyItem> Items;
+
+	// Assigned by UFlowComponent::BindReplicatedArrays, as the constructor value is overwritten by the archetype copy
+	UFlowComponent* OwnerComponent = nullptr;
+
+	// Server: sequence of the last added notify, client: sequence of the last delivered notify
+	int32 LastSequence = 0;
+
+	// Client: notifies received with the initial state were sent before the component became relevant, so they aren't delivered
+	bool bReceivedInitialState = false;
 
-	FNotifyTagReplication(const FGameplayTag& InActorTag, const FGameplayTag& InNotifyTag)
-		: ActorTag(InActorTag)
-		, NotifyTag(InNotifyTag)
+	// Server: notifies of the same kind sent in one frame are merged into a single item, unless it would collapse the repeated tag
+	uint64 LastNotifyFrame = 0;
+
+	void AddNotify(const EFlowNotifyType Type, const FGameplayTagContainer& NotifyTags, const FGameplayTag& ActorTag = FGameplayTag(), UFlowComponent* Sender = nullptr, const int32 Count = 1);
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize);
+
+	// Measures replicated bytes, see the FlowNetworking CSV category
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowNotifyRing> : public TStructOpsTypeTraitsBase2<FFlowNotifyRing>
+{
+	enum
 	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+USTRUCT()
+struct FFlowIdentityTagItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag Tag;
+};
+
+/**
+ * Replicated copy of the component's Identity Tags, sent as the delta of added and removed tags
+ * Tags are serialized by their net index, see FGameplayTag::NetSerialize
+ */
+USTRUCT()
+struct FLOW_API FFlowIdentityTagArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlowIdentityTagItem> Items;
+
+	// Assigned by UFlowComponent::BindReplicatedArrays, as the constructor value is overwritten by the archetype copy
+	UFlowComponent* OwnerComponent = nullptr;
+
+	// Server: updates items to match the container
+	void SyncTags(const FGameplayTagContainer& Tags);
+
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, const int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	// Measures replicated bytes, see the FlowNetworking CSV category
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+private:
+	// Client: changes received in the current update, applied once it's complete
+	FGameplayTagContainer ReceivedAddedTags;
+	FGameplayTagContainer ReceivedRemovedTags;
+
+	// Client: the first update is compared with the tags set on the component, as these might have changed on the server before replication started
+	bool bReceivedInitialState = false;
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowIdentityTagArray> : public TStructOpsTypeTraitsBase2<FFlowIdentityTagArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Active nodes of the Flow Asset instance running on the server, see UFlowAsset::bReplicateInstanceState */
+USTRUCT()
+struct FFlowReplicatedInstanceState : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UFlowAsset> TemplateAsset = nullptr;
+
+	// Bit per node, by the dense node index of the compiled graph
+	UPROPERTY()
+	TArray<uint8> ActiveNodes;
+
+	bool IsNodeActive(const int32 NodeIndex) const
+	{
+		return NodeIndex >= 0 && ActiveNodes.IsValidIndex(NodeIndex / 8) && (ActiveNodes[NodeIndex / 8] & (1 << (NodeIndex % 8))) != 0;
 	}
 };
 
+/** SaveGame properties of the node instance running on the server, resent only if these changed */
+USTRUCT()
+struct FFlowReplicatedNodeState : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UFlowAsset> TemplateAsset = nullptr;
+
+	UPROPERTY()
+	int32 NodeIndex = INDEX_NONE;
+
+	UPROPERTY()
+	TArray<uint8> NodeData;
+};
+
+USTRUCT()
+struct FLOW_API FFlowReplicatedInstanceArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlowReplicatedInstanceState> Items;
+
+	// Assigned by UFlowComponent::BindReplicatedArrays, as the constructor value is overwritten by the archetype copy
+	UFlowComponent* OwnerComponent = nullptr;
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, const int32 FinalSize);
+
+	// Measures replicated bytes, see the FlowNetworking CSV category
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowReplicatedInstanceArray> : public TStructOpsTypeTraitsBase2<FFlowReplicatedInstanceArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+USTRUCT()
+struct FLOW_API FFlowReplicatedNodeArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlowReplicatedNodeState> Items;
+
+	// Assigned by UFlowComponent::BindReplicatedArrays, as the constructor value is overwritten by the archetype copy
+	UFlowComponent* OwnerComponent = nullptr;
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, const int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, const int32 FinalSize);
+
+	// Measures replicated bytes, see the FlowNetworking CSV category
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowReplicatedNodeArray> : public TStructOpsTypeTraitsBase2<FFlowReplicatedNodeArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Slice of the replay snapshot, see FFlowReplayStateArray */
+USTRUCT()
+struct FFlowReplayStateChunk : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ChunkIndex = 0;
+
+	UPROPERTY()
+	TArray<uint8> Data;
+};
+
+/**
+ * Replay snapshot of the Root Flow split into chunks, so it stays under net.MaxRepArraySize and net.MaxRepArrayMemory
+ * Only chunks which changed since the previous snapshot are recorded again
+ */
+USTRUCT()
+struct FLOW_API FFlowReplayStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	// Bytes per chunk, below the array limits of the replicated Data
+	static constexpr int32 ChunkSize = 1024;
+
+	UPROPERTY()
+	TArray<FFlowReplayStateChunk> Items;
+
+	// Assigned by UFlowComponent::BindReplicatedArrays, as the constructor value is overwritten by the archetype copy
+	UFlowComponent* OwnerComponent = nullptr;
+
+	// Server: splits the state into chunks, marking only the changed ones dirty
+	void SetState(const TArray<uint8>& State);
+
+	// Replay: joins chunks in order
+	void GetState(TArray<uint8>& OutState) const;
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	// Measures replicated bytes, see the FlowNetworking CSV category
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowReplayStateArray> : public TStructOpsTypeTraitsBase2<FFlowReplayStateArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Custom Input of the Root Flow triggered by the owning client, sent to the server in batches, see UFlowComponent::TriggerRootFlowCustomInputOnServer */
+USTRUCT()
+struct FFlowClientCustomInput
+{
+	GENERATED_BODY()
+
+	// Resolved to the server instance of this asset, started by the same component
+	UPROPERTY()
+	TObjectPtr<UFlowAsset> TemplateAsset = nullptr;
+
+	// See UFlowAsset::FindCustomInputIndex
+	UPROPERTY()
+	uint16 InputIndex = 0;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FFlowComponentStateReplicated, class UFlowComponent*, const UFlowAsset*);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFlowComponentTagsReplicated, class UFlowComponent*, FlowComponent, const FGameplayTagContainer&, CurrentTags);
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FFlowComponentNotify, class UFlowComponent*, const FGameplayTag&);
@@ -47,15 +347,39 @@ class FLOW_API UFlowComponent : public UActorComponent, public IFlowOwnerInterfa
 	GENERATED_UCLASS_BODY()
 
 	friend class UFlowSubsystem;
+	friend struct FFlowIdentityTagArray;
+	friend struct FFlowNotifyRing;
+	friend struct FFlowRegistryBenchmark;
+	friend struct FFlowReplayStateArray;
+	friend struct FFlowReplicatedInstanceArray;
+	friend struct FFlowReplicatedNodeArray;
 	
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-	
+	virtual void PostInitProperties() override;
+	virtual void OnRegister() override;
+
+private:
+	// Points replicated arrays back to this component, the pointers copied from the archetype point to the archetype
+	void BindReplicatedArrays();
+
+public:
 //////////////////////////////////////////////////////////////////////////
 // Identity Tags
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_IdentityTags, Category = "Flow")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
 	FGameplayTagContainer IdentityTags;
 
+	// Component is needed by cosmetic Flow Assets, so it's registered also by the cosmetic-only client Flow Subsystem
+	// Components with a cosmetic Root Flow are always treated as cosmetic
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
+	bool bCosmetic;
+
+	bool IsCosmetic() const;
+
+	// Replicates changes of Identity Tags, instead of resending the whole container
+	UPROPERTY(Replicated)
+	FFlowIdentityTagArray ReplicatedIdentityTags;
+
 public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -72,14 +396,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Flow")
 	void RemoveIdentityTags(FGameplayTagContainer Tags, const EFlowNetMode NetMode = EFlowNetMode::Authority);
 
+	// Changes whenever Identity Tags are added or removed at runtime, lets the cached results depending on tags detect changes
+	uint32 GetIdentityTagsVersion() const { return IdentityTagsVersion; }
+
+private:
+	uint32 IdentityTagsVersion = 0;
+
 protected:
 	void RegisterWithFlowSubsystem();
 	void UnregisterWithFlowSubsystem();
 	virtual void BeginRootFlow(bool bComponentLoadedFromSaveGame);
 
+public:
+	// Applies tag changes coalesced in this frame immediately, see UFlowSettings::bCoalesceIdentityTagChanges
+	void CommitIdentityTagChanges();
+
 private:
-	UFUNCTION()
-	void OnRep_IdentityTags(const FGameplayTagContainer& PreviousTags);
+	bool IsCoalescingIdentityTagChanges() const;
+	void QueueIdentityTagChanges(const FGameplayTagContainer& Tags, const bool bAdded);
+
+	// Changes not reported to the registry and delegates yet, Identity Tags already contain them
+	FGameplayTagContainer PendingAddedIdentityTags;
+	FGameplayTagContainer PendingRemovedIdentityTags;
+	FTSTicker::FDelegateHandle IdentityTagsCommitHandle;
+
+	void ReplicateIdentityTags();
+	void OnIdentityTagsReplicated(const FGameplayTagContainer& AddedTags, const FGameplayTagContainer& RemovedTags);
 
 public:
 	UPROPERTY(BlueprintAssignable, Category = "Flow")
@@ -94,12 +436,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Flow")
 	void LogError(FString Message, const EFlowOnScreenMessageType OnScreenMessageType = EFlowOnScreenMessageType::Permanent) const;
 
+//////////////////////////////////////////////////////////////////////////
+// Replicated notifies
+
+private:
+	// Notifies sent by the server, replaces replicating the most recent notify only
+	UPROPERTY(Replicated)
+	FFlowNotifyRing ReplicatedNotifies;
+
+	void ReplicateNotify(const EFlowNotifyType Type, const FGameplayTagContainer& NotifyTags, const FGameplayTag& ActorTag = FGameplayTag(), UFlowComponent* Sender = nullptr, const int32 Count = 1);
+	void OnNotifyReplicated(const FFlowNotifyItem& Notify);
+
 //////////////////////////////////////////////////////////////////////////
 // Component sending Notify Tags to Flow Graph, or any other listener
 
 private:
 	// Stores only recently sent tags
-	UPROPERTY(ReplicatedUsing = OnRep_SentNotifyTags)
+	UPROPERTY()
 	FGameplayTagContainer RecentlySentNotifyTags;
 
 public:
@@ -116,8 +469,8 @@ public:
 	void BulkNotifyGraph(const FGameplayTagContainer NotifyTags, const EFlowNetMode NetMode = EFlowNetMode::Authority);
 
 private:
-	UFUNCTION()
-	void OnRep_SentNotifyTags();
+	void SendNotifyGraph(const FGameplayTagContainer& NotifyTags, const int32 Count = 1);
+	void BroadcastSentNotifyTags();
 
 public:
 	FFlowComponentNotify OnNotifyFromComponent;
@@ -125,39 +478,57 @@ public:
 //////////////////////////////////////////////////////////////////////////
 // Component receiving Notify Tags from Flow Graph
 
-private:
-	// Stores only recently replicated tags
-	UPROPERTY(ReplicatedUsing = OnRep_NotifyTagsFromGraph)
-	FGameplayTagContainer NotifyTagsFromGraph;
-
 public:
 	virtual void NotifyFromGraph(const FGameplayTagContainer& NotifyTags, const EFlowNetMode NetMode = EFlowNetMode::Authority);
 
-private:
-	UFUNCTION()
-	void OnRep_NotifyTagsFromGraph();
-
-public:
 	// Receive notification from Flow graph or another Flow Component
 	UPROPERTY(BlueprintAssignable, Category = "Flow")
 	FFlowComponentDynamicNotify ReceiveNotify;
 
+private:
+	// Broadcasts ReceiveNotify and wakes nodes waiting for notifies received by components with our Identity Tags
+	void BroadcastReceivedNotify(UFlowComponent* Sender, const FGameplayTag& NotifyTag);
+
 //////////////////////////////////////////////////////////////////////////
 // Sending Notify Tags between Flow components
 
-private:
-	// Stores only recently replicated tags
-	UPROPERTY(ReplicatedUsing = OnRep_NotifyTagsFromAnotherComponent)
-	TArray<FNotifyTagReplication> NotifyTagsFromAnotherComponent;
-
 public:
 	// Send notification to another actor containing Flow Component
 	UFUNCTION(BlueprintCallable, Category = "Flow")
 	virtual void NotifyActor(const FGameplayTag ActorTag, const FGameplayTag NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
 
 private:
-	UFUNCTION()
-	void OnRep_NotifyTagsFromAnotherComponent();
+	void SendNotifyActor(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const int32 Count = 1);
+	void BroadcastNotifyToActors(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const int32 Count = 1);
+
+//////////////////////////////////////////////////////////////////////////
+// Notify throttling
+
+public:
+	// Limits how often NotifyGraph and NotifyActor send matching tags, applied before broadcasting and replicating
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
+	TArray<FFlowNotifyThrottle> NotifyThrottles;
+
+	// Number of throttled notifies merged into the notify currently broadcast, see EFlowNotifyThrottleMode::Accumulate
+	int32 GetRecentNotifyCount() const { return RecentNotifyCount; }
+
+private:
+	struct FThrottledNotify
+	{
+		double NextSendTime = 0.0;
+		double Interval = 0.0;
+		int32 PendingCount = 0;
+	};
+
+	// By the actor tag and the notify tag, the actor tag is empty for NotifyGraph
+	TMap<TPair<FGameplayTag, FGameplayTag>, FThrottledNotify> ThrottledNotifies;
+	FTSTicker::FDelegateHandle ThrottledNotifiesTickerHandle;
+
+	int32 RecentNotifyCount = 1;
+
+	// Returns true if the notify has been held back, it's sent later by FlushThrottledNotifies
+	bool ThrottleNotify(const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag);
+	bool FlushThrottledNotifies(float DeltaTime);
 
 //////////////////////////////////////////////////////////////////////////
 // Root Flow
@@ -179,9 +550,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RootFlow")
 	bool bAllowMultipleInstances;
 
+	// Finish Policy of Root Flows still running on End Play
+	// Abort tears down all of them in one batch, which is cheaper if many actors are destroyed at once, see UFlowSubsystem::TeardownRootFlows
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RootFlow")
+	EFlowFinishPolicy EndPlayFinishPolicy;
+
+	// Written by saves before instance ids were added
 	UPROPERTY(SaveGame)
 	FString SavedAssetInstanceName;
 
+	UPROPERTY(SaveGame)
+	uint64 SavedAssetInstanceId = 0;
+
 	// This will instantiate Flow Asset assigned on this component.
 	// Created Flow Asset instance will be a "root flow", as additional Flow Assets can be instantiated via Sub Graph node
 	UFUNCTION(BlueprintCallable, Category = "RootFlow")
@@ -197,6 +577,66 @@ public:
 	UFUNCTION(BlueprintPure, Category = "RootFlow", meta = (DeprecatedFunction, DeprecationMessage="Use GetRootInstances() instead."))
 	UFlowAsset* GetRootFlowInstance() const;
 
+//////////////////////////////////////////////////////////////////////////
+// Replicated Flow state
+
+private:
+	// Active nodes of server instances owned by this component, if their asset has bReplicateInstanceState enabled
+	UPROPERTY(Replicated)
+	FFlowReplicatedInstanceArray ReplicatedFlowInstances;
+
+	// SaveGame properties of nodes of these instances
+	UPROPERTY(Replicated)
+	FFlowReplicatedNodeArray ReplicatedFlowNodes;
+
+	struct FPendingReplicatedState
+	{
+		TWeakObjectPtr<UFlowAsset> Instance;
+		TWeakObjectPtr<UFlowAsset> TemplateAsset;
+	};
+
+	// Server: instances changed in this frame, their state is replicated once at the end of the frame
+	TArray<FPendingReplicatedState> PendingReplicatedStates;
+	FTSTicker::FDelegateHandle ReplicatedStateTickerHandle;
+
+	bool FlushReplicatedFlowStates(float DeltaTime);
+	void WriteReplicatedFlowState(UFlowAsset* Instance, UFlowAsset* TemplateAsset);
+	void RemoveReplicatedFlowState(const UFlowAsset* TemplateAsset);
+
+public:
+	// Server: called by the Flow Asset instance whenever its nodes changed
+	void MarkReplicatedFlowStateDirty(UFlowAsset* Instance);
+
+	// Client: was the node active on the server, by the latest replicated state of the server instance of this asset
+	bool IsNodeActiveOnServer(UFlowAsset* TemplateAsset, const FGuid& NodeGuid) const;
+
+	// Client: applies replicated SaveGame properties of the server node to the node of any instance of the same asset, i.e. created for UI
+	bool ApplyReplicatedNodeState(UFlowNode* Node) const;
+
+	// Client: called after the replicated state of the server instance changed
+	FFlowComponentStateReplicated OnFlowStateReplicated;
+
+//////////////////////////////////////////////////////////////////////////
+// Replay Flow state
+
+private:
+	// SaveGame records of the Root Flow and its Sub Graphs, replicated only to replays, see UFlowSettings::bRecordFlowStateInReplays
+	UPROPERTY(Replicated)
+	FFlowReplayStateArray ReplayFlowState;
+
+	// Serialized state of the latest snapshot, unchanged snapshots aren't split again
+	TArray<uint8> RecordedReplayFlowState;
+	bool bWarnedReplayFlowStateSize = false;
+	bool bReplayFlowStateOverLimit = false;
+
+	FTSTicker::FDelegateHandle ReplayFlowStateTickerHandle;
+
+	// Server: snapshots the Root Flow while the world records a replay, without calling OnSave() hooks
+	bool RecordReplayFlowState(float DeltaTime);
+
+	// Replay: restores the Root Flow of the checkpoint or the latest snapshot
+	void RestoreReplayFlowState();
+
 //////////////////////////////////////////////////////////////////////////
 // Custom Input and Output events
 
@@ -224,6 +664,33 @@ public:
 	UE_DEPRECATED(5.5, "Please use OnTriggerRootFlowCustomOutputDispatcher instead.")
 	void OnTriggerRootFlowOutputEventDispatcher(UFlowAsset* RootFlowInstance, const FName& EventName);
 
+//////////////////////////////////////////////////////////////////////////
+// Client Custom Inputs
+
+public:
+	// Triggers the Custom Input of the server instance of the Root Flow, i.e. for UI choices or interaction prompts of the owning client
+	// Inputs triggered within the frame are sent together in a single RPC, on the server the input is triggered immediately
+	// Server limits inputs of every component, see UFlowSettings::MaxClientCustomInputsPerSecond
+	// Only inputs allowed by UFlowNode_CustomInput::bCanBeTriggeredByClient are accepted, and only from the client owning the actor
+	UFUNCTION(BlueprintCallable, Category = "RootFlow")
+	void TriggerRootFlowCustomInputOnServer(UFlowAsset* TemplateAsset, const FName EventName);
+
+private:
+	TArray<FFlowClientCustomInput> PendingClientCustomInputs;
+	FTSTicker::FDelegateHandle ClientCustomInputsTickerHandle;
+
+	// Server: tokens refilled over time, every triggered input takes one
+	double ClientCustomInputTokens = 0.0;
+	double ClientCustomInputRefillTime = 0.0;
+
+	bool FlushClientCustomInputs(float DeltaTime);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerTriggerCustomInputs(const TArray<FFlowClientCustomInput>& Inputs);
+
+	// Only Root Flows started by this component can be triggered, returns false if there's no such instance
+	bool TriggerRootInstanceCustomInput(const UFlowAsset* TemplateAsset, const FName& EventName) const;
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame
 
@@ -240,12 +707,30 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
 	bool LoadInstance();
 
+	// Forces the next SaveInstance() to serialize the component, even if the incremental SaveGame considers it unchanged
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	void MarkSaveDataDirty();
+
+	// Components without state aren't saved at all. True if the Root Flow is assigned, or the class adds SaveGame properties or the Blueprint OnSave/OnLoad
+	virtual bool HasSaveGameState() const;
+
 protected:
+	// Return false if the component's SaveGame data changes without calling MarkSaveDataDirty(), i.e. it's calculated in OnSave()
+	virtual bool CanReuseSaveData() const;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "SaveGame")
 	void OnSave();
 	
 	UFUNCTION(BlueprintNativeEvent, Category = "SaveGame")
 	void OnLoad();
+
+private:
+	// Serialized data from the previous save, reused by the incremental SaveGame
+	TArray<uint8> CachedSaveData;
+	bool bSaveDataDirty = true;
+
+	// Names and object paths of the compact SaveGame format, only grows during the component lifetime
+	FFlowSaveDataTables SaveDataTables;
 	
 //////////////////////////////////////////////////////////////////////////
 // Helpers
@@ -0,0 +1,118 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+
+#include <atomic>
+
+class AActor;
+class UFlowComponent;
+
+/** Handle to the Flow Component registered in the Flow Subsystem, resolves to nullptr after the component is unregistered */
+struct FFlowComponentHandle
+{
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return SlotIndex != INDEX_NONE; }
+};
+
+/** Registered Flow Component as captured by the registry snapshot, holds no UObject pointers */
+struct FLOW_API FFlowComponentSnapshotEntry
+{
+	TObjectKey<AActor> Actor;
+	TObjectKey<UFlowComponent> Component;
+
+	/* Resolves to the component through UFlowSubsystem::ResolveComponentHandle, on the game thread only */
+	FFlowComponentHandle Handle;
+
+	FVector Location = FVector::ZeroVector;
+	FGameplayTagContainer Tags;
+};
+
+/**
+ * Immutable copy of the Flow Component registry, built on the game thread once per frame
+ * Safe to read from any thread, as long as it's read through FFlowComponentRegistrySnapshotReadScope
+ */
+struct FLOW_API FFlowComponentRegistrySnapshot
+{
+	TArray<FFlowComponentSnapshotEntry> Entries;
+
+	/* Indices to Entries, mirroring tag buckets of the registry */
+	TMap<FGameplayTag, TArray<int32>> EntriesPerTag;
+	TMap<FGameplayTag, TArray<int32>> EntriesUnderTag;
+
+	/* GFrameCounter at the time of the build */
+	uint64 FrameNumber = 0;
+
+	void Reset();
+
+	const TArray<int32>* FindEntries(const FGameplayTag& Tag, const bool bExactMatch) const
+	{
+		return bExactMatch ? EntriesPerTag.Find(Tag) : EntriesUnderTag.Find(Tag);
+	}
+
+	/* Number of entries identified by given tag */
+	int32 Num(const FGameplayTag& Tag, const bool bExactMatch) const;
+
+	/* Visits entries identified by given tag, returning false from the function stops the iteration */
+	bool ForEachEntry(const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(const FFlowComponentSnapshotEntry&)> Function) const;
+	bool ForEachEntryInRadius(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const float Radius, TFunctionRef<bool(const FFlowComponentSnapshotEntry&)> Function) const;
+};
+
+/**
+ * Double-buffered registry snapshot, published by the Flow Subsystem and read lock-free by any thread
+ * Game thread rebuilds the buffer which isn't published, then swaps buffers. The buffer still being read is left untouched,
+ * so publishing is skipped for a frame instead of waiting for readers
+ * Shared with worker threads by TSharedRef, so it outlives the subsystem
+ */
+class FLOW_API FFlowComponentRegistrySnapshotBuffer
+{
+public:
+	FFlowComponentRegistrySnapshotBuffer() = default;
+	UE_NONCOPYABLE(FFlowComponentRegistrySnapshotBuffer);
+
+	/* Game thread only, returns the buffer to rebuild or nullptr if it's still being read */
+	FFlowComponentRegistrySnapshot* BeginWrite();
+	void EndWrite();
+
+	/* Pins the published buffer against rewriting, until ReleaseRead */
+	int32 AcquireRead() const;
+	void ReleaseRead(const int32 BufferIndex) const;
+
+	const FFlowComponentRegistrySnapshot& GetBuffer(const int32 BufferIndex) const { return Buffers[BufferIndex]; }
+
+private:
+	FFlowComponentRegistrySnapshot Buffers[2];
+	std::atomic<int32> PublishedIndex{0};
+	mutable std::atomic<int32> ReaderCounts[2]{{0}, {0}};
+};
+
+/**
+ * Read access to the published registry snapshot, keeps it intact for the lifetime of the scope
+ * Scope is meant to be short-lived, holding it over many frames stops the snapshot from updating
+ */
+struct FLOW_API FFlowComponentRegistrySnapshotReadScope
+{
+	explicit FFlowComponentRegistrySnapshotReadScope(const TSharedRef<const FFlowComponentRegistrySnapshotBuffer, ESPMode::ThreadSafe>& InBuffer)
+		: Buffer(InBuffer)
+		, BufferIndex(InBuffer->AcquireRead())
+	{
+	}
+
+	~FFlowComponentRegistrySnapshotReadScope()
+	{
+		Buffer->ReleaseRead(BufferIndex);
+	}
+
+	UE_NONCOPYABLE(FFlowComponentRegistrySnapshotReadScope);
+
+	const FFlowComponentRegistrySnapshot& Get() const { return Buffer->GetBuffer(BufferIndex); }
+	const FFlowComponentRegistrySnapshot* operator->() const { return &Get(); }
+
+private:
+	TSharedRef<const FFlowComponentRegistrySnapshotBuffer, ESPMode::ThreadSafe> Buffer;
+	int32 BufferIndex;
+};
@@ -0,0 +1,89 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowCoroutineFramePool.h"
+#include "Templates/UnrealTemplate.h"
+#include <coroutine>
+
+class UFlowNodeCoroutine;
+
+/**
+ * Coroutine returned by UFlowNodeCoroutine::RunCoroutine, owns its frame
+ * Frame is allocated from the pool of the Flow Subsystem, that's why coroutines have to be members of the coroutine node
+ * Starts suspended, the node resumes it and destroys it once finished
+ */
+class FLOW_API FFlowCoroutine
+{
+public:
+	struct promise_type
+	{
+		template <typename NodeType, typename... ArgTypes>
+		static void* operator new(const SIZE_T Size, NodeType& Node, ArgTypes&&...)
+		{
+			return AllocateFrame(Size, Node);
+		}
+
+		static void operator delete(void* Frame, const SIZE_T Size)
+		{
+			FreeFrame(Frame, Size);
+		}
+
+		FFlowCoroutine get_return_object() { return FFlowCoroutine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { checkNoEntry(); }
+
+	private:
+		static void* AllocateFrame(const SIZE_T Size, const UFlowNodeCoroutine& Node);
+		static void FreeFrame(void* Frame, const SIZE_T Size);
+	};
+
+	FFlowCoroutine() = default;
+	~FFlowCoroutine() { Destroy(); }
+
+	FFlowCoroutine(FFlowCoroutine&& Other) noexcept
+		: Handle(Exchange(Other.Handle, nullptr))
+	{
+	}
+
+	FFlowCoroutine& operator=(FFlowCoroutine&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Destroy();
+			Handle = Exchange(Other.Handle, nullptr);
+		}
+		return *this;
+	}
+
+	FFlowCoroutine(const FFlowCoroutine&) = delete;
+	FFlowCoroutine& operator=(const FFlowCoroutine&) = delete;
+
+	bool IsValid() const { return static_cast<bool>(Handle); }
+	bool IsDone() const { return Handle && Handle.done(); }
+
+	void Resume()
+	{
+		check(Handle && !Handle.done());
+		Handle.resume();
+	}
+
+	void Destroy()
+	{
+		if (Handle)
+		{
+			Handle.destroy();
+			Handle = nullptr;
+		}
+	}
+
+private:
+	explicit FFlowCoroutine(const std::coroutine_handle<promise_type> InHandle)
+		: Handle(InHandle)
+	{
+	}
+
+	std::coroutine_handle<promise_type> Handle;
+};
@@ -0,0 +1,45 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "HAL/UnrealMemory.h"
+
+/**
+ * Free lists of coroutine frames, owned by the Flow Subsystem
+ * Frames are rounded up to size classes, so a finished coroutine leaves its frame to the next activation of any coroutine node
+ * Game thread only, like the nodes running coroutines
+ */
+class FLOW_API FFlowCoroutineFramePool
+{
+public:
+	static constexpr SIZE_T SizeClassGranularity = 64;
+
+	// Frames above 2 KB aren't pooled
+	static constexpr int32 SizeClassesNum = 32;
+
+	FFlowCoroutineFramePool() = default;
+	~FFlowCoroutineFramePool();
+
+	FFlowCoroutineFramePool(const FFlowCoroutineFramePool&) = delete;
+	FFlowCoroutineFramePool& operator=(const FFlowCoroutineFramePool&) = delete;
+
+	void* Allocate(const SIZE_T Size);
+	void Free(void* Frame, const SIZE_T Size);
+
+	// Releases memory of pooled frames, frames in use aren't affected
+	void Trim();
+
+	int32 GetFramesInUseNum() const { return FramesInUseNum; }
+	SIZE_T GetPooledSize() const { return PooledSize; }
+
+private:
+	struct FFreeFrame
+	{
+		FFreeFrame* Next;
+	};
+
+	FFreeFrame* FreeLists[SizeClassesNum] = {};
+
+	int32 FramesInUseNum = 0;
+	SIZE_T PooledSize = 0;
+};
@@ -0,0 +1,104 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Delegates/Delegate.h"
+#include "GameplayTagContainer.h"
+
+class FFlowEventBus;
+class UFlowComponent;
+
+enum class EFlowEventType : uint8
+{
+	NotifyFromComponent,	// UFlowComponent::OnNotifyFromComponent, keyed by Identity Tags of the component
+	ReceivedNotify			// UFlowComponent::ReceiveNotify, keyed by Identity Tags of the receiving component
+};
+
+struct FFlowEventKey
+{
+	FGameplayTag Tag;
+	EFlowEventType Type = EFlowEventType::NotifyFromComponent;
+
+	bool operator==(const FFlowEventKey& Other) const { return Tag == Other.Tag && Type == Other.Type; }
+
+	friend uint32 GetTypeHash(const FFlowEventKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Tag), static_cast<uint32>(Key.Type));
+	}
+};
+
+struct FFlowEvent
+{
+	EFlowEventType Type = EFlowEventType::NotifyFromComponent;
+	UFlowComponent* Component = nullptr;
+	FGameplayTag NotifyTag;
+
+	// Only used by ReceivedNotify, null if the notify was sent by the graph
+	UFlowComponent* Sender = nullptr;
+
+	// Same for all keys woken by one event, so waiters parked on several keys can ignore repeats
+	uint32 Serial = 0;
+};
+
+DECLARE_DELEGATE_OneParam(FFlowEventDelegate, const FFlowEvent&);
+
+/**
+ * Entry of the waiter list of FFlowEventBus, owned by the waiting object
+ * Parking and waking doesn't allocate, as the list links live in the waiter itself
+ * Waiter can't be moved while parked, it unparks itself when destroyed
+ */
+class FLOW_API FFlowEventWaiter
+{
+public:
+	FFlowEventWaiter() = default;
+	~FFlowEventWaiter();
+
+	FFlowEventWaiter(const FFlowEventWaiter&) = delete;
+	FFlowEventWaiter& operator=(const FFlowEventWaiter&) = delete;
+
+	bool IsParked() const { return Bus != nullptr; }
+
+	FFlowEventDelegate OnEvent;
+
+private:
+	friend class FFlowEventBus;
+
+	FFlowEventBus* Bus = nullptr;
+	FFlowEventKey Key;
+	FFlowEventWaiter* Prev = nullptr;
+	FFlowEventWaiter* Next = nullptr;
+};
+
+/**
+ * Wakes waiters parked on the (tag, event type) key, instead of every listener filtering every event
+ * Senders look up a single key per event, which is cheap if nothing waits for it
+ */
+class FLOW_API FFlowEventBus
+{
+public:
+	~FFlowEventBus();
+
+	// Waiter parked while its key is broadcast is woken by the next event
+	void Park(FFlowEventWaiter& Waiter, const FFlowEventKey& Key);
+	void Unpark(FFlowEventWaiter& Waiter);
+
+	bool IsEmpty() const { return WaitersNum == 0; }
+	int32 Num() const { return WaitersNum; }
+	bool HasWaiters(const FFlowEventKey& Key) const { return Heads.Contains(Key); }
+
+	uint32 MakeEventSerial() { return ++LastEventSerial; }
+
+	// Returns the number of woken waiters, these might unpark or park waiters while being woken
+	int32 Broadcast(const FFlowEventKey& Key, const FFlowEvent& Event);
+
+	void Reset();
+
+private:
+	TMap<FFlowEventKey, FFlowEventWaiter*> Heads;
+
+	// Next waiters to wake by ongoing broadcasts, moved forward if these waiters unpark
+	TArray<FFlowEventWaiter**, TInlineAllocator<4>> BroadcastCursors;
+
+	int32 WaitersNum = 0;
+	uint32 LastEventSerial = 0;
+};
@@ -0,0 +1,111 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Misc/Guid.h"
+#include "UObject/ObjectKey.h"
+
+class IFileHandle;
+class UFlowAsset;
+class UFlowNode;
+
+// Execution recorder is a development tool, compiled out of Shipping builds
+// Projects can override it by defining FLOW_WITH_EXECUTION_RECORDER in their target rules
+#ifndef FLOW_WITH_EXECUTION_RECORDER
+#define FLOW_WITH_EXECUTION_RECORDER (!UE_BUILD_SHIPPING)
+#endif
+
+enum class EFlowRecordedEventType : uint8
+{
+	Input,
+	Output
+};
+
+// Single pin activation, serialized as a fixed-size record
+struct FLOW_API FFlowRecordedEvent
+{
+	// Seconds since the recording started
+	float Time = 0.f;
+
+	uint32 InstanceId = 0;
+
+	// Index of the node in FFlowCompiledGraph::NodeGuids of the instance
+	uint16 NodeIndex = 0;
+
+	// Index of the pin in InputPins or OutputPins of the node
+	uint8 PinIndex = 0;
+
+	EFlowRecordedEventType EventType = EFlowRecordedEventType::Input;
+
+	friend FArchive& operator<<(FArchive& Ar, FFlowRecordedEvent& Event);
+};
+
+// Flow Asset instance seen by the recorder, written once before its first event
+struct FLOW_API FFlowRecordedInstance
+{
+	FString TemplatePath;
+	FString InstanceName;
+
+	// Node table of the compiled graph, resolves FFlowRecordedEvent::NodeIndex
+	TArray<FGuid> NodeGuids;
+
+	friend FArchive& operator<<(FArchive& Ar, FFlowRecordedInstance& Instance);
+};
+
+// Recording loaded from the file, i.e. by the editor to replay activations on the graph
+struct FLOW_API FFlowExecutionRecording
+{
+	FString FilePath;
+
+	TMap<uint32, FFlowRecordedInstance> Instances;
+
+	// Ordered by time
+	TArray<FFlowRecordedEvent> Events;
+
+	bool Load(const FString& InFilePath);
+
+	float GetDuration() const { return Events.Num() > 0 ? Events.Last().Time : 0.f; }
+};
+
+#if FLOW_WITH_EXECUTION_RECORDER
+/**
+ * Streams every pin activation of the session to a binary file in Saved/Profiling/Flow
+ * Events are appended to the memory buffer and flushed to the file in large blocks, so recording works in cooked builds with little overhead
+ * Started and stopped with Flow.Recorder console commands
+ */
+class FLOW_API FFlowExecutionRecorder
+{
+public:
+	static bool IsRecording() { return FileHandle != nullptr; }
+
+	// Starts a new recording in the given file or in the default directory, stops the current one
+	static bool Start(const FString& InFilePath = FString());
+	static void Stop();
+
+	static const FString& GetFilePath() { return FilePath; }
+
+	static void RecordPin(const UFlowNode& Node, const int32 PinIndex, const EFlowRecordedEventType EventType);
+
+private:
+	static void Flush();
+
+	static TUniquePtr<IFileHandle> FileHandle;
+	static FString FilePath;
+
+	static TArray<uint8> Buffer;
+	static double StartTime;
+
+	static TMap<FObjectKey, uint32> InstanceIds;
+};
+
+#define FLOW_RECORD_PIN(Node, PinIndex, EventType) \
+	do \
+	{ \
+		if (FFlowExecutionRecorder::IsRecording()) \
+		{ \
+			FFlowExecutionRecorder::RecordPin(Node, PinIndex, EventType); \
+		} \
+	} while (0)
+#else
+#define FLOW_RECORD_PIN(Node, PinIndex, EventType)
+#endif
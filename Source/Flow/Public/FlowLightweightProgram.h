@@ -0,0 +1,292 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
+#include "Misc/Guid.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/NameTypes.h"
+
+// Forward Declarations
+class UFlowAsset;
+class UFlowNode;
+struct FFlowCompiledGraph;
+
+// Runtime state of a single lightweight instance, plain data meant to be embedded in per-entity storage, i.e. Mass fragments
+// Initialized by FFlowLightweightProgram::InitializeState, layout depends on the program
+struct FLOW_API FFlowLightweightState
+{
+	// By the dense node index of the compiled graph
+	TBitArray<> ActiveNodes;
+
+	// AND inputs, OR and Counter state
+	TArray<int32> IntSlots;
+
+	// Remaining time of Timer nodes, negative if the timer isn't running
+	TArray<float> TimeSlots;
+
+	int32 RunningTimers = 0;
+	bool bStarted = false;
+	bool bFinished = false;
+
+	bool IsRunning() const { return bStarted && !bFinished; }
+
+	bool IsNodeActive(const int32 NodeIndex) const { return ActiveNodes[NodeIndex]; }
+	void SetNodeActive(const int32 NodeIndex, const bool bActive) { ActiveNodes[NodeIndex] = bActive; }
+
+	int32 GetIntSlot(const int32 SlotIndex) const { return IntSlots[SlotIndex]; }
+	void SetIntSlot(const int32 SlotIndex, const int32 Value) { IntSlots[SlotIndex] = Value; }
+
+	float GetTimeSlot(const int32 SlotIndex) const { return TimeSlots[SlotIndex]; }
+	void SetTimeSlot(const int32 SlotIndex, const float Value) { TimeSlots[SlotIndex] = Value; }
+};
+
+/**
+ * Copy-on-write view of the lightweight state for the speculative evaluation, i.e. "what happens if this Custom Input fires"
+ * Executing the program on the fork writes only the nodes and slots it changes, the base state is never modified
+ * Creating the fork doesn't copy anything, its cost grows with the changed state, not with the graph. The base must outlive the fork
+ * See UFlowAsset::CaptureSpeculativeState for forking the running Flow Asset instance
+ */
+struct FLOW_API FFlowLightweightFork
+{
+	explicit FFlowLightweightFork(const FFlowLightweightState& InBase)
+		: Base(&InBase)
+		, RunningTimers(InBase.RunningTimers)
+		, bStarted(InBase.bStarted)
+		, bFinished(InBase.bFinished)
+	{
+	}
+
+	bool IsRunning() const { return bStarted && !bFinished; }
+
+	bool IsNodeActive(const int32 NodeIndex) const;
+	void SetNodeActive(const int32 NodeIndex, const bool bActive) { ActiveNodes.Add(NodeIndex, bActive); }
+
+	int32 GetIntSlot(const int32 SlotIndex) const;
+	void SetIntSlot(const int32 SlotIndex, const int32 Value) { IntSlots.Add(SlotIndex, Value); }
+
+	float GetTimeSlot(const int32 SlotIndex) const;
+	void SetTimeSlot(const int32 SlotIndex, const float Value) { TimeSlots.Add(SlotIndex, Value); }
+
+	// Nodes and slots written by the fork
+	int32 GetModifiedNum() const { return ActiveNodes.Num() + IntSlots.Num() + TimeSlots.Num(); }
+
+	// Drops the changes, so the fork can evaluate another what-if from the same base
+	void Reset();
+
+private:
+	friend class FFlowLightweightProgram;
+
+	const FFlowLightweightState* Base;
+
+	TMap<int32, bool> ActiveNodes;
+	TMap<int32, int32> IntSlots;
+	TMap<int32, float> TimeSlots;
+
+	// Set once the fork finished the instance, the base isn't read anymore then
+	bool bBaseDiscarded = false;
+
+public:
+	int32 RunningTimers = 0;
+	bool bStarted = false;
+	bool bFinished = false;
+};
+
+// Reported by the lightweight instance to the caller, in the execution order
+struct FLOW_API FFlowLightweightEvent
+{
+	// Index passed to the program call, i.e. the entity index in the processed chunk
+	int32 InstanceIndex = INDEX_NONE;
+
+	// Event name of the triggered Custom Output, None if the instance reached the Finish node
+	FName EventName = NAME_None;
+
+	// Dense index of the stubbed node reached by the speculative program, execution doesn't continue past it
+	int32 StubNodeIndex = INDEX_NONE;
+
+	bool IsFinish() const { return EventName.IsNone() && StubNodeIndex == INDEX_NONE; }
+	bool IsStub() const { return StubNodeIndex != INDEX_NONE; }
+};
+
+/**
+ * Executes graphs of the template Flow Asset without creating any UObjects, so thousands of entities can run the same simple graph
+ * The program shares the compiled graph of the template, every instance is only the FFlowLightweightState
+ *  - supported nodes: Start, Finish, Reroute, Custom Input, Custom Output, Sequence, AND, OR, Counter and Timer
+ *  - node classes are matched exactly, subclasses might change the behavior
+ *  - nodes with AddOns and Timers with the connected Completion Time data pin aren't supported
+ * Programs are compiled by UFlowAsset::GetLightweightProgram, callers own the states and tick them in batches
+ * Speculative programs replace unsupported nodes with stubs, so any graph can be evaluated on the FFlowLightweightFork without side effects
+ */
+class FLOW_API FFlowLightweightProgram
+{
+public:
+	// Returns nullptr, if any node of the template can't be executed by the program, unless unsupported nodes are stubbed
+	static TSharedPtr<const FFlowLightweightProgram> Compile(UFlowAsset& TemplateAsset, const bool bStubUnsupportedNodes = false);
+
+	void InitializeState(FFlowLightweightState& State) const;
+
+	// Reads the state of the running instance of the template, returns false if the instance doesn't share the compiled graph of the program
+	// Timers keep their remaining time, while properties of stubbed nodes aren't captured
+	bool CaptureState(const UFlowAsset& Instance, FFlowLightweightState& OutState) const;
+
+	// Triggers the Start node
+	void Start(FFlowLightweightState& State, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	// Triggers the Custom Input node with the matching event name, returns false if there isn't such node
+	bool TriggerCustomInput(FFlowLightweightState& State, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	// Advances running timers of the instance
+	void Tick(FFlowLightweightState& State, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	// Advances running timers of all instances, events reference instances by the index in the array
+	void Tick(TArrayView<FFlowLightweightState> States, const float DeltaTime, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	// The same calls executed on the fork, leaving its base untouched
+	void Start(FFlowLightweightFork& Fork, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+	bool TriggerCustomInput(FFlowLightweightFork& Fork, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+	void Tick(FFlowLightweightFork& Fork, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	bool HasTimers() const { return !TimerNodes.IsEmpty(); }
+	int32 GetNodesNum() const { return Nodes.Num(); }
+	int32 GetStubNodesNum() const { return StubNodesNum; }
+
+	// Identifies the node reported by FFlowLightweightEvent::StubNodeIndex
+	FGuid GetNodeGuid(const int32 NodeIndex) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	enum class EOp : uint8
+	{
+		// Triggers the first output
+		Start,
+		CustomInput,
+		Reroute,
+
+		// Finishes the instance
+		Finish,
+
+		// Reports EventName to the caller
+		CustomOutput,
+
+		// Triggers all outputs in the pin order
+		Sequence,
+
+		// Triggers the first output once all inputs were triggered, IntParam is the mask of all inputs
+		AND,
+
+		// Triggers the first output on any numbered input, IntParam is the execution limit, slots are the execution count and enabled flag
+		OR,
+
+		// IntParam is the goal, Outputs are Zero, Step, Goal, Skipped
+		Counter,
+
+		// Time slots are the remaining completion and step time, Outputs are Completed, Step, Skipped
+		Timer,
+
+		// Node the program can't execute, reported to the caller of the speculative program
+		Stub
+	};
+
+	// Meaning of the input pin, by the index in InputPins of the node
+	enum class EInput : uint8
+	{
+		In,
+		Skip,
+		Restart,
+		Increment,
+		Decrement,
+		Enable,
+		Disable,
+		Unknown
+	};
+
+	struct FNode
+	{
+		EOp Op = EOp::Reroute;
+		TArray<EInput, TInlineAllocator<4>> Inputs;
+		TArray<int32, TInlineAllocator<4>> Outputs;
+
+		int32 IntParam = 0;
+		bool bBoolParam = false;
+		float CompletionTime = 0.0f;
+		float StepTime = 0.0f;
+		FName EventName;
+
+		// First entry of IntSlots or TimeSlots owned by the node
+		int32 SlotOffset = INDEX_NONE;
+	};
+
+	struct FTrigger
+	{
+		int32 NodeIndex;
+		int32 PinIndex;
+	};
+
+	// Pin activations executed in FIFO order, like the trigger queue of Flow Asset instances
+	// StateType is either FFlowLightweightState or FFlowLightweightFork
+	template <typename StateType>
+	struct TExecution
+	{
+		StateType& State;
+		const int32 InstanceIndex;
+		TArray<FFlowLightweightEvent>& OutEvents;
+		TArray<FTrigger, TInlineAllocator<16>> Pending;
+	};
+
+	bool CompileNode(const UFlowNode& FlowNode, FNode& OutNode);
+
+	// Forks are reset to the initial state without reading the base
+	void InitializeState(FFlowLightweightFork& Fork) const;
+
+	template <typename StateType>
+	void StartInternal(StateType& State, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	template <typename StateType>
+	bool TriggerCustomInputInternal(StateType& State, const FName& EventName, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	template <typename StateType>
+	void TickInternal(StateType& State, const float DeltaTime, const int32 InstanceIndex, TArray<FFlowLightweightEvent>& OutEvents) const;
+
+	template <typename StateType>
+	void Execute(TExecution<StateType>& Execution) const;
+
+	template <typename StateType>
+	void ExecuteNode(TExecution<StateType>& Execution, const int32 NodeIndex, const int32 PinIndex) const;
+
+	template <typename StateType>
+	void TriggerOutput(TExecution<StateType>& Execution, const int32 NodeIndex, const int32 OutputPinIndex, const bool bFinish) const;
+
+	template <typename StateType>
+	void FinishNode(StateType& State, const int32 NodeIndex) const;
+
+	template <typename StateType>
+	void FinishInstance(TExecution<StateType>& Execution) const;
+
+	template <typename StateType>
+	void StartTimer(StateType& State, const FNode& Node) const;
+
+	template <typename StateType>
+	void StopTimer(StateType& State, const FNode& Node) const;
+
+	static FORCEINLINE EInput GetInput(const FNode& Node, const int32 PinIndex)
+	{
+		return Node.Inputs.IsValidIndex(PinIndex) ? Node.Inputs[PinIndex] : EInput::Unknown;
+	}
+
+	// Connections of the template, shared with its instances
+	TSharedPtr<const FFlowCompiledGraph> Graph;
+
+	// By the dense node index
+	TArray<FNode> Nodes;
+
+	int32 StartNodeIndex = INDEX_NONE;
+	TMap<FName, int32> CustomInputNodes;
+	TArray<int32> TimerNodes;
+
+	int32 IntSlotsNum = 0;
+	int32 TimeSlotsNum = 0;
+	int32 StubNodesNum = 0;
+};
@@ -1,5 +1,61 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
 #pragma once
 
+#include "HAL/CriticalSection.h"
 #include "Logging/LogMacros.h"
+#include "UObject/ObjectKey.h"
 
 FLOW_API DECLARE_LOG_CATEGORY_EXTERN(LogFlow, Log, All);
+
+// Per-node runtime messages, i.e. disabled signals or triggering finished nodes, might be silenced without affecting LogFlow
+FLOW_API DECLARE_LOG_CATEGORY_EXTERN(LogFlowExecution, Log, All);
+
+/**
+ * Limits messages of a single logging call site per node, see Flow.Log.MaxMessagesPerSecond
+ * Safe to use from isolated instances executed in parallel
+ */
+struct FLOW_API FFlowLogRateLimiter
+{
+	// Returns false if the message of this node should be skipped, OutSuppressedNum is the count of its messages skipped since the last accepted one
+	bool TryConsume(const UObject* Node, int32& OutSuppressedNum);
+
+private:
+	struct FNodeMessages
+	{
+		int32 MessagesNum = 0;
+		int32 SuppressedNum = 0;
+	};
+
+	FCriticalSection CriticalSection;
+	int64 WindowStart = -1;
+	TMap<FObjectKey, FNodeMessages> NodeMessages;
+};
+
+/**
+ * Logs message through UFlowNodeBase::LogMessage, called from Flow Node or AddOn methods
+ * Arguments aren't evaluated and the message isn't formatted if the category verbosity is disabled or the node exceeded the rate limit of this call site
+ * Errors are always passed on, as LogMessage displays them on screen even if the category is silenced
+ */
+#if !UE_BUILD_SHIPPING && !NO_LOGGING
+#define FLOW_LOG_NODE(CategoryName, Verbosity, Format, ...) \
+	do \
+	{ \
+		if (ELogVerbosity::Verbosity == ELogVerbosity::Error || UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+		{ \
+			static FFlowLogRateLimiter FlowLogRateLimiter; \
+			int32 FlowLogSuppressedNum = 0; \
+			if (FlowLogRateLimiter.TryConsume(this, FlowLogSuppressedNum)) \
+			{ \
+				FString FlowLogMessage = FString::Printf(Format, ##__VA_ARGS__); \
+				if (FlowLogSuppressedNum > 0) \
+				{ \
+					FlowLogMessage.Appendf(TEXT(" (%d similar messages suppressed)"), FlowLogSuppressedNum); \
+				} \
+				LogMessage(CategoryName, ELogVerbosity::Verbosity, MoveTemp(FlowLogMessage)); \
+			} \
+		} \
+	} while (false)
+#else
+#define FLOW_LOG_NODE(CategoryName, Verbosity, Format, ...) do {} while (false)
+#endif
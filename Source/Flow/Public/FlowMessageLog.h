@@ -98,4 +98,77 @@ protected:
 	}
 };
 
+/**
+ * Runtime Message Log of the asset template, kept as the ring of the most recent lines
+ * Repeated message of the same node and severity increases the repeat count of the existing line, instead of adding a new one
+ */
+class FLOW_API FFlowRuntimeMessageLog
+{
+public:
+	// 0 means unbounded
+	explicit FFlowRuntimeMessageLog(const int32 InMaxMessages);
+
+	// Returns the added line or the existing line updated with the repeat count
+	TSharedRef<FTokenizedMessage> AddMessage(const EMessageSeverity::Type Severity, const FString& Text, const UFlowNodeBase* Node);
+
+	// Lines from the oldest one
+	void GetMessages(TArray<TSharedRef<FTokenizedMessage>>& OutMessages) const;
+
+	int32 GetMessagesNum() const { return Entries.Num(); }
+
+	// Lines removed from the ring to make room for the new ones
+	int32 GetDroppedNum() const { return DroppedNum; }
+
+	// Incremented on every added message, allows listeners to refresh lazily
+	uint32 GetVersion() const { return Version; }
+
+private:
+	struct FEntryKey
+	{
+		FString Text;
+		TWeakObjectPtr<const UFlowNodeBase> Node;
+		EMessageSeverity::Type Severity;
+
+		bool operator==(const FEntryKey& Other) const
+		{
+			return Severity == Other.Severity && Node == Other.Node && Text == Other.Text;
+		}
+
+		friend uint32 GetTypeHash(const FEntryKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Text), HashCombine(GetTypeHash(Key.Node), static_cast<uint32>(Key.Severity)));
+		}
+	};
+
+	struct FEntry
+	{
+		FEntryKey Key;
+		TSharedRef<FTokenizedMessage> Message;
+		int32 Count = 1;
+
+		FEntry(FEntryKey&& InKey, const TSharedRef<FTokenizedMessage>& InMessage)
+			: Key(MoveTemp(InKey))
+			, Message(InMessage)
+		{
+		}
+	};
+
+	static TSharedRef<FTokenizedMessage> CreateMessage(const FEntryKey& Key, const int32 Count);
+
+	int32 MaxMessages;
+
+	// Ring buffer once MaxMessages is reached, OldestIndex is the first line then
+	TArray<FEntry> Entries;
+	int32 OldestIndex = 0;
+
+	// By the entry key, ring positions aren't stable, so lines are referenced by the serial number of the addition
+	TMap<FEntryKey, uint64> EntrySerials;
+	uint64 NextSerial = 0;
+
+	int32 DroppedNum = 0;
+	uint32 Version = 0;
+
+	int32 GetEntryIndex(const uint64 Serial) const;
+};
+
 #endif // WITH_EDITOR
@@ -0,0 +1,103 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Misc/Guid.h"
+#include "UObject/ObjectKey.h"
+
+class UFlowAsset;
+class UFlowNode;
+
+// Runtime cost profiler is a development tool, compiled out of Shipping builds
+// Projects can override it by defining FLOW_WITH_PROFILER in their target rules
+#ifndef FLOW_WITH_PROFILER
+#define FLOW_WITH_PROFILER (!UE_BUILD_SHIPPING)
+#endif
+
+#if FLOW_WITH_PROFILER
+enum class EFlowProfileMetric : uint8
+{
+	ExclusiveTime,
+	InclusiveTime,
+	Triggers
+};
+
+struct FLOW_API FFlowProfileEntry
+{
+	// Time spent in the input execution, including nodes triggered synchronously by its outputs
+	double InclusiveTime = 0.0;
+
+	// Time spent in the input execution, without nodes triggered by its outputs
+	double ExclusiveTime = 0.0;
+
+	int64 Triggers = 0;
+
+	double GetMetric(const EFlowProfileMetric Metric) const;
+};
+
+struct FLOW_API FFlowTemplateProfile
+{
+	FString TemplateName;
+	FFlowProfileEntry Total;
+	TMap<FGuid, FFlowProfileEntry> Nodes;
+};
+
+struct FLOW_API FFlowNodeClassProfile
+{
+	FString ClassName;
+	FFlowProfileEntry Total;
+};
+
+/**
+ * Accumulates time and trigger count of node inputs per Flow Asset template, per node and per node class
+ * Started and stopped with Flow.Profiler console commands or the Flow Asset editor toolbar
+ */
+class FLOW_API FFlowProfiler
+{
+	friend struct FFlowProfilerScope;
+
+public:
+	static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(const bool bInEnabled);
+	static void Reset();
+
+	static const FFlowTemplateProfile* FindTemplateProfile(const UFlowAsset* Template);
+	static const TMap<FObjectKey, FFlowTemplateProfile>& GetTemplateProfiles() { return TemplateProfiles; }
+	static const TMap<FObjectKey, FFlowNodeClassProfile>& GetNodeClassProfiles() { return NodeClassProfiles; }
+
+	// Logs templates and node classes sorted by the metric
+	static void Dump(const EFlowProfileMetric Metric, const int32 MaxEntries);
+
+private:
+	static bool bEnabled;
+
+	static TMap<FObjectKey, FFlowTemplateProfile> TemplateProfiles;
+	static TMap<FObjectKey, FFlowNodeClassProfile> NodeClassProfiles;
+
+	// Innermost scope on the game thread
+	static struct FFlowProfilerScope* CurrentScope;
+};
+
+struct FLOW_API FFlowProfilerScope
+{
+	explicit FFlowProfilerScope(const UFlowNode& Node);
+	~FFlowProfilerScope();
+
+private:
+	bool bActive = false;
+
+	FObjectKey TemplateKey;
+	FObjectKey ClassKey;
+	FGuid NodeGuid;
+
+	double StartTime = 0.0;
+	double ChildTime = 0.0;
+
+	FFlowProfilerScope* Parent = nullptr;
+};
+
+#define FLOW_PROFILER_NODE_SCOPE(Node) \
+	const FFlowProfilerScope PREPROCESSOR_JOIN(FlowProfilerScope, __LINE__)(Node)
+#else
+#define FLOW_PROFILER_NODE_SCOPE(Node)
+#endif
@@ -0,0 +1,85 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Trace/Trace.h"
+#include "UObject/NameTypes.h"
+#include "UObject/ObjectKey.h"
+
+#include "FlowExecutionRecorder.h"
+#include "FlowTypes.h"
+
+class UFlowAsset;
+class UFlowNode;
+
+// Remote debugging is a development tool, compiled out of Shipping builds and builds without Trace
+// Projects can override it by defining FLOW_WITH_REMOTE_DEBUG in their target rules
+#ifndef FLOW_WITH_REMOTE_DEBUG
+#define FLOW_WITH_REMOTE_DEBUG (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#if FLOW_WITH_REMOTE_DEBUG
+UE_TRACE_CHANNEL_EXTERN(FlowDebugChannel, FLOW_API);
+
+/**
+ * Streams pin activations and node state changes of watched instances over Trace, i.e. from a cooked build on the target device to the editor
+ * Nothing is sent until the FlowDebug channel is enabled and at least one template or instance is watched with Flow.RemoteDebug.Watch
+ * Events use the layout of the Execution Recorder, so the editor shows them like a recording loaded from the file
+ */
+class FLOW_API FFlowRemoteDebug
+{
+public:
+	static bool IsStreaming() { return bHasWatches && UE_TRACE_CHANNELEXPR_IS_ENABLED(FlowDebugChannel); }
+
+	// Reads -FlowRemoteDebugWatch=Name1+Name2 from the command line
+	static void Initialize();
+
+	// Name of the template asset or the instance display name, * watches every instance
+	static void Watch(const FName& Name);
+	static void Unwatch(const FName& Name);
+	static void UnwatchAll();
+
+	static void TracePin(const UFlowNode& Node, const int32 PinIndex, const EFlowRecordedEventType EventType);
+	static void TraceNodeState(const UFlowNode& Node, const EFlowNodeState State);
+
+	// Forgets the instance id, so the cache doesn't grow with every instance created while something is watched
+	static void OnInstanceDeinitialized(const UFlowAsset& Instance);
+
+private:
+	// Returns 0 for instances which aren't watched, sends the instance event before the first event of the watched instance
+	static uint32 GetInstanceId(const UFlowAsset& Instance);
+
+	static void OnWatchesChanged();
+	static float GetTime();
+
+	static TSet<FName> WatchedNames;
+	static bool bHasWatches;
+
+	// Cached for every instance seen since the watch list changed, including the unwatched ones
+	static TMap<FObjectKey, uint32> InstanceIds;
+	static uint32 NextInstanceId;
+
+	static double StartTime;
+};
+
+#define FLOW_REMOTE_DEBUG_PIN(Node, PinIndex, EventType) \
+	do \
+	{ \
+		if (FFlowRemoteDebug::IsStreaming()) \
+		{ \
+			FFlowRemoteDebug::TracePin(Node, PinIndex, EventType); \
+		} \
+	} while (0)
+
+#define FLOW_REMOTE_DEBUG_NODE_STATE(Node, State) \
+	do \
+	{ \
+		if (FFlowRemoteDebug::IsStreaming()) \
+		{ \
+			FFlowRemoteDebug::TraceNodeState(Node, State); \
+		} \
+	} while (0)
+#else
+#define FLOW_REMOTE_DEBUG_PIN(Node, PinIndex, EventType)
+#define FLOW_REMOTE_DEBUG_NODE_STATE(Node, State)
+#endif
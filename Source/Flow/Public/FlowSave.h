@@ -3,9 +3,45 @@
 #pragma once
 
 #include "GameFramework/SaveGame.h"
+#include "Serialization/ArchiveProxy.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/SoftObjectPath.h"
 #include "FlowSave.generated.h"
 
+UENUM()
+enum class EFlowSaveDataFormat : uint8
+{
+	// Names and object references are written as strings, every time they occur
+	NameAsString,
+
+	// Names and object references are written as indices into the tables of the record
+	CompactTables
+};
+
+// Names and object paths referenced by the compact save data of a single record
+USTRUCT()
+struct FLOW_API FFlowSaveDataTables
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(SaveGame)
+	TArray<FName> Names;
+
+	UPROPERTY(SaveGame)
+	TArray<FSoftObjectPath> ObjectPaths;
+
+	int32 AddName(const FName& Name);
+	int32 AddObjectPath(const FSoftObjectPath& ObjectPath);
+
+	// Restores lookups after the tables have been loaded, so the save data can be extended with new entries
+	void RebuildIndices();
+	void Reset();
+
+private:
+	TMap<FName, int32> NameIndices;
+	TMap<FSoftObjectPath, int32> ObjectPathIndices;
+};
+
 USTRUCT(BlueprintType)
 struct FLOW_API FFlowNodeSaveData
 {
@@ -31,15 +67,31 @@ struct FLOW_API FFlowAssetSaveData
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
 	FString WorldName;
 
+	// Identifies records written before instance ids were added, empty otherwise
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
 	FString InstanceName;
 
+	// See UFlowAsset::GetInstanceId
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	uint64 InstanceId = 0;
+
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
 	TArray<uint8> AssetData;
 
 	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
 	TArray<FFlowNodeSaveData> NodeRecords;
 
+	// Format of AssetData and NodeRecords, records written before the compact format was added use names as strings
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	EFlowSaveDataFormat Format = EFlowSaveDataFormat::NameAsString;
+
+	UPROPERTY(SaveGame)
+	FFlowSaveDataTables Tables;
+
+	// AssetData and NodeRecords contain only properties different from the template asset and its nodes
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	bool bDeltaFromTemplate = false;
+
 	friend FArchive& operator<<(FArchive& Ar, FFlowAssetSaveData& InAssetData)
 	{
 		return Ar;
@@ -60,6 +112,13 @@ struct FLOW_API FFlowComponentSaveData
 	UPROPERTY(SaveGame)
 	TArray<uint8> ComponentData;
 
+	// Format of ComponentData, records written before the compact format was added use names as strings
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	EFlowSaveDataFormat Format = EFlowSaveDataFormat::NameAsString;
+
+	UPROPERTY(SaveGame)
+	FFlowSaveDataTables Tables;
+
 	friend FArchive& operator<<(FArchive& Ar, FFlowComponentSaveData& InComponentData)
 	{
 		return Ar;
@@ -72,8 +131,117 @@ struct FLOW_API FFlowArchive : public FObjectAndNameAsStringProxyArchive
 	{
 		ArIsSaveGame = true;
 	}
+
+	// Properties of the DeltaObject equal to the DeltaArchetype aren't written
+	void SetDeltaArchetype(const UObject* InDeltaObject, UObject* InDeltaArchetype)
+	{
+		DeltaObject = InDeltaObject;
+		DeltaArchetype = InDeltaArchetype;
+	}
+
+	virtual UObject* GetArchetypeFromLoader(const UObject* Obj) override
+	{
+		return Obj && Obj == DeltaObject ? DeltaArchetype : FObjectAndNameAsStringProxyArchive::GetArchetypeFromLoader(Obj);
+	}
+
+private:
+	const UObject* DeltaObject = nullptr;
+	UObject* DeltaArchetype = nullptr;
+};
+
+// Decoded records of a single streaming level
+struct FLOW_API FFlowLevelRecords
+{
+	TArray<FFlowComponentSaveData> FlowComponents;
+	TArray<FFlowAssetSaveData> FlowInstances;
+};
+
+// Flow data of actors placed in a streaming level, decoded only after the level is streamed in (see UFlowSettings::bGroupSaveGameByLevel)
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowLevelSaveData
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	FString WorldName;
+
+	// Level package name, without the PIE prefix
+	UPROPERTY(SaveGame, VisibleAnywhere, Category = "Flow")
+	FString LevelName;
+
+	UPROPERTY(SaveGame)
+	TArray<uint8> RecordsData;
+
+	void Encode(FFlowLevelRecords& Records);
+	void Decode(FFlowLevelRecords& OutRecords) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FFlowLevelSaveData& InLevelData)
+	{
+		return Ar;
+	}
 };
 
+// Flow Asset instance prepared for saving on the game thread, its serialization may run on a worker thread (see UFlowSettings::bParallelSaveGame)
+struct FFlowAssetPendingSave
+{
+	class UFlowAsset* Instance = nullptr;
+	TArray<class UFlowNode*> Nodes;
+
+	// placeholder record in the SaveGame, filled by serialization
+	TArray<FFlowAssetSaveData>* SavedFlowInstances = nullptr;
+	int32 RecordIndex = INDEX_NONE;
+
+	bool bReuseAssetData = false;
+
+	// See UFlowAsset::SnapshotInstance
+	bool bSnapshot = false;
+};
+
+// Writes names and object references as packed indices into the record tables
+struct FLOW_API FFlowCompactArchive : public FArchiveProxy
+{
+	FFlowCompactArchive(FArchive& InInnerArchive, FFlowSaveDataTables& InTables);
+
+	using FArchiveProxy::operator<<;
+
+	virtual FArchive& operator<<(FName& Value) override;
+	virtual FArchive& operator<<(UObject*& Value) override;
+	virtual FArchive& operator<<(FObjectPtr& Value) override;
+	virtual FArchive& operator<<(FWeakObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPath& Value) override;
+
+	virtual FString GetArchiveName() const override { return TEXT("FFlowCompactArchive"); }
+
+	// Properties of the DeltaObject equal to the DeltaArchetype aren't written
+	void SetDeltaArchetype(const UObject* InDeltaObject, UObject* InDeltaArchetype)
+	{
+		DeltaObject = InDeltaObject;
+		DeltaArchetype = InDeltaArchetype;
+	}
+
+	virtual UObject* GetArchetypeFromLoader(const UObject* Obj) override
+	{
+		return Obj && Obj == DeltaObject ? DeltaArchetype : FArchiveProxy::GetArchetypeFromLoader(Obj);
+	}
+
+private:
+	FFlowSaveDataTables& Tables;
+
+	const UObject* DeltaObject = nullptr;
+	UObject* DeltaArchetype = nullptr;
+};
+
+namespace FlowSave
+{
+	// Serializes SaveGame properties of the object, in the compact format if tables are provided
+	// If the archetype is provided, only properties different from it are written
+	FLOW_API void SerializeSaveData(UObject& Object, FArchive& InnerArchive, FFlowSaveDataTables* Tables, UObject* DeltaArchetype = nullptr);
+
+	// Copies SaveGame properties from the archetype, so the delta save data can be applied on top of them
+	FLOW_API void ResetSaveGameProperties(UObject& Object, const UObject& Archetype);
+}
+
 UCLASS(BlueprintType)
 class FLOW_API UFlowSaveGame : public USaveGame
 {
@@ -90,11 +258,33 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = "Flow")
 	TArray<FFlowAssetSaveData> FlowInstances;
+
+	UPROPERTY(VisibleAnywhere, Category = "Flow")
+	TArray<FFlowLevelSaveData> FlowLevels;
+
+	// Flow records written in the compressed form, see UFlowSettings::SaveGameCompressionFormat
+	// Decompressed right after loading, so the records are always available in the arrays above
+	UPROPERTY()
+	TArray<uint8> CompressedFlowData;
+
+	UPROPERTY()
+	FName CompressedFlowDataFormat;
+
+	UPROPERTY()
+	int32 UncompressedFlowDataSize = 0;
+
+	virtual void Serialize(FArchive& Ar) override;
 	
 	friend FArchive& operator<<(FArchive& Ar, UFlowSaveGame& SaveGame)
 	{
 		Ar << SaveGame.FlowComponents;
 		Ar << SaveGame.FlowInstances;
+		Ar << SaveGame.FlowLevels;
 		return Ar;
 	}
+
+private:
+	void SerializeFlowRecords(FArchive& Ar);
+	bool CompressFlowData(const FName& FormatName);
+	bool DecompressFlowData();
 };
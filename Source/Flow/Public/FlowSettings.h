@@ -3,11 +3,13 @@
 #pragma once
 
 #include "Engine/DeveloperSettings.h"
+#include "FlowTypes.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/SoftObjectPath.h"
 #include "FlowSettings.generated.h"
 
 class UFlowNode;
+class UWorld;
 
 /**
  *
@@ -28,9 +30,113 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	UPROPERTY(Config, EditAnywhere, Category = "Networking")
 	bool bCreateFlowSubsystemOnClients;
 
+	// Client Flow Subsystem instantiates only Flow Assets marked as bCosmetic, i.e. VFX or audio sequencing
+	// Only cosmetic components are added to the client registry, see UFlowComponent::IsCosmetic
+	UPROPERTY(Config, EditAnywhere, Category = "Networking", meta = (EditCondition = "bCreateFlowSubsystemOnClients"))
+	bool bCosmeticFlowsOnlyOnClients;
+
+	// NotifyActor is replicated by the receiving components instead of the sender
+	// Clients get the notify only if the receiving actor is relevant to them, and don't need to search the component registry
+	// Costs one replicated notify per receiving component, instead of one per sender
+	UPROPERTY(Config, EditAnywhere, Category = "Networking")
+	bool bReplicateActorNotifiesByReceiver;
+
+	// While recording a replay, the server periodically writes SaveGame records of every Root Flow into a property replicated only to replays
+	// Playing or scrubbing the replay restores these instances directly, instead of re-simulating graph events. Requires bCreateFlowSubsystemOnClients
+	UPROPERTY(Config, EditAnywhere, Category = "Networking")
+	bool bRecordFlowStateInReplays;
+
+	// Seconds between snapshots of the Root Flow, unchanged records aren't sent again
+	UPROPERTY(Config, EditAnywhere, Category = "Networking", meta = (ClampMin = 0.1f, EditCondition = "bRecordFlowStateInReplays"))
+	float ReplayFlowStateInterval;
+
+	// Snapshot of every component is recorded in 1 KB chunks, larger snapshots aren't recorded and the component logs a warning
+	// Fast arrays accept at most 2048 changed chunks per update
+	UPROPERTY(Config, EditAnywhere, Category = "Networking", meta = (ClampMin = 1, ClampMax = 2048, EditCondition = "bRecordFlowStateInReplays"))
+	int32 MaxReplayFlowStateKB;
+
+	// Custom Inputs triggered by the owning client per second of every Flow Component, see UFlowComponent::TriggerRootFlowCustomInputOnServer
+	// Server drops inputs over the limit, allowing a burst of one second worth of inputs. 0 disables the limit
+	UPROPERTY(Config, EditAnywhere, Category = "Networking", meta = (ClampMin = 0.0f))
+	float MaxClientCustomInputsPerSecond;
+
+	// Client splits inputs of the frame into batches of this size, server closes the connection of the client sending larger batches
+	UPROPERTY(Config, EditAnywhere, Category = "Networking", meta = (ClampMin = 1))
+	int32 MaxClientCustomInputsPerBatch;
+
 	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
 	bool bWarnAboutMissingIdentityTags;
 
+	// SaveGame reuses serialized data of Flow Nodes, Flow Assets and Flow Components that didn't change since the previous save
+	// Native code modifying SaveGame properties outside of node activation has to call MarkSaveDataDirty()
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bIncrementalSaveGame;
+
+	// SaveGame writes names and object references of Flow data as indices into tables stored once per record
+	// Records saved with names as strings are still loaded, regardless of this setting
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bCompactSaveGameFormat;
+
+	// OnSave() hooks of all root Flow Graphs run on the game thread, then Flow Asset instances are serialized in parallel
+	// Native Serialize() overrides of nodes and assets must be safe to call off the game thread
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bParallelSaveGame;
+
+	// SaveGame groups Flow data of actors placed in streaming levels (i.e. World Partition cells) by the level
+	// Group is decoded when the level streams in and its Flow Component loads, and released when the level is removed
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bGroupSaveGameByLevel;
+
+	// SaveGame writes only properties of Flow Asset instances and their nodes that differ from the template asset
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bSaveGameDeltaFromTemplate;
+
+	// Compresses all Flow records of the SaveGame into a single buffer, i.e. Zlib or Oodle. None disables compression
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	FName SaveGameCompressionFormat;
+
+	// Flow Component registry additionally groups components of every tag by their class
+	// Class-filtered queries with the exact tag visit only components of matching classes, at the cost of extra bookkeeping on registration
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bPartitionComponentRegistryByClass;
+
+	// Flow Component registry additionally groups components by their world, for servers running many matches in separate worlds of one game instance
+	// World-scoped queries (i.e. UFlowSubsystem::ForEachComponentInWorld) visit only components of the given world and count queries per world
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bShardComponentRegistryByWorld;
+
+	// Registration events of Flow Components are collected and broadcast once at the start of the next frame
+	// Streaming in a level with many components notifies every observer once, instead of once per component
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bBatchComponentRegistrationPerFrame;
+
+	// Identity Tags added or removed during the frame are reported to the registry, delegates and replication once at the end of the frame
+	// Identity Tags of the component change immediately, registry queries see the change only after the commit
+	// Tag added and removed within the same frame isn't reported at all
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bCoalesceIdentityTagChanges;
+
+	// Flow Component registry additionally keeps owner locations in a 2D grid, updated on movement of the owner's root component
+	// Spatial queries and region listeners visit only nearby cells, instead of every component with the tag
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bSpatialComponentRegistry;
+
+	// Size of the spatial registry cell, should be close to the typical query radius
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry", meta = (ClampMin = 100.0f, EditCondition = "bSpatialComponentRegistry"))
+	float SpatialComponentRegistryCellSize;
+
+	// Flow Subsystem publishes a copy of the registry with owner locations once per frame, readable from any thread without locking
+	// Rebuilt only on registry changes if the spatial registry is enabled, otherwise every frame as owners might have moved
+	UPROPERTY(Config, EditAnywhere, Category = "ComponentRegistry")
+	bool bPublishComponentRegistrySnapshot;
+
+#if WITH_EDITORONLY_DATA
+	// Runtime Log of every asset template keeps only this many most recent lines, repeated messages of the same node are counted on a single line
+	// 0 keeps all lines
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (ClampMin = 0))
+	int32 RuntimeLogMaxMessages;
+#endif
+
 	// If enabled, runtime logs will be added when a flow node signal mode is set to Disabled
 	UPROPERTY(Config, EditAnywhere, Category = "Flow")
 	bool bLogOnSignalDisabled;
@@ -39,6 +145,113 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	UPROPERTY(Config, EditAnywhere, Category = "Flow")
 	bool bLogOnSignalPassthrough;
 
+	// Cooked graphs skip Reroute, pass-through and disabled nodes, nodes unreachable from any entry point aren't cooked at all
+	// Nodes referenced only by their guid from outside of the graph would be stripped too, see FFlowAssetOptimizer
+	UPROPERTY(Config, EditAnywhere, Category = "Flow")
+	bool bOptimizeGraphsOnCook;
+
+	// Root Flows started by the Flow Subsystem are collected and started together at the start of the next frame
+	// Streaming in a level with many Flow Components creates all root instances in one pass, then starts them
+	UPROPERTY(Config, EditAnywhere, Category = "Execution")
+	bool bBatchRootFlowStartsPerFrame;
+
+	// If enabled, pin activations are pushed to a per-instance queue and executed iteratively in FIFO order,
+	// instead of recursively calling the connected node. This bounds the call stack depth for long chains of instant nodes,
+	// but changes the order of execution from depth-first to breadth-first
+	UPROPERTY(Config, EditAnywhere, Category = "Execution")
+	bool bUseTriggerQueue;
+
+	// Maximum number of queued pin activations executed by a single Flow Asset instance per frame, 0 means no limit
+	// Remaining activations are carried over to the next frame
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (EditCondition = "bUseTriggerQueue", ClampMin = 0))
+	int32 MaxQueuedTriggersPerFrame;
+
+	// Time budget shared by all Flow Asset instances for executing queued pin activations in a single frame, 0 means no limit
+	// Activations exceeding the budget are carried over to the next frame, instances with higher Execution Priority are resumed first
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (EditCondition = "bUseTriggerQueue", ClampMin = 0, Units = "Microseconds"))
+	float TriggerQueueFrameBudget;
+
+	// Watchdog catching runaway loops, i.e. Timer's Step wired back to itself: maximum number of node inputs executed by a single Flow Asset instance in one frame
+	// 0 disables the watchdog, see TriggerStormResponse for what happens once exceeded
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0))
+	int32 MaxTriggersPerInstancePerFrame;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (EditCondition = "MaxTriggersPerInstancePerFrame > 0"))
+	EFlowTriggerStormResponse TriggerStormResponse;
+
+	// Node instances release Connections and PinNameToBoundPropertyNameMap copied from the template, reading them from the template node instead
+	// Reduces memory of many concurrent instances, project nodes must access this data through GetConnections() and GetPinNameToBoundPropertyNameMap()
+	UPROPERTY(Config, EditAnywhere, Category = "Execution")
+	bool bShareTemplateNodeData;
+
+	// Data pin values are cached per supplier node and pin, until the supplier executes again or the trigger chain ends
+	// Avoids re-evaluating expensive suppliers read by many consumers, values computed from the world state might get stale within one chain
+	UPROPERTY(Config, EditAnywhere, Category = "Execution")
+	bool bMemoizeDataPinValues;
+
+	// Whenever a node activates, nodes up to this many connections ahead of active nodes preload their content, 0 disables it
+	// Preloaded nodes no longer reachable within this depth are flushed, unless they became active
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0))
+	int32 LookaheadPreloadDepth;
+
+	// Maximum number of nodes preloaded ahead by a single Flow Asset instance, the nearest ones are preferred, 0 means no limit
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (EditCondition = "LookaheadPreloadDepth > 0", ClampMin = 0))
+	int32 MaxLookaheadPreloadedNodes;
+
+	// Preloaded nodes that haven't been activated for this many seconds are flushed, 0 disables it
+	// Like the budget below, it can be overriden per platform in Config/<Platform>/<Platform>Game.ini
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0, ForceUnits = "s"))
+	float PreloadedNodeTimeout;
+
+	// Memory of content preloaded by nodes through the Flow Subsystem, least recently activated preloaded nodes are flushed when exceeded, 0 disables it
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0, ForceUnits = "MB"))
+	int32 PreloadedContentBudgetMB;
+
+	// How often preloaded nodes are checked against the timeout and the budget above
+	// Without the timeout, nodes are scanned only while the budget is exceeded
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0.1f, ForceUnits = "s"))
+	float PreloadEvictionInterval;
+
+	// Instances of assets with bLazyNodeInstantiation release inactive node instances if no input has been triggered for this many seconds, 0 disables it
+	// Only nodes opted in by UFlowNode::CanHibernate are released, these are instantiated again when triggered (see UFlowAsset::HibernateInactiveNodes)
+	UPROPERTY(Config, EditAnywhere, Category = "Execution", meta = (ClampMin = 0, ForceUnits = "s"))
+	float InstanceHibernationDelay;
+
+	// Instances with significance below this value are throttled, see UFlowSubsystem::SetFlowSignificance
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = 0, ClampMax = 1))
+	float ThrottledSignificance;
+
+	// Instances with significance below this value are paused, their timers and queued pin activations catch up once significance rises
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = 0, ClampMax = 1))
+	float PausedSignificance;
+
+	// Timers of throttled instances fire at multiples of this interval, looping timers fire as many times as they expired in the meantime
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = 0.01, ForceUnits = "s"))
+	float ThrottledTimerInterval;
+
+	// Replaces MaxQueuedTriggersPerFrame for throttled instances, remaining activations are carried over to the next frame
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = 1))
+	int32 ThrottledQueuedTriggersPerFrame;
+
+	// How often significance callback of the Flow Subsystem is evaluated for all instances
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = 0, ForceUnits = "s"))
+	float SignificanceUpdateInterval;
+
+	// Determines how pin activations are recorded for debugging, i.e. displayed while hovering pins and highlighting wires
+	// Recording is compiled out in Shipping and dedicated server builds (see FLOW_WITH_PIN_RECORDS)
+	// Can be overriden at runtime with the Flow.PinRecordingMode console variable
+	UPROPERTY(Config, EditAnywhere, Category = "Debug")
+	EFlowPinRecordingMode PinRecordingMode;
+
+	// Number of the most recent activations recorded for every pin
+	UPROPERTY(Config, EditAnywhere, Category = "Debug", meta = (EditCondition = "PinRecordingMode == EFlowPinRecordingMode::RingBuffer", ClampMin = 1))
+	int32 MaxPinRecords;
+
+	// Dedicated server worlds skip pin records, debugger hooks, the runtime message log and on-screen messages
+	// Output Log still receives all messages. Always enabled in dedicated server builds (see FLOW_LEAN_SERVER)
+	UPROPERTY(Config, EditAnywhere, Category = "Debug")
+	bool bLeanDedicatedServer;
+
 	// Adjust the Titles for FlowNodes to be more expressive than default
 	// by incorporating data that would otherwise go in the Description
 	UPROPERTY(EditAnywhere, config, Category = "Nodes")
@@ -56,6 +269,12 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 public:
 	UClass* GetDefaultExpectedOwnerClass() const;
 
+	// Returns PinRecordingMode, unless overriden by the console variable
+	EFlowPinRecordingMode GetPinRecordingMode() const;
+
+	// Returns true if Flow Graphs of this world should run without editor-facing debugging state
+	bool IsLeanServer(const UWorld* World) const;
+
 	static UClass* TryResolveOrLoadSoftClass(const FSoftClassPath& SoftClassPath);
 
 #if WITH_EDITORONLY_DATA
@@ -0,0 +1,145 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+// Enable in Unreal Insights with "-trace=cpu,flow" or "Trace.Enable Flow"
+UE_TRACE_CHANNEL_EXTERN(FlowChannel, FLOW_API);
+
+#if CPUPROFILERTRACE_ENABLED
+// Event names carry the template, node class and pin, formatted only while the channel is enabled
+#define FLOW_TRACE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, FlowChannel)
+
+#define FLOW_TRACE_SCOPE_TEXT(Format, ...) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(UE_TRACE_CHANNELEXPR_IS_ENABLED(FlowChannel) ? *FString::Printf(Format, ##__VA_ARGS__) : TEXT(""), FlowChannel)
+#else
+#define FLOW_TRACE_SCOPE(Name)
+#define FLOW_TRACE_SCOPE_TEXT(Format, ...)
+#endif
+
+DECLARE_STATS_GROUP(TEXT("Flow"), STATGROUP_Flow, STATCAT_Advanced);
+
+// Live state, published once per frame by the Flow Subsystem
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Root Instances"), STAT_FlowRootInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sub Graph Instances"), STAT_FlowSubGraphInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Nodes"), STAT_FlowActiveNodes, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Preloaded Nodes"), STAT_FlowPreloadedNodes, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registered Components"), STAT_FlowRegisteredComponents, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Publish Live Stats"), STAT_FlowPublishLiveStats, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Publish Registry Snapshot"), STAT_FlowPublishRegistrySnapshot, STATGROUP_Flow, FLOW_API);
+
+// Per frame activity
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pin Triggers"), STAT_FlowPinTriggers, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Registry Queries"), STAT_FlowRegistryQueries, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Started Instances"), STAT_FlowStartedInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Finished Instances"), STAT_FlowFinishedInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Teardown Root Flows"), STAT_FlowTeardownRootFlows, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trigger Storms"), STAT_FlowTriggerStorms, STATGROUP_Flow, FLOW_API);
+
+// World startup
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Should Create Subsystem"), STAT_FlowShouldCreateSubsystem, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Initialize Subsystem"), STAT_FlowInitializeSubsystem, STATGROUP_Flow, FLOW_API);
+
+// Trigger queue
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drain Trigger Queue"), STAT_FlowDrainTriggerQueue, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Triggers"), STAT_FlowDeferredTriggers, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Instances"), STAT_FlowDeferredInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Isolated Execution"), STAT_FlowIsolatedExecution, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Isolated Instances"), STAT_FlowIsolatedInstances, STATGROUP_Flow, FLOW_API);
+
+// Timers
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Timers"), STAT_FlowActiveTimers, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fired Timers"), STAT_FlowFiredTimers, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Timers"), STAT_FlowTickTimers, STATGROUP_Flow, FLOW_API);
+
+// Event bus
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Woken Event Waiters"), STAT_FlowWokenEventWaiters, STATGROUP_Flow, FLOW_API);
+
+// Posted events
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Posted Events"), STAT_FlowPostedEvents, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drain Posted Events"), STAT_FlowDrainPostedEvents, STATGROUP_Flow, FLOW_API);
+
+// Node ticking
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tickable Nodes"), STAT_FlowTickableNodes, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Nodes"), STAT_FlowTickNodes, STATGROUP_Flow, FLOW_API);
+
+// Instance pooling
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Instances"), STAT_FlowPooledInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Created Instances"), STAT_FlowCreatedInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reused Instances"), STAT_FlowReusedInstances, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Warmup Templates"), STAT_FlowWarmupTemplates, STATGROUP_Flow, FLOW_API);
+
+// Injected component pooling
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Components"), STAT_FlowPooledComponents, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reused Components"), STAT_FlowReusedComponents, STATGROUP_Flow, FLOW_API);
+
+// Shared preloads, hit rate is Hits / (Hits + Misses)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Preloaded Assets"), STAT_FlowPreloadedAssets, STATGROUP_Flow, FLOW_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Preloaded Memory"), STAT_FlowPreloadedMemory, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Preload Hits"), STAT_FlowPreloadHits, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Preload Misses"), STAT_FlowPreloadMisses, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Evicted Preloaded Nodes"), STAT_FlowEvictedPreloads, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hibernated Nodes"), STAT_FlowHibernatedNodes, STATGROUP_Flow, FLOW_API);
+
+// Data pins
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Pin Memo Hits"), STAT_FlowDataPinMemoHits, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Pin Memo Misses"), STAT_FlowDataPinMemoMisses, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Data Pin"), STAT_FlowResolveDataPin, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resolved Data Pins"), STAT_FlowResolvedDataPins, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Pin Suppliers Visited"), STAT_FlowDataPinSuppliersVisited, STATGROUP_Flow, FLOW_API);
+
+// Predicates, cache hit rate is Hits / (Hits + Misses)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Predicate Cache Hits"), STAT_FlowPredicateCacheHits, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Predicate Cache Misses"), STAT_FlowPredicateCacheMisses, STATGROUP_Flow, FLOW_API);
+
+// SaveGame
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Game"), STAT_FlowSaveGame, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Game"), STAT_FlowLoadGame, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Flow Instance"), STAT_FlowLoadInstance, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Flow Component"), STAT_FlowLoadComponent, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Serialized Save Records"), STAT_FlowSerializedSaveRecords, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reused Save Records"), STAT_FlowReusedSaveRecords, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Component Saves"), STAT_FlowSkippedComponentSaves, STATGROUP_Flow, FLOW_API);
+
+// Debug, stays at zero on the lean server
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pin Records"), STAT_FlowPinRecords, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debugger Pin Notifies"), STAT_FlowDebuggerPinNotifies, STATGROUP_Flow, FLOW_API);
+
+// Networking
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Replicated Bytes"), STAT_FlowReplicatedBytes, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Replicated Notifies"), STAT_FlowReplicatedNotifies, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dropped Throttled Notifies"), STAT_FlowDroppedNotifies, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Merged Throttled Notifies"), STAT_FlowMergedNotifies, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Registry Queries From Replication"), STAT_FlowReplicatedRegistryQueries, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Client Custom Inputs"), STAT_FlowClientCustomInputs, STATGROUP_Flow, FLOW_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dropped Client Custom Inputs"), STAT_FlowDroppedClientCustomInputs, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Receive Replicated Notifies"), STAT_FlowReceiveReplicatedNotifies, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Receive Replicated State"), STAT_FlowReceiveReplicatedState, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Record Replay State"), STAT_FlowRecordReplayState, STATGROUP_Flow, FLOW_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Restore Replay State"), STAT_FlowRestoreReplayState, STATGROUP_Flow, FLOW_API);
+
+// Live state, per frame activity and save/load time are captured by "csvprofile start/stop" as well, as stats are compiled out of Test builds
+// Timings are milliseconds per frame, counters are per frame, live state is sampled once per frame
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FLOW_API, Flow);
+
+// Data pin cost is captured by "csvprofile start/stop" as well, to compare captures across plugin versions
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FLOW_API, FlowDataPins);
+
+// Replicated bytes per property and component class, notifies per tag
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FLOW_API, FlowNetworking);
+
+// The longest sample of every FFlowTelemetry metric per frame, milliseconds
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FLOW_API, FlowTelemetry);
+
+// Used by the resolve functions of UFlowNodeBase
+#define FLOW_RESOLVE_DATA_PIN_SCOPE(PinName) \
+	FLOW_TRACE_SCOPE_TEXT(TEXT("ResolveDataPin %s.%s"), *GetClass()->GetName(), *PinName.ToString()); \
+	SCOPE_CYCLE_COUNTER(STAT_FlowResolveDataPin); \
+	CSV_SCOPED_TIMING_STAT(FlowDataPins, ResolveDataPin); \
+	CSV_CUSTOM_STAT(FlowDataPins, ResolvedDataPins, 1, ECsvCustomStatOp::Accumulate); \
+	INC_DWORD_STAT(STAT_FlowResolvedDataPins)
@@ -2,21 +2,365 @@
 
 #pragma once
 
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Engine/EngineBaseTypes.h"
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "FlowComponent.h"
+#include "FlowComponentRegistrySnapshot.h"
+#include "FlowCoroutineFramePool.h"
+#include "FlowEventBus.h"
+#include "FlowTimerWheel.h"
 #include "FlowSubsystem.generated.h"
 
 class UFlowAsset;
 class UFlowNode_SubGraph;
+class UFlowNodeTickable;
+class UFlowSubsystem;
+struct FFlowCompiledGraph;
+struct FStreamableHandle;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSimpleFlowEvent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSimpleFlowComponentEvent, UFlowComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTaggedFlowComponentEvent, UFlowComponent*, Component, const FGameplayTagContainer&, Tags);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMultipleFlowComponentsEvent, const TArray<UFlowComponent*>&, Components);
 
 DECLARE_DELEGATE_OneParam(FNativeFlowAssetEvent, class UFlowAsset*);
+DECLARE_DELEGATE_OneParam(FNativeFlowComponentEvent, UFlowComponent*);
+DECLARE_DELEGATE_TwoParams(FNativeTaggedFlowComponentEvent, UFlowComponent*, const FGameplayTagContainer&);
+DECLARE_DELEGATE_OneParam(FNativeMultipleFlowComponentsEvent, const TArray<UFlowComponent*>&);
+DECLARE_DELEGATE_OneParam(FNativeFlowSaveGameWritten, const bool /*bSuccess*/);
+DECLARE_DELEGATE_RetVal_OneParam(float, FFlowSignificanceCallback, const UObject* /*Owner*/);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FNativeSimpleFlowComponentMulticastEvent, UFlowComponent*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FNativeTaggedFlowComponentMulticastEvent, UFlowComponent*, const FGameplayTagContainer&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FNativeMultipleFlowComponentsMulticastEvent, const TArray<UFlowComponent*>&);
+
+/** Finished instances of the template asset, waiting for reuse */
+USTRUCT()
+struct FLOW_API FFlowInstancePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UFlowAsset>> Instances;
+
+	/* Graph compiled from the template at the time of pooling instances, editing template invalidates the pool */
+	TSharedPtr<const FFlowCompiledGraph> CompiledGraph;
+};
+
+/** Removed injected components created from the same template or class, waiting for reuse */
+USTRUCT()
+struct FLOW_API FFlowInjectedComponentPool
+{
+	GENERATED_BODY()
+
+	/* Component template or class defaults */
+	FObjectKey Archetype;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UActorComponent>> Components;
+};
+
+/** Save requested while the previous save to the same slot was still being written, see UFlowSubsystem::AsyncSaveGameToSlot */
+USTRUCT()
+struct FLOW_API FFlowQueuedSlotSave
+{
+	GENERATED_BODY()
+
+	/* The latest requested SaveGame, snapshotted once the previous write finishes */
+	UPROPERTY()
+	TObjectPtr<UFlowSaveGame> SaveGame = nullptr;
+
+	int32 UserIndex = 0;
+
+	/* Callbacks of all coalesced requests */
+	TArray<FNativeFlowSaveGameWritten> OnWritten;
+};
+
+/** Notify or Custom Input posted from any thread, see UFlowSubsystem::PostNotifyFromAnyThread */
+struct FFlowPostedEvent
+{
+	/* Either the component to notify, or the instance to trigger Custom Input on */
+	TWeakObjectPtr<UFlowComponent> Component;
+	TWeakObjectPtr<UFlowAsset> FlowInstance;
+
+	FGameplayTag NotifyTag;
+	EFlowNetMode NetMode = EFlowNetMode::Authority;
+
+	FName EventName;
+};
+
+/** Root Flow start waiting for the end of the batch, see UFlowSubsystem::BeginRootFlowStartBatch */
+struct FFlowRootFlowStartRequest
+{
+	TWeakObjectPtr<UObject> Owner;
+	TWeakObjectPtr<UFlowAsset> FlowAsset;
+	bool bAllowMultipleInstances = true;
+};
+
+/** Template loaded, compiled and pooled ahead of its first use, usually during the loading screen */
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowTemplateWarmup
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	TSoftObjectPtr<UFlowAsset> FlowAsset;
+
+	/* Instances created ahead, capped by UFlowAsset::MaxPooledInstances */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow", meta = (ClampMin = 0))
+	int32 PooledInstances = 1;
+};
+
+/** Asset preloaded on behalf of nodes, kept loaded as long as any node holds it */
+struct FFlowSharedPreload
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	int32 RefCount = 0;
+
+	/* Counted into STAT_FlowPreloadedMemory once loading completes */
+	int64 ResidentBytes = 0;
+};
+
+/** Tickable node in the tick list, see UFlowNodeTickable */
+struct FFlowNodeTickEntry
+{
+	TWeakObjectPtr<UFlowNodeTickable> Node;
+
+	/* Time passed since the node ticked, the node ticks once it reaches its Tick Interval */
+	float AccumulatedTime = 0.0f;
+};
+
+/** Tickable nodes of the same class, ticked one after another */
+struct FFlowNodeTickBucket
+{
+	const UClass* NodeClass = nullptr;
+	TArray<FFlowNodeTickEntry> Entries;
+};
+
+/** Single tick function ticking all tickable nodes of its tick group */
+USTRUCT()
+struct FFlowNodeTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UFlowSubsystem* Subsystem = nullptr;
+
+	TArray<FFlowNodeTickBucket> Buckets;
+	int32 NodesNum = 0;
+
+	/* Nodes unregistered while ticking leave empty entries, removed once the tick ends */
+	bool bTicking = false;
+	bool bPendingCompaction = false;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FFlowNodeTickFunction> : public TStructOpsTypeTraitsBase2<FFlowNodeTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/** Notify Tag sent to Flow Components identified by the Actor Tag, see UFlowSubsystem::BatchNotifyActors */
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowActorNotify
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	FGameplayTag ActorTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	FGameplayTag NotifyTag;
+};
+
+/** Slot of the dense Flow Component registry */
+USTRUCT()
+struct FLOW_API FFlowComponentRegistrySlot
+{
+	GENERATED_BODY()
+
+	/* Cleared by the garbage collector, if component was destroyed without unregistering, see UFlowSubsystem::RemoveStaleComponents */
+	UPROPERTY()
+	TObjectPtr<UFlowComponent> Component;
+
+	TObjectKey<UFlowComponent> ComponentKey;
+	const UClass* ComponentClass = nullptr;
+
+	/* Identity Tags the component is registered with, the slot is free if empty */
+	FGameplayTagContainer RegisteredTags;
+
+	/* Incremented on releasing the slot, invalidates handles */
+	uint32 Generation = 0;
+
+	/* Owner location cached by the spatial registry, see UFlowSettings::bSpatialComponentRegistry */
+	FVector Location = FVector::ZeroVector;
+	FIntPoint Cell = FIntPoint::ZeroValue;
+
+	/* Root component of the movable owner, updating the cached location */
+	TWeakObjectPtr<USceneComponent> TrackedSceneComponent;
+	FDelegateHandle TransformUpdatedHandle;
+
+	/* World of the component at the time of registration */
+	TObjectKey<UWorld> World;
+};
+
+/** Tag buckets of Flow Components registered in a single world, see UFlowSettings::bShardComponentRegistryByWorld */
+struct FLOW_API FFlowComponentRegistryShard
+{
+	TMap<FGameplayTag, TArray<int32>> ComponentSlotsPerTag;
+	TMap<FGameplayTag, TArray<int32>> ComponentSlotsUnderTag;
+
+	int32 ComponentsNum = 0;
+
+	/* World-scoped queries executed since the shard has been created */
+	mutable int32 QueriesNum = 0;
+};
+
+/**
+ * Native listener of the Flow Component registry, see UFlowSubsystem::AddComponentListener
+ * Receives only events of components which Identity Tags might match the filter, listener still has to check the match itself
+ * Listener with empty Tags receives all events
+ */
+struct FFlowComponentListener
+{
+	FGameplayTagContainer Tags;
+	EFlowTagContainerMatchType MatchType = EFlowTagContainerMatchType::HasAnyExact;
+
+	/* Called once per registration batch, see UFlowSubsystem::BeginComponentRegistrationBatch */
+	FNativeMultipleFlowComponentsEvent OnComponentsRegistered;
+	FNativeTaggedFlowComponentEvent OnComponentTagAdded;
+	FNativeTaggedFlowComponentEvent OnComponentTagRemoved;
+	FNativeFlowComponentEvent OnComponentUnregistered;
+
+	/* Assigned by the subsystem */
+	FDelegateHandle Handle;
+};
+
+/**
+ * Sphere observed through the spatial Flow Component registry, see UFlowSubsystem::AddComponentRegionListener
+ * Components already inside after adding the listener don't trigger OnComponentEntered, use UFlowSubsystem::ForEachComponentInRegion
+ */
+struct FFlowComponentRegionListener
+{
+	/* Empty container matches every component */
+	FGameplayTagContainer Tags;
+	EFlowTagContainerMatchType MatchType = EFlowTagContainerMatchType::HasAnyExact;
+
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.0f;
+
+	/* Called when the component matching Tags moves into the sphere, or gets matching tags inside of it */
+	FNativeFlowComponentEvent OnComponentEntered;
+	FNativeFlowComponentEvent OnComponentLeft;
+
+	/* Assigned by the subsystem */
+	FDelegateHandle Handle;
+	TSet<TObjectKey<UFlowComponent>> ComponentsInside;
+};
+
+/**
+ * FGameplayTagQuery prepared once for the Flow Component registry
+ * Tags referenced by the query select candidate components from the tag index, so only these are tested against the query
+ */
+struct FLOW_API FFlowCompiledTagQuery
+{
+	FGameplayTagQuery Query;
+
+	/* Component matching the query has at least one of these tags or their child tags, unless bMatchesEmpty */
+	TArray<FGameplayTag> Tags;
+
+	/* Query matches components without any of the referenced tags, i.e. a single NoTagsMatch expression, so every component is a candidate */
+	bool bMatchesEmpty = false;
+
+	FFlowCompiledTagQuery() {}
+	explicit FFlowCompiledTagQuery(const FGameplayTagQuery& InQuery);
+
+	bool IsEmpty() const { return Query.IsEmpty(); }
+	bool Matches(const FGameplayTagContainer& ComponentTags) const { return Query.Matches(ComponentTags); }
+
+	bool operator==(const FFlowCompiledTagQuery& Other) const { return Query == Other.Query; }
+};
+
+/**
+ * Persistent query of the Flow Component registry, its result is updated incrementally on every registry change
+ * Components matching on creation don't trigger OnComponentAdded, read them with UFlowSubsystem::GetLiveQueryComponents
+ */
+struct FFlowComponentLiveQuery
+{
+	FGameplayTagContainer Tags;
+	EFlowTagContainerMatchType MatchType = EFlowTagContainerMatchType::HasAnyExact;
+
+	/* Replaces Tags and MatchType if not empty */
+	FGameplayTagQuery TagQuery;
+
+	FNativeFlowComponentEvent OnComponentAdded;
+	FNativeFlowComponentEvent OnComponentRemoved;
+
+	/* Assigned by the subsystem */
+	FDelegateHandle Handle;
+	int32 FilterIndex = INDEX_NONE;
+
+	/* False until the query created inside the live query batch is resolved */
+	bool bResolved = false;
+};
+
+/**
+ * Result shared by all live queries with the same tags and match type, i.e. observer nodes of many instances of the same template
+ * Registry changes update the filter once, then fan out to its subscribers
+ */
+struct FFlowComponentLiveQueryFilter
+{
+	FGameplayTagContainer Tags;
+	EFlowTagContainerMatchType MatchType = EFlowTagContainerMatchType::HasAnyExact;
+	FFlowCompiledTagQuery TagQuery;
+
+	TSet<TWeakObjectPtr<UFlowComponent>> Components;
+
+	/* Indices of live queries using this filter */
+	TArray<int32> Queries;
+
+	/* False until the filter created inside the live query batch is resolved against the registry */
+	bool bResolved = false;
+
+	bool Matches(const FGameplayTagContainer& ComponentTags) const
+	{
+		return TagQuery.IsEmpty() ? FlowTypes::HasMatchingTags(ComponentTags, Tags, MatchType) : TagQuery.Matches(ComponentTags);
+	}
+
+	/* Tags routing registry changes to this filter */
+	const TArray<FGameplayTag>& GetRoutingTags() const { return TagQuery.IsEmpty() ? Tags.GetGameplayTagArray() : TagQuery.Tags; }
+};
+
+/** Handle to the live query, see UFlowSubsystem::CreateLiveQuery */
+struct FFlowComponentLiveQueryHandle
+{
+	int32 QueryIndex = INDEX_NONE;
+	FDelegateHandle Handle;
+
+	bool IsValid() const { return Handle.IsValid(); }
+	void Reset() { QueryIndex = INDEX_NONE; Handle.Reset(); }
+};
+
+/** Notification of the region listener or the live query, dispatched after the registry finished updating */
+struct FFlowComponentRegistryEvent
+{
+	int32 ListenerIndex = INDEX_NONE;
+	FDelegateHandle Handle;
+	TWeakObjectPtr<UFlowComponent> Component;
+	bool bAdded = false;
+};
 
 /**
  * Flow Subsystem
@@ -29,124 +373,744 @@ class FLOW_API UFlowSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
-public:
-	UFlowSubsystem();
+public:
+	UFlowSubsystem();
+
+	friend class UFlowAsset;
+	friend class UFlowComponent;
+	friend class UFlowNode_SubGraph;
+	friend struct FFlowRegistryBenchmark;
+
+private:
+	/* All asset templates with active instances */
+	UPROPERTY()
+	TArray<TObjectPtr<UFlowAsset>> InstancedTemplates;
+
+	/* Assets instanced by object from another system, i.e. World Settings or Player Controller */
+	UPROPERTY()
+	TMap<TObjectPtr<UFlowAsset>, TWeakObjectPtr<UObject>> RootInstances;
+
+	/* Root instances by owner, so starting and finishing a root flow doesn't iterate all of them. Weak keys stay comparable after the owner is gone */
+	TMap<TWeakObjectPtr<const UObject>, TArray<UFlowAsset*, TInlineAllocator<1>>> RootInstancesPerOwner;
+
+	void AddRootInstance(UFlowAsset* Instance, UObject* Owner);
+	void RemoveRootInstance(UFlowAsset* Instance);
+	const TArray<UFlowAsset*, TInlineAllocator<1>>* FindRootInstances(const UObject* Owner) const;
+
+public:
+	/* Root instances and their owners, valid until a root flow starts or finishes */
+	const TMap<TObjectPtr<UFlowAsset>, TWeakObjectPtr<UObject>>& GetRootInstancesView() const { return RootInstances; }
+
+	/* Root instances of the owner in starting order, valid until a root flow of this owner starts or finishes */
+	TConstArrayView<UFlowAsset*> GetRootInstancesViewByOwner(const UObject* Owner) const;
+
+	/**
+	 * Visits root instances and their owners without collecting them to the container
+	 * Function must not start or finish root flows, as that changes the visited map
+	 * 
+	 * @param Function Called for every root instance, return false to stop iterating
+	 * @return False if iteration was stopped by the Function
+	 */
+	bool ForEachRootInstance(TFunctionRef<bool(UFlowAsset& Instance, UObject* Owner)> Function) const;
+
+private:
+	/* Assets instanced by Sub Graph nodes */
+	UPROPERTY()
+	TMap<TObjectPtr<UFlowNode_SubGraph>, TObjectPtr<UFlowAsset>> InstancedSubFlows;
+
+#if !UE_BUILD_SHIPPING
+public:
+	/* Called after creating the first instance of given Flow Asset */
+	static FNativeFlowAssetEvent OnInstancedTemplateAdded;
+
+	/* Called just before removing the last instance of given Flow Asset */
+	static FNativeFlowAssetEvent OnInstancedTemplateRemoved;
+#endif
+
+protected:
+	UPROPERTY()
+	TObjectPtr<UFlowSaveGame> LoadedSaveGame;
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void AbortActiveFlows();
+
+	/* Start the root Flow, graph that will eventually instantiate next Flow Graphs through the SubGraph node */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true);
+
+	virtual UFlowAsset* CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true, const FString& NewInstanceName = FString());
+
+//////////////////////////////////////////////////////////////////////////
+// Root Flow start batch
+
+protected:
+	TArray<FFlowRootFlowStartRequest> PendingRootFlowStarts;
+
+	int32 RootFlowStartBatchDepth = 0;
+	FTSTicker::FDelegateHandle RootFlowStartBatchHandle;
+
+	/* Cached from settings on initialization, see UFlowSettings::bBatchRootFlowStartsPerFrame */
+	bool bBatchRootFlowStartsPerFrame = false;
+
+	bool TickRootFlowStartBatch(float DeltaTime);
+
+	/* Creates all requested Root Flows, then starts them */
+	void StartRootFlowRequests(const TArray<FFlowRootFlowStartRequest>& Requests);
+
+	/* Null Template Asset removes all requests of the owner */
+	void RemovePendingRootFlowStarts(const UObject* Owner, const UFlowAsset* TemplateAsset = nullptr);
+
+public:
+	/**
+	 * Root Flows started until the matching EndRootFlowStartBatch() are created together, and started after all of them exist
+	 * Use FFlowRootFlowStartBatchScope, i.e. around BeginPlay of a freshly streamed level
+	 */
+	void BeginRootFlowStartBatch();
+	void EndRootFlowStartBatch();
+
+	bool IsRootFlowStartBatched() const { return RootFlowStartBatchDepth > 0 || bBatchRootFlowStartsPerFrame; }
+
+	/* Creates and starts Root Flows requested in the batch */
+	void FlushRootFlowStartBatch();
+
+	bool HasPendingRootFlowStart(const UObject* Owner) const;
+
+	/* Creates and starts Root Flows of the owner requested in the batch, without waiting for the end of the batch */
+	void FlushPendingRootFlowStarts(const UObject* Owner);
+
+//////////////////////////////////////////////////////////////////////////
+
+public:
+
+	/* Finish Policy value is read by Flow Node
+	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
+	 * Example: Spawn node might despawn all actors if Flow Graph is aborted, not completed */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void FinishRootFlow(UObject* Owner, UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy);
+
+	/* Finish Policy value is read by Flow Node
+	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
+	 * Example: Spawn node might despawn all actors if Flow Graph is aborted, not completed */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void FinishAllRootFlows(UObject* Owner, const EFlowFinishPolicy FinishPolicy);
+
+	/* Finishes the given root instance, FinishRootFlow finishes the first instance of the template started by the owner */
+	void FinishRootInstance(UFlowAsset* Instance, const EFlowFinishPolicy FinishPolicy);
+
+	/* Aborts all Root Flows of the owner as one batch, used by FinishAllRootFlows with the Abort policy
+	 * Instances are removed from the owner and template bookkeeping once per batch, then returned to the pool */
+	void TeardownRootFlows(UObject* Owner);
+
+protected:
+	/* Sub Graph isn't started if it's loaded from the SaveGame, either by the legacy SavedInstanceName or bLoading */
+	UFlowAsset* CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedInstanceName = FString(), const bool bPreloading = false, const bool bLoading = false);
+	void RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlowFinishPolicy FinishPolicy);
+
+public:
+	/* Instance is named after the template unless NewInstanceName is provided, SaveGame identifies it by the instance id instead of the name */
+	UFlowAsset* CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, UFlowAsset* LoadedFlowAsset, FString NewInstanceName = FString());
+
+protected:
+	virtual void AddInstancedTemplate(UFlowAsset* Template);
+	virtual void RemoveInstancedTemplate(UFlowAsset* Template);
+
+//////////////////////////////////////////////////////////////////////////
+// Instance ids
+
+protected:
+	/* Serial of the next instance id and generated instance name, moved past serials of ids restored from the SaveGame */
+	uint32 NextInstanceSerial = 1;
+
+	/* Initialized instances by UFlowAsset::GetInstanceId */
+	TMap<uint64, UFlowAsset*> InstancesById;
+
+	/* Numbered name sharing the name table entry of the template name, so instances don't search for the free name */
+	FName MakeInstanceName(const UFlowAsset& Template, const uint32 InstanceSerial);
+
+	void AssignInstanceId(UFlowAsset& Instance, const UFlowAsset& Template, const uint32 InstanceSerial);
+	void UnregisterInstanceId(UFlowAsset& Instance);
+
+	/* Gives the loaded instance its saved id, unless another instance uses it already */
+	void RestoreInstanceId(UFlowAsset& Instance, const uint64 SavedInstanceId);
+
+public:
+	UFlowAsset* FindInstanceById(const uint64 InstanceId) const;
+
+	static uint32 GetTemplateIdOfInstance(const uint64 InstanceId) { return static_cast<uint32>(InstanceId >> 32); }
+	static uint32 GetSerialOfInstance(const uint64 InstanceId) { return static_cast<uint32>(InstanceId); }
+
+//////////////////////////////////////////////////////////////////////////
+// Instance pooling
+
+protected:
+	/* Finished instances per template, see UFlowAsset::MaxPooledInstances */
+	UPROPERTY()
+	TMap<TObjectPtr<UFlowAsset>, FFlowInstancePool> InstancePools;
+
+	UFlowAsset* AcquirePooledInstance(UFlowAsset* Template, const FString& NewInstanceName);
+
+public:
+	/* Called after finishing and deinitializing the instance, returns true if instance has been pooled */
+	virtual bool ReleaseFlowInstance(UFlowAsset* Instance, UFlowAsset* Template);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void ClearInstancePools();
+
+//////////////////////////////////////////////////////////////////////////
+// Injected component pooling
+
+protected:
+	/* Removed injected components per archetype, see UFlowNode_ExecuteComponent::MaxPooledComponents */
+	UPROPERTY()
+	TArray<FFlowInjectedComponentPool> InjectedComponentPools;
+
+	FFlowInjectedComponentPool* FindInjectedComponentPool(const UActorComponent& Archetype);
+
+public:
+	/* Returns component pooled for the template or class defaults, preferring the one pooled on the same actor */
+	UActorComponent* AcquirePooledComponent(AActor& Actor, const UActorComponent& Archetype);
+
+	/* Called instead of destroying the removed injected component, returns true if component has been pooled */
+	bool ReleaseComponentToPool(UActorComponent& Component, const UActorComponent& Archetype, const int32 MaxPooledComponents);
+
+	bool IsPooledComponent(const UActorComponent& Component, const UActorComponent& Archetype) const;
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void ClearInjectedComponentPools();
+
+	/* Sequence player pooling moved to UFlowLevelSequenceSubsystem, this forwards the call if the FlowLevelSequence module is loaded */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DeprecatedFunction, DeprecationMessage="Use ClearSequencePlayerPools() of the Flow Level Sequence Subsystem instead."))
+	void ClearSequencePlayerPools();
+
+//////////////////////////////////////////////////////////////////////////
+// Template warmup
+
+protected:
+	/* Templates of the latest warmup, kept loaded even if their pools are disabled */
+	UPROPERTY()
+	TArray<TObjectPtr<UFlowAsset>> WarmedTemplates;
+
+	/* Content dependencies of warmed templates */
+	TArray<TSharedPtr<FStreamableHandle>> WarmupContentHandles;
+
+	FDelegateHandle WorldInitializedActorsHandle;
+
+	/* Warms up templates listed by AFlowWorldSettings of the world being loaded */
+	void OnWorldInitializedActors(const FActorsInitializedParams& Params);
+
+public:
+	/* Loads, compiles and pre-pools templates, so their first StartRootFlow or Sub Graph doesn't hitch. Replaces the previous warmup list */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void WarmupTemplates(const TArray<FFlowTemplateWarmup>& Warmups);
+
+	virtual void WarmupTemplate(UFlowAsset* Template, const int32 PooledInstances);
+
+	/* Requests all content cooked into UFlowAsset::ContentDependencies as a single async load, content stays loaded while the handle is held */
+	TSharedPtr<FStreamableHandle> RequestContentDependencies(const UFlowAsset* Template) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Shared preloads
+
+protected:
+	/* Assets requested by PreloadContent of nodes, shared by all nodes and instances referencing the same asset */
+	TMap<FSoftObjectPath, FFlowSharedPreload> SharedPreloads;
+
+	void OnSharedPreloadCompleted(const FSoftObjectPath Path);
+
+	/* Sum of ResidentBytes of all shared preloads */
+	int64 SharedPreloadBytes = 0;
+
+	FTSTicker::FDelegateHandle PreloadEvictionTickerHandle;
+
+	/* Flushes preloaded nodes past UFlowSettings::PreloadedNodeTimeout, then the least recently used ones while over PreloadedContentBudgetMB */
+	bool EvictPreloadedContent(float DeltaTime);
+
+	FTSTicker::FDelegateHandle HibernationTickerHandle;
+
+	/* Releases inactive nodes of instances idle for UFlowSettings::InstanceHibernationDelay */
+	bool HibernateIdleInstances(float DeltaTime);
+
+	FTSTicker::FDelegateHandle LiveStatsTickerHandle;
+
+	/* Sets counters of live instances, nodes and components for "stat flow" and CSV captures */
+	bool PublishLiveStats(float DeltaTime);
+
+public:
+	/* Starts async loading of the asset or references the pending and completed load. Every call has to be paired with ReleasePreload */
+	void AcquirePreload(const FSoftObjectPath& Path);
+	void ReleasePreload(const FSoftObjectPath& Path);
+
+	bool IsPreloaded(const FSoftObjectPath& Path) const;
+	int64 GetSharedPreloadBytes() const { return SharedPreloadBytes; }
+
+protected:
+	void ClearSharedPreloads();
+
+//////////////////////////////////////////////////////////////////////////
+
+public:
+	/* Returns all assets instanced by object from another system like World Settings. Builds a new map, prefer ForEachRootInstance or GetRootInstancesNum */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	TMap<UObject*, UFlowAsset*> GetRootInstances() const;
+	
+	/* Returns asset instanced by specific object. Builds a new set, prefer GetRootInstancesViewByOwner or GetRootInstanceByOwner */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	TSet<UFlowAsset*> GetRootInstancesByOwner(const UObject* Owner) const;
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	int32 GetRootInstancesNum() const { return RootInstances.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	int32 GetRootInstancesNumByOwner(const UObject* Owner) const { return GetRootInstancesViewByOwner(Owner).Num(); }
+
+	/* Returns the root instance started by the owner, in starting order. Null if the Index is out of range */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	UFlowAsset* GetRootInstanceByOwner(const UObject* Owner, const int32 Index = 0) const;
+
+	/* Returns the root instance of the template started by the owner, if any */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	UFlowAsset* FindRootInstanceByTemplate(const UObject* Owner, const UFlowAsset* TemplateAsset) const;
+
+	/* Returns the object which started the root instance, null for other instances or destroyed owners */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	UObject* GetRootInstanceOwner(const UFlowAsset* Instance) const;
+
+	bool IsRootInstance(const UFlowAsset* Instance) const { return RootInstances.Contains(Instance); }
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeprecatedFunction, DeprecationMessage="Use GetRootInstancesByOwner() instead."))
+	UFlowAsset* GetRootFlow(const UObject* Owner) const;
+
+	/* Returns assets instanced by Sub Graph nodes */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const TMap<UFlowNode_SubGraph*, UFlowAsset*>& GetInstancedSubFlows() const { return ObjectPtrDecay(InstancedSubFlows); }
+
+	virtual UWorld* GetWorld() const override;
+
+//////////////////////////////////////////////////////////////////////////
+// Trigger queue
+
+protected:
+	/* Flow Asset instances with queued pin activations carried over to the next frame */
+	TArray<TWeakObjectPtr<UFlowAsset>> DeferredTriggerQueues;
+
+	FTSTicker::FDelegateHandle DeferredTriggerQueuesHandle;
+
+	/* Time spent on draining trigger queues in the TriggerQueueBudgetFrame, see UFlowSettings::TriggerQueueFrameBudget */
+	double TriggerQueueBudgetUsed = 0.0;
+	uint64 TriggerQueueBudgetFrame = 0;
+
+	/* Nested drains happen if draining one instance starts another one, i.e. through the SubGraph node */
+	double TriggerQueueDrainStartTime = 0.0;
+	int32 TriggerQueueDrainDepth = 0;
+
+public:
+	/* Continue draining trigger queue of this instance in the next frame */
+	void DeferTriggerQueue(UFlowAsset* FlowInstance);
+
+	void BeginTriggerQueueDrain();
+	void EndTriggerQueueDrain();
+	bool IsTriggerQueueFrameBudgetExceeded() const;
+
+protected:
+	bool TickDeferredTriggerQueues(float DeltaTime);
+
+	/* Drains instances supporting isolated execution in parallel and removes them from the array, see UFlowAsset::bIsolatedExecution */
+	void DrainIsolatedTriggerQueues(TArray<TWeakObjectPtr<UFlowAsset>>& InOutQueuesToDrain);
+
+//////////////////////////////////////////////////////////////////////////
+// Timers
+
+protected:
+	/* Timers of Flow nodes, advanced by the world time once per frame after actors tick */
+	FFlowTimerWheel TimerWheel;
+
+	FDelegateHandle WorldPostActorTickHandle;
+
+	/* World time seen by the latest tick, timers don't advance while the world is paused */
+	TWeakObjectPtr<UWorld> TimerWorld;
+	double LastTimerWorldTime = 0.0;
+
+	void TickTimers(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+public:
+	/* Works like FTimerManager::SetTimer, but the timer is owned by the Flow Asset instance, so all timers of the graph can be paused together */
+	FFlowTimerHandle SetFlowTimer(const UFlowAsset* FlowInstance, FFlowTimerDelegate&& Delegate, const float Rate, const bool bLoop, const float FirstDelay = -1.f);
+	FFlowTimerHandle SetFlowTimerForNextTick(const UFlowAsset* FlowInstance, FFlowTimerDelegate&& Delegate);
+
+	void ClearFlowTimer(FFlowTimerHandle& Handle);
+
+	/* Clears all timers of the instance and its paused state, called on deinitializing the instance */
+	void ClearFlowTimers(const UFlowAsset* FlowInstance);
+
+	/* Advances timers of the instance by DeltaTime within this call, see FFlowTimerWheel::FastForwardTimers. Returns the number of fired timers */
+	int32 FastForwardFlowTimers(const UFlowAsset* FlowInstance, const float DeltaTime);
+
+	float GetFlowTimerRemaining(const FFlowTimerHandle& Handle) const { return TimerWheel.GetTimerRemaining(Handle); }
+	float GetFlowTimerElapsed(const FFlowTimerHandle& Handle) const { return TimerWheel.GetTimerElapsed(Handle); }
+
+	/* Freezes all timers of the instance, including timers set while paused. Sub Graphs are separate instances */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void PauseFlowTimers(UFlowAsset* FlowInstance);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void UnPauseFlowTimers(UFlowAsset* FlowInstance);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	bool AreFlowTimersPaused(const UFlowAsset* FlowInstance) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Significance
+
+protected:
+	/* Returns significance of the instance owner in the 0-1 range, i.e. by USignificanceManager::GetSignificance */
+	FFlowSignificanceCallback SignificanceCallback;
+
+	FTSTicker::FDelegateHandle SignificanceTickerHandle;
+
+	/* Instances with timers paused by significance, so timers paused through PauseFlowTimers aren't resumed by it */
+	TSet<FObjectKey> SignificancePausedInstances;
+
+	bool UpdateSignificance(float DeltaTime);
+
+public:
+	/* Evaluated for all instances every UFlowSettings::SignificanceUpdateInterval, unbound callback restores full significance of all instances */
+	void SetSignificanceCallback(FFlowSignificanceCallback&& Callback);
+
+	/**
+	 * Throttles or pauses the instance below significance thresholds of the Flow Settings
+	 * Throttled instance fires timers at ThrottledTimerInterval and executes up to ThrottledQueuedTriggersPerFrame queued activations per frame
+	 * Paused instance freezes timers and keeps queued activations, both catch up once significance rises. Sub Graphs are separate instances
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void SetFlowSignificance(UFlowAsset* FlowInstance, const float Significance);
+
+//////////////////////////////////////////////////////////////////////////
+// Event bus
+
+protected:
+	/* Nodes waiting for events of components with specific Identity Tags */
+	FFlowEventBus EventBus;
+
+public:
+	FFlowEventBus& GetEventBus() { return EventBus; }
+
+	/* Wakes waiters parked on Identity Tags of the component or their parents, cheap if nothing waits */
+	void BroadcastComponentEvent(const EFlowEventType Type, UFlowComponent* Component, const FGameplayTag& NotifyTag, UFlowComponent* Sender = nullptr);
+
+//////////////////////////////////////////////////////////////////////////
+// Posted events
+
+protected:
+	/* Events posted from any thread, executed in the posting order by the game thread at the start of the next frame */
+	TQueue<FFlowPostedEvent, EQueueMode::Mpsc> PostedEvents;
+
+	FTSTicker::FDelegateHandle PostedEventsTickerHandle;
+
+	bool DrainPostedEvents(float DeltaTime);
+
+public:
+	/* Thread-safe and lock-free, calls UFlowComponent::NotifyGraph on the game thread */
+	void PostNotifyFromAnyThread(UFlowComponent* Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+
+	/* Thread-safe and lock-free, calls UFlowAsset::TriggerCustomInput on the game thread */
+	void PostCustomInputFromAnyThread(UFlowAsset* FlowInstance, const FName& EventName);
+
+//////////////////////////////////////////////////////////////////////////
+// Node ticking
+
+protected:
+	/* One tick function per tick group used by tickable nodes, allocated separately as the world keeps pointers to them */
+	TArray<TUniquePtr<FFlowNodeTickFunction>> NodeTickFunctions;
+
+	FFlowNodeTickFunction& FindOrAddNodeTickFunction(const ETickingGroup TickGroup);
+
+public:
+	/* Called by UFlowNodeTickable, when the node enables its tick */
+	void RegisterTickableNode(UFlowNodeTickable* Node);
+	void UnregisterTickableNode(UFlowNodeTickable* Node);
+
+	void TickNodes(FFlowNodeTickFunction& TickFunction, const float DeltaTime);
+
+private:
+	void CompactNodeTickFunction(FFlowNodeTickFunction& TickFunction);
+
+//////////////////////////////////////////////////////////////////////////
+// Coroutines
+
+protected:
+	/* Frames of coroutines run by UFlowNodeCoroutine, reused across nodes and instances */
+	FFlowCoroutineFramePool CoroutineFramePool;
+
+public:
+	FFlowCoroutineFramePool& GetCoroutineFramePool() { return CoroutineFramePool; }
+
+//////////////////////////////////////////////////////////////////////////
+// SaveGame support
+
+protected:
+	/* Records of the LoadedSaveGame by the instance name, in the order of the records. Only records written before instance ids are named */
+	TMap<FString, TArray<const FFlowAssetSaveData*>> LoadedFlowInstanceRecords;
+
+	/* Records of the LoadedSaveGame by the instance id, in the order of the records */
+	TMap<uint64, TArray<const FFlowAssetSaveData*>> LoadedFlowInstanceRecordsById;
+
+	/* Records of the LoadedSaveGame by the world name and the actor instance name */
+	TMap<TPair<FString, FString>, const FFlowComponentSaveData*> LoadedFlowComponentRecords;
+
+	/* Level groups of the LoadedSaveGame decoded so far, by the level name */
+	TMap<FString, FFlowLevelRecords> LoadedLevelRecords;
+
+	FDelegateHandle LevelRemovedFromWorldHandle;
+
+	void BuildLoadedSaveGameIndex();
+	void AddToLoadedSaveGameIndex(const TArray<FFlowAssetSaveData>& FlowInstances, const TArray<FFlowComponentSaveData>& FlowComponents);
+
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+	/* Flow Asset instances collected by OnGameSaved, to be serialized in parallel (see UFlowSettings::bParallelSaveGame) */
+	TArray<FFlowAssetPendingSave> PendingParallelSaves;
+	bool bCollectingParallelSaves = false;
+
+	/* Whether the component class adds anything to save on top of UFlowComponent, computed once per class */
+	TMap<TObjectKey<UClass>, bool> ComponentClassSaveGameStates;
+
+public:
+	bool HasComponentClassSaveGameState(const UClass* ComponentClass);
+
+public:
+	// Called by Flow Asset instances while saving, returns true if the subsystem takes over their serialization
+	bool TryDeferSaveSerialization(TArray<FFlowAssetPendingSave>& PendingSaves);
+
+public:
+	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
+	FSimpleFlowEvent OnSaveGame;
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void OnGameSaved(UFlowSaveGame* SaveGame);
+
+	/**
+	 * Snapshots Flow Graphs into the SaveGame on the game thread and writes it to its slot on a worker thread
+	 * OnWritten is executed on the game thread after the write completes
+	 * Requests made while the same slot is being written are coalesced, the latest one is snapshotted once the write finishes
+	 */
+	void AsyncSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, const FNativeFlowSaveGameWritten& OnWritten = FNativeFlowSaveGameWritten());
+
+	bool IsSavingToSlot(const FString& SlotName, const int32 UserIndex) const;
+
+protected:
+	void StartSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, TArray<FNativeFlowSaveGameWritten>&& OnWritten);
+	void OnSaveGameToSlotWritten(const FString& SlotName, const int32 UserIndex, const bool bSuccess, TArray<FNativeFlowSaveGameWritten> OnWritten);
+
+	static FString GetSlotSaveKey(const FString& SlotName, const int32 UserIndex) { return FString::Printf(TEXT("%s:%d"), *SlotName, UserIndex); }
+
+	/* Slots being written by AsyncSaveGameToSlot */
+	TSet<FString> SlotSavesInProgress;
+
+	UPROPERTY(Transient)
+	TMap<FString, FFlowQueuedSlotSave> QueuedSlotSaves;
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void OnGameLoaded(UFlowSaveGame* SaveGame);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName, const bool bAllowMultipleInstances);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedAssetInstanceName);
+
+	/* Loads the record written with the instance id, see UFlowAsset::GetInstanceId */
+	virtual void LoadRootFlowById(UObject* Owner, UFlowAsset* FlowAsset, const uint64 SavedAssetInstanceId, const bool bAllowMultipleInstances);
+	virtual void LoadSubFlowById(UFlowNode_SubGraph* SubGraphNode, const uint64 SavedAssetInstanceId);
+
+	/* Replaces the Root Flow of the owner with the replay records, see UFlowSettings::bRecordFlowStateInReplays. Zero id only finishes the instance */
+	virtual void LoadReplayFlowState(UObject* Owner, UFlowAsset* FlowAsset, const uint64 RootInstanceId, TArray<FFlowAssetSaveData>&& FlowInstances);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	UFlowSaveGame* GetLoadedSaveGame() const { return LoadedSaveGame; }
+
+	/* Finds the record in the LoadedSaveGame, empty WorldName matches record of any world */
+	const FFlowAssetSaveData* FindLoadedFlowInstance(const FString& InstanceName, const FString& WorldName) const;
+	const FFlowAssetSaveData* FindLoadedFlowInstanceById(const uint64 InstanceId, const FString& WorldName) const;
+	const FFlowComponentSaveData* FindLoadedFlowComponent(const FString& WorldName, const FString& ActorInstanceName) const;
+
+	/* Decodes the LoadedSaveGame group of the streaming level, so its records can be found. Does nothing if already decoded */
+	void LoadLevelSaveData(const ULevel* Level);
+
+	/* Name of the save group, empty for the persistent level which isn't grouped */
+	static FString GetSaveLevelName(const ULevel* Level);
+
+//////////////////////////////////////////////////////////////////////////
+// Component Registry
+
+protected:
+	/* All the Flow Components currently existing in the world, tag buckets below store indices to this array */
+	UPROPERTY()
+	TArray<FFlowComponentRegistrySlot> ComponentSlots;
+
+	TArray<int32> FreeComponentSlots;
+	TMap<TObjectKey<UFlowComponent>, int32> ComponentSlotIndices;
 
-	friend class UFlowAsset;
-	friend class UFlowComponent;
-	friend class UFlowNode_SubGraph;
+	/* Components registered with exactly this tag, its count lets multi-tag queries start from the most selective tag */
+	TMap<FGameplayTag, TArray<int32>> ComponentSlotsPerTag;
 
-private:
-	/* All asset templates with active instances */
-	UPROPERTY()
-	TArray<TObjectPtr<UFlowAsset>> InstancedTemplates;
+	/* Components registered under the tag or any of its child tags, used by non-exact queries */
+	TMap<FGameplayTag, TArray<int32>> ComponentSlotsUnderTag;
 
-	/* Assets instanced by object from another system, i.e. World Settings or Player Controller */
-	UPROPERTY()
-	TMap<TObjectPtr<UFlowAsset>, TWeakObjectPtr<UObject>> RootInstances;
+	/* Components registered with exactly this tag, grouped by the component class, see UFlowSettings::bPartitionComponentRegistryByClass */
+	TMap<FGameplayTag, TMap<const UClass*, TArray<int32>>> ComponentSlotsPerClass;
 
-	/* Assets instanced by Sub Graph nodes */
-	UPROPERTY()
-	TMap<TObjectPtr<UFlowNode_SubGraph>, TObjectPtr<UFlowAsset>> InstancedSubFlows;
+	/* Cached from settings on initialization, so the partitions stay consistent with the registry */
+	bool bPartitionRegistryByClass = false;
 
-#if !UE_BUILD_SHIPPING
-public:
-	/* Called after creating the first instance of given Flow Asset */
-	static FNativeFlowAssetEvent OnInstancedTemplateAdded;
+	/* Registry buckets per world, removed once the last component of the world unregisters */
+	TMap<TObjectKey<UWorld>, FFlowComponentRegistryShard> RegistryShards;
+	bool bShardRegistryByWorld = false;
 
-	/* Called just before removing the last instance of given Flow Asset */
-	static FNativeFlowAssetEvent OnInstancedTemplateRemoved;
-#endif
+	/* Null World returns buckets of all worlds */
+	const TArray<int32>* FindComponentSlots(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch) const;
 
-protected:
+	/* Components registered inside the registration batch, waiting for the coalesced broadcast */
 	UPROPERTY()
-	TObjectPtr<UFlowSaveGame> LoadedSaveGame;
+	TArray<TObjectPtr<UFlowComponent>> PendingRegisteredComponents;
 
-public:
-	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	/* Components of PendingRegisteredComponents still waiting for the broadcast, the array might contain unregistered or duplicate entries */
+	TSet<const UFlowComponent*> PendingRegisteredComponentsSet;
 
-	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
-	virtual void Deinitialize() override;
+	int32 ComponentRegistrationBatchDepth = 0;
+	FTSTicker::FDelegateHandle ComponentRegistrationBatchHandle;
 
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
-	virtual void AbortActiveFlows();
+	/* Cached from settings on initialization, see UFlowSettings::bBatchComponentRegistrationPerFrame */
+	bool bBatchRegistrationPerFrame = false;
 
-	/* Start the root Flow, graph that will eventually instantiate next Flow Graphs through the SubGraph node */
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
-	virtual void StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true);
+	TSparseArray<FFlowComponentListener> ComponentListeners;
 
-	virtual UFlowAsset* CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true, const FString& NewInstanceName = FString());
+	/* Listeners routed by the filter tag, listeners with All match type are routed by their first tag only */
+	TMap<FGameplayTag, TArray<int32>> ComponentListenersPerTag;
+	TArray<int32> UnfilteredComponentListeners;
 
-	/* Finish Policy value is read by Flow Node
-	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
-	 * Example: Spawn node might despawn all actors if Flow Graph is aborted, not completed */
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
-	virtual void FinishRootFlow(UObject* Owner, UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy);
+private:
+	void AddToComponentRegistry(const FGameplayTag& Tag, UFlowComponent* Component);
+	void RemoveFromComponentRegistry(const FGameplayTag& Tag, UFlowComponent* Component);
+	void RemoveSlotTag(const int32 SlotIndex, const FGameplayTag& Tag);
 
-	/* Finish Policy value is read by Flow Node
-	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
-	 * Example: Spawn node might despawn all actors if Flow Graph is aborted, not completed */
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
-	virtual void FinishAllRootFlows(UObject* Owner, const EFlowFinishPolicy FinishPolicy);
+	int32 AcquireComponentSlot(UFlowComponent* Component);
+	void ReleaseComponentSlot(const int32 SlotIndex);
 
-protected:
-	UFlowAsset* CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedInstanceName = FString(), const bool bPreloading = false);
-	void RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlowFinishPolicy FinishPolicy);
+	bool VisitComponentSlots(const TArray<int32>& SlotIndices, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	void BroadcastComponentRegistered(UFlowComponent* Component);
+	void BroadcastComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags);
+	void BroadcastComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags);
+	void BroadcastComponentUnregistered(UFlowComponent* Component, const FGameplayTagContainer& RegisteredTags);
+	void ScheduleComponentRegistrationBatch();
+	bool TickComponentRegistrationBatch(float DeltaTime);
+
+	void NotifyComponentListeners(const FGameplayTagContainer& ComponentTags, TFunctionRef<void(const FFlowComponentListener&)> Notify) const;
+
+	/* Dispatches events of region listeners and live queries queued while updating the registry */
+	void DispatchRegistryEvents();
+	void CollectComponentListeners(const FGameplayTagContainer& ComponentTags, TArray<TPair<int32, FDelegateHandle>, TInlineAllocator<16>>& OutListeners) const;
 
 public:
-	UFlowAsset* CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, UFlowAsset* LoadedFlowAsset, FString NewInstanceName = FString());
+	/**
+	 * Registration events of components registered until the matching EndComponentRegistrationBatch() are coalesced
+	 * Registry is updated immediately, so queries inside the batch already return these components
+	 * Use FFlowComponentRegistrationBatchScope, i.e. around spawning many actors at once
+	 */
+	void BeginComponentRegistrationBatch();
+	void EndComponentRegistrationBatch();
+
+	bool IsComponentRegistrationBatched() const { return ComponentRegistrationBatchDepth > 0 || bBatchRegistrationPerFrame; }
+
+	/* Broadcasts registration events of components registered in the batch */
+	void FlushComponentRegistrationBatch();
+
+	/**
+	 * Subscribes to events of components matching the listener's filter only
+	 * Cheaper than binding the dynamic events below, as events aren't delivered to every listener in the world
+	 * @return Handle required to remove the listener
+	 */
+	FDelegateHandle AddComponentListener(const FFlowComponentListener& Listener);
+	void RemoveComponentListener(FDelegateHandle& Handle);
 
 protected:
-	virtual void AddInstancedTemplate(UFlowAsset* Template);
-	virtual void RemoveInstancedTemplate(UFlowAsset* Template);
+	TSparseArray<FFlowComponentLiveQuery> LiveQueries;
+	TSparseArray<FFlowComponentLiveQueryFilter> LiveQueryFilters;
 
-public:
-	/* Returns all assets instanced by object from another system like World Settings */
-	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
-	TMap<UObject*, UFlowAsset*> GetRootInstances() const;
-	
-	/* Returns asset instanced by specific object */
-	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
-	TSet<UFlowAsset*> GetRootInstancesByOwner(const UObject* Owner) const;
+	/* Live query filters routed by the query tag, filters with All match type are routed by their first tag only */
+	TMap<FGameplayTag, TArray<int32>> LiveQueryFiltersPerTag;
 
-	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeprecatedFunction, DeprecationMessage="Use GetRootInstancesByOwner() instead."))
-	UFlowAsset* GetRootFlow(const UObject* Owner) const;
+	/* Filters with tag queries matching components without any of the referenced tags, refreshed on every registry change */
+	TArray<int32> UnroutedLiveQueryFilters;
+	TArray<FFlowComponentRegistryEvent> PendingLiveQueryEvents;
 
-	/* Returns assets instanced by Sub Graph nodes */
-	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
-	const TMap<UFlowNode_SubGraph*, UFlowAsset*>& GetInstancedSubFlows() const { return ObjectPtrDecay(InstancedSubFlows); }
+	/* Queries created inside the live query batch, waiting to be resolved against the registry */
+	TArray<int32> PendingLiveQueryResolves;
+	int32 LiveQueryBatchDepth = 0;
 
-	virtual UWorld* GetWorld() const override;
+private:
+	void RefreshLiveQueries(const int32 SlotIndex, const FGameplayTag& ChangedTag);
 
-//////////////////////////////////////////////////////////////////////////
-// SaveGame support
+	/* Resolves queries created inside the batch, queries with the same tags and match type share one registry pass */
+	void ResolvePendingLiveQueries();
 
-	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
-	FSimpleFlowEvent OnSaveGame;
+	int32 FindOrAddLiveQueryFilter(const FFlowComponentLiveQuery& Query);
+	void ResolveLiveQueryFilter(FFlowComponentLiveQueryFilter& Filter);
 
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
-	virtual void OnGameSaved(UFlowSaveGame* SaveGame);
+public:
+	/**
+	 * Creates the query, which result is kept up to date by the registry
+	 * Reading the result is free, use it instead of repeating the same GetComponents() call or tracking component events
+	 */
+	FFlowComponentLiveQueryHandle CreateLiveQuery(const FFlowComponentLiveQuery& Query);
+	void DestroyLiveQuery(FFlowComponentLiveQueryHandle& Handle);
 
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
-	virtual void OnGameLoaded(UFlowSaveGame* SaveGame);
+	/**
+	 * Queries created until the matching EndLiveQueryBatch() are resolved together once the batch ends
+	 * Their result is empty inside the batch, matching components are delivered by OnComponentAdded instead
+	 * Used while loading the SaveGame, as every loaded observer creates its query, use FFlowLiveQueryBatchScope
+	 */
+	void BeginLiveQueryBatch();
+	void EndLiveQueryBatch();
 
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
-	virtual void LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName, const bool bAllowMultipleInstances);
+	bool IsLiveQueryBatched() const { return LiveQueryBatchDepth > 0; }
 
-	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
-	virtual void LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString& SavedAssetInstanceName);
+	/* Returns nullptr if the handle is invalid or the query isn't resolved yet, pointer is valid until the registry changes */
+	const TSet<TWeakObjectPtr<UFlowComponent>>* GetLiveQueryComponents(const FFlowComponentLiveQueryHandle& Handle) const;
 
-	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
-	UFlowSaveGame* GetLoadedSaveGame() const { return LoadedSaveGame; }
+	int32 GetLiveQueriesNum() const { return LiveQueries.Num(); }
+	int32 GetLiveQueryFiltersNum() const { return LiveQueryFilters.Num(); }
 
-//////////////////////////////////////////////////////////////////////////
-// Component Registry
+	FFlowComponentHandle GetComponentHandle(const UFlowComponent* Component) const;
+	UFlowComponent* ResolveComponentHandle(const FFlowComponentHandle& Handle) const;
+
+	/* Releases slots of components destroyed without unregistering, called on the next tick after garbage collection */
+	void RemoveStaleComponents();
 
 protected:
-	/* All the Flow Components currently existing in the world */
-	TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>> FlowComponentRegistry;
+	FDelegateHandle PostGarbageCollectHandle;
+	FTSTicker::FDelegateHandle StaleComponentsTickerHandle;
+
+	/* Slots are cleared by the garbage collector, delegates of registry events aren't safe to call from its callback */
+	void OnPostGarbageCollect();
+	bool TickRemoveStaleComponents(float DeltaTime);
+
+public:
+	/* True on clients with bCosmeticFlowsOnlyOnClients enabled, only cosmetic assets and components are handled then */
+	bool IsCosmeticOnly() const;
 
 protected:
+	/* False for non-cosmetic components in the cosmetic-only mode, these never enter the registry */
+	bool ShouldRegisterComponent(const UFlowComponent* Component) const;
+
 	virtual void RegisterComponent(UFlowComponent* Component);
 	virtual void OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag);
 	virtual void OnIdentityTagsAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags);
@@ -160,6 +1124,11 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
 	FSimpleFlowComponentEvent OnComponentRegistered;
 
+	/* Called once for all components registered in the registration batch, or for every component registered outside of the batch
+	 * Called before OnComponentRegistered of the same components, bind only one of these */
+	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
+	FMultipleFlowComponentsEvent OnComponentsRegistered;
+
 	/* Called after adding Identity Tags to already registered Flow Component
 	 * This can happen only after Begin Play occured in the component */
 	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
@@ -174,12 +1143,20 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
 	FTaggedFlowComponentEvent OnComponentTagRemoved;
 
+	/* Native counterparts of the events above, called before them
+	 * Cheaper to broadcast and bind lambdas or raw C++ objects, prefer these or AddComponentListener() in C++ */
+	FNativeSimpleFlowComponentMulticastEvent OnComponentRegisteredNative;
+	FNativeMultipleFlowComponentsMulticastEvent OnComponentsRegisteredNative;
+	FNativeTaggedFlowComponentMulticastEvent OnComponentTagAddedNative;
+	FNativeSimpleFlowComponentMulticastEvent OnComponentUnregisteredNative;
+	FNativeTaggedFlowComponentMulticastEvent OnComponentTagRemovedNative;
+
 	/**
 	 * Returns all registered Flow Components identified by given tag
 	 * 
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
 	 * @param ComponentClass Only components matching this class we'll be returned
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ComponentClass"))
 	TSet<UFlowComponent*> GetFlowComponentsByTag(const FGameplayTag Tag, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch = true) const;
@@ -190,17 +1167,26 @@ public:
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
 	 * @param ComponentClass Only components matching this class we'll be returned
-	* @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	* @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ComponentClass"))
 	TSet<UFlowComponent*> GetFlowComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch = true) const;
 
+	/**
+	 * Returns all registered Flow Components which Identity Tags match the query
+	 * 
+	 * @param TagQuery Query tested against Identity Tags of components registered with any of the tags it references
+	 * @param ComponentClass Only components matching this class we'll be returned
+	 */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ComponentClass"))
+	TSet<UFlowComponent*> GetFlowComponentsByTagQuery(const FGameplayTagQuery& TagQuery, const TSubclassOf<UFlowComponent> ComponentClass) const;
+
 	/**
 	 * Returns all registered actors with Flow Component identified by given tag
 	 * 
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
 	 * @param ActorClass Only actors matching this class we'll be returned
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ActorClass"))
 	TSet<AActor*> GetFlowActorsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch = true) const;
@@ -211,7 +1197,7 @@ public:
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
 	 * @param ActorClass Only actors matching this class we'll be returned
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ActorClass"))
 	TSet<AActor*> GetFlowActorsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch = true) const;
@@ -221,7 +1207,7 @@ public:
 	 * 
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
 	 * @param ActorClass Only actors matching this class we'll be returned
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ActorClass"))
 	TMap<AActor*, UFlowComponent*> GetFlowActorsAndComponentsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch = true) const;
@@ -232,37 +1218,119 @@ public:
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
 	 * @param ActorClass Only actors matching this class we'll be returned
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ActorClass"))
 	TMap<AActor*, UFlowComponent*> GetFlowActorsAndComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch = true) const;
 
+	/**
+	 * Visits registered Flow Components identified by given tag, without collecting them to the container
+	 * Every matching component is visited once, Function must not register or unregister components
+	 * 
+	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching
+	 * @param Function Called for every matching component, return false to stop iterating
+	 * @return False if iteration was stopped by the Function
+	 */
+	bool ForEachComponent(const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/**
+	 * Visits registered Flow Components identified by Any or All provided tags, without collecting them to the container
+	 * Every matching component is visited once, Function must not register or unregister components
+	 * 
+	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
+	 * @param MatchType If Any, visited component needs to have only one of given tags. If All, component needs to have all given Identity Tags
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching
+	 * @param Function Called for every matching component, return false to stop iterating
+	 * @return False if iteration was stopped by the Function
+	 */
+	bool ForEachComponent(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/* Visits registered Flow Components which Identity Tags match the compiled query, Function must not register or unregister components */
+	bool ForEachComponentMatchingQuery(const FFlowCompiledTagQuery& TagQuery, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/* ForEachComponent limited to components of the given world, uses only the world's shard if UFlowSettings::bShardComponentRegistryByWorld is enabled */
+	bool ForEachComponentInWorld(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const;
+	bool ForEachComponentInWorld(const UWorld* World, const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/* Registry shard of the world, nullptr if sharding is disabled or the world has no registered components */
+	const FFlowComponentRegistryShard* FindRegistryShard(const UWorld* World) const { return RegistryShards.Find(World); }
+
+	/**
+	 * Sends every Notify Tag to components identified exactly by its Actor Tag, like calling NotifyFromGraph per pair
+	 * Targets of all pairs are resolved in one registry pass, and every component receives all its Notify Tags in a single NotifyFromGraph call,
+	 * so components matched by several pairs are notified once and replicate one notify
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void BatchNotifyActors(const TArray<FFlowActorNotify>& Notifies, const EFlowNetMode NetMode = EFlowNetMode::Authority) const;
+
+	/* Notifies only components of the given world, all worlds if null */
+	void BatchNotifyActorsInWorld(const UWorld* World, const TArray<FFlowActorNotify>& Notifies, const EFlowNetMode NetMode = EFlowNetMode::Authority) const;
+
+	/* Count of registered components identified by given tag, cheap to call */
+	int32 GetComponentCount(const FGameplayTag& Tag, const bool bExactMatch = true) const;
+
+	/* Cheap to call only with sharding enabled, otherwise it checks the world of every component with the tag */
+	int32 GetComponentCountInWorld(const UWorld* World, const FGameplayTag& Tag, const bool bExactMatch = true) const;
+
+	/**
+	 * Visits registered Flow Components of given class identified by given tag
+	 * Exact tag queries visit only the matching class partitions, if the registry is partitioned by class
+	 * 
+	 * @param ComponentClass Only components matching this class will be visited
+	 */
+	bool ForEachComponentOfClass(const FGameplayTag& Tag, const bool bExactMatch, const UClass* ComponentClass, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/**
+	 * Visits registered Flow Components of given class identified by given tag
+	 * @tparam T Only components matching this class will be visited
+	 */
+	template <class T>
+	bool ForEachComponentOfClass(const FGameplayTag& Tag, const bool bExactMatch, TFunctionRef<bool(T&)> Function) const
+	{
+		static_assert(TPointerIsConvertibleFromTo<T, const UActorComponent>::Value, "'T' template parameter to ForEachComponentOfClass must be derived from UActorComponent");
+
+		return ForEachComponentOfClass(Tag, bExactMatch, T::StaticClass(), [&Function](UFlowComponent& Component)
+		{
+			T* ComponentOfClass = Cast<T>(&Component);
+			return ComponentOfClass == nullptr || Function(*ComponentOfClass);
+		});
+	}
+
+	/**
+	 * Visits registered Flow Components of given class identified by Any or All provided tags
+	 * @tparam T Only components matching this class will be visited
+	 */
+	template <class T>
+	bool ForEachComponentOfClass(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TFunctionRef<bool(T&)> Function) const
+	{
+		static_assert(TPointerIsConvertibleFromTo<T, const UActorComponent>::Value, "'T' template parameter to ForEachComponentOfClass must be derived from UActorComponent");
+
+		return ForEachComponent(Tags, MatchType, bExactMatch, [&Function](UFlowComponent& Component)
+		{
+			T* ComponentOfClass = Cast<T>(&Component);
+			return ComponentOfClass == nullptr || Function(*ComponentOfClass);
+		});
+	}
+
 	/**
 	 * Returns all registered Flow Components identified by given tag
 	 * 
 	 * @tparam T Only components matching this class we'll be returned
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class T>
 	TSet<TWeakObjectPtr<T>> GetComponents(const FGameplayTag& Tag, const bool bExactMatch = true) const
 	{
 		static_assert(TPointerIsConvertibleFromTo<T, const UActorComponent>::Value, "'T' template parameter to GetComponents must be derived from UActorComponent");
 
-		TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tag, bExactMatch, FoundComponents);
-
 		TSet<TWeakObjectPtr<T>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponentOfClass<T>(Tag, bExactMatch, [&Result](T& Component)
 		{
-			if (Component.IsValid())
-			{
-				if (T* ComponentOfClass = Cast<T>(Component))
-				{
-					Result.Emplace(ComponentOfClass);
-				}
-			}
-		}
+			Result.Emplace(&Component);
+			return true;
+		});
 
 		return Result;
 	}
@@ -273,27 +1341,19 @@ public:
 	 * @tparam T Only components matching this class we'll be returned
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class T>
 	TSet<TWeakObjectPtr<T>> GetComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch = true) const
 	{
 		static_assert(TPointerIsConvertibleFromTo<T, const UActorComponent>::Value, "'T' template parameter to GetComponents must be derived from UActorComponent");
 
-		TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
-
 		TSet<TWeakObjectPtr<T>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponentOfClass<T>(Tags, MatchType, bExactMatch, [&Result](T& Component)
 		{
-			if (Component.IsValid())
-			{
-				if (T* ComponentOfClass = Cast<T>(Component))
-				{
-					Result.Emplace(ComponentOfClass);
-				}
-			}
-		}
+			Result.Emplace(&Component);
+			return true;
+		});
 
 		return Result;
 	}
@@ -303,27 +1363,22 @@ public:
 	 * 
 	 * @tparam T Only components matching this class we'll be returned
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class T>
 	TSet<TWeakObjectPtr<T>> GetActors(const FGameplayTag& Tag, const bool bExactMatch = true) const
 	{
 		static_assert(TPointerIsConvertibleFromTo<T, const AActor>::Value, "'T' template parameter to GetActors must be derived from AActor");
 
-		TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tag, bExactMatch, FoundComponents);
-
 		TSet<TWeakObjectPtr<T>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponent(Tag, bExactMatch, [&Result](UFlowComponent& Component)
 		{
-			if (Component.IsValid())
+			if (T* ActorOfClass = Cast<T>(Component.GetOwner()))
 			{
-				if (T* ActorOfClass = Cast<T>(Component->GetOwner()))
-				{
-					Result.Emplace(ActorOfClass);
-				}
+				Result.Emplace(ActorOfClass);
 			}
-		}
+			return true;
+		});
 
 		return Result;
 	}
@@ -334,27 +1389,22 @@ public:
 	 * @tparam T Only actors matching this class we'll be returned
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class T>
 	TSet<TWeakObjectPtr<T>> GetActors(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch = true) const
 	{
 		static_assert(TPointerIsConvertibleFromTo<T, const AActor>::Value, "'T' template parameter to GetActors must be derived from AActor");
 
-		TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
-
 		TSet<TWeakObjectPtr<T>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponent(Tags, MatchType, bExactMatch, [&Result](UFlowComponent& Component)
 		{
-			if (Component.IsValid())
+			if (T* ActorOfClass = Cast<T>(Component.GetOwner()))
 			{
-				if (T* ActorOfClass = Cast<T>(Component->GetOwner()))
-				{
-					Result.Emplace(ActorOfClass);
-				}
+				Result.Emplace(ActorOfClass);
 			}
-		}
+			return true;
+		});
 
 		return Result;
 	}
@@ -365,7 +1415,7 @@ public:
 	 * @tparam ActorT Only actors matching this class we'll be returned
 	 * @tparam ComponentT Only components matching this class we'll be returned
 	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class ActorT, class ComponentT>
 	TMap<TWeakObjectPtr<ActorT>, TWeakObjectPtr<ComponentT>> GetActorsAndComponents(const FGameplayTag& Tag, const bool bExactMatch = true) const
@@ -373,22 +1423,15 @@ public:
 		static_assert(TPointerIsConvertibleFromTo<ActorT, const AActor>::Value, "'ActorT' template parameter to GetActorsAndComponents must be derived from AActor");
 		static_assert(TPointerIsConvertibleFromTo<ComponentT, const UActorComponent>::Value, "'ComponentT' template parameter to GetActorsAndComponents must be derived from UActorComponent");
 
-		TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tag, bExactMatch, FoundComponents);
-
 		TMap<TWeakObjectPtr<ActorT>, TWeakObjectPtr<ComponentT>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponentOfClass<ComponentT>(Tag, bExactMatch, [&Result](ComponentT& Component)
 		{
-			if (Component.IsValid())
+			if (ActorT* ActorOfClass = Cast<ActorT>(Component.GetOwner()))
 			{
-				ComponentT* ComponentOfClass = Cast<ComponentT>(Component);
-				ActorT* ActorOfClass = Cast<ActorT>(Component->GetOwner());
-				if (ComponentOfClass && ActorOfClass)
-				{
-					Result.Emplace(ActorOfClass, ComponentOfClass);
-				}
+				Result.Emplace(ActorOfClass, &Component);
 			}
-		}
+			return true;
+		});
 
 		return Result;
 	}
@@ -400,7 +1443,7 @@ public:
 	 * @tparam ComponentT Only components matching this class we'll be returned
 	 * @param Tags Container to check if it matches Identity Tags of registered Flow Components
 	 * @param MatchType If Any, returned component needs to have only one of given tags. If All, component needs to have all given Identity Tags
-	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching. Be careful, using latter option may be very expensive, as the search cost is proportional to the number of registered Gameplay Tags!
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
 	 */
 	template <class ActorT, class ComponentT>
 	TMap<TWeakObjectPtr<ActorT>, TWeakObjectPtr<ComponentT>> GetActorsAndComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch = true) const
@@ -408,27 +1451,188 @@ public:
 		static_assert(TPointerIsConvertibleFromTo<ActorT, const AActor>::Value, "'ActorT' template parameter to GetActorsAndComponents must be derived from AActor");
 		static_assert(TPointerIsConvertibleFromTo<ComponentT, const UActorComponent>::Value, "'ComponentT' template parameter to GetActorsAndComponents must be derived from UActorComponent");
 
-		TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-		FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
-
 		TMap<TWeakObjectPtr<ActorT>, TWeakObjectPtr<ComponentT>> Result;
-		for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+		ForEachComponentOfClass<ComponentT>(Tags, MatchType, bExactMatch, [&Result](ComponentT& Component)
 		{
-			if (Component.IsValid())
+			if (ActorT* ActorOfClass = Cast<ActorT>(Component.GetOwner()))
 			{
-				ComponentT* ComponentOfClass = Cast<ComponentT>(Component);
-				ActorT* ActorOfClass = Cast<ActorT>(Component->GetOwner());
-				if (ComponentOfClass && ActorOfClass)
-				{
-					Result.Emplace(ActorOfClass, ComponentOfClass);
-				}
+				Result.Emplace(ActorOfClass, &Component);
 			}
-		}
+			return true;
+		});
 
 		return Result;
 	}
 
+//////////////////////////////////////////////////////////////////////////
+// Component Registry Snapshot
+
+protected:
+	/* Created on initialization, see UFlowSettings::bPublishComponentRegistrySnapshot */
+	TSharedPtr<FFlowComponentRegistrySnapshotBuffer, ESPMode::ThreadSafe> RegistrySnapshot;
+	FTSTicker::FDelegateHandle RegistrySnapshotTickerHandle;
+
+	/* Set by every registry change, locations are tracked only by the spatial registry */
+	bool bRegistrySnapshotDirty = true;
+
+private:
+	bool PublishRegistrySnapshot(float DeltaTime);
+	void BuildRegistrySnapshot(FFlowComponentRegistrySnapshot& OutSnapshot) const;
+
+	void MarkRegistrySnapshotDirty() { bRegistrySnapshotDirty = true; }
+
+public:
+	/**
+	 * Copy of the registry readable from any thread, i.e. by AI or perception tasks. Updated once per frame, at the start of the frame
+	 * Read it through FFlowComponentRegistrySnapshotReadScope, returns nullptr if the snapshot isn't enabled in settings
+	 */
+	TSharedPtr<const FFlowComponentRegistrySnapshotBuffer, ESPMode::ThreadSafe> GetComponentRegistrySnapshot() const { return RegistrySnapshot; }
+
+//////////////////////////////////////////////////////////////////////////
+// Spatial Component Registry
+
+protected:
+	/* Cached from settings on initialization, see UFlowSettings::bSpatialComponentRegistry */
+	bool bSpatialRegistry = false;
+	float SpatialCellSize = 5000.0f;
+
+	TMap<FIntPoint, TArray<int32>> ComponentSlotsPerCell;
+
+	TSparseArray<FFlowComponentRegionListener> ComponentRegions;
+	TMap<FIntPoint, TArray<int32>> ComponentRegionsPerCell;
+	TArray<FFlowComponentRegistryEvent> PendingRegionEvents;
+
+private:
+	void AddToSpatialRegistry(const int32 SlotIndex);
+	void RemoveFromSpatialRegistry(const int32 SlotIndex);
+
+	void OnComponentOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, const int32 SlotIndex);
+	void RefreshComponentRegions(const int32 SlotIndex, const FIntPoint& PreviousCell);
+
+	FIntPoint GetSpatialCell(const FVector& Location) const;
+	FVector GetSlotLocation(const FFlowComponentRegistrySlot& Slot) const;
+
+	/* Visits slots with the tag and the location inside the box, through the grid cells if these are fewer than components with the tag */
+	bool VisitComponentSlotsInBox(const FGameplayTag& Tag, const bool bExactMatch, const FBox& Box, TFunctionRef<bool(const FFlowComponentRegistrySlot&, const FVector&)> Function) const;
+
+public:
+	bool IsSpatialRegistryEnabled() const { return bSpatialRegistry; }
+
+	/**
+	 * Visits registered Flow Components identified by given tag, which owners are located within the radius
+	 * Works without the spatial registry too, but then it checks every component with the tag
+	 */
+	bool ForEachComponentInRadius(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const float Radius, TFunctionRef<bool(UFlowComponent&)> Function) const;
+	bool ForEachComponentInBox(const FGameplayTag& Tag, const bool bExactMatch, const FBox& Box, TFunctionRef<bool(UFlowComponent&)> Function) const;
+
+	/* Collects up to Count registered Flow Components identified by given tag, sorted by the distance of their owners to the Origin */
+	void FindNearestComponents(const FGameplayTag& Tag, const bool bExactMatch, const FVector& Origin, const int32 Count, TArray<UFlowComponent*>& OutComponents, const float MaxRadius = UE_BIG_NUMBER, const UClass* ComponentClass = nullptr) const;
+
+	/**
+	 * Returns all registered Flow Components identified by given tag, which owners are located within the radius
+	 * 
+	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
+	 * @param ComponentClass Only components matching this class we'll be returned
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
+	 */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ComponentClass"))
+	TSet<UFlowComponent*> GetFlowComponentsInRadius(const FGameplayTag Tag, const FVector Origin, const float Radius, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch = true) const;
+
+	/**
+	 * Returns registered Flow Component identified by given tag, which owner is the closest to the Origin
+	 * 
+	 * @param Tag Tag to check if it matches Identity Tags of registered Flow Components
+	 * @param ComponentClass Only components matching this class we'll be returned
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then TagContainer will include it's parent tags while matching.
+	 */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DeterminesOutputType = "ComponentClass"))
+	UFlowComponent* FindNearestFlowComponent(const FGameplayTag Tag, const FVector Origin, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch = true) const;
+
+	/**
+	 * Subscribes to components entering and leaving the sphere, requires the spatial registry
+	 * @return Handle required to remove the listener, invalid if the spatial registry is disabled
+	 */
+	FDelegateHandle AddComponentRegionListener(const FFlowComponentRegionListener& Listener);
+	void RemoveComponentRegionListener(FDelegateHandle& Handle);
+
+	/* Visits components currently inside the region */
+	bool ForEachComponentInRegion(const FDelegateHandle& Handle, TFunctionRef<bool(UFlowComponent&)> Function) const;
+};
+
+/** Resolves live queries created in this scope at once, see UFlowSubsystem::BeginLiveQueryBatch */
+struct FFlowLiveQueryBatchScope
+{
+	explicit FFlowLiveQueryBatchScope(UFlowSubsystem* InFlowSubsystem)
+		: FlowSubsystem(InFlowSubsystem)
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->BeginLiveQueryBatch();
+		}
+	}
+
+	~FFlowLiveQueryBatchScope()
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->EndLiveQueryBatch();
+		}
+	}
+
+	UE_NONCOPYABLE(FFlowLiveQueryBatchScope);
+
+private:
+	TWeakObjectPtr<UFlowSubsystem> FlowSubsystem;
+};
+
+/** Coalesces registration events of Flow Components registered in this scope, see UFlowSubsystem::BeginComponentRegistrationBatch */
+struct FFlowComponentRegistrationBatchScope
+{
+	explicit FFlowComponentRegistrationBatchScope(UFlowSubsystem* InFlowSubsystem)
+		: FlowSubsystem(InFlowSubsystem)
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->BeginComponentRegistrationBatch();
+		}
+	}
+
+	~FFlowComponentRegistrationBatchScope()
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->EndComponentRegistrationBatch();
+		}
+	}
+
+	UE_NONCOPYABLE(FFlowComponentRegistrationBatchScope);
+
+private:
+	TWeakObjectPtr<UFlowSubsystem> FlowSubsystem;
+};
+
+/** Creates and starts Root Flows started in this scope together, see UFlowSubsystem::BeginRootFlowStartBatch */
+struct FFlowRootFlowStartBatchScope
+{
+	explicit FFlowRootFlowStartBatchScope(UFlowSubsystem* InFlowSubsystem)
+		: FlowSubsystem(InFlowSubsystem)
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->BeginRootFlowStartBatch();
+		}
+	}
+
+	~FFlowRootFlowStartBatchScope()
+	{
+		if (FlowSubsystem.IsValid())
+		{
+			FlowSubsystem->EndRootFlowStartBatch();
+		}
+	}
+
+	UE_NONCOPYABLE(FFlowRootFlowStartBatchScope);
+
 private:
-	void FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
-	void FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+	TWeakObjectPtr<UFlowSubsystem> FlowSubsystem;
 };
@@ -0,0 +1,130 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "UObject/ObjectKey.h"
+
+class UFlowAsset;
+class UFlowNode;
+
+// Instance telemetry is meant for playtests and analytics, so it's compiled into Shipping builds and disabled at runtime by default
+// Projects can override it by defining FLOW_WITH_TELEMETRY in their target rules
+#ifndef FLOW_WITH_TELEMETRY
+#define FLOW_WITH_TELEMETRY 1
+#endif
+
+#if FLOW_WITH_TELEMETRY
+enum class EFlowTelemetryMetric : uint8
+{
+	// From StartFlow to FinishFlow of the instance
+	InstanceLifetime,
+
+	// From StartFlow to the first Custom Output of the instance
+	FirstOutputLatency,
+
+	// From node activation to its deactivation, of all nodes in the template
+	NodeActiveDuration,
+
+	// From queueing the pin activation to executing it, only for activations deferred to the Flow Subsystem tick or executed by isolated instances
+	TriggerQueueDelay,
+
+	// From requesting the asynchronous load of SubGraph or Play Level Sequence asset to its completion
+	AsyncLoadWait,
+
+	Max
+};
+
+/** Log-scale histogram of durations, bucket N counts samples from 2^N to 2^(N+1) microseconds */
+struct FLOW_API FFlowTelemetryHistogram
+{
+	static constexpr int32 BucketsNum = 40;
+
+	uint32 Buckets[BucketsNum] = {};
+	uint32 Count = 0;
+
+	// Seconds
+	double Sum = 0.0;
+	double Min = 0.0;
+	double Max = 0.0;
+
+	void Add(const double Seconds);
+	void Merge(const FFlowTelemetryHistogram& Other);
+
+	double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+
+	// Estimated by linear interpolation inside the bucket, Percentile is 0-1
+	double GetPercentile(const double Percentile) const;
+};
+
+struct FLOW_API FFlowTemplateTelemetry
+{
+	FString TemplateName;
+	FFlowTelemetryHistogram Histograms[static_cast<int32>(EFlowTelemetryMetric::Max)];
+
+	// Active duration per node, the template histogram merges all of them
+	TMap<FGuid, FFlowTelemetryHistogram> Nodes;
+
+	const FFlowTelemetryHistogram& GetHistogram(const EFlowTelemetryMetric Metric) const { return Histograms[static_cast<int32>(Metric)]; }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FFlowTelemetryReportEvent, const FFlowTemplateTelemetry&);
+
+/**
+ * Gathers histograms of instance lifetime, latency and wait times per Flow Asset template
+ * Started and stopped with Flow.Telemetry console commands or SetEnabled, i.e. by the game analytics module
+ * Results are logged, exported to a CSV file, added to the metadata of CSV Profiler capture or broadcast by OnReport
+ */
+class FLOW_API FFlowTelemetry
+{
+public:
+	static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(const bool bInEnabled);
+	static void Reset();
+
+	// Zero if telemetry is disabled, so samples started before enabling it are skipped
+	static double GetTime() { return bEnabled ? FPlatformTime::Seconds() : 0.0; }
+
+	static void RecordSince(const UFlowAsset* FlowInstance, const EFlowTelemetryMetric Metric, const double StartTime);
+	static void RecordNodeSince(const UFlowNode& Node, const double StartTime);
+
+	static const FFlowTemplateTelemetry* FindTemplateTelemetry(const UFlowAsset* Template);
+	static const TMap<FObjectKey, FFlowTemplateTelemetry>& GetTemplateTelemetry() { return TemplateTelemetry; }
+
+	// All templates merged
+	static FFlowTelemetryHistogram GetTotalHistogram(const EFlowTelemetryMetric Metric);
+
+	static const TCHAR* GetMetricName(const EFlowTelemetryMetric Metric);
+
+	// Logs templates sorted by the 95th percentile of the metric
+	static void Dump(const EFlowTelemetryMetric Metric, const int32 MaxEntries);
+
+	// Writes percentiles of every template and node to the CSV file, returns its path
+	static FString Export(const FString& InFilePath = FString());
+
+	// Broadcasts OnReport for every template, i.e. to forward results to the analytics provider
+	static void Report();
+
+	static FFlowTelemetryReportEvent OnReport;
+
+private:
+	static bool bEnabled;
+	static TMap<FObjectKey, FFlowTemplateTelemetry> TemplateTelemetry;
+
+	static FFlowTemplateTelemetry* FindOrAddTemplateTelemetry(const UFlowAsset* FlowInstance);
+	static void RecordCsvStat(const EFlowTelemetryMetric Metric, const double Seconds);
+
+	// Adds percentiles to the metadata of the CSV Profiler capture
+	static void OnCsvProfileEnd();
+};
+
+// the enabled check is inlined at every call site, so disabled telemetry costs a single branch without a function call
+#define FLOW_TELEMETRY_TIME() FFlowTelemetry::GetTime()
+#define FLOW_TELEMETRY_RECORD(FlowInstance, Metric, StartTime) do { if (FFlowTelemetry::IsEnabled()) { FFlowTelemetry::RecordSince(FlowInstance, EFlowTelemetryMetric::Metric, StartTime); } } while (0)
+#define FLOW_TELEMETRY_RECORD_NODE(Node, StartTime) do { if (FFlowTelemetry::IsEnabled()) { FFlowTelemetry::RecordNodeSince(Node, StartTime); } } while (0)
+#else
+#define FLOW_TELEMETRY_TIME() 0.0
+#define FLOW_TELEMETRY_RECORD(FlowInstance, Metric, StartTime)
+#define FLOW_TELEMETRY_RECORD_NODE(Node, StartTime)
+#endif
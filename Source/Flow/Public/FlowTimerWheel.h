@@ -0,0 +1,139 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/SparseArray.h"
+#include "Delegates/Delegate.h"
+#include "UObject/ObjectKey.h"
+
+DECLARE_DELEGATE(FFlowTimerDelegate);
+
+// Identifies the timer set by FFlowTimerWheel, stays valid until cleared even after the one-shot timer fired, like FTimerHandle
+struct FLOW_API FFlowTimerHandle
+{
+	bool IsValid() const { return Serial != 0; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FFlowTimerHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FFlowTimerHandle& Other) const { return !(*this == Other); }
+
+private:
+	friend class FFlowTimerWheel;
+
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+};
+
+/**
+ * Hierarchical timer wheel owned by the Flow Subsystem, replaces FTimerManager timers of Flow nodes
+ * Setting and clearing the timer costs the same regardless of the number of active timers, and the clock is advanced once per frame
+ * Timers are owned by the Flow Asset instance, so all timers of the graph can be paused and resumed together
+ */
+class FLOW_API FFlowTimerWheel
+{
+public:
+	// Seconds covered by a single slot of the lowest level, timers fire during the first Advance past their expiration slot
+	static constexpr double Resolution = 0.01;
+
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr int32 LevelsNum = 4;
+
+	// Works like FTimerManager::SetTimer, non-positive rate doesn't set the timer
+	FFlowTimerHandle SetTimer(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate, const float Rate, const bool bLoop, const float FirstDelay = -1.f);
+
+	// Timer fires during the next Advance
+	FFlowTimerHandle SetTimerForNextTick(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate);
+
+	void ClearTimer(FFlowTimerHandle& Handle);
+	void ClearTimers(const FObjectKey& Owner);
+
+	bool IsTimerActive(const FFlowTimerHandle& Handle) const;
+
+	// Both return -1 for timers which aren't active
+	float GetTimerRemaining(const FFlowTimerHandle& Handle) const;
+	float GetTimerElapsed(const FFlowTimerHandle& Handle) const;
+
+	// Paused timers keep their remaining time, new timers of the paused owner start paused
+	// Catching up fires timers which would have expired while paused during the next Advance, looping timers as many times as they would have fired
+	void PauseTimers(const FObjectKey& Owner);
+	void UnPauseTimers(const FObjectKey& Owner, const bool bCatchUp = false);
+
+	// Timers of the owner fire during the first Advance past the multiple of the interval, so many owners fire their timers in the same batch, 0 restores the Resolution
+	void SetTimersInterval(const FObjectKey& Owner, const double Interval);
+	bool AreTimersPaused(const FObjectKey& Owner) const { return PausedOwners.Contains(Owner); }
+
+	// Advances the clock and fires expired timers ordered by their expiration time, returns the number of fired timers
+	int32 Advance(const double DeltaTime);
+
+	// Advances only timers of the owner by DeltaTime in one pass, without advancing the clock, returns the number of fired timers
+	// Timers fire in order of their expiration, looping timers once per period. Timers set by callbacks are advanced by the rest of DeltaTime
+	// Paused timers are advanced as well and stay paused. Timers set for the next tick by callbacks fire during the next Advance
+	int32 FastForwardTimers(const FObjectKey& Owner, const double DeltaTime);
+
+	int32 Num() const { return Timers.Num(); }
+	int32 NumActive() const { return ActiveTimersNum; }
+
+	void Reset();
+
+private:
+	struct FTimer
+	{
+		FFlowTimerDelegate Delegate;
+		FObjectKey Owner;
+
+		double ExpireTime = 0.0;
+		uint64 ExpireTick = 0;
+
+		// Loop period or the delay of the one-shot timer
+		double Rate = 0.0;
+
+		// Captured while the owner is paused
+		double PausedRemaining = 0.0;
+		double PauseTime = 0.0;
+
+		uint32 Serial = 0;
+
+		// Changes every time the timer is scheduled, entries of previous schedules are skipped
+		uint32 ScheduleSerial = 0;
+
+		bool bLoop = false;
+		bool bPaused = false;
+	};
+
+	struct FSlotEntry
+	{
+		int32 Index;
+		uint32 ScheduleSerial;
+	};
+
+	FFlowTimerHandle AddTimer(const FObjectKey& Owner, FFlowTimerDelegate&& Delegate, const double Rate, const bool bLoop, const double Delay);
+	void RemoveTimer(const int32 Index);
+
+	void Schedule(const int32 Index);
+	void InsertEntry(const FSlotEntry& Entry, const uint64 ExpireTick);
+	void Cascade(const int32 Level);
+
+	bool IsEntryValid(const FSlotEntry& Entry) const;
+
+	// Time left to the expiration, paused or not
+	double GetRemaining(const FTimer& Timer) const { return Timer.bPaused ? Timer.PausedRemaining : Timer.ExpireTime - Time; }
+
+	FTimer* Find(const FFlowTimerHandle& Handle);
+	const FTimer* Find(const FFlowTimerHandle& Handle) const;
+
+	TSparseArray<FTimer> Timers;
+	TArray<FSlotEntry> Slots[LevelsNum][SlotsPerLevel];
+
+	TMap<FObjectKey, TArray<int32, TInlineAllocator<2>>> TimersPerOwner;
+	TSet<FObjectKey> PausedOwners;
+	TMap<FObjectKey, double> OwnerIntervals;
+
+	double Time = 0.0;
+	uint64 CurrentTick = 0;
+
+	// Serials are never reused, so handles of removed timers don't match timers added later at the same index
+	uint32 NextSerial = 1;
+
+	int32 ActiveTimersNum = 0;
+};
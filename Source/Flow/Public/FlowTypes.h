@@ -60,6 +60,15 @@ enum class EFlowFinishPolicy : uint8
 	Abort
 };
 
+// Execution fidelity of the Flow Asset instance, see UFlowSubsystem::SetFlowSignificance
+UENUM(BlueprintType)
+enum class EFlowSignificance : uint8
+{
+	Full		UMETA(ToolTip = "Timers and queued pin activations are executed as usual."),
+	Throttled	UMETA(ToolTip = "Timers fire in coarse batches and fewer queued pin activations are executed per frame."),
+	Paused		UMETA(ToolTip = "Timers are frozen and queued pin activations wait until significance rises again.")
+};
+
 UENUM(BlueprintType)
 enum class EFlowSignalMode : uint8
 {
@@ -107,6 +116,22 @@ namespace FlowTypes
 	}
 }
 
+UENUM()
+enum class EFlowPinRecordingMode : uint8
+{
+	Off			UMETA(ToolTip = "Pin activations aren't recorded."),
+	RingBuffer	UMETA(ToolTip = "Only the most recent activations are recorded for every pin."),
+	Full		UMETA(ToolTip = "Every pin activation is recorded.")
+};
+
+UENUM()
+enum class EFlowTriggerStormResponse : uint8
+{
+	Log				UMETA(ToolTip = "Log the offending node once per frame, keep executing."),
+	BreakChain		UMETA(ToolTip = "Log and ignore further pin activations of the instance until the next frame."),
+	AbortInstance	UMETA(ToolTip = "Log, ignore further pin activations and abort the instance on the next tick.")
+};
+
 UENUM(BlueprintType)
 enum class EFlowOnScreenMessageType : uint8
 {
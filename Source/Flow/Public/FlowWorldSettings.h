@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFramework/WorldSettings.h"
+#include "FlowSubsystem.h"
 #include "FlowWorldSettings.generated.h"
 
 class UFlowComponent;
@@ -21,4 +22,8 @@ private:
 
 public:
 	UFlowComponent* GetFlowComponent() const { return FlowComponent; }
+
+	/* Flow Assets used by this map, loaded, compiled and pooled while the map loads */
+	UPROPERTY(EditAnywhere, Category = "Flow")
+	TArray<FFlowTemplateWarmup> WarmupFlowAssets;
 };
@@ -28,6 +28,16 @@ public:
 	bool CanSupplyDataPinValues() const;
 	virtual bool CanSupplyDataPinValues_Implementation() const { return true; }
 
+	// Only Blueprint subclasses can override events of this interface, native suppliers can be called without going through ProcessEvent
+	// Includes Blueprint subclasses of native suppliers, which don't override any event of this interface
+	static bool IsNativeSupplier(const UObject* Supplier);
+
+	// Calls native implementation directly, if possible
+	static bool CanSupplyDataPinValuesFast(const UObject* Supplier)
+	{
+		return IsNativeSupplier(Supplier) ? CastChecked<IFlowDataPinValueSupplierInterface>(Supplier)->CanSupplyDataPinValues_Implementation() : Execute_CanSupplyDataPinValues(Supplier);
+	}
+
 	// Must implement TrySupplyDataAs... for every EFlowPinType
 	FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "UObject/Interface.h"
+#include "Nodes/FlowNodeBase.h"
 #include "FlowNodeWithExternalDataPinSupplierInterface.generated.h"
 
 class IFlowDataPinValueSupplierInterface;
@@ -31,4 +32,8 @@ public:
 
 	// Get the IFlowDataPinValueSupplierInterface for the external supplier for this node
 	virtual IFlowDataPinValueSupplierInterface* GetExternalDataPinSupplier() const = 0;
+
+	// Supplier chain of the external supplier, built once when setting the supplier
+	// Allows reading the outermost source directly, instead of crawling through every nested SubGraph
+	virtual const FFlowPinValueSupplierDataArray* FindFlattenedExternalSuppliers(const FName& PinName) const { return nullptr; }
 };
@@ -16,4 +16,8 @@ class UFlowOwnerInterface : public UInterface
 class FLOW_API IFlowOwnerInterface
 {
 	GENERATED_BODY()
+
+public:
+	// Added to the Execution Priority of Flow Assets owned by this object, see UFlowAsset::GetExecutionPriority
+	virtual int32 GetFlowExecutionPriorityOffset() const { return 0; }
 };
@@ -9,6 +9,26 @@
 
 class UFlowNodeAddOn;
 
+// Declares what the predicate result depends on, so the result can be reused until any of them changes
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowPredicateCacheDependencies
+{
+	GENERATED_BODY()
+
+	// Opt-in, predicates are evaluated every time by default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Predicate")
+	bool bCacheResult = false;
+
+	// Cached result is discarded after Identity Tags of the Flow Component owning the Root Flow change
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Predicate")
+	bool bOwnerIdentityTags = false;
+
+	// Cached result is discarded after the preferred supplier of any of these input data pins calls MarkDataPinDirty
+	// Pins supplied by unversioned pins can't be cached, so the predicate is evaluated every time
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Predicate")
+	TArray<FName> DataPinNames;
+};
+
 // Predicate interface for AddOns
 UINTERFACE(MinimalAPI, BlueprintType, Blueprintable, DisplayName = "Flow Predicate Interface")
 class UFlowPredicateInterface : public UInterface
@@ -26,5 +46,10 @@ public:
 	bool EvaluatePredicate() const;
 	virtual bool EvaluatePredicate_Implementation() const { return true; }
 
+	// Queried once, when the predicate is compiled into FFlowPredicateProgram
+	UFUNCTION(BlueprintNativeEvent)
+	FFlowPredicateCacheDependencies GetPredicateCacheDependencies() const;
+	virtual FFlowPredicateCacheDependencies GetPredicateCacheDependencies_Implementation() const { return FFlowPredicateCacheDependencies(); }
+
 	static bool ImplementsInterfaceSafe(const UFlowNodeAddOn* AddOnTemplate);
 };
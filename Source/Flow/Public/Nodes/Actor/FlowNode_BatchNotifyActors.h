@@ -0,0 +1,33 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowSubsystem.h"
+#include "Nodes/FlowNode.h"
+#include "FlowNode_BatchNotifyActors.generated.h"
+
+/**
+ * Sends every Notify Tag to Flow Components identified by its Actor Tag, calls ReceiveNotify event on these components
+ * Cheaper than chaining Notify Actor nodes, as all targets are found in one registry pass and every component is notified once
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "Batch Notify Actors", Keywords = "event"))
+class FLOW_API UFlowNode_BatchNotifyActors : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+protected:
+	// Actor Tags have to be exact matches of Identity Tags
+	UPROPERTY(EditAnywhere, Category = "Notify")
+	TArray<FFlowActorNotify> Notifies;
+
+	UPROPERTY(EditAnywhere, Category = "Notify")
+	EFlowNetMode NetMode;
+
+	virtual void ExecuteInput(const FName& PinName) override;
+
+#if WITH_EDITOR
+public:
+	virtual FString GetNodeDescription() const override;
+	virtual EDataValidationResult ValidateNode() override;
+#endif
+};
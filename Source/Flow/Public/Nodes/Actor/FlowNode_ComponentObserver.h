@@ -4,6 +4,7 @@
 
 #include "GameplayTagContainer.h"
 
+#include "FlowSubsystem.h"
 #include "Nodes/FlowNode.h"
 #include "FlowNode_ComponentObserver.generated.h"
 
@@ -29,6 +30,11 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "ObservedComponent")
 	EFlowTagContainerMatchType IdentityMatchType;
 
+	// Replaces Identity Tags and Identity Match Type if not empty
+	// Evaluated against Identity Tags in Flow Component, only components with any of the tags referenced by the query we'll be tested
+	UPROPERTY(EditAnywhere, Category = "ObservedComponent")
+	FGameplayTagQuery IdentityTagQuery;
+
 	// This node will become Completed, if Success Limit > 0 and Success Count reaches this limit
 	// Set this to zero, if you'd like receive events indefinitely (node would finish work only if explicitly Stopped)
 	UPROPERTY(EditAnywhere, Category = "Lifetime", meta = (ClampMin = 0))
@@ -40,6 +46,15 @@ protected:
 
 	TMap<TWeakObjectPtr<AActor>, TWeakObjectPtr<UFlowComponent>> RegisteredActors;
 
+	/* See UFlowSubsystem::CreateLiveQuery */
+	FFlowComponentLiveQueryHandle LiveQueryHandle;
+
+public:
+	// For nodes created by code, i.e. synthetic graphs of benchmarks, call before the node is activated
+	void SetIdentityTags(const FGameplayTagContainer& InIdentityTags) { IdentityTags = InIdentityTags; }
+	const FGameplayTagContainer& GetIdentityTags() const { return IdentityTags; }
+	void SetSuccessLimit(const int32 InSuccessLimit) { SuccessLimit = FMath::Max(InSuccessLimit, 0); }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void OnLoad_Implementation() override;
@@ -47,15 +62,26 @@ protected:
 	virtual void StartObserving();
 	virtual void StopObserving();
 
-	UFUNCTION()
+	// False for nodes matching components by Identity Tags outside of the live query
+	virtual bool SupportsIdentityTagQuery() const { return true; }
+	bool UsesIdentityTagQuery() const { return SupportsIdentityTagQuery() && !IdentityTagQuery.IsEmpty(); }
+	bool HasIdentityFilter() const { return UsesIdentityTagQuery() || IdentityTags.IsValid(); }
+
+	bool MatchesIdentity(const UFlowComponent* Component) const;
+
+	UFUNCTION(meta = (DeprecatedFunction, DeprecationMessage="Live query calls OnComponentRegistered for every component starting to match Identity Tags."))
+	void OnComponentsRegistered(const TArray<UFlowComponent*>& Components);
+
+	// Called when component starts matching Identity Tags
 	virtual void OnComponentRegistered(UFlowComponent* Component);
 
-	UFUNCTION()
+	UFUNCTION(meta = (DeprecatedFunction, DeprecationMessage="Live query calls OnComponentRegistered once the component starts matching Identity Tags."))
 	virtual void OnComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags);
 
-	UFUNCTION()
+	UFUNCTION(meta = (DeprecatedFunction, DeprecationMessage="Live query calls OnComponentUnregistered once the component stops matching Identity Tags."))
 	virtual void OnComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags);
 
+	// Called when component stops matching Identity Tags
 	UFUNCTION()
 	virtual void OnComponentUnregistered(UFlowComponent* Component);
 
@@ -11,6 +11,8 @@
 #include "FlowNode_ExecuteComponent.generated.h"
 
 // Forward Declarations
+class IFlowCoreExecutableInterface;
+class IFlowExternalExecutableInterface;
 class IFlowOwnerInterface;
 class UFlowInjectComponentsManager;
 
@@ -37,6 +39,29 @@ namespace EExecuteComponentSource_Classifiers
 	FORCEINLINE bool DoesComponentSourceUseInjectManager(EExecuteComponentSource Source) { return FLOW_IS_ENUM_IN_SUBRANGE(Source, EExecuteComponentSource::UsesInjectManager); }
 }
 
+// Context pins of the component bound on the expected owner, see UFlowNode_ExecuteComponent::ExpectedComponentPins
+USTRUCT()
+struct FLOW_API FFlowExecuteComponentPinCache
+{
+	GENERATED_BODY()
+
+	// Pins are valid only for the same owner class and component name
+	UPROPERTY()
+	FSoftClassPath OwnerClass;
+
+	UPROPERTY()
+	FName ComponentName;
+
+	UPROPERTY()
+	TArray<FFlowPin> InputPins;
+
+	UPROPERTY()
+	TArray<FFlowPin> OutputPins;
+
+	UPROPERTY()
+	bool bIsSet = false;
+};
+
 /**
  * Execute a UActorComponent on the owning actor as if it was a flow subgraph
  */
@@ -52,6 +77,7 @@ public:
 	// IFlowCoreExecutableInterface
 	virtual void InitializeInstance() override;
 	virtual void DeinitializeInstance() override;
+	virtual bool HasPreloadContent() const override { return true; }
 	virtual void PreloadContent() override;
 	virtual void FlushContent() override;
 	virtual void OnActivate() override;
@@ -98,6 +124,7 @@ public:
 	// UFlowNode
 	virtual FText GetNodeTitle() const override;
 	virtual EDataValidationResult ValidateNode() override;
+	virtual void GatherContentDependencies(TArray<FSoftObjectPath>& OutPaths) const override;
 
 	virtual FString GetStatusString() const override;
 	// --
@@ -109,13 +136,29 @@ protected:
 	void RefreshPins();
 	const UActorComponent* TryGetExpectedComponent() const;
 
+	// Returns nullptr if the cache doesn't match the current component reference
+	const FFlowExecuteComponentPinCache* FindExpectedComponentPins() const;
+	void UpdateExpectedComponentPins();
+
 	void RefreshComponentSource();
 #endif // WITH_EDITOR
 
 	bool TryInjectComponent();
 
+	// Template or class defaults of the component to inject
+	const UActorComponent* GetComponentToInjectDefaults() const;
+
+	// Key of the Flow Subsystem pool of injected components, shared by all instances of this node
+	const UActorComponent* GetComponentPoolArchetype() const;
+	UActorComponent* TryAcquirePooledComponent(AActor& ActorOwner) const;
+	bool IsPooledComponent(const UActorComponent& Component) const;
+
 	UActorComponent* TryResolveComponent();
 	UActorComponent* GetResolvedComponent() const;
+
+	// Resolves the component and refreshes the cached interfaces, if the resolved component changed
+	UActorComponent* TryResolveExecutableComponent();
+	void ResetExecutableInterfaces();
 	TSubclassOf<AActor> TryGetExpectedActorOwnerClass() const;
 
 protected:
@@ -137,6 +180,18 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UFlowInjectComponentsManager> InjectComponentsManager = nullptr;
 
+	// Interfaces of the executed component, so lifecycle calls don't repeat the interface lookups
+	//  - native pointers are set if a C++ class implements the interface, calling it without the reflection
+	//  - otherwise, Blueprint implementations are called through the Execute_K2 functions
+	TWeakObjectPtr<UActorComponent> ExecutableComponent;
+	IFlowCoreExecutableInterface* NativeCoreExecutable = nullptr;
+	IFlowExternalExecutableInterface* NativeExternalExecutable = nullptr;
+	bool bScriptCoreExecutable = false;
+	bool bScriptExternalExecutable = false;
+
+	// Assets soft-referenced by the component to inject, acquired from the Flow Subsystem shared preloads
+	TArray<FSoftObjectPath> PreloadedPaths;
+
 	// Look for the component (by class) on the Actor and re-use it (rather than injecting)
 	// if the component already exists.
 	UPROPERTY(EditAnywhere, Category = Configuration, DisplayName = "Re-use existing component if found", meta = (EditConditionHides, EditCondition = "ComponentSource == EExecuteComponentSource::InjectFromClass"))
@@ -146,7 +201,21 @@ protected:
 	UPROPERTY(EditAnywhere, Category = Configuration, DisplayName = "Allow injecting component", meta = (EditConditionHides, EditCondition = "ComponentSource == EExecuteComponentSource::InjectFromClass && bReuseExistingComponent"))
 	bool bAllowInjectComponent = true;
 
+	// Number of removed injected components kept by the Flow Subsystem for reuse, avoids creating and destroying components on every injection
+	// Pooled components stay registered with their last Actor until reused on another one, they're only deactivated
+	// Components don't receive BeginPlay again, so they must reset their runtime state in InitializeInstance or Activate
+	// Replicated components aren't pooled, 0 disables pooling
+	UPROPERTY(EditAnywhere, Category = Configuration, meta = (ClampMin = 0, EditConditionHides, EditCondition = "ComponentSource == EExecuteComponentSource::InjectFromTemplate || ComponentSource == EExecuteComponentSource::InjectFromClass"))
+	int32 MaxPooledComponents = 0;
+
 	// Inject component(s) onto the owning Actor
 	UPROPERTY()
 	EExecuteComponentSource ComponentSource = EExecuteComponentSource::Undetermined;
+
+#if WITH_EDITORONLY_DATA
+	// Context pins of the bound component, so refreshing the graph doesn't resolve component templates of the owner Blueprint
+	// Updated on editing the node and on validating it, which also happens on saving the asset
+	UPROPERTY()
+	FFlowExecuteComponentPinCache ExpectedComponentPins;
+#endif
 };
@@ -37,6 +37,9 @@ protected:
 
 	virtual void ExecuteInput(const FName& PinName) override;
 
+public:
+	virtual bool CanHibernate() const override { return true; }
+
 #if WITH_EDITOR
 public:
 	virtual FString GetNodeDescription() const override;
@@ -0,0 +1,42 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/Actor/FlowNode_ComponentObserver.h"
+#include "FlowNode_OnActorEnteredRegion.generated.h"
+
+/**
+ * Triggers output when actor with matching Identity Tag enters the sphere
+ * Requires the spatial component registry enabled in Flow Settings
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "On Actor Entered Region", Keywords = "bind, trigger, radius"))
+class FLOW_API UFlowNode_OnActorEnteredRegion : public UFlowNode_ComponentObserver
+{
+	GENERATED_UCLASS_BODY()
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "Region")
+	FVector RegionCenter;
+
+	UPROPERTY(EditAnywhere, Category = "Region", meta = (ClampMin = 0.0f))
+	float RegionRadius;
+
+	/* See UFlowSubsystem::AddComponentRegionListener */
+	FDelegateHandle RegionListenerHandle;
+
+	virtual void StartObserving() override;
+	virtual void StopObserving() override;
+
+	// Region listeners match components by Identity Tags
+	virtual bool SupportsIdentityTagQuery() const override { return false; }
+
+	void OnComponentEntered(UFlowComponent* Component);
+	void OnComponentLeft(UFlowComponent* Component);
+
+	virtual void ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
+
+#if WITH_EDITOR
+public:
+	virtual FString GetNodeDescription() const override;
+#endif
+};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "FlowEventBus.h"
 #include "Nodes/Actor/FlowNode_ComponentObserver.h"
 #include "FlowNode_OnNotifyFromActor.generated.h"
 
@@ -22,9 +23,21 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Notify")
 	bool bRetroactive;
 
+	// Parked on every Identity Tag, instead of binding OnNotifyFromComponent of every observed component
+	TArray<FFlowEventWaiter> NotifyWaiters;
+
+	// Components matching several Identity Tags wake several waiters with the same event
+	uint32 LastEventSerial = 0;
+
+	virtual void StartObserving() override;
+	virtual void StopObserving() override;
+
+	// Waiters are parked on the event bus by Identity Tags
+	virtual bool SupportsIdentityTagQuery() const override { return false; }
+
 	virtual void ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
-	virtual void ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
 
+	void OnFlowEvent(const FFlowEvent& Event);
 	virtual void OnNotifyFromComponent(UFlowComponent* Component, const FGameplayTag& Tag);
 	
 #if WITH_EDITOR
@@ -32,6 +32,8 @@ class FLOW_API UFlowNode
 	friend class UFlowNodeAddOn;
 	friend class SFlowInputPinHandle;
 	friend class SFlowOutputPinHandle;
+	friend struct FFlowNodeBlueprintMetadata;
+	friend class FFlowAssetOptimizer;
 
 //////////////////////////////////////////////////////////////////////////
 // Node
@@ -47,6 +49,10 @@ protected:
 #endif
 
 public:
+	// UObject
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// --
+
 	// UFlowNodeBase
 	virtual UFlowNode* GetFlowNodeSelfOrOwner() override { return this; }
 	virtual bool IsSupportedInputPinName(const FName& PinName) const override;
@@ -82,6 +88,18 @@ public:
 public:	
 	virtual bool CanFinishGraph() const { return false; }
 
+	// True if the node touches only its own state and the state of its Flow Asset instance while executing inputs
+	// Only instances built entirely from such nodes can run on worker threads, see UFlowAsset::bIsolatedExecution
+	virtual bool SupportsIsolatedExecution() const { return false; }
+
+	// True if the inactive node keeps no state between activations, so its instance can be released while the Flow Asset instance is idle
+	// Released node is instantiated again with default property values, see UFlowAsset::HibernateInactiveNodes
+	virtual bool CanHibernate() const { return false; }
+
+	// True if the node doesn't reference objects assigned after its initialization, so it can join the GC cluster of its Flow Asset instance
+	// Garbage collector doesn't track references added to the cluster later, see UFlowAsset::bClusterInstances
+	virtual bool CanBeInInstanceCluster() const { return false; }
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "FlowNode")
 	TArray<EFlowSignalMode> AllowedSignalModes;
@@ -168,9 +186,16 @@ protected:
 	UPROPERTY()
 	TMap<FName, FConnectedPin> Connections;
 
+	// Template node providing immutable data to this instance, see UFlowSettings::bShareTemplateNodeData
+	const UFlowNode* SharedDataNode = nullptr;
+
 public:
 	void SetConnections(const TMap<FName, FConnectedPin>& InConnections) { Connections = InConnections; }
-	FConnectedPin GetConnection(const FName OutputName) const { return Connections.FindRef(OutputName); }
+	const TMap<FName, FConnectedPin>& GetConnections() const { return SharedDataNode ? SharedDataNode->Connections : Connections; }
+	FConnectedPin GetConnection(const FName OutputName) const { return GetConnections().FindRef(OutputName); }
+
+	// Releases data copied from the template that doesn't change at runtime, reads are redirected to the template node
+	void ShareTemplateNodeData(const UFlowNode& TemplateNode);
 
 	UE_DEPRECATED(5.5, "Please use GatherConnectedNodes instead.")
 	TSet<UFlowNode*> GetConnectedNodes() const { return GatherConnectedNodes(); }
@@ -198,6 +223,7 @@ protected:
 
 	// Slow and fast lookup functions, based on whether we are proactively caching the connections for quick lookup 
 	// in the Connections array (by PinCategory)
+	// The "slow" one uses the reverse index of the Flow Asset, falling back to iterating all nodes if the index is missing
 	bool FindConnectedNodeForPinFast(const FName& FlowPinName, FGuid* FoundGuid = nullptr, FName* OutConnectedPinName = nullptr) const;
 	bool FindConnectedNodeForPinSlow(const FName& FlowPinName, FGuid* FoundGuid = nullptr, FName* OutConnectedPinName = nullptr) const;
 
@@ -211,7 +237,7 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, AdvancedDisplay, Category = "FlowNode", meta = (GetByRef))
 	TMap<FName, FName> PinNameToBoundPropertyNameMap;
 
-	const TMap<FName, FName>& GetPinNameToBoundPropertyNameMap() const { return PinNameToBoundPropertyNameMap; }
+	const TMap<FName, FName>& GetPinNameToBoundPropertyNameMap() const { return SharedDataNode ? SharedDataNode->PinNameToBoundPropertyNameMap : PinNameToBoundPropertyNameMap; }
 
 #if WITH_EDITORONLY_DATA	
 	UPROPERTY(VisibleDefaultsOnly, AdvancedDisplay, Category = "FlowNode", meta = (GetByRef))
@@ -254,9 +280,31 @@ public:
 
 	bool TryGetFlowDataPinSupplierDatasForPinName(
 		const FName& PinName,
-		TArray<FFlowPinValueSupplierData>& InOutPinValueSupplierDatas) const;
+		FFlowPinValueSupplierDataArray& InOutPinValueSupplierDatas) const;
 	// --
 
+	// Supplies the values of the array data pin as a view of this node's storage, see FlowDataPin::TryResolveArray
+	// Views the bound FFlowDataPinArrayProperty wrapper or plain TArray property, override it to supply computed arrays
+	virtual FFlowDataPinArrayView TrySupplyDataPinAsArray(const FName& PinName) const;
+
+	// Opt-in push model: call it after changing the value bound to the output data pin
+	// Consumers reading the pin via TFlowDataPinHandle reuse their cached value until the pin version changes
+	void MarkDataPinDirty(const FName& PinName);
+
+	// Zero if the pin was never marked dirty, such pin is resolved on every read
+	uint32 GetDataPinVersion(const FName& PinName) const;
+
+	// Sets the value of the output data pin property and marks the pin dirty
+	template <typename TFlowDataPinProperty, typename TValue>
+	void SetDataPinPropertyValue(const FName& PinName, TFlowDataPinProperty& DataPinProperty, const TValue& NewValue)
+	{
+		DataPinProperty.Value = NewValue;
+		MarkDataPinDirty(PinName);
+	}
+
+private:
+	TMap<FName, uint32> DataPinVersions;
+
 protected:
 
 	// Helper functions for the TrySupplyDataPin...() functions
@@ -271,6 +319,15 @@ protected:
 		TInstancedStruct<FFlowDataPinProperty>& OutFoundInstancedStruct,
 		EFlowDataPinResolveResult& InOutResult) const;
 
+private:
+	// Properties found by TryFindPropertyByRemappedPinName, filled on the first lookup
+	// Instances using the shared template data read the cache of the template node
+	mutable TMap<FName, const FProperty*> BoundPropertyCache;
+
+	const FProperty* FindBoundProperty(const FName& RemappedPinName) const;
+
+protected:
+
 	// Functions to supply the pin data value from a variety of supported property types
 	template <typename TFlowDataPinResultType, typename TFlowDataPinProperty, typename TFieldPropertyType>
 	TFlowDataPinResultType TrySupplyDataPinAsType(const FName& PinName) const;
@@ -286,6 +343,13 @@ protected:
 	template <typename TFlowDataPinResultType, typename TFlowDataPinProperty, typename TTargetStruct>
 	TFlowDataPinResultType TrySupplyDataPinAsStructType(const FName& PinName) const;
 
+public:
+	// Zero-copy read of the struct bound to the output data pin, i.e. FInstancedStruct, FGameplayTagContainer or FTransform
+	// Bound property can be the TFlowDataPinProperty wrapper or the plain TTargetStruct
+	// Points to this node's storage, so it's valid only until the node changes the value. Don't keep it across frames.
+	template <typename TFlowDataPinProperty, typename TTargetStruct>
+	const TTargetStruct* TryGetDataPinStructValuePtr(const FName& PinName) const;
+
 	template <typename TFlowDataPinResultType, typename TFlowDataPinProperty, typename TUObjectType,
 		typename TFieldPropertyObjectType0, typename TFieldPropertySoftObjectType1>
 	TFlowDataPinResultType TrySupplyDataPinAsUObjectTypeCommon(const FName& PinName, const FProperty*& OutFoundProperty) const;
@@ -314,6 +378,9 @@ protected:
 public:
 	bool bPreloaded;
 
+	// Platform time of the preload or the latest activation since, least recently used nodes are flushed first when over UFlowSettings::PreloadedContentBudgetMB
+	double LastPreloadUseTime;
+
 protected:
 	UPROPERTY(SaveGame)
 	EFlowNodeState ActivationState;
@@ -322,22 +389,63 @@ public:
 	EFlowNodeState GetActivationState() const { return ActivationState; }
 	bool HasFinished() const { return EFlowNodeState_Classifiers::IsFinishedState(ActivationState); }
 
-#if !UE_BUILD_SHIPPING
+private:
+	// Dense index of this node in the compiled graph of its Flow Asset instance, INDEX_NONE if not instantiated
+	int32 CompiledNodeIndex = INDEX_NONE;
+
+	// Slot of this node in the ActiveNodes array of its Flow Asset instance, INDEX_NONE if not active
+	int32 ActiveNodeIndex = INDEX_NONE;
+
+	// See FFlowTelemetry::GetTime
+	double TelemetryActivationTime = 0.0;
+
+	// Updates the state block of the Flow Asset instance too, see UFlowAsset::NodeStates
+	void SetActivationState(const EFlowNodeState NewState);
+
+public:
+	int32 GetCompiledNodeIndex() const { return CompiledNodeIndex; }
+
+#if FLOW_WITH_PIN_RECORDS
+
+protected:
+	// Number of the most recent activations kept for every pin of this node, 0 keeps all records
+	// Override it for nodes triggering pins at high frequency, i.e. Timer's Step output
+	virtual int32 GetPinRecordsCapacity() const;
 
 private:
-	TMap<FName, TArray<FPinRecord>> InputRecords;
-	TMap<FName, TArray<FPinRecord>> OutputRecords;
+	TMap<FName, FPinRecordHistory> InputRecords;
+	TMap<FName, FPinRecordHistory> OutputRecords;
+
+	void AddPinRecord(TMap<FName, FPinRecordHistory>& Records, const FName& PinName, const EFlowPinActivationType ActivationType) const;
 #endif
 
 public:
 	void TriggerPreload();
 	void TriggerFlush();
 
+	// True if PreloadContent loads anything, these nodes are preloaded ahead by UFlowSettings::LookaheadPreloadDepth
+	// Called on template nodes too
+	virtual bool HasPreloadContent() const { return false; }
+
+#if WITH_EDITOR
+	// Content loaded by this node at runtime, cooked into UFlowAsset::ContentDependencies
+	// By default, soft references held by node properties
+	virtual void GatherContentDependencies(TArray<FSoftObjectPath>& OutPaths) const;
+
+	// Tags used by this node, saved as Asset Registry tags of the Flow Asset, see FFlowAssetRegistryTags
+	// By default, tags held by runtime properties of the node and its AddOns
+	virtual void GatherGameplayTags(FGameplayTagContainer& OutTags) const;
+#endif
+
 protected:
 
 	// Trigger execution of input pin
 	void TriggerInput(const FName& PinName, const EFlowPinActivationType ActivationType = EFlowPinActivationType::Default);
 
+private:
+	// bIsKnownPin allows callers that already resolved the pin index to skip the InputPins search
+	void TriggerInput_Internal(const FName& PinName, const bool bIsKnownPin, const EFlowPinActivationType ActivationType = EFlowPinActivationType::Default);
+
 protected:
 	void Deactivate();
 
@@ -359,7 +467,30 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "FlowNode")
 	void LoadInstance(const FFlowNodeSaveData& NodeRecord);
 
+	// Game thread part of SaveInstance(), calls OnSave() unless the previous save data is reused
+	void PrepareSaveInstance();
+
+	// Serializes the node into the record, doesn't call Blueprint code so it can run on a worker thread
+	// Snapshot neither reuses nor updates the data of the incremental SaveGame, see UFlowAsset::SnapshotInstance
+	void SerializeSaveInstance(FFlowNodeSaveData& NodeRecord, const bool bSnapshot = false);
+
+	// First phase of LoadInstance(), restores the node state without calling OnLoad() hooks
+	void DeserializeSaveInstance(const FFlowNodeSaveData& NodeRecord);
+
+	// Second phase of LoadInstance(), calls OnLoad() once all nodes of the graph have been deserialized
+	void PostLoadInstance();
+
+	// Forces the next SaveInstance() to serialize the node, even if the incremental SaveGame considers it unchanged
+	UFUNCTION(BlueprintCallable, Category = "FlowNode")
+	void MarkSaveDataDirty();
+
+	bool IsSaveDataDirty() const { return bSaveDataDirty; }
+
 protected:
+	// Return false if the node's SaveGame data changes without activating the node, i.e. it's calculated in OnSave()
+	// Blueprint nodes are always serialized, as the native code can't know when their SaveGame properties change
+	virtual bool CanReuseSaveData() const;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "FlowNode")
 	void OnSave();
 
@@ -368,6 +499,13 @@ protected:
 
 	UFUNCTION(BlueprintNativeEvent, Category = "FlowNode")
 	void OnPassThrough();
+
+private:
+	bool ShouldReuseSaveData() const;
+
+	// Serialized data from the previous save, reused by the incremental SaveGame
+	TArray<uint8> CachedSaveData;
+	bool bSaveDataDirty = true;
 	
 //////////////////////////////////////////////////////////////////////////
 // Utils
@@ -450,10 +588,9 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsType(const FName& PinName) c
 
 		if (StructProperty->Struct == FlowDataPinPropertyStruct)
 		{
-			TFlowDataPinProperty ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const TFlowDataPinProperty* ValueStruct = StructProperty->ContainerPtrToValuePtr<TFlowDataPinProperty>(this);
 
-			SuppliedResult.Value = ValueStruct.Value;
+			SuppliedResult.Value = ValueStruct->Value;
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 
@@ -516,18 +653,16 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsNumericType(const FName& Pin
 		// Supporting both a 64 and 32 bit wrapper for ints/floats, given the ubiquity of int32/float.
 		if (StructProperty->Struct == FlowLargeDataPinPropertyStruct)
 		{
-			TFlowLargeDataPinProperty ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const TFlowLargeDataPinProperty* ValueStruct = StructProperty->ContainerPtrToValuePtr<TFlowLargeDataPinProperty>(this);
 
-			SuppliedResult.Value = ValueStruct.Value;
+			SuppliedResult.Value = ValueStruct->Value;
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 		else if (StructProperty->Struct == FlowMediumDataPinPropertyStruct)
 		{
-			TFlowMediumDataPinProperty ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const TFlowMediumDataPinProperty* ValueStruct = StructProperty->ContainerPtrToValuePtr<TFlowMediumDataPinProperty>(this);
 
-			SuppliedResult.Value = ValueStruct.Value;
+			SuppliedResult.Value = ValueStruct->Value;
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 
@@ -613,26 +748,23 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsAnyTextType(const FName& Pin
 
 		if (StructProperty->Struct == FlowDataPinPropertyStruct_Name)
 		{
-			FFlowDataPinOutputProperty_Name ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const FFlowDataPinOutputProperty_Name* ValueStruct = StructProperty->ContainerPtrToValuePtr<FFlowDataPinOutputProperty_Name>(this);
 
-			SuppliedResult.SetValue(ValueStruct.Value);
+			SuppliedResult.SetValue(ValueStruct->Value);
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 		else if (StructProperty->Struct == FlowDataPinPropertyStruct_String)
 		{
-			FFlowDataPinOutputProperty_String ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const FFlowDataPinOutputProperty_String* ValueStruct = StructProperty->ContainerPtrToValuePtr<FFlowDataPinOutputProperty_String>(this);
 
-			SuppliedResult.SetValue(ValueStruct.Value);
+			SuppliedResult.SetValue(ValueStruct->Value);
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 		else if (StructProperty->Struct == FlowDataPinPropertyStruct_Text)
 		{
-			FFlowDataPinOutputProperty_Text ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const FFlowDataPinOutputProperty_Text* ValueStruct = StructProperty->ContainerPtrToValuePtr<FFlowDataPinOutputProperty_Text>(this);
 
-			SuppliedResult.SetValue(ValueStruct.Value);
+			SuppliedResult.SetValue(ValueStruct->Value);
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 
@@ -699,11 +831,10 @@ FFlowDataPinResult_Enum UFlowNode::TrySupplyDataPinAsEnumType(const FName& PinNa
 
 		if (StructProperty->Struct == FlowDataPinPropertyStruct_Enum)
 		{
-			FFlowDataPinOutputProperty_Enum ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const FFlowDataPinOutputProperty_Enum* ValueStruct = StructProperty->ContainerPtrToValuePtr<FFlowDataPinOutputProperty_Enum>(this);
 
-			SuppliedResult.Value = ValueStruct.Value;
-			SuppliedResult.EnumClass = ValueStruct.EnumClass;
+			SuppliedResult.Value = ValueStruct->Value;
+			SuppliedResult.EnumClass = ValueStruct->EnumClass;
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 
@@ -733,6 +864,34 @@ FFlowDataPinResult_Enum UFlowNode::TrySupplyDataPinAsEnumType(const FName& PinNa
 	}
 }
 
+template <typename TFlowDataPinProperty, typename TTargetStruct>
+const TTargetStruct* UFlowNode::TryGetDataPinStructValuePtr(const FName& PinName) const
+{
+	const FName* RemappedPinName = GetPinNameToBoundPropertyNameMap().Find(PinName);
+	if (!RemappedPinName)
+	{
+		return nullptr;
+	}
+
+	const FStructProperty* StructProperty = CastField<FStructProperty>(FindBoundProperty(*RemappedPinName));
+	if (!StructProperty)
+	{
+		return nullptr;
+	}
+
+	if (StructProperty->Struct == TFlowDataPinProperty::StaticStruct())
+	{
+		return &StructProperty->ContainerPtrToValuePtr<TFlowDataPinProperty>(this)->Value;
+	}
+
+	if (StructProperty->Struct == TBaseStructure<TTargetStruct>::Get())
+	{
+		return StructProperty->ContainerPtrToValuePtr<TTargetStruct>(this);
+	}
+
+	return nullptr;
+}
+
 template <typename TFlowDataPinResultType, typename TFlowDataPinProperty, typename TTargetStruct>
 TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsStructType(const FName& PinName) const
 {
@@ -745,12 +904,12 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsStructType(const FName& PinN
 		return SuppliedResult;
 	}
 
-	if (const TFlowDataPinProperty* FlowDataPinProp = InstancedStruct.GetPtr<TFlowDataPinProperty>())
+	if (TFlowDataPinProperty* FlowDataPinProp = InstancedStruct.GetMutablePtr<TFlowDataPinProperty>())
 	{
 		// In some cases, TryFindPropertyByPinName can find an instanced struct for the wrapper,
-		// so get the value from it and return straight away
+		// it's our own copy, so move the value out of it and return straight away
 
-		SuppliedResult.Value = FlowDataPinProp->Value;
+		SuppliedResult.Value = MoveTemp(FlowDataPinProp->Value);
 		SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 
 		return SuppliedResult;
@@ -771,10 +930,9 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsStructType(const FName& PinN
 	{
 		// Check for struct-based wrapper for the property and get the value out of it
 
-		TFlowDataPinProperty ValueStruct;
-		StructProperty->GetValue_InContainer(this, &ValueStruct);
+		const TFlowDataPinProperty* ValueStruct = StructProperty->ContainerPtrToValuePtr<TFlowDataPinProperty>(this);
 
-		SuppliedResult.Value = ValueStruct.Value;
+		SuppliedResult.Value = ValueStruct->Value;
 		SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 
 		return SuppliedResult;
@@ -783,10 +941,9 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsStructType(const FName& PinN
 	{
 		// Get the value from a UE struct (non-wrapper) property type
 
-		TTargetStruct TargetStruct;
-		StructProperty->GetValue_InContainer(this, &TargetStruct);
+		const TTargetStruct* TargetStruct = StructProperty->ContainerPtrToValuePtr<TTargetStruct>(this);
 
-		SuppliedResult.Value = TargetStruct;
+		SuppliedResult.Value = *TargetStruct;
 		SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 
 		return SuppliedResult;
@@ -829,10 +986,9 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsUObjectTypeCommon(const FNam
 
 		if (StructProperty->Struct == FlowDataPinPropertyStruct)
 		{
-			TFlowDataPinProperty ValueStruct;
-			StructProperty->GetValue_InContainer(this, &ValueStruct);
+			const TFlowDataPinProperty* ValueStruct = StructProperty->ContainerPtrToValuePtr<TFlowDataPinProperty>(this);
 
-			SuppliedResult.SetValueFromPropertyWrapper(ValueStruct);
+			SuppliedResult.SetValueFromPropertyWrapper(*ValueStruct);
 			SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 		}
 
@@ -852,9 +1008,8 @@ TFlowDataPinResultType UFlowNode::TrySupplyDataPinAsUObjectTypeCommon(const FNam
 
 	if (const TFieldPropertySoftObjectType1* UnrealProperty1 = CastField<TFieldPropertySoftObjectType1>(OutFoundProperty))
 	{
-		// FSoftObjectPath / TSoftObjectPtr (or their Class variants)
-		const FSoftObjectPath SoftObjectPath = UnrealProperty1->GetPropertyValue_InContainer(this).ToSoftObjectPath();
-		SuppliedResult.SetValueFromSoftPath(SoftObjectPath);
+		// TSoftObjectPtr / TSoftClassPtr, resolved through the property's own soft pointer which caches the object
+		SuppliedResult.SetValueFromSoftObjectPtr(*UnrealProperty1->GetPropertyValuePtr_InContainer(this));
 		SuppliedResult.Result = EFlowDataPinResolveResult::Success;
 
 		return SuppliedResult;
@@ -20,5 +20,9 @@ class FLOW_API UFlowNodeAddOnBlueprint : public UBlueprint
 
 	virtual bool SupportsDelegates() const override { return false; }
 	// --
+
+	// UObject
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+	// --
 #endif
 };
@@ -0,0 +1,85 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/FlowNode.h"
+#include "Templates/Function.h"
+#include <atomic>
+#include "FlowNodeAsync.generated.h"
+
+// Shared by the node and its running task, long work can poll it to stop early
+class FFlowAsyncTaskCancellation
+{
+public:
+	bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+
+private:
+	std::atomic<bool> bCancelled = false;
+};
+
+/**
+ * Base for nodes moving heavy work off the game thread, i.e. queries, path requests or file lookups
+ * LaunchTask resolves inputs on the game thread and calls RunAsyncTask, the work runs on UE::Tasks workers with the captured values
+ * Its result is passed back to the game thread, where OnCompleted triggers outputs. The node stays active until then
+ * Work must not touch UObjects. Finishing the node cancels the running task and its result is dropped
+ * Running task isn't saved, the loaded node launches it again
+ */
+UCLASS(Abstract, NotBlueprintable)
+class FLOW_API UFlowNodeAsync : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	// Restores the task after loading the SaveGame
+	UPROPERTY(SaveGame)
+	bool bTaskRunning;
+
+	// Changes with every launched or cancelled task, so results of previous tasks are dropped
+	uint32 TaskSerial = 0;
+
+	TSharedPtr<FFlowAsyncTaskCancellation> TaskCancellation;
+
+public:
+	bool IsTaskRunning() const { return bTaskRunning; }
+
+protected:
+	// Triggered by the default input pin and after loading the node with the running task, implementations call RunAsyncTask
+	virtual void LaunchTask() PURE_VIRTUAL(UFlowNodeAsync::LaunchTask);
+
+	/**
+	 * Runs Work on the worker thread, then OnCompleted with its result on the game thread
+	 * OnCompleted isn't called if the task has been cancelled or the node finished meanwhile
+	 * Launching the task while another one is running cancels the previous one
+	 */
+	template <typename ResultType>
+	void RunAsyncTask(TUniqueFunction<ResultType(const FFlowAsyncTaskCancellation& Cancellation)>&& Work, TUniqueFunction<void(ResultType&& Result)>&& OnCompleted)
+	{
+		RunErasedAsyncTask([Work = MoveTemp(Work), OnCompleted = MoveTemp(OnCompleted)](const FFlowAsyncTaskCancellation& Cancellation) mutable -> TUniqueFunction<void()>
+		{
+			// the result moves from the worker to the game thread together with the callback
+			return [Result = Work(Cancellation), OnCompleted = MoveTemp(OnCompleted)]() mutable
+			{
+				OnCompleted(MoveTemp(Result));
+			};
+		});
+	}
+
+	// Drops the result of the running task and tells the task to stop
+	void CancelTask();
+
+	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void ForceFinishNode() override;
+	virtual void Cleanup() override;
+	virtual void DeinitializeInstance() override;
+
+	virtual void OnLoad_Implementation() override;
+
+#if WITH_EDITOR
+	virtual FString GetStatusString() const override;
+#endif
+
+private:
+	void RunErasedAsyncTask(TUniqueFunction<TUniqueFunction<void()>(const FFlowAsyncTaskCancellation&)>&& Work);
+	void CompleteTask(const uint32 CompletedSerial, TUniqueFunction<void()>&& OnCompleted);
+};
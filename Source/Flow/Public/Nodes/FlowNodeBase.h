@@ -6,9 +6,12 @@
 
 #include "Interfaces/FlowCoreExecutableInterface.h"
 #include "Interfaces/FlowContextPinSupplierInterface.h"
+#include "FlowLogChannels.h"
 #include "FlowMessageLog.h"
 #include "FlowTags.h" // used by subclasses
 #include "FlowTypes.h"
+#include "Types/FlowArray.h"
+#include "Types/FlowBlueprintEvents.h"
 #include "Types/FlowDataPinResults.h"
 
 #include "FlowNodeBase.generated.h"
@@ -22,6 +25,7 @@ class IFlowOwnerInterface;
 class IFlowDataPinValueSupplierInterface;
 struct FFlowPin;
 struct FFlowNamedDataPinProperty;
+struct FStreamableHandle;
 
 #if WITH_EDITORONLY_DATA
 DECLARE_DELEGATE(FFlowNodeEvent);
@@ -35,8 +39,18 @@ struct FFlowPinValueSupplierData
 {
 	FName SupplierPinName;
 	const IFlowDataPinValueSupplierInterface* PinValueSupplier = nullptr;
+
+	// Supplier can be called through the _Implementation functions, skipping the Execute_ thunks
+	bool bNativeSupplier = false;
+
+	// Set if the supplier is a Flow Node, allows memoizing its values
+	const UFlowNode* SupplierFlowNode = nullptr;
 };
 
+// Suppliers ordered from the lowest to the highest priority
+// Inline storage covers the usual chain (node default, connected node, external supplier), so resolving a data pin doesn't allocate
+typedef FlowArray::TInlineArray<FFlowPinValueSupplierData, 4> FFlowPinValueSupplierDataArray;
+
 // Helper template to reduce (some) of the boilerplate in TryResolveDataPinAs...() functions
 template <typename TFlowDataPinResultType, EFlowPinType PinType>
 struct TResolveDataPinWorkingData
@@ -47,11 +61,28 @@ struct TResolveDataPinWorkingData
 	const UFlowNode* FlowNode = nullptr;
 	const FFlowPin* FlowPin = nullptr;
 	
-	TArray<FFlowPinValueSupplierData> PinValueSupplierDatas;
+	FFlowPinValueSupplierDataArray PinValueSupplierDatas;
 
 	static constexpr bool bCheckDefaultProperties = true;
 };
 
+// AddOns of the node's whole AddOn tree, flattened in the order of ForEachAddOn and grouped by capability
+// Built after AddOn instances are initialized, so per-trigger dispatch is a flat loop without recursion or class checks
+struct FFlowAddOnDispatchTables
+{
+	// Receive ExecuteInput from ExecuteInputForSelfAndAddOns
+	TArray<UFlowNodeAddOn*> AddOns;
+
+	// Implement IFlowPredicateInterface
+	TArray<UFlowNodeAddOn*> Predicates;
+
+	// Implement IFlowDataPinValueSupplierInterface
+	TArray<UFlowNodeAddOn*> DataPinSuppliers;
+
+	// Returns the table matching the class or interface queried by ForEachAddOnForClass, if there's one
+	const TArray<UFlowNodeAddOn*>* FindTableForClass(const UClass& InterfaceOrClass) const;
+};
+
 /**
  * The base class for UFlowNode and UFlowNodeAddOn, with their shared functionality
  */
@@ -67,6 +98,7 @@ class FLOW_API UFlowNodeBase
 	friend class UFlowAsset;
 	friend class UFlowGraphNode;
 	friend class UFlowGraphSchema;
+	friend struct FFlowNodeBlueprintMetadata;
 
 //////////////////////////////////////////////////////////////////////////
 // Node
@@ -74,6 +106,7 @@ class FLOW_API UFlowNodeBase
 public:
 	// UObject
 	virtual UWorld* GetWorld() const override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 	// --
 
 	// Dispatcher for ExecuteInput to ensure the AddOns get their ExecuteInput calls even if the node/addon
@@ -93,6 +126,25 @@ public:
 	virtual void Cleanup() override;
 	// --
 
+	// Blueprint overrides of this class, cached while the instance is initialized
+	const FFlowBlueprintEvents& GetBlueprintEvents() const { return BlueprintEvents.IsValid() ? *BlueprintEvents : *FFlowBlueprintEvents::Get(*GetClass()); }
+
+protected:
+	// Calls the Blueprint implementation with ProcessEvent, returns false if the event isn't overridden
+	bool ProcessBlueprintEvent(UFunction* Function, void* Parms = nullptr)
+	{
+		if (Function)
+		{
+			ProcessEvent(Function, Parms);
+			return true;
+		}
+		return false;
+	}
+
+private:
+	TSharedPtr<const FFlowBlueprintEvents> BlueprintEvents;
+
+public:
 	// Finish execution of node, it will call Cleanup
 	UFUNCTION(BlueprintCallable, Category = "FlowNode")
 	virtual void Finish() PURE_VIRTUAL(Finish)
@@ -163,8 +215,7 @@ public:
 
 	static TArray<UFlowNodeBase*> BuildFlowNodeBaseAncestorChain(UFlowNodeBase& FromFlowNodeBase, bool bIncludeFromFlowNodeBase);
 
-protected:
-	// Helper functions for GetFlowOwnerInterface()
+	// Helper functions for GetFlowOwnerInterface(), used by UFlowAsset resolving the owner once per instance
 	static IFlowOwnerInterface* TryGetFlowOwnerInterfaceFromRootFlowOwner(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass);
 	static IFlowOwnerInterface* TryGetFlowOwnerInterfaceActor(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass);
 
@@ -228,6 +279,16 @@ public:
 
 	EFlowForEachAddOnFunctionReturnValue ForEachAddOnForClass(const UClass& InterfaceOrClass, const FFlowNodeAddOnFunction& Function, EFlowForEachAddOnChildRule AddOnChildRule = EFlowForEachAddOnChildRule::AllChildren) const;
 
+	// Set only on initialized Flow Nodes with AddOns, AddOns themselves are dispatched by their node
+	const FFlowAddOnDispatchTables* GetAddOnDispatchTables() const { return AddOnDispatchTables.Get(); }
+
+protected:
+	void BuildAddOnDispatchTables();
+
+private:
+	// Shared, so dispatch loops keep the tables alive if the node is deinitialized by one of its AddOns, i.e. by finishing the flow
+	TSharedPtr<const FFlowAddOnDispatchTables> AddOnDispatchTables;
+
 public:
 
 //////////////////////////////////////////////////////////////////////////
@@ -281,13 +342,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = DataPins, DisplayName = "Try Resolve DataPin As Class")
 	FFlowDataPinResult_Class TryResolveDataPinAsClass(const FName& PinName) const;
 
-	// Public only for TResolveDataPinWorkingData's use
-	EFlowDataPinResolveResult TryResolveDataPinPrerequisites(const FName& PinName, const UFlowNode*& FlowNode, const FFlowPin*& FlowPin, EFlowPinType PinType) const;
+	// Resolves the pin and loads the soft-referenced object asynchronously, if it isn't resident
+	// OnResolved is called immediately if nothing has to be loaded, otherwise after loading, unless this node is destroyed before
+	// Returns the handle of the pending load, canceling it drops the callback
+	TSharedPtr<FStreamableHandle> TryResolveDataPinAsObjectAsync(const FName& PinName, TFunction<void(const FFlowDataPinResult_Object&)> OnResolved) const;
+	TSharedPtr<FStreamableHandle> TryResolveDataPinAsClassAsync(const FName& PinName, TFunction<void(const FFlowDataPinResult_Class&)> OnResolved) const;
+
+	// Resolves many input data pins in one pass, validates this node once and reuses the supplier chain buffer
+	// OutResults is aligned with PinNames, each holding the FFlowDataPinResult_... matching the pin type
+	// Returns the count of successfully resolved pins
+	int32 TryResolveDataPins(TConstArrayView<FName> PinNames, TArray<TInstancedStruct<FFlowDataPinResult>>& OutResults) const;
+
+	// Resolves every input data pin of the node, i.e. auto-generated data pins of the SubGraph node
+	int32 TryResolveAllInputDataPins(TArray<FName>& OutPinNames, TArray<TInstancedStruct<FFlowDataPinResult>>& OutResults) const;
+
+protected:
+	static TInstancedStruct<FFlowDataPinResult> TryResolveDataPinWithSuppliers(const FFlowPin& FlowPin, const FFlowPinValueSupplierDataArray& PinValueSupplierDatas);
+
+public:
+	// Public only for TResolveDataPinWorkingData's and FlowDataPin::TryResolveArray's use
+	EFlowDataPinResolveResult TryResolveDataPinPrerequisites(const FName& PinName, const UFlowNode*& FlowNode, const FFlowPin*& FlowPin, EFlowPinType PinType, bool bIsArray = false) const;
 
 protected:
 
 	bool TryAddValueToFormatNamedArguments(const FFlowNamedDataPinProperty& NamedDataPinProperty, FFormatNamedArguments& InOutArguments) const;
 
+	// Resolves the data pin to the value used by FText::Format, complex types are exported "ToString"
+	bool TryResolveDataPinAsFormatArgumentValue(const FName& PinName, const EFlowPinType FlowPinType, FFormatArgumentValue& OutValue) const;
+
 public:
 
 //////////////////////////////////////////////////////////////////////////
@@ -426,6 +508,10 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "FlowNode", meta = (DevelopmentOnly))
 	void LogVerbose(FString Message) const;
 
+	// Shared by all Log methods, skipped before building the message if the category verbosity is disabled
+	// Prefer FLOW_LOG_NODE in native code, it doesn't even format the message then
+	void LogMessage(const FLogCategoryBase& Category, const ELogVerbosity::Type Verbosity, FString Message, const EFlowOnScreenMessageType OnScreenMessageType = EFlowOnScreenMessageType::Permanent) const;
+
 #if !UE_BUILD_SHIPPING
 protected:
 	bool BuildMessage(FString& Message) const;
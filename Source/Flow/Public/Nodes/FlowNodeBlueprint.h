@@ -3,8 +3,43 @@
 #pragma once
 
 #include "Engine/Blueprint.h"
+#include "UObject/TopLevelAssetPath.h"
 #include "FlowNodeBlueprint.generated.h"
 
+#if WITH_EDITOR
+struct FAssetData;
+
+/**
+ * Palette data of Flow Node and AddOn blueprints, stored as Asset Registry tags on saving the blueprint
+ * Allows building the node palette from FAssetData alone, so blueprints are loaded only when placing the node
+ */
+struct FLOW_API FFlowNodeBlueprintMetadata
+{
+	bool bPlaceable = false;
+
+	FString Category;
+	FText DisplayName;
+	FText ToolTip;
+	FString Keywords;
+
+	FTopLevelAssetPath GeneratedClassPath;
+
+	// Generated class and all its ancestors up to UFlowNodeBase
+	TArray<FTopLevelAssetPath> ClassAncestry;
+
+	// UFlowNode::AllowedAssetClasses and DeniedAssetClasses, empty for AddOns
+	TArray<FTopLevelAssetPath> AllowedAssetClasses;
+	TArray<FTopLevelAssetPath> DeniedAssetClasses;
+
+	static void AddAssetRegistryTags(const UBlueprint& Blueprint, FAssetRegistryTagsContext Context);
+
+	// Returns false if the blueprint has been saved without the tags, it has to be loaded then
+	static bool FromAssetData(const FAssetData& AssetData, FFlowNodeBlueprintMetadata& OutMetadata);
+
+	bool IsChildOf(const UClass* Class) const;
+};
+#endif
+
 /**
  * Flow Node Blueprint class
  */
@@ -18,5 +53,9 @@ class FLOW_API UFlowNodeBlueprint : public UBlueprint
 	virtual bool SupportedByDefaultBlueprintFactory() const override { return false; }
 	virtual bool SupportsDelegates() const override { return false; }
 	// --
+
+	// UObject
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+	// --
 #endif
 };
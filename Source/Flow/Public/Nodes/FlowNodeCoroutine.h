@@ -0,0 +1,203 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowCoroutine.h"
+#include "FlowEventBus.h"
+#include "FlowTimerWheel.h"
+#include "Nodes/FlowNodeAsync.h"
+#include "FlowNodeCoroutine.generated.h"
+
+// Resumes the coroutine once the input pin is triggered, or immediately if the input has been latched since the previous wait
+struct FFlowAwaitInput
+{
+	UFlowNodeCoroutine& Node;
+	FName PinName;
+
+	bool await_ready() const;
+	void await_suspend(std::coroutine_handle<>) const;
+	void await_resume() const {}
+};
+
+// Resumes the coroutine after the time passes on the Flow timers of the instance, so it's paused together with the graph
+struct FFlowAwaitTime
+{
+	UFlowNodeCoroutine& Node;
+	float Seconds;
+
+	bool await_ready() const { return false; }
+	void await_suspend(std::coroutine_handle<>) const;
+	void await_resume() const {}
+};
+
+// Resumes the coroutine with the notify sent by the component with the Identity Tag, see FFlowEventBus
+struct FFlowAwaitNotify
+{
+	UFlowNodeCoroutine& Node;
+	FGameplayTag IdentityTag;
+	FGameplayTag NotifyTag;
+	EFlowEventType EventType;
+	FFlowEvent Event;
+
+	bool await_ready() const { return false; }
+	void await_suspend(std::coroutine_handle<>);
+	FFlowEvent await_resume() const { return Event; }
+};
+
+// Resumes the coroutine with the result of the work executed by UE::Tasks, see UFlowNodeAsync
+template <typename ResultType>
+struct TFlowAwaitTask
+{
+	UFlowNodeCoroutine& Node;
+	TUniqueFunction<ResultType(const FFlowAsyncTaskCancellation& Cancellation)> Work;
+	TOptional<ResultType> Result;
+
+	bool await_ready() const { return false; }
+	void await_suspend(std::coroutine_handle<>);
+	ResultType await_resume() { return MoveTemp(Result.GetValue()); }
+};
+
+/**
+ * Base for latent nodes written as a single C++20 coroutine, instead of the state machine spread across input and timer callbacks
+ * RunCoroutine co_awaits input pins, Flow timers, notifies and async tasks, frames are allocated from the pool of the Flow Subsystem
+ * Only RunCoroutine itself can co_await, as the node keeps a single suspended frame
+ * Coroutine frame can't be saved. Body records its progress by SetCheckpoint, the loaded node starts RunCoroutine again from the saved checkpoint
+ * Finishing the node destroys the frame at its current suspension point, so the body should co_return right after finishing the node
+ */
+UCLASS(Abstract, NotBlueprintable)
+class FLOW_API UFlowNodeCoroutine : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+	friend struct FFlowAwaitInput;
+	friend struct FFlowAwaitTime;
+	friend struct FFlowAwaitNotify;
+	template <typename ResultType> friend struct TFlowAwaitTask;
+
+protected:
+	// Outputs triggered after waiting for timers, notifies and async tasks are executed by the trigger queue in the next frame
+	// The graph doesn't run inside these callbacks then, outputs triggered after waiting for input pins are always executed immediately
+	UPROPERTY(EditAnywhere, Category = "Coroutine")
+	bool bDeferResumedOutputs;
+
+private:
+	// Restores the coroutine after loading the SaveGame
+	UPROPERTY(SaveGame)
+	bool bCoroutineRunning;
+
+	UPROPERTY(SaveGame)
+	int32 Checkpoint;
+
+	FFlowCoroutine Coroutine;
+
+	// Frame can't be destroyed while it runs, so finishing the node from the body destroys it after the body suspends
+	bool bCoroutineExecuting = false;
+	bool bDestroyCoroutinePending = false;
+
+	// Changes with every finished wait, so timers, notifies and tasks of previous waits are ignored
+	uint32 AwaitSerial = 0;
+
+	FName AwaitedInput;
+
+	// Inputs triggered while not awaited, consumed by the next wait for the same pin
+	TArray<FName> LatchedInputs;
+
+	FFlowTimerHandle AwaitTimerHandle;
+
+	FFlowEventWaiter AwaitEventWaiter;
+	FFlowAwaitNotify* AwaitedNotify = nullptr;
+
+	TSharedPtr<FFlowAsyncTaskCancellation> AwaitTaskCancellation;
+
+public:
+	bool IsCoroutineRunning() const { return bCoroutineRunning; }
+	int32 GetCheckpoint() const { return Checkpoint; }
+
+protected:
+	// Started by the default input pin with zero, and after loading the node with the saved checkpoint
+	virtual FFlowCoroutine RunCoroutine(const int32 FromCheckpoint) PURE_VIRTUAL(UFlowNodeCoroutine::RunCoroutine, return FFlowCoroutine(););
+
+	FFlowAwaitInput WaitForInput(const FName& PinName) { return {*this, PinName}; }
+
+	// Zero or negative time resumes in the next frame
+	FFlowAwaitTime WaitSeconds(const float Seconds) { return {*this, Seconds}; }
+	FFlowAwaitTime WaitNextTick() { return {*this, 0.f}; }
+
+	// Empty NotifyTag accepts any notify of the component
+	FFlowAwaitNotify WaitForNotify(const FGameplayTag& IdentityTag, const FGameplayTag& NotifyTag = FGameplayTag(), const EFlowEventType EventType = EFlowEventType::NotifyFromComponent)
+	{
+		return {*this, IdentityTag, NotifyTag, EventType, FFlowEvent()};
+	}
+
+	// Work must not touch UObjects, inputs have to be resolved before launching it
+	template <typename ResultType>
+	TFlowAwaitTask<ResultType> RunAsync(TUniqueFunction<ResultType(const FFlowAsyncTaskCancellation& Cancellation)>&& Work)
+	{
+		return {*this, MoveTemp(Work), TOptional<ResultType>()};
+	}
+
+	// Saved with the node, passed to RunCoroutine after loading
+	void SetCheckpoint(const int32 NewCheckpoint);
+
+	// Destroys the coroutine without finishing the node
+	void CancelCoroutine();
+
+	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void ForceFinishNode() override;
+	virtual void Cleanup() override;
+	virtual void DeinitializeInstance() override;
+
+	virtual void OnLoad_Implementation() override;
+
+#if WITH_EDITOR
+	virtual FString GetStatusString() const override;
+#endif
+
+private:
+	void StartCoroutine(const int32 FromCheckpoint);
+	void ResumeCoroutine(const bool bDeferOutputs);
+	void ClearAwait();
+
+	bool ConsumeLatchedInput(const FName& PinName);
+	void AwaitInput(const FName& PinName);
+	void AwaitTime(const float Seconds);
+	void AwaitNotify(FFlowAwaitNotify& Awaiter);
+	void AwaitTask(TUniqueFunction<TUniqueFunction<void()>(const FFlowAsyncTaskCancellation&)>&& Work);
+
+	void OnAwaitedTime(const uint32 Serial);
+	void OnAwaitedEvent(const FFlowEvent& Event);
+	void OnAwaitedTask(const uint32 Serial, TUniqueFunction<void()>&& StoreResult);
+};
+
+inline bool FFlowAwaitInput::await_ready() const
+{
+	return Node.ConsumeLatchedInput(PinName);
+}
+
+inline void FFlowAwaitInput::await_suspend(std::coroutine_handle<>) const
+{
+	Node.AwaitInput(PinName);
+}
+
+inline void FFlowAwaitTime::await_suspend(std::coroutine_handle<>) const
+{
+	Node.AwaitTime(Seconds);
+}
+
+inline void FFlowAwaitNotify::await_suspend(std::coroutine_handle<>)
+{
+	Node.AwaitNotify(*this);
+}
+
+template <typename ResultType>
+void TFlowAwaitTask<ResultType>::await_suspend(std::coroutine_handle<>)
+{
+	// the result is stored on the game thread, the awaiter in the frame stays valid until the wait finishes
+	Node.AwaitTask([this, Work = MoveTemp(Work)](const FFlowAsyncTaskCancellation& Cancellation) mutable -> TUniqueFunction<void()>
+	{
+		return [this, Value = Work(Cancellation)]() mutable
+		{
+			Result.Emplace(MoveTemp(Value));
+		};
+	});
+}
@@ -0,0 +1,67 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+
+#include "Nodes/FlowNode.h"
+#include "FlowNodeTickable.generated.h"
+
+/**
+ * Base for nodes polling the world while active, instead of looping the Timer node with a tiny Step Time
+ * Nodes of the same tick group are ticked by a single tick function owned by the Flow Subsystem, one node class after another
+ */
+UCLASS(Abstract, Blueprintable, HideCategories = Object)
+class FLOW_API UFlowNodeTickable : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+	friend class UFlowSubsystem;
+
+protected:
+	// Applied when the tick is enabled
+	UPROPERTY(EditAnywhere, Category = "Tick")
+	TEnumAsByte<ETickingGroup> TickGroup;
+
+	// Seconds between ticks of this node, zero ticks every frame
+	UPROPERTY(EditAnywhere, Category = "Tick", meta = (ClampMin = 0))
+	float TickInterval;
+
+	// If false, tick needs to be enabled by calling SetNodeTickEnabled
+	UPROPERTY(EditAnywhere, Category = "Tick")
+	bool bStartWithTickEnabled;
+
+private:
+	// Restores the tick after loading the SaveGame
+	UPROPERTY(SaveGame)
+	bool bTickEnabled;
+
+	// Position in the tick list of the Flow Subsystem
+	int32 TickBucketIndex = INDEX_NONE;
+	int32 TickEntryIndex = INDEX_NONE;
+	ETickingGroup RegisteredTickGroup = TG_PrePhysics;
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "FlowNode")
+	void SetNodeTickEnabled(const bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category = "FlowNode")
+	bool IsNodeTickEnabled() const { return bTickEnabled; }
+
+protected:
+	// Called with the time passed since the previous tick of this node
+	virtual void TickNode(const float DeltaTime);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "FlowNode", meta = (DisplayName = "Tick Node"))
+	void K2_TickNode(const float DeltaTime);
+
+	virtual void OnActivate() override;
+	virtual void Cleanup() override;
+	virtual void DeinitializeInstance() override;
+
+	virtual void OnLoad_Implementation() override;
+
+private:
+	void RegisterTick();
+	void UnregisterTick();
+};
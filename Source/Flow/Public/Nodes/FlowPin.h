@@ -23,12 +23,15 @@ struct FLOW_API FFlowPin
 	UPROPERTY(EditDefaultsOnly, Category = FlowPin)
 	FName PinName;
 
+#if WITH_EDITORONLY_DATA
 	// An optional Display Name, you can use it to override PinName without the need to update graph connections
+	// Display data isn't cooked, so every node instance copies only the pin name and type
 	UPROPERTY(EditDefaultsOnly, Category = FlowPin)
 	FText PinFriendlyName;
 
 	UPROPERTY(EditDefaultsOnly, Category = FlowPin)
 	FString PinToolTip;
+#endif // WITH_EDITORONLY_DATA
 
 protected:
 	// PinType (implies PinCategory)
@@ -40,6 +43,11 @@ protected:
 	UPROPERTY()
 	TWeakObjectPtr<UObject> PinSubCategoryObject;
 
+	// Pin carries an array of PinType values, see IsArraySupportedPinType
+	// Set by harvesting array properties, the values are resolved as views via FlowDataPin::TryResolveArray
+	UPROPERTY()
+	bool bIsArray = false;
+
 #if WITH_EDITORONLY_DATA
 	// Filter for limiting the compatible classes for this data pin.
 	// This property is editor-only, but it is automatically copied into PinSubCategoryObject if the PinType matches (for runtime use).
@@ -122,40 +130,38 @@ public:
 
 	FFlowPin(const FStringView InPinName, const FText& InPinFriendlyName)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
 	{
+		SetDisplayData(InPinFriendlyName, FString());
 	}
 
 	FFlowPin(const FStringView InPinName, const FString& InPinTooltip)
 		: PinName(InPinName)
-		, PinToolTip(InPinTooltip)
 	{
+		SetDisplayData(FText::GetEmpty(), InPinTooltip);
 	}
 
 	FFlowPin(const FStringView InPinName, const FText& InPinFriendlyName, const FString& InPinTooltip)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
-		, PinToolTip(InPinTooltip)
 	{
+		SetDisplayData(InPinFriendlyName, InPinTooltip);
 	}
 
 	FFlowPin(const FName& InPinName, const FText& InPinFriendlyName)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
 	{
+		SetDisplayData(InPinFriendlyName, FString());
 	}
 
 	FFlowPin(const FName& InPinName, const FText& InPinFriendlyName, const FString& InPinTooltip)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
-		, PinToolTip(InPinTooltip)
 	{
+		SetDisplayData(InPinFriendlyName, InPinTooltip);
 	}
 
 	FFlowPin(const FName& InPinName, const FText& InPinFriendlyName, EFlowPinType InFlowPinType, UObject* SubCategoryObject = nullptr)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
 	{
+		SetDisplayData(InPinFriendlyName, FString());
 		SetPinType(InFlowPinType, SubCategoryObject);
 	}
 
@@ -170,6 +176,15 @@ public:
 		return !PinName.IsNone();
 	}
 
+	// Display data is editor-only, it's ignored in builds without editor data
+	FORCEINLINE void SetDisplayData(const FText& InPinFriendlyName, const FString& InPinToolTip)
+	{
+#if WITH_EDITORONLY_DATA
+		PinFriendlyName = InPinFriendlyName;
+		PinToolTip = InPinToolTip;
+#endif
+	}
+
 	FORCEINLINE bool operator==(const FFlowPin& Other) const
 	{
 		return PinName == Other.PinName;
@@ -213,10 +228,16 @@ public:
 
 	const TWeakObjectPtr<UObject>& GetPinSubCategoryObject() const { return PinSubCategoryObject; }
 
+	void SetIsArray(const bool bInIsArray) { bIsArray = bInIsArray; }
+	bool IsArray() const { return bIsArray; }
+
+	// Pin types with contiguous array storage, see FFlowDataPinArrayProperty
+	static bool IsArraySupportedPinType(EFlowPinType FlowPinType);
+
 	static bool ArePinArraysMatchingNamesAndTypes(const TArray<FFlowPin>& Left, const TArray<FFlowPin>& Right);
 	static bool DoPinsMatchNamesAndTypes(const FFlowPin& LeftPin, const FFlowPin& RightPin)
 	{
-		return (LeftPin.PinName == RightPin.PinName && LeftPin.PinType == RightPin.PinType && LeftPin.PinSubCategoryObject == RightPin.PinSubCategoryObject);
+		return (LeftPin.PinName == RightPin.PinName && LeftPin.PinType == RightPin.PinType && LeftPin.bIsArray == RightPin.bIsArray && LeftPin.PinSubCategoryObject == RightPin.PinSubCategoryObject);
 	}
 
 	// FFlowPin instance signatures for "trait" functions
@@ -286,6 +307,9 @@ public:
 	//   that should be auto-generated when the struct is used as a property in a UFlowNode.
 	//
 	//   The string value of the metadata should exactly match a value in EFlowPinType
+	//
+	//   TArray properties generate array pins of the given type, if their elements are stored
+	//   as the type's array storage (see TFlowDataPinArrayElementTraits), i.e. TArray<double> for Float
 	static const FName MetadataKey_FlowPinType;
 	// --
 
@@ -382,8 +406,20 @@ enum class EFlowPinActivationType : uint8
 	PassThrough
 };
 
+// Pin records are debugging data, compiled out of Shipping and dedicated server builds
+// Projects can override it by defining FLOW_WITH_PIN_RECORDS in their target rules
+#ifndef FLOW_WITH_PIN_RECORDS
+#define FLOW_WITH_PIN_RECORDS (!UE_BUILD_SHIPPING && !UE_SERVER)
+#endif
+
+// Lean server profile skips debugger hooks, runtime message log and on-screen messages, always enabled in dedicated server builds
+// Other builds enable it per world with bLeanDedicatedServer in Flow Settings, projects can override it by defining FLOW_LEAN_SERVER
+#ifndef FLOW_LEAN_SERVER
+#define FLOW_LEAN_SERVER UE_SERVER
+#endif
+
 // Every time pin is activated, we record it and display this data while user hovers mouse over pin
-#if !UE_BUILD_SHIPPING
+#if FLOW_WITH_PIN_RECORDS
 struct FLOW_API FPinRecord
 {
 	double Time;
@@ -401,4 +437,38 @@ struct FLOW_API FPinRecord
 private:
 	FORCEINLINE static FString DoubleDigit(const int32 Number);
 };
+
+// Pin activation history, overwriting the oldest records once the capacity is reached
+// Capacity of 0 keeps all records
+struct FLOW_API FPinRecordHistory
+{
+	FPinRecordHistory()
+		: Capacity(0)
+		, Head(0)
+	{
+	}
+
+	void Add(FPinRecord&& Record, const int32 InCapacity);
+	void Reset();
+
+	int32 Num() const { return Records.Num(); }
+	bool IsEmpty() const { return Records.IsEmpty(); }
+
+	// Most recent record, history can't be empty
+	const FPinRecord& Last() const;
+
+	// Records ordered from the oldest to the most recent
+	TArray<FPinRecord> ToArray() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void SetCapacity(const int32 InCapacity);
+
+	TArray<FPinRecord> Records;
+	int32 Capacity;
+
+	// Index of the oldest record, once the buffer wrapped around
+	int32 Head;
+};
 #endif
@@ -0,0 +1,49 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/FlowNode.h"
+
+#include "FlowNode_ArrayStatistics.generated.h"
+
+/**
+ * Supplies the count, sum, min, max and average of the float array as output data pins
+ * Statistics are computed in a single pass over a view of the array, the values aren't copied
+ * Inside the data pin memo scope (see UFlowSettings::bMemoizeDataPinValues) resolving one output memoizes all of them, so the array is scanned once per trigger chain
+ * Min, Max and Average fail to resolve for an empty array, so the consumers use their default values
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "Array Statistics", Keywords = "count, sum, min, max, average, array"))
+class FLOW_API UFlowNode_ArrayStatistics : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	// Connect an array data pin or type the values
+	UPROPERTY(EditAnywhere, Category = "Array")
+	FFlowDataPinInputProperty_FloatArray Values;
+
+public:
+	// IFlowDataPinValueSupplierInterface
+	virtual FFlowDataPinResult_Int TrySupplyDataPinAsInt_Implementation(const FName& PinName) const override;
+	virtual FFlowDataPinResult_Float TrySupplyDataPinAsFloat_Implementation(const FName& PinName) const override;
+	// --
+
+	static const FName OUTPIN_Count;
+	static const FName OUTPIN_Sum;
+	static const FName OUTPIN_Min;
+	static const FName OUTPIN_Max;
+	static const FName OUTPIN_Average;
+
+protected:
+	struct FArrayStatistics
+	{
+		int32 Count = 0;
+		double Sum = 0.0;
+		double Min = 0.0;
+		double Max = 0.0;
+	};
+
+	EFlowDataPinResolveResult TryComputeStatistics(FArrayStatistics& OutStatistics) const;
+
+	static FFlowDataPinResult_Float GetFloatResult(const FArrayStatistics& Statistics, const FName& PinName);
+};
@@ -7,6 +7,7 @@
 
 /**
  * Save the state of the game to the save file
+ * Out is triggered right after taking the snapshot, Saved once the file is written. Writing happens on a worker thread
  * It's recommended to replace this with game-specific variant and this node to UFlowGraphSettings::HiddenNodes
  */
 UCLASS(NotBlueprintable, meta = (DisplayName = "Checkpoint", Keywords = "autosave, save"))
@@ -14,7 +15,16 @@ class FLOW_API UFlowNode_Checkpoint final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+public:
+	static FName OUTPIN_Saved;
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void OnLoad_Implementation() override;
+
+	void OnSaveGameWritten(const bool bSuccess);
+
+	// Snapshot queued behind the write in progress is taken after Out fired, then loading it mustn't fire Out again
+	UPROPERTY(SaveGame)
+	bool bOutTriggered = false;
 };
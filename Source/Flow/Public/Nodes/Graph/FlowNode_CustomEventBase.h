@@ -23,6 +23,10 @@ public:
 
 #if WITH_EDITOR
 public:
+	// UObject
+	virtual void PostEditUndo() override;
+	// --
+
 	virtual FString GetNodeDescription() const override;
 	virtual EDataValidationResult ValidateNode() override;
 #endif
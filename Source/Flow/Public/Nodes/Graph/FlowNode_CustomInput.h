@@ -16,9 +16,16 @@ class FLOW_API UFlowNode_CustomInput : public UFlowNode_CustomEventBase
 	friend class UFlowAsset;
 
 protected:
+	// Lets the owning client trigger this input with UFlowComponent::TriggerRootFlowCustomInputOnServer
+	// Server rejects client requests for other inputs, so keep it disabled for inputs granting rewards or completing quests
+	UPROPERTY(EditAnywhere, Category = "Networking")
+	bool bCanBeTriggeredByClient = false;
+
 	virtual void ExecuteInput(const FName& PinName) override;
 
 public:
+	bool CanBeTriggeredByClient() const { return bCanBeTriggeredByClient; }
+
 	virtual void PostEditImport() override;
 
 #if WITH_EDITOR
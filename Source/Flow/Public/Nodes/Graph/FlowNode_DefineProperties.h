@@ -39,6 +39,10 @@ public:
 
 	bool TryFormatTextWithNamedPropertiesAsParameters(const FText& FormatText, FText& OutFormattedText) const;
 
+	// UFlowNode
+	virtual FFlowDataPinArrayView TrySupplyDataPinAsArray(const FName& PinName) const override;
+	// --
+
 protected:
 	virtual bool TryFindPropertyByRemappedPinName(
 		const FName& RemappedPinName,
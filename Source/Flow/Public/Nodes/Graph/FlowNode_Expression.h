@@ -0,0 +1,102 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/Graph/FlowNode_DefineProperties.h"
+#include "Types/FlowExpression.h"
+
+#include "FlowNode_Expression.generated.h"
+
+UENUM(BlueprintType)
+enum class EFlowExpressionResultType : uint8
+{
+	Float,
+
+	// Fractional results are truncated
+	Int,
+
+	// Non-zero results are true
+	Bool
+};
+
+// Output data pin supplied by the expression
+USTRUCT()
+struct FLOW_API FFlowExpressionOutput
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	EFlowExpressionResultType ResultType = EFlowExpressionResultType::Float;
+
+	// i.e. clamp(Health / {Max Health}, 0, 1) or Level >= 3 && !bLocked
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	FString Expression;
+
+	// Compiled while editing the node, so instances don't parse the text
+	UPROPERTY()
+	FFlowExpressionProgram Program;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(VisibleAnywhere, Transient, Category = "Expression")
+	FString CompileError;
+#endif
+
+	EFlowPinType GetPinType() const;
+};
+
+/**
+ * Evaluates arithmetic and boolean expressions over its input data pins, supplying the results as output data pins
+ * Input properties of the Bool, Int and Float types are referenced by name, see FFlowExpressionProgram for the syntax
+ * Expressions are evaluated every time the output pin is resolved, inputs are resolved once per evaluation
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "Expression", Keywords = "math, compare, clamp, lerp, formula"))
+class FLOW_API UFlowNode_Expression : public UFlowNode_DefineProperties
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	TArray<FFlowExpressionOutput> Expressions;
+
+public:
+#if WITH_EDITOR
+	// UObject
+	virtual void PostLoad() override;
+	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
+	// --
+
+	// IFlowContextPinSupplierInterface
+	virtual bool SupportsContextPins() const override { return Super::SupportsContextPins() || !Expressions.IsEmpty(); }
+	// --
+
+	// IFlowDataPinGeneratorNodeInterface
+	virtual void AutoGenerateDataPins(TMap<FName, FName>& PinNameToBoundPropertyMap, TArray<FFlowPin>& InputDataPins, TArray<FFlowPin>& OutputDataPins) const override;
+	// --
+
+	virtual EDataValidationResult ValidateNode() override;
+	virtual void UpdateNodeConfigText_Implementation() override;
+#endif
+
+	// IFlowCoreExecutableInterface
+	virtual void InitializeInstance() override;
+	// --
+
+	// IFlowDataPinValueSupplierInterface
+	virtual FFlowDataPinResult_Bool TrySupplyDataPinAsBool_Implementation(const FName& PinName) const override;
+	virtual FFlowDataPinResult_Int TrySupplyDataPinAsInt_Implementation(const FName& PinName) const override;
+	virtual FFlowDataPinResult_Float TrySupplyDataPinAsFloat_Implementation(const FName& PinName) const override;
+	// --
+
+protected:
+	// Compiles the expression and checks its inputs, returns false with the error
+	bool CompileExpression(FFlowExpressionOutput& Output, FString& OutError) const;
+
+	// Type of the input property, Invalid if there's no Bool, Int or Float input of this name
+	EFlowPinType FindInputPinType(const FName& InputName) const;
+
+	// Evaluates the expression supplying the output pin of the given type
+	EFlowDataPinResolveResult TryEvaluateExpression(const FName& PinName, const EFlowPinType PinType, double& OutValue) const;
+};
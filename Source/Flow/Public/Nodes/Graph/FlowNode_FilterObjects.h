@@ -0,0 +1,51 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/FlowNode.h"
+
+#include "FlowNode_FilterObjects.generated.h"
+
+/**
+ * Supplies the objects of the array that pass the class and actor tag filters
+ * Filtering runs in a single pass over a view of the input array, every time an output pin is resolved
+ * Filtered array is owned by the resolve result, so concurrent or nested resolves don't overwrite each other
+ * Count pin only counts the passing objects, it doesn't build the filtered array
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "Filter Objects", Keywords = "actors, class, tag, array, count"))
+class FLOW_API UFlowNode_FilterObjects : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	// Connect an array data pin or pick the objects
+	UPROPERTY(EditAnywhere, Category = "Filter")
+	FFlowDataPinInputProperty_ObjectArray Objects;
+
+	// Objects must be of this class, all valid objects pass if it's not set
+	UPROPERTY(EditAnywhere, Category = "Filter", meta = (AllowAbstract))
+	TSubclassOf<UObject> ObjectClass;
+
+	// Actors must have this tag, other objects pass only if it's none
+	UPROPERTY(EditAnywhere, Category = "Filter")
+	FName ActorTag;
+
+public:
+	// UFlowNode
+	virtual FFlowDataPinArrayView TrySupplyDataPinAsArray(const FName& PinName) const override;
+	// --
+
+	// IFlowDataPinValueSupplierInterface
+	virtual FFlowDataPinResult_Int TrySupplyDataPinAsInt_Implementation(const FName& PinName) const override;
+	// --
+
+#if WITH_EDITOR
+	virtual void UpdateNodeConfigText_Implementation() override;
+#endif
+
+	static const FName OUTPIN_Filtered;
+	static const FName OUTPIN_Count;
+
+protected:
+	bool PassesFilter(const UObject* Object) const;
+};
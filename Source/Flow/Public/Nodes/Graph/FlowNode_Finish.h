@@ -16,5 +16,7 @@ class FLOW_API UFlowNode_Finish : public UFlowNode
 
 protected:
 	virtual bool CanFinishGraph() const override { return true; }
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+	virtual bool CanBeInInstanceCluster() const override { return true; }
 	virtual void ExecuteInput(const FName& PinName) override;
 };
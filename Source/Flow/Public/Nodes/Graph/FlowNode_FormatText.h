@@ -30,8 +30,23 @@ public:
 #endif
 
 	EFlowDataPinResolveResult TryResolveFormatText(const FName& PinName, FText& OutFormattedText) const;
+	EFlowDataPinResolveResult TryResolveFormatString(const FName& PinName, FString& OutFormattedString) const;
+
+	// Compiles FormatText and binds its arguments to named properties
+	void CompileFormat();
+
+	// Resolves bound data pins into FormatArguments, only valid on the compiled instance
+	void ResolveFormatArguments() const;
 
 public:
+	// IFlowCoreExecutableInterface
+	virtual void InitializeInstance() override;
+	virtual void DeinitializeInstance() override;
+	// --
+
+	// Formats without building the FText, for results that are only logged, hashed or compared
+	bool TryFormatString(FString& OutFormattedString) const;
+
 	// IFlowDataPinValueSupplierInterface
 	virtual FFlowDataPinResult_Name TrySupplyDataPinAsName_Implementation(const FName& PinName) const override;
 	virtual FFlowDataPinResult_String TrySupplyDataPinAsString_Implementation(const FName& PinName) const override;
@@ -39,4 +54,22 @@ public:
 	// --
 
 	static const FName OUTPIN_TextOutput;
+
+private:
+	struct FFormatArgumentSlot
+	{
+		FString ArgumentName;
+		FName PinName;
+		EFlowPinType PinType;
+	};
+
+	// Compiled on initializing the instance, the template node formats the text from scratch
+	bool bFormatCompiled = false;
+	FTextFormat CompiledFormat;
+
+	// Named properties referenced by the format, properties not used by it are never resolved
+	TArray<FFormatArgumentSlot> ArgumentSlots;
+
+	// Reused between evaluations, keys stay and only values are replaced
+	mutable FFormatNamedArguments FormatArguments;
 };
@@ -25,15 +25,25 @@ protected:
 	UPROPERTY(Transient)
 	TScriptInterface<IFlowDataPinValueSupplierInterface> FlowDataPinValueSupplierInterface;
 
+	// Supplier chains of the external supplier per output data pin
+	// Suppliers live in the outer graph, which outlives this graph
+	TMap<FName, FFlowPinValueSupplierDataArray> FlattenedExternalSuppliers;
+
 public:
 
 	// IFlowCoreExecutableInterface
 	virtual void ExecuteInput(const FName& PinName) override;
 	// --
 
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+
+	// external supplier is the Sub Graph node of the outer graph, which outlives this graph
+	virtual bool CanBeInInstanceCluster() const override { return true; }
+
 	// IFlowNodeWithExternalDataPinSupplierInterface
 	virtual void SetDataPinValueSupplier(IFlowDataPinValueSupplierInterface* DataPinValueSupplier) override;
 	virtual IFlowDataPinValueSupplierInterface* GetExternalDataPinSupplier() const override { return FlowDataPinValueSupplierInterface.GetInterface(); }
+	virtual const FFlowPinValueSupplierDataArray* FindFlattenedExternalSuppliers(const FName& PinName) const override { return FlattenedExternalSuppliers.Find(PinName); }
 #if WITH_EDITOR
 	virtual bool TryAppendExternalInputPins(TArray<FFlowPin>& InOutPins) const override;
 #endif
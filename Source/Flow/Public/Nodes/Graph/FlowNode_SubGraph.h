@@ -7,6 +7,16 @@
 
 #include "FlowNode_SubGraph.generated.h"
 
+struct FStreamableHandle;
+
+UENUM(BlueprintType)
+enum class EFlowSubGraphLoadPolicy : uint8
+{
+	Blocking,	// asset not loaded yet is loaded synchronously on activation
+	AsyncWait,	// node activation waits until the asset is loaded asynchronously
+	AsyncSkip	// node finishes immediately if the asset isn't loaded yet, loading it for the next activation
+};
+
 /**
  * Creates instance of provided Flow Asset and starts its execution
  */
@@ -19,6 +29,8 @@ public:
 	friend class UFlowAsset;
 	friend class FFlowNode_SubGraphDetails;
 	friend class UFlowSubsystem;
+	friend class FFlowAssetOptimizer;
+	friend class FFlowAssetDependencies;
 
 	static FFlowPin StartPin;
 	static FFlowPin FinishPin;
@@ -34,12 +46,35 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Graph")
 	bool bCanInstanceIdenticalAsset;
 
+	// Determines what happens if the asset isn't loaded yet when the node starts, loading from SaveGame is always blocking
+	UPROPERTY(EditAnywhere, Category = "Graph")
+	EFlowSubGraphLoadPolicy LoadPolicy;
+
+	// Written by saves before instance ids were added
 	UPROPERTY(SaveGame)
 	FString SavedAssetInstanceName;
 
+	UPROPERTY(SaveGame)
+	uint64 SavedAssetInstanceId = 0;
+
+	TSharedPtr<FStreamableHandle> AssetLoadHandle;
+
+	// Requested by the AsyncSkip policy for the next activation, so finishing the node doesn't cancel it
+	TSharedPtr<FStreamableHandle> SkippedAssetLoadHandle;
+
+	// Inputs triggered while waiting for the asset, passed to the Sub Graph once it's started
+	TArray<FName> PendingCustomInputs;
+
 protected:
 	virtual bool CanBeAssetInstanced() const;
 
+	bool IsLoadingAsset() const { return AssetLoadHandle.IsValid(); }
+	void RequestAssetLoad(TFunction<void()>&& OnLoaded);
+	void CancelAssetLoad();
+
+	void StartSubFlow();
+
+	virtual bool HasPreloadContent() const override { return !Asset.IsNull(); }
 	virtual void PreloadContent() override;
 	virtual void FlushContent() override;
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Nodes/FlowNode.h"
+#include "Types/FlowPredicateProgram.h"
 
 #include "FlowNode_Branch.generated.h"
 
@@ -18,10 +19,20 @@ public:
 	virtual EFlowAddOnAcceptResult AcceptFlowNodeAddOnChild_Implementation(const UFlowNodeAddOn* AddOnTemplate, const TArray<UFlowNodeAddOn*>& AdditionalAddOnsToAssumeAreChildren) const override;
 	// --
 
+	// IFlowCoreExecutableInterface
+	virtual void InitializeInstance() override;
+	virtual void DeinitializeInstance() override;
+	// --
+
 	// Event reacting on triggering Input pin
 	virtual void ExecuteInput(const FName& PinName) override;
 
 	static const FName INPIN_Evaluate;
 	static const FName OUTPIN_True;
 	static const FName OUTPIN_False;
+
+protected:
+
+	// Predicate AddOns flattened on initializing the instance, after AddOn instances are created
+	FFlowPredicateProgram PredicateProgram;
 };
@@ -13,6 +13,8 @@ class FLOW_API UFlowNode_Counter final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FFlowLightweightProgram;
+
 protected:
 	UPROPERTY(EditAnywhere, Category = "Counter", meta = (ClampMin = 2))
 	int32 Goal;
@@ -21,6 +23,10 @@ private:
 	UPROPERTY(SaveGame)
 	int32 CurrentSum;
 
+public:
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+	virtual bool CanBeInInstanceCluster() const override { return true; }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void Cleanup() override;
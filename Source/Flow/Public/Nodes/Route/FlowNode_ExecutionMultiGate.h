@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Nodes/FlowNode.h"
+#include "Types/FlowBitState.h"
 #include "FlowNode_ExecutionMultiGate.generated.h"
 
 /**
@@ -28,8 +29,9 @@ private:
 	UPROPERTY(SaveGame)
 	int32 NextOutput;
 
+	// Indexed by output pins
 	UPROPERTY(SaveGame)
-	TArray<bool> Completed;
+	FFlowBitState Completed;
 
 public:
 #if WITH_EDITOR
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "FlowTimerWheel.h"
 #include "Nodes/FlowNode.h"
 #include "FlowNode_ExecutionSequence.generated.h"
 
@@ -13,6 +14,8 @@ class FLOW_API UFlowNode_ExecutionSequence final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FFlowLightweightProgram;
+
 protected:
 	/**
 	 * If enabled and the graph is saved during gameplay, this node
@@ -29,7 +32,25 @@ protected:
 	UPROPERTY(SaveGame)
 	TSet<FGuid> ExecutedConnections;
 
+	/**
+	 * If above 0, only this many outputs are triggered per frame, remaining outputs are triggered in the following frames.
+	 * Outputs are always triggered in the pin order, so branches with expensive downstream chains don't spike a single frame.
+	 * Remaining outputs are also carried over to the next frame after exceeding UFlowSettings::TriggerQueueFrameBudget.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Sequence", meta = (ClampMin = 0))
+	int32 MaxBranchesPerFrame;
+
+private:
+	// Index of the first output not triggered yet
+	UPROPERTY(SaveGame)
+	int32 NextBranchIndex;
+
+	FFlowTimerHandle NextBranchesTimerHandle;
+
 public:
+	// deferred branches are triggered by the subsystem timer
+	virtual bool SupportsIsolatedExecution() const override { return MaxBranchesPerFrame == 0; }
+
 #if WITH_EDITOR
 	virtual bool CanUserAddOutput() const override { return true; }
 #endif
@@ -39,7 +60,8 @@ protected:
 	virtual void OnLoad_Implementation() override;
 	virtual void Cleanup() override;
 
-	void ExecuteNewConnections();
+	void ExecuteBranches();
+	bool ShouldDeferBranches(const int32 BranchesThisFrame) const;
 
 #if WITH_EDITOR
 public:
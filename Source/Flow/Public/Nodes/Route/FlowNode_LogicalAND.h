@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Nodes/FlowNode.h"
+#include "Types/FlowBitState.h"
 #include "FlowNode_LogicalAND.generated.h"
 
 /**
@@ -14,15 +15,22 @@ class FLOW_API UFlowNode_LogicalAND final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FFlowLightweightProgram;
+
 private:
+	// Indexed by input pins
 	UPROPERTY(SaveGame)
-	TSet<FName> ExecutedInputNames;
+	FFlowBitState ExecutedInputs;
 	
 #if WITH_EDITOR
 public:
 	virtual bool CanUserAddInput() const override { return true; }
 #endif
 
+public:
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+	virtual bool CanBeInInstanceCluster() const override { return true; }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void Cleanup() override;
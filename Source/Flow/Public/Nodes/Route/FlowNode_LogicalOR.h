@@ -14,6 +14,8 @@ class FLOW_API UFlowNode_LogicalOR final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FFlowLightweightProgram;
+
 protected:
 	UPROPERTY(EditAnywhere, Category = "Lifetime", SaveGame)
 	bool bEnabled;
@@ -32,6 +34,10 @@ public:
 	virtual bool CanUserAddInput() const override { return true; }
 #endif
 
+public:
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+	virtual bool CanBeInInstanceCluster() const override { return true; }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void Cleanup() override;
@@ -13,6 +13,11 @@ class FLOW_API UFlowNode_Reroute final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 	
+public:
+	virtual bool SupportsIsolatedExecution() const override { return true; }
+	virtual bool CanBeInInstanceCluster() const override { return true; }
+	virtual bool CanHibernate() const override { return true; }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 };
@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "Engine/EngineTypes.h"
+#include "FlowTimerWheel.h"
 #include "Nodes/FlowNode.h"
 #include "FlowNode_Timer.generated.h"
 
@@ -14,6 +14,8 @@ class FLOW_API UFlowNode_Timer : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FFlowLightweightProgram;
+
 protected:
 	// If the value is closer to 0, Timer will complete in next tick
 	UPROPERTY(EditAnywhere, Category = "Timer", meta = (ClampMin = 0.0f, DefaultForInputFlowPin, FlowPinType = Float))
@@ -26,8 +28,9 @@ protected:
 	static FName INPIN_CompletionTime;
 
 private:
-	FTimerHandle CompletionTimerHandle;
-	FTimerHandle StepTimerHandle;
+	// timers are owned by the Flow Subsystem, so they can be paused with the whole graph
+	FFlowTimerHandle CompletionTimerHandle;
+	FFlowTimerHandle StepTimerHandle;
 
 	UPROPERTY(SaveGame)
 	float ResolvedCompletionTime;
@@ -60,6 +63,9 @@ private:
 protected:
 	virtual void Cleanup() override;
 
+	// remaining time is captured in OnSave()
+	virtual bool CanReuseSaveData() const override { return false; }
+
 	virtual void OnSave_Implementation() override;
 	virtual void OnLoad_Implementation() override;
 	
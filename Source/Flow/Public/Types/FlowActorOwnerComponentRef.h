@@ -32,8 +32,12 @@ public:
 	bool IsConfigured() const { return !ComponentName.IsNone(); }
 	bool IsResolved() const;
 
+	// Uses the per-actor index of component names, built on the first call for the given actor
 	static UActorComponent* TryResolveComponentByName(const AActor& InActor, const FName& InComponentName);
 
+	// Has to be called after adding or removing components, unless the number of actor components changed anyway
+	static void InvalidateComponentNameIndex(const AActor& InActor);
+
 public:
 
 	// The name of the component
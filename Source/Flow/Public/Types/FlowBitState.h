@@ -0,0 +1,53 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowBitState.generated.h"
+
+/**
+ * Fixed-size set of flags used as the runtime state of route nodes, i.e. executed inputs or completed outputs
+ * Tests for all or any flag are popcounts over a few words, and it serializes as these words in SaveGame records
+ */
+USTRUCT()
+struct FLOW_API FFlowBitState
+{
+	GENERATED_BODY()
+
+	static constexpr int32 BitsPerWord = 32;
+
+	// Clears all flags and sets the number of them
+	void Init(const int32 InNumBits);
+	void Reset();
+
+	bool IsInitialized() const { return NumBits > 0; }
+	int32 Num() const { return NumBits; }
+	bool IsValidIndex(const int32 Index) const { return Index >= 0 && Index < NumBits; }
+
+	bool IsSet(const int32 Index) const
+	{
+		check(IsValidIndex(Index));
+		return (Words[Index / BitsPerWord] & (1u << (Index % BitsPerWord))) != 0;
+	}
+
+	void Set(const int32 Index)
+	{
+		check(IsValidIndex(Index));
+		Words[Index / BitsPerWord] |= 1u << (Index % BitsPerWord);
+	}
+
+	int32 CountSet() const;
+	int32 CountUnset() const { return NumBits - CountSet(); }
+
+	bool AreAllSet() const { return CountSet() == NumBits; }
+	bool IsAnySet() const;
+
+	// Returns the index of the randomly chosen flag which isn't set yet, or INDEX_NONE if all are set
+	int32 PickRandomUnset() const;
+
+private:
+	UPROPERTY(SaveGame)
+	TArray<uint32> Words;
+
+	UPROPERTY(SaveGame)
+	int32 NumBits = 0;
+};
@@ -0,0 +1,52 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Templates/SharedPointer.h"
+
+class UClass;
+class UFunction;
+
+/**
+ * Blueprint overrides of events called on Flow Node and AddOn instances, resolved once per class
+ * Null function means no Blueprint class in the hierarchy implements the event, so callers can skip ProcessEvent:
+ *  - BlueprintImplementableEvent isn't called at all
+ *  - BlueprintNativeEvent calls the native _Implementation directly
+ * Overridden events are called with ProcessEvent on the cached function, without looking it up by name
+ */
+struct FLOW_API FFlowBlueprintEvents
+{
+	// IFlowCoreExecutableInterface
+	UFunction* InitializeInstance = nullptr;
+	UFunction* DeinitializeInstance = nullptr;
+	UFunction* PreloadContent = nullptr;
+	UFunction* FlushContent = nullptr;
+	UFunction* OnActivate = nullptr;
+	UFunction* Cleanup = nullptr;
+	UFunction* ForceFinishNode = nullptr;
+	UFunction* ExecuteInput = nullptr;
+
+	// UFlowNode
+	UFunction* OnSave = nullptr;
+	UFunction* OnLoad = nullptr;
+	UFunction* OnPassThrough = nullptr;
+
+	// UFlowNodeTickable
+	UFunction* TickNode = nullptr;
+
+	// IFlowPredicateInterface
+	UFunction* EvaluatePredicate = nullptr;
+	UFunction* GetPredicateCacheDependencies = nullptr;
+
+	// IFlowDataPinValueSupplierInterface is implemented in C++ and none of its events is overridden by a Blueprint
+	bool bNativeDataPinSupplier = false;
+
+	// Resolved again after new classes have been registered, i.e. Blueprint compilation or hot reload
+	static TSharedRef<const FFlowBlueprintEvents> Get(const UClass& Class);
+
+private:
+	explicit FFlowBlueprintEvents(const UClass& Class);
+
+	// Returns the function only if it's been implemented by a Blueprint class
+	static UFunction* FindBlueprintEvent(const UClass& Class, const FName& FunctionName);
+};
@@ -7,6 +7,12 @@
 class FString;
 class UClass;
 
+namespace FlowClassUtils
+{
+	// Cached GetDerivedClasses check, resolved again only after new classes have been registered
+	FLOW_API bool HasDerivedClasses(const UClass* Class);
+}
+
 #if WITH_EDITOR
 namespace FlowClassUtils
 {
@@ -0,0 +1,276 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowAsset.h"
+#include "FlowStats.h"
+#include "Interfaces/FlowDataPinValueSupplierInterface.h"
+#include "Misc/ReverseIterate.h"
+#include "Nodes/FlowNode.h"
+#include "Types/FlowDataPinResults.h"
+#include "Types/FlowEnumUtils.h"
+#include "Types/FlowPinEnums.h"
+
+// Maps the data pin result type to its pin type and the supplier function
+template <typename TFlowDataPinResultType>
+struct TFlowDataPinResultTraits
+{
+	static_assert(sizeof(TFlowDataPinResultType) == 0, "Unsupported data pin result type, use one of the FFlowDataPinResult_ types");
+};
+
+#define FLOW_DATA_PIN_RESULT_TRAITS(PinTypeName) \
+	template <> \
+	struct TFlowDataPinResultTraits<FFlowDataPinResult_##PinTypeName> \
+	{ \
+		static constexpr EFlowPinType PinType = EFlowPinType::PinTypeName; \
+		static FFlowDataPinResult_##PinTypeName Supply(const FFlowPinValueSupplierData& SupplierData) \
+		{ \
+			return SupplierData.bNativeSupplier \
+				? SupplierData.PinValueSupplier->TrySupplyDataPinAs##PinTypeName##_Implementation(SupplierData.SupplierPinName) \
+				: IFlowDataPinValueSupplierInterface::Execute_TrySupplyDataPinAs##PinTypeName(CastChecked<UObject>(SupplierData.PinValueSupplier), SupplierData.SupplierPinName); \
+		} \
+	};
+
+// Must specialize traits for every EFlowPinType, except Exec
+FLOW_ASSERT_ENUM_MAX(EFlowPinType, 16);
+
+FLOW_DATA_PIN_RESULT_TRAITS(Bool)
+FLOW_DATA_PIN_RESULT_TRAITS(Int)
+FLOW_DATA_PIN_RESULT_TRAITS(Float)
+FLOW_DATA_PIN_RESULT_TRAITS(Name)
+FLOW_DATA_PIN_RESULT_TRAITS(String)
+FLOW_DATA_PIN_RESULT_TRAITS(Text)
+FLOW_DATA_PIN_RESULT_TRAITS(Enum)
+FLOW_DATA_PIN_RESULT_TRAITS(Vector)
+FLOW_DATA_PIN_RESULT_TRAITS(Rotator)
+FLOW_DATA_PIN_RESULT_TRAITS(Transform)
+FLOW_DATA_PIN_RESULT_TRAITS(GameplayTag)
+FLOW_DATA_PIN_RESULT_TRAITS(GameplayTagContainer)
+FLOW_DATA_PIN_RESULT_TRAITS(InstancedStruct)
+FLOW_DATA_PIN_RESULT_TRAITS(Object)
+FLOW_DATA_PIN_RESULT_TRAITS(Class)
+
+#undef FLOW_DATA_PIN_RESULT_TRAITS
+
+namespace FlowDataPin
+{
+	// Supplies the value, reusing the memoized one if the supplier's Flow Asset instance is inside the memo scope
+	template <typename TFlowDataPinResultType>
+	TFlowDataPinResultType Supply(const FFlowPinValueSupplierData& SupplierData)
+	{
+		UFlowAsset* FlowAsset = SupplierData.SupplierFlowNode ? Cast<UFlowAsset>(SupplierData.SupplierFlowNode->GetOuter()) : nullptr;
+		if (FlowAsset == nullptr || !FlowAsset->IsDataPinMemoActive())
+		{
+			return TFlowDataPinResultTraits<TFlowDataPinResultType>::Supply(SupplierData);
+		}
+
+		if (const TFlowDataPinResultType* MemoizedResult = FlowAsset->FindMemoizedDataPinValue<TFlowDataPinResultType>(*SupplierData.SupplierFlowNode, SupplierData.SupplierPinName))
+		{
+			INC_DWORD_STAT(STAT_FlowDataPinMemoHits);
+			return *MemoizedResult;
+		}
+
+		INC_DWORD_STAT(STAT_FlowDataPinMemoMisses);
+
+		TFlowDataPinResultType SuppliedResult = TFlowDataPinResultTraits<TFlowDataPinResultType>::Supply(SupplierData);
+		FlowAsset->MemoizeDataPinValue(*SupplierData.SupplierFlowNode, SupplierData.SupplierPinName, SuppliedResult);
+
+		return SuppliedResult;
+	}
+
+	/**
+	 * Zero-copy variant of TryResolveDataPinAs...() for large struct payloads, see UFlowNode::TryGetDataPinStructValuePtr
+	 * i.e. FlowDataPin::TryResolveStructValuePtr<FFlowDataPinOutputProperty_InstancedStruct, FInstancedStruct>(*this, PinName)
+	 * Returns nullptr if the preferred supplier doesn't serve the pin from a bound property, then use the by-value resolve
+	 * Pointer is valid for the duration of the calling function only
+	 */
+	template <typename TFlowDataPinProperty, typename TTargetStruct>
+	const TTargetStruct* TryResolveStructValuePtr(const UFlowNode& ConsumerNode, const FName& PinName)
+	{
+		FFlowPinValueSupplierDataArray SupplierDatas;
+		if (!ConsumerNode.TryGetFlowDataPinSupplierDatasForPinName(PinName, SupplierDatas))
+		{
+			return nullptr;
+		}
+
+		for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(SupplierDatas))
+		{
+			const UFlowNode* SupplierFlowNode = SupplierData.SupplierFlowNode;
+
+			// supplier computes its value, it can't be viewed
+			if (SupplierFlowNode == nullptr || !SupplierFlowNode->GetPinNameToBoundPropertyNameMap().Contains(SupplierData.SupplierPinName))
+			{
+				return nullptr;
+			}
+
+			if (const TTargetStruct* ValuePtr = SupplierFlowNode->TryGetDataPinStructValuePtr<TFlowDataPinProperty, TTargetStruct>(SupplierData.SupplierPinName))
+			{
+				return ValuePtr;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Resolves the array data pin as a view of the supplier's storage, values aren't copied
+	 * i.e. const TFlowDataPinArrayResult<double> Weights = FlowDataPin::TryResolveArray<double>(*this, TEXT("Weights"));
+	 * Only Flow Nodes supply arrays (see UFlowNode::TrySupplyDataPinAsArray), external suppliers are skipped
+	 * Values are valid for the duration of the calling function only
+	 */
+	template <typename TElementType>
+	TFlowDataPinArrayResult<TElementType> TryResolveArray(const UFlowNodeBase& ConsumerNode, const FName& PinName)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlowResolveDataPin);
+		INC_DWORD_STAT(STAT_FlowResolvedDataPins);
+
+		const UFlowNode* FlowNode = nullptr;
+		const FFlowPin* FlowPin = nullptr;
+		constexpr bool bIsArray = true;
+
+		const EFlowDataPinResolveResult PrerequisitesResult = ConsumerNode.TryResolveDataPinPrerequisites(PinName, FlowNode, FlowPin, TFlowDataPinArrayElementTraits<TElementType>::PinType, bIsArray);
+		if (PrerequisitesResult != EFlowDataPinResolveResult::Success)
+		{
+			return TFlowDataPinArrayResult<TElementType>(PrerequisitesResult);
+		}
+
+		// pin must be disconnected and have no default value available
+		TFlowDataPinArrayResult<TElementType> DataPinResult(EFlowDataPinResolveResult::FailedUnconnected);
+
+		FFlowPinValueSupplierDataArray SupplierDatas;
+		if (!FlowNode->TryGetFlowDataPinSupplierDatasForPinName(FlowPin->PinName, SupplierDatas))
+		{
+			return DataPinResult;
+		}
+
+		INC_DWORD_STAT_BY(STAT_FlowDataPinSuppliersVisited, SupplierDatas.Num());
+
+		for (const FFlowPinValueSupplierData& SupplierData : ReverseIterate(SupplierDatas))
+		{
+			if (SupplierData.SupplierFlowNode == nullptr)
+			{
+				DataPinResult.Result = EFlowDataPinResolveResult::FailedUnimplemented;
+				continue;
+			}
+
+			DataPinResult = SupplierData.SupplierFlowNode->TrySupplyDataPinAsArray(SupplierData.SupplierPinName).Get<TElementType>();
+
+			if (DataPinResult.Result == EFlowDataPinResolveResult::Success)
+			{
+				break;
+			}
+		}
+
+		return DataPinResult;
+	}
+}
+
+/**
+ * Typed handle to the input data pin, alternative to calling TryResolveDataPinAs...() with the pin name
+ * - declare it as a node member, i.e. TFlowDataPinHandle<FFlowDataPinResult_Int> CountPin = TFlowDataPinHandle<FFlowDataPinResult_Int>(TEXT("Count"));
+ * - call Initialize() from the node's InitializeInstance(), which validates the pin once
+ * - supplier chain is resolved on the first Get(), after the owning graph started and external suppliers are known
+ * - if the preferred supplier versions its pin (UFlowNode::MarkDataPinDirty), the resolved value is cached until the version changes
+ */
+template <typename TFlowDataPinResultType>
+struct TFlowDataPinHandle
+{
+	explicit TFlowDataPinHandle(const FName InPinName)
+		: PinName(InPinName)
+	{
+	}
+
+	bool Initialize(const UFlowNode& InOwnerNode)
+	{
+		OwnerNode = &InOwnerNode;
+		SupplierDatas.Reset();
+		bSupplierDatasResolved = false;
+		CachedVersion = 0;
+
+		const FFlowPin* FlowPin = InOwnerNode.GetInputPins().FindByKey(PinName);
+		if (FlowPin == nullptr)
+		{
+			InitializeResult = EFlowDataPinResolveResult::FailedMissingPin;
+		}
+		else if (FlowPin->GetPinType() != TFlowDataPinResultTraits<TFlowDataPinResultType>::PinType || FlowPin->IsArray())
+		{
+			InitializeResult = EFlowDataPinResolveResult::FailedMismatchedType;
+		}
+		else
+		{
+			InitializeResult = EFlowDataPinResolveResult::Success;
+		}
+
+		return IsValid();
+	}
+
+	bool IsValid() const { return InitializeResult == EFlowDataPinResolveResult::Success; }
+	const FName& GetPinName() const { return PinName; }
+
+	// Version of the cached value, zero if the value isn't cached
+	uint32 GetCachedVersion() const { return CachedVersion; }
+
+	TFlowDataPinResultType Get() const
+	{
+		TFlowDataPinResultType DataPinResult;
+
+		if (!IsValid())
+		{
+			DataPinResult.Result = InitializeResult;
+			return DataPinResult;
+		}
+
+		if (!bSupplierDatasResolved)
+		{
+			OwnerNode->TryGetFlowDataPinSupplierDatasForPinName(PinName, SupplierDatas);
+			bSupplierDatasResolved = true;
+		}
+
+		// only the preferred supplier can be cached, as lower priority values are used only while it fails
+		uint32 PreferredVersion = 0;
+		if (!SupplierDatas.IsEmpty())
+		{
+			const FFlowPinValueSupplierData& PreferredSupplier = SupplierDatas.Last();
+			if (PreferredSupplier.SupplierFlowNode)
+			{
+				PreferredVersion = PreferredSupplier.SupplierFlowNode->GetDataPinVersion(PreferredSupplier.SupplierPinName);
+			}
+
+			if (PreferredVersion != 0 && PreferredVersion == CachedVersion)
+			{
+				return CachedResult;
+			}
+		}
+
+		// pin must be disconnected and have no default value available
+		DataPinResult.Result = EFlowDataPinResolveResult::FailedUnconnected;
+
+		for (int32 Index = SupplierDatas.Num() - 1; Index >= 0; --Index)
+		{
+			DataPinResult = FlowDataPin::Supply<TFlowDataPinResultType>(SupplierDatas[Index]);
+
+			if (DataPinResult.Result == EFlowDataPinResolveResult::Success)
+			{
+				if (PreferredVersion != 0 && Index == SupplierDatas.Num() - 1)
+				{
+					CachedResult = DataPinResult;
+					CachedVersion = PreferredVersion;
+				}
+				break;
+			}
+		}
+
+		return DataPinResult;
+	}
+
+private:
+	FName PinName;
+	const UFlowNode* OwnerNode = nullptr;
+	EFlowDataPinResolveResult InitializeResult = EFlowDataPinResolveResult::FailedWithError;
+
+	mutable FFlowPinValueSupplierDataArray SupplierDatas;
+	mutable bool bSupplierDatasResolved = false;
+
+	mutable TFlowDataPinResultType CachedResult;
+	mutable uint32 CachedVersion = 0;
+};
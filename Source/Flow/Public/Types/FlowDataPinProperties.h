@@ -4,9 +4,11 @@
 
 #include "GameplayTagContainer.h"
 #include "StructUtils/InstancedStruct.h"
+#include "UObject/SoftObjectPtr.h"
 #include "UObject/Class.h"
 
 #include "Nodes/FlowPin.h"
+#include "Types/FlowDataPinResults.h"
 #include "FlowDataPinProperties.generated.h"
 
 class FStructProperty;
@@ -23,6 +25,10 @@ struct FFlowDataPinProperty
 
 	FLOW_API virtual EFlowPinType GetFlowPinType() const { return EFlowPinType::Invalid; }
 	FLOW_API virtual bool IsInputProperty() const { return false; }
+	FLOW_API virtual bool IsArrayProperty() const { return false; }
+
+	// Pin type of the TArray element property, Invalid if the element type has no contiguous array storage
+	FLOW_API static EFlowPinType GetArrayElementPinType(const FProperty& ElementProperty);
 
 #if WITH_EDITOR
 	FLOW_API static FFlowPin CreateFlowPin(const FName& PinName, const TInstancedStruct<FFlowDataPinProperty>& DataPinProperty);
@@ -443,7 +449,152 @@ public:
 #endif
 
 	const FSoftClassPath& GetAsSoftClass() const { return Value; }
-	UClass* GetResolvedClass() const { return Value.ResolveClass(); }
+
+	// Cached until the path changes, the soft pointer resolves it again only after new objects have been loaded
+	FLOW_API UClass* GetResolvedClass() const;
+
+private:
+	mutable FSoftObjectPtr ResolvedValue;
+};
+
+// Base for wrapper structs of arrays that will generate and link to an array Data Pin with their same name
+// Values are stored contiguously, so consumers resolve them as views without copying (see FlowDataPin::TryResolveArray)
+USTRUCT(BlueprintType, DisplayName = "Base - Flow DataPin Array Property", meta = (Hidden))
+struct FFlowDataPinArrayProperty : public FFlowDataPinProperty
+{
+	GENERATED_BODY()
+
+	FLOW_API virtual bool IsArrayProperty() const override { return true; }
+
+	// View of the values, points to this struct's storage
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const { return FFlowDataPinArrayView(EFlowDataPinResolveResult::FailedUnimplemented); }
+};
+
+// Wrapper struct for a TArray<int64> that will generate and link to an array Data Pin with its same name
+USTRUCT(BlueprintType, DisplayName = "Int64 Array - Output Flow Data Pin Property", meta = (FlowPinType = "Int"))
+struct FFlowDataPinOutputProperty_IntArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<int64> Values;
+
+public:
+
+	FFlowDataPinOutputProperty_IntArray() { }
+	FFlowDataPinOutputProperty_IntArray(const TArray<int64>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::Int; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<int64>(Values)); }
+};
+
+// Wrapper struct for a TArray<double> that will generate and link to an array Data Pin with its same name
+USTRUCT(BlueprintType, DisplayName = "Double (float64) Array - Output Flow Data Pin Property", meta = (FlowPinType = "Float"))
+struct FFlowDataPinOutputProperty_FloatArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<double> Values;
+
+public:
+
+	FFlowDataPinOutputProperty_FloatArray() { }
+	FFlowDataPinOutputProperty_FloatArray(const TArray<double>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::Float; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<double>(Values)); }
+};
+
+// Wrapper struct for a TArray<FName> that will generate and link to an array Data Pin with its same name
+USTRUCT(BlueprintType, DisplayName = "Name Array - Output Flow Data Pin Property", meta = (FlowPinType = "Name"))
+struct FFlowDataPinOutputProperty_NameArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<FName> Values;
+
+public:
+
+	FFlowDataPinOutputProperty_NameArray() { }
+	FFlowDataPinOutputProperty_NameArray(const TArray<FName>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::Name; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<FName>(Values)); }
+};
+
+// Wrapper struct for a TArray<FVector> that will generate and link to an array Data Pin with its same name
+USTRUCT(BlueprintType, DisplayName = "Vector Array - Output Flow Data Pin Property", meta = (FlowPinType = "Vector"))
+struct FFlowDataPinOutputProperty_VectorArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<FVector> Values;
+
+public:
+
+	FFlowDataPinOutputProperty_VectorArray() { }
+	FFlowDataPinOutputProperty_VectorArray(const TArray<FVector>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::Vector; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<FVector>(Values)); }
+};
+
+// Wrapper struct for a TArray<FGameplayTag> that will generate and link to an array Data Pin with its same name
+// Unlike FGameplayTagContainer, it keeps the order and duplicates of the tags
+USTRUCT(BlueprintType, DisplayName = "GameplayTag Array - Output Flow Data Pin Property", meta = (FlowPinType = "GameplayTag"))
+struct FFlowDataPinOutputProperty_GameplayTagArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<FGameplayTag> Values;
+
+public:
+
+	FFlowDataPinOutputProperty_GameplayTagArray() { }
+	FFlowDataPinOutputProperty_GameplayTagArray(const TArray<FGameplayTag>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::GameplayTag; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<FGameplayTag>(Values)); }
+};
+
+// Wrapper struct for a TArray of UObjects that will generate and link to an array Data Pin with its same name
+// Only hard references are stored, so the view doesn't resolve anything
+USTRUCT(BlueprintType, DisplayName = "Object Array - Output Flow DataPin Property", meta = (FlowPinType = "Object"))
+struct FFlowDataPinOutputProperty_ObjectArray : public FFlowDataPinArrayProperty
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DataPins)
+	TArray<TObjectPtr<UObject>> Values;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = DataPins, meta = (AllowAbstract))
+	TObjectPtr<UClass> ClassFilter = UObject::StaticClass();
+#endif // WITH_EDITORONLY_DATA
+
+public:
+
+	FFlowDataPinOutputProperty_ObjectArray() { }
+	FFlowDataPinOutputProperty_ObjectArray(const TArray<TObjectPtr<UObject>>& InValues) : Values(InValues) { }
+
+	FLOW_API virtual EFlowPinType GetFlowPinType() const override { return EFlowPinType::Object; }
+	FLOW_API virtual FFlowDataPinArrayView GetArrayView() const override { return FFlowDataPinArrayView(TConstArrayView<TObjectPtr<UObject>>(Values)); }
 };
 
 // Wrapper for FFlowDataPinProperty that is used for flow nodes that add 
@@ -666,3 +817,68 @@ struct FFlowDataPinInputProperty_Class : public FFlowDataPinOutputProperty_Class
 	FLOW_API virtual bool IsInputProperty() const override { return true; }
 };
 
+USTRUCT(BlueprintType, DisplayName = "Int64 Array - Input Flow Data Pin Property", meta = (DefaultForInputFlowPin, FlowPinType = "Int"))
+struct FFlowDataPinInputProperty_IntArray : public FFlowDataPinOutputProperty_IntArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_IntArray() : Super() { }
+	FFlowDataPinInputProperty_IntArray(const TArray<int64>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
+
+USTRUCT(BlueprintType, DisplayName = "Double (float64) Array - Input Flow Data Pin Property", meta = (DefaultForInputFlowPin, FlowPinType = "Float"))
+struct FFlowDataPinInputProperty_FloatArray : public FFlowDataPinOutputProperty_FloatArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_FloatArray() : Super() { }
+	FFlowDataPinInputProperty_FloatArray(const TArray<double>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
+
+USTRUCT(BlueprintType, DisplayName = "Name Array - Input Flow Data Pin Property", meta = (DefaultForInputFlowPin, FlowPinType = "Name"))
+struct FFlowDataPinInputProperty_NameArray : public FFlowDataPinOutputProperty_NameArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_NameArray() : Super() { }
+	FFlowDataPinInputProperty_NameArray(const TArray<FName>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
+
+USTRUCT(BlueprintType, DisplayName = "Vector Array - Input Flow Data Pin Property", meta = (DefaultForInputFlowPin, FlowPinType = "Vector"))
+struct FFlowDataPinInputProperty_VectorArray : public FFlowDataPinOutputProperty_VectorArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_VectorArray() : Super() { }
+	FFlowDataPinInputProperty_VectorArray(const TArray<FVector>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
+
+USTRUCT(BlueprintType, DisplayName = "GameplayTag Array - Input Flow Data Pin Property", meta = (DefaultForInputFlowPin, FlowPinType = "GameplayTag"))
+struct FFlowDataPinInputProperty_GameplayTagArray : public FFlowDataPinOutputProperty_GameplayTagArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_GameplayTagArray() : Super() { }
+	FFlowDataPinInputProperty_GameplayTagArray(const TArray<FGameplayTag>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
+
+USTRUCT(BlueprintType, DisplayName = "Object Array - Input Flow DataPin Property", meta = (DefaultForInputFlowPin, FlowPinType = "Object"))
+struct FFlowDataPinInputProperty_ObjectArray : public FFlowDataPinOutputProperty_ObjectArray
+{
+	GENERATED_BODY()
+
+	FFlowDataPinInputProperty_ObjectArray() : Super() { }
+	FFlowDataPinInputProperty_ObjectArray(const TArray<TObjectPtr<UObject>>& InValues) : Super(InValues) { }
+
+	FLOW_API virtual bool IsInputProperty() const override { return true; }
+};
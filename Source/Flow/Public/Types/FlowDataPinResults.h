@@ -4,6 +4,7 @@
 
 #include "GameplayTagContainer.h"
 #include "StructUtils/InstancedStruct.h"
+#include "UObject/SoftObjectPtr.h"
 
 #include "Types/FlowPinEnums.h"
 #include "FlowDataPinResults.generated.h"
@@ -368,6 +369,10 @@ public:
 	UPROPERTY(Transient, BlueprintReadWrite, Category = DataPins)
 	TObjectPtr<UObject> Value;
 
+	// Set if the value has been supplied by a soft reference, so the object can be loaded if it isn't resident
+	UPROPERTY(Transient, BlueprintReadWrite, Category = DataPins)
+	FSoftObjectPath ValuePath;
+
 public:
 
 	FLOW_API FFlowDataPinResult_Object() { }
@@ -375,8 +380,13 @@ public:
 	FLOW_API FFlowDataPinResult_Object(UObject* InValue);
 
 	FLOW_API void SetValueFromPropertyWrapper(const FFlowDataPinOutputProperty_Object& InPropertyWrapper);
-	FLOW_API FORCEINLINE void SetValueFromSoftPath(const FSoftObjectPath& SoftPath) { Value = SoftPath.ResolveObject(); }
-	FLOW_API FORCEINLINE void SetValueFromObjectPtr(UObject* ObjectPtr) { Value = ObjectPtr; }
+	FLOW_API FORCEINLINE void SetValueFromSoftPath(const FSoftObjectPath& SoftPath) { ValuePath = SoftPath; Value = SoftPath.ResolveObject(); }
+	FLOW_API FORCEINLINE void SetValueFromObjectPtr(UObject* ObjectPtr) { ValuePath.Reset(); Value = ObjectPtr; }
+
+	// Soft pointer resolves the path again only after new objects have been loaded
+	FLOW_API FORCEINLINE void SetValueFromSoftObjectPtr(const FSoftObjectPtr& SoftObjectPtr) { ValuePath = SoftObjectPtr.GetUniqueID(); Value = SoftObjectPtr.Get(); }
+
+	FLOW_API FSoftObjectPath GetAsSoftObject() const { return ValuePath.IsValid() ? ValuePath : FSoftObjectPath(Value); }
 };
 
 USTRUCT(BlueprintType, DisplayName = "Flow DataPin Result (Class)")
@@ -406,8 +416,104 @@ public:
 	FLOW_API void SetValueFromPropertyWrapper(const FFlowDataPinOutputProperty_Class& PropertyWrapper);
 	FLOW_API void SetValueSoftClassAndClassPtr(const FSoftClassPath& SoftPath, UClass* ObjectPtr);
 	FLOW_API void SetValueFromSoftPath(const FSoftObjectPath& SoftObjectPath);
-	FLOW_API FORCEINLINE void SetValueFromObjectPtr(UClass* ClassPtr) { SetValueSoftClassAndClassPtr(FSoftClassPath(ClassPtr), ClassPtr); }
+	FLOW_API void SetValueFromSoftObjectPtr(const FSoftObjectPtr& SoftObjectPtr);
+
+	// The path is built only if requested by GetAsSoftClass
+	FLOW_API FORCEINLINE void SetValueFromObjectPtr(UClass* ClassPtr) { SetValueSoftClassAndClassPtr(FSoftClassPath(), ClassPtr); }
 
 	FLOW_API UClass* GetOrResolveClass() const { return IsValid(ValueClass) ? ValueClass.Get() : ValuePath.ResolveClass(); }
 	FLOW_API FSoftClassPath GetAsSoftClass() const;
 };
+
+// Maps the element type of an array data pin to its pin type, arrays are stored as TArray of these types
+template <typename TElementType>
+struct TFlowDataPinArrayElementTraits
+{
+	static_assert(sizeof(TElementType) == 0, "Unsupported array data pin element type, see FFlowPin::IsArraySupportedPinType");
+};
+
+#define FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(ElementType, PinTypeName) \
+	template <> \
+	struct TFlowDataPinArrayElementTraits<ElementType> \
+	{ \
+		static constexpr EFlowPinType PinType = EFlowPinType::PinTypeName; \
+	};
+
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(int64, Int)
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(double, Float)
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(FName, Name)
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(FVector, Vector)
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(FGameplayTag, GameplayTag)
+FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS(TObjectPtr<UObject>, Object)
+
+#undef FLOW_DATA_PIN_ARRAY_ELEMENT_TRAITS
+
+// Result of resolving an array data pin, see FlowDataPin::TryResolveArray
+// Values point to the supplier's storage, so they're valid for the duration of the calling function only
+template <typename TElementType>
+struct TFlowDataPinArrayResult
+{
+	EFlowDataPinResolveResult Result = EFlowDataPinResolveResult::FailedUnimplemented;
+	TConstArrayView<TElementType> Values;
+
+	// Set if the supplier built the values during the resolve, keeps them alive together with the result
+	TSharedPtr<const void> OwnedStorage;
+
+	TFlowDataPinArrayResult() { }
+	explicit TFlowDataPinArrayResult(EFlowDataPinResolveResult InResult) : Result(InResult) { }
+	explicit TFlowDataPinArrayResult(TConstArrayView<TElementType> InValues, const TSharedPtr<const void>& InOwnedStorage = nullptr)
+		: Result(EFlowDataPinResolveResult::Success)
+		, Values(InValues)
+		, OwnedStorage(InOwnedStorage)
+		{ }
+};
+
+// Type-erased view supplied by UFlowNode::TrySupplyDataPinAsArray, the element type is identified by its pin type
+struct FFlowDataPinArrayView
+{
+	EFlowDataPinResolveResult Result = EFlowDataPinResolveResult::FailedUnimplemented;
+	EFlowPinType ElementPinType = EFlowPinType::Invalid;
+	const void* Data = nullptr;
+	int32 Num = 0;
+
+	// See TFlowDataPinArrayResult::OwnedStorage
+	TSharedPtr<const void> OwnedStorage;
+
+	FFlowDataPinArrayView() { }
+	explicit FFlowDataPinArrayView(EFlowDataPinResolveResult InResult) : Result(InResult) { }
+	FFlowDataPinArrayView(const EFlowPinType InElementPinType, const void* InData, const int32 InNum)
+		: Result(EFlowDataPinResolveResult::Success)
+		, ElementPinType(InElementPinType)
+		, Data(InData)
+		, Num(InNum)
+		{ }
+
+	template <typename TElementType>
+	explicit FFlowDataPinArrayView(TConstArrayView<TElementType> InValues)
+		: FFlowDataPinArrayView(TFlowDataPinArrayElementTraits<TElementType>::PinType, InValues.GetData(), InValues.Num())
+		{ }
+
+	// Values built by the supplier during the resolve, owned by the view and the result resolved from it
+	template <typename TElementType>
+	explicit FFlowDataPinArrayView(const TSharedRef<const TArray<TElementType>>& InValues)
+		: FFlowDataPinArrayView(TFlowDataPinArrayElementTraits<TElementType>::PinType, InValues->GetData(), InValues->Num())
+	{
+		OwnedStorage = InValues;
+	}
+
+	template <typename TElementType>
+	TFlowDataPinArrayResult<TElementType> Get() const
+	{
+		if (Result != EFlowDataPinResolveResult::Success)
+		{
+			return TFlowDataPinArrayResult<TElementType>(Result);
+		}
+
+		if (ElementPinType != TFlowDataPinArrayElementTraits<TElementType>::PinType)
+		{
+			return TFlowDataPinArrayResult<TElementType>(EFlowDataPinResolveResult::FailedMismatchedType);
+		}
+
+		return TFlowDataPinArrayResult<TElementType>(MakeArrayView(static_cast<const TElementType*>(Data), Num), OwnedStorage);
+	}
+};
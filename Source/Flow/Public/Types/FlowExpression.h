@@ -0,0 +1,108 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Templates/Function.h"
+
+#include "FlowExpression.generated.h"
+
+UENUM()
+enum class EFlowExpressionOp : uint8
+{
+	// Pushes Constants[Operand]
+	Constant,
+
+	// Pushes the value of InputNames[Operand]
+	Input,
+
+	// Unary
+	Negate,
+	Not,
+	Abs,
+	Floor,
+	Ceil,
+	Round,
+	Sqrt,
+	Sign,
+
+	// Binary
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	Modulo,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual,
+	Equal,
+	NotEqual,
+	Min,
+	Max,
+	Pow,
+
+	// Ternary
+	Clamp,
+	Lerp,
+
+	// Converts any non-zero value to 1
+	Bool,
+
+	// Pops the condition and skips Operand instructions if it's zero, so ?: && || evaluate only the taken branch
+	JumpIfFalse,
+
+	// Skips Operand instructions
+	Jump
+};
+
+USTRUCT()
+struct FFlowExpressionInstruction
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EFlowExpressionOp Op = EFlowExpressionOp::Constant;
+
+	// Index to Constants or InputNames, the number of instructions to skip by jumps, unused by operators
+	UPROPERTY()
+	int32 Operand = INDEX_NONE;
+};
+
+/**
+ * Arithmetic expression compiled into the postfix program with jumps, evaluated on the stack of doubles
+ *  - operators: + - * / % < <= > >= == != && || ! and the ternary ?:
+ *  - functions: min, max, clamp, lerp, abs, floor, ceil, round, sqrt, pow, sign
+ *  - literals: numbers, true, false
+ *  - inputs: identifiers, or names in braces for names with spaces, i.e. {Max Health}
+ * Booleans are 0 and 1, any non-zero value counts as true. Sub-expressions over literals only are folded while compiling.
+ * ?: && || short-circuit like in C++, so inputs of the branch not taken aren't resolved, and it can't divide by zero, i.e. x != 0 ? 10 / x : 0
+ */
+USTRUCT()
+struct FLOW_API FFlowExpressionProgram
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlowExpressionInstruction> Instructions;
+
+	UPROPERTY()
+	TArray<double> Constants;
+
+	// Unique input names, in order of the first reference
+	UPROPERTY()
+	TArray<FName> InputNames;
+
+	UPROPERTY()
+	int32 MaxStackDepth = 0;
+
+	// Returns false and the error with the character position, if the expression can't be parsed
+	static bool Compile(const FString& Expression, FFlowExpressionProgram& OutProgram, FString& OutError);
+
+	bool IsCompiled() const { return !Instructions.IsEmpty(); }
+
+	// ResolveInput receives the index to InputNames, evaluation stops if it returns false
+	// Returns false and the error if any input of the taken branches can't be resolved or the expression divides by zero
+	bool Evaluate(TFunctionRef<bool(int32 InputIndex, double& OutValue)> ResolveInput, double& OutValue, FString& OutError) const;
+
+	SIZE_T GetAllocatedSize() const;
+};
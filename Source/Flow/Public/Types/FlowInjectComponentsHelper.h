@@ -17,11 +17,17 @@ public:
 
 	FLOW_API TArray<UActorComponent*> CreateComponentInstancesForActor(AActor& Actor);
 
+	// Soft classes to inject and the assets soft-referenced by the components, preloading them makes the injection a spawn from memory
+	FLOW_API void GatherPreloadPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	// Soft references held by the object properties and its default subobjects
+	static FLOW_API void GatherSoftReferences(const UObject& Object, TArray<FSoftObjectPath>& OutPaths);
+
 	// Static functions to create a component for injection:
 	static FLOW_API UActorComponent* TryCreateComponentInstanceForActorFromTemplate(AActor& Actor, UActorComponent& ComponentTemplate);
 	static FLOW_API UActorComponent* TryCreateComponentInstanceForActorFromClass(AActor& Actor, TSubclassOf<UActorComponent> ComponentClass, const FName& InstanceBaseName);
 
-	// After creating using one of the above two functions, inject into the actor:
+	// After creating using one of the above two functions, inject into the actor (or reactivate the pooled component):
 	static FLOW_API void InjectCreatedComponent(AActor& Actor, UActorComponent& ComponentInstance);
 
 	// Remove & Destroy the injected component:
@@ -36,4 +42,8 @@ public:
 	// Component (template) to inject on the spawned actor
 	UPROPERTY(EditAnywhere, Category = Configuration)
 	TArray<TSubclassOf<UActorComponent>> ComponentClasses;
+
+	// Component (class) to inject on the spawned actor, loaded on demand unless preloaded
+	UPROPERTY(EditAnywhere, Category = Configuration)
+	TArray<TSoftClassPtr<UActorComponent>> SoftComponentClasses;
 };
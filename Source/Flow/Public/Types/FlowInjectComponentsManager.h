@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "UObject/Object.h"
 
 #include "FlowInjectComponentsManager.generated.h"
@@ -21,6 +22,24 @@ public:
 	TArray<TWeakObjectPtr<UActorComponent>> Components;
 };
 
+// Component waiting for the deferred injection, see UFlowInjectComponentsManager::InjectComponentsDeferred
+USTRUCT()
+struct FLOW_API FFlowPendingComponentInjection
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> Actor = nullptr;
+
+	// Strong reference, as nothing else keeps the component alive until it's registered
+	UPROPERTY(Transient)
+	TObjectPtr<UActorComponent> Component = nullptr;
+};
+
+DECLARE_DELEGATE(FFlowComponentInjectionComplete);
+
 // Inject components onto actors and will remove them when they are destroyed (or this is shutdown)
 UCLASS(MinimalAPI)
 class UFlowInjectComponentsManager : public UObject
@@ -37,6 +56,20 @@ public:
 
 	FLOW_API void RemoveAllInjectedComponentsAndStopMonitoringActor(AActor& Actor);
 
+	// Injects components over several frames, so injecting onto a large group of actors doesn't register all of them in a single frame
+	//  - at least one component is injected per frame, then injection stops after MaxInjectionsPerFrame components or FrameBudget microseconds (0 means no limit)
+	//  - components are injected in the given order, OnComplete is called after injecting the last one
+	//  - registration stays on the game thread, as the engine creates render and physics state of registered components there
+	FLOW_API void InjectComponentsDeferred(const TArray<FFlowPendingComponentInjection>& Injections, const int32 MaxInjectionsPerFrame, const float FrameBudget, FFlowComponentInjectionComplete&& OnComplete);
+
+	FLOW_API bool HasPendingInjections() const { return PendingInjectionsHead < PendingInjections.Num(); }
+
+	// Drops pending injections without calling their OnComplete, components created for them are left to the garbage collector
+	FLOW_API void CancelPendingInjections();
+
+	// Removed components are returned to the Flow Subsystem pool instead of being destroyed, see UFlowSubsystem::AcquirePooledComponent
+	FLOW_API void SetComponentPooling(const UActorComponent& Archetype, const int32 InMaxPooledComponents);
+
 protected:
 
 	FLOW_API void AddAndRegisterComponent(AActor& Actor, UActorComponent& ComponentInstance);
@@ -47,6 +80,9 @@ protected:
 
 	FLOW_API void RemoveInjectedComponents();
 
+	bool TickPendingInjections(float DeltaTime);
+	void ExecuteCompletedInjectionCallbacks();
+
 	UFUNCTION()
 	FLOW_API void OnActorDestroyed(AActor* DestroyedActor);
 
@@ -64,4 +100,25 @@ public:
 	// Map of spawned components (if we are cleaning up)
 	UPROPERTY(Transient)
 	TMap<TObjectPtr<AActor>, FFlowComponentInstances> ActorToComponentsMap;
+
+protected:
+
+	// Deferred injections in FIFO order, see InjectComponentsDeferred
+	UPROPERTY(Transient)
+	TArray<FFlowPendingComponentInjection> PendingInjections;
+	int32 PendingInjectionsHead = 0;
+
+	// Budget of the most recent InjectComponentsDeferred call, applies to all pending injections
+	int32 MaxInjectionsPerFrame = 0;
+	float InjectionFrameBudget = 0.0f;
+
+	// Called once the injection reaches the given index of PendingInjections
+	TArray<TPair<int32, FFlowComponentInjectionComplete>> PendingInjectionCallbacks;
+
+	FTSTicker::FDelegateHandle PendingInjectionsHandle;
+	bool bIsInjectingPending = false;
+
+	// Template or class defaults of the injected components, if pooling
+	TWeakObjectPtr<const UActorComponent> PoolArchetype;
+	int32 MaxPooledComponents = 0;
 };
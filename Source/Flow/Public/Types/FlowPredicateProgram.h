@@ -0,0 +1,101 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// Forward Declarations
+class IFlowPredicateInterface;
+class UFlowComponent;
+class UFlowNode;
+class UFlowNodeAddOn;
+
+// Predicate AddOn tree flattened into a linear program, so evaluating it doesn't repeat interface checks and recursion
+//  - AND, OR and NOT AddOns become short-circuit jumps, other predicates are leaves
+//  - leaves of native classes call EvaluatePredicate_Implementation directly, Blueprint leaves go through the BlueprintNativeEvent
+//  - leaves opting in via GetPredicateCacheDependencies reuse their result until a declared dependency changes
+//  - compiled programs reference AddOn instances, so the program has to be compiled again after AddOns are re-created
+struct FLOW_API FFlowPredicateProgram
+{
+public:
+
+	// Compiles predicates with the semantics of UFlowNodeAddOn_PredicateAND::EvaluatePredicateAND(AddOns)
+	void Compile(const TArray<UFlowNodeAddOn*>& AddOns);
+	void Reset();
+
+	bool IsCompiled() const { return !Instructions.IsEmpty(); }
+
+	bool Evaluate() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	enum class EOp : uint8
+	{
+		// Result = Leaves[Operand]
+		Leaf,
+
+		// Result = true, used by composites without any predicate children
+		True,
+
+		// Result = !Result
+		Not,
+
+		// Continue at Operand, if Result is false or true respectively
+		JumpIfFalse,
+		JumpIfTrue
+	};
+
+	struct FInstruction
+	{
+		EOp Op;
+		int32 Operand;
+	};
+
+	struct FLeaf
+	{
+		const UFlowNodeAddOn* AddOn;
+
+		// Set if no Blueprint class in the hierarchy overrides EvaluatePredicate
+		const IFlowPredicateInterface* NativePredicate;
+
+		// Index to Caches, if the predicate opted in to caching
+		int32 CacheIndex;
+	};
+
+	struct FDataPinDependency
+	{
+		TWeakObjectPtr<const UFlowNode> SupplierFlowNode;
+		FName SupplierPinName;
+	};
+
+	struct FLeafCache
+	{
+		bool bOwnerIdentityTags = false;
+		TArray<FName> DataPinNames;
+
+		// Resolved on the first evaluation, as suppliers and the owner might not be initialized yet while compiling
+		bool bDependenciesResolved = false;
+		TWeakObjectPtr<const UFlowComponent> OwnerComponent;
+		TArray<FDataPinDependency, TInlineAllocator<2>> DataPinDependencies;
+
+		// Owner tags version first, if used, followed by versions of data pin suppliers
+		TArray<uint32, TInlineAllocator<4>> CachedVersions;
+		bool bCachedResult = false;
+		bool bHasCachedResult = false;
+	};
+
+	void CompilePredicate(const UFlowNodeAddOn* AddOn);
+	void CompileComposite(const TArray<UFlowNodeAddOn*>& AddOns, const EOp ShortCircuitOp);
+
+	bool EvaluateLeaf(const FLeaf& Leaf) const;
+	static bool EvaluatePredicate(const FLeaf& Leaf);
+	static void ResolveCacheDependencies(const FLeaf& Leaf, FLeafCache& Cache);
+
+	TArray<FInstruction> Instructions;
+	TArray<FLeaf> Leaves;
+
+	mutable TArray<FLeafCache> Caches;
+};
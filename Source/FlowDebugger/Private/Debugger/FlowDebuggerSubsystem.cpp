@@ -4,7 +4,10 @@
 #include "Debugger/FlowDebuggerSettings.h"
 
 #include "FlowAsset.h"
+#include "FlowLogChannels.h"
 #include "FlowSubsystem.h"
+#include "Nodes/FlowNode.h"
+#include "Types/FlowClassUtils.h"
 
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
@@ -12,6 +15,9 @@
 #include "Engine/GameInstance.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowDebuggerSubsystem)
 
@@ -24,35 +30,183 @@ UFlowDebuggerSubsystem::UFlowDebuggerSubsystem()
 bool UFlowDebuggerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	// Only create an instance if there is no override implementation defined elsewhere
-	TArray<UClass*> ChildClasses;
-	GetDerivedClasses(GetClass(), ChildClasses, false);
-	if (ChildClasses.Num() > 0)
+	return !FlowClassUtils::HasDerivedClasses(GetClass());
+}
+
+void UFlowDebuggerSubsystem::OnInstancedTemplateAdded(UFlowAsset* AssetTemplate)
+{
+	InstancedTemplates.AddUnique(AssetTemplate);
+	UpdatePinTriggeredHook(*AssetTemplate);
+}
+
+void UFlowDebuggerSubsystem::OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate)
+{
+	InstancedTemplates.Remove(AssetTemplate);
+	AssetTemplate->OnPinTriggered.Unbind();
+}
+
+void UFlowDebuggerSubsystem::OnPinTriggered(const UFlowNode& NodeInstance, const FName& PinName)
+{
+	const FGuid& NodeGuid = NodeInstance.GetGuid();
+
+	if (FFlowBreakpoint* PinBreakpoint = FindBreakpoint(NodeGuid, PinName))
+	{
+		if (EvaluateBreakpoint(*PinBreakpoint, NodeInstance, PinName))
+		{
+			MarkAsHit(NodeGuid, PinName);
+		}
+	}
+
+	// Node breakpoints waits on any pin triggered
+	if (FFlowBreakpoint* NodeBreakpoint = FindBreakpoint(NodeGuid))
+	{
+		if (EvaluateBreakpoint(*NodeBreakpoint, NodeInstance, PinName))
+		{
+			MarkAsHit(NodeGuid);
+		}
+	}
+}
+
+bool UFlowDebuggerSubsystem::EvaluateBreakpoint(FFlowBreakpoint& Breakpoint, const UFlowNode& NodeInstance, const FName& PinName) const
+{
+	if (!Breakpoint.IsEnabled())
 	{
 		return false;
 	}
 
+	Breakpoint.HitCount++;
+
+	const FFlowBreakpointCondition& Condition = Breakpoint.Condition;
+	if (!Condition.IsConditional())
+	{
+		return true;
+	}
+
+	bool bPassed = Breakpoint.HitCount >= Condition.HitCountThreshold;
+
+	if (Condition.TriggersPerSecondThreshold > 0)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime - Breakpoint.RateWindowStart > 1.0)
+		{
+			Breakpoint.RateWindowStart = CurrentTime;
+			Breakpoint.RateWindowHits = 0;
+		}
+
+		Breakpoint.RateWindowHits++;
+		bPassed &= Breakpoint.RateWindowHits > Condition.TriggersPerSecondThreshold;
+	}
+
+	// resolving the data pin might be costly, do it only if everything else passed
+	bPassed = bPassed && EvaluateDataPinCondition(Condition, NodeInstance);
+	if (!bPassed)
+	{
+		return false;
+	}
+
+	if (Condition.Action == EFlowBreakpointAction::Log)
+	{
+		const FString NodePath = FString::Printf(TEXT("%s.%s"), *NodeInstance.GetPathName(), *PinName.ToString());
+		UE_LOG(LogFlow, Warning, TEXT("Flow breakpoint hit %d times: %s"), Breakpoint.HitCount, *NodePath);
+		TRACE_BOOKMARK(TEXT("Flow breakpoint %s"), *NodePath);
+
+		// restart the rate window, so a runaway loop logs once per second instead of every trigger
+		Breakpoint.RateWindowStart = FPlatformTime::Seconds();
+		Breakpoint.RateWindowHits = 0;
+		return false;
+	}
+
 	return true;
 }
 
-void UFlowDebuggerSubsystem::OnInstancedTemplateAdded(UFlowAsset* AssetTemplate)
+bool UFlowDebuggerSubsystem::EvaluateDataPinCondition(const FFlowBreakpointCondition& Condition, const UFlowNode& NodeInstance)
 {
-	AssetTemplate->OnPinTriggered.BindUObject(this, &ThisClass::OnPinTriggered);
+	if (Condition.DataPinName.IsNone())
+	{
+		return true;
+	}
+
+	TArray<TInstancedStruct<FFlowDataPinResult>> Results;
+	NodeInstance.TryResolveDataPins({Condition.DataPinName}, Results);
+	if (!Results.IsValidIndex(0) || Results[0].Get().Result != EFlowDataPinResolveResult::Success)
+	{
+		return false;
+	}
+
+	// every result type holds the resolved data in the Value or Values property
+	const UScriptStruct* ResultStruct = Results[0].GetScriptStruct();
+	const FProperty* ValueProperty = ResultStruct->FindPropertyByName(TEXT("Value"));
+	if (ValueProperty == nullptr)
+	{
+		ValueProperty = ResultStruct->FindPropertyByName(TEXT("Values"));
+	}
+	if (ValueProperty == nullptr)
+	{
+		return false;
+	}
+
+	FString ValueText;
+	ValueProperty->ExportTextItem_InContainer(ValueText, Results[0].GetMemory(), nullptr, nullptr, PPF_None);
+	return ValueText.Equals(Condition.DataPinValue, ESearchCase::IgnoreCase);
 }
 
-void UFlowDebuggerSubsystem::OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate) const
+bool UFlowDebuggerSubsystem::HasEnabledBreakpoints(const UFlowAsset& AssetTemplate) const
 {
-	AssetTemplate->OnPinTriggered.Unbind();
+	const UFlowDebuggerSettings* Settings = GetDefault<UFlowDebuggerSettings>();
+	const TMap<FGuid, UFlowNode*>& Nodes = AssetTemplate.GetNodes();
+
+	for (const TPair<FGuid, FNodeBreakpoint>& NodeBreakpoint : Settings->NodeBreakpoints)
+	{
+		if (!Nodes.Contains(NodeBreakpoint.Key))
+		{
+			continue;
+		}
+
+		if (NodeBreakpoint.Value.Breakpoint.IsActive() && NodeBreakpoint.Value.Breakpoint.IsEnabled())
+		{
+			return true;
+		}
+
+		for (const TPair<FName, FFlowBreakpoint>& PinBreakpoint : NodeBreakpoint.Value.PinBreakpoints)
+		{
+			if (PinBreakpoint.Value.IsEnabled())
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
 }
 
-void UFlowDebuggerSubsystem::OnPinTriggered(const FGuid& NodeGuid, const FName& PinName)
+void UFlowDebuggerSubsystem::UpdatePinTriggeredHook(UFlowAsset& AssetTemplate)
 {
-	if (FindBreakpoint(NodeGuid, PinName))
+	if (HasEnabledBreakpoints(AssetTemplate))
+	{
+		if (!AssetTemplate.OnPinTriggered.IsBound())
+		{
+			AssetTemplate.OnPinTriggered.BindUObject(this, &ThisClass::OnPinTriggered);
+		}
+	}
+	else
 	{
-		MarkAsHit(NodeGuid, PinName);
+		AssetTemplate.OnPinTriggered.Unbind();
 	}
+}
 
-	// Node breakpoints waits on any pin triggered
-	MarkAsHit(NodeGuid);
+void UFlowDebuggerSubsystem::UpdatePinTriggeredHooks()
+{
+	for (int32 Index = InstancedTemplates.Num() - 1; Index >= 0; Index--)
+	{
+		if (UFlowAsset* AssetTemplate = InstancedTemplates[Index].Get())
+		{
+			UpdatePinTriggeredHook(*AssetTemplate);
+		}
+		else
+		{
+			InstancedTemplates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
 }
 
 void UFlowDebuggerSubsystem::AddBreakpoint(const FGuid& NodeGuid)
@@ -61,7 +215,7 @@ void UFlowDebuggerSubsystem::AddBreakpoint(const FGuid& NodeGuid)
 	FNodeBreakpoint& NodeBreakpoint = Settings->NodeBreakpoints.FindOrAdd(NodeGuid);
 
 	NodeBreakpoint.Breakpoint.SetActive(true);
-	SaveSettings();
+	OnBreakpointsModified();
 }
 
 void UFlowDebuggerSubsystem::AddBreakpoint(const FGuid& NodeGuid, const FName& PinName)
@@ -71,7 +225,7 @@ void UFlowDebuggerSubsystem::AddBreakpoint(const FGuid& NodeGuid, const FName& P
 	FFlowBreakpoint& PinBreakpoint = NodeBreakpoint.PinBreakpoints.FindOrAdd(PinName);
 
 	PinBreakpoint.SetEnabled(true);
-	SaveSettings();
+	OnBreakpointsModified();
 }
 
 void UFlowDebuggerSubsystem::RemoveAllBreakpoints(const FGuid& NodeGuid)
@@ -81,7 +235,7 @@ void UFlowDebuggerSubsystem::RemoveAllBreakpoints(const FGuid& NodeGuid)
 	if (Settings->NodeBreakpoints.Contains(NodeGuid))
 	{
 		Settings->NodeBreakpoints.Remove(NodeGuid);
-		SaveSettings();
+		OnBreakpointsModified();
 	}
 }
 
@@ -101,7 +255,7 @@ void UFlowDebuggerSubsystem::RemoveNodeBreakpoint(const FGuid& NodeGuid)
 			NodeBreakpoint->Breakpoint.SetActive(false);
 		}
 
-		SaveSettings();
+		OnBreakpointsModified();
 	}
 }
 
@@ -121,7 +275,7 @@ void UFlowDebuggerSubsystem::RemovePinBreakpoint(const FGuid& NodeGuid, const FN
 			Settings->NodeBreakpoints.Remove(NodeGuid);
 		}
 
-		SaveSettings();
+		OnBreakpointsModified();
 	}
 }
 
@@ -157,7 +311,7 @@ void UFlowDebuggerSubsystem::RemoveObsoletePinBreakpoints(const UEdGraphNode* No
 
 		if (bAnythingRemoved)
 		{
-			SaveSettings();
+			OnBreakpointsModified();
 		}
 	}
 }
@@ -211,7 +365,7 @@ void UFlowDebuggerSubsystem::SetBreakpointEnabled(const FGuid& NodeGuid, const b
 	if (FFlowBreakpoint* NodeBreakpoint = FindBreakpoint(NodeGuid))
 	{
 		NodeBreakpoint->SetEnabled(bEnabled);
-		SaveSettings();
+		OnBreakpointsModified();
 	}
 }
 
@@ -220,7 +374,61 @@ void UFlowDebuggerSubsystem::SetBreakpointEnabled(const FGuid& NodeGuid, const F
 	if (FFlowBreakpoint* PinBreakpoint = FindBreakpoint(NodeGuid, PinName))
 	{
 		PinBreakpoint->SetEnabled(bEnabled);
-		SaveSettings();
+		OnBreakpointsModified();
+	}
+}
+
+void UFlowDebuggerSubsystem::SetBreakpointCondition(const FGuid& NodeGuid, const FFlowBreakpointCondition& Condition)
+{
+	if (FFlowBreakpoint* NodeBreakpoint = FindBreakpoint(NodeGuid))
+	{
+		NodeBreakpoint->Condition = Condition;
+		NodeBreakpoint->ResetHitCount();
+		OnBreakpointsModified();
+	}
+}
+
+void UFlowDebuggerSubsystem::SetBreakpointCondition(const FGuid& NodeGuid, const FName& PinName, const FFlowBreakpointCondition& Condition)
+{
+	if (FFlowBreakpoint* PinBreakpoint = FindBreakpoint(NodeGuid, PinName))
+	{
+		PinBreakpoint->Condition = Condition;
+		PinBreakpoint->ResetHitCount();
+		OnBreakpointsModified();
+	}
+}
+
+void UFlowDebuggerSubsystem::ResetHitCounts()
+{
+	UFlowDebuggerSettings* Settings = GetMutableDefault<UFlowDebuggerSettings>();
+
+	for (TPair<FGuid, FNodeBreakpoint>& NodeBreakpoint : Settings->NodeBreakpoints)
+	{
+		NodeBreakpoint.Value.Breakpoint.ResetHitCount();
+
+		for (TPair<FName, FFlowBreakpoint>& PinBreakpoint : NodeBreakpoint.Value.PinBreakpoints)
+		{
+			PinBreakpoint.Value.ResetHitCount();
+		}
+	}
+}
+
+void UFlowDebuggerSubsystem::DumpHitCounts()
+{
+	const UFlowDebuggerSettings* Settings = GetDefault<UFlowDebuggerSettings>();
+
+	UE_LOG(LogFlow, Display, TEXT("Flow breakpoint hit counts:"));
+	for (const TPair<FGuid, FNodeBreakpoint>& NodeBreakpoint : Settings->NodeBreakpoints)
+	{
+		if (NodeBreakpoint.Value.Breakpoint.IsActive())
+		{
+			UE_LOG(LogFlow, Display, TEXT("  %8d  node %s"), NodeBreakpoint.Value.Breakpoint.GetHitCount(), *NodeBreakpoint.Key.ToString());
+		}
+
+		for (const TPair<FName, FFlowBreakpoint>& PinBreakpoint : NodeBreakpoint.Value.PinBreakpoints)
+		{
+			UE_LOG(LogFlow, Display, TEXT("  %8d  node %s, pin %s"), PinBreakpoint.Value.GetHitCount(), *NodeBreakpoint.Key.ToString(), *PinBreakpoint.Key.ToString());
+		}
 	}
 }
 
@@ -348,8 +556,36 @@ bool UFlowDebuggerSubsystem::IsBreakpointHit(const FGuid& NodeGuid, const FName&
 	return false;
 }
 
+void UFlowDebuggerSubsystem::OnBreakpointsModified()
+{
+	UpdatePinTriggeredHooks();
+	SaveSettings();
+}
+
 void UFlowDebuggerSubsystem::SaveSettings()
 {
 	UFlowDebuggerSettings* Settings = GetMutableDefault<UFlowDebuggerSettings>();
 	Settings->SaveConfig();
 }
+
+static FAutoConsoleCommand FlowDebuggerDumpHitCountsCommand(
+	TEXT("Flow.Debugger.DumpHitCounts"),
+	TEXT("Logs how many times every Flow breakpoint was triggered in this play session"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (UFlowDebuggerSubsystem* DebuggerSubsystem = GEngine ? GEngine->GetEngineSubsystem<UFlowDebuggerSubsystem>() : nullptr)
+		{
+			DebuggerSubsystem->DumpHitCounts();
+		}
+	}));
+
+static FAutoConsoleCommand FlowDebuggerResetHitCountsCommand(
+	TEXT("Flow.Debugger.ResetHitCounts"),
+	TEXT("Resets hit counters of all Flow breakpoints"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (UFlowDebuggerSubsystem* DebuggerSubsystem = GEngine ? GEngine->GetEngineSubsystem<UFlowDebuggerSubsystem>() : nullptr)
+		{
+			DebuggerSubsystem->ResetHitCounts();
+		}
+	}));
@@ -9,6 +9,7 @@
 
 class UEdGraphNode;
 class UFlowAsset;
+class UFlowNode;
 
 /**
  * Persistent subsystem supporting Flow Graph debugging.
@@ -26,9 +27,23 @@ public:
 
 protected:
 	virtual void OnInstancedTemplateAdded(UFlowAsset* AssetTemplate);
-	virtual void OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate) const;
+	virtual void OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate);
 
-	virtual void OnPinTriggered(const FGuid& NodeGuid, const FName& PinName);
+	virtual void OnPinTriggered(const UFlowNode& NodeInstance, const FName& PinName);
+
+	/** Counts the hit and checks breakpoint conditions, returns true if the session should pause. */
+	virtual bool EvaluateBreakpoint(FFlowBreakpoint& Breakpoint, const UFlowNode& NodeInstance, const FName& PinName) const;
+	static bool EvaluateDataPinCondition(const FFlowBreakpointCondition& Condition, const UFlowNode& NodeInstance);
+
+	/** True if any enabled breakpoint is placed on the node of this template. */
+	virtual bool HasEnabledBreakpoints(const UFlowAsset& AssetTemplate) const;
+
+	/** Binds OnPinTriggered only to templates with enabled breakpoints, so other templates don't pay for debugging. */
+	void UpdatePinTriggeredHook(UFlowAsset& AssetTemplate);
+	void UpdatePinTriggeredHooks();
+
+	/** Templates instanced in any world, the hook is updated on them after every breakpoint modification. */
+	TArray<TWeakObjectPtr<UFlowAsset>> InstancedTemplates;
 
 public:
 	virtual void AddBreakpoint(const FGuid& NodeGuid);
@@ -55,6 +70,15 @@ public:
 	virtual bool IsBreakpointEnabled(const FGuid& NodeGuid);
 	virtual bool IsBreakpointEnabled(const FGuid& NodeGuid, const FName& PinName);
 
+	virtual void SetBreakpointCondition(const FGuid& NodeGuid, const FFlowBreakpointCondition& Condition);
+	virtual void SetBreakpointCondition(const FGuid& NodeGuid, const FName& PinName, const FFlowBreakpointCondition& Condition);
+
+	/** Resets hit counters of all breakpoints, done automatically when a new play session starts. */
+	virtual void ResetHitCounts();
+
+	/** Logs hit counters of all breakpoints. */
+	virtual void DumpHitCounts();
+
 protected:
 	virtual void MarkAsHit(const FGuid& NodeGuid);
 	virtual void MarkAsHit(const FGuid& NodeGuid, const FName& PinName);
@@ -70,6 +94,9 @@ public:
 	virtual bool IsBreakpointHit(const FGuid& NodeGuid, const FName& PinName);
 
 private:
+	/** Updates pin hooks and saves any modifications made to breakpoints */
+	void OnBreakpointsModified();
+
 	/** Saves any modifications made to breakpoints */
 	virtual void SaveSettings();
 };
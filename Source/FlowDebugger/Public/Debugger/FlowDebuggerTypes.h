@@ -4,6 +4,48 @@
 
 #include "FlowDebuggerTypes.generated.h"
 
+UENUM()
+enum class EFlowBreakpointAction : uint8
+{
+	// Pauses the game session
+	Pause,
+
+	// Logs the hit and adds a trace bookmark, session keeps running
+	Log
+};
+
+// Conditions evaluated before the breakpoint is hit, all of the set conditions have to pass
+USTRUCT()
+struct FLOWDEBUGGER_API FFlowBreakpointCondition
+{
+	GENERATED_BODY()
+
+	// Breaks only once the breakpoint was triggered this many times, 0 breaks on the first trigger
+	UPROPERTY(EditAnywhere, Category = "Breakpoint", meta = (ClampMin = 0))
+	int32 HitCountThreshold = 0;
+
+	// Breaks only if the breakpoint is triggered more than this many times within a second, 0 ignores the rate
+	// Catching runaway loops doesn't require stopping on every trigger
+	UPROPERTY(EditAnywhere, Category = "Breakpoint", meta = (ClampMin = 0))
+	int32 TriggersPerSecondThreshold = 0;
+
+	// Breaks only if this data pin of the node resolves to ConditionValue, none ignores the data pin
+	UPROPERTY(EditAnywhere, Category = "Breakpoint")
+	FName DataPinName;
+
+	// Value compared against the resolved data pin value exported as text, case insensitive
+	UPROPERTY(EditAnywhere, Category = "Breakpoint")
+	FString DataPinValue;
+
+	UPROPERTY(EditAnywhere, Category = "Breakpoint")
+	EFlowBreakpointAction Action = EFlowBreakpointAction::Pause;
+
+	bool IsConditional() const
+	{
+		return HitCountThreshold > 0 || TriggersPerSecondThreshold > 0 || !DataPinName.IsNone() || Action != EFlowBreakpointAction::Pause;
+	}
+};
+
 USTRUCT()
 struct FLOWDEBUGGER_API FFlowBreakpoint
 {
@@ -21,6 +63,15 @@ protected:
 	UPROPERTY(Transient)
 	uint8 bHit : 1;
 
+public:
+	UPROPERTY()
+	FFlowBreakpointCondition Condition;
+
+	// Runtime counters, reset with every play session
+	int32 HitCount = 0;
+	double RateWindowStart = 0.0;
+	int32 RateWindowHits = 0;
+
 public:
 	FFlowBreakpoint()
 		: bActive(false)
@@ -45,9 +96,17 @@ public:
 		bHit = bNowHit;
 	}
 
+	void ResetHitCount()
+	{
+		HitCount = 0;
+		RateWindowStart = 0.0;
+		RateWindowHits = 0;
+	}
+
 	bool IsActive() const { return bActive; }
 	bool IsEnabled() const { return bEnabled; }
 	bool IsHit() const { return bHit; }
+	int32 GetHitCount() const { return HitCount; }
 };
 
 USTRUCT()
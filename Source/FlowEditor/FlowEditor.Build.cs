@@ -33,6 +33,8 @@ public class FlowEditor : ModuleRules
 			"ContentBrowser",
 			"Core",
 			"CoreUObject",
+			"DerivedDataCache",
+			"DesktopPlatform",
 			"DetailCustomizations",
 			"DeveloperSettings",
 			"EditorFramework",
@@ -40,6 +42,7 @@ public class FlowEditor : ModuleRules
 			"EditorStyle",
 			"Engine",
 			"EngineAssetDefinitions",
+			"FlowLevelSequence",
 			"GraphEditor",
 			"GameplayTags",
 			"InputCore",
@@ -62,6 +65,7 @@ public class FlowEditor : ModuleRules
 			"SlateCore",
 			"SourceControl",
 			"ToolMenus",
+			"TraceAnalysis",
 			"UnrealEd"
 		});
 	}
@@ -0,0 +1,121 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowAssetDependencies.h"
+#include "Asset/FlowAssetOptimizer.h"
+#include "FlowAsset.h"
+#include "FlowEditorLogChannels.h"
+#include "FlowSettings.h"
+#include "Nodes/FlowNode.h"
+#include "Nodes/Graph/FlowNode_SubGraph.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Cooker/CookDependency.h"
+#include "UObject/UObjectGlobals.h"
+
+FDelegateHandle FFlowAssetDependencies::PreSaveHandle;
+
+void FFlowAssetDependencies::Register()
+{
+	PreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddStatic(&FFlowAssetDependencies::OnObjectPreSave);
+}
+
+void FFlowAssetDependencies::Unregister()
+{
+	FCoreUObjectDelegates::OnObjectPreSave.Remove(PreSaveHandle);
+	PreSaveHandle.Reset();
+}
+
+void FFlowAssetDependencies::GatherContentDependencies(const UFlowAsset& FlowAsset, TArray<FSoftObjectPath>& OutPaths)
+{
+	TSet<const UFlowAsset*> VisitedAssets;
+	GatherContentDependencies(FlowAsset, OutPaths, VisitedAssets);
+}
+
+void FFlowAssetDependencies::GatherContentDependencies(const UFlowAsset& FlowAsset, TArray<FSoftObjectPath>& OutPaths, TSet<const UFlowAsset*>& VisitedAssets)
+{
+	bool bAlreadyVisited = false;
+	VisitedAssets.Add(&FlowAsset, &bAlreadyVisited);
+	if (bAlreadyVisited)
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> NodePaths;
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+	{
+		if (IsValid(Node.Value))
+		{
+			Node.Value->GatherContentDependencies(NodePaths);
+		}
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	for (const FSoftObjectPath& Path : NodePaths)
+	{
+		if (OutPaths.Contains(Path))
+		{
+			continue;
+		}
+		OutPaths.Add(Path);
+
+		// content of Sub Graphs is needed as soon as they start, so it's fetched in the same batch
+		const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(Path);
+		if (AssetData.IsValid() && AssetData.IsInstanceOf(UFlowAsset::StaticClass()))
+		{
+			if (const UFlowAsset* SubFlow = Cast<UFlowAsset>(Path.TryLoad()))
+			{
+				GatherContentDependencies(*SubFlow, OutPaths, VisitedAssets);
+			}
+		}
+	}
+}
+
+void FFlowAssetDependencies::OnObjectPreSave(UObject* Object, FObjectPreSaveContext SaveContext)
+{
+	UFlowAsset* FlowAsset = Cast<UFlowAsset>(Object);
+	if (FlowAsset == nullptr || FlowAsset->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	// list is derived from nodes, keeping it out of source assets avoids needless diffs
+	FlowAsset->ContentDependencies.Reset();
+
+	if (SaveContext.IsCooking())
+	{
+		FlowAsset->ApplyCookFixups();
+
+		// optimizing modifies the loaded asset, so it's left out of cooking from the running editor
+		// runs first, so content of stripped nodes isn't requested
+		if (UFlowSettings::Get()->bOptimizeGraphsOnCook && IsRunningCookCommandlet())
+		{
+			// before optimizing, as inlined Sub Graph nodes are removed
+			AddSubGraphCookDependencies(*FlowAsset, SaveContext);
+			FFlowAssetOptimizer::OptimizeForCook(*FlowAsset);
+		}
+
+		GatherContentDependencies(*FlowAsset, FlowAsset->ContentDependencies);
+		UE_LOG(LogFlowEditor, Verbose, TEXT("Cooked %d content dependencies of %s"), FlowAsset->ContentDependencies.Num(), *FlowAsset->GetName());
+	}
+}
+
+void FFlowAssetDependencies::AddSubGraphCookDependencies(const UFlowAsset& FlowAsset, FObjectPreSaveContext& SaveContext)
+{
+	TSet<FName> SubGraphPackages;
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+	{
+		const UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node.Value);
+		if (SubGraphNode == nullptr || SubGraphNode->Asset.IsNull())
+		{
+			continue;
+		}
+
+		const FName PackageName = SubGraphNode->Asset.ToSoftObjectPath().GetLongPackageFName();
+		bool bAlreadyAdded = false;
+		SubGraphPackages.Add(PackageName, &bAlreadyAdded);
+		if (!bAlreadyAdded)
+		{
+			SaveContext.AddCookBuildDependency(UE::Cook::FCookDependency::Package(PackageName));
+		}
+	}
+}
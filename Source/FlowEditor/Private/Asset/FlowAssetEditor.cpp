@@ -13,6 +13,11 @@
 #include "Graph/Widgets/SFlowPalette.h"
 
 #include "FlowAsset.h"
+#include "FlowProfiler.h"
+#include "Asset/FlowRecordingPlayback.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
 
 #include "EdGraph/EdGraphNode.h"
 #include "Editor.h"
@@ -421,6 +426,15 @@ void FFlowAssetEditor::BindToolbarCommands()
 								FCanExecuteAction::CreateSP(this, &FFlowAssetEditor::CanGoToParentInstance),
 								FIsActionChecked(),
 								FIsActionButtonVisible::CreateSP(this, &FFlowAssetEditor::CanGoToParentInstance));
+
+	ToolkitCommands->MapAction(ToolbarCommands.ToggleProfiler,
+								FExecuteAction::CreateStatic(&FFlowAssetEditor::ToggleProfiler),
+								FCanExecuteAction(),
+								FIsActionChecked::CreateStatic(&FFlowAssetEditor::IsProfilerEnabled));
+
+	ToolkitCommands->MapAction(ToolbarCommands.LoadRecording,
+								FExecuteAction::CreateStatic(&FFlowAssetEditor::LoadRecording),
+								FCanExecuteAction());
 }
 
 void FFlowAssetEditor::InitalizeExtenders()
@@ -495,6 +509,40 @@ bool FFlowAssetEditor::CanGoToParentInstance()
 	return FlowAsset->GetInspectedInstance() && FlowAsset->GetInspectedInstance()->GetNodeOwningThisAssetInstance() != nullptr;
 }
 
+void FFlowAssetEditor::ToggleProfiler()
+{
+#if FLOW_WITH_PROFILER
+	FFlowProfiler::SetEnabled(!FFlowProfiler::IsEnabled());
+#endif
+}
+
+bool FFlowAssetEditor::IsProfilerEnabled()
+{
+#if FLOW_WITH_PROFILER
+	return FFlowProfiler::IsEnabled();
+#else
+	return false;
+#endif
+}
+
+void FFlowAssetEditor::LoadRecording()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform == nullptr)
+	{
+		return;
+	}
+
+	TArray<FString> FilePaths;
+	const void* ParentWindowHandle = FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr);
+	if (DesktopPlatform->OpenFileDialog(ParentWindowHandle, LOCTEXT("LoadRecordingTitle", "Load Flow Recording").ToString(),
+		FPaths::ProfilingDir() / TEXT("Flow"), FString(), TEXT("Flow Recording (*.flowrec)|*.flowrec"), EFileDialogFlags::None, FilePaths)
+		&& FilePaths.Num() > 0)
+	{
+		FFlowRecordingPlayback::Get().Load(FilePaths[0]);
+	}
+}
+
 void FFlowAssetEditor::CreateWidgets()
 {
 	// Details View
@@ -20,6 +20,7 @@ enum class EFlowAssetIndexerVersion
 {
 	Empty,
 	Initial,
+	NodeContent,
 
 	// -----<new versions can be added above this line>-------------------------------------------------
 	VersionPlusOne,
@@ -51,78 +52,99 @@ void FFlowAssetIndexer::IndexAsset(const UObject* InAssetObject, FSearchSerializ
 
 void FFlowAssetIndexer::IndexGraph(const UFlowAsset* InFlowAsset, FSearchSerializer& Serializer) const
 {
-	for (UEdGraphNode* Node : InFlowAsset->GetGraph()->Nodes)
+	for (const UEdGraphNode* Node : InFlowAsset->GetGraph()->Nodes)
 	{
-		// Ignore Reroutes
-		if (Cast<UFlowGraphNode_Reroute>(Node))
-		{
-			continue;
-		}
+		IndexGraphNode(Node, Serializer);
+	}
+}
+
+void FFlowAssetIndexer::IndexGraphNode(const UEdGraphNode* Node, FSearchSerializer& Serializer) const
+{
+	// Ignore Reroutes
+	if (Node == nullptr || Cast<UFlowGraphNode_Reroute>(Node))
+	{
+		return;
+	}
+
+	// Special rules for comment nodes
+	if (Cast<UEdGraphNode_Comment>(Node))
+	{
+		Serializer.BeginIndexingObject(Node, Node->NodeComment);
+		Serializer.IndexProperty(TEXT("Comment"), Node->NodeComment);
+		Serializer.EndIndexingObject();
+		return;
+	}
+
+	// Indexing UEdGraphNode
+	{
+		const FText NodeText = Node->GetNodeTitle(ENodeTitleType::MenuTitle);
+		Serializer.BeginIndexingObject(Node, NodeText);
+		Serializer.IndexProperty(TEXT("Title"), NodeText);
 
-		// Special rules for comment nodes
-		if (Cast<UEdGraphNode_Comment>(Node))
+		if (!Node->NodeComment.IsEmpty())
 		{
-			Serializer.BeginIndexingObject(Node, Node->NodeComment);
 			Serializer.IndexProperty(TEXT("Comment"), Node->NodeComment);
-			Serializer.EndIndexingObject();
-			continue;
 		}
 
-		// Indexing UEdGraphNode
+		for (const UEdGraphPin* Pin : Node->GetAllPins())
 		{
-			const FText NodeText = Node->GetNodeTitle(ENodeTitleType::MenuTitle);
-			Serializer.BeginIndexingObject(Node, NodeText);
-			Serializer.IndexProperty(TEXT("Title"), NodeText);
-
-			if (!Node->NodeComment.IsEmpty())
+			const FText PinText = Pin->GetDisplayName();
+			if (PinText.IsEmpty())
 			{
-				Serializer.IndexProperty(TEXT("Comment"), Node->NodeComment);
+				continue;
 			}
 
-			for (const UEdGraphPin* Pin : Node->GetAllPins())
+			// allows finding all nodes using the pin, i.e. events of Custom Inputs
+			Serializer.IndexProperty(TEXT("Pin"), PinText);
+
+			if (Pin->Direction == EGPD_Input && Pin->LinkedTo.Num() == 0)
 			{
-				if (Pin->Direction == EGPD_Input && Pin->LinkedTo.Num() == 0)
+				const FText PinValue = Pin->GetDefaultAsText();
+				if (PinValue.IsEmpty())
 				{
-					const FText PinText = Pin->GetDisplayName();
-					if (PinText.IsEmpty())
-					{
-						continue;
-					}
-
-					const FText PinValue = Pin->GetDefaultAsText();
-					if (PinValue.IsEmpty())
-					{
-						continue;
-					}
-
-					const FString PinLabel = TEXT("[Pin] ") + *FTextInspector::GetSourceString(PinText);
-					Serializer.IndexProperty(PinLabel, PinValue);
+					continue;
 				}
+
+				const FString PinLabel = TEXT("[Pin] ") + *FTextInspector::GetSourceString(PinText);
+				Serializer.IndexProperty(PinLabel, PinValue);
+			}
+		}
+
+		// This will serialize any user exposed options for the node that are editable in the Details
+		FIndexerUtilities::IterateIndexableProperties(Node, [&Serializer](const FProperty* Property, const FString& Value)
+		{
+			Serializer.IndexProperty(Property, Value);
+		});
+
+		Serializer.EndIndexingObject();
+	}
+
+	// Indexing Flow Node
+	if (const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node))
+	{
+		if (const UFlowNodeBase* FlowNodeBase = FlowGraphNode->GetFlowNodeBase())
+		{
+			const FString NodeDescription = FlowNodeBase->GetNodeDescription();
+			const FString NodeFriendlyName = FString::Printf(TEXT("%s: %s"), *FlowNodeBase->GetClass()->GetName(), *NodeDescription);
+			Serializer.BeginIndexingObject(FlowNodeBase, NodeFriendlyName);
+
+			Serializer.IndexProperty(TEXT("Class"), FlowNodeBase->GetClass()->GetName());
+			if (!NodeDescription.IsEmpty())
+			{
+				Serializer.IndexProperty(TEXT("Description"), NodeDescription);
 			}
 
-			// This will serialize any user exposed options for the node that are editable in the Details
-			FIndexerUtilities::IterateIndexableProperties(Node, [&Serializer](const FProperty* Property, const FString& Value)
+			FIndexerUtilities::IterateIndexableProperties(FlowNodeBase, [&Serializer](const FProperty* Property, const FString& Value)
 			{
 				Serializer.IndexProperty(Property, Value);
 			});
-
+			FlowGraphNode->AdditionalNodeIndexing(Serializer);
 			Serializer.EndIndexingObject();
 		}
 
-		// Indexing Flow Node
-		if (const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node))
+		for (const UFlowGraphNode* SubNode : FlowGraphNode->SubNodes)
 		{
-			if (const UFlowNodeBase* FlowNodeBase = FlowGraphNode->GetFlowNodeBase())
-			{
-				const FString NodeFriendlyName = FString::Printf(TEXT("%s: %s"), *FlowNodeBase->GetClass()->GetName(), *FlowNodeBase->GetNodeDescription());
-				Serializer.BeginIndexingObject(FlowNodeBase, NodeFriendlyName);
-				FIndexerUtilities::IterateIndexableProperties(FlowNodeBase, [&Serializer](const FProperty* Property, const FString& Value)
-				{
-					Serializer.IndexProperty(Property, Value);
-				});
-				FlowGraphNode->AdditionalNodeIndexing(Serializer);
-				Serializer.EndIndexingObject();
-			}
+			IndexGraphNode(SubNode, Serializer);
 		}
 	}
 }
@@ -0,0 +1,478 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowAssetOptimizer.h"
+#include "FlowAsset.h"
+#include "FlowEditorLogChannels.h"
+#include "Nodes/FlowNode.h"
+#include "Nodes/Graph/FlowNode_CustomInput.h"
+#include "Nodes/Graph/FlowNode_CustomOutput.h"
+#include "Nodes/Graph/FlowNode_Finish.h"
+#include "Nodes/Graph/FlowNode_Start.h"
+#include "Nodes/Graph/FlowNode_SubGraph.h"
+#include "Nodes/Route/FlowNode_Reroute.h"
+
+#include "UObject/UObjectHash.h"
+
+int32 FFlowAssetOptimizer::OptimizeForCook(UFlowAsset& FlowAsset)
+{
+	// Sub Graphs copied from another Sub Graph aren't inlined again, so recursive assets can't expand infinitely
+	TArray<UFlowNode_SubGraph*> SubGraphNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+	{
+		if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node.Value))
+		{
+			SubGraphNodes.Add(SubGraphNode);
+		}
+	}
+
+	int32 InlinedSubGraphs = 0;
+	for (UFlowNode_SubGraph* SubGraphNode : SubGraphNodes)
+	{
+		if (InlineSubGraph(FlowAsset, *SubGraphNode))
+		{
+			InlinedSubGraphs++;
+		}
+	}
+
+	const TMap<FGuid, UFlowNode*>& Nodes = FlowAsset.GetNodes();
+
+	// nodes read through data pins have to stay, even if no exec pin leads to them
+	TSet<FGuid> DataSupplierNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (IsValid(Node.Value))
+		{
+			for (const TPair<FName, FConnectedPin>& Connection : Node.Value->Connections)
+			{
+				if (!IsExecOutput(*Node.Value, Connection.Key))
+				{
+					DataSupplierNodes.Add(Connection.Value.NodeGuid);
+				}
+			}
+		}
+	}
+
+	// collapsed node -> connection of its only connected exec output, invalid if the output isn't connected
+	TMap<FGuid, FConnectedPin> CollapsedNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (IsValid(Node.Value) && CanCollapseNode(*Node.Value, DataSupplierNodes))
+		{
+			const TMap<FName, FConnectedPin>& Connections = Node.Value->Connections;
+			CollapsedNodes.Add(Node.Key, Connections.IsEmpty() ? FConnectedPin() : Connections.CreateConstIterator()->Value);
+		}
+	}
+
+	// connect nodes directly to the node triggered at the end of collapsed chains
+	int32 ChangedConnections = 0;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (!IsValid(Node.Value) || CollapsedNodes.Contains(Node.Key))
+		{
+			continue;
+		}
+
+		TMap<FName, FConnectedPin> Connections = Node.Value->Connections;
+		bool bConnectionsChanged = false;
+
+		for (auto It = Connections.CreateIterator(); It; ++It)
+		{
+			if (!IsExecOutput(*Node.Value, It.Key()))
+			{
+				continue;
+			}
+
+			const FConnectedPin ResolvedConnection = ResolveConnection(FlowAsset, It.Value(), CollapsedNodes);
+			if (ResolvedConnection == It.Value())
+			{
+				continue;
+			}
+
+			if (ResolvedConnection.NodeGuid.IsValid())
+			{
+				It.Value() = ResolvedConnection;
+			}
+			else
+			{
+				It.RemoveCurrent();
+			}
+
+			bConnectionsChanged = true;
+			ChangedConnections++;
+		}
+
+		if (bConnectionsChanged)
+		{
+			Node.Value->SetConnections(Connections);
+		}
+	}
+
+	// everything reachable from entry points through the remaining connections, including data suppliers
+	TSet<FGuid> ReachableNodes;
+	TArray<FGuid> PendingNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (IsValid(Node.Value) && !CollapsedNodes.Contains(Node.Key) && IsEntryNode(*Node.Value))
+		{
+			ReachableNodes.Add(Node.Key);
+			PendingNodes.Add(Node.Key);
+		}
+	}
+
+	if (const UFlowNode* DefaultEntryNode = FlowAsset.GetDefaultEntryNode())
+	{
+		bool bAlreadyReachable = false;
+		ReachableNodes.Add(DefaultEntryNode->GetGuid(), &bAlreadyReachable);
+		if (!bAlreadyReachable)
+		{
+			PendingNodes.Add(DefaultEntryNode->GetGuid());
+		}
+	}
+
+	while (!PendingNodes.IsEmpty())
+	{
+		const UFlowNode* Node = FlowAsset.GetNode(PendingNodes.Pop(EAllowShrinking::No));
+		if (Node == nullptr)
+		{
+			continue;
+		}
+
+		for (const TPair<FName, FConnectedPin>& Connection : Node->Connections)
+		{
+			bool bAlreadyReachable = false;
+			ReachableNodes.Add(Connection.Value.NodeGuid, &bAlreadyReachable);
+			if (!bAlreadyReachable)
+			{
+				PendingNodes.Add(Connection.Value.NodeGuid);
+			}
+		}
+	}
+
+	TArray<FGuid> StrippedNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (!ReachableNodes.Contains(Node.Key))
+		{
+			StrippedNodes.Add(Node.Key);
+		}
+	}
+
+	for (const FGuid& NodeGuid : StrippedNodes)
+	{
+		// collapsed nodes redirect to the node they triggered, so a SaveGame referencing them still points to the same place in the graph
+		const FConnectedPin* CollapsedConnection = CollapsedNodes.Find(NodeGuid);
+		const FConnectedPin ResolvedConnection = CollapsedConnection ? ResolveConnection(FlowAsset, *CollapsedConnection, CollapsedNodes) : FConnectedPin();
+		FlowAsset.StrippedNodeRedirects.FindOrAdd(NodeGuid, ResolvedConnection.NodeGuid);
+
+		// stripped node and its AddOns won't be cooked
+		if (UFlowNode* Node = FlowAsset.GetNode(NodeGuid))
+		{
+			Node->SetFlags(RF_Transient);
+			ForEachObjectWithOuter(Node, [](UObject* Subobject)
+			{
+				Subobject->SetFlags(RF_Transient);
+			});
+		}
+
+		FlowAsset.Nodes.Remove(NodeGuid);
+	}
+
+	if (InlinedSubGraphs > 0 || ChangedConnections > 0 || StrippedNodes.Num() > 0)
+	{
+		FlowAsset.Nodes.Compact();
+		FlowAsset.RebuildReverseConnections();
+		FlowAsset.InvalidateCompiledGraph();
+		FlowAsset.InvalidateCustomEventNodes();
+
+		UE_LOG(LogFlowEditor, Verbose, TEXT("Optimized %s for cook: %d Sub Graphs inlined, %d connections collapsed, %d nodes stripped"), *FlowAsset.GetName(), InlinedSubGraphs, ChangedConnections, StrippedNodes.Num());
+	}
+
+	return StrippedNodes.Num();
+}
+
+bool FFlowAssetOptimizer::InlineSubGraph(UFlowAsset& FlowAsset, UFlowNode_SubGraph& SubGraphNode)
+{
+	const UFlowAsset* SubAsset = SubGraphNode.Asset.LoadSynchronous();
+	if (SubAsset == nullptr || !SubAsset->bInlineWhenCooked || !CanInlineSubGraph(FlowAsset, SubGraphNode, *SubAsset))
+	{
+		return false;
+	}
+
+	const FGuid& SubGraphGuid = SubGraphNode.GetGuid();
+	const UFlowNode* SubEntryNode = SubAsset->GetDefaultEntryNode();
+
+	// copies get guids derived from the Sub Graph node, so SaveGames stay compatible between cooks
+	TMap<FGuid, UFlowNode*> CopiedNodes;
+	for (const TPair<FGuid, UFlowNode*>& SubNode : SubAsset->GetNodes())
+	{
+		if (SubNode.Value->IsA<UFlowNode_Start>() || SubNode.Value->IsA<UFlowNode_CustomInput>() || SubNode.Value->IsA<UFlowNode_Finish>() || SubNode.Value->IsA<UFlowNode_CustomOutput>())
+		{
+			continue;
+		}
+
+		UFlowNode* CopiedNode = DuplicateObject<UFlowNode>(SubNode.Value, &FlowAsset);
+		CopiedNode->SetGuid(FGuid::Combine(SubGraphGuid, SubNode.Key));
+		CopiedNodes.Add(SubNode.Key, CopiedNode);
+	}
+
+	// connection inside the Sub Graph -> connection in the parent graph, exits lead to outputs of the Sub Graph node
+	auto MapConnection = [&](const FConnectedPin& SubConnection) -> FConnectedPin
+	{
+		if (const UFlowNode* const* CopiedNode = CopiedNodes.Find(SubConnection.NodeGuid))
+		{
+			return FConnectedPin((*CopiedNode)->GetGuid(), SubConnection.PinName);
+		}
+
+		const UFlowNode* SubNode = SubAsset->GetNode(SubConnection.NodeGuid);
+		if (SubNode && SubNode->IsA<UFlowNode_Finish>())
+		{
+			return SubGraphNode.Connections.FindRef(UFlowNode_SubGraph::FinishPin.PinName);
+		}
+
+		if (const UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(SubNode))
+		{
+			return SubGraphNode.Connections.FindRef(CustomOutput->GetEventName());
+		}
+
+		return FConnectedPin();
+	};
+
+	for (const TPair<FGuid, UFlowNode*>& CopiedNode : CopiedNodes)
+	{
+		TMap<FName, FConnectedPin> Connections;
+		for (const TPair<FName, FConnectedPin>& Connection : CopiedNode.Value->Connections)
+		{
+			const FConnectedPin MappedConnection = MapConnection(Connection.Value);
+			if (MappedConnection.NodeGuid.IsValid())
+			{
+				Connections.Add(Connection.Key, MappedConnection);
+			}
+		}
+		CopiedNode.Value->SetConnections(Connections);
+
+		FlowAsset.Nodes.Add(CopiedNode.Value->GetGuid(), CopiedNode.Value);
+	}
+
+	// Start and Custom Inputs of the Sub Graph node lead directly to nodes connected to the Sub Graph entry points
+	auto MapInput = [&](const FName& PinName) -> FConnectedPin
+	{
+		const UFlowNode* EntryNode = PinName == UFlowNode_SubGraph::StartPin.PinName ? SubEntryNode : SubAsset->TryFindCustomInputNodeByEventName(PinName);
+		if (EntryNode && EntryNode->GetOutputPins().Num() > 0)
+		{
+			const FConnectedPin* EntryConnection = EntryNode->Connections.Find(EntryNode->GetOutputPins()[0].PinName);
+			return EntryConnection ? MapConnection(*EntryConnection) : FConnectedPin();
+		}
+
+		return FConnectedPin();
+	};
+
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+	{
+		// copies are included, the Sub Graph might lead back to the Sub Graph node
+		if (Node.Value == &SubGraphNode)
+		{
+			continue;
+		}
+
+		TMap<FName, FConnectedPin> Connections = Node.Value->Connections;
+		bool bConnectionsChanged = false;
+
+		for (auto It = Connections.CreateIterator(); It; ++It)
+		{
+			if (It.Value().NodeGuid != SubGraphGuid)
+			{
+				continue;
+			}
+
+			const FConnectedPin MappedConnection = MapInput(It.Value().PinName);
+			if (MappedConnection.NodeGuid.IsValid())
+			{
+				It.Value() = MappedConnection;
+			}
+			else
+			{
+				It.RemoveCurrent();
+			}
+
+			bConnectionsChanged = true;
+		}
+
+		if (bConnectionsChanged)
+		{
+			Node.Value->SetConnections(Connections);
+		}
+	}
+
+	// nothing leads to the Sub Graph node anymore, it's stripped together with unreachable nodes
+	const FConnectedPin EntryConnection = MapInput(UFlowNode_SubGraph::StartPin.PinName);
+	FlowAsset.StrippedNodeRedirects.Add(SubGraphGuid, EntryConnection.NodeGuid);
+
+	UE_LOG(LogFlowEditor, Verbose, TEXT("Inlined %d nodes of %s into %s"), CopiedNodes.Num(), *SubAsset->GetName(), *FlowAsset.GetName());
+	return true;
+}
+
+bool FFlowAssetOptimizer::CanInlineSubGraph(const UFlowAsset& FlowAsset, const UFlowNode_SubGraph& SubGraphNode, const UFlowAsset& SubAsset)
+{
+	// custom asset classes might override the graph lifetime events, like OnStart or FinishFlow
+	if (&SubAsset == &FlowAsset || SubAsset.GetClass() != UFlowAsset::StaticClass())
+	{
+		return false;
+	}
+
+	if (SubGraphNode.SignalMode != EFlowSignalMode::Enabled || !SubGraphNode.GetFlowNodeAddOnChildren().IsEmpty())
+	{
+		return false;
+	}
+
+	// data pins of the Sub Graph node are supplied to the Start node of the Sub Graph instance
+	for (const TPair<FName, FConnectedPin>& Connection : SubGraphNode.Connections)
+	{
+		if (!IsExecOutput(SubGraphNode, Connection.Key))
+		{
+			return false;
+		}
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+	{
+		for (const TPair<FName, FConnectedPin>& Connection : Node.Value->Connections)
+		{
+			if (Connection.Value.NodeGuid == SubGraphNode.GetGuid() && !IsExecOutput(*Node.Value, Connection.Key))
+			{
+				return false;
+			}
+		}
+	}
+
+	TSet<FName> CustomInputNames;
+	for (const TPair<FGuid, UFlowNode*>& SubNode : SubAsset.GetNodes())
+	{
+		if (!IsValid(SubNode.Value))
+		{
+			return false;
+		}
+
+		const bool bIsBoundaryNode = SubNode.Value->IsA<UFlowNode_Start>() || SubNode.Value->IsA<UFlowNode_CustomInput>() || SubNode.Value->IsA<UFlowNode_Finish>() || SubNode.Value->IsA<UFlowNode_CustomOutput>();
+		if (bIsBoundaryNode && (SubNode.Value->SignalMode != EFlowSignalMode::Enabled || !SubNode.Value->GetFlowNodeAddOnChildren().IsEmpty()))
+		{
+			return false;
+		}
+
+		// other nodes finishing the graph would have to finish the Sub Graph node
+		if (!bIsBoundaryNode && SubNode.Value->CanFinishGraph())
+		{
+			return false;
+		}
+
+		// the runtime triggers all Custom Inputs sharing the name, a connection leads to one node
+		if (const UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(SubNode.Value))
+		{
+			bool bAlreadyAdded = false;
+			CustomInputNames.Add(CustomInput->GetEventName(), &bAlreadyAdded);
+			if (bAlreadyAdded)
+			{
+				return false;
+			}
+		}
+
+		// boundary nodes aren't copied, so nothing can read their data pins
+		for (const TPair<FName, FConnectedPin>& Connection : SubNode.Value->Connections)
+		{
+			if (!IsExecOutput(*SubNode.Value, Connection.Key))
+			{
+				const UFlowNode* SupplierNode = SubAsset.GetNode(Connection.Value.NodeGuid);
+				if (SupplierNode == nullptr || SupplierNode->IsA<UFlowNode_Start>() || SupplierNode->IsA<UFlowNode_CustomInput>()
+					|| SupplierNode->IsA<UFlowNode_Finish>() || SupplierNode->IsA<UFlowNode_CustomOutput>())
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FFlowAssetOptimizer::CanCollapseNode(const UFlowNode& Node, const TSet<FGuid>& DataSupplierNodes)
+{
+	if (IsEntryNode(Node) || !Node.GetFlowNodeAddOnChildren().IsEmpty() || DataSupplierNodes.Contains(Node.GetGuid()) || Node.Connections.Num() > 1)
+	{
+		return false;
+	}
+
+	// data pins can't be collapsed into a single exec connection
+	for (const TPair<FName, FConnectedPin>& Connection : Node.Connections)
+	{
+		if (!IsExecOutput(Node, Connection.Key))
+		{
+			return false;
+		}
+	}
+
+	if (Node.IsA<UFlowNode_Reroute>())
+	{
+		return Node.SignalMode == EFlowSignalMode::Enabled;
+	}
+
+	if (Node.SignalMode == EFlowSignalMode::PassThrough)
+	{
+		// native overrides of OnPassThrough_Implementation can't be detected, the default implementation triggers all connected outputs
+		const UFunction* PassThroughFunction = Node.GetClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UFlowNode, OnPassThrough));
+		return PassThroughFunction && PassThroughFunction->GetOuterUClass() == UFlowNode::StaticClass();
+	}
+
+	return false;
+}
+
+bool FFlowAssetOptimizer::IsEntryNode(const UFlowNode& Node)
+{
+	if (Node.IsA<UFlowNode_Start>() || Node.IsA<UFlowNode_CustomInput>())
+	{
+		return true;
+	}
+
+	// nodes without exec inputs are started by the graph itself or from the outside
+	for (const FFlowPin& InputPin : Node.GetInputPins())
+	{
+		if (InputPin.IsExecPin())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FConnectedPin FFlowAssetOptimizer::ResolveConnection(const UFlowAsset& FlowAsset, const FConnectedPin& Connection, const TMap<FGuid, FConnectedPin>& CollapsedNodes)
+{
+	TSet<FGuid> VisitedNodes;
+	FConnectedPin ResolvedConnection = Connection;
+
+	while (const FConnectedPin* CollapsedConnection = CollapsedNodes.Find(ResolvedConnection.NodeGuid))
+	{
+		bool bAlreadyVisited = false;
+		VisitedNodes.Add(ResolvedConnection.NodeGuid, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			// loop made only of collapsed nodes, keep the original connection
+			return Connection;
+		}
+
+		ResolvedConnection = *CollapsedConnection;
+	}
+
+	const UFlowNode* ConnectedNode = FlowAsset.GetNode(ResolvedConnection.NodeGuid);
+	if (ConnectedNode == nullptr || ConnectedNode->SignalMode == EFlowSignalMode::Disabled)
+	{
+		// disabled nodes ignore any input activation
+		return FConnectedPin();
+	}
+
+	return ResolvedConnection;
+}
+
+bool FFlowAssetOptimizer::IsExecOutput(const UFlowNode& Node, const FName& PinName)
+{
+	const FFlowPin* OutputPin = Node.GetOutputPins().FindByKey(PinName);
+	return OutputPin && OutputPin->IsExecPin();
+}
@@ -4,18 +4,25 @@
 
 #include "Asset/FlowAssetEditor.h"
 #include "Asset/FlowAssetEditorContext.h"
+#include "Asset/FlowRecordingPlayback.h"
 #include "Asset/SAssetRevisionMenu.h"
 #include "FlowEditorCommands.h"
 
 #include "FlowAsset.h"
 
+#include "Editor.h"
+#include "Engine/Selection.h"
 #include "Kismet2/DebuggerCommands.h"
 #include "Misc/Attribute.h"
 #include "Misc/MessageDialog.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "ToolMenu.h"
 #include "ToolMenuSection.h"
-#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Layout/SBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
 
@@ -34,18 +41,21 @@ FText SFlowAssetInstanceList::NoInstanceSelectedText = LOCTEXT("NoInstanceSelect
 void SFlowAssetInstanceList::Construct(const FArguments& InArgs, const TWeakObjectPtr<UFlowAsset> InTemplateAsset)
 {
 	TemplateAsset = InTemplateAsset;
+
+	NoInstanceItem = MakeShared<FFlowAssetInstanceListItem>();
+	NoInstanceItem->DisplayName = *NoInstanceSelectedText.ToString();
+
 	if (TemplateAsset.IsValid())
 	{
-		TemplateAsset->OnDebuggerRefresh().AddSP(this, &SFlowAssetInstanceList::RefreshInstances);
-		RefreshInstances();
+		TemplateAsset->OnInstanceListChanged().AddSP(this, &SFlowAssetInstanceList::OnInstanceListChanged);
+		RebuildInstances();
 	}
 
-	// create dropdown
-	SAssignNew(Dropdown, SComboBox<TSharedPtr<FName>>)
-		.OptionsSource(&InstanceNames)
+	// create dropdown, list widget is created only when opened
+	SAssignNew(Dropdown, SComboButton)
 		.Visibility_Static(&SFlowAssetInstanceList::GetDebuggerVisibility)
-		.OnGenerateWidget(this, &SFlowAssetInstanceList::OnGenerateWidget)
-		.OnSelectionChanged(this, &SFlowAssetInstanceList::OnSelectionChanged)
+		.OnGetMenuContent(this, &SFlowAssetInstanceList::OnGetMenuContent)
+		.ButtonContent()
 		[
 			SNew(STextBlock)
 			.Text(this, &SFlowAssetInstanceList::GetSelectedInstanceName)
@@ -53,7 +63,28 @@ void SFlowAssetInstanceList::Construct(const FArguments& InArgs, const TWeakObje
 
 	ChildSlot
 	[
-		Dropdown.ToSharedRef()
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			Dropdown.ToSharedRef()
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SButton)
+			.Visibility_Static(&SFlowAssetInstanceList::GetDebuggerVisibility)
+			.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+			.ToolTipText(LOCTEXT("PickSelectedActorTooltip", "Inspect the instance started by the actor selected in the level editor"))
+			.IsEnabled(this, &SFlowAssetInstanceList::CanPickSelectedActor)
+			.OnClicked(this, &SFlowAssetInstanceList::OnPickSelectedActor)
+			[
+				SNew(SImage)
+				.Image(FAppStyle::GetBrush("Icons.EyeDropper"))
+				.ColorAndOpacity(FSlateColor::UseForeground())
+			]
+		]
 	];
 }
 
@@ -61,33 +92,82 @@ SFlowAssetInstanceList::~SFlowAssetInstanceList()
 {
 	if (TemplateAsset.IsValid())
 	{
-		TemplateAsset->OnDebuggerRefresh().RemoveAll(this);
+		TemplateAsset->OnInstanceListChanged().RemoveAll(this);
 	}
 }
 
-void SFlowAssetInstanceList::RefreshInstances()
+void SFlowAssetInstanceList::RebuildInstances()
 {
-	// collect instance names of this Flow Asset
-	InstanceNames = {MakeShareable(new FName(*NoInstanceSelectedText.ToString()))};
-	TemplateAsset->GetInstanceDisplayNames(InstanceNames);
+	Items.Reset();
+	for (UFlowAsset* Instance : TemplateAsset->GetActiveInstances())
+	{
+		if (Instance)
+		{
+			OnInstanceListChanged(Instance, true);
+		}
+	}
 
-	// select instance
-	if (const UFlowAsset* InspectedInstance = TemplateAsset->GetInspectedInstance())
+	FilterItems();
+}
+
+void SFlowAssetInstanceList::OnInstanceListChanged(UFlowAsset* Instance, const bool bAdded)
+{
+	if (Instance == nullptr)
 	{
-		const FName& InspectedInstanceName = InspectedInstance->GetDisplayName();
-		for (const TSharedPtr<FName>& Instance : InstanceNames)
+		RebuildInstances();
+		return;
+	}
+
+	if (bAdded)
+	{
+		const FItemPtr Item = MakeShared<FFlowAssetInstanceListItem>();
+		Item->Instance = Instance;
+		Item->DisplayName = Instance->GetDisplayName();
+		if (const AActor* ActorOwner = Instance->GetRootFlowActorOwner())
+		{
+			Item->OwnerName = ActorOwner->GetActorNameOrLabel();
+		}
+
+		Items.Add(Instance, Item);
+		if (Item->PassesFilter(FilterText))
 		{
-			if (*Instance == InspectedInstanceName)
+			Item->FilteredIndex = FilteredItems.Add(Item);
+		}
+	}
+	else
+	{
+		FItemPtr Item;
+		if (Items.RemoveAndCopyValue(Instance, Item) && FilteredItems.IsValidIndex(Item->FilteredIndex))
+		{
+			// thousands of instances finish at once on ending PIE, the list isn't sorted anyway
+			const int32 RemovedIndex = Item->FilteredIndex;
+			FilteredItems.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+			if (FilteredItems.IsValidIndex(RemovedIndex))
 			{
-				SelectedInstance = Instance;
-				break;
+				FilteredItems[RemovedIndex]->FilteredIndex = RemovedIndex;
 			}
 		}
 	}
-	else
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SFlowAssetInstanceList::FilterItems()
+{
+	FilteredItems.Reset(Items.Num() + 1);
+	NoInstanceItem->FilteredIndex = FilteredItems.Add(NoInstanceItem);
+
+	for (const TPair<TWeakObjectPtr<UFlowAsset>, FItemPtr>& Item : Items)
 	{
-		// default object is always available
-		SelectedInstance = InstanceNames[0];
+		Item.Value->FilteredIndex = Item.Value->PassesFilter(FilterText) ? FilteredItems.Add(Item.Value) : INDEX_NONE;
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
 	}
 }
 
@@ -96,28 +176,95 @@ EVisibility SFlowAssetInstanceList::GetDebuggerVisibility()
 	return GEditor->PlayWorld ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
-TSharedRef<SWidget> SFlowAssetInstanceList::OnGenerateWidget(const TSharedPtr<FName> Item) const
+TSharedRef<SWidget> SFlowAssetInstanceList::OnGetMenuContent()
 {
-	return SNew(STextBlock).Text(FText::FromName(*Item.Get()));
+	TSharedRef<SSearchBox> SearchBox = SNew(SSearchBox)
+		.InitialText(FText::FromString(FilterText))
+		.OnTextChanged(this, &SFlowAssetInstanceList::OnFilterTextChanged);
+
+	SAssignNew(ListView, SListView<FItemPtr>)
+		.ListItemsSource(&FilteredItems)
+		.SelectionMode(ESelectionMode::Single)
+		.OnGenerateRow(this, &SFlowAssetInstanceList::OnGenerateRow)
+		.OnSelectionChanged(this, &SFlowAssetInstanceList::OnSelectionChanged);
+
+	Dropdown->SetMenuContentWidgetToFocus(SearchBox);
+
+	return SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SearchBox
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(SBox)
+			.MinDesiredWidth(300.0f)
+			.MaxDesiredHeight(400.0f)
+			[
+				ListView.ToSharedRef()
+			]
+		];
+}
+
+TSharedRef<ITableRow> SFlowAssetInstanceList::OnGenerateRow(const FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	const FText Text = Item->OwnerName.IsEmpty()
+		? FText::FromName(Item->DisplayName)
+		: FText::Format(LOCTEXT("InstanceWithOwner", "{0} ({1})"), FText::FromName(Item->DisplayName), FText::FromString(Item->OwnerName));
+
+	return SNew(STableRow<FItemPtr>, OwnerTable)
+		[
+			SNew(STextBlock)
+			.Text(Text)
+			.HighlightText_Lambda([this]() { return FText::FromString(FilterText); })
+		];
+}
+
+void SFlowAssetInstanceList::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	FilterItems();
 }
 
-void SFlowAssetInstanceList::OnSelectionChanged(const TSharedPtr<FName> SelectedItem, const ESelectInfo::Type SelectionType)
+void SFlowAssetInstanceList::OnSelectionChanged(const FItemPtr SelectedItem, const ESelectInfo::Type SelectionType)
 {
-	if (SelectionType != ESelectInfo::Direct)
+	if (SelectionType != ESelectInfo::Direct && SelectedItem.IsValid() && TemplateAsset.IsValid())
 	{
-		SelectedInstance = SelectedItem;
+		TemplateAsset->SetInspectedInstance(SelectedItem->Instance.Get());
+		Dropdown->SetIsOpen(false);
+	}
+}
 
-		if (TemplateAsset.IsValid())
+FText SFlowAssetInstanceList::GetSelectedInstanceName() const
+{
+	const UFlowAsset* InspectedInstance = TemplateAsset.IsValid() ? TemplateAsset->GetInspectedInstance() : nullptr;
+	return InspectedInstance ? FText::FromName(InspectedInstance->GetDisplayName()) : NoInstanceSelectedText;
+}
+
+FReply SFlowAssetInstanceList::OnPickSelectedActor() const
+{
+	if (TemplateAsset.IsValid())
+	{
+		if (AActor* SelectedActor = GEditor->GetSelectedActors()->GetTop<AActor>())
 		{
-			const FName NewSelectedInstanceName = (SelectedInstance.IsValid() && *SelectedInstance != *InstanceNames[0]) ? *SelectedInstance : NAME_None;
-			TemplateAsset->SetInspectedInstance(NewSelectedInstanceName);
+			// actors picked in the level editor belong to the editor world, instances are owned by their PIE counterparts
+			const AActor* SimWorldActor = EditorUtilities::GetSimWorldCounterpartActor(SelectedActor);
+			if (UFlowAsset* Instance = TemplateAsset->FindInstanceByActorOwner(SimWorldActor ? SimWorldActor : SelectedActor))
+			{
+				TemplateAsset->SetInspectedInstance(Instance);
+			}
 		}
 	}
+
+	return FReply::Handled();
 }
 
-FText SFlowAssetInstanceList::GetSelectedInstanceName() const
+bool SFlowAssetInstanceList::CanPickSelectedActor() const
 {
-	return SelectedInstance.IsValid() ? FText::FromName(*SelectedInstance) : NoInstanceSelectedText;
+	return GEditor->GetSelectedActorCount() > 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -327,6 +474,48 @@ void FFlowAssetToolbar::BuildDebuggerToolbar(UToolMenu* ToolbarMenu) const
 
 			InSection.AddEntry(FToolMenuEntry::InitToolBarButton(FFlowToolbarCommands::Get().GoToParentInstance));
 			InSection.AddEntry(FToolMenuEntry::InitWidget("AssetBreadcrumb", SNew(SFlowAssetBreadcrumb, Context->GetFlowAsset()), FText(), true));
+
+			InSection.AddEntry(FToolMenuEntry::InitToolBarButton(
+				FFlowToolbarCommands::Get().ToggleProfiler,
+				TAttribute<FText>(),
+				TAttribute<FText>(),
+				FSlateIcon(FAppStyle::GetAppStyleSetName(), "Profiler.Tab")
+			));
+
+			InSection.AddEntry(FToolMenuEntry::InitToolBarButton(
+				FFlowToolbarCommands::Get().LoadRecording,
+				TAttribute<FText>(),
+				TAttribute<FText>(),
+				FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.FolderOpen")
+			));
+
+			// playback time of the loaded recording, scrubbing shows activations recorded until then
+			InSection.AddEntry(FToolMenuEntry::InitWidget("RecordingTime",
+				SNew(SBox)
+				.WidthOverride(120.f)
+				.Visibility_Lambda([]()
+				{
+					return FFlowRecordingPlayback::Get().IsLoaded() ? EVisibility::Visible : EVisibility::Collapsed;
+				})
+				[
+					SNew(SSpinBox<float>)
+					.MinValue(0.f)
+					.MaxValue_Lambda([]()
+					{
+						return TOptional<float>(FFlowRecordingPlayback::Get().GetRecording().GetDuration());
+					})
+					.Value_Lambda([]()
+					{
+						return FFlowRecordingPlayback::Get().GetTime();
+					})
+					.OnValueChanged_Lambda([](const float NewTime)
+					{
+						FFlowRecordingPlayback::Get().Pause();
+						FFlowRecordingPlayback::Get().SetTime(NewTime);
+					})
+					.ToolTipText(LOCTEXT("RecordingTimeTooltip", "Playback time of the loaded Flow recording, in seconds"))
+				],
+				FText(), true));
 		}
 	}));
 }
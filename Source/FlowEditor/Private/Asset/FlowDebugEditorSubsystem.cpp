@@ -3,6 +3,9 @@
 #include "Asset/FlowDebugEditorSubsystem.h"
 #include "Asset/FlowAssetEditor.h"
 #include "Asset/FlowMessageLogListing.h"
+#include "FlowAsset.h"
+#include "FlowMessageLog.h"
+#include "Graph/FlowGraphEditorSettings.h"
 
 #include "Editor/UnrealEdEngine.h"
 #include "Engine/Engine.h"
@@ -23,6 +26,15 @@ UFlowDebugEditorSubsystem::UFlowDebugEditorSubsystem()
 	FEditorDelegates::EndPIE.AddUObject(this, &ThisClass::OnEndPIE);
 }
 
+void UFlowDebugEditorSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(RuntimeLogsTickerHandle);
+	RuntimeLogsTickerHandle.Reset();
+	DirtyRuntimeLogs.Empty();
+
+	Super::Deinitialize();
+}
+
 void UFlowDebugEditorSubsystem::OnInstancedTemplateAdded(UFlowAsset* AssetTemplate)
 {
 	Super::OnInstancedTemplateAdded(AssetTemplate);
@@ -34,27 +46,68 @@ void UFlowDebugEditorSubsystem::OnInstancedTemplateAdded(UFlowAsset* AssetTempla
 	}
 }
 
-void UFlowDebugEditorSubsystem::OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate) const
+void UFlowDebugEditorSubsystem::OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate)
 {
 	AssetTemplate->OnRuntimeMessageAdded().RemoveAll(this);
 
+	// runtime log is released with the instanced template
+	if (DirtyRuntimeLogs.Remove(AssetTemplate) > 0)
+	{
+		FlushRuntimeLog(AssetTemplate);
+	}
+
 	Super::OnInstancedTemplateRemoved(AssetTemplate);
 }
 
-void UFlowDebugEditorSubsystem::OnRuntimeMessageAdded(const UFlowAsset* AssetTemplate, const TSharedRef<FTokenizedMessage>& Message) const
+void UFlowDebugEditorSubsystem::OnRuntimeMessageAdded(const UFlowAsset* AssetTemplate, const TSharedRef<FTokenizedMessage>& Message)
+{
+	DirtyRuntimeLogs.Add(AssetTemplate);
+
+	if (!RuntimeLogsTickerHandle.IsValid())
+	{
+		const float RefreshInterval = UFlowGraphEditorSettings::Get()->RuntimeLogRefreshInterval;
+		RuntimeLogsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::FlushRuntimeLogs), RefreshInterval);
+	}
+}
+
+bool UFlowDebugEditorSubsystem::FlushRuntimeLogs(float DeltaTime)
+{
+	RuntimeLogsTickerHandle.Reset();
+
+	for (const TWeakObjectPtr<const UFlowAsset>& AssetTemplate : DirtyRuntimeLogs)
+	{
+		if (AssetTemplate.IsValid())
+		{
+			FlushRuntimeLog(AssetTemplate.Get());
+		}
+	}
+	DirtyRuntimeLogs.Empty();
+
+	// registered again by the next message
+	return false;
+}
+
+void UFlowDebugEditorSubsystem::FlushRuntimeLog(const UFlowAsset* AssetTemplate) const
 {
 	const TSharedPtr<class IMessageLogListing> Log = RuntimeLogs.FindRef(AssetTemplate);
-	if (Log.IsValid())
+	const FFlowRuntimeMessageLog* RuntimeLog = AssetTemplate->GetRuntimeLog();
+	if (Log.IsValid() && RuntimeLog)
 	{
-		Log->AddMessage(Message);
-		Log->OnDataChanged().Broadcast();
+		// lines might be dropped or updated with the repeat count, so the listing mirrors the whole log
+		TArray<TSharedRef<FTokenizedMessage>> Messages;
+		RuntimeLog->GetMessages(Messages);
+
+		Log->ClearMessages();
+		Log->AddMessages(Messages);
 	}
 }
 
 void UFlowDebugEditorSubsystem::OnBeginPIE(const bool bIsSimulating)
 {
-	// clear all logs from a previous session
+	// clear all logs and hit counters from a previous session
 	RuntimeLogs.Empty();
+	DirtyRuntimeLogs.Empty();
+	ResetHitCounts();
 }
 
 void UFlowDebugEditorSubsystem::OnResumePIE(const bool bIsSimulating)
@@ -1,9 +1,11 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Asset/FlowDiffControl.h"
+#include "Asset/FlowStructuralDiff.h"
 #include "Asset/SFlowDiff.h"
 
 #include "FlowAsset.h"
+#include "Nodes/FlowNode.h"
 
 #include "EdGraph/EdGraph.h"
 #include "GraphDiffControl.h"
@@ -440,7 +442,19 @@ TSharedRef<SWidget> FFlowGraphToDiff::GenerateCategoryWidget() const
 void FFlowGraphToDiff::BuildDiffSourceArray()
 {
 	FoundDiffs->Empty();
-	FGraphDiffControl::DiffGraphs(GraphOld, GraphNew, *FoundDiffs);
+
+	const UFlowAsset* FlowAssetOld = GraphOld ? GraphOld->GetTypedOuter<UFlowAsset>() : nullptr;
+	const UFlowAsset* FlowAssetNew = GraphNew ? GraphNew->GetTypedOuter<UFlowAsset>() : nullptr;
+	if (FlowAssetOld && FlowAssetNew)
+	{
+		StructuralDiff.Empty();
+		FFlowStructuralDiff::DiffAssets(*FlowAssetOld, *FlowAssetNew, StructuralDiff);
+		DiffGraphsByGuid(*FoundDiffs);
+	}
+	else
+	{
+		FGraphDiffControl::DiffGraphs(GraphOld, GraphNew, *FoundDiffs);
+	}
 
 	Algo::SortBy(*FoundDiffs, &FDiffSingleResult::Diff);
 
@@ -451,6 +465,120 @@ void FFlowGraphToDiff::BuildDiffSourceArray()
 	}
 }
 
+void FFlowGraphToDiff::DiffGraphsByGuid(TArray<FDiffSingleResult>& OutDiffs) const
+{
+	// FGraphDiffControl::DiffGraphs searches the old graph for every new node, that's quadratic on large graphs
+	// Nodes keep their GUIDs between revisions, so we match them through the map and run the full node diff only on nodes changed by the structural diff
+	TSet<FGuid> ChangedFlowNodes;
+	FFlowStructuralDiff::GetChangedNodes(StructuralDiff, ChangedFlowNodes);
+
+	TMap<FGuid, UEdGraphNode*> OldNodesByGuid;
+	OldNodesByGuid.Reserve(GraphOld->Nodes.Num());
+	for (UEdGraphNode* OldNode : GraphOld->Nodes)
+	{
+		if (OldNode)
+		{
+			OldNodesByGuid.Add(OldNode->NodeGuid, OldNode);
+		}
+	}
+
+	const auto IsNodeUnchanged = [&ChangedFlowNodes](const UEdGraphNode& OldNode, const UEdGraphNode& NewNode)
+	{
+		const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(&NewNode);
+		const UFlowNode* FlowNode = FlowGraphNode ? Cast<UFlowNode>(FlowGraphNode->GetFlowNodeBase()) : nullptr;
+
+		// comments and other non-Flow nodes are always diffed
+		if (FlowNode == nullptr || ChangedFlowNodes.Contains(FlowNode->GetGuid()))
+		{
+			return false;
+		}
+
+		// editor-only data of the graph node, not covered by the structural diff
+		if (OldNode.GetClass() != NewNode.GetClass()
+			|| OldNode.NodePosX != NewNode.NodePosX
+			|| OldNode.NodePosY != NewNode.NodePosY
+			|| OldNode.NodeComment != NewNode.NodeComment
+			|| OldNode.Pins.Num() != NewNode.Pins.Num())
+		{
+			return false;
+		}
+
+		// default values of unconnected input pins are stored only on graph pins, FGraphDiffControl reports them as pin changes
+		for (int32 PinIndex = 0; PinIndex < NewNode.Pins.Num(); ++PinIndex)
+		{
+			const UEdGraphPin* OldPin = OldNode.Pins[PinIndex];
+			const UEdGraphPin* NewPin = NewNode.Pins[PinIndex];
+			if (OldPin == nullptr || NewPin == nullptr)
+			{
+				if (OldPin != NewPin)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			if (OldPin->PinName != NewPin->PinName
+				|| OldPin->DefaultValue != NewPin->DefaultValue
+				|| OldPin->DefaultObject != NewPin->DefaultObject
+				|| (!OldPin->DefaultTextValue.IdenticalTo(NewPin->DefaultTextValue) && !OldPin->DefaultTextValue.EqualTo(NewPin->DefaultTextValue)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	FDiffResults Results(&OutDiffs);
+
+	FGraphDiffControl::FNodeDiffContext AdditiveDiffContext;
+	AdditiveDiffContext.NodeTypeDisplayName = LOCTEXT("NodeMatchDiffContextNode", "Node");
+
+	TSet<const UEdGraphNode*> MatchedOldNodes;
+	MatchedOldNodes.Reserve(OldNodesByGuid.Num());
+
+	for (UEdGraphNode* NewNode : GraphNew->Nodes)
+	{
+		if (NewNode == nullptr)
+		{
+			continue;
+		}
+
+		FGraphDiffControl::FNodeMatch NodeMatch;
+		NodeMatch.NewNode = NewNode;
+		NodeMatch.OldNode = OldNodesByGuid.FindRef(NewNode->NodeGuid);
+
+		if (NodeMatch.OldNode)
+		{
+			MatchedOldNodes.Add(NodeMatch.OldNode);
+
+			if (IsNodeUnchanged(*NodeMatch.OldNode, *NewNode))
+			{
+				continue;
+			}
+		}
+
+		NodeMatch.Diff(AdditiveDiffContext, Results);
+	}
+
+	FGraphDiffControl::FNodeDiffContext SubtractiveDiffContext = AdditiveDiffContext;
+	SubtractiveDiffContext.DiffMode = FGraphDiffControl::EDiffMode::Subtractive;
+	SubtractiveDiffContext.DiffFlags = FGraphDiffControl::EDiffFlags::NodeExistance;
+
+	for (UEdGraphNode* OldNode : GraphOld->Nodes)
+	{
+		if (OldNode == nullptr || MatchedOldNodes.Contains(OldNode))
+		{
+			continue;
+		}
+
+		FGraphDiffControl::FNodeMatch NodeMatch;
+		NodeMatch.NewNode = OldNode;
+
+		NodeMatch.Diff(SubtractiveDiffContext, Results);
+	}
+}
+
 void FFlowGraphToDiff::OnGraphChanged(const FEdGraphEditAction& Action) const
 {
 	DiffWidget->OnGraphChanged(this);
@@ -16,7 +16,9 @@
 #include "AssetToolsModule.h"
 #include "EdGraphSchema_K2.h"
 #include "EditorAssetLibrary.h"
+#include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
+#include "UObject/UObjectGlobals.h"
 
 #if ENABLE_ASYNC_NODES_IMPORT
 #include "K2Node_BaseAsyncTask.h"
@@ -41,7 +43,123 @@ UFlowAsset* UFlowImportUtils::ImportBlueprintGraph(UObject* BlueprintAsset, cons
 		return nullptr;
 	}
 
-	UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintAsset);
+	FunctionsToFlowNodes = InFunctionsToFlowNodes;
+	PinMappings = InPinMappings;
+
+	UFlowAsset* FlowAsset = CreateFlowAssetFromBlueprint(Cast<UBlueprint>(BlueprintAsset), FlowAssetClass, FlowAssetName, StartEventName);
+
+	FunctionsToFlowNodes.Empty();
+	PinMappings.Empty();
+
+	if (FlowAsset)
+	{
+		UEditorAssetLibrary::SaveLoadedAsset(FlowAsset->GetPackage());
+	}
+
+	return FlowAsset;
+}
+
+FFlowBatchImportResult UFlowImportUtils::ImportBlueprintGraphs(const FFlowBatchImportParams& Params,
+																const TMap<FName, TSubclassOf<UFlowNode>>& InFunctionsToFlowNodes, const TMap<TSubclassOf<UFlowNode>, FBlueprintToFlowPinName>& InPinMappings)
+{
+	FFlowBatchImportResult Result;
+	if (Params.FlowAssetClass == nullptr || Params.StartEventName.IsNone())
+	{
+		return Result;
+	}
+
+	TSet<FString> ImportedBlueprints;
+	if (!Params.ProgressFilePath.IsEmpty())
+	{
+		TArray<FString> Lines;
+		if (FFileHelper::LoadFileToStringArray(Lines, *Params.ProgressFilePath))
+		{
+			ImportedBlueprints.Append(Lines);
+		}
+	}
+
+	TArray<FSoftObjectPath> PendingBlueprints;
+	PendingBlueprints.Reserve(Params.Blueprints.Num());
+	for (const FSoftObjectPath& BlueprintPath : Params.Blueprints)
+	{
+		if (ImportedBlueprints.Contains(BlueprintPath.ToString()))
+		{
+			Result.Skipped++;
+		}
+		else
+		{
+			PendingBlueprints.Add(BlueprintPath);
+		}
+	}
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Importing %d blueprint graphs, %d skipped as already imported"), PendingBlueprints.Num(), Result.Skipped);
+
+	FunctionsToFlowNodes = InFunctionsToFlowNodes;
+	PinMappings = InPinMappings;
+
+	FScopedSlowTask BatchTask(PendingBlueprints.Num(), LOCTEXT("ImportBlueprintGraphs", "Importing blueprint graphs"));
+	BatchTask.MakeDialog(true);
+
+	int32 PrefetchedIndex = 0;
+	for (int32 Index = 0; Index < PendingBlueprints.Num(); Index++)
+	{
+		if (BatchTask.ShouldCancel())
+		{
+			Result.bCancelled = true;
+			break;
+		}
+
+		// editing graphs and saving packages has to happen on the game thread, but following blueprints can be loaded in the background meanwhile
+		const int32 PrefetchEnd = FMath::Min(PendingBlueprints.Num(), Index + 1 + FMath::Max(Params.PrefetchCount, 0));
+		for (; PrefetchedIndex < PrefetchEnd; PrefetchedIndex++)
+		{
+			LoadPackageAsync(PendingBlueprints[PrefetchedIndex].GetLongPackageName());
+		}
+
+		const FSoftObjectPath& BlueprintPath = PendingBlueprints[Index];
+		BatchTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ImportBlueprintGraphsProgress", "Importing {0} ({1}/{2})"),
+			FText::FromString(BlueprintPath.GetAssetName()), FText::AsNumber(Index + 1), FText::AsNumber(PendingBlueprints.Num())));
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintPath.TryLoad());
+		UFlowAsset* FlowAsset = Blueprint ? CreateFlowAssetFromBlueprint(Blueprint, Params.FlowAssetClass, Params.FlowAssetPrefix + Blueprint->GetName(), Params.StartEventName) : nullptr;
+
+		// saved right away, so progress isn't lost on a failure and memory can be reclaimed
+		if (FlowAsset && UEditorAssetLibrary::SaveLoadedAsset(FlowAsset, false))
+		{
+			Result.Imported++;
+			UE_LOG(LogFlowEditor, Display, TEXT("Imported %s as %s"), *BlueprintPath.ToString(), *FlowAsset->GetPathName());
+
+			if (!Params.ProgressFilePath.IsEmpty())
+			{
+				FFileHelper::SaveStringToFile(BlueprintPath.ToString() + LINE_TERMINATOR, *Params.ProgressFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+			}
+		}
+		else
+		{
+			Result.Failed++;
+			UE_LOG(LogFlowEditor, Error, TEXT("Failed to import %s"), *BlueprintPath.ToString());
+		}
+
+		if (Params.GarbageCollectionInterval > 0 && (Index + 1) % Params.GarbageCollectionInterval == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	FunctionsToFlowNodes.Empty();
+	PinMappings.Empty();
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Imported %d blueprint graphs, %d failed, %d skipped%s"), Result.Imported, Result.Failed, Result.Skipped, Result.bCancelled ? TEXT(", cancelled") : TEXT(""));
+	return Result;
+}
+
+UFlowAsset* UFlowImportUtils::CreateFlowAssetFromBlueprint(UBlueprint* Blueprint, const TSubclassOf<UFlowAsset> FlowAssetClass, const FString& FlowAssetName, const FName StartEventName)
+{
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
 	UFlowAsset* FlowAsset = nullptr;
 
 	// we assume that users want to have a converted asset in the same folder as the legacy blueprint
@@ -70,15 +188,8 @@ UFlowAsset* UFlowImportUtils::ImportBlueprintGraph(UObject* BlueprintAsset, cons
 	// import graph
 	if (FlowAsset)
 	{
-		FunctionsToFlowNodes = InFunctionsToFlowNodes;
-		PinMappings = InPinMappings;
-
 		ImportBlueprintGraph(Blueprint, FlowAsset, StartEventName);
-		FunctionsToFlowNodes.Empty();
-		PinMappings.Empty();
-
 		Cast<UFlowGraph>(FlowAsset->GetGraph())->RefreshGraph();
-		UEditorAssetLibrary::SaveLoadedAsset(FlowAsset->GetPackage());
 	}
 
 	return FlowAsset;
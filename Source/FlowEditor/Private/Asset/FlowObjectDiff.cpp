@@ -7,6 +7,7 @@
 #include "Nodes/FlowNodeBase.h"
 
 #include "DiffResults.h"
+#include "DiffUtils.h"
 #include "EdGraph/EdGraph.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "SBlueprintDiff.h"
@@ -27,12 +28,12 @@ FFlowObjectDiff::FFlowObjectDiff(TSharedPtr<FDiffResultItem> InDiffResult, const
 	//ensure we do not generate details panels for pin changes.
 	if (InDiffResult->Result.Pin1 == nullptr && InDiffResult->Result.Pin2 == nullptr)
 	{
-		InitializeDetailsDiffFromNode(InDiffResult->Result.Node1, InDiffResult->Result.Object1, GraphToDiff);
-		InitializeDetailsDiffFromNode(InDiffResult->Result.Node2, InDiffResult->Result.Object2, GraphToDiff);
+		InitializeObjectFromNode(InDiffResult->Result.Node1, InDiffResult->Result.Object1, GraphToDiff);
+		InitializeObjectFromNode(InDiffResult->Result.Node2, InDiffResult->Result.Object2, GraphToDiff);
 	}
 }
 
-void FFlowObjectDiff::InitializeDetailsDiffFromNode(UEdGraphNode* Node, const UObject* Object, const FFlowGraphToDiff& GraphToDiff)
+void FFlowObjectDiff::InitializeObjectFromNode(UEdGraphNode* Node, const UObject* Object, const FFlowGraphToDiff& GraphToDiff)
 {
 	if (!IsValid(Node))
 	{
@@ -49,30 +50,43 @@ void FFlowObjectDiff::InitializeDetailsDiffFromNode(UEdGraphNode* Node, const UO
 	}
 	const ENodeDiffType NodeDiffType = GraphToDiff.GetNodeDiffType(*Node);
 
-	if (NodeDiffType == ENodeDiffType::Old && !OldDetailsView.IsValid())
+	if (NodeDiffType == ENodeDiffType::Old && !OldObject.IsValid())
+	{
+		OldObject = Object;
+	}
+	else if (NodeDiffType == ENodeDiffType::New && !NewObject.IsValid())
+	{
+		NewObject = Object;
+	}
+}
+
+void FFlowObjectDiff::CreateDetailsViews()
+{
+	if (!OldDetailsView.IsValid() && OldObject.IsValid())
 	{
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
-		OldDetailsView = MakeShared<FDetailsDiff>(Object, FOnDisplayedPropertiesChanged());
+		OldDetailsView = MakeShared<FDetailsDiff>(OldObject.Get(), FOnDisplayedPropertiesChanged());
 #else
-		OldDetailsView = MakeShared<FDetailsDiff>(Object);
+		OldDetailsView = MakeShared<FDetailsDiff>(OldObject.Get());
 #endif
 	}
-	else if (NodeDiffType == ENodeDiffType::New && !NewDetailsView.IsValid())
+
+	if (!NewDetailsView.IsValid() && NewObject.IsValid())
 	{
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6		
-		NewDetailsView = MakeShared<FDetailsDiff>(Object, FOnDisplayedPropertiesChanged());
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
+		NewDetailsView = MakeShared<FDetailsDiff>(NewObject.Get(), FOnDisplayedPropertiesChanged());
 #else
-		NewDetailsView = MakeShared<FDetailsDiff>(Object);
+		NewDetailsView = MakeShared<FDetailsDiff>(NewObject.Get());
 #endif
 	}
 }
 
 void FFlowObjectDiff::DiffProperties(TArray<FSingleObjectDiffEntry>& OutPropertyDiffsArray) const
 {
-	if (OldDetailsView.IsValid() && NewDetailsView.IsValid())
+	// compares reflected properties directly, instead of property trees of details views
+	if (OldObject.IsValid() && NewObject.IsValid())
 	{
-		static constexpr bool bSortByDisplayOrder = true;
-		OldDetailsView->DiffAgainst(*NewDetailsView.Get(), OutPropertyDiffsArray, bSortByDisplayOrder);
+		DiffUtils::CompareUnrelatedObjects(OldObject.Get(), NewObject.Get(), OutPropertyDiffsArray);
 	}
 }
 
@@ -0,0 +1,253 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowRecordingPlayback.h"
+#include "FlowEditorLogChannels.h"
+
+#include "FlowAsset.h"
+
+#include "HAL/IConsoleManager.h"
+
+static int32 GFlowRemoteDebugMaxLiveEvents = 1000000;
+static FAutoConsoleVariableRef CVarFlowRemoteDebugMaxLiveEvents(
+	TEXT("Flow.RemoteDebug.MaxLiveEvents"),
+	GFlowRemoteDebugMaxLiveEvents,
+	TEXT("Activations kept by the live recording of the remote debug session, the oldest quarter is dropped once exceeded. 0 keeps all of them"));
+
+FFlowRecordingPlayback& FFlowRecordingPlayback::Get()
+{
+	static FFlowRecordingPlayback Playback;
+	return Playback;
+}
+
+bool FFlowRecordingPlayback::Load(const FString& FilePath)
+{
+	Clear();
+
+	if (!Recording.Load(FilePath))
+	{
+		return false;
+	}
+
+	BuildEventsByTemplate();
+
+	bLoaded = true;
+	Time = Recording.GetDuration();
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Flow Recording: loaded %d activations of %d instances, %.2f seconds"), Recording.Events.Num(), Recording.Instances.Num(), Time);
+	return true;
+}
+
+void FFlowRecordingPlayback::BuildEventsByTemplate()
+{
+	EventsByTemplate.Reset();
+
+	for (int32 EventIndex = 0; EventIndex < Recording.Events.Num(); EventIndex++)
+	{
+		if (const FFlowRecordedInstance* Instance = Recording.Instances.Find(Recording.Events[EventIndex].InstanceId))
+		{
+			EventsByTemplate.FindOrAdd(Instance->TemplatePath).Add(EventIndex);
+		}
+	}
+}
+
+void FFlowRecordingPlayback::Clear()
+{
+	Pause();
+
+	Recording = FFlowExecutionRecording();
+	EventsByTemplate.Empty();
+	LiveNodeStates.Empty();
+	bLoaded = false;
+	bLive = false;
+	Time = 0.f;
+}
+
+void FFlowRecordingPlayback::BeginLive()
+{
+	Clear();
+
+	bLoaded = true;
+	bLive = true;
+}
+
+void FFlowRecordingPlayback::AddLiveInstance(const uint32 InstanceId, FFlowRecordedInstance&& Instance)
+{
+	Recording.Instances.Add(InstanceId, MoveTemp(Instance));
+}
+
+void FFlowRecordingPlayback::AddLiveEvent(const FFlowRecordedEvent& Event)
+{
+	if (const FFlowRecordedInstance* Instance = Recording.Instances.Find(Event.InstanceId))
+	{
+		EventsByTemplate.FindOrAdd(Instance->TemplatePath).Add(Recording.Events.Add(Event));
+		Time = FMath::Max(Time, Event.Time);
+
+		if (GFlowRemoteDebugMaxLiveEvents > 0 && Recording.Events.Num() > GFlowRemoteDebugMaxLiveEvents)
+		{
+			TrimLiveEvents();
+		}
+	}
+}
+
+void FFlowRecordingPlayback::TrimLiveEvents()
+{
+	// a quarter at once, so indices are rebuilt rarely
+	const int32 RemovedEvents = FMath::Max(Recording.Events.Num() / 4, 1);
+	Recording.Events.RemoveAt(0, RemovedEvents, EAllowShrinking::No);
+	BuildEventsByTemplate();
+
+	UE_LOG(LogFlowEditor, Verbose, TEXT("Flow Remote Debug: dropped %d oldest activations of the live recording"), RemovedEvents);
+}
+
+void FFlowRecordingPlayback::SetLiveNodeState(const uint32 InstanceId, const uint16 NodeIndex, const EFlowNodeState State)
+{
+	const FFlowRecordedInstance* Instance = Recording.Instances.Find(InstanceId);
+	if (Instance && Instance->NodeGuids.IsValidIndex(NodeIndex))
+	{
+		LiveNodeStates.FindOrAdd(Instance->TemplatePath).Add(Instance->NodeGuids[NodeIndex], State);
+	}
+}
+
+EFlowNodeState FFlowRecordingPlayback::GetLiveNodeState(const UFlowAsset& Template, const FGuid& NodeGuid) const
+{
+	if (const TMap<FGuid, EFlowNodeState>* NodeStates = LiveNodeStates.Find(Template.GetPathName()))
+	{
+		if (const EFlowNodeState* State = NodeStates->Find(NodeGuid))
+		{
+			return *State;
+		}
+	}
+
+	return EFlowNodeState::NeverActivated;
+}
+
+void FFlowRecordingPlayback::SetTime(const float NewTime)
+{
+	Time = FMath::Clamp(NewTime, 0.f, Recording.GetDuration());
+}
+
+void FFlowRecordingPlayback::Play(const float InSpeed)
+{
+	Pause();
+
+	Speed = InSpeed;
+	if (bLoaded)
+	{
+		if (Time >= Recording.GetDuration())
+		{
+			Time = 0.f;
+		}
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFlowRecordingPlayback::Tick));
+	}
+}
+
+void FFlowRecordingPlayback::Pause()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FFlowRecordingPlayback::Tick(const float DeltaTime)
+{
+	SetTime(Time + DeltaTime * Speed);
+
+	if (Time >= Recording.GetDuration())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FFlowRecordingPlayback::HasTemplate(const UFlowAsset& Template) const
+{
+	return EventsByTemplate.Contains(Template.GetPathName());
+}
+
+template <typename PredicateType>
+void FFlowRecordingPlayback::ForEachTemplateEvent(const UFlowAsset& Template, PredicateType Predicate) const
+{
+	const TArray<int32>* EventIndices = EventsByTemplate.Find(Template.GetPathName());
+	if (EventIndices == nullptr)
+	{
+		return;
+	}
+
+	for (const int32 EventIndex : *EventIndices)
+	{
+		const FFlowRecordedEvent& Event = Recording.Events[EventIndex];
+		if (Event.Time > Time)
+		{
+			// events are ordered by time
+			break;
+		}
+
+		const FFlowRecordedInstance& Instance = Recording.Instances.FindChecked(Event.InstanceId);
+		if (Instance.NodeGuids.IsValidIndex(Event.NodeIndex))
+		{
+			Predicate(Event, Instance.NodeGuids[Event.NodeIndex]);
+		}
+	}
+}
+
+void FFlowRecordingPlayback::GetWireRecords(const UFlowAsset& Template, TMap<FGuid, TMap<uint8, float>>& OutRecords) const
+{
+	ForEachTemplateEvent(Template, [&OutRecords](const FFlowRecordedEvent& Event, const FGuid& NodeGuid)
+	{
+		if (Event.EventType == EFlowRecordedEventType::Output)
+		{
+			OutRecords.FindOrAdd(NodeGuid).Add(Event.PinIndex, Event.Time);
+		}
+	});
+}
+
+void FFlowRecordingPlayback::GetPinRecords(const UFlowAsset& Template, const FGuid& NodeGuid, const uint8 PinIndex, const EFlowRecordedEventType EventType, TArray<float>& OutTimes) const
+{
+	ForEachTemplateEvent(Template, [&](const FFlowRecordedEvent& Event, const FGuid& EventNodeGuid)
+	{
+		if (Event.EventType == EventType && Event.PinIndex == PinIndex && EventNodeGuid == NodeGuid)
+		{
+			OutTimes.Add(Event.Time);
+		}
+	});
+}
+
+static FAutoConsoleCommand FlowRecordingLoadCommand(
+	TEXT("Flow.Recording.Load"),
+	TEXT("Loads the file written by Flow.Recorder, graphs of recorded assets show its activations. Arguments: FilePath"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.IsValidIndex(0))
+		{
+			FFlowRecordingPlayback::Get().Load(Args[0]);
+		}
+	}));
+
+static FAutoConsoleCommand FlowRecordingScrubCommand(
+	TEXT("Flow.Recording.Scrub"),
+	TEXT("Sets the playback time of the loaded Flow recording. Arguments: Seconds"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FFlowRecordingPlayback::Get().Pause();
+		FFlowRecordingPlayback::Get().SetTime(Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 0.f);
+	}));
+
+static FAutoConsoleCommand FlowRecordingPlayCommand(
+	TEXT("Flow.Recording.Play"),
+	TEXT("Replays the loaded Flow recording from the playback time. Arguments: [Speed=1]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FFlowRecordingPlayback::Get().Play(Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 1.f);
+	}));
+
+static FAutoConsoleCommand FlowRecordingClearCommand(
+	TEXT("Flow.Recording.Clear"),
+	TEXT("Unloads the Flow recording"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FFlowRecordingPlayback::Get().Clear();
+	}));
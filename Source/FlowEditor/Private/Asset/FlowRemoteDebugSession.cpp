@@ -0,0 +1,220 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowRemoteDebugSession.h"
+#include "Asset/FlowRecordingPlayback.h"
+#include "FlowEditorLogChannels.h"
+
+#include "Containers/Queue.h"
+#include "HAL/IConsoleManager.h"
+#include "Trace/Analysis.h"
+#include "Trace/Analyzer.h"
+#include "Trace/DataStream.h"
+#include "Trace/StoreClient.h"
+
+// Runs on the analysis thread, events are handed over to the game thread by queues
+class FFlowRemoteDebugAnalyzer : public UE::Trace::IAnalyzer
+{
+public:
+	struct FNodeState
+	{
+		uint32 InstanceId = 0;
+		uint16 NodeIndex = 0;
+		EFlowNodeState State = EFlowNodeState::NeverActivated;
+	};
+
+	// instance always precedes its events, so instances are dequeued first
+	TQueue<TPair<uint32, FFlowRecordedInstance>, EQueueMode::Spsc> Instances;
+	TQueue<FFlowRecordedEvent, EQueueMode::Spsc> Events;
+	TQueue<FNodeState, EQueueMode::Spsc> NodeStates;
+
+	virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override
+	{
+		FInterfaceBuilder& Builder = Context.InterfaceBuilder;
+		Builder.RouteEvent(RouteId_Instance, "Flow", "RemoteInstance");
+		Builder.RouteEvent(RouteId_Pin, "Flow", "RemotePin");
+		Builder.RouteEvent(RouteId_NodeState, "Flow", "RemoteNodeState");
+	}
+
+	virtual bool OnEvent(const uint16 RouteId, EStyle Style, const FOnEventContext& Context) override
+	{
+		const FEventData& EventData = Context.EventData;
+
+		switch (RouteId)
+		{
+			case RouteId_Instance:
+			{
+				TPair<uint32, FFlowRecordedInstance> Instance;
+				Instance.Key = EventData.GetValue<uint32>("InstanceId");
+				EventData.GetString("TemplatePath", Instance.Value.TemplatePath);
+				EventData.GetString("InstanceName", Instance.Value.InstanceName);
+
+				const TArrayReader<uint32>& GuidComponents = EventData.GetArray<uint32>("NodeGuids");
+				Instance.Value.NodeGuids.Reserve(GuidComponents.Num() / 4);
+				for (uint32 Index = 0; Index + 3 < GuidComponents.Num(); Index += 4)
+				{
+					Instance.Value.NodeGuids.Emplace(GuidComponents[Index], GuidComponents[Index + 1], GuidComponents[Index + 2], GuidComponents[Index + 3]);
+				}
+
+				Instances.Enqueue(MoveTemp(Instance));
+				break;
+			}
+			case RouteId_Pin:
+			{
+				FFlowRecordedEvent Event;
+				Event.Time = EventData.GetValue<float>("Time");
+				Event.InstanceId = EventData.GetValue<uint32>("InstanceId");
+				Event.NodeIndex = EventData.GetValue<uint16>("NodeIndex");
+				Event.PinIndex = EventData.GetValue<uint8>("PinIndex");
+				Event.EventType = static_cast<EFlowRecordedEventType>(EventData.GetValue<uint8>("EventType"));
+				Events.Enqueue(Event);
+				break;
+			}
+			case RouteId_NodeState:
+			{
+				FNodeState NodeState;
+				NodeState.InstanceId = EventData.GetValue<uint32>("InstanceId");
+				NodeState.NodeIndex = EventData.GetValue<uint16>("NodeIndex");
+				NodeState.State = static_cast<EFlowNodeState>(EventData.GetValue<uint8>("State"));
+				NodeStates.Enqueue(NodeState);
+				break;
+			}
+			default: ;
+		}
+
+		return true;
+	}
+
+private:
+	enum : uint16
+	{
+		RouteId_Instance,
+		RouteId_Pin,
+		RouteId_NodeState
+	};
+};
+
+FFlowRemoteDebugSession& FFlowRemoteDebugSession::Get()
+{
+	static FFlowRemoteDebugSession Session;
+	return Session;
+}
+
+bool FFlowRemoteDebugSession::Connect(const FString& StoreHost)
+{
+	Disconnect();
+
+	StoreClient.Reset(UE::Trace::FStoreClient::Connect(*StoreHost));
+	if (!StoreClient.IsValid())
+	{
+		UE_LOG(LogFlowEditor, Warning, TEXT("Flow Remote Debug: can't connect to the trace store at %s"), *StoreHost);
+		return false;
+	}
+
+	// the most recent live session, presumably the device started last
+	const UE::Trace::FStoreClient::FSessionInfo* LiveSession = nullptr;
+	for (uint32 SessionIndex = 0; SessionIndex < StoreClient->GetSessionCount(); ++SessionIndex)
+	{
+		LiveSession = StoreClient->GetSessionInfo(SessionIndex);
+	}
+
+	if (LiveSession == nullptr)
+	{
+		UE_LOG(LogFlowEditor, Warning, TEXT("Flow Remote Debug: no live trace session at %s"), *StoreHost);
+		StoreClient.Reset();
+		return false;
+	}
+
+	UE::Trace::FStoreClient::FTraceData TraceData = StoreClient->ReadTrace(LiveSession->GetTraceId());
+	if (!TraceData.IsValid())
+	{
+		UE_LOG(LogFlowEditor, Warning, TEXT("Flow Remote Debug: can't read the live trace session"));
+		StoreClient.Reset();
+		return false;
+	}
+	DataStream = MoveTemp(TraceData);
+
+	FFlowRecordingPlayback::Get().BeginLive();
+
+	Analyzer = MakeShared<FFlowRemoteDebugAnalyzer>();
+
+	UE::Trace::FAnalysisContext Context;
+	Context.AddAnalyzer(*Analyzer);
+	Processor = MakeUnique<UE::Trace::FAnalysisProcessor>(Context.Process(*DataStream));
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFlowRemoteDebugSession::Tick));
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Flow Remote Debug: connected to the live trace session at %s"), *StoreHost);
+	return true;
+}
+
+void FFlowRemoteDebugSession::Disconnect()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	if (Processor.IsValid())
+	{
+		Processor->Stop();
+		Processor->Wait();
+		Processor.Reset();
+	}
+
+	Analyzer.Reset();
+	DataStream.Reset();
+	StoreClient.Reset();
+}
+
+bool FFlowRemoteDebugSession::Tick(float DeltaTime)
+{
+	FFlowRecordingPlayback& Playback = FFlowRecordingPlayback::Get();
+
+	TPair<uint32, FFlowRecordedInstance> Instance;
+	while (Analyzer->Instances.Dequeue(Instance))
+	{
+		Playback.AddLiveInstance(Instance.Key, MoveTemp(Instance.Value));
+	}
+
+	FFlowRecordedEvent Event;
+	while (Analyzer->Events.Dequeue(Event))
+	{
+		Playback.AddLiveEvent(Event);
+	}
+
+	FFlowRemoteDebugAnalyzer::FNodeState NodeState;
+	while (Analyzer->NodeStates.Dequeue(NodeState))
+	{
+		Playback.SetLiveNodeState(NodeState.InstanceId, NodeState.NodeIndex, NodeState.State);
+	}
+
+	if (!Processor->IsActive())
+	{
+		UE_LOG(LogFlowEditor, Display, TEXT("Flow Remote Debug: live trace session ended"));
+		TickerHandle.Reset();
+		Processor.Reset();
+		Analyzer.Reset();
+		DataStream.Reset();
+		StoreClient.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+static FAutoConsoleCommand FlowRemoteDebugConnectCommand(
+	TEXT("Flow.RemoteDebug.Connect"),
+	TEXT("Shows activations streamed by the device over the FlowDebug trace channel on Flow graphs. Arguments: [TraceStoreHost=localhost]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FFlowRemoteDebugSession::Get().Connect(Args.IsValidIndex(0) ? Args[0] : TEXT("localhost"));
+	}));
+
+static FAutoConsoleCommand FlowRemoteDebugDisconnectCommand(
+	TEXT("Flow.RemoteDebug.Disconnect"),
+	TEXT("Stops reading the live trace session, streamed activations stay visible until Flow.Recording.Clear"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FFlowRemoteDebugSession::Get().Disconnect();
+	}));
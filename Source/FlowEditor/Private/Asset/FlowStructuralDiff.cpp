@@ -0,0 +1,199 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowStructuralDiff.h"
+
+#include "AddOns/FlowNodeAddOn.h"
+#include "FlowAsset.h"
+#include "Nodes/FlowNode.h"
+
+#include "UObject/UnrealType.h"
+
+void FFlowStructuralDiff::DiffAssets(const UFlowAsset& OldAsset, const UFlowAsset& NewAsset, TArray<FFlowStructuralDiffEntry>& OutEntries)
+{
+	const TMap<FGuid, UFlowNode*>& OldNodes = OldAsset.GetNodes();
+	const TMap<FGuid, UFlowNode*>& NewNodes = NewAsset.GetNodes();
+
+	TArray<FGuid> NodeGuids;
+	NodeGuids.Reserve(FMath::Max(OldNodes.Num(), NewNodes.Num()));
+	OldNodes.GetKeys(NodeGuids);
+	for (const TPair<FGuid, UFlowNode*>& NewNode : NewNodes)
+	{
+		if (!OldNodes.Contains(NewNode.Key))
+		{
+			NodeGuids.Add(NewNode.Key);
+		}
+	}
+	NodeGuids.Sort();
+
+	for (const FGuid& NodeGuid : NodeGuids)
+	{
+		const UFlowNode* OldNode = OldNodes.FindRef(NodeGuid);
+		const UFlowNode* NewNode = NewNodes.FindRef(NodeGuid);
+
+		if (!IsValid(OldNode) && !IsValid(NewNode))
+		{
+			continue;
+		}
+
+		if (!IsValid(OldNode))
+		{
+			FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.Type = EFlowStructuralDiffType::NodeAdded;
+			Entry.NodeGuid = NodeGuid;
+			continue;
+		}
+
+		if (!IsValid(NewNode))
+		{
+			FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.Type = EFlowStructuralDiffType::NodeRemoved;
+			Entry.NodeGuid = NodeGuid;
+			continue;
+		}
+
+		DiffNodes(NodeGuid, *OldNode, *NewNode, OutEntries);
+		DiffConnections(NodeGuid, OldNode->GetConnections(), NewNode->GetConnections(), OutEntries);
+	}
+}
+
+void FFlowStructuralDiff::GetChangedNodes(const TArray<FFlowStructuralDiffEntry>& Entries, TSet<FGuid>& OutNodeGuids)
+{
+	for (const FFlowStructuralDiffEntry& Entry : Entries)
+	{
+		OutNodeGuids.Add(Entry.NodeGuid);
+	}
+}
+
+bool FFlowStructuralDiff::FindChangedProperties(const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, TArray<FName>& OutPropertyNames, const bool bStopOnFirst)
+{
+	check(OldNode.GetClass() == NewNode.GetClass());
+
+	bool bChanged = false;
+	for (TFieldIterator<FProperty> PropIt(OldNode.GetClass()); PropIt; ++PropIt)
+	{
+		const FProperty* Property = *PropIt;
+		if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_Transient))
+		{
+			continue;
+		}
+
+		if (!Property->Identical_InContainer(&OldNode, &NewNode, 0, PPF_DeepComparison))
+		{
+			OutPropertyNames.Add(Property->GetFName());
+			bChanged = true;
+
+			if (bStopOnFirst)
+			{
+				break;
+			}
+		}
+	}
+
+	return bChanged;
+}
+
+void FFlowStructuralDiff::DiffNodes(const FGuid& NodeGuid, const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, TArray<FFlowStructuralDiffEntry>& OutEntries)
+{
+	if (OldNode.GetClass() != NewNode.GetClass())
+	{
+		FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Type = EFlowStructuralDiffType::NodeClassChanged;
+		Entry.NodeGuid = NodeGuid;
+		return;
+	}
+
+	TArray<FName> ChangedProperties;
+	FindChangedProperties(OldNode, NewNode, ChangedProperties);
+	for (const FName& PropertyName : ChangedProperties)
+	{
+		FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Type = EFlowStructuralDiffType::PropertyChanged;
+		Entry.NodeGuid = NodeGuid;
+		Entry.PropertyName = PropertyName;
+	}
+
+	FName AddOnPropertyName;
+	if (!AreAddOnsIdentical(OldNode, NewNode, AddOnPropertyName))
+	{
+		FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Type = EFlowStructuralDiffType::AddOnsChanged;
+		Entry.NodeGuid = NodeGuid;
+		Entry.PropertyName = AddOnPropertyName;
+	}
+}
+
+void FFlowStructuralDiff::DiffConnections(const FGuid& NodeGuid, const TMap<FName, FConnectedPin>& OldConnections, const TMap<FName, FConnectedPin>& NewConnections, TArray<FFlowStructuralDiffEntry>& OutEntries)
+{
+	TArray<FName> PinNames;
+	OldConnections.GetKeys(PinNames);
+	for (const TPair<FName, FConnectedPin>& NewConnection : NewConnections)
+	{
+		if (!OldConnections.Contains(NewConnection.Key))
+		{
+			PinNames.Add(NewConnection.Key);
+		}
+	}
+	PinNames.Sort(FNameLexicalLess());
+
+	for (const FName& PinName : PinNames)
+	{
+		const FConnectedPin OldConnection = OldConnections.FindRef(PinName);
+		const FConnectedPin NewConnection = NewConnections.FindRef(PinName);
+
+		if (!(OldConnection == NewConnection))
+		{
+			FFlowStructuralDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.Type = EFlowStructuralDiffType::ConnectionChanged;
+			Entry.NodeGuid = NodeGuid;
+			Entry.PinName = PinName;
+			Entry.OldConnection = OldConnection;
+			Entry.NewConnection = NewConnection;
+		}
+	}
+}
+
+bool FFlowStructuralDiff::AreAddOnsIdentical(const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, FName& OutPropertyName)
+{
+	const TArray<UFlowNodeAddOn*>& OldAddOns = OldNode.GetFlowNodeAddOnChildren();
+	const TArray<UFlowNodeAddOn*>& NewAddOns = NewNode.GetFlowNodeAddOnChildren();
+
+	if (OldAddOns.Num() != NewAddOns.Num())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < OldAddOns.Num(); Index++)
+	{
+		const UFlowNodeAddOn* OldAddOn = OldAddOns[Index];
+		const UFlowNodeAddOn* NewAddOn = NewAddOns[Index];
+
+		if (!IsValid(OldAddOn) || !IsValid(NewAddOn))
+		{
+			if (IsValid(OldAddOn) != IsValid(NewAddOn))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (OldAddOn->GetClass() != NewAddOn->GetClass())
+		{
+			return false;
+		}
+
+		TArray<FName> ChangedProperties;
+		if (FindChangedProperties(*OldAddOn, *NewAddOn, ChangedProperties, true))
+		{
+			OutPropertyName = ChangedProperties[0];
+			return false;
+		}
+
+		// AddOns can have own AddOns
+		if (!AreAddOnsIdentical(*OldAddOn, *NewAddOn, OutPropertyName))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -407,6 +407,8 @@ void SFlowDiff::OnDiffListSelectionChanged(TSharedPtr<FFlowObjectDiffArgs> FlowO
 		return;
 	}
 
+	FlowObjectDiff->CreateDetailsViews();
+
 	check(!FlowObjectDiff->DiffResult->Result.OwningObjectPath.IsEmpty());
 	FocusOnGraphRevisions(FindGraphToDiffEntry(FlowObjectDiff->DiffResult->Result.OwningObjectPath));
 
@@ -0,0 +1,120 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowImportBlueprintsCommandlet.h"
+#include "FlowAsset.h"
+#include "FlowEditorLogChannels.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowImportBlueprintsCommandlet)
+
+UFlowImportBlueprintsCommandlet::UFlowImportBlueprintsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowImportBlueprintsCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const FString* PathsParam = ParamsMap.Find(TEXT("Paths"));
+	if (PathsParam == nullptr || PathsParam->IsEmpty())
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Missing -Paths= parameter, i.e. -Paths=/Game/Legacy+/Game/Quests"));
+		return 1;
+	}
+
+	FFlowBatchImportParams ImportParams;
+	ImportParams.FlowAssetClass = UFlowAsset::StaticClass();
+
+	if (const FString* ClassParam = ParamsMap.Find(TEXT("FlowAssetClass")))
+	{
+		UClass* FlowAssetClass = LoadObject<UClass>(nullptr, **ClassParam);
+		if (FlowAssetClass == nullptr || !FlowAssetClass->IsChildOf(UFlowAsset::StaticClass()))
+		{
+			UE_LOG(LogFlowEditor, Error, TEXT("%s isn't a Flow Asset class"), **ClassParam);
+			return 1;
+		}
+		ImportParams.FlowAssetClass = FlowAssetClass;
+	}
+
+	if (const FString* PrefixParam = ParamsMap.Find(TEXT("Prefix")))
+	{
+		ImportParams.FlowAssetPrefix = *PrefixParam;
+	}
+
+	if (const FString* StartEventParam = ParamsMap.Find(TEXT("StartEvent")))
+	{
+		ImportParams.StartEventName = **StartEventParam;
+	}
+
+	if (const FString* PrefetchParam = ParamsMap.Find(TEXT("Prefetch")))
+	{
+		ImportParams.PrefetchCount = FCString::Atoi(**PrefetchParam);
+	}
+
+	if (const FString* GCIntervalParam = ParamsMap.Find(TEXT("GCInterval")))
+	{
+		ImportParams.GarbageCollectionInterval = FCString::Atoi(**GCIntervalParam);
+	}
+
+	const FString* ProgressFileParam = ParamsMap.Find(TEXT("ProgressFile"));
+	ImportParams.ProgressFilePath = ProgressFileParam ? *ProgressFileParam : FPaths::ProjectSavedDir() / TEXT("FlowImport") / (ImportParams.FlowAssetPrefix + TEXT("Progress.txt"));
+
+	if (Switches.Contains(TEXT("Restart")))
+	{
+		IFileManager::Get().Delete(*ImportParams.ProgressFilePath);
+	}
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+
+	TArray<FString> Paths;
+	PathsParam->ParseIntoArray(Paths, TEXT("+"));
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	ImportParams.Blueprints.Reserve(Assets.Num());
+	for (const FAssetData& AssetData : Assets)
+	{
+		ImportParams.Blueprints.Add(AssetData.GetSoftObjectPath());
+	}
+
+	TMap<FName, TSubclassOf<UFlowNode>> FunctionsToFlowNodes;
+	TMap<TSubclassOf<UFlowNode>, FBlueprintToFlowPinName> PinMappings;
+	GetImportMappings(FunctionsToFlowNodes, PinMappings);
+
+	if (FunctionsToFlowNodes.IsEmpty())
+	{
+		UE_LOG(LogFlowEditor, Warning, TEXT("No function mappings provided, only Start nodes will be created. Override GetImportMappings in a subclass of this commandlet."));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FFlowBatchImportResult Result = UFlowImportUtils::ImportBlueprintGraphs(ImportParams, FunctionsToFlowNodes, PinMappings);
+	UE_LOG(LogFlowEditor, Display, TEXT("Import finished in %.2f s, progress stored in %s"), FPlatformTime::Seconds() - StartTime, *ImportParams.ProgressFilePath);
+
+	return Result.Failed > 0 || Result.bCancelled ? 1 : 0;
+}
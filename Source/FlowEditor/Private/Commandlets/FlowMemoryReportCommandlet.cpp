@@ -0,0 +1,231 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowMemoryReportCommandlet.h"
+#include "Asset/FlowAssetDependencies.h"
+#include "Asset/FlowAssetOptimizer.h"
+#include "AddOns/FlowNodeAddOn.h"
+#include "FlowAsset.h"
+#include "FlowEditorLogChannels.h"
+#include "FlowSettings.h"
+#include "Nodes/FlowNode.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowMemoryReportCommandlet)
+
+namespace FlowMemoryReport
+{
+	struct FAssetReport
+	{
+		FString ObjectPath;
+
+		int32 NodesNum = 0;
+		int32 PinsNum = 0;
+		int32 ConnectionsNum = 0;
+		int32 AddOnsNum = 0;
+
+		// Template keeps the compiled graph shared by all instances
+		SIZE_T TemplateBytes = 0;
+		SIZE_T InstanceBytes = 0;
+		SIZE_T CompiledGraphBytes = 0;
+
+		// Content soft-referenced by nodes, including Sub Graphs and their content
+		int32 ContentDependenciesNum = 0;
+		int64 ContentDiskBytes = 0;
+	};
+
+	const TCHAR* SortColumns[] = {TEXT("Instance"), TEXT("Template"), TEXT("CompiledGraph"), TEXT("Content")};
+
+	int64 GetSortValue(const FAssetReport& Report, const int32 SortColumn)
+	{
+		switch (SortColumn)
+		{
+			case 1:
+				return Report.TemplateBytes;
+			case 2:
+				return Report.CompiledGraphBytes;
+			case 3:
+				return Report.ContentDiskBytes;
+			default:
+				return Report.InstanceBytes;
+		}
+	}
+
+	FAssetReport MeasureAsset(UFlowAsset& FlowAsset, const IAssetRegistry& AssetRegistry)
+	{
+		FAssetReport Report;
+		Report.ObjectPath = FlowAsset.GetPathName();
+
+		// the cooked asset is optimized by the cooker, the report doesn't save it
+		if (UFlowSettings::Get()->bOptimizeGraphsOnCook)
+		{
+			FFlowAssetOptimizer::OptimizeForCook(FlowAsset);
+		}
+
+		TMap<FGuid, TObjectPtr<UFlowNode>> Nodes;
+		for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset.GetNodes())
+		{
+			if (!IsValid(Node.Value))
+			{
+				continue;
+			}
+
+			Nodes.Add(Node.Key, Node.Value);
+
+			Report.NodesNum++;
+			Report.PinsNum += Node.Value->GetInputPins().Num() + Node.Value->GetOutputPins().Num();
+			Report.ConnectionsNum += Node.Value->GetConnections().Num();
+
+			(void) Node.Value->ForEachAddOnConst([&Report](const UFlowNodeAddOn& AddOn)
+			{
+				Report.AddOnsNum++;
+				return EFlowForEachAddOnFunctionReturnValue::Continue;
+			});
+		}
+
+		// instances are created from the template, so the template nodes estimate the instance
+		FResourceSizeEx InstanceSize(EResourceSizeMode::EstimatedTotal);
+		FlowAsset.GetResourceSizeEx(InstanceSize);
+		Report.InstanceBytes = FlowAsset.GetClass()->GetStructureSize() + InstanceSize.GetTotalMemoryBytes();
+
+		// cooked templates load the compiled graph with the package
+		FFlowCompiledGraph CompiledGraph;
+		CompiledGraph.Compile(Nodes);
+		Report.CompiledGraphBytes = sizeof(FFlowCompiledGraph) + CompiledGraph.GetAllocatedSize();
+		Report.TemplateBytes = Report.InstanceBytes + Report.CompiledGraphBytes;
+
+		TArray<FSoftObjectPath> ContentPaths;
+		FFlowAssetDependencies::GatherContentDependencies(FlowAsset, ContentPaths);
+		Report.ContentDependenciesNum = ContentPaths.Num();
+
+		// many assets live in a single package, i.e. Level Sequence and its bindings
+		TSet<FName> ContentPackages;
+		for (const FSoftObjectPath& Path : ContentPaths)
+		{
+			ContentPackages.Add(Path.GetLongPackageFName());
+		}
+
+		for (const FName& PackageName : ContentPackages)
+		{
+			const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+			if (PackageData.IsSet())
+			{
+				Report.ContentDiskBytes += FMath::Max<int64>(PackageData->DiskSize, 0);
+			}
+		}
+
+		return Report;
+	}
+}
+
+UFlowMemoryReportCommandlet::UFlowMemoryReportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowMemoryReportCommandlet::Main(const FString& Params)
+{
+	using namespace FlowMemoryReport;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	int32 SortColumn = 0;
+	if (const FString* SortParam = ParamsMap.Find(TEXT("SortBy")))
+	{
+		for (int32 ColumnIndex = 0; ColumnIndex < UE_ARRAY_COUNT(SortColumns); ++ColumnIndex)
+		{
+			if (SortParam->Equals(SortColumns[ColumnIndex], ESearchCase::IgnoreCase))
+			{
+				SortColumn = ColumnIndex;
+			}
+		}
+	}
+
+	const int64 InstanceBudgetBytes = ParamsMap.Contains(TEXT("InstanceBudgetKB")) ? FCString::Atoi64(*ParamsMap[TEXT("InstanceBudgetKB")]) * 1024 : 0;
+	const int64 ContentBudgetBytes = ParamsMap.Contains(TEXT("ContentBudgetMB")) ? FCString::Atoi64(*ParamsMap[TEXT("ContentBudgetMB")]) * 1024 * 1024 : 0;
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UFlowAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	if (const FString* PathsParam = ParamsMap.Find(TEXT("Paths")))
+	{
+		TArray<FString> Paths;
+		PathsParam->ParseIntoArray(Paths, TEXT("+"));
+		for (const FString& Path : Paths)
+		{
+			Filter.PackagePaths.Add(*Path);
+		}
+		Filter.bRecursivePaths = true;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Measuring %d Flow Assets..."), Assets.Num());
+
+	TArray<FAssetReport> Reports;
+	Reports.Reserve(Assets.Num());
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+		if (FlowAsset == nullptr)
+		{
+			UE_LOG(LogFlowEditor, Error, TEXT("%s: failed to load the asset"), *AssetData.GetObjectPathString());
+			continue;
+		}
+
+		Reports.Add(MeasureAsset(*FlowAsset, AssetRegistry));
+	}
+
+	Reports.Sort([SortColumn](const FAssetReport& A, const FAssetReport& B)
+	{
+		return GetSortValue(A, SortColumn) > GetSortValue(B, SortColumn);
+	});
+
+	int32 OverBudgetAssets = 0;
+	FString Csv = TEXT("Asset,Nodes,Pins,Connections,AddOns,TemplateBytes,InstanceBytes,CompiledGraphBytes,ContentDependencies,ContentDiskBytes,OverBudget") LINE_TERMINATOR;
+
+	for (const FAssetReport& Report : Reports)
+	{
+		const bool bInstanceOverBudget = InstanceBudgetBytes > 0 && static_cast<int64>(Report.InstanceBytes) > InstanceBudgetBytes;
+		const bool bContentOverBudget = ContentBudgetBytes > 0 && Report.ContentDiskBytes > ContentBudgetBytes;
+
+		if (bInstanceOverBudget || bContentOverBudget)
+		{
+			OverBudgetAssets++;
+			UE_LOG(LogFlowEditor, Error, TEXT("%s: over budget, instance %.1f KB, content %.1f MB"), *Report.ObjectPath,
+				Report.InstanceBytes / 1024.0, Report.ContentDiskBytes / (1024.0 * 1024.0));
+		}
+
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%llu,%llu,%llu,%d,%lld,%s") LINE_TERMINATOR, *Report.ObjectPath,
+			Report.NodesNum, Report.PinsNum, Report.ConnectionsNum, Report.AddOnsNum,
+			static_cast<uint64>(Report.TemplateBytes), static_cast<uint64>(Report.InstanceBytes), static_cast<uint64>(Report.CompiledGraphBytes),
+			Report.ContentDependenciesNum, Report.ContentDiskBytes,
+			bInstanceOverBudget ? TEXT("Instance") : (bContentOverBudget ? TEXT("Content") : TEXT("")));
+	}
+
+	const FString* OutputParam = ParamsMap.Find(TEXT("Output"));
+	const FString FilePath = OutputParam ? *OutputParam : FPaths::ProfilingDir() / TEXT("Flow") / FString::Printf(TEXT("FlowMemoryReport-%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Failed to write the report to %s"), *FilePath);
+		return 1;
+	}
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Measured %d Flow Assets sorted by %s, %d over budget, report saved to %s"), Reports.Num(), SortColumns[SortColumn], OverBudgetAssets, *FilePath);
+
+	return OverBudgetAssets > 0 ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowValidateAssetsCommandlet.h"
+#include "Graph/FlowGraph.h"
+#include "FlowAsset.h"
+#include "FlowEditorLogChannels.h"
+#include "FlowMessageLog.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/PlatformTime.h"
+#include "Logging/TokenizedMessage.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowValidateAssetsCommandlet)
+
+UFlowValidateAssetsCommandlet::UFlowValidateAssetsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowValidateAssetsCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const bool bWarningsAsErrors = Switches.Contains(TEXT("WarningsAsErrors"));
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UFlowAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	if (const FString* PathsParam = ParamsMap.Find(TEXT("Paths")))
+	{
+		TArray<FString> Paths;
+		PathsParam->ParseIntoArray(Paths, TEXT("+"));
+		for (const FString& Path : Paths)
+		{
+			Filter.PackagePaths.Add(*Path);
+		}
+		Filter.bRecursivePaths = true;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Validating %d Flow Assets..."), Assets.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LoadTime = 0.0;
+	int32 InvalidAssets = 0;
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		const double AssetStartTime = FPlatformTime::Seconds();
+		UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+		const double AssetLoadedTime = FPlatformTime::Seconds();
+		LoadTime += AssetLoadedTime - AssetStartTime;
+
+		UFlowGraph* FlowGraph = FlowAsset ? Cast<UFlowGraph>(FlowAsset->GetGraph()) : nullptr;
+		if (FlowGraph == nullptr)
+		{
+			UE_LOG(LogFlowEditor, Error, TEXT("%s: failed to load the asset or its graph"), *AssetData.GetObjectPathString());
+			InvalidAssets++;
+			continue;
+		}
+
+		FFlowMessageLog MessageLog;
+		FlowGraph->ValidateAsset(MessageLog);
+
+		bool bInvalid = false;
+		for (const TSharedRef<FTokenizedMessage>& Message : MessageLog.Messages)
+		{
+			const EMessageSeverity::Type Severity = Message->GetSeverity();
+			if (Severity == EMessageSeverity::Error || (bWarningsAsErrors && Severity == EMessageSeverity::Warning))
+			{
+				bInvalid = true;
+				UE_LOG(LogFlowEditor, Error, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Message->ToText().ToString());
+			}
+			else if (Severity == EMessageSeverity::Warning || Severity == EMessageSeverity::PerformanceWarning)
+			{
+				UE_LOG(LogFlowEditor, Warning, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Message->ToText().ToString());
+			}
+			else
+			{
+				UE_LOG(LogFlowEditor, Display, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Message->ToText().ToString());
+			}
+		}
+
+		if (bInvalid)
+		{
+			InvalidAssets++;
+		}
+
+		UE_LOG(LogFlowEditor, Display, TEXT("%s: %s, loaded in %.2f ms, validated in %.2f ms"), *AssetData.GetObjectPathString(),
+			bInvalid ? TEXT("invalid") : TEXT("valid"),
+			(AssetLoadedTime - AssetStartTime) * 1000.0,
+			(FPlatformTime::Seconds() - AssetLoadedTime) * 1000.0);
+	}
+
+	const double TotalTime = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogFlowEditor, Display, TEXT("Validated %d Flow Assets in %.2f s (loading %.2f s), %d invalid"), Assets.Num(), TotalTime, LoadTime, InvalidAssets);
+
+	return InvalidAssets > 0 ? 1 : 0;
+}
@@ -11,4 +11,26 @@ void FFlowNode_ComponentObserverDetails::CustomizeDetails(IDetailLayoutBuilder&
 	IDetailCategoryBuilder& SequenceCategory = DetailBuilder.EditCategory("ObservedComponent");
 	SequenceCategory.AddProperty(GET_MEMBER_NAME_CHECKED(UFlowNode_ComponentObserver, IdentityTags));
 	SequenceCategory.AddProperty(GET_MEMBER_NAME_CHECKED(UFlowNode_ComponentObserver, IdentityMatchType));
+
+	TArray<TWeakObjectPtr<UObject>> ObjectsBeingCustomized;
+	DetailBuilder.GetObjectsBeingCustomized(ObjectsBeingCustomized);
+
+	bool bSupportsTagQuery = true;
+	for (const TWeakObjectPtr<UObject>& Object : ObjectsBeingCustomized)
+	{
+		if (const UFlowNode_ComponentObserver* Observer = Cast<UFlowNode_ComponentObserver>(Object.Get()))
+		{
+			bSupportsTagQuery &= Observer->SupportsIdentityTagQuery();
+		}
+	}
+
+	const TSharedRef<IPropertyHandle> TagQueryHandle = DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(UFlowNode_ComponentObserver, IdentityTagQuery));
+	if (bSupportsTagQuery)
+	{
+		SequenceCategory.AddProperty(TagQueryHandle);
+	}
+	else
+	{
+		DetailBuilder.HideProperty(TagQueryHandle);
+	}
 }
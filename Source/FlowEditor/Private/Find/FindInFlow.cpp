@@ -10,12 +10,14 @@
 #include "Nodes/FlowNode.h"
 #include "Nodes/Graph/FlowNode_SubGraph.h"
 
+#include "Async/Async.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/Views/ITypedTableView.h"
 #include "GraphEditor.h"
 #include "HAL/PlatformMath.h"
+#include "IAssetSearchModule.h"
 #include "Input/Events.h"
 #include "Internationalization/Internationalization.h"
 #include "Layout/Children.h"
@@ -58,6 +60,11 @@ FFindInFlowResult::FFindInFlowResult(const FString& InValue, TSharedPtr<FFindInF
 {
 }
 
+FFindInFlowResult::FFindInFlowResult(const FString& InValue, TSharedPtr<FFindInFlowResult>& InParent, const FSoftObjectPath& InAssetPath, const FString& InObjectPath, const FString& InPropertyName)
+	: Value(InValue), GraphNode(nullptr), Parent(InParent), AssetPath(InAssetPath), ObjectPath(InObjectPath), PropertyName(InPropertyName)
+{
+}
+
 TSharedRef<SWidget> FFindInFlowResult::CreateIcon() const
 {
 	const FSlateColor IconColor = FSlateColor::UseForeground();
@@ -87,6 +94,12 @@ FReply FFindInFlowResult::OnClick(TWeakPtr<class FFlowAssetEditor> FlowAssetEdit
 
 FReply FFindInFlowResult::OnDoubleClick(TSharedPtr<FFindInFlowResult> Root) const
 {
+	if (AssetPath.IsValid())
+	{
+		OpenProjectResult();
+		return FReply::Handled();
+	}
+
 	if (!Parent.IsValid() || !bIsSubGraphNode)
 	{
 		return FReply::Handled();
@@ -115,6 +128,32 @@ FReply FFindInFlowResult::OnDoubleClick(TSharedPtr<FFindInFlowResult> Root) cons
 	return FReply::Handled();
 }
 
+void FFindInFlowResult::OpenProjectResult() const
+{
+	UObject* Asset = AssetPath.TryLoad();
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if (Asset == nullptr || !AssetEditorSubsystem->OpenEditorForAsset(Asset))
+	{
+		return;
+	}
+
+	// indexed objects are graph nodes or their flow nodes
+	const UObject* IndexedObject = ObjectPath.IsEmpty() ? nullptr : FindObject<UObject>(nullptr, *ObjectPath);
+	const UEdGraphNode* IndexedGraphNode = Cast<UEdGraphNode>(IndexedObject);
+	if (const UFlowNodeBase* FlowNodeBase = Cast<UFlowNodeBase>(IndexedObject))
+	{
+		IndexedGraphNode = FlowNodeBase->GetGraphNode();
+	}
+
+	if (IndexedGraphNode)
+	{
+		if (const TSharedPtr<FFlowAssetEditor> FlowAssetEditor = FFlowGraphUtils::GetFlowAssetEditor(IndexedGraphNode->GetGraph()))
+		{
+			FlowAssetEditor->JumpToNode(IndexedGraphNode);
+		}
+	}
+}
+
 FString FFindInFlowResult::GetDescriptionText() const
 {
 	if (const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(GraphNode.Get()))
@@ -160,11 +199,16 @@ FString FFindInFlowResult::GetNodeTypeText() const
 		}
 	}
 
-	return FString();
+	return PropertyName;
 }
 
 FText FFindInFlowResult::GetToolTipText() const
 {
+	if (AssetPath.IsValid())
+	{
+		return FText::FromString(TEXT("Double click to open the asset and focus on the node."));
+	}
+
 	FString ToolTipStr = TEXT("Click to focus on nodes.");
 	if (bIsSubGraphNode)
 	{
@@ -210,6 +254,21 @@ void SFindInFlow::Construct( const FArguments& InArgs, TSharedPtr<FFlowAssetEdit
 					.OnCheckStateChanged(this, &SFindInFlow::OnFindInSubGraphStateChanged)
 					.ToolTipText(LOCTEXT("FlowEditorSubGraphSearchHint", "Checkin means search also in sub graph."))
 				]
+				+SHorizontalBox::Slot()
+				.Padding(10,0,5,0)
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("FlowEditorProjectSearchText", "Find In Project "))
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SCheckBox)
+					.OnCheckStateChanged(this, &SFindInFlow::OnFindInProjectStateChanged)
+					.ToolTipText(LOCTEXT("FlowEditorProjectSearchHint", "Checkin means search all Flow Assets indexed by the Asset Search plugin, results arrive asynchronously."))
+				]
 			]
 			+SVerticalBox::Slot()
 			.FillHeight(1.0f)
@@ -262,16 +321,33 @@ void SFindInFlow::InitiateSearch()
 		TreeView->SetItemExpansion(*It, false);
 	}
 	ItemsFound.Empty();
+
+	if (bFindInProject && Tokens.Num() > 0)
+	{
+		HighlightText = FText::FromString(SearchValue);
+		StartProjectSearch();
+		RefreshTree(LOCTEXT("FlowEditorSearchInProgress", "Searching..."));
+		return;
+	}
+
+	// results of the pending project query won't be needed
+	ProjectQueryId++;
+
 	if (Tokens.Num() > 0)
 	{
 		HighlightText = FText::FromString(SearchValue);
 		MatchTokens(Tokens);
 	}
 
+	RefreshTree(LOCTEXT("FlowEditorSearchNoResults", "No Results found"));
+}
+
+void SFindInFlow::RefreshTree(const FText& EmptyResultsText)
+{
 	// Insert a fake result to inform user if none found
 	if (ItemsFound.Num() == 0)
 	{
-		ItemsFound.Add(MakeShared<FFindInFlowResult>(LOCTEXT("FlowEditorSearchNoResults", "No Results found").ToString()));
+		ItemsFound.Add(MakeShared<FFindInFlowResult>(EmptyResultsText.ToString()));
 	}
 
 	TreeView->RequestTreeRefresh();
@@ -336,6 +412,74 @@ void SFindInFlow::MatchTokens(const TArray<FString>& Tokens)
 	}
 }
 
+void SFindInFlow::StartProjectSearch()
+{
+	const uint32 QueryId = ++ProjectQueryId;
+	const TWeakPtr<SFindInFlow> WeakThis = StaticCastSharedRef<SFindInFlow>(AsShared());
+
+	// the index is queried on a background thread, so typing doesn't block the editor
+	const FSearchQueryPtr Query = MakeShared<FSearchQuery, ESPMode::ThreadSafe>(SearchValue);
+	Query->SetResultsCallback([WeakThis, QueryId](TArray<FSearchRecord>&& Records)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, QueryId, Records = MoveTemp(Records)]() mutable
+		{
+			if (const TSharedPtr<SFindInFlow> FindInFlow = WeakThis.Pin())
+			{
+				FindInFlow->OnProjectSearchResults(MoveTemp(Records), QueryId);
+			}
+		});
+	});
+
+	IAssetSearchModule::Get().Search(Query);
+}
+
+void SFindInFlow::OnProjectSearchResults(TArray<FSearchRecord>&& Records, const uint32 QueryId)
+{
+	if (QueryId != ProjectQueryId)
+	{
+		return;
+	}
+
+	for (auto It(ItemsFound.CreateIterator()); It; ++It)
+	{
+		TreeView->SetItemExpansion(*It, false);
+	}
+	ItemsFound.Empty();
+
+	RootSearchResult = MakeShared<FFindInFlowResult>(FString("FlowEditorRoot"));
+
+	// the index contains all asset types, class names are resolved once per query
+	TMap<FString, bool> FlowAssetClasses;
+	TMap<FString, FSearchResult> AssetResults;
+
+	for (const FSearchRecord& Record : Records)
+	{
+		const bool* bFlowAssetClass = FlowAssetClasses.Find(Record.AssetClass);
+		if (bFlowAssetClass == nullptr)
+		{
+			const UClass* AssetClass = UClass::TryFindTypeSlow<UClass>(Record.AssetClass);
+			bFlowAssetClass = &FlowAssetClasses.Add(Record.AssetClass, AssetClass && AssetClass->IsChildOf<UFlowAsset>());
+		}
+
+		if (!*bFlowAssetClass)
+		{
+			continue;
+		}
+
+		const FSoftObjectPath AssetPath(Record.AssetPath);
+		FSearchResult& AssetResult = AssetResults.FindOrAdd(Record.AssetPath);
+		if (!AssetResult.IsValid())
+		{
+			AssetResult = MakeShared<FFindInFlowResult>(Record.AssetName, RootSearchResult, AssetPath, FString(), FString());
+			ItemsFound.Add(AssetResult);
+		}
+
+		AssetResult->Children.Add(MakeShared<FFindInFlowResult>(Record.Text, AssetResult, AssetPath, Record.ObjectPath, Record.PropertyName));
+	}
+
+	RefreshTree(LOCTEXT("FlowEditorSearchNoResults", "No Results found"));
+}
+
 void SFindInFlow::MatchTokensInChild(const TArray<FString>& Tokens, UEdGraphNode* Child, FSearchResult ParentNode)
 {
 	if (Child == nullptr)
@@ -442,6 +586,12 @@ void SFindInFlow::OnFindInSubGraphStateChanged(ECheckBoxState CheckBoxState)
 	InitiateSearch();
 }
 
+void SFindInFlow::OnFindInProjectStateChanged(ECheckBoxState CheckBoxState)
+{
+	bFindInProject = CheckBoxState == ECheckBoxState::Checked;
+	InitiateSearch();
+}
+
 bool SFindInFlow::StringMatchesSearchTokens(const TArray<FString>& Tokens, const FString& ComparisonString)
 {
 	bool bFoundAllTokens = true;
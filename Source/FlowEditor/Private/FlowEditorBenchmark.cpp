@@ -0,0 +1,345 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowAssetEditor.h"
+#include "Asset/FlowStructuralDiff.h"
+#include "Asset/SFlowDiff.h"
+#include "Find/FindInFlow.h"
+#include "FlowEditorLogChannels.h"
+#include "Graph/FlowGraph.h"
+#include "Graph/FlowGraphSchema.h"
+#include "Graph/FlowGraphSchema_Actions.h"
+#include "Graph/Nodes/FlowGraphNode.h"
+
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Developer/FlowNode_Log.h"
+#include "Nodes/FlowNodeBlueprint.h"
+#include "Nodes/Route/FlowNode_Branch.h"
+#include "Nodes/Route/FlowNode_ExecutionSequence.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "IAssetTypeActions.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ScopedTransaction.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Toolkits/ToolkitManager.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define LOCTEXT_NAMESPACE "FlowEditorBenchmark"
+
+/**
+ * Times editor operations on synthetic Flow Assets and node Blueprints, results are written as CSV to compare plugin versions
+ * Friend of UFlowGraphSchema and SFindInFlow, so the cold palette and the search run without user input
+ */
+struct FFlowEditorBenchmark
+{
+	struct FSample
+	{
+		FString Scenario;
+
+		// Nodes, node Blueprints or root instances, depending on the scenario
+		int32 Count = 0;
+
+		int32 Iteration = 0;
+		double Milliseconds = 0.0;
+	};
+
+	int32 NodesNum = 1000;
+	int32 BlueprintsNum = 200;
+	int32 Iterations = 3;
+
+	TArray<FSample> Samples;
+	TArray<TStrongObjectPtr<UObject>> KeepAlive;
+
+	template <typename FunctionType>
+	void Measure(const TCHAR* Scenario, const int32 Count, const int32 Iteration, FunctionType&& Function)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Function();
+		Samples.Add({Scenario, Count, Iteration, (FPlatformTime::Seconds() - StartTime) * 1000.0});
+	}
+
+	static UPackage* CreateBenchmarkPackage(const FString& Name)
+	{
+		UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Temp/FlowEditorBenchmark/%s"), *Name));
+		Package->SetFlags(RF_Transient);
+		return Package;
+	}
+
+	// Long chain of Log nodes, with Branch and Sequence nodes every few nodes, so there are properties to diff and search
+	UFlowAsset* CreateAsset(const FString& Name)
+	{
+		UFlowAsset* Asset = NewObject<UFlowAsset>(CreateBenchmarkPackage(Name), FName(*Name), RF_Public | RF_Standalone | RF_Transient);
+		KeepAlive.Emplace(Asset);
+
+		UFlowGraph::CreateGraph(Asset);
+		UEdGraph* Graph = Asset->GetGraph();
+
+		UEdGraphNode* PreviousNode = Graph->Nodes.IsEmpty() ? nullptr : Graph->Nodes[0];
+		for (int32 Index = 0; Index < NodesNum; Index++)
+		{
+			const UClass* NodeClass = Index % 10 == 0 ? UFlowNode_Branch::StaticClass() : (Index % 10 == 5 ? UFlowNode_ExecutionSequence::StaticClass() : UFlowNode_Log::StaticClass());
+			const FVector2D Location((Index % 50) * 320.0, (Index / 50) * 200.0);
+
+			UEdGraphPin* FromPin = PreviousNode ? UFlowGraph::FindGraphNodePin(PreviousNode, EGPD_Output) : nullptr;
+			PreviousNode = FFlowGraphSchemaAction_NewNode::CreateNode(Graph, FromPin, NodeClass, Location, false);
+		}
+
+		Asset->HarvestNodeConnections();
+		return Asset;
+	}
+
+	// Every tenth Log node gets a different message
+	UFlowAsset* CreateModifiedCopy(UFlowAsset* Asset, const FString& Name)
+	{
+		UFlowAsset* Copy = DuplicateObject<UFlowAsset>(Asset, CreateBenchmarkPackage(Name), FName(*Name));
+		KeepAlive.Emplace(Copy);
+
+		const FStrProperty* MessageProperty = FindFProperty<FStrProperty>(UFlowNode_Log::StaticClass(), TEXT("Message"));
+		int32 LogIndex = 0;
+		for (const TPair<FGuid, UFlowNode*>& Node : Copy->GetNodes())
+		{
+			if (MessageProperty && Node.Value && Node.Value->IsA<UFlowNode_Log>() && LogIndex++ % 10 == 0)
+			{
+				MessageProperty->SetPropertyValue_InContainer(Node.Value, FString::Printf(TEXT("Modified %d"), LogIndex));
+			}
+		}
+
+		return Copy;
+	}
+
+	TArray<UBlueprint*> CreateNodeBlueprints()
+	{
+		TArray<UBlueprint*> Blueprints;
+		for (int32 Index = 0; Index < BlueprintsNum; Index++)
+		{
+			const FString Name = FString::Printf(TEXT("FlowBenchmarkNode_%d"), Index);
+			UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(UFlowNode::StaticClass(), CreateBenchmarkPackage(Name), FName(*Name), BPTYPE_Normal, UFlowNodeBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass(), NAME_None);
+			if (Blueprint)
+			{
+				Blueprint->SetFlags(RF_Transient);
+				FAssetRegistryModule::AssetCreated(Blueprint);
+				Blueprints.Add(Blueprint);
+			}
+		}
+		return Blueprints;
+	}
+
+	static void DestroyNodeBlueprints(const TArray<UBlueprint*>& Blueprints)
+	{
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			FAssetRegistryModule::AssetDeleted(Blueprint);
+			Blueprint->ClearFlags(RF_Public | RF_Standalone);
+			Blueprint->MarkAsGarbage();
+		}
+	}
+
+	// Same state as the first palette open in the editor session
+	static void ResetGatheredNodes()
+	{
+		UFlowGraphSchema::bInitialGatherPerformed = false;
+		UFlowGraphSchema::NativeFlowNodes.Reset();
+		UFlowGraphSchema::NativeFlowNodeAddOns.Reset();
+		UFlowGraphSchema::BlueprintFlowNodes.Reset();
+		UFlowGraphSchema::BlueprintFlowNodeAddOns.Reset();
+		UFlowGraphSchema::ClearPlaceableNodesCache();
+	}
+
+	void Run()
+	{
+		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+
+		{
+			// transactions of created nodes are gathered here and cancelled, so the user's undo history stays intact
+			FScopedTransaction Transaction(LOCTEXT("FlowEditorBenchmark", "Flow Editor Benchmark"));
+
+			UFlowAsset* Asset = nullptr;
+			Measure(TEXT("CreateGraph"), NodesNum, 0, [&]()
+			{
+				Asset = CreateAsset(TEXT("FlowBenchmarkAsset"));
+			});
+			UFlowAsset* ModifiedAsset = CreateModifiedCopy(Asset, TEXT("FlowBenchmarkAsset_Modified"));
+
+			TArray<UBlueprint*> Blueprints;
+			Measure(TEXT("CreateNodeBlueprints"), BlueprintsNum, 0, [&]()
+			{
+				Blueprints = CreateNodeBlueprints();
+			});
+
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				ResetGatheredNodes();
+				Measure(TEXT("GatherNodes"), BlueprintsNum, Iteration, []()
+				{
+					UFlowGraphSchema::GatherNodes();
+				});
+
+				Measure(TEXT("PaletteActions"), BlueprintsNum, Iteration, [Asset]()
+				{
+					FGraphActionMenuBuilder ActionMenuBuilder;
+					UFlowGraphSchema::GetPaletteActions(ActionMenuBuilder, Asset, FString());
+				});
+
+				Measure(TEXT("OpenEditor"), NodesNum, Iteration, [AssetEditorSubsystem, Asset]()
+				{
+					AssetEditorSubsystem->OpenEditorForAsset(Asset);
+				});
+
+				const TSharedPtr<FFlowAssetEditor> FlowAssetEditor = StaticCastSharedPtr<FFlowAssetEditor>(FToolkitManager::Get().FindEditorForAsset(Asset));
+				if (FlowAssetEditor.IsValid())
+				{
+					const TSharedRef<SFindInFlow> FindInFlow = SNew(SFindInFlow, FlowAssetEditor);
+					FindInFlow->SearchValue = TEXT("Log");
+					Measure(TEXT("FindInFlow"), NodesNum, Iteration, [&FindInFlow]()
+					{
+						FindInFlow->InitiateSearch();
+					});
+				}
+
+				Measure(TEXT("CloseEditor"), NodesNum, Iteration, [AssetEditorSubsystem, Asset]()
+				{
+					AssetEditorSubsystem->CloseAllEditorsForAsset(Asset);
+				});
+
+				Measure(TEXT("StructuralDiff"), NodesNum, Iteration, [Asset, ModifiedAsset]()
+				{
+					TArray<FFlowStructuralDiffEntry> Entries;
+					FFlowStructuralDiff::DiffAssets(*Asset, *ModifiedAsset, Entries);
+				});
+
+				Measure(TEXT("DiffWidget"), NodesNum, Iteration, [Asset, ModifiedAsset]()
+				{
+					SNew(SFlowDiff)
+						.OldFlow(Asset)
+						.NewFlow(ModifiedAsset)
+						.OldRevision(FRevisionInfo::InvalidRevision())
+						.NewRevision(FRevisionInfo::InvalidRevision())
+						.ShowAssetNames(false);
+				});
+			}
+
+			DestroyNodeBlueprints(Blueprints);
+			KeepAlive.Empty();
+
+			Transaction.Cancel();
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		// restores the node list without the benchmark blueprints
+		ResetGatheredNodes();
+		UFlowGraphSchema::GatherNodes();
+	}
+
+	void Report(const TCHAR* Name) const
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("Flow"));
+		const FString Version = Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString();
+
+		FString Csv = TEXT("Version,Scenario,Count,Iteration,Milliseconds") LINE_TERMINATOR;
+		for (const FSample& Sample : Samples)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.3f") LINE_TERMINATOR, *Version, *Sample.Scenario, Sample.Count, Sample.Iteration, Sample.Milliseconds);
+		}
+
+		const FString FilePath = FPaths::ProfilingDir() / TEXT("Flow") / FString::Printf(TEXT("%s-%s.csv"), Name, *FDateTime::Now().ToString());
+		FFileHelper::SaveStringToFile(Csv, *FilePath);
+
+		// the fastest iteration, so the summary isn't skewed by the first iteration warming caches
+		TMap<FString, double> FastestTimes;
+		for (const FSample& Sample : Samples)
+		{
+			double& Fastest = FastestTimes.FindOrAdd(Sample.Scenario, Sample.Milliseconds);
+			Fastest = FMath::Min(Fastest, Sample.Milliseconds);
+		}
+
+		UE_LOG(LogFlowEditor, Display, TEXT("%s: %d nodes, %d node Blueprints, %d iterations, written to %s"), Name, NodesNum, BlueprintsNum, Iterations, *FilePath);
+		for (const TPair<FString, double>& Fastest : FastestTimes)
+		{
+			UE_LOG(LogFlowEditor, Display, TEXT("  %-20s %10.3f ms"), *Fastest.Key, Fastest.Value);
+		}
+	}
+
+	static void RunCommand(const TArray<FString>& Args)
+	{
+		if (GEditor == nullptr || GEditor->PlayWorld)
+		{
+			UE_LOG(LogFlowEditor, Warning, TEXT("Flow.Benchmark.Editor runs only in the editor, outside of PIE"));
+			return;
+		}
+
+		FFlowEditorBenchmark Benchmark;
+		Benchmark.NodesNum = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : Benchmark.NodesNum;
+		Benchmark.BlueprintsNum = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 0) : Benchmark.BlueprintsNum;
+		Benchmark.Iterations = Args.IsValidIndex(2) ? FMath::Max(FCString::Atoi(*Args[2]), 1) : Benchmark.Iterations;
+
+		Benchmark.Run();
+		Benchmark.Report(TEXT("EditorBenchmark"));
+	}
+
+	// PIE starts on the next editor tick, so the time includes the frame between the request and the start
+	static double PIERequestTime;
+	static FDelegateHandle PIEStartedHandle;
+
+	static void RunPIECommand()
+	{
+		if (GEditor == nullptr || GEditor->PlayWorld || PIEStartedHandle.IsValid())
+		{
+			UE_LOG(LogFlowEditor, Warning, TEXT("Flow.Benchmark.EditorPIE runs only in the editor, outside of PIE"));
+			return;
+		}
+
+		PIEStartedHandle = FEditorDelegates::PostPIEStarted.AddStatic(&FFlowEditorBenchmark::OnPostPIEStarted);
+		PIERequestTime = FPlatformTime::Seconds();
+
+		const FRequestPlaySessionParams Params;
+		GEditor->RequestPlaySession(Params);
+	}
+
+	static void OnPostPIEStarted(const bool bIsSimulating)
+	{
+		const double Milliseconds = (FPlatformTime::Seconds() - PIERequestTime) * 1000.0;
+
+		FEditorDelegates::PostPIEStarted.Remove(PIEStartedHandle);
+		PIEStartedHandle.Reset();
+
+		// root flows started by Flow Components and World Settings on BeginPlay
+		const UGameInstance* GameInstance = GEditor->PlayWorld ? GEditor->PlayWorld->GetGameInstance() : nullptr;
+		const UFlowSubsystem* FlowSubsystem = GameInstance ? GameInstance->GetSubsystem<UFlowSubsystem>() : nullptr;
+
+		FFlowEditorBenchmark Benchmark;
+		Benchmark.Iterations = 1;
+		Benchmark.Samples.Add({TEXT("PIEStart"), FlowSubsystem ? FlowSubsystem->GetRootInstancesNum() : 0, 0, Milliseconds});
+		Benchmark.Report(TEXT("EditorBenchmarkPIE"));
+	}
+};
+
+double FFlowEditorBenchmark::PIERequestTime = 0.0;
+FDelegateHandle FFlowEditorBenchmark::PIEStartedHandle;
+
+static FAutoConsoleCommand FlowEditorBenchmarkCommand(
+	TEXT("Flow.Benchmark.Editor"),
+	TEXT("Builds a synthetic Flow Asset and node Blueprints, times opening the asset editor, the first node palette, Find in Flow and diffing. ")
+	TEXT("Writes CSV to Saved/Profiling/Flow. Clears the undo history, run it in a fresh editor session. ")
+	TEXT("Arguments: [Nodes=1000] [NodeBlueprints=200] [Iterations=3]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FFlowEditorBenchmark::RunCommand));
+
+static FAutoConsoleCommand FlowEditorPIEBenchmarkCommand(
+	TEXT("Flow.Benchmark.EditorPIE"),
+	TEXT("Starts PIE in the current level and times it until PIE has started, including Begin Play of Flow Components. ")
+	TEXT("Writes CSV with the number of started root flows to Saved/Profiling/Flow."),
+	FConsoleCommandDelegate::CreateStatic(&FFlowEditorBenchmark::RunPIECommand));
+
+#undef LOCTEXT_NAMESPACE
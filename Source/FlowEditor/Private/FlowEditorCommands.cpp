@@ -25,6 +25,8 @@ void FFlowToolbarCommands::RegisterCommands()
 	UI_COMMAND(EditAssetDefaults, "Asset Defaults", "Edit the FlowAsset default properties", EUserInterfaceActionType::Button, FInputChord());
 
 	UI_COMMAND(GoToParentInstance, "Go To Parent", "Open editor for the Flow Asset that created this Flow instance", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(ToggleProfiler, "Profiler", "Measure cost of the nodes and show it as the heatmap on the graph, reported by Flow.Profiler.Dump as well", EUserInterfaceActionType::ToggleButton, FInputChord());
+	UI_COMMAND(LoadRecording, "Recording", "Load activations recorded by Flow.Recorder, i.e. in a cooked build, and replay them on the graph", EUserInterfaceActionType::Button, FInputChord());
 }
 
 FFlowGraphCommands::FFlowGraphCommands()
@@ -3,8 +3,10 @@
 #include "FlowEditorModule.h"
 #include "FlowEditorStyle.h"
 
+#include "Asset/FlowAssetDependencies.h"
 #include "Asset/FlowAssetEditor.h"
 #include "Asset/FlowAssetIndexer.h"
+#include "Asset/FlowRemoteDebugSession.h"
 #include "Graph/FlowGraphConnectionDrawingPolicy.h"
 #include "Graph/FlowGraphPinFactory.h"
 #include "Graph/FlowGraphSettings.h"
@@ -49,6 +51,7 @@
 #include "ISequencerModule.h"
 #include "LevelEditor.h"
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 static FName AssetSearchModuleName = TEXT("AssetSearch");
 
@@ -59,6 +62,8 @@ FAssetCategoryPath FFLowAssetCategoryPaths::Flow(LOCTEXT("Flow", "Flow"));
 
 void FFlowEditorModule::StartupModule()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFlowEditorModule::StartupModule);
+
 	MenuExtensibilityManager = MakeShared<FExtensibilityManager>();
 	ToolBarExtensibilityManager = MakeShared<FExtensibilityManager>();
 	
@@ -91,6 +96,9 @@ void FFlowEditorModule::StartupModule()
 
 	RegisterDetailCustomizations();
 
+	// cook content dependencies of Flow Assets
+	FFlowAssetDependencies::Register();
+
 	// register asset indexers
 	if (FModuleManager::Get().IsModuleLoaded(AssetSearchModuleName))
 	{
@@ -104,6 +112,9 @@ void FFlowEditorModule::StartupModule()
 
 void FFlowEditorModule::ShutdownModule()
 {
+	// stop the analysis thread before the trace modules go away
+	FFlowRemoteDebugSession::Get().Disconnect();
+
 	MenuExtensibilityManager.Reset();
 	ToolBarExtensibilityManager.Reset();
 	
@@ -118,6 +129,8 @@ void FFlowEditorModule::ShutdownModule()
 	SequencerModule.UnRegisterTrackEditor(FlowTrackCreateEditorHandle);
 
 	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+
+	FFlowAssetDependencies::Unregister();
 }
 
 void FFlowEditorModule::TrySetFlowNodeDisplayStyleDefaults() const
@@ -11,10 +11,46 @@
 #include "Editor.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "EdGraph/EdGraphPin.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 #include "Logging/LogMacros.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowGraph)
 
+static bool GFlowParallelGraphValidation = true;
+static FAutoConsoleVariableRef CVarFlowParallelGraphValidation(
+	TEXT("Flow.Validation.Parallel"),
+	GFlowParallelGraphValidation,
+	TEXT("Validates connections of graph nodes on worker threads. Node instances and connections checked by classes not opting in IsConnectionValidationThreadSafe are always validated on the game thread."));
+
+// connection checks call IsConnectionDisallowed of both nodes, so every data input connected to this node has to opt in
+static bool CanValidateGraphNodeInParallel(const UFlowGraphNode* FlowGraphNode)
+{
+	if (!FlowGraphNode->IsConnectionValidationThreadSafe())
+	{
+		return false;
+	}
+
+	for (const UEdGraphPin* EdGraphPin : FlowGraphNode->Pins)
+	{
+		if (EdGraphPin->Direction != EGPD_Input || !FFlowPin::IsDataPinCategory(EdGraphPin->PinType.PinCategory))
+		{
+			continue;
+		}
+
+		for (const UEdGraphPin* ConnectedPin : EdGraphPin->LinkedTo)
+		{
+			const UFlowGraphNode* ConnectedNode = ConnectedPin ? Cast<UFlowGraphNode>(ConnectedPin->GetOwningNodeUnchecked()) : nullptr;
+			if (ConnectedNode && !ConnectedNode->IsConnectionValidationThreadSafe())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 UFlowGraph::UFlowGraph(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, GraphVersion(0)
@@ -122,10 +158,72 @@ void UFlowGraph::RecursivelyRefreshAddOns(UFlowGraphNode& FromFlowGraphNode)
 	}
 }
 
+bool UFlowGraph::ReconstructNodesOfClasses(const TArray<const UClass*>& RecompiledClasses)
+{
+	bool bReconstructed = false;
+
+	// reconstruction of AddOns would update the asset after every node
+	LockUpdates();
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node))
+		{
+			bReconstructed |= RecursivelyReconstructNodesOfClasses(*FlowGraphNode, RecompiledClasses);
+		}
+	}
+	bLockUpdates = false;
+
+	if (bReconstructed)
+	{
+		UpdateAsset();
+		NotifyGraphChanged();
+	}
+
+	return bReconstructed;
+}
+
+bool UFlowGraph::RecursivelyReconstructNodesOfClasses(UFlowGraphNode& FromFlowGraphNode, const TArray<const UClass*>& RecompiledClasses)
+{
+	bool bReconstructed = false;
+
+	const UFlowNodeBase* NodeInstance = FromFlowGraphNode.GetFlowNodeBase();
+	if (IsValid(NodeInstance))
+	{
+		const UClass* NodeClass = NodeInstance->GetClass();
+		if (RecompiledClasses.ContainsByPredicate([NodeClass](const UClass* RecompiledClass) { return NodeClass->IsChildOf(RecompiledClass); }))
+		{
+			FromFlowGraphNode.OnNodeClassRecompiled();
+			bReconstructed = true;
+		}
+	}
+
+	for (UFlowGraphNode* SubNode : FromFlowGraphNode.SubNodes)
+	{
+		if (IsValid(SubNode))
+		{
+			bReconstructed |= RecursivelyReconstructNodesOfClasses(*SubNode, RecompiledClasses);
+		}
+	}
+
+	return bReconstructed;
+}
+
 void UFlowGraph::NotifyGraphChanged()
 {
+	// pins might have been recreated
+	DebugWirePaths.Reset();
+
 	if (UFlowAsset* FlowAsset = GetFlowAsset())
 	{
+		// refreshed once at the end of the batch
+		if (FlowAsset->IsEditBatchActive())
+		{
+			// editor utilities might query event names of the asset before the batch ends
+			FlowAsset->InvalidateCustomEventNodes();
+			FlowAsset->MarkEditBatchGraphChanged();
+			return;
+		}
+
 		FlowAsset->HarvestNodeConnections();
 	}
 
@@ -144,13 +242,53 @@ void UFlowGraph::ValidateAsset(FFlowMessageLog& MessageLog)
 		FlowAsset->ValidateAsset(MessageLog);
 	}
 
+	TArray<const UFlowGraphNode*> FlowGraphNodes;
+	FlowGraphNodes.Reserve(Nodes.Num());
 	for (UEdGraphNode* Node : Nodes)
 	{
 		if (const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node))
 		{
-			FlowGraphNode->ValidateGraphNode(MessageLog);
+			FlowGraphNodes.Add(FlowGraphNode);
+		}
+	}
+
+	// connection checks only read pins of the graph, every node writes to its own log
+	// logs are merged in the node order, so results don't depend on the scheduling
+	TArray<FFlowMessageLog> NodeLogs;
+	NodeLogs.SetNum(FlowGraphNodes.Num());
+
+	// overridden checks of schemas and nodes not opting in might touch UObjects or call Blueprint code, so they stay on the game thread
+	TArray<int32> ParallelIndices;
+	TArray<int32> GameThreadIndices;
+	const UFlowGraphSchema* FlowGraphSchema = Cast<UFlowGraphSchema>(GetSchema());
+	const bool bParallelSchema = GFlowParallelGraphValidation && FlowGraphSchema && FlowGraphSchema->IsConnectionValidationThreadSafe();
+	for (int32 Index = 0; Index < FlowGraphNodes.Num(); ++Index)
+	{
+		if (bParallelSchema && CanValidateGraphNodeInParallel(FlowGraphNodes[Index]))
+		{
+			ParallelIndices.Add(Index);
+		}
+		else
+		{
+			GameThreadIndices.Add(Index);
 		}
 	}
+
+	ParallelFor(ParallelIndices.Num(), [&FlowGraphNodes, &NodeLogs, &ParallelIndices](const int32 Index)
+	{
+		const int32 NodeIndex = ParallelIndices[Index];
+		FlowGraphNodes[NodeIndex]->ValidateGraphNode(NodeLogs[NodeIndex]);
+	}, EParallelForFlags::Unbalanced);
+
+	for (const int32 NodeIndex : GameThreadIndices)
+	{
+		FlowGraphNodes[NodeIndex]->ValidateGraphNode(NodeLogs[NodeIndex]);
+	}
+
+	for (const FFlowMessageLog& NodeLog : NodeLogs)
+	{
+		MessageLog.Messages.Append(NodeLog.Messages);
+	}
 }
 
 void UFlowGraph::Serialize(FArchive& Ar)
@@ -2,6 +2,8 @@
 
 #include "Graph/FlowGraphConnectionDrawingPolicy.h"
 
+#include "Asset/FlowRecordingPlayback.h"
+
 #include "Graph/FlowGraph.h"
 #include "Graph/FlowGraphEditor.h"
 #include "Graph/FlowGraphEditorSettings.h"
@@ -55,37 +57,38 @@ FFlowGraphConnectionDrawingPolicy::FFlowGraphConnectionDrawingPolicy(int32 InBac
 
 void FFlowGraphConnectionDrawingPolicy::BuildPaths()
 {
-	if (const UFlowAsset* FlowInstance = CastChecked<UFlowGraph>(GraphObj)->GetFlowAsset()->GetInspectedInstance())
+	UFlowGraph* FlowGraph = CastChecked<UFlowGraph>(GraphObj);
+	const UFlowAsset* FlowAsset = FlowGraph->GetFlowAsset();
+	const FFlowRecordingPlayback& RecordingPlayback = FFlowRecordingPlayback::Get();
+
+	if (const UFlowAsset* FlowInstance = FlowAsset->GetInspectedInstance())
 	{
 		const double CurrentTime = FApp::GetCurrentTime();
 
-		for (const UFlowNode* Node : FlowInstance->GetRecordedNodes())
+		// rebuild only if the instance recorded new activations or a recent wire faded out
+		TSharedPtr<FFlowGraphWirePaths>& CachedPaths = FlowGraph->DebugWirePaths;
+		if (!CachedPaths.IsValid()
+			|| CachedPaths->Instance != FlowInstance
+			|| CachedPaths->WireRecordsVersion != FlowInstance->GetWireRecordsVersion()
+			|| CachedPaths->RecentWireDuration != RecentWireDuration
+			|| CurrentTime >= CachedPaths->RecentPathsExpiry)
 		{
-			const UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node->GetGraphNode());
-
-			for (const TPair<uint8, FPinRecord>& Record : Node->GetWireRecords())
-			{
-				if (!FlowGraphNode->OutputPins.IsValidIndex(Record.Key))
-				{
-					UE_LOG(LogFlowEditor, Error, TEXT("Flow node '%s' has an invalid pin connection.  This is probably an flow editor code bug."), *Node->GetName());
-
-					continue;
-				}
+			CachedPaths = MakeShared<FFlowGraphWirePaths>();
+			BuildInstancePaths(*FlowAsset, *FlowInstance, CurrentTime, *CachedPaths);
+		}
 
-				if (UEdGraphPin* OutputPin = FlowGraphNode->OutputPins[Record.Key])
-				{
-					// check if Output pin is connected to anything
-					if (OutputPin->LinkedTo.Num() > 0)
-					{
-						RecordedPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+		WirePaths = CachedPaths;
+	}
+	else
+	{
+		FlowGraph->DebugWirePaths.Reset();
 
-						if (CurrentTime < Record.Value.Time + RecentWireDuration)
-						{
-							RecentPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
-						}
-					}
-				}
-			}
+		if (RecordingPlayback.IsLoaded() && RecordingPlayback.HasTemplate(*FlowAsset))
+		{
+			// playback time can move in both directions, so paths are built on every paint
+			const TSharedRef<FFlowGraphWirePaths> PlaybackPaths = MakeShared<FFlowGraphWirePaths>();
+			BuildPlaybackPaths(*FlowAsset, *PlaybackPaths);
+			WirePaths = PlaybackPaths;
 		}
 	}
 
@@ -112,6 +115,81 @@ void FFlowGraphConnectionDrawingPolicy::BuildPaths()
 	}
 }
 
+void FFlowGraphConnectionDrawingPolicy::BuildInstancePaths(const UFlowAsset& FlowAsset, const UFlowAsset& FlowInstance, const double CurrentTime, FFlowGraphWirePaths& OutPaths) const
+{
+	OutPaths.Instance = &FlowInstance;
+	OutPaths.WireRecordsVersion = FlowInstance.GetWireRecordsVersion();
+	OutPaths.RecentWireDuration = RecentWireDuration;
+
+	for (const TPair<FGuid, TMap<uint8, double>>& NodeRecords : FlowInstance.GetWireRecords())
+	{
+		const UFlowNode* Node = FlowAsset.GetNode(NodeRecords.Key);
+		const UFlowGraphNode* FlowGraphNode = Node ? Cast<UFlowGraphNode>(Node->GetGraphNode()) : nullptr;
+		if (FlowGraphNode == nullptr)
+		{
+			continue;
+		}
+
+		for (const TPair<uint8, double>& Record : NodeRecords.Value)
+		{
+			if (!FlowGraphNode->OutputPins.IsValidIndex(Record.Key))
+			{
+				UE_LOG(LogFlowEditor, Error, TEXT("Flow node '%s' has an invalid pin connection.  This is probably an flow editor code bug."), *Node->GetName());
+
+				continue;
+			}
+
+			// check if Output pin is connected to anything
+			UEdGraphPin* OutputPin = FlowGraphNode->OutputPins[Record.Key];
+			if (OutputPin && OutputPin->LinkedTo.Num() > 0)
+			{
+				OutPaths.RecordedPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+
+				const double RecentWireExpiry = Record.Value + RecentWireDuration;
+				if (CurrentTime < RecentWireExpiry)
+				{
+					OutPaths.RecentPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+					OutPaths.RecentPathsExpiry = FMath::Min(OutPaths.RecentPathsExpiry, RecentWireExpiry);
+				}
+			}
+		}
+	}
+}
+
+void FFlowGraphConnectionDrawingPolicy::BuildPlaybackPaths(const UFlowAsset& FlowAsset, FFlowGraphWirePaths& OutPaths) const
+{
+	const FFlowRecordingPlayback& RecordingPlayback = FFlowRecordingPlayback::Get();
+
+	// replay activations loaded from the recording file, relative to its playback time
+	TMap<FGuid, TMap<uint8, float>> WireRecords;
+	RecordingPlayback.GetWireRecords(FlowAsset, WireRecords);
+
+	for (const TPair<FGuid, TMap<uint8, float>>& NodeRecords : WireRecords)
+	{
+		const UFlowNode* Node = FlowAsset.GetNode(NodeRecords.Key);
+		const UFlowGraphNode* FlowGraphNode = Node ? Cast<UFlowGraphNode>(Node->GetGraphNode()) : nullptr;
+		if (FlowGraphNode == nullptr)
+		{
+			// node has been removed since the recording
+			continue;
+		}
+
+		for (const TPair<uint8, float>& Record : NodeRecords.Value)
+		{
+			UEdGraphPin* OutputPin = FlowGraphNode->OutputPins.IsValidIndex(Record.Key) ? FlowGraphNode->OutputPins[Record.Key] : nullptr;
+			if (OutputPin && OutputPin->LinkedTo.Num() > 0)
+			{
+				OutPaths.RecordedPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+
+				if (RecordingPlayback.GetTime() < Record.Value + RecentWireDuration)
+				{
+					OutPaths.RecentPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+				}
+			}
+		}
+	}
+}
+
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
 void FFlowGraphConnectionDrawingPolicy::DrawConnection(int32 LayerId, const FVector2D& Start, const FVector2D& End, const FConnectionParams& Params)
 #else
@@ -168,14 +246,14 @@ void FFlowGraphConnectionDrawingPolicy::DetermineWiringStyle(UEdGraphPin* Output
 				Params.bDrawBubbles = false;
 			}
 			// recent paths
-			else if (RecentPaths.Contains(OutputPin) && RecentPaths[OutputPin] == InputPin)
+			else if (WirePaths.IsValid() && WirePaths->RecentPaths.FindRef(OutputPin) == InputPin)
 			{
 				Params.WireColor = RecentColor;
 				Params.WireThickness = RecentWireThickness;
 				Params.bDrawBubbles = true;
 			}
 			// all paths, showing graph history
-			else if (RecordedPaths.Contains(OutputPin) && RecordedPaths[OutputPin] == InputPin)
+			else if (WirePaths.IsValid() && WirePaths->RecordedPaths.FindRef(OutputPin) == InputPin)
 			{
 				Params.WireColor = RecordedColor;
 				Params.WireThickness = RecordedWireThickness;
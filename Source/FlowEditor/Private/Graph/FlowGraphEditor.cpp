@@ -480,9 +480,9 @@ void SFlowGraphEditor::ReconnectExecPins(const UFlowGraphNode* Node)
 
 void SFlowGraphEditor::DeleteSelectedNodes()
 {
-	const FScopedTransaction Transaction(LOCTEXT("DeleteSelectedNode", "Delete Selected Node"));
+	// a single harvest and graph refresh after removing all the nodes
+	const FFlowAssetEditBatch EditBatch(FlowAsset.Get(), LOCTEXT("DeleteSelectedNode", "Delete Selected Node"));
 	GetCurrentGraph()->Modify();
-	FlowAsset->Modify();
 
 	const FGraphPanelSelectionSet SelectedNodes = GetSelectedNodes();
 	FlowAssetEditor.Pin()->SetUISelectionState(NAME_None);
@@ -677,11 +677,10 @@ void SFlowGraphEditor::PasteNodes()
 
 void SFlowGraphEditor::PasteNodesHere(const FVector2D& Location)
 {
-	// Undo/Redo support
-	const FScopedTransaction Transaction(LOCTEXT("PasteNode", "Paste Node"));
+	// Undo/Redo support, registering every pasted node would harvest the whole graph again
+	const FFlowAssetEditBatch EditBatch(FlowAsset.Get(), LOCTEXT("PasteNode", "Paste Node"));
 	UFlowGraph* FlowGraph = CastChecked<UFlowGraph>(FlowAsset->GetGraph());
 	FlowGraph->Modify();
-	FlowAsset->Modify();
 
 	FlowGraph->LockUpdates();
 
@@ -13,9 +13,13 @@ UFlowGraphEditorSettings::UFlowGraphEditorSettings()
 	, bShowSubGraphPreview(true)
 	, bShowSubGraphPath(true)
 	, SubGraphPreviewSize(FVector2D(640.f, 360.f))
+	, DeferredNodeDetailsMinNodes(500)
+	, NodeInfoRefreshInterval(0.2f)
 	, bHotReloadNativeNodes(false)
 	, bHighlightInputWiresOfSelectedNodes(false)
 	, bHighlightOutputWiresOfSelectedNodes(false)
+	, RuntimeLogRefreshInterval(0.25f)
+	, ProfilerHeatmapMetric(EFlowProfilerHeatmapMetric::ExclusiveTime)
 {
 }
 
@@ -22,12 +22,19 @@
 #include "Nodes/Route/FlowNode_Reroute.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "DerivedDataCacheInterface.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraphSchema_K2.h"
 #include "Editor.h"
 #include "Engine/MemberReference.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "ScopedTransaction.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
 #include "Kismet/BlueprintTypeConversions.h"
@@ -47,8 +54,21 @@ TMap<FName, FAssetData> UFlowGraphSchema::BlueprintFlowNodeAddOns;
 TMap<TSubclassOf<UFlowNodeBase>, TSubclassOf<UEdGraphNode>> UFlowGraphSchema::GraphNodesByFlowNodes;
 
 bool UFlowGraphSchema::bBlueprintCompilationPending;
+TArray<TWeakObjectPtr<UBlueprint>> UFlowGraphSchema::RecompiledBlueprints;
+FTSTicker::FDelegateHandle UFlowGraphSchema::RecompiledBlueprintsTickerHandle;
 int32 UFlowGraphSchema::CurrentCacheRefreshID = 0;
 
+struct FFlowPlaceableNodesCache
+{
+	// Class defaults, blueprint ones are replaced on compilation
+	TArray<TWeakObjectPtr<UFlowNodeBase>> Nodes;
+
+	TArray<FFlowNodeBlueprintMetadata> UnloadedBlueprints;
+};
+
+TMap<TPair<FObjectKey, FName>, FFlowPlaceableNodesCache> UFlowGraphSchema::PlaceableNodesCache;
+TMap<TPair<FObjectKey, FName>, FFlowPlaceableNodesCache> UFlowGraphSchema::PlaceableAddOnsCache;
+
 FFlowGraphSchemaRefresh UFlowGraphSchema::OnNodeListChanged;
 
 const UScriptStruct* UFlowGraphSchema::VectorStruct = nullptr;
@@ -223,6 +243,9 @@ void UFlowGraphSchema::SubscribeToAssetChanges()
 
 	FCoreUObjectDelegates::ReloadCompleteDelegate.AddStatic(&UFlowGraphSchema::OnHotReload);
 
+	// every change of gathered nodes and blueprints is broadcasted, including GatherNodes after compiling blueprints
+	OnNodeListChanged.AddStatic(&UFlowGraphSchema::ClearPlaceableNodesCache);
+
 	if (GEditor)
 	{
 		GEditor->OnBlueprintPreCompile().AddStatic(&UFlowGraphSchema::OnBlueprintPreCompile);
@@ -372,11 +395,17 @@ bool UFlowGraphSchema::ArePinTypesCompatible(const FEdGraphPinType& Output, cons
 	using namespace FlowGraphSchema::Private;
 	using namespace UE::Kismet::BlueprintTypeConversions;
 
+	// array pins are resolved as views of the supplier's values, so there's no conversion from or to single values
+	if (!bIgnoreArray && Output.ContainerType != Input.ContainerType)
+	{
+		return false;
+	}
+
 	if (ArePinCategoriesEffectivelyMatching(Input.PinCategory, Output.PinCategory))
 	{
 		const UScriptStruct* OutputStruct = Cast<UScriptStruct>(Output.PinSubCategoryObject.Get());
 		const UScriptStruct* InputStruct = Cast<UScriptStruct>(Input.PinSubCategoryObject.Get());
-		if (OutputStruct != InputStruct)
+		if (OutputStruct != InputStruct && !Output.IsArray())
 		{
 			const bool bAreConvertibleStructs =
 				FStructConversionTable::Get().GetConversionFunction(OutputStruct, InputStruct).IsSet();
@@ -504,6 +533,11 @@ const FPinConnectionResponse UFlowGraphSchema::CanCreateConnection(const UEdGrap
 	return ConnectionResponse;
 }
 
+bool UFlowGraphSchema::IsConnectionValidationThreadSafe() const
+{
+	return GetClass() == UFlowGraphSchema::StaticClass();
+}
+
 const FPinConnectionResponse UFlowGraphSchema::DetermineConnectionResponseOfCompatibleTypedPins(const UEdGraphPin* PinA, const UEdGraphPin* PinB, const UEdGraphPin* InputPin, const UEdGraphPin* OutputPin) const
 {
 	const bool bIsExistingConnection = PinA->LinkedTo.Contains(PinB);
@@ -867,6 +901,8 @@ void UFlowGraphSchema::ForceVisualizationCacheClear() const
 
 void UFlowGraphSchema::UpdateGeneratedDisplayNames()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::UpdateGeneratedDisplayNames);
+
 	for (UClass* FlowNodeClass : NativeFlowNodes)
 	{
 		UpdateGeneratedDisplayName(FlowNodeClass, true);
@@ -877,9 +913,10 @@ void UFlowGraphSchema::UpdateGeneratedDisplayNames()
 		UpdateGeneratedDisplayName(FlowNodeAddOnClass, true);
 	}
 
+	// blueprints restored from the cache aren't loaded yet, these get their names once loaded by GetPlaceableNodeOrAddOnBlueprint
 	for (TPair<FName, FAssetData>& AssetData : BlueprintFlowNodes)
 	{
-		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.Value.GetAsset()))
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.Value.FastGetAsset(false)))
 		{
 			UClass* NodeClass = Blueprint->GeneratedClass;
 			UpdateGeneratedDisplayName(NodeClass, true);
@@ -888,7 +925,7 @@ void UFlowGraphSchema::UpdateGeneratedDisplayNames()
 
 	for (TPair<FName, FAssetData>& AssetData : BlueprintFlowNodeAddOns)
 	{
-		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.Value.GetAsset()))
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.Value.FastGetAsset(false)))
 		{
 			UClass* NodeAddOnClass = Blueprint->GeneratedClass;
 			UpdateGeneratedDisplayName(NodeAddOnClass, true);
@@ -946,19 +983,22 @@ TArray<TSharedPtr<FString>> UFlowGraphSchema::GetFlowNodeCategories()
 		}
 	}
 
-	for (const TPair<FName, FAssetData>& AssetData : BlueprintFlowNodes)
+	for (const TMap<FName, FAssetData>* BlueprintNodesOrAddOns : {&BlueprintFlowNodes, &BlueprintFlowNodeAddOns})
 	{
-		if (const UBlueprint* Blueprint = GetPlaceableNodeOrAddOnBlueprint(AssetData.Value))
+		for (const TPair<FName, FAssetData>& AssetData : *BlueprintNodesOrAddOns)
 		{
-			UnsortedCategories.Emplace(Blueprint->BlueprintCategory);
-		}
-	}
-
-	for (const TPair<FName, FAssetData>& AssetData : BlueprintFlowNodeAddOns)
-	{
-		if (const UBlueprint* Blueprint = GetPlaceableNodeOrAddOnBlueprint(AssetData.Value))
-		{
-			UnsortedCategories.Emplace(Blueprint->BlueprintCategory);
+			FFlowNodeBlueprintMetadata Metadata;
+			if (FFlowNodeBlueprintMetadata::FromAssetData(AssetData.Value, Metadata))
+			{
+				if (Metadata.bPlaceable)
+				{
+					UnsortedCategories.Emplace(Metadata.Category);
+				}
+			}
+			else if (const UBlueprint* Blueprint = GetPlaceableNodeOrAddOnBlueprint(AssetData.Value))
+			{
+				UnsortedCategories.Emplace(Blueprint->BlueprintCategory);
+			}
 		}
 	}
 
@@ -1052,20 +1092,45 @@ void UFlowGraphSchema::ApplyNodeOrAddOnFilter(const UFlowAsset* EditedFlowAsset,
 
 void UFlowGraphSchema::GetFlowNodeActions(FGraphActionMenuBuilder& ActionMenuBuilder, const UFlowAsset* EditedFlowAsset, const FString& CategoryName)
 {
-	TArray<UFlowNodeBase*> FilteredNodes = GetFilteredPlaceableNodesOrAddOns(EditedFlowAsset, NativeFlowNodes, BlueprintFlowNodes);
+	const FFlowPlaceableNodesCache& FilteredNodes = GetCachedPlaceableNodesOrAddOns(EditedFlowAsset, false);
 
 	const UFlowGraphSettings& FlowGraphSettings = *UFlowGraphSettings::Get();
-	for (const UFlowNodeBase* FlowNode : FilteredNodes)
+	for (const TWeakObjectPtr<UFlowNodeBase>& FlowNodePtr : FilteredNodes.Nodes)
 	{
+		const UFlowNodeBase* FlowNode = FlowNodePtr.Get();
+		if (FlowNode == nullptr)
+		{
+			continue;
+		}
+
 		if ((CategoryName.IsEmpty() || CategoryName.Equals(FlowNode->GetNodeCategory())) && !FlowGraphSettings.NodesHiddenFromPalette.Contains(FlowNode->GetClass()))
 		{
 			TSharedPtr<FFlowGraphSchemaAction_NewNode> NewNodeAction(new FFlowGraphSchemaAction_NewNode(FlowNode, FlowGraphSettings));
 			ActionMenuBuilder.AddAction(NewNodeAction);
 		}
 	}
+
+	// hidden classes are loaded with the settings, so compare paths instead of loading blueprints
+	TSet<FTopLevelAssetPath> HiddenClassPaths;
+	for (const TSubclassOf<UFlowNode>& HiddenClass : FlowGraphSettings.NodesHiddenFromPalette)
+	{
+		if (HiddenClass)
+		{
+			HiddenClassPaths.Add(HiddenClass->GetClassPathName());
+		}
+	}
+
+	for (const FFlowNodeBlueprintMetadata& Metadata : FilteredNodes.UnloadedBlueprints)
+	{
+		if ((CategoryName.IsEmpty() || CategoryName.Equals(Metadata.Category)) && !HiddenClassPaths.Contains(Metadata.GeneratedClassPath))
+		{
+			TSharedPtr<FFlowGraphSchemaAction_NewNode> NewNodeAction(new FFlowGraphSchemaAction_NewNode(Metadata, FlowGraphSettings));
+			ActionMenuBuilder.AddAction(NewNodeAction);
+		}
+	}
 }
 
-TArray<UFlowNodeBase*> UFlowGraphSchema::GetFilteredPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const TArray<UClass*>& InNativeNodesOrAddOns, const TMap<FName, FAssetData>& InBlueprintNodesOrAddOns)
+TArray<UFlowNodeBase*> UFlowGraphSchema::GetFilteredPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const TArray<UClass*>& InNativeNodesOrAddOns, const TMap<FName, FAssetData>& InBlueprintNodesOrAddOns, TArray<FFlowNodeBlueprintMetadata>* OutUnloadedBlueprints)
 {
 	if (!bInitialGatherPerformed)
 	{
@@ -1084,6 +1149,22 @@ TArray<UFlowNodeBase*> UFlowGraphSchema::GetFilteredPlaceableNodesOrAddOns(const
 
 	for (const TPair<FName, FAssetData>& AssetData : InBlueprintNodesOrAddOns)
 	{
+		// loaded blueprints are filtered by their class defaults, tags might be outdated until saving the blueprint
+		FFlowNodeBlueprintMetadata Metadata;
+		if (AssetData.Value.FastGetAsset(false) == nullptr && FFlowNodeBlueprintMetadata::FromAssetData(AssetData.Value, Metadata))
+		{
+			if (!Metadata.bPlaceable || EditedFlowAsset == nullptr || !EditedFlowAsset->IsNodeOrAddOnBlueprintAllowed(AssetData.Value, Metadata))
+			{
+				continue;
+			}
+
+			if (OutUnloadedBlueprints)
+			{
+				OutUnloadedBlueprints->Add(MoveTemp(Metadata));
+				continue;
+			}
+		}
+
 		if (const UBlueprint* Blueprint = GetPlaceableNodeOrAddOnBlueprint(AssetData.Value))
 		{
 			ApplyNodeOrAddOnFilter(EditedFlowAsset, Blueprint->GeneratedClass, FilteredNodes);
@@ -1095,6 +1176,51 @@ TArray<UFlowNodeBase*> UFlowGraphSchema::GetFilteredPlaceableNodesOrAddOns(const
 	return FilteredNodes;
 }
 
+const FFlowPlaceableNodesCache& UFlowGraphSchema::GetCachedPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const bool bAddOns)
+{
+	static const FFlowPlaceableNodesCache EmptyCache;
+	if (EditedFlowAsset == nullptr)
+	{
+		return EmptyCache;
+	}
+
+	if (!bInitialGatherPerformed)
+	{
+		GatherNodes();
+	}
+
+	const FName MountPoint = FPackageName::GetPackageMountPoint(EditedFlowAsset->GetPackage()->GetName());
+	const TPair<FObjectKey, FName> CacheKey(FObjectKey(EditedFlowAsset->GetClass()), MountPoint);
+
+	TMap<TPair<FObjectKey, FName>, FFlowPlaceableNodesCache>& Cache = bAddOns ? PlaceableAddOnsCache : PlaceableNodesCache;
+	if (const FFlowPlaceableNodesCache* CachedNodes = Cache.Find(CacheKey))
+	{
+		return *CachedNodes;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::GetCachedPlaceableNodesOrAddOns);
+
+	// filtering might load blueprints, so the cache is added once it's complete
+	FFlowPlaceableNodesCache NewCache;
+	TArray<UFlowNodeBase*> FilteredNodes = bAddOns
+		? GetFilteredPlaceableNodesOrAddOns(EditedFlowAsset, NativeFlowNodeAddOns, BlueprintFlowNodeAddOns)
+		: GetFilteredPlaceableNodesOrAddOns(EditedFlowAsset, NativeFlowNodes, BlueprintFlowNodes, &NewCache.UnloadedBlueprints);
+
+	NewCache.Nodes.Reserve(FilteredNodes.Num());
+	for (UFlowNodeBase* FlowNode : FilteredNodes)
+	{
+		NewCache.Nodes.Emplace(FlowNode);
+	}
+
+	return Cache.Add(CacheKey, MoveTemp(NewCache));
+}
+
+void UFlowGraphSchema::ClearPlaceableNodesCache()
+{
+	PlaceableNodesCache.Empty();
+	PlaceableAddOnsCache.Empty();
+}
+
 void UFlowGraphSchema::GetGraphNodeContextActions(FGraphContextMenuBuilder& ContextMenuBuilder, int32 SubNodeFlags) const
 {
 	UEdGraph* Graph = const_cast<UEdGraph*>(ContextMenuBuilder.CurrentGraph);
@@ -1102,10 +1228,16 @@ void UFlowGraphSchema::GetGraphNodeContextActions(FGraphContextMenuBuilder& Cont
 
 	const UFlowAsset* EditedFlowAsset = GetEditedAssetOrClassDefault(ContextMenuBuilder.CurrentGraph);
 
-	TArray<UFlowNodeBase*> FilteredNodes = GetFilteredPlaceableNodesOrAddOns(EditedFlowAsset, NativeFlowNodeAddOns, BlueprintFlowNodeAddOns);
+	const FFlowPlaceableNodesCache& FilteredNodes = GetCachedPlaceableNodesOrAddOns(EditedFlowAsset, true);
 
-	for (UFlowNodeBase* FlowNodeBase : FilteredNodes)
+	for (const TWeakObjectPtr<UFlowNodeBase>& FlowNodePtr : FilteredNodes.Nodes)
 	{
+		UFlowNodeBase* FlowNodeBase = FlowNodePtr.Get();
+		if (FlowNodeBase == nullptr)
+		{
+			continue;
+		}
+
 		UFlowNodeAddOn* FlowNodeAddOnTemplate = CastChecked<UFlowNodeAddOn>(FlowNodeBase);
 
 		// Add-Ons are futher filtered by what they are potentially being attached to 
@@ -1207,19 +1339,61 @@ void UFlowGraphSchema::OnBlueprintPreCompile(UBlueprint* Blueprint)
 	if (Blueprint && Blueprint->GeneratedClass && Blueprint->GeneratedClass->IsChildOf(UFlowNodeBase::StaticClass()))
 	{
 		bBlueprintCompilationPending = true;
+		RecompiledBlueprints.AddUnique(Blueprint);
 	}
 }
 
 void UFlowGraphSchema::OnBlueprintCompiled()
 {
-	if (bBlueprintCompilationPending)
+	// compiling a base blueprint compiles its children separately, so the refresh is coalesced until the next tick
+	if (bBlueprintCompilationPending && !RecompiledBlueprintsTickerHandle.IsValid())
 	{
-		GatherNodes();
+		RecompiledBlueprintsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&UFlowGraphSchema::RefreshAfterBlueprintsCompiled));
 	}
 
 	bBlueprintCompilationPending = false;
 }
 
+bool UFlowGraphSchema::RefreshAfterBlueprintsCompiled(float DeltaTime)
+{
+	// graphs aren't refreshed during PIE, wait for its end
+	if (GCompilingBlueprint || (GEditor && IsPIESimulating()))
+	{
+		return true;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::RefreshAfterBlueprintsCompiled);
+
+	RecompiledBlueprintsTickerHandle.Reset();
+
+	TArray<const UClass*> RecompiledClasses;
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : RecompiledBlueprints)
+	{
+		if (Blueprint.IsValid() && Blueprint->GeneratedClass)
+		{
+			RecompiledClasses.Add(Blueprint->GeneratedClass);
+		}
+	}
+	RecompiledBlueprints.Reset();
+
+	// broadcasts OnNodeListChanged and clears the visualization cache once for all compiled blueprints
+	GatherNodes();
+
+	if (RecompiledClasses.Num() > 0 && GEditor)
+	{
+		for (UObject* EditedAsset : GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->GetAllEditedAssets())
+		{
+			const UFlowAsset* FlowAsset = Cast<UFlowAsset>(EditedAsset);
+			if (UFlowGraph* FlowGraph = FlowAsset ? Cast<UFlowGraph>(FlowAsset->GetGraph()) : nullptr)
+			{
+				FlowGraph->ReconstructNodesOfClasses(RecompiledClasses);
+			}
+		}
+	}
+
+	return false;
+}
+
 void UFlowGraphSchema::OnHotReload(EReloadCompleteReason ReloadCompleteReason)
 {
 	GatherNodes();
@@ -1227,6 +1401,8 @@ void UFlowGraphSchema::OnHotReload(EReloadCompleteReason ReloadCompleteReason)
 
 void UFlowGraphSchema::GatherNativeNodesOrAddOns(const TSubclassOf<UFlowNodeBase>& FlowNodeBaseClass, TArray<UClass*>& InOutNodesOrAddOnsArray)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::GatherNativeNodesOrAddOns);
+
 	// collect C++ Nodes or AddOns once per editor session
 	if (InOutNodesOrAddOnsArray.Num() > 0)
 	{
@@ -1273,6 +1449,8 @@ void UFlowGraphSchema::GatherNodes()
 		return;
 	}
 
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::GatherNodes);
+
 	bInitialGatherPerformed = true;
 
 	GatherNativeNodesOrAddOns(UFlowNode::StaticClass(), NativeFlowNodes);
@@ -1286,15 +1464,138 @@ void UFlowGraphSchema::GatherNodes()
 
 	TArray<FAssetData> FoundAssets;
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
-	AssetRegistryModule.Get().GetAssets(Filter, FoundAssets);
-	for (const FAssetData& AssetData : FoundAssets)
 	{
-		AddAsset(AssetData, true);
+		TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::GatherNodes_GetAssets);
+		AssetRegistryModule.Get().GetAssets(Filter, FoundAssets);
+	}
+
+	// AddAsset skips assets until the registry finished loading, so only the complete result is cached
+	const bool bUseCache = !AssetRegistryModule.Get().IsLoadingAssets();
+	const FString CacheKey = bUseCache ? GetBlueprintNodesCacheKey(FoundAssets) : FString();
+
+	if (!bUseCache || !LoadCachedBlueprintNodes(CacheKey, FoundAssets))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::GatherNodes_AddAssets);
+		for (const FAssetData& AssetData : FoundAssets)
+		{
+			AddAsset(AssetData, true);
+		}
+
+		if (bUseCache)
+		{
+			CacheBlueprintNodes(CacheKey);
+		}
 	}
 
 	UpdateGeneratedDisplayNames();
 }
 
+FString UFlowGraphSchema::GetBlueprintNodesCacheKey(const TArray<FAssetData>& FoundAssets)
+{
+	// bump whenever the rules of placing blueprint nodes change
+	static const TCHAR* CacheVersion = TEXT("6A0E4F1B9C2D4E7A8B3F5C6D7E8F9012");
+
+	TArray<TPair<FName, FIoHash>> PackageHashes;
+	PackageHashes.Reserve(FoundAssets.Num());
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	for (const FAssetData& AssetData : FoundAssets)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName);
+		PackageHashes.Emplace(AssetData.PackageName, PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash());
+	}
+
+	PackageHashes.Sort([](const TPair<FName, FIoHash>& A, const TPair<FName, FIoHash>& B)
+	{
+		return A.Key.LexicalLess(B.Key);
+	});
+
+	// placeability of blueprint nodes depends on their native parents as well
+	FSHA1 Hash;
+	for (const UClass* NativeClass : NativeFlowNodes)
+	{
+		const FString ClassPath = NativeClass->GetPathName();
+		Hash.UpdateWithString(*ClassPath, ClassPath.Len());
+	}
+	for (const UClass* NativeClass : NativeFlowNodeAddOns)
+	{
+		const FString ClassPath = NativeClass->GetPathName();
+		Hash.UpdateWithString(*ClassPath, ClassPath.Len());
+	}
+	for (const TPair<FName, FIoHash>& PackageHash : PackageHashes)
+	{
+		const FString PackageName = PackageHash.Key.ToString();
+		Hash.UpdateWithString(*PackageName, PackageName.Len());
+		Hash.Update(PackageHash.Value.GetBytes(), sizeof(FIoHash::ByteArray));
+	}
+
+	// Finalize() finishes the digest itself
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("FLOWNODES"), CacheVersion, *Hash.Finalize().ToString());
+}
+
+bool UFlowGraphSchema::LoadCachedBlueprintNodes(const FString& CacheKey, const TArray<FAssetData>& FoundAssets)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UFlowGraphSchema::LoadCachedBlueprintNodes);
+
+	TArray<uint8> CachedData;
+	if (!GetDerivedDataCacheRef().GetSynchronous(*CacheKey, CachedData, TEXT("FlowGraphSchema")))
+	{
+		return false;
+	}
+
+	TArray<FName> NodePackages;
+	TArray<FName> AddOnPackages;
+	FMemoryReader Ar(CachedData);
+	Ar << NodePackages;
+	Ar << AddOnPackages;
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	TMap<FName, const FAssetData*> AssetsByPackage;
+	AssetsByPackage.Reserve(FoundAssets.Num());
+	for (const FAssetData& AssetData : FoundAssets)
+	{
+		AssetsByPackage.Add(AssetData.PackageName, &AssetData);
+	}
+
+	for (const FName& PackageName : NodePackages)
+	{
+		if (const FAssetData* const* AssetData = AssetsByPackage.Find(PackageName))
+		{
+			BlueprintFlowNodes.Emplace(PackageName, **AssetData);
+		}
+	}
+
+	for (const FName& PackageName : AddOnPackages)
+	{
+		if (const FAssetData* const* AssetData = AssetsByPackage.Find(PackageName))
+		{
+			BlueprintFlowNodeAddOns.Emplace(PackageName, **AssetData);
+		}
+	}
+
+	UE_LOG(LogFlowEditor, Verbose, TEXT("Restored %d blueprint nodes and %d add-ons from the Derived Data Cache"), NodePackages.Num(), AddOnPackages.Num());
+	return true;
+}
+
+void UFlowGraphSchema::CacheBlueprintNodes(const FString& CacheKey)
+{
+	TArray<FName> NodePackages;
+	BlueprintFlowNodes.GenerateKeyArray(NodePackages);
+
+	TArray<FName> AddOnPackages;
+	BlueprintFlowNodeAddOns.GenerateKeyArray(AddOnPackages);
+
+	TArray<uint8> CachedData;
+	FMemoryWriter Ar(CachedData);
+	Ar << NodePackages;
+	Ar << AddOnPackages;
+
+	GetDerivedDataCacheRef().Put(*CacheKey, CachedData, TEXT("FlowGraphSchema"));
+}
+
 void UFlowGraphSchema::OnAssetAdded(const FAssetData& AssetData)
 {
 	AddAsset(AssetData, false);
@@ -1331,7 +1632,8 @@ void UFlowGraphSchema::AddAsset(const FAssetData& AssetData, const bool bBatch)
 
 	if (bAddedToMap && !bBatch)
 	{
-		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
+		// blueprints accepted by their Asset Registry tags get names once loaded by GetPlaceableNodeOrAddOnBlueprint
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
 		{
 			UClass* NodeClass = Blueprint->GeneratedClass;
 			UpdateGeneratedDisplayName(NodeClass, false);
@@ -1347,6 +1649,13 @@ bool UFlowGraphSchema::ShouldAddToBlueprintFlowNodesMap(const FAssetData& AssetD
 		return false;
 	}
 
+	FFlowNodeBlueprintMetadata Metadata;
+	if (FFlowNodeBlueprintMetadata::FromAssetData(AssetData, Metadata))
+	{
+		return Metadata.bPlaceable && Metadata.IsChildOf(FlowNodeBaseClass);
+	}
+
+	// blueprint saved before adding the tags
 	const UBlueprint* Blueprint = GetPlaceableNodeOrAddOnBlueprint(AssetData);
 	if (!IsValid(Blueprint))
 	{
@@ -1407,6 +1716,13 @@ UBlueprint* UFlowGraphSchema::GetPlaceableNodeOrAddOnBlueprint(const FAssetData&
 	UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
 	if (Blueprint && IsFlowNodeOrAddOnPlaceable(Blueprint->GeneratedClass))
 	{
+		// blueprint restored from the node cache is loaded for the first time here
+		static const FName NAME_GeneratedDisplayName("GeneratedDisplayName");
+		if (!Blueprint->GeneratedClass->HasMetaData(NAME_GeneratedDisplayName))
+		{
+			UpdateGeneratedDisplayName(Blueprint->GeneratedClass, true);
+		}
+
 		return Blueprint;
 	}
 
@@ -12,6 +12,7 @@
 #include "FlowAsset.h"
 #include "AddOns/FlowNodeAddOn.h"
 #include "Nodes/FlowNode.h"
+#include "Nodes/FlowNodeBlueprint.h"
 
 #include "EdGraph/EdGraph.h"
 #include "EdGraphNode_Comment.h"
@@ -25,6 +26,13 @@
 /////////////////////////////////////////////////////
 // Flow Node
 
+FFlowGraphSchemaAction_NewNode::FFlowGraphSchemaAction_NewNode(const FFlowNodeBlueprintMetadata& Metadata, const UFlowGraphSettings& GraphSettings)
+	: FEdGraphSchemaAction(GetNodeCategory(Metadata, GraphSettings), Metadata.DisplayName, Metadata.ToolTip, 0, FText::FromString(Metadata.Keywords))
+	, NodeClass(nullptr)
+	, NodeClassPath(Metadata.GeneratedClassPath.ToString())
+{
+}
+
 UEdGraphNode* FFlowGraphSchemaAction_NewNode::PerformAction(class UEdGraph* ParentGraph, UEdGraphPin* FromPin, const FVector2D Location, bool bSelectNewNode /* = true*/)
 {
 	// prevent adding new nodes while playing
@@ -33,6 +41,16 @@ UEdGraphNode* FFlowGraphSchemaAction_NewNode::PerformAction(class UEdGraph* Pare
 		return nullptr;
 	}
 
+	// palette built from the Asset Registry tags, blueprint is loaded only now
+	if (NodeClass == nullptr && NodeClassPath.IsValid())
+	{
+		NodeClass = NodeClassPath.TryLoadClass<UFlowNodeBase>();
+		if (NodeClass && NodeClass->ClassGeneratedBy)
+		{
+			UFlowGraphSchema::GetPlaceableNodeOrAddOnBlueprint(FAssetData(NodeClass->ClassGeneratedBy));
+		}
+	}
+
 	if (NodeClass)
 	{
 		return CreateNode(ParentGraph, FromPin, NodeClass, Location, bSelectNewNode);
@@ -212,6 +230,20 @@ FText FFlowGraphSchemaAction_NewNode::GetNodeCategory(const UFlowNodeBase* Node,
 	return FText::FromString(Node->GetNodeCategory());
 }
 
+FText FFlowGraphSchemaAction_NewNode::GetNodeCategory(const FFlowNodeBlueprintMetadata& Metadata, const UFlowGraphSettings& GraphSettings)
+{
+	// overriden classes are loaded with the settings, so compare paths instead of loading this class
+	for (const TPair<TSubclassOf<UFlowNode>, FString>& OverridenCategory : GraphSettings.OverridenNodeCategories)
+	{
+		if (OverridenCategory.Key && OverridenCategory.Key->GetClassPathName() == Metadata.GeneratedClassPath && !OverridenCategory.Value.IsEmpty())
+		{
+			return FText::FromString(OverridenCategory.Value);
+		}
+	}
+
+	return FText::FromString(Metadata.Category);
+}
+
 /////////////////////////////////////////////////////
 // New SubNode (AddOn)
 
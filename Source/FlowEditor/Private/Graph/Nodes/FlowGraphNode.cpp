@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Graph/Nodes/FlowGraphNode.h"
+#include "Asset/FlowRecordingPlayback.h"
 
 #include "FlowAsset.h"
 #include "AddOns/FlowNodeAddOn.h"
@@ -217,6 +218,20 @@ void UFlowGraphNode::OnGraphRefresh()
 	ReconstructNode();
 }
 
+void UFlowGraphNode::OnNodeClassRecompiled()
+{
+	if (bIsReconstructingNode)
+	{
+		return;
+	}
+
+	// reinstanced node doesn't have the delegate bound
+	SubscribeToExternalChanges();
+
+	bNeedsFullReconstruction = true;
+	ReconstructNode();
+}
+
 bool UFlowGraphNode::CanPlaceBreakpoints() const
 {
 	return true;
@@ -341,6 +356,11 @@ void UFlowGraphNode::ReconstructNode()
 		}
 
 		bNeedsFullReconstruction = false;
+
+		if (UFlowAsset* FlowAsset = NodeInstance ? NodeInstance->GetFlowAsset() : nullptr)
+		{
+			FlowAsset->MarkFullHarvestPending();
+		}
 	}
 
 	// This ensures the graph editor 'Refresh' button still rebuilds all the graph widgets even if the FlowGraphNode has nothing to update
@@ -740,6 +760,12 @@ EFlowNodeState UFlowGraphNode::GetActivationState() const
 		}
 	}
 
+	// streamed from the remote device
+	if (FFlowRecordingPlayback::Get().IsLive() && GetFlowAsset())
+	{
+		return FFlowRecordingPlayback::Get().GetLiveNodeState(*GetFlowAsset(), NodeGuid);
+	}
+
 	return EFlowNodeState::NeverActivated;
 }
 
@@ -887,8 +913,9 @@ void UFlowGraphNode::CreateInputPin(const FFlowPin& FlowPin, const int32 Index /
 	const FName PinSubCategory = NAME_None;
 	UObject* PinSubCategoryObject = FlowPin.GetPinSubCategoryObject().Get();
 	constexpr bool bIsReference = false;
+	const EPinContainerType PinContainerType = FlowPin.IsArray() ? EPinContainerType::Array : EPinContainerType::None;
 
-	const FEdGraphPinType PinType = FEdGraphPinType(PinCategory, PinSubCategory, PinSubCategoryObject, EPinContainerType::None, bIsReference, FEdGraphTerminalType());
+	const FEdGraphPinType PinType = FEdGraphPinType(PinCategory, PinSubCategory, PinSubCategoryObject, PinContainerType, bIsReference, FEdGraphTerminalType());
 	UEdGraphPin* NewPin = CreatePin(EGPD_Input, PinType, FlowPin.PinName, Index);
 	check(NewPin);
 
@@ -914,8 +941,9 @@ void UFlowGraphNode::CreateOutputPin(const FFlowPin& FlowPin, const int32 Index
 	const FName PinSubCategory = NAME_None;
 	UObject* PinSubCategoryObject = FlowPin.GetPinSubCategoryObject().Get();
 	constexpr bool bIsReference = false;
+	const EPinContainerType PinContainerType = FlowPin.IsArray() ? EPinContainerType::Array : EPinContainerType::None;
 
-	const FEdGraphPinType PinType = FEdGraphPinType(PinCategory, PinSubCategory, PinSubCategoryObject, EPinContainerType::None, bIsReference, FEdGraphTerminalType());
+	const FEdGraphPinType PinType = FEdGraphPinType(PinCategory, PinSubCategory, PinSubCategoryObject, PinContainerType, bIsReference, FEdGraphTerminalType());
 	UEdGraphPin* NewPin = CreatePin(EGPD_Output, PinType, FlowPin.PinName, Index);
 	check(NewPin);
 
@@ -1109,6 +1137,31 @@ void UFlowGraphNode::GetPinHoverText(const UEdGraphPin& Pin, FString& HoverTextO
 			}
 		}
 	}
+	else if (FFlowRecordingPlayback::Get().IsLoaded() && GetFlowAsset())
+	{
+		const bool bIsInput = Pin.Direction == EGPD_Input;
+		const int32 PinIndex = bIsInput ? InputPins.IndexOfByKey(&Pin) : OutputPins.IndexOfByKey(&Pin);
+		if (PinIndex == INDEX_NONE || PinIndex > MAX_uint8)
+		{
+			return;
+		}
+
+		TArray<float> ActivationTimes;
+		FFlowRecordingPlayback::Get().GetPinRecords(*GetFlowAsset(), NodeGuid, static_cast<uint8>(PinIndex),
+			bIsInput ? EFlowRecordedEventType::Input : EFlowRecordedEventType::Output, ActivationTimes);
+
+		if (!HoverTextOut.IsEmpty())
+		{
+			HoverTextOut.Append(LINE_TERMINATOR).Append(LINE_TERMINATOR);
+		}
+
+		HoverTextOut.Append(ActivationTimes.Num() == 0 ? FPinRecord::NoActivations : FPinRecord::PinActivations);
+		for (int32 i = 0; i < ActivationTimes.Num(); i++)
+		{
+			HoverTextOut.Append(LINE_TERMINATOR);
+			HoverTextOut.Appendf(TEXT("%d) %.3f s"), i + 1, ActivationTimes[i]);
+		}
+	}
 }
 
 const FName& UFlowGraphNode::GetPinCategoryFromFlowPin(const FFlowPin& FlowPin)
@@ -1640,6 +1693,11 @@ void UFlowGraphNode::ValidateGraphNode(FFlowMessageLog& MessageLog) const
 	}
 }
 
+bool UFlowGraphNode::IsConnectionValidationThreadSafe() const
+{
+	return GetClass()->GetOutermost() == UFlowGraphNode::StaticClass()->GetOutermost();
+}
+
 bool UFlowGraphNode::CanReconstructNode() const
 {
 	// Global states that should prevent ReconstructNode from running
@@ -4,8 +4,10 @@
 #include "DragFlowGraphNode.h"
 #include "FlowEditorStyle.h"
 #include "Graph/FlowGraph.h"
+#include "Graph/FlowGraphEditorSettings.h"
 #include "Graph/FlowGraphSettings.h"
 
+#include "FlowProfiler.h"
 #include "Nodes/FlowNode.h"
 
 #include "Debugger/FlowDebuggerSubsystem.h"
@@ -68,6 +70,8 @@ void SFlowGraphNode::Construct(const FArguments& InArgs, UFlowGraphNode* InNode)
 	UpdateGraphNode();
 
 	bDragMarkerVisible = false;
+
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(this, &SFlowGraphNode::OnObjectPropertyChanged);
 }
 
 SFlowGraphNode::~SFlowGraphNode()
@@ -76,32 +80,81 @@ SFlowGraphNode::~SFlowGraphNode()
 	FlowGraphNode->OnSignalModeChanged.Unbind();
 	FlowGraphNode->OnReconstructNodeCompleted.Unbind();
 
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+
 	FlowGraphNode = nullptr;
 }
 
+void SFlowGraphNode::UpdateNodeInfoCache() const
+{
+	const bool bPlaying = GEditor->PlayWorld != nullptr;
+	const UFlowNode* InspectedInstance = bPlaying ? FlowGraphNode->GetInspectedNodeInstance() : nullptr;
+	const EFlowNodeState ActivationState = InspectedInstance ? InspectedInstance->GetActivationState() : EFlowNodeState::NeverActivated;
+
+	if (bPlaying != bCachedWhilePlaying || InspectedInstance != CachedInspectedInstance.Get() || ActivationState != CachedActivationState)
+	{
+		bNodeInfoCacheValid = false;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (bNodeInfoCacheValid && (!bPlaying || CurrentTime - NodeInfoCacheTime < UFlowGraphEditorSettings::Get()->NodeInfoRefreshInterval))
+	{
+		return;
+	}
+
+	bNodeInfoCacheValid = true;
+	NodeInfoCacheTime = CurrentTime;
+	bCachedWhilePlaying = bPlaying;
+	CachedInspectedInstance = InspectedInstance;
+	CachedActivationState = ActivationState;
+
+	CachedDescription = FlowGraphNode->GetNodeDescription();
+	CachedStatus = bPlaying ? FlowGraphNode->GetStatusString() : FString();
+	CachedStatusColor = CachedStatus.IsEmpty() ? FLinearColor::White : FlowGraphNode->GetStatusBackgroundColor();
+	bCachedPreloaded = bPlaying && FlowGraphNode->IsContentPreloaded();
+}
+
+void SFlowGraphNode::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// AddOns are outered to the node they're attached to
+	const UFlowNodeBase* NodeInstance = FlowGraphNode ? FlowGraphNode->GetFlowNodeBase() : nullptr;
+	if (NodeInstance && Object && (Object == NodeInstance || Object->IsInOuter(NodeInstance)))
+	{
+		InvalidateNodeInfoCache();
+	}
+}
+
 void SFlowGraphNode::GetNodeInfoPopups(FNodeInfoContext* Context, TArray<FGraphInformationPopupInfo>& Popups) const
 {
-	const FString& Description = FlowGraphNode->GetNodeDescription(); 
-	if (!Description.IsEmpty())
+	UpdateNodeInfoCache();
+
+	if (!CachedDescription.IsEmpty())
 	{
-		const FGraphInformationPopupInfo DescriptionPopup = FGraphInformationPopupInfo(nullptr, UFlowGraphSettings::Get()->NodeDescriptionBackground, Description);
+		const FGraphInformationPopupInfo DescriptionPopup = FGraphInformationPopupInfo(nullptr, UFlowGraphSettings::Get()->NodeDescriptionBackground, CachedDescription);
 		Popups.Add(DescriptionPopup);
 	}
 
 	if (GEditor->PlayWorld)
 	{
-		const FString Status = FlowGraphNode->GetStatusString();
-		if (!Status.IsEmpty())
+		if (!CachedStatus.IsEmpty())
 		{
-			const FGraphInformationPopupInfo DescriptionPopup = FGraphInformationPopupInfo(nullptr, FlowGraphNode->GetStatusBackgroundColor(), Status);
+			const FGraphInformationPopupInfo DescriptionPopup = FGraphInformationPopupInfo(nullptr, CachedStatusColor, CachedStatus);
 			Popups.Add(DescriptionPopup);
 		}
-		else if (FlowGraphNode->IsContentPreloaded())
+		else if (bCachedPreloaded)
 		{
 			const FGraphInformationPopupInfo DescriptionPopup = FGraphInformationPopupInfo(nullptr, UFlowGraphSettings::Get()->NodeStatusBackground, TEXT("Preloaded"));
 			Popups.Add(DescriptionPopup);
 		}
 	}
+
+	float Heat = 0.0f;
+	FString ProfilerSummary;
+	if (GetProfilerHeat(Heat, ProfilerSummary))
+	{
+		const FGraphInformationPopupInfo ProfilerPopup = FGraphInformationPopupInfo(nullptr, FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, Heat), ProfilerSummary);
+		Popups.Add(ProfilerPopup);
+	}
 }
 
 const FSlateBrush* SFlowGraphNode::GetShadowBrush(bool bSelected) const
@@ -195,6 +248,8 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 void SFlowGraphNode::UpdateGraphNode()
 {
+	InvalidateNodeInfoCache();
+
 	InputPins.Empty();
 	OutputPins.Empty();
 
@@ -388,10 +443,38 @@ void SFlowGraphNode::UpdateGraphNode()
 	CreatePinWidgets();
 	CreateInputSideAddButton(LeftNodeBox);
 	CreateOutputSideAddButton(RightNodeBox);
-	CreateBelowPinControls(InnerVerticalBox);
+
+	if (ShouldDeferBelowPinControls())
+	{
+		InnerVerticalBox->AddSlot()
+			.AutoHeight()
+			[
+				SAssignNew(DeferredBelowPinsBox, SVerticalBox)
+			];
+	}
+	else
+	{
+		DeferredBelowPinsBox.Reset();
+		CreateBelowPinControls(InnerVerticalBox);
+		bBelowPinControlsCreated = true;
+	}
+
 	CreateAdvancedViewArrow(InnerVerticalBox);
 }
 
+bool SFlowGraphNode::ShouldDeferBelowPinControls() const
+{
+	// once created, rebuilding the node shouldn't change its layout for a frame
+	if (bBelowPinControlsCreated)
+	{
+		return false;
+	}
+
+	const int32 MinNodes = UFlowGraphEditorSettings::Get()->DeferredNodeDetailsMinNodes;
+	const UEdGraph* Graph = GraphNode ? GraphNode->GetGraph() : nullptr;
+	return MinNodes > 0 && Graph && Graph->Nodes.Num() >= MinNodes;
+}
+
 FSlateColor SFlowGraphNode::GetBorderBackgroundColor() const
 {
 	return SGraphNode::GetNodeTitleColor();
@@ -551,6 +634,48 @@ void SFlowGraphNode::CreateOrRebuildSubNodeBox(const TSharedPtr<SVerticalBox>& I
 		];
 }
 
+bool SFlowGraphNode::GetProfilerHeat(float& OutHeat, FString& OutSummary) const
+{
+#if FLOW_WITH_PROFILER
+	if (!FFlowProfiler::IsEnabled())
+	{
+		return false;
+	}
+
+	const UFlowNode* FlowNode = Cast<UFlowNode>(FlowGraphNode->GetFlowNodeBase());
+	const FFlowTemplateProfile* TemplateProfile = FlowNode ? FFlowProfiler::FindTemplateProfile(FlowGraphNode->GetFlowAsset()) : nullptr;
+	const FFlowProfileEntry* NodeEntry = TemplateProfile ? TemplateProfile->Nodes.Find(FlowNode->GetGuid()) : nullptr;
+	if (NodeEntry == nullptr)
+	{
+		return false;
+	}
+
+	EFlowProfileMetric Metric = EFlowProfileMetric::ExclusiveTime;
+	switch (UFlowGraphEditorSettings::Get()->ProfilerHeatmapMetric)
+	{
+		case EFlowProfilerHeatmapMetric::InclusiveTime:
+			Metric = EFlowProfileMetric::InclusiveTime;
+			break;
+		case EFlowProfilerHeatmapMetric::Triggers:
+			Metric = EFlowProfileMetric::Triggers;
+			break;
+		default: ;
+	}
+
+	double MaxValue = 0.0;
+	for (const TPair<FGuid, FFlowProfileEntry>& Entry : TemplateProfile->Nodes)
+	{
+		MaxValue = FMath::Max(MaxValue, Entry.Value.GetMetric(Metric));
+	}
+
+	OutHeat = MaxValue > 0.0 ? static_cast<float>(NodeEntry->GetMetric(Metric) / MaxValue) : 0.0f;
+	OutSummary = FString::Printf(TEXT("%.3f ms excl. / %.3f ms incl. / %lld triggers"), NodeEntry->ExclusiveTime * 1000.0, NodeEntry->InclusiveTime * 1000.0, NodeEntry->Triggers);
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool SFlowGraphNode::IsFlowGraphNodeSelected(UFlowGraphNode* Node) const
 {
 	return GetOwnerPanel().IsValid() && GetOwnerPanel()->SelectionManager.SelectedNodes.Contains(Node);
@@ -670,6 +795,14 @@ FSlateColor SFlowGraphNode::GetNodeTitleColor() const
 FSlateColor SFlowGraphNode::GetNodeBodyColor() const
 {
 	FLinearColor ReturnBodyColor = GraphNode->GetNodeBodyTintColor();
+
+	float Heat = 0.0f;
+	FString ProfilerSummary;
+	if (GetProfilerHeat(Heat, ProfilerSummary))
+	{
+		ReturnBodyColor = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, Heat);
+	}
+
 	if (FlowGraphNode->GetSignalMode() != EFlowSignalMode::Enabled)
 	{
 		ReturnBodyColor *= FLinearColor(1.0f, 1.0f, 1.0f, 0.5f); 
@@ -974,6 +1107,21 @@ FReply SFlowGraphNode::OnMouseButtonDown(const FGeometry& SenderGeometry, const
 	return FReply::Unhandled();
 }
 
+void SFlowGraphNode::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SGraphNode::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// far-zoomed nodes keep rendering without the config text and AddOns
+	if (DeferredBelowPinsBox.IsValid() && GetCurrentLOD() > EGraphRenderingLOD::LowestDetail)
+	{
+		const TSharedPtr<SVerticalBox> BelowPinsBox = DeferredBelowPinsBox;
+		DeferredBelowPinsBox.Reset();
+
+		CreateBelowPinControls(BelowPinsBox);
+		bBelowPinControlsCreated = true;
+	}
+}
+
 TSharedPtr<SGraphNode> SFlowGraphNode::GetSubNodeUnderCursor(const FGeometry& WidgetGeometry, const FPointerEvent& MouseEvent)
 {
 	// We just need to find the one WidgetToFind among our descendants.
@@ -0,0 +1,29 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "UObject/ObjectSaveContext.h"
+
+class UFlowAsset;
+
+/**
+ * Gathers content loaded by nodes of the Flow Asset and Sub Graphs it starts
+ * It's cooked into UFlowAsset::ContentDependencies, so the runtime can request the whole graph content in one batch
+ */
+class FLOWEDITOR_API FFlowAssetDependencies
+{
+public:
+	static void Register();
+	static void Unregister();
+
+	static void GatherContentDependencies(const UFlowAsset& FlowAsset, TArray<FSoftObjectPath>& OutPaths);
+
+private:
+	static void GatherContentDependencies(const UFlowAsset& FlowAsset, TArray<FSoftObjectPath>& OutPaths, TSet<const UFlowAsset*>& VisitedAssets);
+
+	// Sub Graph assets might be inlined by FFlowAssetOptimizer, so the incremental cook has to recook the asset after any of them changes
+	static void AddSubGraphCookDependencies(const UFlowAsset& FlowAsset, FObjectPreSaveContext& SaveContext);
+	static void OnObjectPreSave(UObject* Object, FObjectPreSaveContext SaveContext);
+
+	static FDelegateHandle PreSaveHandle;
+};
@@ -143,6 +143,11 @@ protected:
 	virtual void GoToParentInstance();
 	virtual bool CanGoToParentInstance();
 
+	static void ToggleProfiler();
+	static bool IsProfilerEnabled();
+
+	static void LoadRecording();
+
 	virtual void CreateWidgets();
 	virtual void CreateGraphWidget();
 
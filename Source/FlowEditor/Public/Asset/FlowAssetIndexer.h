@@ -6,6 +6,7 @@
 
 #include "IAssetIndexer.h"
 
+class UEdGraphNode;
 class UFlowAsset;
 class FSearchSerializer;
 
@@ -22,4 +23,7 @@ public:
 private:
 	// Variant of FBlueprintIndexer::IndexGraphs
 	void IndexGraph(const UFlowAsset* InFlowAsset, FSearchSerializer& Serializer) const;
+
+	// Indexes the node and its AddOns, which aren't part of the graph nodes
+	void IndexGraphNode(const UEdGraphNode* Node, FSearchSerializer& Serializer) const;
 };
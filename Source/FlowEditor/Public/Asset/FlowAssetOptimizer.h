@@ -0,0 +1,39 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/FlowPin.h"
+
+class UFlowAsset;
+class UFlowNode;
+class UFlowNode_SubGraph;
+
+/**
+ * Cook-time pass producing the runtime graph of the Flow Asset, enabled by UFlowSettings::bOptimizeGraphsOnCook
+ *  - Sub Graph nodes starting assets with bInlineWhenCooked are replaced with copies of the Sub Graph nodes
+ *  - connections to Reroute nodes and pass-through nodes are collapsed into connections to the node they finally trigger
+ *  - connections to disabled nodes are removed
+ *  - nodes not reachable from the Start node, Custom Inputs or any node without exec inputs are stripped
+ * Nodes keep their guids, stripped guids are recorded in UFlowAsset::StrippedNodeRedirects for SaveGames of unoptimized builds
+ * Runs only in the cook commandlet, as it modifies the loaded asset
+ */
+class FLOWEDITOR_API FFlowAssetOptimizer
+{
+public:
+	// Returns the number of stripped nodes
+	static int32 OptimizeForCook(UFlowAsset& FlowAsset);
+
+private:
+	// Inlining is skipped if the Sub Graph has data pins, custom asset class, nodes finishing the graph other than Finish or duplicate Custom Inputs
+	static bool InlineSubGraph(UFlowAsset& FlowAsset, UFlowNode_SubGraph& SubGraphNode);
+	static bool CanInlineSubGraph(const UFlowAsset& FlowAsset, const UFlowNode_SubGraph& SubGraphNode, const UFlowAsset& SubAsset);
+
+	// Connections of these nodes can be replaced with the connection of their only connected exec output
+	static bool CanCollapseNode(const UFlowNode& Node, const TSet<FGuid>& DataSupplierNodes);
+	static bool IsEntryNode(const UFlowNode& Node);
+
+	// Follows collapsed nodes, returns the invalid pin if the connection ends at a disabled node or unconnected output
+	static FConnectedPin ResolveConnection(const UFlowAsset& FlowAsset, const FConnectedPin& Connection, const TMap<FGuid, FConnectedPin>& CollapsedNodes);
+
+	static bool IsExecOutput(const UFlowNode& Node, const FName& PinName);
+};
@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SComboButton.h"
 #include "Widgets/Navigation/SBreadcrumbTrail.h"
+#include "Widgets/Views/SListView.h"
 
 #include "FlowAsset.h"
 
@@ -14,6 +15,27 @@ class UToolMenu;
 //////////////////////////////////////////////////////////////////////////
 // Flow Asset Instance List
 
+struct FFlowAssetInstanceListItem
+{
+	// Invalid for the "No instance selected" item
+	TWeakObjectPtr<UFlowAsset> Instance;
+
+	FName DisplayName;
+	FString OwnerName;
+
+	// Slot in SFlowAssetInstanceList::FilteredItems, INDEX_NONE if filtered out
+	int32 FilteredIndex = INDEX_NONE;
+
+	bool PassesFilter(const FString& FilterText) const
+	{
+		return FilterText.IsEmpty() || DisplayName.ToString().Contains(FilterText) || OwnerName.Contains(FilterText);
+	}
+};
+
+/**
+ * Picker of the inspected instance, lists thousands of PIE instances without a hitch
+ * List is virtualized and kept in sync with UFlowAsset::OnInstanceListChanged, instead of being rebuilt on every refresh
+ */
 class FLOWEDITOR_API SFlowAssetInstanceList : public SCompoundWidget
 {
 public:
@@ -26,17 +48,30 @@ public:
 	static EVisibility GetDebuggerVisibility();
 
 private:
-	void RefreshInstances();
+	typedef TSharedPtr<FFlowAssetInstanceListItem> FItemPtr;
 
-	TSharedRef<SWidget> OnGenerateWidget(TSharedPtr<FName> Item) const;
-	void OnSelectionChanged(TSharedPtr<FName> SelectedItem, ESelectInfo::Type SelectionType);
+	void RebuildInstances();
+	void OnInstanceListChanged(UFlowAsset* Instance, const bool bAdded);
+	void FilterItems();
+
+	TSharedRef<SWidget> OnGetMenuContent();
+	TSharedRef<ITableRow> OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const;
+	void OnFilterTextChanged(const FText& InFilterText);
+	void OnSelectionChanged(FItemPtr SelectedItem, ESelectInfo::Type SelectionType);
 	FText GetSelectedInstanceName() const;
 
+	// Selects the instance started by the actor selected in the level editor
+	FReply OnPickSelectedActor() const;
+	bool CanPickSelectedActor() const;
+
 	TWeakObjectPtr<UFlowAsset> TemplateAsset;
-	TSharedPtr<SComboBox<TSharedPtr<FName>>> Dropdown;
+	TSharedPtr<SComboButton> Dropdown;
+	TSharedPtr<SListView<FItemPtr>> ListView;
 
-	TArray<TSharedPtr<FName>> InstanceNames;
-	TSharedPtr<FName> SelectedInstance;
+	FItemPtr NoInstanceItem;
+	TMap<TWeakObjectPtr<UFlowAsset>, FItemPtr> Items;
+	TArray<FItemPtr> FilteredItems;
+	FString FilterText;
 
 	static FText NoInstanceSelectedText;
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "Logging/TokenizedMessage.h"
 
 #include "Debugger/FlowDebuggerSubsystem.h"
@@ -21,13 +22,22 @@ class FLOWEDITOR_API UFlowDebugEditorSubsystem : public UFlowDebuggerSubsystem
 public:
 	UFlowDebugEditorSubsystem();
 
+	virtual void Deinitialize() override;
+
 protected:
 	TMap<TWeakObjectPtr<UFlowAsset>, TSharedPtr<class IMessageLogListing>> RuntimeLogs;
 
 	virtual void OnInstancedTemplateAdded(UFlowAsset* AssetTemplate) override;
-	virtual void OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate) const override;
+	virtual void OnInstancedTemplateRemoved(UFlowAsset* AssetTemplate) override;
+
+	// Listings are rebuilt from the runtime log of the template at most every RuntimeLogRefreshInterval
+	TSet<TWeakObjectPtr<const UFlowAsset>> DirtyRuntimeLogs;
+	FTSTicker::FDelegateHandle RuntimeLogsTickerHandle;
+
+	void OnRuntimeMessageAdded(const UFlowAsset* AssetTemplate, const TSharedRef<FTokenizedMessage>& Message);
 
-	void OnRuntimeMessageAdded(const UFlowAsset* AssetTemplate, const TSharedRef<FTokenizedMessage>& Message) const;
+	bool FlushRuntimeLogs(float DeltaTime);
+	void FlushRuntimeLog(const UFlowAsset* AssetTemplate) const;
 
 	virtual void OnBeginPIE(const bool bIsSimulating);
 	virtual void OnResumePIE(const bool bIsSimulating);
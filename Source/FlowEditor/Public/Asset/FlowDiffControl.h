@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Asset/FlowObjectDiff.h"
+#include "Asset/FlowStructuralDiff.h"
 #include "DiffResults.h"
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 7
@@ -46,6 +47,9 @@ struct FLOWEDITOR_API FFlowGraphToDiff : public TSharedFromThis<FFlowGraphToDiff
 
 	TSharedPtr<FFlowObjectDiff> GetFlowObjectDiff(const FDiffResultItem& DiffResultItem);
 
+	/** GUID-keyed diff of Flow Nodes, computed without any widgets */
+	const TArray<FFlowStructuralDiffEntry>& GetStructuralDiff() const { return StructuralDiff; }
+
 	/** Source for list view */
 	TArray<TSharedPtr<FDiffResultItem>> DiffListSource;
 	TSharedPtr<TArray<FDiffSingleResult>> FoundDiffs;
@@ -61,6 +65,7 @@ private:
 	void OnGraphChanged(const FEdGraphEditAction& Action) const;
 
 	void BuildDiffSourceArray();
+	void DiffGraphsByGuid(TArray<FDiffSingleResult>& OutDiffs) const;
 
 	TSharedPtr<FFlowObjectDiff> GenerateFlowObjectDiff(const TSharedPtr<FDiffResultItem>& Differences);
 
@@ -68,6 +73,8 @@ private:
 
 	TMap<FString, TSharedPtr<FFlowObjectDiff>> FlowObjectDiffsByNodeName;
 
+	TArray<FFlowStructuralDiffEntry> StructuralDiff;
+
 	SFlowDiff* DiffWidget;
 	UEdGraph* GraphOld;
 	UEdGraph* GraphNew;
@@ -42,6 +42,36 @@ struct FLOWEDITOR_API FBlueprintToFlowPinName
 	}
 };
 
+// Settings of importing many blueprints at once
+struct FLOWEDITOR_API FFlowBatchImportParams
+{
+	TArray<FSoftObjectPath> Blueprints;
+	TSubclassOf<UFlowAsset> FlowAssetClass;
+
+	// Flow Asset is created next to the blueprint, named by the prefix and the blueprint name
+	FString FlowAssetPrefix = TEXT("FA_");
+
+	FName StartEventName = TEXT("BeginPlay");
+
+	// Blueprints listed in this file are skipped, every blueprint is appended once its Flow Asset is saved
+	// Allows resuming the import after a failure or cancelling
+	FString ProgressFilePath;
+
+	// Number of following blueprints loaded asynchronously while the current one is imported
+	int32 PrefetchCount = 8;
+
+	// Imported assets are released by the garbage collection every N blueprints, 0 disables it
+	int32 GarbageCollectionInterval = 50;
+};
+
+struct FLOWEDITOR_API FFlowBatchImportResult
+{
+	int32 Imported = 0;
+	int32 Skipped = 0;
+	int32 Failed = 0;
+	bool bCancelled = false;
+};
+
 /**
  * Groundwork for converting blueprint graphs to Flow Graph.
  * It's NOT meant to be universal, out-of-box solution as complexity of blueprint graphs conflicts with simplicity of Flow Graph.
@@ -61,9 +91,17 @@ public:
 	static UFlowAsset* ImportBlueprintGraph(UObject* BlueprintAsset, const TSubclassOf<UFlowAsset> FlowAssetClass, const FString FlowAssetName,
 											const TMap<FName, TSubclassOf<UFlowNode>> InFunctionsToFlowNodes, const TMap<TSubclassOf<UFlowNode>, FBlueprintToFlowPinName> InPinMappings, const FName StartEventName = TEXT("BeginPlay"));
 
+	// Imports blueprints one by one, saving every Flow Asset once it's imported. Can be cancelled from the progress dialog
+	static FFlowBatchImportResult ImportBlueprintGraphs(const FFlowBatchImportParams& Params,
+														const TMap<FName, TSubclassOf<UFlowNode>>& InFunctionsToFlowNodes, const TMap<TSubclassOf<UFlowNode>, FBlueprintToFlowPinName>& InPinMappings);
+
 	static void ImportBlueprintGraph(UBlueprint* Blueprint, UFlowAsset* FlowAsset, const FName StartEventName = TEXT("BeginPlay"));
 	static void ImportBlueprintFunction(const UFlowAsset* FlowAsset, const FImportedGraphNode& NodeImport, const TMap<FGuid, struct FImportedGraphNode>& SourceNodes, TMap<FGuid, class UFlowGraphNode*>& TargetNodes);
 
 	static void GetValidInputPins(const UEdGraphNode* GraphNode, TMap<const FName, const UEdGraphPin*>& Result);
 	static const UEdGraphPin* FindPinMatchingToProperty(UClass* FlowNodeClass, const FProperty* Property, const TMap<const FName, const UEdGraphPin*>Pins);
+
+private:
+	// Creates or loads the Flow Asset next to the blueprint and imports the graph, expects mappings to be set
+	static UFlowAsset* CreateFlowAssetFromBlueprint(UBlueprint* Blueprint, const TSubclassOf<UFlowAsset> FlowAssetClass, const FString& FlowAssetName, const FName StartEventName);
 };
@@ -43,8 +43,11 @@ public:
 
 	void DiffProperties(TArray<FSingleObjectDiffEntry>& OutPropertyDiffsArray) const;
 
+	/** Details views are created on the first selection of the diff, building them for every changed node is slow on large graphs */
+	void CreateDetailsViews();
+
 private:
-	void InitializeDetailsDiffFromNode(UEdGraphNode* Node, const UObject* Object, const FFlowGraphToDiff& GraphToDiff);
+	void InitializeObjectFromNode(UEdGraphNode* Node, const UObject* Object, const FFlowGraphToDiff& GraphToDiff);
 
 public:
 	//the tree entry for this diff object, which can be the parent tree node to other changes such as property changes,
@@ -58,6 +61,10 @@ public:
 	TSharedPtr<FDetailsDiff> OldDetailsView;
 	TSharedPtr<FDetailsDiff> NewDetailsView;
 
+	/** Objects displayed by details views */
+	TWeakObjectPtr<const UObject> OldObject;
+	TWeakObjectPtr<const UObject> NewObject;
+
 	//arguments used for FOnDiffEntryFocused.
 	TSharedPtr<FFlowObjectDiffArgs> DiffEntryFocusArg;
 	TArray<TSharedPtr<FFlowObjectDiffArgs>> PropertyDiffArgList;
@@ -0,0 +1,79 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "FlowExecutionRecorder.h"
+#include "FlowTypes.h"
+
+class UFlowAsset;
+
+/**
+ * Execution recording loaded in the editor, i.e. captured by Flow.Recorder in a cooked build
+ * Graphs of recorded templates show activations up to the playback time, if no instance is inspected
+ */
+class FLOWEDITOR_API FFlowRecordingPlayback
+{
+public:
+	static FFlowRecordingPlayback& Get();
+
+	bool Load(const FString& FilePath);
+	void Clear();
+
+	// Live recording is filled by FFlowRemoteDebugSession as events arrive, playback time follows the latest event
+	void BeginLive();
+	bool IsLive() const { return bLive; }
+
+	void AddLiveInstance(const uint32 InstanceId, FFlowRecordedInstance&& Instance);
+	void AddLiveEvent(const FFlowRecordedEvent& Event);
+	void SetLiveNodeState(const uint32 InstanceId, const uint16 NodeIndex, const EFlowNodeState State);
+
+	// Most recently reported state of the node in any streamed instance of this template
+	EFlowNodeState GetLiveNodeState(const UFlowAsset& Template, const FGuid& NodeGuid) const;
+
+	bool IsLoaded() const { return bLoaded; }
+	const FFlowExecutionRecording& GetRecording() const { return Recording; }
+
+	// Activations recorded after the playback time aren't shown
+	float GetTime() const { return Time; }
+	void SetTime(const float NewTime);
+
+	// Advances the playback time in real time multiplied by the speed, until the end of recording
+	void Play(const float InSpeed = 1.f);
+	void Pause();
+	bool IsPlaying() const { return TickerHandle.IsValid(); }
+
+	bool HasTemplate(const UFlowAsset& Template) const;
+
+	// Most recent activation time of every output pin of every node of this template, recorded until the playback time
+	void GetWireRecords(const UFlowAsset& Template, TMap<FGuid, TMap<uint8, float>>& OutRecords) const;
+
+	// Activation times of the pin, recorded until the playback time
+	void GetPinRecords(const UFlowAsset& Template, const FGuid& NodeGuid, const uint8 PinIndex, const EFlowRecordedEventType EventType, TArray<float>& OutTimes) const;
+
+private:
+	template <typename PredicateType>
+	void ForEachTemplateEvent(const UFlowAsset& Template, PredicateType Predicate) const;
+
+	bool Tick(float DeltaTime);
+
+	// Groups Recording.Events by the template path of the instance
+	void BuildEventsByTemplate();
+
+	// Drops the oldest events of the live recording, once it exceeds Flow.RemoteDebug.MaxLiveEvents
+	void TrimLiveEvents();
+
+	FFlowExecutionRecording Recording;
+	bool bLoaded = false;
+	bool bLive = false;
+
+	// By the template path
+	TMap<FString, TMap<FGuid, EFlowNodeState>> LiveNodeStates;
+
+	// Indices of Recording.Events, grouped by the template path of the instance
+	TMap<FString, TArray<int32>> EventsByTemplate;
+
+	float Time = 0.f;
+	float Speed = 1.f;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
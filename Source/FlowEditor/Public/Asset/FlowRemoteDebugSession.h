@@ -0,0 +1,43 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Templates/UniquePtr.h"
+
+namespace UE::Trace
+{
+	class FAnalysisProcessor;
+	class FStoreClient;
+	class IInDataStream;
+}
+
+class FFlowRemoteDebugAnalyzer;
+
+/**
+ * Editor end of FFlowRemoteDebug, reads the live trace session of the device from the trace store
+ * Streamed activations are shown on graphs like a recording loaded from the file, see FFlowRecordingPlayback::BeginLive
+ * The device has to run with -trace=FlowDebug -tracehost=<machine running the trace store>, instances are selected with Flow.RemoteDebug.Watch on the device
+ */
+class FLOWEDITOR_API FFlowRemoteDebugSession
+{
+public:
+	static FFlowRemoteDebugSession& Get();
+
+	// Connects to the most recent live session in the trace store
+	bool Connect(const FString& StoreHost = TEXT("localhost"));
+	void Disconnect();
+
+	bool IsConnected() const { return Processor.IsValid(); }
+
+private:
+	// Moves events received by the analysis thread to the playback
+	bool Tick(float DeltaTime);
+
+	TUniquePtr<UE::Trace::FStoreClient> StoreClient;
+	TUniquePtr<UE::Trace::IInDataStream> DataStream;
+	TSharedPtr<FFlowRemoteDebugAnalyzer> Analyzer;
+	TUniquePtr<UE::Trace::FAnalysisProcessor> Processor;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
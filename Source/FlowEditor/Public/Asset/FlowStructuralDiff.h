@@ -0,0 +1,58 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/FlowPin.h"
+
+class UFlowAsset;
+class UFlowNodeBase;
+
+enum class EFlowStructuralDiffType : uint8
+{
+	NodeAdded,
+	NodeRemoved,
+	NodeClassChanged,
+
+	// PropertyName is the changed editable property of the node
+	PropertyChanged,
+
+	// PinName is the output pin, OldConnection or NewConnection is empty if the pin wasn't connected in that revision
+	ConnectionChanged,
+
+	// Added, removed or reordered AddOns, or PropertyName changed on one of them
+	AddOnsChanged
+};
+
+struct FLOWEDITOR_API FFlowStructuralDiffEntry
+{
+	EFlowStructuralDiffType Type = EFlowStructuralDiffType::NodeAdded;
+	FGuid NodeGuid;
+
+	FName PinName;
+	FConnectedPin OldConnection;
+	FConnectedPin NewConnection;
+
+	FName PropertyName;
+};
+
+/**
+ * GUID-keyed diff of Nodes of two Flow Asset revisions
+ * Doesn't touch the graph or any widget, so it can run headless, i.e. in review tools, and before SFlowDiff builds any panel
+ */
+class FLOWEDITOR_API FFlowStructuralDiff
+{
+public:
+	// Entries are sorted by the node GUID, so the result doesn't depend on the order of the Nodes map
+	static void DiffAssets(const UFlowAsset& OldAsset, const UFlowAsset& NewAsset, TArray<FFlowStructuralDiffEntry>& OutEntries);
+
+	// GUIDs of nodes that were added, removed or changed in any way
+	static void GetChangedNodes(const TArray<FFlowStructuralDiffEntry>& Entries, TSet<FGuid>& OutNodeGuids);
+
+	// Gathers editable properties with different values, returns true if there was any. Both objects must be of the same class
+	static bool FindChangedProperties(const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, TArray<FName>& OutPropertyNames, const bool bStopOnFirst = false);
+
+private:
+	static void DiffNodes(const FGuid& NodeGuid, const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, TArray<FFlowStructuralDiffEntry>& OutEntries);
+	static void DiffConnections(const FGuid& NodeGuid, const TMap<FName, FConnectedPin>& OldConnections, const TMap<FName, FConnectedPin>& NewConnections, TArray<FFlowStructuralDiffEntry>& OutEntries);
+	static bool AreAddOnsIdentical(const UFlowNodeBase& OldNode, const UFlowNodeBase& NewNode, FName& OutPropertyName);
+};
@@ -0,0 +1,28 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Asset/FlowImportUtils.h"
+#include "FlowImportBlueprintsCommandlet.generated.h"
+
+/**
+ * Converts blueprint graphs to Flow Assets in bulk, see UFlowImportUtils::ImportBlueprintGraphs
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowImportBlueprints -Paths=/Game/Legacy+/Game/Quests
+ *        [-FlowAssetClass=/Script/Flow.FlowAsset] [-Prefix=FA_] [-StartEvent=BeginPlay] [-ProgressFile=<path>] [-Prefetch=8] [-GCInterval=50] [-Restart]
+ * Progress is stored in Saved/FlowImport/<Prefix>Progress.txt by default, so running the commandlet again resumes the import
+ * Projects provide function to node mappings by subclassing it and overriding GetImportMappings
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowImportBlueprintsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFlowImportBlueprintsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	virtual void GetImportMappings(TMap<FName, TSubclassOf<UFlowNode>>& OutFunctionsToFlowNodes, TMap<TSubclassOf<UFlowNode>, FBlueprintToFlowPinName>& OutPinMappings) const {}
+};
@@ -0,0 +1,23 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlowMemoryReportCommandlet.generated.h"
+
+/**
+ * Reports memory of all Flow Assets of the project as they would be cooked, exported as CSV to Saved/Profiling/Flow
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowMemoryReport [-Paths=/Game/Quests+/Game/Dialogues] [-SortBy=Instance|Template|CompiledGraph|Content]
+ *		[-InstanceBudgetKB=64] [-ContentBudgetMB=256] [-Output=<File.csv>]
+ * Returns 1 if any asset exceeds the given per-platform budgets, so it can guard the content on CI
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowMemoryReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFlowMemoryReportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,22 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlowValidateAssetsCommandlet.generated.h"
+
+/**
+ * Validates all Flow Assets of the project, meant to be run on CI
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowValidateAssets [-Paths=/Game/Quests+/Game/Dialogues] [-WarningsAsErrors]
+ * Returns 1 if any asset failed validation, logs the time spent on every asset and the total time
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowValidateAssetsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFlowValidateAssetsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -16,6 +16,7 @@
 #include "Templates/TypeHash.h"
 #include "Templates/UnrealTemplate.h"
 #include "Types/SlateEnums.h"
+#include "UObject/SoftObjectPath.h"
 #include "UObject/WeakObjectPtr.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
@@ -27,6 +28,7 @@ class ITableRow;
 class SWidget;
 class UFlowGraphNode;
 class UEdGraphNode;
+struct FSearchRecord;
 
 /** Item that matched the search results */
 class FFindInFlowResult
@@ -38,6 +40,9 @@ public:
 	/** Create a flow node result */
 	FFindInFlowResult(const FString& InValue, TSharedPtr<FFindInFlowResult>& InParent, UEdGraphNode* InNode, bool bInIsSubGraphNode = false);
 
+	/** Create a result found in the Asset Search index, InObjectPath is empty for the asset itself */
+	FFindInFlowResult(const FString& InValue, TSharedPtr<FFindInFlowResult>& InParent, const FSoftObjectPath& InAssetPath, const FString& InObjectPath, const FString& InPropertyName);
+
 	/** Called when user clicks on the search item */
 	FReply OnClick(TWeakPtr<class FFlowAssetEditor> FlowAssetEditor,  TSharedPtr<FFindInFlowResult> Root);
 	
@@ -73,11 +78,26 @@ public:
 
 	/** Whether this item is a subgraph node */
 	bool bIsSubGraphNode = false;
+
+	/** Asset containing the indexed object, set only for results found in the project */
+	FSoftObjectPath AssetPath;
+
+	/** Full path of the indexed graph node or flow node */
+	FString ObjectPath;
+
+	/** Name of the matched indexed property */
+	FString PropertyName;
+
+private:
+	/** Opens the asset and focuses the indexed node */
+	void OpenProjectResult() const;
 };
 
 /** Widget for searching for (Flow nodes) across focused FlowNodes */
 class SFindInFlow : public SCompoundWidget
 {
+	friend struct FFlowEditorBenchmark;
+
 public:
 	SLATE_BEGIN_ARGS(SFindInFlow){}
 	SLATE_END_ARGS()
@@ -109,6 +129,9 @@ private:
 	/** Called when whether find in sub graph changed */
 	void OnFindInSubGraphStateChanged(ECheckBoxState CheckBoxState);
 
+	/** Called when whether find in the whole project changed */
+	void OnFindInProjectStateChanged(ECheckBoxState CheckBoxState);
+
 	/** Called when a new row is being generated */
 	TSharedRef<ITableRow> OnGenerateRow(FSearchResult InItem, const TSharedRef<STableViewBase>& OwnerTable);
 
@@ -118,6 +141,15 @@ private:
 	/** Find any results that contain all of the tokens */
 	void MatchTokens(const TArray<FString>& Tokens);
 
+	/** Fills the tree with ItemsFound, or the fake result if empty */
+	void RefreshTree(const FText& EmptyResultsText);
+
+	/** Queries the Asset Search index, results arrive asynchronously */
+	void StartProjectSearch();
+
+	/** Adds results of the project query, grouped by Flow Assets */
+	void OnProjectSearchResults(TArray<FSearchRecord>&& Records, const uint32 QueryId);
+
 	/** Find if child contains all of the tokens and add a result accordingly */
 	static void MatchTokensInChild(const TArray<FString>& Tokens, UEdGraphNode* Child, FSearchResult ParentNode);
 	
@@ -148,4 +180,10 @@ private:
 
 	/** Using to control whether search in sub graph */
 	bool bFindInSubGraph = false;
+
+	/** Using to control whether search all Flow Assets indexed by Asset Search */
+	bool bFindInProject = false;
+
+	/** Incremented for every project query, so results of outdated queries are ignored */
+	uint32 ProjectQueryId = 0;
 };
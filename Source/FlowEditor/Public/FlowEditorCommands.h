@@ -19,6 +19,8 @@ public:
 	TSharedPtr<FUICommandInfo> EditAssetDefaults;
 
 	TSharedPtr<FUICommandInfo> GoToParentInstance;
+	TSharedPtr<FUICommandInfo> ToggleProfiler;
+	TSharedPtr<FUICommandInfo> LoadRecording;
 
 	virtual void RegisterCommands() override;
 };
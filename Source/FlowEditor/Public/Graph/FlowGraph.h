@@ -8,6 +8,7 @@
 #include "FlowGraph.generated.h"
 
 class SFlowGraphEditor;
+struct FFlowGraphWirePaths;
 class UFlowGraphNode;
 class UFlowGraphSchema;
 
@@ -30,6 +31,10 @@ protected:
 	uint32 bIsLoadingGraph : 1;
 
 	bool bIsSavingGraph = false;
+
+	// Highlighted wires of the inspected instance, reused by connection drawing policies until the instance records change
+	friend class FFlowGraphConnectionDrawingPolicy;
+	TSharedPtr<FFlowGraphWirePaths> DebugWirePaths;
 	
 public:
 	static void CreateGraph(UFlowAsset* InFlowAsset);
@@ -38,6 +43,7 @@ public:
 
 protected:
 	void RecursivelyRefreshAddOns(UFlowGraphNode& FromFlowGraphNode);
+	static bool RecursivelyReconstructNodesOfClasses(UFlowGraphNode& FromFlowGraphNode, const TArray<const UClass*>& RecompiledClasses);
 	static void RecursivelySetupAllFlowGraphNodesForEditing(UFlowGraphNode& FromFlowGraphNode);
 
 public:	
@@ -48,6 +54,10 @@ public:
 	UFlowAsset* GetFlowAsset() const;
 	void ValidateAsset(FFlowMessageLog& MessageLog);
 
+	// Reconstructs nodes and AddOns of the recompiled classes or their subclasses, then notifies the graph once
+	// Returns true if any node was reconstructed
+	bool ReconstructNodesOfClasses(const TArray<const UClass*>& RecompiledClasses);
+
 	// UObject
 	virtual void Serialize(FArchive& Ar) override;
 	// --
@@ -24,6 +24,21 @@ struct FLOWEDITOR_API FFlowGraphConnectionDrawingPolicyFactory : public FGraphPa
 
 class FSlateWindowElementList;
 class UEdGraph;
+class UFlowAsset;
+
+// Highlighted wires of the inspected instance, cached by the graph, as drawing policies are recreated on every paint
+struct FLOWEDITOR_API FFlowGraphWirePaths
+{
+	TMap<UEdGraphPin*, UEdGraphPin*> RecentPaths;
+	TMap<UEdGraphPin*, UEdGraphPin*> RecordedPaths;
+
+	TWeakObjectPtr<const UFlowAsset> Instance;
+	uint32 WireRecordsVersion = 0;
+	float RecentWireDuration = 0.0f;
+
+	// Paths are rebuilt once the first recent wire fades out
+	double RecentPathsExpiry = TNumericLimits<double>::Max();
+};
 
 // This class draws the connections between nodes
 class FLOWEDITOR_API FFlowGraphConnectionDrawingPolicy : public FConnectionDrawingPolicy
@@ -42,8 +57,7 @@ class FLOWEDITOR_API FFlowGraphConnectionDrawingPolicy : public FConnectionDrawi
 
 	// runtime values
 	UEdGraph* GraphObj;
-	TMap<UEdGraphPin*, UEdGraphPin*> RecentPaths;
-	TMap<UEdGraphPin*, UEdGraphPin*> RecordedPaths;
+	TSharedPtr<const FFlowGraphWirePaths> WirePaths;
 	TMap<UEdGraphPin*, UEdGraphPin*> SelectedPaths;
 
 	//Used to help reversing pins on nodes that go backwards
@@ -54,6 +68,12 @@ public:
 
 	void BuildPaths();
 
+private:
+	void BuildInstancePaths(const UFlowAsset& FlowAsset, const UFlowAsset& FlowInstance, const double CurrentTime, FFlowGraphWirePaths& OutPaths) const;
+	void BuildPlaybackPaths(const UFlowAsset& FlowAsset, FFlowGraphWirePaths& OutPaths) const;
+
+public:
+
 	// FConnectionDrawingPolicy interface
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
 	virtual void DrawConnection(int32 LayerId, const FVector2D& Start, const FVector2D& End, const FConnectionParams& Params) override;
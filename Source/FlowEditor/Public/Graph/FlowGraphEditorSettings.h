@@ -13,6 +13,14 @@ enum class EFlowNodeDoubleClickTarget : uint8
 	PrimaryAssetOrNodeDefinition UMETA(Tooltip = "First try opening the asset then if there is none, open the node class") 
 };
 
+UENUM()
+enum class EFlowProfilerHeatmapMetric : uint8
+{
+	ExclusiveTime UMETA(Tooltip = "Time spent in the node itself"),
+	InclusiveTime UMETA(Tooltip = "Time spent in the node and nodes triggered synchronously by its outputs"),
+	Triggers      UMETA(Tooltip = "Number of triggered inputs")
+};
+
 /**
  *
  */
@@ -56,6 +64,16 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Nodes", meta = (EditCondition = "bShowSubGraphPreview"))
 	FVector2D SubGraphPreviewSize;
 
+	// Nodes of graphs with at least this many nodes create the config text and AddOn widgets once they come into view
+	// Speeds up opening very large graphs, 0 creates all widgets immediately
+	UPROPERTY(config, EditAnywhere, Category = "Nodes", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 DeferredNodeDetailsMinNodes;
+
+	// Node description and status popups are refreshed at most this often while playing, these might call Blueprint events of every visible node
+	// While editing, popups are refreshed only after changing the node
+	UPROPERTY(config, EditAnywhere, Category = "Nodes", AdvancedDisplay, meta = (ClampMin = 0.0f, Units = "s"))
+	float NodeInfoRefreshInterval;
+
 	/** Enable hot reload for native flow nodes?
 	 * WARNING: hot reload can easily crash the editor and you can lose progress */
 	UPROPERTY(EditAnywhere, Config, Category = "Nodes", AdvancedDisplay)
@@ -67,6 +85,14 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Wires")
 	bool bHighlightOutputWiresOfSelectedNodes;
 
+	// Runtime Log tab is refreshed at most this often while playing, noisy graphs would otherwise update it on every message
+	UPROPERTY(EditAnywhere, config, Category = "Runtime Log", meta = (ClampMin = 0.0f, Units = "s"))
+	float RuntimeLogRefreshInterval;
+
+	// Colours graph nodes by this value while the Profiler is enabled in the toolbar
+	UPROPERTY(EditAnywhere, config, Category = "Profiler")
+	EFlowProfilerHeatmapMetric ProfilerHeatmapMetric;
+
 public:
 	virtual FName GetCategoryName() const override { return FName("Flow Graph"); }
 	virtual FText GetSectionText() const override { return INVTEXT("User Settings"); }
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "EdGraph/EdGraphSchema.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
 
 #include "FlowGraphSchema.generated.h"
 
@@ -13,6 +15,8 @@ class UFlowNode;
 class UFlowNodeAddOn;
 class UFlowNodeBase;
 class UFlowGraphNode;
+struct FFlowNodeBlueprintMetadata;
+struct FFlowPlaceableNodesCache;
 
 DECLARE_MULTICAST_DELEGATE(FFlowGraphSchemaRefresh);
 
@@ -22,6 +26,7 @@ class FLOWEDITOR_API UFlowGraphSchema : public UEdGraphSchema
 	GENERATED_UCLASS_BODY()
 
 	friend class UFlowGraph;
+	friend struct FFlowEditorBenchmark;
 
 private:
 	static bool bInitialGatherPerformed;
@@ -38,6 +43,10 @@ private:
 
 	static bool bBlueprintCompilationPending;
 
+	// Flow Node blueprints compiled since the last refresh, graphs are refreshed once on the next tick
+	static TArray<TWeakObjectPtr<UBlueprint>> RecompiledBlueprints;
+	static FTSTicker::FDelegateHandle RecompiledBlueprintsTickerHandle;
+
 public:
 	static void SubscribeToAssetChanges();
 	static void GetPaletteActions(FGraphActionMenuBuilder& ActionMenuBuilder, const UFlowAsset* EditedFlowAsset, const FString& CategoryName);
@@ -87,6 +96,12 @@ public:
 	 */
 	virtual bool ArePinTypesCompatible(const FEdGraphPinType& Output, const FEdGraphPinType& Input, const UClass* CallingContext = NULL, bool bIgnoreArray = false) const;
 
+	/**
+	 * Whether CanCreateConnection and ArePinsCompatible can be called from worker threads during the asset validation
+	 * Only the plugin schema opts in, subclasses overriding these checks should override this once they're thread-safe
+	 */
+	virtual bool IsConnectionValidationThreadSafe() const;
+
 	/**
 	 * Returns the connection response for connecting PinA to PinB, which have already been determined to be compatible
 	 * types with a compatible direction.  InputPin and OutputPin are PinA and PinB or vis versa, indicating their direction.
@@ -124,7 +139,12 @@ protected:
 private:
 	static void ApplyNodeOrAddOnFilter(const UFlowAsset* AssetClassDefaults, const UClass* FlowNodeClass, TArray<UFlowNodeBase*>& FilteredNodes);
 	static void GetFlowNodeActions(FGraphActionMenuBuilder& ActionMenuBuilder, const UFlowAsset* EditedFlowAsset, const FString& CategoryName);
-	static TArray<UFlowNodeBase*> GetFilteredPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const TArray<UClass*>& InNativeNodesOrAddOns, const TMap<FName, FAssetData>& InBlueprintNodesOrAddOns);
+	// Blueprints not loaded yet are filtered by their Asset Registry tags, added to OutUnloadedBlueprints if provided, otherwise loaded if they pass the filter
+	static TArray<UFlowNodeBase*> GetFilteredPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const TArray<UClass*>& InNativeNodesOrAddOns, const TMap<FName, FAssetData>& InBlueprintNodesOrAddOns, TArray<FFlowNodeBlueprintMetadata>* OutUnloadedBlueprints = nullptr);
+
+	// Filtered nodes or addons, shared by assets of the same class and mount point until the node list changes
+	static const FFlowPlaceableNodesCache& GetCachedPlaceableNodesOrAddOns(const UFlowAsset* EditedFlowAsset, const bool bAddOns);
+	static void ClearPlaceableNodesCache();
 
 	static void GetCommentAction(FGraphActionMenuBuilder& ActionMenuBuilder, const UEdGraph* CurrentGraph = nullptr);
 
@@ -132,11 +152,17 @@ private:
 
 	static void OnBlueprintPreCompile(UBlueprint* Blueprint);
 	static void OnBlueprintCompiled();
+	static bool RefreshAfterBlueprintsCompiled(float DeltaTime);
 	static void OnHotReload(EReloadCompleteReason ReloadCompleteReason);
 
 	static void GatherNativeNodesOrAddOns(const TSubclassOf<UFlowNodeBase>& FlowNodeBaseClass, TArray<UClass*>& InOutNodesOrAddOnsArray);
 	static void GatherNodes();
 
+	// Blueprint nodes found by the previous gather of the same assets are cached in the Derived Data Cache, so the editor startup doesn't load every blueprint
+	static FString GetBlueprintNodesCacheKey(const TArray<FAssetData>& FoundAssets);
+	static bool LoadCachedBlueprintNodes(const FString& CacheKey, const TArray<FAssetData>& FoundAssets);
+	static void CacheBlueprintNodes(const FString& CacheKey);
+
 	static void OnAssetAdded(const FAssetData& AssetData);
 	static void AddAsset(const FAssetData& AssetData, const bool bBatch);
 	static bool ShouldAddToBlueprintFlowNodesMap(const FAssetData& AssetData, const TSubclassOf<UBlueprint>& BlueprintClass, const TSubclassOf<UFlowNodeBase>& FlowNodeBaseClass);
@@ -153,4 +179,8 @@ public:
 private:
 	// ID for checking dirty status of node titles against
 	static int32 CurrentCacheRefreshID;
+
+	// By the Flow Asset class and the mount point of the asset, as plugin reference restrictions depend on it
+	static TMap<TPair<FObjectKey, FName>, FFlowPlaceableNodesCache> PlaceableNodesCache;
+	static TMap<TPair<FObjectKey, FName>, FFlowPlaceableNodesCache> PlaceableAddOnsCache;
 };
@@ -9,6 +9,7 @@
 #include "FlowGraphSchema_Actions.generated.h"
 
 class UFlowGraphSettings;
+struct FFlowNodeBlueprintMetadata;
 
 /** Action to add a node to the graph */
 USTRUCT()
@@ -19,6 +20,10 @@ struct FLOWEDITOR_API FFlowGraphSchemaAction_NewNode : public FEdGraphSchemaActi
 	UPROPERTY()
 	TObjectPtr<class UClass> NodeClass;
 
+	// Class of the blueprint node not loaded yet, loaded on performing the action
+	UPROPERTY()
+	FSoftClassPath NodeClassPath;
+
 	static FName StaticGetTypeId()
 	{
 		static FName Type("FFlowGraphSchemaAction_NewNode");
@@ -43,6 +48,8 @@ struct FLOWEDITOR_API FFlowGraphSchemaAction_NewNode : public FEdGraphSchemaActi
 	{
 	}
 
+	explicit FFlowGraphSchemaAction_NewNode(const FFlowNodeBlueprintMetadata& Metadata, const UFlowGraphSettings& GraphSettings);
+
 	// FEdGraphSchemaAction
 	virtual UEdGraphNode* PerformAction(class UEdGraph* ParentGraph, UEdGraphPin* FromPin, const FVector2D Location, bool bSelectNewNode = true) override;
 	// --
@@ -53,6 +60,7 @@ struct FLOWEDITOR_API FFlowGraphSchemaAction_NewNode : public FEdGraphSchemaActi
 
 private:
 	static FText GetNodeCategory(const UFlowNodeBase* Node, const UFlowGraphSettings& GraphSettings);
+	static FText GetNodeCategory(const FFlowNodeBlueprintMetadata& Metadata, const UFlowGraphSettings& GraphSettings);
 };
 
 /** Action to add a subnode to the selected node */
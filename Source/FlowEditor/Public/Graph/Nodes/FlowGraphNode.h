@@ -75,6 +75,10 @@ public:
 	virtual void OnGraphRefresh();
 	virtual bool CanPlaceBreakpoints() const;
 
+	// Called by the graph after the class of the node instance was recompiled, the instance might have been replaced
+	// Doesn't notify the graph, so the graph can refresh once for all reconstructed nodes
+	void OnNodeClassRecompiled();
+
 //////////////////////////////////////////////////////////////////////////
 // Graph node
 
@@ -208,6 +212,10 @@ public:
 	// @return true, if pins cannot be connected due to node's inner logic, put message for user in OutReason
 	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const { return false; }
 
+	// @return true, if IsConnectionDisallowed can be called from worker threads during the asset validation
+	// Only native graph nodes of the plugin opt in, project classes should override this once their checks are thread-safe
+	virtual bool IsConnectionValidationThreadSafe() const;
+
 protected:
 	// Gets the PinCategory from the FlowPin
 	// (accounting for FFlowPin structs that predate the PinCategory field)
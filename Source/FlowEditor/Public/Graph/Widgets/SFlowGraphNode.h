@@ -86,6 +86,7 @@ virtual void GetOverlayBrushes(bool bSelected, const FVector2f& WidgetSize, TArr
 
 	// SWidget
 	virtual FReply OnMouseButtonDown(const FGeometry& SenderGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 	// --
 
 	// purposely overriden non-virtual methods, added PR #9791 to made these methods virtual: https://github.com/EpicGames/UnrealEngine/pull/9791
@@ -130,8 +131,20 @@ protected:
 
 	void CreateOrRebuildSubNodeBox(const TSharedPtr<SVerticalBox>& MainBox);
 
+	/** nodes of very large graphs create controls below pins once painted, Tick isn't called for culled nodes */
+	bool ShouldDeferBelowPinControls() const;
+
 	bool IsFlowGraphNodeSelected(UFlowGraphNode* Node) const;
 
+	/** cost of this node relative to the most expensive node of the graph, while the Flow Profiler is enabled */
+	bool GetProfilerHeat(float& OutHeat, FString& OutSummary) const;
+
+	/** refreshes strings of info popups, if invalidated or the refresh interval passed while playing */
+	void UpdateNodeInfoCache() const;
+	void InvalidateNodeInfoCache() const { bNodeInfoCacheValid = false; }
+
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
 protected:
 	// The graph node this slate widget is representing
 	UFlowGraphNode* FlowGraphNode = nullptr;
@@ -144,6 +157,26 @@ protected:
 	TSharedPtr<SVerticalBox> SubNodeBox;
 	TSharedPtr<STextBlock> ConfigTextBlock;
 
+	// Slot waiting for CreateBelowPinControls, valid until the node is painted at the sufficient LOD
+	TSharedPtr<SVerticalBox> DeferredBelowPinsBox;
+	bool bBelowPinControlsCreated = false;
+
+	// Info popups are collected on every paint, their strings might come from Blueprint events
+	mutable FString CachedDescription;
+	mutable FString CachedStatus;
+	mutable FLinearColor CachedStatusColor = FLinearColor::White;
+	mutable bool bCachedPreloaded = false;
+
+	// Changing any of these refreshes the cache immediately
+	mutable EFlowNodeState CachedActivationState = EFlowNodeState::NeverActivated;
+	mutable TWeakObjectPtr<const UFlowNode> CachedInspectedInstance;
+	mutable bool bCachedWhilePlaying = false;
+
+	mutable bool bNodeInfoCacheValid = false;
+	mutable double NodeInfoCacheTime = 0.0;
+
+	FDelegateHandle ObjectPropertyChangedHandle;
+
 public:
 	static const FLinearColor UnselectedNodeTint;
 	static const FLinearColor ConfigBoxColor;
@@ -0,0 +1,28 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+using UnrealBuildTool;
+
+// Level Sequence integration, kept out of the Flow module so projects not using Sequencer don't link it
+public class FlowLevelSequence : ModuleRules
+{
+	public FlowLevelSequence(ReadOnlyTargetRules target) : base(target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new[]
+		{
+			"Flow",
+			"LevelSequence",
+			"MovieScene",
+			"MovieSceneTracks"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"NetCore"
+		});
+	}
+}
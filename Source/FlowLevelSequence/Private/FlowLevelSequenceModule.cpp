@@ -0,0 +1,15 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowLevelSequenceModule.h"
+
+#include "Modules/ModuleManager.h"
+
+void FFlowLevelSequenceModule::StartupModule()
+{
+}
+
+void FFlowLevelSequenceModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FFlowLevelSequenceModule, FlowLevelSequence)
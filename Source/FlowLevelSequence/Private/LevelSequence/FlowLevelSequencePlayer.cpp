@@ -2,7 +2,7 @@
 
 #include "LevelSequence/FlowLevelSequencePlayer.h"
 #include "LevelSequence/FlowLevelSequenceActor.h"
-#include "Nodes/FlowNode.h"
+#include "Nodes/Actor/FlowNode_PlayLevelSequence.h"
 
 #include "DefaultLevelSequenceInstanceData.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -12,6 +12,7 @@
 UFlowLevelSequencePlayer::UFlowLevelSequencePlayer(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, FlowEventReceiver(nullptr)
+	, FlowTrackReceiver(nullptr)
 {
 }
 
@@ -87,6 +88,12 @@ UFlowLevelSequencePlayer* UFlowLevelSequencePlayer::CreateFlowLevelSequencePlaye
 	return Cast<UFlowLevelSequencePlayer>(Actor->GetSequencePlayer());
 }
 
+void UFlowLevelSequencePlayer::SetFlowEventReceiver(UFlowNode* FlowNode)
+{
+	FlowEventReceiver = FlowNode;
+	FlowTrackReceiver = Cast<UFlowNode_PlayLevelSequence>(FlowNode);
+}
+
 TArray<UObject*> UFlowLevelSequencePlayer::GetEventContexts() const
 {
 	TArray<UObject*> EventContexts;
@@ -0,0 +1,113 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "LevelSequence/FlowLevelSequenceSubsystem.h"
+#include "LevelSequence/FlowLevelSequenceActor.h"
+#include "LevelSequence/FlowLevelSequencePlayer.h"
+#include "FlowStats.h"
+
+#include "DefaultLevelSequenceInstanceData.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowLevelSequenceSubsystem)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Sequence Players"), STAT_FlowPooledSequencePlayers, STATGROUP_Flow);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reused Sequence Players"), STAT_FlowReusedSequencePlayers, STATGROUP_Flow);
+
+void UFlowLevelSequenceSubsystem::Deinitialize()
+{
+	ClearSequencePlayerPools();
+
+	Super::Deinitialize();
+}
+
+UFlowLevelSequencePlayer* UFlowLevelSequenceSubsystem::AcquirePooledSequencePlayer(ULevelSequence* Sequence, const FMovieSceneSequencePlaybackSettings& Settings, const FLevelSequenceCameraSettings& CameraSettings, AActor* TransformOriginActor)
+{
+	FFlowSequencePlayerPool* Pool = SequencePlayerPools.Find(Sequence);
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	// pooled actors are destroyed together with their world
+	const UWorld* World = GetWorld();
+	const int32 NumRemoved = Pool->Actors.RemoveAll([World](const AFlowLevelSequenceActor* Actor)
+	{
+		return !IsValid(Actor) || Actor->IsActorBeingDestroyed() || Actor->GetWorld() != World;
+	});
+	DEC_DWORD_STAT_BY(STAT_FlowPooledSequencePlayers, NumRemoved);
+
+	// camera settings are applied only while initializing the player
+	const int32 ActorIndex = Pool->Actors.IndexOfByPredicate([&CameraSettings](const AFlowLevelSequenceActor* Actor)
+	{
+		return FLevelSequenceCameraSettings::StaticStruct()->CompareScriptStruct(&Actor->CameraSettings, &CameraSettings, PPF_None);
+	});
+	if (ActorIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	AFlowLevelSequenceActor* Actor = Pool->Actors[ActorIndex];
+	Pool->Actors.RemoveAtSwap(ActorIndex, 1, EAllowShrinking::No);
+	DEC_DWORD_STAT(STAT_FlowPooledSequencePlayers);
+
+	const bool bHasTransformOrigin = TransformOriginActor->IsValidLowLevel();
+	if (bHasTransformOrigin)
+	{
+		const FTransform& OriginTransform = TransformOriginActor->GetTransform();
+		Actor->SetActorTransform(FTransform(OriginTransform.GetRotation(), OriginTransform.GetLocation(), FVector::OneVector));
+	}
+	if (UDefaultLevelSequenceInstanceData* InstanceData = Cast<UDefaultLevelSequenceInstanceData>(Actor->DefaultInstanceData))
+	{
+		Actor->bOverrideInstanceData = bHasTransformOrigin;
+		InstanceData->TransformOriginActor = bHasTransformOrigin ? TransformOriginActor : nullptr;
+	}
+
+	Actor->SetPlaybackSettings(Settings);
+
+	INC_DWORD_STAT(STAT_FlowReusedSequencePlayers);
+	return Cast<UFlowLevelSequencePlayer>(Actor->GetSequencePlayer());
+}
+
+bool UFlowLevelSequenceSubsystem::ReleaseSequencePlayerToPool(UFlowLevelSequencePlayer* Player, ULevelSequence* Sequence, const int32 MaxPooledPlayers)
+{
+	if (MaxPooledPlayers <= 0 || Player == nullptr || Sequence == nullptr)
+	{
+		return false;
+	}
+
+	// replicated playback is set up on clients while spawning the actor
+	AFlowLevelSequenceActor* Actor = Cast<AFlowLevelSequenceActor>(Player->GetOuter());
+	if (!IsValid(Actor) || Actor->IsActorBeingDestroyed() || Actor->bReplicatePlayback || Actor->GetWorld() != GetWorld())
+	{
+		return false;
+	}
+
+	FFlowSequencePlayerPool& Pool = SequencePlayerPools.FindOrAdd(Sequence);
+	if (Pool.Actors.Num() >= MaxPooledPlayers || Pool.Actors.Contains(Actor))
+	{
+		return false;
+	}
+
+	Pool.Actors.Add(Actor);
+	INC_DWORD_STAT(STAT_FlowPooledSequencePlayers);
+
+	return true;
+}
+
+void UFlowLevelSequenceSubsystem::ClearSequencePlayerPools()
+{
+	for (const TPair<TObjectPtr<ULevelSequence>, FFlowSequencePlayerPool>& Pool : SequencePlayerPools)
+	{
+		DEC_DWORD_STAT_BY(STAT_FlowPooledSequencePlayers, Pool.Value.Actors.Num());
+
+		for (AFlowLevelSequenceActor* Actor : Pool.Value.Actors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+
+	SequencePlayerPools.Empty();
+}
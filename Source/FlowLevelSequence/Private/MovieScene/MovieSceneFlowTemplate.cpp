@@ -0,0 +1,222 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "MovieScene/MovieSceneFlowTemplate.h"
+#include "LevelSequence/FlowLevelSequencePlayer.h"
+#include "MovieScene/MovieSceneFlowTrack.h"
+#include "Nodes/Actor/FlowNode_PlayLevelSequence.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Evaluation/MovieSceneEvaluation.h"
+#include "IMovieScenePlayer.h"
+#include "MovieScene.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneFlowTemplate)
+
+#define LOCTEXT_NAMESPACE "MovieSceneFlowTemplate"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Track Token Execute"), MovieSceneEval_FlowTrack_TokenExecute, STATGROUP_MovieSceneEval);
+
+struct FFlowTrackExecutionToken final : IMovieSceneExecutionToken
+{
+	using FEventNames = TArray<FName, TInlineAllocator<4>>;
+
+	FFlowTrackExecutionToken(FEventNames&& InEventNames)
+		: EventNames(MoveTemp(InEventNames))
+	{
+	}
+
+	FEventNames EventNames;
+
+	virtual void Execute(const FMovieSceneContext& Context, const FMovieSceneEvaluationOperand& Operand, FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) override
+	{
+		MOVIESCENE_DETAILED_SCOPE_CYCLE_COUNTER(MovieSceneEval_FlowTrack_TokenExecute)
+
+		// every Flow player is bound to its own node, so multiple sequences can play at once without scanning event contexts
+		if (const UFlowLevelSequencePlayer* FlowPlayer = Cast<UFlowLevelSequencePlayer>(Player.AsUObject()))
+		{
+			if (UFlowNode_PlayLevelSequence* FlowNode = FlowPlayer->GetFlowTrackReceiver())
+			{
+				FlowNode->TriggerEvents(EventNames);
+			}
+			return;
+		}
+
+		// other players, resolve receivers once per token
+		TArray<UFlowNode_PlayLevelSequence*, TInlineAllocator<2>> FlowNodes;
+		for (UObject* EventReceiver : Player.GetEventContexts())
+		{
+			if (UFlowNode_PlayLevelSequence* FlowNode = Cast<UFlowNode_PlayLevelSequence>(EventReceiver))
+			{
+				FlowNodes.Add(FlowNode);
+			}
+		}
+
+		for (UFlowNode_PlayLevelSequence* FlowNode : FlowNodes)
+		{
+			FlowNode->TriggerEvents(EventNames);
+		}
+	}
+};
+
+FMovieSceneFlowTriggerTemplate::FMovieSceneFlowTriggerTemplate(const UMovieSceneFlowTriggerSection& Section, const UMovieSceneFlowTrack& Track)
+	: FMovieSceneFlowTemplateBase(Track, Section)
+{
+	const TMovieSceneChannelData<const FString> EventData = Section.StringChannel.GetData();
+	const TArrayView<const FFrameNumber> Times = EventData.GetTimes();
+	const TArrayView<const FString> EntryPoints = EventData.GetValues();
+
+	// channel keeps keys sorted, but evaluation relies on it so don't take it for granted
+	TArray<int32> SortedIndices;
+	SortedIndices.Reserve(Times.Num());
+	for (int32 Index = 0; Index < Times.Num(); ++Index)
+	{
+		if (!EntryPoints[Index].IsEmpty())
+		{
+			SortedIndices.Add(Index);
+		}
+	}
+	Algo::StableSortBy(SortedIndices, [&Times](const int32 Index)
+	{
+		return Times[Index];
+	});
+
+	EventTimes.Reserve(SortedIndices.Num());
+	EventNames.Reserve(SortedIndices.Num());
+
+	for (const int32 Index : SortedIndices)
+	{
+		EventTimes.Add(Times[Index]);
+		EventNames.Add(FName(*EntryPoints[Index]));
+	}
+}
+
+void FMovieSceneFlowTriggerTemplate::EvaluateSwept(const FMovieSceneEvaluationOperand& Operand, const FMovieSceneContext& Context, const TRange<FFrameNumber>& SweptRange, const FPersistentEvaluationData& PersistentData, FMovieSceneExecutionTokens& ExecutionTokens) const
+{
+	// Don't allow events to fire when playback is in a stopped state. This can occur when stopping 
+	// playback and returning the current position to the start of playback. It's not desirable to have 
+	// all the events from the last playback position to the start of playback be fired.
+	if (Context.GetStatus() == EMovieScenePlayerStatus::Stopped || Context.IsSilent())
+	{
+		return;
+	}
+
+	const bool bBackwards = Context.GetDirection() == EPlayDirection::Backwards;
+
+	if ((!bBackwards && !bFireEventsWhenForwards) || (bBackwards && !bFireEventsWhenBackwards))
+	{
+		return;
+	}
+
+	// EventTimes are sorted, so keys within the swept range are [FirstIndex, EndIndex)
+	const TRangeBound<FFrameNumber>& LowerBound = SweptRange.GetLowerBound();
+	const TRangeBound<FFrameNumber>& UpperBound = SweptRange.GetUpperBound();
+
+	int32 FirstIndex = 0;
+	if (LowerBound.IsInclusive())
+	{
+		FirstIndex = Algo::LowerBound(EventTimes, LowerBound.GetValue());
+	}
+	else if (LowerBound.IsExclusive())
+	{
+		FirstIndex = Algo::UpperBound(EventTimes, LowerBound.GetValue());
+	}
+
+	int32 EndIndex = EventTimes.Num();
+	if (UpperBound.IsInclusive())
+	{
+		EndIndex = Algo::UpperBound(EventTimes, UpperBound.GetValue());
+	}
+	else if (UpperBound.IsExclusive())
+	{
+		EndIndex = Algo::LowerBound(EventTimes, UpperBound.GetValue());
+	}
+
+	if (FirstIndex >= EndIndex)
+	{
+		return;
+	}
+
+	FFlowTrackExecutionToken::FEventNames EventsToTrigger;
+	EventsToTrigger.Reserve(EndIndex - FirstIndex);
+
+	if (bBackwards)
+	{
+		// Trigger events backwards
+		for (int32 KeyIndex = EndIndex - 1; KeyIndex >= FirstIndex; --KeyIndex)
+		{
+			EventsToTrigger.Add(EventNames[KeyIndex]);
+		}
+	}
+	else
+	{
+		// Trigger events forwards
+		for (int32 KeyIndex = FirstIndex; KeyIndex < EndIndex; ++KeyIndex)
+		{
+			EventsToTrigger.Add(EventNames[KeyIndex]);
+		}
+	}
+
+	ExecutionTokens.Add(FFlowTrackExecutionToken(MoveTemp(EventsToTrigger)));
+}
+
+FMovieSceneFlowRepeaterTemplate::FMovieSceneFlowRepeaterTemplate(const UMovieSceneFlowRepeaterSection& Section, const UMovieSceneFlowTrack& Track)
+	: FMovieSceneFlowTemplateBase(Track, Section)
+	, EventName(Section.EventName.IsEmpty() ? NAME_None : FName(*Section.EventName))
+	, IntervalStart(Section.HasStartFrame() ? Section.GetInclusiveStartFrame() : FFrameNumber(0))
+{
+	const UMovieScene* MovieScene = Section.GetTypedOuter<UMovieScene>();
+	if (Section.FireInterval > 0.0f && MovieScene)
+	{
+		IntervalFrames = FMath::Max(1, MovieScene->GetTickResolution().AsFrameTime(Section.FireInterval).RoundToFrame().Value);
+	}
+}
+
+void FMovieSceneFlowRepeaterTemplate::EvaluateSwept(const FMovieSceneEvaluationOperand& Operand, const FMovieSceneContext& Context, const TRange<FFrameNumber>& SweptRange, const FPersistentEvaluationData& PersistentData, FMovieSceneExecutionTokens& ExecutionTokens) const
+{
+	const bool bBackwards = Context.GetDirection() == EPlayDirection::Backwards;
+	const FFrameNumber CurrentFrame = bBackwards ? Context.GetTime().CeilToFrame() : Context.GetTime().FloorToFrame();
+
+	// Don't allow events to fire when playback is in a stopped state. This can occur when stopping 
+	// playback and returning the current position to the start of playback. It's not desirable to have 
+	// all the events from the last playback position to the start of playback be fired.
+	if (EventName.IsNone() || !SweptRange.Contains(CurrentFrame) || Context.GetStatus() == EMovieScenePlayerStatus::Stopped || Context.IsSilent())
+	{
+		return;
+	}
+
+	if ((!bBackwards && bFireEventsWhenForwards) || (bBackwards && bFireEventsWhenBackwards))
+	{
+		int32 FireCount = 1;
+
+		if (IntervalFrames > 0)
+		{
+			// count interval boundaries, IntervalStart + N * IntervalFrames, within the swept range
+			const TRangeBound<FFrameNumber>& LowerBound = SweptRange.GetLowerBound();
+			const TRangeBound<FFrameNumber>& UpperBound = SweptRange.GetUpperBound();
+
+			const int64 First = LowerBound.IsOpen() ? IntervalStart.Value : LowerBound.GetValue().Value + (LowerBound.IsExclusive() ? 1 : 0);
+			const int64 Last = UpperBound.IsOpen() ? CurrentFrame.Value : UpperBound.GetValue().Value - (UpperBound.IsExclusive() ? 1 : 0);
+			if (Last < IntervalStart.Value || Last < First)
+			{
+				return;
+			}
+
+			const int64 FirstInterval = First <= IntervalStart.Value ? 0 : (First - IntervalStart.Value + IntervalFrames - 1) / IntervalFrames;
+			const int64 LastInterval = (Last - IntervalStart.Value) / IntervalFrames;
+
+			FireCount = static_cast<int32>(FMath::Max<int64>(LastInterval - FirstInterval + 1, 0));
+			if (FireCount == 0)
+			{
+				return;
+			}
+		}
+
+		// fits the inline allocation, unless the interval is shorter than a fraction of the frame time
+		FFlowTrackExecutionToken::FEventNames EventsToTrigger;
+		EventsToTrigger.Init(EventName, FireCount);
+		ExecutionTokens.Add(FFlowTrackExecutionToken(MoveTemp(EventsToTrigger)));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -5,13 +5,18 @@
 #include "FlowAsset.h"
 #include "FlowLogChannels.h"
 #include "FlowSubsystem.h"
+#include "FlowTelemetry.h"
 #include "LevelSequence/FlowLevelSequencePlayer.h"
+#include "LevelSequence/FlowLevelSequenceSubsystem.h"
 
 #if WITH_EDITOR
 #include "MovieScene/MovieSceneFlowTrack.h"
 #include "MovieScene/MovieSceneFlowTriggerSection.h"
 #endif
 
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "LevelSequence.h"
 #include "LevelSequenceActor.h"
 #include "VisualLogger/VisualLogger.h"
@@ -46,6 +51,7 @@ UFlowNode_PlayLevelSequence::UFlowNode_PlayLevelSequence(const FObjectInitialize
 	InputPins.Add(FFlowPin(TEXT("Resume")));
 	InputPins.Add(FFlowPin(TEXT("Stop")));
 
+	OutputPins.Add(FFlowPin(TEXT("Loading")));
 	OutputPins.Add(FFlowPin(TEXT("PreStart")));
 	OutputPins.Add(FFlowPin(TEXT("Started")));
 	OutputPins.Add(FFlowPin(TEXT("Completed")));
@@ -106,9 +112,10 @@ void UFlowNode_PlayLevelSequence::PreloadContent()
 	UE_VLOG(this, LogFlow, Log, TEXT("Preloading"));
 #endif
 
-	if (!Sequence.IsNull())
+	if (!Sequence.IsNull() && PreloadedSequence.IsNull() && GetFlowSubsystem())
 	{
-		StreamableManager.RequestAsyncLoad({Sequence.ToSoftObjectPath()}, FStreamableDelegate());
+		PreloadedSequence = Sequence.ToSoftObjectPath();
+		GetFlowSubsystem()->AcquirePreload(PreloadedSequence);
 	}
 }
 
@@ -118,9 +125,13 @@ void UFlowNode_PlayLevelSequence::FlushContent()
 	UE_VLOG(this, LogFlow, Log, TEXT("Flushing preload"));
 #endif
 
-	if (!Sequence.IsNull())
+	if (!PreloadedSequence.IsNull())
 	{
-		StreamableManager.Unload(Sequence.ToSoftObjectPath());
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->ReleasePreload(PreloadedSequence);
+		}
+		PreloadedSequence.Reset();
 	}
 }
 
@@ -150,8 +161,17 @@ void UFlowNode_PlayLevelSequence::CreatePlayer()
 		// Apply Transform Origin
 		AActor* TransformOriginActor = bUseGraphOwnerAsTransformOrigin ? OwningActor : nullptr;
 
+		UFlowLevelSequencePlayer* PooledPlayer = nullptr;
+		if (MaxPooledPlayers > 0 && !bReplicates)
+		{
+			if (UFlowLevelSequenceSubsystem* SequenceSubsystem = GetSequenceSubsystem())
+			{
+				PooledPlayer = SequenceSubsystem->AcquirePooledSequencePlayer(LoadedSequence, PlaybackSettings, CameraSettings, TransformOriginActor);
+			}
+		}
+
 		// Finally create the player
-		SequencePlayer = UFlowLevelSequencePlayer::CreateFlowLevelSequencePlayer(this, LoadedSequence, PlaybackSettings, CameraSettings, TransformOriginActor, bReplicates, bAlwaysRelevant, SequenceActor);
+		SequencePlayer = PooledPlayer ? PooledPlayer : UFlowLevelSequencePlayer::CreateFlowLevelSequencePlayer(this, LoadedSequence, PlaybackSettings, CameraSettings, TransformOriginActor, bReplicates, bAlwaysRelevant, SequenceActor);
 
 		if (SequencePlayer)
 		{
@@ -168,47 +188,127 @@ void UFlowNode_PlayLevelSequence::ExecuteInput(const FName& PinName)
 {
 	if (PinName == TEXT("Start"))
 	{
-		LoadedSequence = Sequence.LoadSynchronous();
+		if (bAsyncLoad && !Sequence.IsNull() && !Sequence.IsValid())
+		{
+			RequestSequenceLoad();
+			TriggerOutput(TEXT("Loading"));
+		}
+		else
+		{
+			StartPlayback();
+		}
 
-		if (GetFlowSubsystem()->GetWorld() && LoadedSequence)
+		TriggerFirstOutput(false);
+	}
+	else if (PinName == TEXT("Stop"))
+	{
+		CancelSequenceLoad();
+		StopPlayback();
+	}
+	else if (PinName == TEXT("Pause"))
+	{
+		if (SequencePlayer)
 		{
-			CreatePlayer();
+			SequencePlayer->Pause();
+		}
+	}
+	else if (PinName == TEXT("Resume") && SequencePlayer && SequencePlayer->IsPaused())
+	{
+		SequencePlayer->Play();
+	}
+}
 
-			if (SequencePlayer)
-			{
-				TriggerOutput(TEXT("PreStart"));
+void UFlowNode_PlayLevelSequence::StartPlayback()
+{
+	LoadedSequence = Sequence.LoadSynchronous();
 
-				SequencePlayer->OnFinished.AddDynamic(this, &UFlowNode_PlayLevelSequence::OnPlaybackFinished);
+	if (GetFlowSubsystem()->GetWorld() && LoadedSequence)
+	{
+		CreatePlayer();
 
-				if (bPlayReverse)
-				{
-					SequencePlayer->PlayReverse();
-				}
-				else
-				{
-					SequencePlayer->Play();
-				}
+		if (SequencePlayer)
+		{
+			TriggerOutput(TEXT("PreStart"));
+
+			SequencePlayer->OnFinished.AddDynamic(this, &UFlowNode_PlayLevelSequence::OnPlaybackFinished);
 
-				TriggerOutput(TEXT("Started"));
+			if (bPlayReverse)
+			{
+				SequencePlayer->PlayReverse();
+			}
+			else
+			{
+				SequencePlayer->Play();
 			}
+
+			TriggerOutput(TEXT("Started"));
 		}
+	}
+}
 
-		TriggerFirstOutput(false);
+void UFlowNode_PlayLevelSequence::RequestSequenceLoad()
+{
+	CancelSequenceLoad();
+
+	// joins the load requested by PreloadContent, if it's still pending
+	SequenceLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Sequence.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this, [this, RequestTime = FLOW_TELEMETRY_TIME()]()
+	{
+		FLOW_TELEMETRY_RECORD(GetFlowAsset(), AsyncLoadWait, RequestTime);
+		SequenceLoadHandle.Reset();
+		OnSequenceLoaded();
+	}));
+
+	if (AsyncLoadTimeout > 0.0f && IsLoadingSequence())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			SequenceLoadTimeoutHandle = FlowSubsystem->SetFlowTimer(GetFlowAsset(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_PlayLevelSequence::OnSequenceLoadTimeout), AsyncLoadTimeout, false);
+		}
 	}
-	else if (PinName == TEXT("Stop"))
+}
+
+void UFlowNode_PlayLevelSequence::CancelSequenceLoad()
+{
+	if (SequenceLoadTimeoutHandle.IsValid())
 	{
-		StopPlayback();
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->ClearFlowTimer(SequenceLoadTimeoutHandle);
+		}
+		SequenceLoadTimeoutHandle.Invalidate();
 	}
-	else if (PinName == TEXT("Pause"))
+
+	if (SequenceLoadHandle.IsValid())
 	{
-		SequencePlayer->Pause();
+		// handle has to be reset before canceling, as canceling releases the lambda holding this node
+		const TSharedPtr<FStreamableHandle> Handle = MoveTemp(SequenceLoadHandle);
+		Handle->CancelHandle();
 	}
-	else if (PinName == TEXT("Resume") && SequencePlayer->IsPaused())
+}
+
+void UFlowNode_PlayLevelSequence::OnSequenceLoaded()
+{
+	CancelSequenceLoad();
+
+	if (GetActivationState() == EFlowNodeState::Active)
 	{
-		SequencePlayer->Play();
+		StartPlayback();
 	}
 }
 
+void UFlowNode_PlayLevelSequence::OnSequenceLoadTimeout()
+{
+	SequenceLoadTimeoutHandle.Invalidate();
+
+#if ENABLE_VISUAL_LOG
+	UE_VLOG(this, LogFlow, Log, TEXT("Async load timed out, loading synchronously: %s"), *Sequence.ToString());
+#endif
+
+	// StartPlayback flushes the pending load
+	CancelSequenceLoad();
+	StartPlayback();
+}
+
 void UFlowNode_PlayLevelSequence::OnSave_Implementation()
 {
 	if (SequencePlayer)
@@ -248,9 +348,23 @@ void UFlowNode_PlayLevelSequence::OnLoad_Implementation()
 	}
 }
 
-void UFlowNode_PlayLevelSequence::TriggerEvent(const FString& EventName)
+void UFlowNode_PlayLevelSequence::TriggerEvents(TConstArrayView<FName> EventNames)
 {
-	TriggerOutput(*EventName, false);
+	UFlowAsset* FlowAsset = bDeferSequenceEvents ? GetFlowAsset() : nullptr;
+	if (FlowAsset)
+	{
+		FlowAsset->BeginDeferredInputs();
+	}
+
+	for (const FName& EventName : EventNames)
+	{
+		TriggerOutput(EventName, false);
+	}
+
+	if (FlowAsset)
+	{
+		FlowAsset->EndDeferredInputs();
+	}
 }
 
 void UFlowNode_PlayLevelSequence::OnTimeDilationUpdate(const float NewTimeDilation)
@@ -281,6 +395,8 @@ void UFlowNode_PlayLevelSequence::StopPlayback()
 
 void UFlowNode_PlayLevelSequence::Cleanup()
 {
+	CancelSequenceLoad();
+
 	if (SequencePlayer)
 	{
 		SequencePlayer->SetFlowEventReceiver(nullptr);
@@ -288,6 +404,15 @@ void UFlowNode_PlayLevelSequence::Cleanup()
 		if (!PlaybackSettings.bPauseAtEnd)
 		{
 			SequencePlayer->Stop();
+
+			// paused players keep showing the last frame, only stopped ones can be reused
+			if (MaxPooledPlayers > 0)
+			{
+				if (UFlowLevelSequenceSubsystem* SequenceSubsystem = GetSequenceSubsystem())
+				{
+					SequenceSubsystem->ReleaseSequencePlayerToPool(SequencePlayer, LoadedSequence, MaxPooledPlayers);
+				}
+			}
 		}
 		SequencePlayer = nullptr;
 	}
@@ -304,6 +429,13 @@ void UFlowNode_PlayLevelSequence::Cleanup()
 	Super::Cleanup();
 }
 
+UFlowLevelSequenceSubsystem* UFlowNode_PlayLevelSequence::GetSequenceSubsystem() const
+{
+	const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	const UGameInstance* GameInstance = FlowSubsystem ? FlowSubsystem->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UFlowLevelSequenceSubsystem>() : nullptr;
+}
+
 FString UFlowNode_PlayLevelSequence::GetPlaybackProgress() const
 {
 	if (SequencePlayer && SequencePlayer->IsPlaying())
@@ -11,7 +11,7 @@ class ULevelSequence;
  * Custom ALevelSequenceActor is needed to override ULevelSequencePlayer class
  */
 UCLASS(hideCategories=(Rendering, Physics, LOD, Activation, Input))
-class FLOW_API AFlowLevelSequenceActor : public ALevelSequenceActor
+class FLOWLEVELSEQUENCE_API AFlowLevelSequenceActor : public ALevelSequenceActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -6,12 +6,13 @@
 #include "FlowLevelSequencePlayer.generated.h"
 
 class UFlowNode;
+class UFlowNode_PlayLevelSequence;
 
 /**
  * Custom ULevelSequencePlayer allows for binding Flow Nodes to Level Sequence events
  */
 UCLASS()
-class FLOW_API UFlowLevelSequencePlayer : public ULevelSequencePlayer
+class FLOWLEVELSEQUENCE_API UFlowLevelSequencePlayer : public ULevelSequencePlayer
 {
 	GENERATED_UCLASS_BODY()
 
@@ -20,6 +21,10 @@ private:
 	UPROPERTY()
 	TObjectPtr<UFlowNode> FlowEventReceiver;
 
+	// FlowEventReceiver resolved once on binding, Flow track events are dispatched directly to it
+	UPROPERTY(Transient)
+	TObjectPtr<UFlowNode_PlayLevelSequence> FlowTrackReceiver;
+
 public:
 	// variant of ULevelSequencePlayer::CreateLevelSequencePlayer
 	static UFlowLevelSequencePlayer* CreateFlowLevelSequencePlayer(
@@ -32,7 +37,8 @@ public:
 		const bool bAlwaysRelevant,
 		ALevelSequenceActor*& OutActor);
 
-	void SetFlowEventReceiver(UFlowNode* FlowNode) { FlowEventReceiver = FlowNode; }
+	void SetFlowEventReceiver(UFlowNode* FlowNode);
+	UFlowNode_PlayLevelSequence* GetFlowTrackReceiver() const { return FlowTrackReceiver; }
 
 	// IMovieScenePlayer
 	virtual TArray<UObject*> GetEventContexts() const override;
@@ -0,0 +1,49 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "FlowLevelSequenceSubsystem.generated.h"
+
+class AFlowLevelSequenceActor;
+class ULevelSequence;
+class UFlowLevelSequencePlayer;
+struct FLevelSequenceCameraSettings;
+struct FMovieSceneSequencePlaybackSettings;
+
+/** Stopped sequence actors created for the same Level Sequence, waiting for reuse */
+USTRUCT()
+struct FLOWLEVELSEQUENCE_API FFlowSequencePlayerPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AFlowLevelSequenceActor>> Actors;
+};
+
+/**
+ * Pools sequence players of the Play Level Sequence node, see UFlowNode_PlayLevelSequence::MaxPooledPlayers
+ */
+UCLASS()
+class FLOWLEVELSEQUENCE_API UFlowLevelSequenceSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	/* Stopped sequence actors per sequence */
+	UPROPERTY()
+	TMap<TObjectPtr<ULevelSequence>, FFlowSequencePlayerPool> SequencePlayerPools;
+
+public:
+	/* Returns stopped player of the sequence with matching camera settings, playback settings and transform origin are applied like on creating a new player */
+	UFlowLevelSequencePlayer* AcquirePooledSequencePlayer(ULevelSequence* Sequence, const FMovieSceneSequencePlaybackSettings& Settings, const FLevelSequenceCameraSettings& CameraSettings, AActor* TransformOriginActor);
+
+	/* Called with the stopped player instead of abandoning its actor, returns true if player has been pooled */
+	bool ReleaseSequencePlayerToPool(UFlowLevelSequencePlayer* Player, ULevelSequence* Sequence, const int32 MaxPooledPlayers);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	void ClearSequencePlayerPools();
+};
@@ -7,9 +7,10 @@
 
 /**
  * Flow section that will trigger its event exactly once, every time it is evaluated.
+ * With a non-zero FireInterval it triggers at fixed times from the section start instead, independent of the frame rate.
  */
 UCLASS()
-class FLOW_API UMovieSceneFlowRepeaterSection : public UMovieSceneFlowSectionBase
+class FLOWLEVELSEQUENCE_API UMovieSceneFlowRepeaterSection : public UMovieSceneFlowSectionBase
 {
 	GENERATED_BODY()
 
@@ -21,4 +22,8 @@ public:
 	/** The event that should be triggered each time this section is evaluated */
 	UPROPERTY(EditAnywhere, Category = "Flow")
 	FString EventName;
+
+	/** Seconds between triggering the event, starting at the section start. Event is triggered as many times as intervals passed by the evaluation. 0 triggers on every evaluation */
+	UPROPERTY(EditAnywhere, Category = "Flow", meta = (ClampMin = 0, Units = "s"))
+	float FireInterval = 0.0f;
 };
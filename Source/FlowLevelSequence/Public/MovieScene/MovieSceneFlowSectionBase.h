@@ -9,7 +9,7 @@
  * Base class for flow sections
  */
 UCLASS()
-class FLOW_API UMovieSceneFlowSectionBase : public UMovieSceneSection
+class FLOWLEVELSEQUENCE_API UMovieSceneFlowSectionBase : public UMovieSceneSection
 {
 	GENERATED_BODY()
 
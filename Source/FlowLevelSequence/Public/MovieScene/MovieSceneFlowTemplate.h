@@ -45,11 +45,13 @@ struct FMovieSceneFlowTriggerTemplate : public FMovieSceneFlowTemplateBase
 	FMovieSceneFlowTriggerTemplate() {}
 	FMovieSceneFlowTriggerTemplate(const UMovieSceneFlowTriggerSection& Section, const UMovieSceneFlowTrack& Track);
 
+	// Sorted times of keys with non-empty event names
 	UPROPERTY()
 	TArray<FFrameNumber> EventTimes;
 
+	// Converted once on compiling the template, by the index in EventTimes
 	UPROPERTY()
-	TArray<FString> EventNames;
+	TArray<FName> EventNames;
 
 private:
 	virtual UScriptStruct& GetScriptStructImpl() const override { return *StaticStruct(); }
@@ -65,7 +67,15 @@ struct FMovieSceneFlowRepeaterTemplate : public FMovieSceneFlowTemplateBase
 	FMovieSceneFlowRepeaterTemplate(const UMovieSceneFlowRepeaterSection& Section, const UMovieSceneFlowTrack& Track);
 
 	UPROPERTY()
-	FString EventName;
+	FName EventName;
+
+	// FireInterval of the section in the tick resolution of the movie scene, 0 fires on every evaluation
+	UPROPERTY()
+	int32 IntervalFrames = 0;
+
+	// Frame of the first interval
+	UPROPERTY()
+	FFrameNumber IntervalStart;
 
 private:
 	virtual UScriptStruct& GetScriptStructImpl() const override { return *StaticStruct(); }
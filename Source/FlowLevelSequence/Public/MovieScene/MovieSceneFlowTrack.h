@@ -11,7 +11,7 @@ struct FMovieSceneEvaluationTrack;
  * Implements a movie scene track that triggers events in the Flow System during playback.
  */
 UCLASS()
-class FLOW_API UMovieSceneFlowTrack
+class FLOWLEVELSEQUENCE_API UMovieSceneFlowTrack
 	: public UMovieSceneNameableTrack
 	, public IMovieSceneTrackTemplateProducer
 {
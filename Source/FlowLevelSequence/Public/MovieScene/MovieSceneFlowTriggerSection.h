@@ -11,7 +11,7 @@
  * Flow section that triggers specific timed events.
  */
 UCLASS()
-class FLOW_API UMovieSceneFlowTriggerSection : public UMovieSceneFlowSectionBase
+class FLOWLEVELSEQUENCE_API UMovieSceneFlowTriggerSection : public UMovieSceneFlowSectionBase
 {
 	GENERATED_BODY()
 
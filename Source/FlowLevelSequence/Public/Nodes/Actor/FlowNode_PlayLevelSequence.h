@@ -3,26 +3,29 @@
 #pragma once
 
 #include "EngineDefines.h"
-#include "Engine/StreamableManager.h"
 #include "LevelSequencePlayer.h"
 #include "MovieSceneSequencePlayer.h"
 
+#include "FlowTimerWheel.h"
 #include "Nodes/FlowNode.h"
 #include "FlowNode_PlayLevelSequence.generated.h"
 
 class UFlowLevelSequencePlayer;
+class UFlowLevelSequenceSubsystem;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE(FFlowNodeLevelSequenceEvent);
 
 /**
  * Order of triggering outputs after calling Start
+ * - Loading, only if the sequence is loaded asynchronously, see bAsyncLoad
  * - PreStart, just before starting playback
  * - Started
- * - Out (always, even if Sequence is invalid)
+ * - Out (always, even if Sequence is invalid), right after Loading if the sequence is still loading
  * - Completed
  */
 UCLASS(NotBlueprintable, meta = (DisplayName = "Play Level Sequence"))
-class FLOW_API UFlowNode_PlayLevelSequence : public UFlowNode
+class FLOWLEVELSEQUENCE_API UFlowNode_PlayLevelSequence : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 	friend struct FFlowTrackExecutionToken;
@@ -61,6 +64,26 @@ public:
 	// Enabling this option will use Custom Time Dilation from actor that created Root Flow instance, i.e. World Settings or Player Controller
 	UPROPERTY(EditAnywhere, Category = "Sequence")
 	bool bApplyOwnerTimeDilation;
+
+	// Number of stopped sequence players of this sequence kept by the Flow Subsystem for reuse, avoids spawning a sequence actor on every playback
+	// Players are reused by any node playing the same sequence with the same Camera Settings
+	// Replicated players and players pausing at the end aren't pooled, 0 disables pooling
+	UPROPERTY(EditAnywhere, Category = "Sequence", meta = (ClampMin = 0))
+	int32 MaxPooledPlayers = 0;
+
+	// If the sequence isn't loaded on Start, it's loaded asynchronously and playback starts once loading completes
+	// Loading output is triggered instead of PreStart and Started in such case. Loading from SaveGame is always blocking
+	UPROPERTY(EditAnywhere, Category = "Sequence")
+	bool bAsyncLoad = false;
+
+	// Seconds of waiting for the async load before falling back to synchronous loading, 0 waits until loading completes
+	UPROPERTY(EditAnywhere, Category = "Sequence", meta = (ClampMin = 0, EditCondition = "bAsyncLoad"))
+	float AsyncLoadTimeout = 0.0f;
+
+	// If True, nodes connected to Flow track event outputs aren't executed inside the Sequencer evaluation
+	// Events fired by the evaluation are passed as one batch to the deferred trigger queue, drained by the Flow Subsystem in the next frame
+	UPROPERTY(EditAnywhere, Category = "Sequence")
+	bool bDeferSequenceEvents = false;
 	
 protected:
 	UPROPERTY()
@@ -81,7 +104,11 @@ protected:
 	UPROPERTY(SaveGame)
 	float TimeDilation;
 
-	FStreamableManager StreamableManager;
+	/* Sequence acquired from the Flow Subsystem shared preloads, released by FlushContent */
+	FSoftObjectPath PreloadedSequence;
+
+	TSharedPtr<FStreamableHandle> SequenceLoadHandle;
+	FFlowTimerHandle SequenceLoadTimeoutHandle;
 
 public:
 #if WITH_EDITOR
@@ -93,6 +120,7 @@ public:
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
+	virtual bool HasPreloadContent() const override { return !Sequence.IsNull(); }
 	virtual void PreloadContent() override;
 	virtual void FlushContent() override;
 
@@ -102,11 +130,23 @@ public:
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 
+	void StartPlayback();
+
+	bool IsLoadingSequence() const { return SequenceLoadHandle.IsValid(); }
+	void RequestSequenceLoad();
+	void CancelSequenceLoad();
+	void OnSequenceLoaded();
+	void OnSequenceLoadTimeout();
+
+	// elapsed time is captured in OnSave()
+	virtual bool CanReuseSaveData() const override { return false; }
+
 	virtual void OnSave_Implementation() override;
 	virtual void OnLoad_Implementation() override;
 
 private:
-	void TriggerEvent(const FString& EventName);
+	// Triggers outputs of Flow track events fired by a single evaluation of the sequence
+	void TriggerEvents(TConstArrayView<FName> EventNames);
 
 public:
 	void OnTimeDilationUpdate(const float NewTimeDilation);
@@ -121,6 +161,9 @@ public:
 protected:
 	virtual void Cleanup() override;
 
+	// Owner of the player pools, lives next to the Flow Subsystem
+	UFlowLevelSequenceSubsystem* GetSequenceSubsystem() const;
+
 public:
 	FString GetPlaybackProgress() const;
 